@@ -34,6 +34,7 @@
 
 #include "cutlass/cutlass.h"
 #include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
 #include "cutlass/conv/convolution.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -183,22 +184,12 @@ public:
 
         int smem_size = int(sizeof(typename ImplicitGemmKernel::SharedStorage));
 
-        if (smem_size >= (48 << 10)) {
-            cudaError_t result = cudaFuncSetAttribute(
-                    cutlass::Kernel<ImplicitGemmKernel>,
-                    cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size);
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<ImplicitGemmKernel>::configure(
+                        smem_size);
 
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
-
-            result = cudaFuncSetAttribute(
-                    cutlass::Kernel<ImplicitGemmKernel>,
-                    cudaFuncAttributePreferredSharedMemoryCarveout, 100);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
         }
 
         return Status::kSuccess;
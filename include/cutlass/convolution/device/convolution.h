@@ -39,6 +39,7 @@
 #include "cutlass/cutlass.h"
 #include "cutlass/arch/arch.h"
 #include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
 #include "cutlass/numeric_types.h"
 
 #include "cutlass/conv/convolution.h"
@@ -231,7 +232,6 @@ public:
         params_.output_op = args.output_op;
         params_.transform_src = args.transform_src;
         params_.transform_filter = args.transform_filter;
-        params_.extra_param = args.extra_param;
         params_.workspace = static_cast<int*>(workspace);
 
         return Status::kSuccess;
@@ -248,22 +248,12 @@ public:
         cudaError_t result;
 
         int smem_size = int(sizeof(typename ConvolutionKernel::SharedStorage));
-        if (smem_size >= (48 << 10)) {
-            result = cudaFuncSetAttribute(
-                    Kernel<ConvolutionKernel>,
-                    cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
-
-            result = cudaFuncSetAttribute(
-                    Kernel<ConvolutionKernel>,
-                    cudaFuncAttributePreferredSharedMemoryCarveout, 100);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<ConvolutionKernel>::configure(
+                        smem_size);
+
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
         }
 
         cutlass::Kernel<ConvolutionKernel>
@@ -463,7 +453,6 @@ public:
         params_.output_op = args.output_op;
         params_.transform_src = args.transform_src;
         params_.transform_filter = args.transform_filter;
-        params_.extra_param = args.extra_param;
         params_.workspace = static_cast<int*>(workspace);
 
         return Status::kSuccess;
@@ -480,22 +469,12 @@ public:
         cudaError_t result;
 
         int smem_size = int(sizeof(typename ConvolutionKernel::SharedStorage));
-        if (smem_size >= (48 << 10)) {
-            result = cudaFuncSetAttribute(
-                    Kernel<ConvolutionKernel>,
-                    cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
-
-            result = cudaFuncSetAttribute(
-                    Kernel<ConvolutionKernel>,
-                    cudaFuncAttributePreferredSharedMemoryCarveout, 100);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<ConvolutionKernel>::configure(
+                        smem_size);
+
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
         }
 
         cutlass::Kernel<ConvolutionKernel>
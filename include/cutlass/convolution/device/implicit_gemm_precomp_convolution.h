@@ -44,6 +44,7 @@
 
 #include "cutlass/cutlass.h"
 #include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
 #include "cutlass/conv/convolution.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -165,22 +166,12 @@ public:
         cudaError_t result;
 
         int smem_size = int(sizeof(typename ImplicitGemmKernel::SharedStorage));
-        if (smem_size >= (48 << 10)) {
-            result = cudaFuncSetAttribute(
-                    Kernel<ImplicitGemmKernel>,
-                    cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
-
-            result = cudaFuncSetAttribute(
-                    Kernel<ImplicitGemmKernel>,
-                    cudaFuncAttributePreferredSharedMemoryCarveout, 100);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<ImplicitGemmKernel>::configure(
+                        smem_size);
+
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
         }
 
         cutlass::Kernel<ImplicitGemmKernel>
@@ -257,9 +257,7 @@ struct ImplicitGemmTnPrecompConvolution {
             ConvProblemSize problem_size,
             typename Mma::IteratorSrc::TensorRef ref_src,
             typename Mma::IteratorFilter::TensorRef ref_filter,
-            typename Epilogue::BiasTileIterator::TensorRef ref_bias,
-            typename Epilogue::OutputTileIterator::TensorRef ref_z,
-            typename Epilogue::OutputTileIterator::TensorRef ref_dst) {
+            TensorRefBias ref_bias, TensorRefDst ref_z, TensorRefDst ref_dst) {
         static int const kAlignmentSrc =
                 Mma::IteratorSrc::AccessType::kElements;
         static int const kAlignmentFilter =
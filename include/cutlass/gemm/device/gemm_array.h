@@ -35,6 +35,7 @@
 #include "cutlass/numeric_types.h"
 #include "cutlass/arch/arch.h"
 #include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
 
 #include "cutlass/gemm/threadblock/threadblock_swizzle.h"
 #include "cutlass/gemm/kernel/gemm_array.h"
@@ -399,22 +400,12 @@ public:
         cudaError_t result;
 
         int smem_size = int(sizeof(typename GemmKernel::SharedStorage));
-        if (smem_size >= (48 << 10)) {
-            result = cudaFuncSetAttribute(
-                    Kernel<GemmKernel>,
-                    cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
-
-            result = cudaFuncSetAttribute(
-                    Kernel<GemmKernel>,
-                    cudaFuncAttributePreferredSharedMemoryCarveout, 100);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<GemmKernel>::configure(
+                        smem_size);
+
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
         }
 
         cutlass::Kernel<GemmKernel>
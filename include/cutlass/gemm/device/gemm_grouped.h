@@ -0,0 +1,398 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Device-level operator launching a persistent grouped GEMM kernel.
+*/
+
+#pragma once
+
+#include <algorithm>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/arch/arch.h"
+#include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
+
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/kernel/gemm_grouped.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace gemm {
+namespace device {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/*! GemmGrouped device-level operator. Computes a group of independent GEMM
+  problems, each with its own M, N, K, operands and leading dimensions, in a
+  single kernel launch.
+
+  The kernel launches a fixed number of persistent threadblocks which visit
+  the output tiles of all problems (see kernel::GemmGroupedProblemVisitor).
+  Problem sizes, operand pointers and leading dimensions are read from arrays
+  in device memory, so alignment constraints on individual problems cannot be
+  verified when the operator is initialized; callers with host-side copies
+  should check each problem with can_implement(problem_size, lda, ...).
+
+  Example:
+
+    using GemmKernel = typename cutlass::gemm::kernel::DefaultGemmGrouped<
+      float, cutlass::layout::ColumnMajor, 1,
+      float, cutlass::layout::ColumnMajor, 1,
+      float, cutlass::layout::ColumnMajor,
+      float,
+      cutlass::arch::OpClassSimt,
+      cutlass::arch::Sm50,
+      cutlass::gemm::GemmShape<128, 128, 8>,
+      cutlass::gemm::GemmShape<32, 64, 8>,
+      cutlass::gemm::GemmShape<1, 1, 1>,
+      cutlass::epilogue::thread::LinearCombination<float, 1, float, float>,
+      cutlass::gemm::threadblock::GemmIdentityThreadblockSwizzle<>,
+      2,
+      cutlass::arch::OpMultiplyAdd
+    >::GemmKernel;
+
+    cutlass::gemm::device::GemmGrouped<GemmKernel> gemm_op;
+
+    cutlass::Status status = gemm_op({
+      problem_sizes,          // GemmCoord const * (device memory)
+      problem_count,          // int
+      0,                      // threadblock_count (0 selects from occupancy)
+      {alpha, beta},          // EpilogueOutputOp::Params
+      ptr_A, ptr_B, ptr_C, ptr_D,   // Element pointer arrays (device memory)
+      lda, ldb, ldc, ldd            // int64_t arrays (device memory)
+    });
+*/
+template <typename GemmKernel_>
+class GemmGrouped {
+public:
+    using GemmKernel = GemmKernel_;
+
+    using ElementA = typename GemmKernel::ElementA;
+    using LayoutA = typename GemmKernel::LayoutA;
+    using ElementB = typename GemmKernel::ElementB;
+    using LayoutB = typename GemmKernel::LayoutB;
+    using ElementC = typename GemmKernel::ElementC;
+    using LayoutC = typename GemmKernel::LayoutC;
+    using ElementAccumulator =
+            typename GemmKernel::Mma::Policy::Operator::ElementC;
+
+    using ThreadblockShape = typename GemmKernel::ThreadblockShape;
+    using WarpShape = typename GemmKernel::WarpShape;
+    using InstructionShape = typename GemmKernel::InstructionShape;
+
+    // warp-level, arch-level (instruction), math operator
+    using WarpMmaOperator = typename GemmKernel::Mma::Policy::Operator;
+    using ArchMmaOperator = typename WarpMmaOperator::ArchMmaOperator;
+    using Operator = typename ArchMmaOperator::Operator;
+
+    // Operator class and arch tag extract bottom-up
+    using OperatorClass = typename WarpMmaOperator::OperatorClass;
+    using ArchTag = typename WarpMmaOperator::ArchTag;
+
+    using EpilogueOutputOp = typename GemmKernel::EpilogueOutputOp;
+    using ThreadblockSwizzle = typename GemmKernel::ThreadblockSwizzle;
+    using ProblemVisitor = typename GemmKernel::ProblemVisitor;
+
+    static ComplexTransform const kTransformA = GemmKernel::kTransformA;
+    static ComplexTransform const kTransformB = GemmKernel::kTransformB;
+
+    static int const kStages = GemmKernel::Mma::kStages;
+    static int const kAlignmentA = GemmKernel::kAlignmentA;
+    static int const kAlignmentB = GemmKernel::kAlignmentB;
+    static int const kAlignmentC = GemmKernel::kAlignmentC;
+
+    /// Argument structure
+    struct Arguments {
+        //
+        // Data members
+        //
+
+        /// Size of each problem (device memory)
+        GemmCoord const* problem_sizes;
+
+        /// Number of problems
+        int problem_count;
+
+        /// Number of persistent threadblocks; zero launches as many as can be
+        /// resident on the device at once
+        int threadblock_count;
+
+        typename EpilogueOutputOp::Params epilogue;
+
+        /// Arrays of per-problem operand pointers (device memory)
+        ElementA const* const* ptr_A;
+        ElementB const* const* ptr_B;
+        ElementC const* const* ptr_C;
+        ElementC* const* ptr_D;
+
+        /// Arrays of per-problem leading dimensions (device memory)
+        int64_t const* lda;
+        int64_t const* ldb;
+        int64_t const* ldc;
+        int64_t const* ldd;
+
+        //
+        // Methods
+        //
+
+        /// Default ctor
+        CUTLASS_HOST_DEVICE
+        Arguments()
+                : problem_sizes(nullptr),
+                  problem_count(0),
+                  threadblock_count(0),
+                  ptr_A(nullptr),
+                  ptr_B(nullptr),
+                  ptr_C(nullptr),
+                  ptr_D(nullptr),
+                  lda(nullptr),
+                  ldb(nullptr),
+                  ldc(nullptr),
+                  ldd(nullptr) {}
+
+        /// Constructs an Arguments structure
+        CUTLASS_HOST_DEVICE
+        Arguments(GemmCoord const* problem_sizes_, int problem_count_,
+                  int threadblock_count_,
+                  typename EpilogueOutputOp::Params epilogue_,
+                  ElementA const* const* ptr_A_, ElementB const* const* ptr_B_,
+                  ElementC const* const* ptr_C_, ElementC* const* ptr_D_,
+                  int64_t const* lda_, int64_t const* ldb_,
+                  int64_t const* ldc_, int64_t const* ldd_)
+                : problem_sizes(problem_sizes_),
+                  problem_count(problem_count_),
+                  threadblock_count(threadblock_count_),
+                  epilogue(epilogue_),
+                  ptr_A(ptr_A_),
+                  ptr_B(ptr_B_),
+                  ptr_C(ptr_C_),
+                  ptr_D(ptr_D_),
+                  lda(lda_),
+                  ldb(ldb_),
+                  ldc(ldc_),
+                  ldd(ldd_) {}
+    };
+
+private:
+    /// Kernel parameters object
+    typename GemmKernel::Params params_;
+
+public:
+    /// Constructs the GEMM.
+    GemmGrouped() {}
+
+    /// Determines whether the GEMM can execute the given group.
+    static Status can_implement(Arguments const& args) {
+        if (args.problem_count < 0 || args.threadblock_count < 0) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        if (args.problem_count &&
+            (!args.problem_sizes || !args.ptr_A || !args.ptr_B ||
+             !args.ptr_C || !args.ptr_D || !args.lda || !args.ldb ||
+             !args.ldc || !args.ldd)) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        return Status::kSuccess;
+    }
+
+    /// Determines whether the GEMM can execute one problem of a group.
+    static Status can_implement(GemmCoord const& problem_size, int64_t lda,
+                                int64_t ldb, int64_t ldc, int64_t ldd) {
+        if (problem_size.m() < 0 || problem_size.n() < 0 ||
+            problem_size.k() < 0) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        if ((lda % kAlignmentA) || (ldb % kAlignmentB) ||
+            (ldc % kAlignmentC) || (ldd % kAlignmentC)) {
+            return Status::kErrorMisalignedOperand;
+        }
+
+        if ((problem_size.m() % kAlignmentA) ||
+            (problem_size.k() % kAlignmentA) ||
+            (problem_size.n() % kAlignmentB) ||
+            (problem_size.k() % kAlignmentB) ||
+            (problem_size.m() % kAlignmentC) ||
+            (problem_size.n() % kAlignmentC)) {
+            return Status::kErrorMisalignedOperand;
+        }
+
+        return Status::kSuccess;
+    }
+
+    /// Gets the workspace size
+    static size_t get_workspace_size(Arguments const& args) { return 0; }
+
+    /// Computes the maximum number of active blocks per multiprocessor
+    static int maximum_active_blocks() {
+        int max_active_blocks = -1;
+        int smem_size = int(sizeof(typename GemmKernel::SharedStorage));
+
+        if (KernelSharedMemoryConfiguration<GemmKernel>::configure(
+                    smem_size) != Status::kSuccess) {
+            return -1;
+        }
+
+        cudaError_t result = cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+                &max_active_blocks, Kernel<GemmKernel>,
+                GemmKernel::kThreadCount, smem_size);
+
+        return result == cudaSuccess ? max_active_blocks : -1;
+    }
+
+    /// Returns the number of threadblocks to launch for a group: enough to
+    /// fill the device once, but no more than the number of output tiles when
+    /// host-side problem sizes are given. Returns zero on error.
+    static int sufficient(GemmCoord const* host_problem_sizes = nullptr,
+                          int problem_count = 0,
+                          int available_sm_count = -1) {
+        if (available_sm_count < 0) {
+            int device_idx = 0;
+
+            if (cudaGetDevice(&device_idx) != cudaSuccess) {
+                return 0;
+            }
+
+            if (cudaDeviceGetAttribute(&available_sm_count,
+                                       cudaDevAttrMultiProcessorCount,
+                                       device_idx) != cudaSuccess) {
+                return 0;
+            }
+        }
+
+        int max_active_blocks = maximum_active_blocks();
+
+        if (max_active_blocks <= 0) {
+            return 0;
+        }
+
+        int threadblock_count = available_sm_count * max_active_blocks;
+
+        if (host_problem_sizes) {
+            threadblock_count = std::min(
+                    threadblock_count,
+                    int(ProblemVisitor::group_tile_count(host_problem_sizes,
+                                                         problem_count)));
+        }
+
+        return threadblock_count;
+    }
+
+    /// Initializes GEMM state from arguments.
+    Status initialize(Arguments const& args, void* workspace = nullptr,
+                      cudaStream_t stream = nullptr) {
+        int threadblock_count = args.threadblock_count;
+
+        if (!threadblock_count) {
+            threadblock_count = sufficient();
+
+            if (!threadblock_count) {
+                return Status::kErrorInternal;
+            }
+        }
+
+        // Initialize the Params structure
+        params_ = typename GemmKernel::Params(
+                args.problem_sizes, args.problem_count, threadblock_count,
+                args.epilogue, args.ptr_A, args.ptr_B, args.ptr_C, args.ptr_D,
+                args.lda, args.ldb, args.ldc, args.ldd);
+
+        return Status::kSuccess;
+    }
+
+    /// Lightweight update given a subset of arguments
+    Status update(Arguments const& args, void* workspace = nullptr) {
+        int threadblock_count = args.threadblock_count
+                                        ? args.threadblock_count
+                                        : params_.threadblock_count;
+
+        params_ = typename GemmKernel::Params(
+                args.problem_sizes, args.problem_count, threadblock_count,
+                args.epilogue, args.ptr_A, args.ptr_B, args.ptr_C, args.ptr_D,
+                args.lda, args.ldb, args.ldc, args.ldd);
+
+        return Status::kSuccess;
+    }
+
+    /// Runs the kernel using initialized state.
+    Status run(cudaStream_t stream = nullptr) {
+        // An empty group launches nothing
+        if (!params_.problem_visitor.problem_count) {
+            return Status::kSuccess;
+        }
+
+        dim3 grid(params_.threadblock_count, 1, 1);
+        dim3 block(GemmKernel::kThreadCount, 1, 1);
+
+        cudaError_t result;
+
+        int smem_size = int(sizeof(typename GemmKernel::SharedStorage));
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<GemmKernel>::configure(
+                        smem_size);
+
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
+        }
+
+        cutlass::Kernel<GemmKernel>
+                <<<grid, block, smem_size, stream>>>(params_);
+
+        result = cudaGetLastError();
+
+        return result == cudaSuccess ? Status::kSuccess
+                                     : Status::kErrorInternal;
+    }
+
+    /// Runs the kernel using initialized state.
+    Status operator()(cudaStream_t stream = nullptr) { return run(stream); }
+
+    /// Runs the kernel using initialized state.
+    Status operator()(Arguments const& args, void* workspace = nullptr,
+                      cudaStream_t stream = nullptr) {
+        Status status = initialize(args, workspace, stream);
+
+        if (status == Status::kSuccess) {
+            status = run(stream);
+        }
+
+        return status;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace device
+}  // namespace gemm
+}  // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////
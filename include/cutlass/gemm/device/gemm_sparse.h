@@ -35,6 +35,7 @@
 #include "cutlass/numeric_types.h"
 #include "cutlass/arch/arch.h"
 #include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
 
 #include "cutlass/gemm/threadblock/threadblock_swizzle.h"
 #include "cutlass/gemm/kernel/sparse_gemm.h"
@@ -404,22 +405,12 @@ public:
                 static_cast<int*>(workspace)};
 
         int smem_size = int(sizeof(typename GemmKernel::SharedStorage));
-        if (smem_size >= (48 << 10)) {
-            cudaError_t result = cudaFuncSetAttribute(
-                    Kernel<GemmKernel>,
-                    cudaFuncAttributeMaxDynamicSharedMemorySize, smem_size);
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<GemmKernel>::configure(
+                        smem_size);
 
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
-
-            result = cudaFuncSetAttribute(
-                    Kernel<GemmKernel>,
-                    cudaFuncAttributePreferredSharedMemoryCarveout, 100);
-
-            if (result != cudaSuccess) {
-                return Status::kErrorInternal;
-            }
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
         }
 
         return Status::kSuccess;
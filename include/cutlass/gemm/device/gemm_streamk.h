@@ -0,0 +1,388 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Device-level operator launching a Stream-K GEMM kernel.
+*/
+
+#pragma once
+
+#include <algorithm>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/arch/arch.h"
+#include "cutlass/device_kernel.h"
+#include "cutlass/kernel_attributes.h"
+#include "cutlass/tensor_ref.h"
+
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/kernel/gemm_streamk.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace gemm {
+namespace device {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/*! GemmStreamK device-level operator. Launches a fixed number of persistent
+  threadblocks, by default as many as can be resident on the device at once,
+  which divide the multiply-accumulate iterations of all output tiles evenly
+  (see threadblock::GemmStreamKThreadblockSwizzle).
+
+  Unlike a grid of one threadblock per output tile, no wave is left partially
+  occupied. Output tiles divided among several threadblocks are reduced
+  serially through the destination tensor, as for serial split-K, so the
+  epilogue must support set_k_partition() and partial sums are rounded to
+  ElementC.
+
+  The workspace holds one semaphore per output tile. It is cleared by
+  initialize() and left cleared by each launch.
+
+  Example:
+
+    using GemmKernel = typename cutlass::gemm::kernel::DefaultGemmStreamK<
+      float, cutlass::layout::ColumnMajor, 1,
+      float, cutlass::layout::ColumnMajor, 1,
+      float, cutlass::layout::ColumnMajor,
+      float,
+      cutlass::arch::OpClassSimt,
+      cutlass::arch::Sm50,
+      cutlass::gemm::GemmShape<128, 128, 8>,
+      cutlass::gemm::GemmShape<32, 64, 8>,
+      cutlass::gemm::GemmShape<1, 1, 1>,
+      cutlass::epilogue::thread::LinearCombination<float, 1, float, float>,
+      2,
+      cutlass::arch::OpMultiplyAdd
+    >::GemmKernel;
+
+    cutlass::gemm::device::GemmStreamK<GemmKernel> gemm_op;
+
+    typename cutlass::gemm::device::GemmStreamK<GemmKernel>::Arguments args(
+      {M, N, K},
+      {ptr_A, lda}, {ptr_B, ldb}, {ptr_C, ldc}, {ptr_D, ldd},
+      {alpha, beta});
+
+    cutlass::Status status = gemm_op(args, workspace);
+*/
+template <typename GemmKernel_>
+class GemmStreamK {
+public:
+    using GemmKernel = GemmKernel_;
+
+    using ElementA = typename GemmKernel::ElementA;
+    using LayoutA = typename GemmKernel::LayoutA;
+    using TensorRefA = TensorRef<ElementA const, LayoutA>;
+    using ElementB = typename GemmKernel::ElementB;
+    using LayoutB = typename GemmKernel::LayoutB;
+    using TensorRefB = TensorRef<ElementB const, LayoutB>;
+    using ElementC = typename GemmKernel::ElementC;
+    using LayoutC = typename GemmKernel::LayoutC;
+    using TensorRefC = TensorRef<ElementC const, LayoutC>;
+    using TensorRefD = TensorRef<ElementC, LayoutC>;
+    using ElementAccumulator =
+            typename GemmKernel::Mma::Policy::Operator::ElementC;
+
+    using ThreadblockShape = typename GemmKernel::ThreadblockShape;
+    using WarpShape = typename GemmKernel::WarpShape;
+    using InstructionShape = typename GemmKernel::InstructionShape;
+
+    // warp-level, arch-level (instruction), math operator
+    using WarpMmaOperator = typename GemmKernel::Mma::Policy::Operator;
+    using ArchMmaOperator = typename WarpMmaOperator::ArchMmaOperator;
+    using Operator = typename ArchMmaOperator::Operator;
+
+    // Operator class and arch tag extract bottom-up
+    using OperatorClass = typename WarpMmaOperator::OperatorClass;
+    using ArchTag = typename WarpMmaOperator::ArchTag;
+
+    using EpilogueOutputOp = typename GemmKernel::EpilogueOutputOp;
+    using ThreadblockSwizzle = typename GemmKernel::ThreadblockSwizzle;
+
+    static ComplexTransform const kTransformA = GemmKernel::kTransformA;
+    static ComplexTransform const kTransformB = GemmKernel::kTransformB;
+
+    static int const kStages = GemmKernel::Mma::kStages;
+    static int const kAlignmentA = GemmKernel::kAlignmentA;
+    static int const kAlignmentB = GemmKernel::kAlignmentB;
+    static int const kAlignmentC = GemmKernel::kAlignmentC;
+
+    /// Argument structure
+    struct Arguments {
+        //
+        // Data members
+        //
+
+        GemmCoord problem_size;
+        TensorRefA ref_A;
+        TensorRefB ref_B;
+        TensorRefC ref_C;
+        TensorRefD ref_D;
+        typename EpilogueOutputOp::Params epilogue;
+
+        /// Number of persistent threadblocks; zero launches as many as can be
+        /// resident on the device at once. Larger counts are clamped to that
+        /// number, since a threadblock may wait on higher-indexed ones to
+        /// fix up a tile, which deadlocks unless all are resident.
+        int threadblock_count;
+
+        //
+        // Methods
+        //
+
+        /// Default ctor
+        CUTLASS_HOST_DEVICE
+        Arguments() : problem_size(0, 0, 0), threadblock_count(0) {}
+
+        /// Constructs an Arguments structure
+        CUTLASS_HOST_DEVICE
+        Arguments(GemmCoord problem_size_, TensorRefA ref_A_,
+                  TensorRefB ref_B_, TensorRefC ref_C_, TensorRefD ref_D_,
+                  typename EpilogueOutputOp::Params epilogue_ =
+                          typename EpilogueOutputOp::Params(),
+                  int threadblock_count_ = 0)
+                : problem_size(problem_size_),
+                  ref_A(ref_A_),
+                  ref_B(ref_B_),
+                  ref_C(ref_C_),
+                  ref_D(ref_D_),
+                  epilogue(epilogue_),
+                  threadblock_count(threadblock_count_) {}
+    };
+
+private:
+    /// Kernel parameters object
+    typename GemmKernel::Params params_;
+
+public:
+    /// Constructs the GEMM.
+    GemmStreamK() {}
+
+    /// Determines whether the GEMM can execute the given problem.
+    static Status can_implement(Arguments const& args) {
+        if (args.problem_size.m() < 0 || args.problem_size.n() < 0 ||
+            args.problem_size.k() < 0 || args.threadblock_count < 0) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        if (!TensorRef_aligned(args.ref_A, kAlignmentA) ||
+            !TensorRef_aligned(args.ref_B, kAlignmentB) ||
+            !TensorRef_aligned(args.ref_C, kAlignmentC) ||
+            !TensorRef_aligned(args.ref_D, kAlignmentC)) {
+            return Status::kErrorMisalignedOperand;
+        }
+
+        if ((args.problem_size.m() % kAlignmentA) ||
+            (args.problem_size.k() % kAlignmentA) ||
+            (args.problem_size.n() % kAlignmentB) ||
+            (args.problem_size.k() % kAlignmentB) ||
+            (args.problem_size.m() % kAlignmentC) ||
+            (args.problem_size.n() % kAlignmentC)) {
+            return Status::kErrorMisalignedOperand;
+        }
+
+        return Status::kSuccess;
+    }
+
+    /// Gets the workspace size
+    static size_t get_workspace_size(Arguments const& args) {
+        // One semaphore per output tile of the problem the kernel computes
+        return sizeof(int) *
+               GemmKernel::get_semaphore_count(args.problem_size);
+    }
+
+    /// Computes the maximum number of active blocks per multiprocessor
+    static int maximum_active_blocks() {
+        int max_active_blocks = -1;
+        int smem_size = int(sizeof(typename GemmKernel::SharedStorage));
+
+        if (KernelSharedMemoryConfiguration<GemmKernel>::configure(
+                    smem_size) != Status::kSuccess) {
+            return -1;
+        }
+
+        cudaError_t result = cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+                &max_active_blocks, Kernel<GemmKernel>,
+                GemmKernel::kThreadCount, smem_size);
+
+        return result == cudaSuccess ? max_active_blocks : -1;
+    }
+
+    /// Returns the number of threadblocks able to be resident on the device
+    /// at once. Returns zero on error.
+    static int sufficient(int available_sm_count = -1) {
+        if (available_sm_count < 0) {
+            int device_idx = 0;
+
+            if (cudaGetDevice(&device_idx) != cudaSuccess) {
+                return 0;
+            }
+
+            if (cudaDeviceGetAttribute(&available_sm_count,
+                                       cudaDevAttrMultiProcessorCount,
+                                       device_idx) != cudaSuccess) {
+                return 0;
+            }
+        }
+
+        int max_active_blocks = maximum_active_blocks();
+
+        if (max_active_blocks <= 0) {
+            return 0;
+        }
+
+        return available_sm_count * max_active_blocks;
+    }
+
+    /// Returns the number of threadblocks to launch for a requested count:
+    /// all that can be resident if zero or more are requested. Returns zero
+    /// on error.
+    static int resident_threadblock_count(int threadblock_count) {
+        int resident = sufficient();
+
+        if (!threadblock_count || threadblock_count > resident) {
+            return resident;
+        }
+        return threadblock_count;
+    }
+
+    /// Initializes GEMM state from arguments.
+    Status initialize(Arguments const& args, void* workspace = nullptr,
+                      cudaStream_t stream = nullptr) {
+        int threadblock_count =
+                resident_threadblock_count(args.threadblock_count);
+
+        if (!threadblock_count) {
+            return Status::kErrorInternal;
+        }
+
+        size_t bytes = get_workspace_size(args);
+
+        if (bytes) {
+            if (!workspace) {
+                return Status::kErrorWorkspaceNull;
+            }
+
+            cudaError_t result = cudaMemsetAsync(workspace, 0, bytes, stream);
+
+            if (result != cudaSuccess) {
+                return Status::kErrorInternal;
+            }
+        }
+
+        // Initialize the Params structure
+        params_ = typename GemmKernel::Params(
+                args.problem_size, threadblock_count, args.ref_A.data(),
+                args.ref_A.stride(0), args.ref_B.data(), args.ref_B.stride(0),
+                args.ref_C.data(), args.ref_C.stride(0), args.ref_D.data(),
+                args.ref_D.stride(0), args.epilogue,
+                static_cast<int*>(workspace));
+
+        return Status::kSuccess;
+    }
+
+    /// Lightweight update given a subset of arguments
+    Status update(Arguments const& args, void* workspace = nullptr) {
+        if (get_workspace_size(args) && !workspace) {
+            return Status::kErrorWorkspaceNull;
+        }
+
+        int threadblock_count = params_.swizzle.block_count;
+
+        if (args.threadblock_count) {
+            threadblock_count =
+                    resident_threadblock_count(args.threadblock_count);
+
+            if (!threadblock_count) {
+                return Status::kErrorInternal;
+            }
+        }
+
+        params_ = typename GemmKernel::Params(
+                args.problem_size, threadblock_count, args.ref_A.data(),
+                args.ref_A.stride(0), args.ref_B.data(), args.ref_B.stride(0),
+                args.ref_C.data(), args.ref_C.stride(0), args.ref_D.data(),
+                args.ref_D.stride(0), args.epilogue,
+                static_cast<int*>(workspace));
+
+        return Status::kSuccess;
+    }
+
+    /// Runs the kernel using initialized state.
+    Status run(cudaStream_t stream = nullptr) {
+        // A problem without output tiles launches nothing
+        if (!params_.swizzle.block_count) {
+            return Status::kSuccess;
+        }
+
+        dim3 grid = params_.swizzle.get_grid_shape();
+        dim3 block(GemmKernel::kThreadCount, 1, 1);
+
+        cudaError_t result;
+
+        int smem_size = int(sizeof(typename GemmKernel::SharedStorage));
+        Status attribute_status =
+                KernelSharedMemoryConfiguration<GemmKernel>::configure(
+                        smem_size);
+
+        if (attribute_status != Status::kSuccess) {
+            return attribute_status;
+        }
+
+        cutlass::Kernel<GemmKernel>
+                <<<grid, block, smem_size, stream>>>(params_);
+
+        result = cudaGetLastError();
+
+        return result == cudaSuccess ? Status::kSuccess
+                                     : Status::kErrorInternal;
+    }
+
+    /// Runs the kernel using initialized state.
+    Status operator()(cudaStream_t stream = nullptr) { return run(stream); }
+
+    /// Runs the kernel using initialized state.
+    Status operator()(Arguments const& args, void* workspace = nullptr,
+                      cudaStream_t stream = nullptr) {
+        Status status = initialize(args, workspace, stream);
+
+        if (status == Status::kSuccess) {
+            status = run(stream);
+        }
+
+        return status;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace device
+}  // namespace gemm
+}  // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////
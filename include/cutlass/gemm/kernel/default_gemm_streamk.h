@@ -0,0 +1,211 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief
+      Default kernel-level Stream-K GEMM definitions combine threadblock-scoped
+   matrix multiply-add with the appropriate threadblock-scoped epilogue.
+
+      Column-major outputs are computed as the transpose of a row-major
+   problem by exchanging the A and B operands.
+*/
+
+#pragma once
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/gemm/kernel/default_gemm.h"
+#include "cutlass/gemm/kernel/gemm_streamk.h"
+#include "cutlass/gemm/threadblock/threadblock_swizzle.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace gemm {
+namespace kernel {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <
+        /// Element type for A matrix operand
+        typename ElementA,
+        /// Layout type for A matrix operand
+        typename LayoutA,
+        /// Access granularity of A matrix in units of elements
+        int kAlignmentA,
+        /// Element type for B matrix operand
+        typename ElementB,
+        /// Layout type for B matrix operand
+        typename LayoutB,
+        /// Access granularity of B matrix in units of elements
+        int kAlignmentB,
+        /// Element type for C and D matrix operands
+        typename ElementC,
+        /// Layout type for C and D matrix operands
+        typename LayoutC,
+        /// Element type for internal accumulation
+        typename ElementAccumulator,
+        /// Operator class tag
+        typename OperatorClass,
+        /// Tag indicating architecture to tune for
+        typename ArchTag,
+        /// Threadblock-level tile size (concept: GemmShape)
+        typename ThreadblockShape,
+        /// Warp-level tile size (concept: GemmShape)
+        typename WarpShape,
+        /// Warp-level tile size (concept: GemmShape)
+        typename InstructionShape,
+        /// Epilogue output operator
+        typename EpilogueOutputOp,
+        /// Number of stages used in the pipelined mainloop
+        int Stages,
+        /// Operation performed by GEMM
+        typename Operator>
+struct DefaultGemmStreamK;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Partial specialization for row-major output
+template <
+        /// Element type for A matrix operand
+        typename ElementA,
+        /// Layout type for A matrix operand
+        typename LayoutA,
+        /// Access granularity of A matrix in units of elements
+        int kAlignmentA,
+        /// Element type for B matrix operand
+        typename ElementB,
+        /// Layout type for B matrix operand
+        typename LayoutB,
+        /// Access granularity of B matrix in units of elements
+        int kAlignmentB,
+        /// Element type for C and D matrix operands
+        typename ElementC,
+        /// Element type for internal accumulation
+        typename ElementAccumulator,
+        /// Operator class tag
+        typename OperatorClass,
+        /// Tag indicating architecture to tune for
+        typename ArchTag,
+        /// Threadblock-level tile size (concept: GemmShape)
+        typename ThreadblockShape,
+        /// Warp-level tile size (concept: GemmShape)
+        typename WarpShape,
+        /// Warp-level tile size (concept: GemmShape)
+        typename InstructionShape,
+        /// Epilogue output operator
+        typename EpilogueOutputOp,
+        /// Number of stages used in the pipelined mainloop
+        int Stages,
+        /// Operation performed by GEMM
+        typename Operator>
+struct DefaultGemmStreamK<ElementA, LayoutA, kAlignmentA, ElementB, LayoutB,
+                          kAlignmentB, ElementC, layout::RowMajor,
+                          ElementAccumulator, OperatorClass, ArchTag,
+                          ThreadblockShape, WarpShape, InstructionShape,
+                          EpilogueOutputOp, Stages, Operator> {
+    using DefaultGemmKernel = typename kernel::DefaultGemm<
+            ElementA, LayoutA, kAlignmentA, ElementB, LayoutB, kAlignmentB,
+            ElementC, layout::RowMajor, ElementAccumulator, OperatorClass,
+            ArchTag, ThreadblockShape, WarpShape, InstructionShape,
+            EpilogueOutputOp, threadblock::GemmStreamKThreadblockSwizzle,
+            Stages, false, Operator>::GemmKernel;
+
+    /// Define the kernel in terms of the default kernel
+    using GemmKernel = kernel::GemmStreamK<
+            typename DefaultGemmKernel::Mma,
+            typename DefaultGemmKernel::Epilogue,
+            threadblock::GemmStreamKThreadblockSwizzle, false>;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Partial specialization for column-major output exchanges the operands and
+/// computes the transpose of the problem.
+template <
+        /// Element type for A matrix operand
+        typename ElementA,
+        /// Layout type for A matrix operand
+        typename LayoutA,
+        /// Access granularity of A matrix in units of elements
+        int kAlignmentA,
+        /// Element type for B matrix operand
+        typename ElementB,
+        /// Layout type for B matrix operand
+        typename LayoutB,
+        /// Access granularity of B matrix in units of elements
+        int kAlignmentB,
+        /// Element type for C and D matrix operands
+        typename ElementC,
+        /// Element type for internal accumulation
+        typename ElementAccumulator,
+        /// Operator class tag
+        typename OperatorClass,
+        /// Tag indicating architecture to tune for
+        typename ArchTag,
+        /// Threadblock-level tile size (concept: GemmShape)
+        typename ThreadblockShape,
+        /// Warp-level tile size (concept: GemmShape)
+        typename WarpShape,
+        /// Warp-level tile size (concept: GemmShape)
+        typename InstructionShape,
+        /// Epilogue output operator
+        typename EpilogueOutputOp,
+        /// Number of stages used in the pipelined mainloop
+        int Stages,
+        /// Operation performed by GEMM
+        typename Operator>
+struct DefaultGemmStreamK<ElementA, LayoutA, kAlignmentA, ElementB, LayoutB,
+                          kAlignmentB, ElementC, layout::ColumnMajor,
+                          ElementAccumulator, OperatorClass, ArchTag,
+                          ThreadblockShape, WarpShape, InstructionShape,
+                          EpilogueOutputOp, Stages, Operator> {
+    using DefaultGemmKernel = typename kernel::DefaultGemm<
+            ElementB, typename layout::LayoutTranspose<LayoutB>::type,
+            kAlignmentB, ElementA,
+            typename layout::LayoutTranspose<LayoutA>::type, kAlignmentA,
+            ElementC, layout::RowMajor, ElementAccumulator, OperatorClass,
+            ArchTag, ThreadblockShape, WarpShape, InstructionShape,
+            EpilogueOutputOp, threadblock::GemmStreamKThreadblockSwizzle,
+            Stages, false, Operator>::GemmKernel;
+
+    /// Define the kernel in terms of the default kernel
+    using GemmKernel = kernel::GemmStreamK<
+            typename DefaultGemmKernel::Mma,
+            typename DefaultGemmKernel::Epilogue,
+            threadblock::GemmStreamKThreadblockSwizzle, true>;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace kernel
+}  // namespace gemm
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,312 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Persistent GEMM kernel computing a group of independent problems of
+   different shapes in one launch.
+*/
+
+#pragma once
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/complex.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/matrix_coord.h"
+#include "cutlass/platform/platform.h"
+
+#include "cutlass/gemm/kernel/gemm_grouped_problem_visitor.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace gemm {
+namespace kernel {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Mma_,  ///! Threadblock-scoped matrix multiply-accumulate
+          typename Epilogue_,            ///! Epilogue
+          typename ThreadblockSwizzle_,  ///! Threadblock swizzling function
+          bool Transposed = false  ///! If true, computes the transpose of
+                                   ///! each problem with A and B exchanged
+          >
+struct GemmGrouped {
+    using Mma = Mma_;
+    using Epilogue = Epilogue_;
+    using OutputOp = typename Epilogue::OutputOp;
+    using EpilogueOutputOp = OutputOp;
+    using ThreadblockSwizzle = ThreadblockSwizzle_;
+    using ThreadblockShape = typename Mma::Shape;
+    using WarpShape = typename Mma::Operator::Shape;
+    using InstructionShape = typename Mma::Policy::Operator::InstructionShape;
+    static bool const kTransposed = Transposed;
+
+    /// Operand types as seen by the caller. Computing the transpose of a
+    /// problem with a row-major output exchanges the roles of A and B.
+    using ElementA = typename platform::conditional<
+            kTransposed, typename Mma::IteratorB::Element,
+            typename Mma::IteratorA::Element>::type;
+    using LayoutA = typename platform::conditional<
+            kTransposed,
+            typename layout::LayoutTranspose<
+                    typename Mma::IteratorB::Layout>::type,
+            typename Mma::IteratorA::Layout>::type;
+    using ElementB = typename platform::conditional<
+            kTransposed, typename Mma::IteratorA::Element,
+            typename Mma::IteratorB::Element>::type;
+    using LayoutB = typename platform::conditional<
+            kTransposed,
+            typename layout::LayoutTranspose<
+                    typename Mma::IteratorA::Layout>::type,
+            typename Mma::IteratorB::Layout>::type;
+    using ElementC = typename Epilogue::OutputTileIterator::Element;
+    using LayoutC = typename platform::conditional<
+            kTransposed,
+            typename layout::LayoutTranspose<
+                    typename Epilogue::OutputTileIterator::Layout>::type,
+            typename Epilogue::OutputTileIterator::Layout>::type;
+
+    static ComplexTransform const kTransformA =
+            kTransposed ? Mma::kTransformB : Mma::kTransformA;
+    static ComplexTransform const kTransformB =
+            kTransposed ? Mma::kTransformA : Mma::kTransformB;
+
+    static int const kAlignmentA = kTransposed
+                                           ? Mma::IteratorB::AccessType::kElements
+                                           : Mma::IteratorA::AccessType::kElements;
+    static int const kAlignmentB = kTransposed
+                                           ? Mma::IteratorA::AccessType::kElements
+                                           : Mma::IteratorB::AccessType::kElements;
+    static int const kAlignmentC =
+            Epilogue::OutputTileIterator::kElementsPerAccess;
+
+    using ProblemVisitor =
+            GemmGroupedProblemVisitor<ThreadblockShape, kTransposed>;
+
+    /// Warp count (concept: GemmShape)
+    using WarpCount = typename Mma::WarpCount;
+    static int const kThreadCount = 32 * WarpCount::kCount;
+
+    /// Parameters structure
+    struct Params {
+        typename ProblemVisitor::Params problem_visitor;
+        int threadblock_count;
+
+        typename OutputOp::Params epilogue;
+
+        ElementA const* const* ptr_A;
+        ElementB const* const* ptr_B;
+        ElementC const* const* ptr_C;
+        ElementC* const* ptr_D;
+
+        int64_t const* lda;
+        int64_t const* ldb;
+        int64_t const* ldc;
+        int64_t const* ldd;
+
+        //
+        // Methods
+        //
+
+        CUTLASS_HOST_DEVICE
+        Params()
+                : threadblock_count(0),
+                  ptr_A(nullptr),
+                  ptr_B(nullptr),
+                  ptr_C(nullptr),
+                  ptr_D(nullptr),
+                  lda(nullptr),
+                  ldb(nullptr),
+                  ldc(nullptr),
+                  ldd(nullptr) {}
+
+        CUTLASS_HOST_DEVICE
+        Params(GemmCoord const* problem_sizes_, int problem_count_,
+               int threadblock_count_, typename OutputOp::Params epilogue_,
+               ElementA const* const* ptr_A_, ElementB const* const* ptr_B_,
+               ElementC const* const* ptr_C_, ElementC* const* ptr_D_,
+               int64_t const* lda_, int64_t const* ldb_, int64_t const* ldc_,
+               int64_t const* ldd_)
+                : problem_visitor(problem_sizes_, problem_count_),
+                  threadblock_count(threadblock_count_),
+                  epilogue(epilogue_),
+                  ptr_A(ptr_A_),
+                  ptr_B(ptr_B_),
+                  ptr_C(ptr_C_),
+                  ptr_D(ptr_D_),
+                  lda(lda_),
+                  ldb(ldb_),
+                  ldc(ldc_),
+                  ldd(ldd_) {}
+    };
+
+    /// Shared memory storage structure
+    union SharedStorage {
+        typename Mma::SharedStorage main_loop;
+        typename Epilogue::SharedStorage epilogue;
+    };
+
+    //
+    // Methods
+    //
+
+    CUTLASS_HOST_DEVICE
+    GemmGrouped() {}
+
+    /// Executes the tiles of every problem assigned to this threadblock
+    CUTLASS_DEVICE
+    void operator()(Params const& params, SharedStorage& shared_storage) {
+        using MmaElementA = typename Mma::IteratorA::Element;
+        using MmaElementB = typename Mma::IteratorB::Element;
+        using MmaLayoutA = typename Mma::IteratorA::Layout;
+        using MmaLayoutB = typename Mma::IteratorB::Layout;
+        using OutputLayout = typename Epilogue::OutputTileIterator::Layout;
+
+        ProblemVisitor problem_visitor(params.problem_visitor, blockIdx.x);
+
+        // Compute position within threadblock
+        int thread_idx = threadIdx.x;
+
+        // Broadcast the warp_id computed by lane 0 to ensure dependent code
+        // is compiled as warp-uniform.
+        int warp_idx = __shfl_sync(0xffffffff, threadIdx.x / 32, 0);
+
+        int lane_idx = threadIdx.x % 32;
+
+        // Persistent loop over the tiles of all problems
+        while (problem_visitor.next_tile()) {
+            GemmCoord problem_size = problem_visitor.problem_size();
+            int32_t problem_idx = problem_visitor.problem_index();
+
+            GemmCoord threadblock_tile_offset =
+                    problem_visitor.threadblock_tile_offset();
+
+            // Exchange the operands when computing the transposed problem
+            MmaElementA* ptr_A = const_cast<MmaElementA*>(
+                    reinterpret_cast<MmaElementA const*>(
+                            kTransposed ? static_cast<void const*>(
+                                                  params.ptr_B[problem_idx])
+                                        : static_cast<void const*>(
+                                                  params.ptr_A[problem_idx])));
+
+            MmaElementB* ptr_B = const_cast<MmaElementB*>(
+                    reinterpret_cast<MmaElementB const*>(
+                            kTransposed ? static_cast<void const*>(
+                                                  params.ptr_A[problem_idx])
+                                        : static_cast<void const*>(
+                                                  params.ptr_B[problem_idx])));
+
+            int64_t ld_A = kTransposed ? params.ldb[problem_idx]
+                                       : params.lda[problem_idx];
+            int64_t ld_B = kTransposed ? params.lda[problem_idx]
+                                       : params.ldb[problem_idx];
+
+            // Compute initial location in logical coordinates
+            cutlass::MatrixCoord tb_offset_A{
+                    threadblock_tile_offset.m() * Mma::Shape::kM, 0};
+
+            cutlass::MatrixCoord tb_offset_B{
+                    0, threadblock_tile_offset.n() * Mma::Shape::kN};
+
+            // Construct iterators to A and B operands
+            typename Mma::IteratorA iterator_A(
+                    typename Mma::IteratorA::Params(MmaLayoutA(
+                            typename MmaLayoutA::Index(ld_A))),
+                    ptr_A, problem_size.mk(), thread_idx, tb_offset_A);
+
+            typename Mma::IteratorB iterator_B(
+                    typename Mma::IteratorB::Params(MmaLayoutB(
+                            typename MmaLayoutB::Index(ld_B))),
+                    ptr_B, problem_size.kn(), thread_idx, tb_offset_B);
+
+            // The previous tile's epilogue may still be reading shared
+            // memory that the main loop is about to overwrite.
+            __syncthreads();
+
+            //
+            // Main loop
+            //
+
+            Mma mma(shared_storage.main_loop, thread_idx, warp_idx, lane_idx);
+
+            typename Mma::FragmentC accumulators;
+
+            accumulators.clear();
+
+            int gemm_k_iterations =
+                    (problem_size.k() + Mma::Shape::kK - 1) / Mma::Shape::kK;
+
+            // Compute threadblock-scoped matrix multiply-add
+            mma(gemm_k_iterations, accumulators, iterator_A, iterator_B,
+                accumulators);
+
+            //
+            // Epilogue
+            //
+
+            OutputOp output_op(params.epilogue);
+
+            MatrixCoord threadblock_offset(
+                    threadblock_tile_offset.m() * Mma::Shape::kM,
+                    threadblock_tile_offset.n() * Mma::Shape::kN);
+
+            // Tile iterator reading from source tile
+            typename Epilogue::OutputTileIterator iterator_C(
+                    typename Epilogue::OutputTileIterator::Params(OutputLayout(
+                            typename OutputLayout::Index(
+                                    params.ldc[problem_idx]))),
+                    const_cast<ElementC*>(params.ptr_C[problem_idx]),
+                    problem_size.mn(), thread_idx, threadblock_offset);
+
+            // Tile iterator writing to output tile
+            typename Epilogue::OutputTileIterator iterator_D(
+                    typename Epilogue::OutputTileIterator::Params(OutputLayout(
+                            typename OutputLayout::Index(
+                                    params.ldd[problem_idx]))),
+                    params.ptr_D[problem_idx], problem_size.mn(), thread_idx,
+                    threadblock_offset);
+
+            Epilogue epilogue(shared_storage.epilogue, thread_idx, warp_idx,
+                              lane_idx);
+
+            // run efficient epilogue
+            epilogue(output_op, iterator_D, accumulators, iterator_C);
+
+            // Next tile
+            problem_visitor.advance(gridDim.x);
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace kernel
+}  // namespace gemm
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,223 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Maps the threadblocks of a persistent grouped GEMM kernel onto the
+   tiles of many independent GEMM problems.
+*/
+
+#pragma once
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/matrix_coord.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace gemm {
+namespace kernel {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Visits the tiles of a group of GEMM problems on behalf of one threadblock.
+//
+// The output tiles of all problems form a single linear index space in which
+// problem i owns the tiles [start_i, start_i + tiles_i). Threadblock b visits
+// linear tiles b, b + G, b + 2G, ... for a grid of G threadblocks, so every
+// tile is computed exactly once regardless of how many problems there are or
+// how their shapes differ. Tiles within a problem are numbered in row-major
+// order of the problem's tiled M-by-N grid.
+//
+// Each threadblock scans the problem sizes forward only, so the cost of
+// locating the owning problem is amortized across the tiles it computes. All
+// methods are callable from the host to simulate the schedule without a GPU.
+template <
+        /// Threadblock-level tile size (concept: GemmShape)
+        typename ThreadblockShape_,
+        /// If true, tiles cover the transpose (N-by-M) of each problem
+        bool Transposed = false>
+struct GemmGroupedProblemVisitor {
+    using ThreadblockShape = ThreadblockShape_;
+    static bool const kTransposed = Transposed;
+
+    /// Parameters structure
+    struct Params {
+        /// Size of each problem
+        GemmCoord const* problem_sizes;
+
+        /// Number of problems
+        int32_t problem_count;
+
+        //
+        // Methods
+        //
+
+        CUTLASS_HOST_DEVICE
+        Params() : problem_sizes(nullptr), problem_count(0) {}
+
+        CUTLASS_HOST_DEVICE
+        Params(GemmCoord const* problem_sizes_, int32_t problem_count_)
+                : problem_sizes(problem_sizes_),
+                  problem_count(problem_count_) {}
+    };
+
+    //
+    // Data members
+    //
+
+    Params const& params;
+
+    /// Linear index of the tile currently visited
+    int32_t tile_idx;
+
+    /// Index of the problem owning tile_idx
+    int32_t problem_idx;
+
+    /// Linear index of the first tile of problem_idx
+    int32_t problem_tile_start;
+
+    /// Number of tiles of problem_idx
+    int32_t problem_tile_count;
+
+    //
+    // Methods
+    //
+
+    /// Starts the visit at the tile whose linear index equals block_idx
+    CUTLASS_HOST_DEVICE
+    GemmGroupedProblemVisitor(Params const& params_, int32_t block_idx)
+            : params(params_),
+              tile_idx(block_idx),
+              problem_idx(0),
+              problem_tile_start(0),
+              problem_tile_count(0) {
+        if (params.problem_count > 0) {
+            problem_tile_count = tile_count(problem_size(0));
+        }
+    }
+
+    /// Returns the size of a problem as computed by the kernel
+    CUTLASS_HOST_DEVICE
+    GemmCoord problem_size(int32_t idx) const {
+        GemmCoord problem = params.problem_sizes[idx];
+
+        if (kTransposed) {
+            return GemmCoord(problem.n(), problem.m(), problem.k());
+        }
+
+        return problem;
+    }
+
+    /// Returns the number of tiles along the M and N dimensions of a problem
+    CUTLASS_HOST_DEVICE
+    static GemmCoord grid_shape(GemmCoord const& problem) {
+        return GemmCoord(
+                (problem.m() + ThreadblockShape::kM - 1) / ThreadblockShape::kM,
+                (problem.n() + ThreadblockShape::kN - 1) / ThreadblockShape::kN,
+                1);
+    }
+
+    /// Returns the number of output tiles of a problem
+    CUTLASS_HOST_DEVICE
+    static int32_t tile_count(GemmCoord const& problem) {
+        GemmCoord grid = grid_shape(problem);
+        return grid.m() * grid.n();
+    }
+
+    /// Returns the number of output tiles of all problems
+    CUTLASS_HOST_DEVICE
+    static int32_t group_tile_count(GemmCoord const* problem_sizes,
+                                    int32_t problem_count) {
+        int32_t total = 0;
+
+        for (int32_t idx = 0; idx < problem_count; ++idx) {
+            GemmCoord problem = problem_sizes[idx];
+
+            if (kTransposed) {
+                problem = GemmCoord(problem.n(), problem.m(), problem.k());
+            }
+
+            total += tile_count(problem);
+        }
+
+        return total;
+    }
+
+    /// Locates the problem owning the current tile. Returns false once the
+    /// tiles of every problem have been visited.
+    CUTLASS_HOST_DEVICE
+    bool next_tile() {
+        while (problem_idx < params.problem_count) {
+            if (tile_idx < problem_tile_start + problem_tile_count) {
+                return true;
+            }
+
+            problem_tile_start += problem_tile_count;
+            ++problem_idx;
+
+            if (problem_idx < params.problem_count) {
+                problem_tile_count = tile_count(problem_size(problem_idx));
+            }
+        }
+
+        return false;
+    }
+
+    /// Moves to the next tile of this threadblock
+    CUTLASS_HOST_DEVICE
+    void advance(int32_t grid_size) { tile_idx += grid_size; }
+
+    /// Index of the problem owning the current tile
+    CUTLASS_HOST_DEVICE
+    int32_t problem_index() const { return problem_idx; }
+
+    /// Size of the problem owning the current tile
+    CUTLASS_HOST_DEVICE
+    GemmCoord problem_size() const { return problem_size(problem_idx); }
+
+    /// Index of the current tile within its problem
+    CUTLASS_HOST_DEVICE
+    int32_t threadblock_index() const { return tile_idx - problem_tile_start; }
+
+    /// Coordinate of the current tile within its problem, in units of tiles
+    CUTLASS_HOST_DEVICE
+    GemmCoord threadblock_tile_offset() const {
+        int32_t grid_n = grid_shape(problem_size()).n();
+        int32_t idx = threadblock_index();
+
+        return GemmCoord(idx / grid_n, idx % grid_n, 0);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace kernel
+}  // namespace gemm
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,394 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Stream-K GEMM kernel. A fixed number of persistent threadblocks
+   divide the multiply-accumulate iterations of all output tiles evenly, and
+   tiles shared by several threadblocks are reduced serially.
+*/
+
+#pragma once
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/complex.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/matrix_coord.h"
+#include "cutlass/platform/platform.h"
+#include "cutlass/semaphore.h"
+
+#include "cutlass/gemm/threadblock/threadblock_swizzle.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace gemm {
+namespace kernel {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Mma_,  ///! Threadblock-scoped matrix multiply-accumulate
+          typename Epilogue_,  ///! Epilogue
+          typename ThreadblockSwizzle_ =
+                  threadblock::GemmStreamKThreadblockSwizzle,  ///! Stream-K
+                                                               ///! partitioning
+          bool Transposed = false  ///! If true, computes the transpose of the
+                                   ///! problem with A and B exchanged
+          >
+struct GemmStreamK {
+    using Mma = Mma_;
+    using Epilogue = Epilogue_;
+    using OutputOp = typename Epilogue::OutputOp;
+    using EpilogueOutputOp = OutputOp;
+    using ThreadblockSwizzle = ThreadblockSwizzle_;
+    using ThreadblockShape = typename Mma::Shape;
+    using WarpShape = typename Mma::Operator::Shape;
+    using InstructionShape = typename Mma::Policy::Operator::InstructionShape;
+    static bool const kTransposed = Transposed;
+
+    /// Operand types as seen by the caller. Computing the transpose of a
+    /// problem with a row-major output exchanges the roles of A and B.
+    using ElementA = typename platform::conditional<
+            kTransposed, typename Mma::IteratorB::Element,
+            typename Mma::IteratorA::Element>::type;
+    using LayoutA = typename platform::conditional<
+            kTransposed,
+            typename layout::LayoutTranspose<
+                    typename Mma::IteratorB::Layout>::type,
+            typename Mma::IteratorA::Layout>::type;
+    using ElementB = typename platform::conditional<
+            kTransposed, typename Mma::IteratorA::Element,
+            typename Mma::IteratorB::Element>::type;
+    using LayoutB = typename platform::conditional<
+            kTransposed,
+            typename layout::LayoutTranspose<
+                    typename Mma::IteratorA::Layout>::type,
+            typename Mma::IteratorB::Layout>::type;
+    using ElementC = typename Epilogue::OutputTileIterator::Element;
+    using LayoutC = typename platform::conditional<
+            kTransposed,
+            typename layout::LayoutTranspose<
+                    typename Epilogue::OutputTileIterator::Layout>::type,
+            typename Epilogue::OutputTileIterator::Layout>::type;
+
+    static ComplexTransform const kTransformA =
+            kTransposed ? Mma::kTransformB : Mma::kTransformA;
+    static ComplexTransform const kTransformB =
+            kTransposed ? Mma::kTransformA : Mma::kTransformB;
+
+    static int const kAlignmentA = kTransposed
+                                           ? Mma::IteratorB::AccessType::kElements
+                                           : Mma::IteratorA::AccessType::kElements;
+    static int const kAlignmentB = kTransposed
+                                           ? Mma::IteratorA::AccessType::kElements
+                                           : Mma::IteratorB::AccessType::kElements;
+    static int const kAlignmentC =
+            Epilogue::OutputTileIterator::kElementsPerAccess;
+
+    /// Warp count (concept: GemmShape)
+    using WarpCount = typename Mma::WarpCount;
+    static int const kThreadCount = 32 * WarpCount::kCount;
+
+    /// Parameters structure
+    struct Params {
+        /// Problem size as computed by the kernel, after any transposition
+        cutlass::gemm::GemmCoord problem_size;
+        ThreadblockSwizzle swizzle;
+        typename Mma::IteratorA::Params params_A;
+        typename Mma::IteratorA::Element* ptr_A;
+        typename Mma::IteratorB::Params params_B;
+        typename Mma::IteratorB::Element* ptr_B;
+        typename Epilogue::OutputTileIterator::Params params_C;
+        ElementC* ptr_C;
+        typename Epilogue::OutputTileIterator::Params params_D;
+        ElementC* ptr_D;
+        typename OutputOp::Params output_op;
+        int* semaphore;
+
+        //
+        // Methods
+        //
+
+        CUTLASS_HOST_DEVICE
+        Params()
+                : ptr_A(nullptr),
+                  ptr_B(nullptr),
+                  ptr_C(nullptr),
+                  ptr_D(nullptr),
+                  semaphore(nullptr) {}
+
+        /// Constructs the parameters of a problem given in the caller's view
+        CUTLASS_HOST_DEVICE
+        Params(cutlass::gemm::GemmCoord const& problem_size_,
+               int threadblock_count, ElementA const* ptr_A_, int64_t lda,
+               ElementB const* ptr_B_, int64_t ldb, ElementC const* ptr_C_,
+               int64_t ldc, ElementC* ptr_D_, int64_t ldd,
+               typename OutputOp::Params output_op_ =
+                       typename OutputOp::Params(),
+               int* workspace = nullptr)
+                : problem_size(kernel_problem_size(problem_size_)),
+                  swizzle(problem_size,
+                          {ThreadblockShape::kM, ThreadblockShape::kN,
+                           ThreadblockShape::kK},
+                          threadblock_count),
+                  params_A(typename Mma::IteratorA::Layout(
+                          typename Mma::IteratorA::Layout::Index(
+                                  kTransposed ? ldb : lda))),
+                  ptr_A(const_cast<typename Mma::IteratorA::Element*>(
+                          reinterpret_cast<
+                                  typename Mma::IteratorA::Element const*>(
+                                  kTransposed
+                                          ? static_cast<void const*>(ptr_B_)
+                                          : static_cast<void const*>(
+                                                    ptr_A_)))),
+                  params_B(typename Mma::IteratorB::Layout(
+                          typename Mma::IteratorB::Layout::Index(
+                                  kTransposed ? lda : ldb))),
+                  ptr_B(const_cast<typename Mma::IteratorB::Element*>(
+                          reinterpret_cast<
+                                  typename Mma::IteratorB::Element const*>(
+                                  kTransposed
+                                          ? static_cast<void const*>(ptr_A_)
+                                          : static_cast<void const*>(
+                                                    ptr_B_)))),
+                  params_C(typename Epilogue::OutputTileIterator::Layout(
+                          typename Epilogue::OutputTileIterator::Layout::Index(
+                                  ldc))),
+                  ptr_C(const_cast<ElementC*>(ptr_C_)),
+                  params_D(typename Epilogue::OutputTileIterator::Layout(
+                          typename Epilogue::OutputTileIterator::Layout::Index(
+                                  ldd))),
+                  ptr_D(ptr_D_),
+                  output_op(output_op_),
+                  semaphore(workspace) {}
+    };
+
+    /// Shared memory storage structure
+    union SharedStorage {
+        typename Mma::SharedStorage main_loop;
+        typename Epilogue::SharedStorage epilogue;
+    };
+
+    //
+    // Methods
+    //
+
+    CUTLASS_HOST_DEVICE
+    GemmStreamK() {}
+
+    /// Returns the problem computed by the kernel for a problem given in the
+    /// caller's view
+    CUTLASS_HOST_DEVICE
+    static cutlass::gemm::GemmCoord kernel_problem_size(
+            cutlass::gemm::GemmCoord const& problem_size) {
+        return kTransposed ? cutlass::gemm::GemmCoord(problem_size.n(),
+                                                      problem_size.m(),
+                                                      problem_size.k())
+                           : problem_size;
+    }
+
+    /// Returns the number of semaphores needed to reduce the output tiles of
+    /// a problem given in the caller's view, independent of the threadblock
+    /// count
+    static size_t get_semaphore_count(
+            cutlass::gemm::GemmCoord const& problem_size) {
+        ThreadblockSwizzle swizzle(kernel_problem_size(problem_size),
+                                   {ThreadblockShape::kM, ThreadblockShape::kN,
+                                    ThreadblockShape::kK},
+                                   1);
+
+        return size_t(swizzle.get_tile_count());
+    }
+
+    /// Executes the range of iterations assigned to this threadblock
+    CUTLASS_DEVICE
+    void operator()(Params const& params, SharedStorage& shared_storage) {
+        ThreadblockSwizzle const& swizzle = params.swizzle;
+
+        int block_idx = blockIdx.x;
+
+        int iter = swizzle.get_block_iter_begin(block_idx);
+        int block_iter_end = swizzle.get_block_iter_end(block_idx);
+
+        // Compute position within threadblock
+        int thread_idx = threadIdx.x;
+
+        // Broadcast the warp_id computed by lane 0 to ensure dependent code
+        // is compiled as warp-uniform.
+        int warp_idx = __shfl_sync(0xffffffff, threadIdx.x / 32, 0);
+
+        int lane_idx = threadIdx.x % 32;
+
+        // Each pass computes the part of one output tile falling within this
+        // threadblock's range
+        while (iter < block_iter_end) {
+            int tile_idx = swizzle.get_tile_idx(iter);
+            int tile_iter_begin = swizzle.get_tile_iter_begin(tile_idx);
+            int tile_iter_end = swizzle.get_tile_iter_end(tile_idx);
+            int segment_iter_end = min(block_iter_end, tile_iter_end);
+
+            cutlass::gemm::GemmCoord threadblock_tile_offset =
+                    swizzle.get_tile_offset(tile_idx);
+
+            // K extent of this partition of the tile
+            int problem_k_begin = (iter - tile_iter_begin) * Mma::Shape::kK;
+            int problem_size_k =
+                    min(params.problem_size.k(),
+                        (segment_iter_end - tile_iter_begin) * Mma::Shape::kK);
+
+            // Compute initial location in logical coordinates
+            cutlass::MatrixCoord tb_offset_A{
+                    threadblock_tile_offset.m() * Mma::Shape::kM,
+                    problem_k_begin};
+
+            cutlass::MatrixCoord tb_offset_B{
+                    problem_k_begin,
+                    threadblock_tile_offset.n() * Mma::Shape::kN};
+
+            // Construct iterators to A and B operands
+            typename Mma::IteratorA iterator_A(
+                    params.params_A, params.ptr_A,
+                    {params.problem_size.m(), problem_size_k}, thread_idx,
+                    tb_offset_A);
+
+            typename Mma::IteratorB iterator_B(
+                    params.params_B, params.ptr_B,
+                    {problem_size_k, params.problem_size.n()}, thread_idx,
+                    tb_offset_B);
+
+            // The previous tile's epilogue may still be reading shared
+            // memory that the main loop is about to overwrite.
+            __syncthreads();
+
+            //
+            // Main loop
+            //
+
+            Mma mma(shared_storage.main_loop, thread_idx, warp_idx, lane_idx);
+
+            typename Mma::FragmentC accumulators;
+
+            accumulators.clear();
+
+            int gemm_k_iterations =
+                    (problem_size_k - problem_k_begin + Mma::Shape::kK - 1) /
+                    Mma::Shape::kK;
+
+            if (gemm_k_iterations > 0) {
+                // Compute threadblock-scoped matrix multiply-add
+                mma(gemm_k_iterations, accumulators, iterator_A, iterator_B,
+                    accumulators);
+            }
+
+            //
+            // Epilogue
+            //
+
+            OutputOp output_op(params.output_op);
+
+            int partition_count = swizzle.get_partition_count(tile_idx);
+            int partition_idx = swizzle.get_partition_idx(tile_idx, block_idx);
+
+            // Construct the semaphore.
+            Semaphore semaphore(params.semaphore + tile_idx, thread_idx);
+
+            // If the tile is shared with other threadblocks, fetch the
+            // initial synchronization
+            if (partition_count > 1) {
+                // Fetch the synchronization lock initially but do not block.
+                semaphore.fetch();
+
+                // Indicate which position in the serial reduction the output
+                // operator is currently updating
+                output_op.set_k_partition(partition_idx, partition_count);
+            }
+
+            MatrixCoord threadblock_offset(
+                    threadblock_tile_offset.m() * Mma::Shape::kM,
+                    threadblock_tile_offset.n() * Mma::Shape::kN);
+
+            // Tile iterator loading from source tensor.
+            typename Epilogue::OutputTileIterator iterator_C(
+                    params.params_C, params.ptr_C, params.problem_size.mn(),
+                    thread_idx, threadblock_offset);
+
+            // Tile iterator writing to destination tensor.
+            typename Epilogue::OutputTileIterator iterator_D(
+                    params.params_D, params.ptr_D, params.problem_size.mn(),
+                    thread_idx, threadblock_offset);
+
+            Epilogue epilogue(shared_storage.epilogue, thread_idx, warp_idx,
+                              lane_idx);
+
+            // Wait on the semaphore - this latency may have been covered by
+            // the main loop of this threadblock
+            if (partition_count > 1) {
+                // For subsequent partitions, the source matrix is held in
+                // the 'D' tensor.
+                if (partition_idx) {
+                    iterator_C = iterator_D;
+                }
+
+                semaphore.wait(partition_idx);
+
+                __threadfence();
+            }
+
+            // Execute the epilogue operator to update the destination tensor.
+            epilogue(output_op, iterator_D, accumulators, iterator_C);
+
+            //
+            // Release the semaphore
+            //
+
+            if (partition_count > 1) {
+                int lock = 0;
+                if (partition_count == partition_idx + 1) {
+                    // The final partition resets the semaphore for
+                    // subsequent grids.
+                    lock = 0;
+                } else {
+                    // Otherwise, the semaphore is incremented
+                    lock = partition_idx + 1;
+                }
+
+                __threadfence();
+                semaphore.release(lock);
+            }
+
+            iter = segment_iter_end;
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace kernel
+}  // namespace gemm
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
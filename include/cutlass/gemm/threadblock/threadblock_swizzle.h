@@ -275,6 +275,166 @@ struct GemmSplitKHorizontalThreadblockSwizzle {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Threadblock swizzling function for Stream-K GEMMs.
+///
+/// A fixed number of persistent threadblocks divide the problem's
+/// multiply-accumulate iterations evenly among themselves. Iterations are
+/// linearized tile by tile, with the K iterations of each output tile
+/// contiguous, so each threadblock computes a contiguous range spanning one or
+/// more whole or partial tiles. Threadblock counts differ by at most one
+/// iteration, avoiding the partially occupied last wave of a grid launching
+/// one threadblock per tile.
+///
+/// A tile whose iterations are divided among several threadblocks is reduced
+/// serially through the output tensor, as for serial split-K. Each of its
+/// partitions is assigned a position in the reduction such that a threadblock
+/// only ever waits on threadblocks of higher index.
+struct GemmStreamKThreadblockSwizzle {
+    /// Shape of the problem in units of logical tiles
+    GemmCoord tiled_shape;
+
+    /// Number of multiply-accumulate iterations per output tile
+    int iters_per_tile;
+
+    /// Number of threadblocks launched
+    int block_count;
+
+    /// Minimum number of iterations computed by each threadblock
+    int iters_per_block;
+
+    /// Number of leading threadblocks computing one additional iteration
+    int extra_iters;
+
+    //
+    // Methods
+    //
+
+    CUTLASS_HOST_DEVICE
+    GemmStreamKThreadblockSwizzle()
+            : iters_per_tile(0),
+              block_count(0),
+              iters_per_block(0),
+              extra_iters(0) {}
+
+    /// Partitions a problem among at most available_blocks threadblocks
+    CUTLASS_HOST_DEVICE
+    GemmStreamKThreadblockSwizzle(GemmCoord problem_size, GemmCoord tile_size,
+                                  int available_blocks)
+            : tiled_shape(
+                      (problem_size.m() + tile_size.m() - 1) / tile_size.m(),
+                      (problem_size.n() + tile_size.n() - 1) / tile_size.n(),
+                      1),
+              iters_per_tile(0),
+              block_count(0),
+              iters_per_block(0),
+              extra_iters(0) {
+        // Tiles without K iterations still apply the epilogue once
+        iters_per_tile =
+                (problem_size.k() + tile_size.k() - 1) / tile_size.k();
+
+        if (iters_per_tile < 1) {
+            iters_per_tile = 1;
+        }
+
+        int iter_count = get_iter_count();
+
+        block_count = (available_blocks < iter_count) ? available_blocks
+                                                      : iter_count;
+
+        if (block_count < 1) {
+            block_count = (iter_count ? 1 : 0);
+        }
+
+        if (block_count) {
+            iters_per_block = iter_count / block_count;
+            extra_iters = iter_count % block_count;
+        }
+    }
+
+    /// Returns the shape of the problem in units of logical tiles
+    CUTLASS_HOST_DEVICE
+    GemmCoord get_tiled_shape() const { return tiled_shape; }
+
+    /// Returns the number of output tiles
+    CUTLASS_HOST_DEVICE
+    int get_tile_count() const { return tiled_shape.m() * tiled_shape.n(); }
+
+    /// Returns the number of multiply-accumulate iterations of the problem
+    CUTLASS_HOST_DEVICE
+    int get_iter_count() const { return get_tile_count() * iters_per_tile; }
+
+    /// Computes CUDA grid dimensions
+    CUTLASS_HOST_DEVICE
+    dim3 get_grid_shape() const { return dim3(block_count, 1, 1); }
+
+    /// Returns the first iteration computed by a threadblock
+    CUTLASS_HOST_DEVICE
+    int get_block_iter_begin(int block_idx) const {
+        return block_idx * iters_per_block +
+               (block_idx < extra_iters ? block_idx : extra_iters);
+    }
+
+    /// Returns one past the last iteration computed by a threadblock
+    CUTLASS_HOST_DEVICE
+    int get_block_iter_end(int block_idx) const {
+        return get_block_iter_begin(block_idx + 1);
+    }
+
+    /// Returns the threadblock computing an iteration
+    CUTLASS_HOST_DEVICE
+    int get_block_idx(int iter) const {
+        int extra_iter_end = extra_iters * (iters_per_block + 1);
+
+        if (iter < extra_iter_end) {
+            return iter / (iters_per_block + 1);
+        }
+
+        return extra_iters + (iter - extra_iter_end) / iters_per_block;
+    }
+
+    /// Returns the output tile an iteration contributes to
+    CUTLASS_HOST_DEVICE
+    int get_tile_idx(int iter) const { return iter / iters_per_tile; }
+
+    /// Returns the first iteration of an output tile
+    CUTLASS_HOST_DEVICE
+    int get_tile_iter_begin(int tile_idx) const {
+        return tile_idx * iters_per_tile;
+    }
+
+    /// Returns one past the last iteration of an output tile
+    CUTLASS_HOST_DEVICE
+    int get_tile_iter_end(int tile_idx) const {
+        return (tile_idx + 1) * iters_per_tile;
+    }
+
+    /// Obtains the offset of an output tile (in units of threadblock-scoped
+    /// tiles)
+    CUTLASS_HOST_DEVICE
+    GemmCoord get_tile_offset(int tile_idx) const {
+        return GemmCoord{tile_idx % tiled_shape.m(),
+                         tile_idx / tiled_shape.m(), 0};
+    }
+
+    /// Returns the number of threadblocks contributing to an output tile
+    CUTLASS_HOST_DEVICE
+    int get_partition_count(int tile_idx) const {
+        return get_block_idx(get_tile_iter_end(tile_idx) - 1) -
+               get_block_idx(get_tile_iter_begin(tile_idx)) + 1;
+    }
+
+    /// Returns the position of a threadblock's partition in the serial
+    /// reduction of an output tile. The threadblock computing the tile's last
+    /// iterations goes first and the one computing its first iterations,
+    /// which reaches the tile at the end of its range, goes last.
+    CUTLASS_HOST_DEVICE
+    int get_partition_idx(int tile_idx, int block_idx) const {
+        return get_block_idx(get_tile_iter_end(tile_idx) - 1) - block_idx;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Threadblock swizzling function for batched GEMVs
 struct GemvBatchedStridedThreadblockDefaultSwizzle {
     /// Returns the shape of the problem in units of logical tiles
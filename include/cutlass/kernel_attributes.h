@@ -0,0 +1,198 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *this list of conditions and the following disclaimer in the documentation
+ *and/or other materials provided with the distribution.
+ *   * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Configures the attributes of CUTLASS kernels once per device.
+
+    Kernels using 48KB of shared memory or more must opt in to the larger
+    capacity with cudaFuncSetAttribute() before they are launched. The
+    attribute persists for the lifetime of the CUDA context, so device-level
+    operators configure each kernel once per device rather than before every
+    launch.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/device_kernel.h"
+
+namespace cutlass {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// CUDA Runtime functions used to configure kernel attributes.
+//
+// Tests replace them with set_kernel_attribute_runtime() to observe the
+// configuration without a GPU.
+struct KernelAttributeRuntime {
+    cudaError_t (*get_device)(int* device);
+    cudaError_t (*func_set_attribute)(void const* func,
+                                      cudaFuncAttribute attr, int value);
+};
+
+namespace detail {
+
+inline cudaError_t kernel_attribute_get_device(int* device) {
+    return cudaGetDevice(device);
+}
+
+inline cudaError_t kernel_attribute_func_set_attribute(
+        void const* func, cudaFuncAttribute attr, int value) {
+    return cudaFuncSetAttribute(func, attr, value);
+}
+
+inline KernelAttributeRuntime& kernel_attribute_runtime() {
+    static KernelAttributeRuntime runtime = {
+            kernel_attribute_get_device, kernel_attribute_func_set_attribute};
+    return runtime;
+}
+
+}  // namespace detail
+
+/// Returns the functions used to configure kernel attributes
+inline KernelAttributeRuntime const& kernel_attribute_runtime() {
+    return detail::kernel_attribute_runtime();
+}
+
+/// Replaces the functions used to configure kernel attributes and returns
+/// the previous ones. Not synchronized with concurrent launches.
+inline KernelAttributeRuntime set_kernel_attribute_runtime(
+        KernelAttributeRuntime const& runtime) {
+    KernelAttributeRuntime previous = detail::kernel_attribute_runtime();
+    detail::kernel_attribute_runtime() = runtime;
+    return previous;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Configures the dynamic shared memory of cutlass::Kernel<Operator> once per
+/// device.
+//
+// The first launch on each device sets MaxDynamicSharedMemorySize and
+// PreferredSharedMemoryCarveout under a mutex; later launches only load an
+// atomic flag. A failed configuration is not recorded and is retried by the
+// next launch. Devices beyond kMaxDevices are configured on every launch.
+template <typename Operator>
+class KernelSharedMemoryConfiguration {
+public:
+    /// Devices whose configuration is remembered
+    static int const kMaxDevices = 64;
+
+    /// Shared memory a kernel may use without opting in
+    static int const kDefaultCapacity = (48 << 10);
+
+    /// Ensures the kernel may use smem_size bytes of dynamic shared memory
+    /// on the current device
+    static Status configure(int smem_size) {
+        if (smem_size < kDefaultCapacity) {
+            return Status::kSuccess;
+        }
+
+        int device = 0;
+        if (kernel_attribute_runtime().get_device(&device) != cudaSuccess) {
+            return Status::kErrorInternal;
+        }
+
+        if (device < 0 || device >= kMaxDevices) {
+            return set_attributes_(smem_size);
+        }
+
+        State& state = state_();
+        std::atomic<bool>& configured = state.configured[device];
+
+        if (configured.load(std::memory_order_acquire)) {
+            return Status::kSuccess;
+        }
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (configured.load(std::memory_order_relaxed)) {
+            return Status::kSuccess;
+        }
+
+        Status status = set_attributes_(smem_size);
+        if (status == Status::kSuccess) {
+            configured.store(true, std::memory_order_release);
+        }
+        return status;
+    }
+
+    /// Forgets the configuration of every device, e.g. after
+    /// cudaDeviceReset() destroyed the contexts holding it
+    static void reset() {
+        State& state = state_();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (int device = 0; device < kMaxDevices; ++device) {
+            state.configured[device].store(false, std::memory_order_release);
+        }
+    }
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::atomic<bool> configured[kMaxDevices];
+
+        State() {
+            for (int device = 0; device < kMaxDevices; ++device) {
+                configured[device].store(false, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    static State& state_() {
+        static State state;
+        return state;
+    }
+
+    static Status set_attributes_(int smem_size) {
+        void const* kernel = reinterpret_cast<void const*>(&Kernel<Operator>);
+        KernelAttributeRuntime const& runtime = kernel_attribute_runtime();
+
+        cudaError_t result = runtime.func_set_attribute(
+                kernel, cudaFuncAttributeMaxDynamicSharedMemorySize,
+                smem_size);
+
+        if (result != cudaSuccess) {
+            return Status::kErrorInternal;
+        }
+
+        result = runtime.func_set_attribute(
+                kernel, cudaFuncAttributePreferredSharedMemoryCarveout, 100);
+
+        if (result != cudaSuccess) {
+            return Status::kErrorInternal;
+        }
+
+        return Status::kSuccess;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace cutlass
@@ -0,0 +1,221 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for configuring kernel attributes once per device.
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/kernel_attributes.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace core {
+namespace kernel {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Operator whose kernel is configured but never launched
+template <int Id>
+struct AttributeOperator {
+    struct Params {};
+    struct SharedStorage {};
+
+    CUTLASS_DEVICE
+    void operator()(Params const&, SharedStorage&) {}
+};
+
+/// Device reported by the runtime shim
+int current_device = 0;
+
+/// Calls of func_set_attribute, with their kernels
+std::atomic<int> set_attribute_calls(0);
+std::vector<void const*> configured_kernels;
+
+/// Number of upcoming func_set_attribute calls failing
+int failures = 0;
+
+cudaError_t get_device(int* device) {
+    *device = current_device;
+    return cudaSuccess;
+}
+
+cudaError_t func_set_attribute(void const* func, cudaFuncAttribute attr,
+                               int) {
+    if (failures > 0) {
+        --failures;
+        return cudaErrorInvalidValue;
+    }
+    if (set_attribute_calls++ % 2 == 0) {
+        configured_kernels.push_back(func);
+    }
+    return cudaSuccess;
+}
+
+/// Installs the runtime shim for the lifetime of a test
+struct RuntimeShim {
+    cutlass::KernelAttributeRuntime previous;
+
+    RuntimeShim() {
+        current_device = 0;
+        set_attribute_calls = 0;
+        configured_kernels.clear();
+        failures = 0;
+        previous = cutlass::set_kernel_attribute_runtime(
+                {get_device, func_set_attribute});
+    }
+
+    ~RuntimeShim() { cutlass::set_kernel_attribute_runtime(previous); }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace kernel
+}  // namespace core
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+int const kLargeSharedMemory = 96 << 10;
+
+TEST(KernelSharedMemoryConfiguration, small_shared_memory_is_not_configured) {
+    using namespace test::core::kernel;
+    using Configuration =
+            cutlass::KernelSharedMemoryConfiguration<AttributeOperator<0>>;
+
+    RuntimeShim shim;
+
+    EXPECT_EQ(Configuration::configure(16 << 10), cutlass::Status::kSuccess);
+    EXPECT_EQ(set_attribute_calls, 0);
+}
+
+TEST(KernelSharedMemoryConfiguration, configures_once_per_device) {
+    using namespace test::core::kernel;
+    using Configuration =
+            cutlass::KernelSharedMemoryConfiguration<AttributeOperator<1>>;
+
+    RuntimeShim shim;
+
+    for (int launch = 0; launch < 4; ++launch) {
+        EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+                  cutlass::Status::kSuccess);
+    }
+
+    // MaxDynamicSharedMemorySize and PreferredSharedMemoryCarveout
+    EXPECT_EQ(set_attribute_calls, 2);
+
+    current_device = 1;
+    EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(set_attribute_calls, 4);
+
+    current_device = 0;
+    EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(set_attribute_calls, 4);
+
+    Configuration::reset();
+    EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(set_attribute_calls, 6);
+}
+
+TEST(KernelSharedMemoryConfiguration, configures_each_kernel) {
+    using namespace test::core::kernel;
+
+    RuntimeShim shim;
+
+    EXPECT_EQ(cutlass::KernelSharedMemoryConfiguration<
+                      AttributeOperator<2>>::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(cutlass::KernelSharedMemoryConfiguration<
+                      AttributeOperator<3>>::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+
+    ASSERT_EQ(configured_kernels.size(), size_t(2));
+    EXPECT_EQ(configured_kernels[0],
+              reinterpret_cast<void const*>(
+                      &cutlass::Kernel<AttributeOperator<2>>));
+    EXPECT_EQ(configured_kernels[1],
+              reinterpret_cast<void const*>(
+                      &cutlass::Kernel<AttributeOperator<3>>));
+}
+
+TEST(KernelSharedMemoryConfiguration, failures_are_retried) {
+    using namespace test::core::kernel;
+    using Configuration =
+            cutlass::KernelSharedMemoryConfiguration<AttributeOperator<4>>;
+
+    RuntimeShim shim;
+
+    failures = 1;
+    EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+              cutlass::Status::kErrorInternal);
+    EXPECT_EQ(set_attribute_calls, 0);
+
+    EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(Configuration::configure(kLargeSharedMemory),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(set_attribute_calls, 2);
+}
+
+TEST(KernelSharedMemoryConfiguration, concurrent_launches_configure_once) {
+    using namespace test::core::kernel;
+    using Configuration =
+            cutlass::KernelSharedMemoryConfiguration<AttributeOperator<5>>;
+
+    RuntimeShim shim;
+
+    std::atomic<int> failed(0);
+    std::vector<std::thread> threads;
+
+    for (int thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&failed]() {
+            for (int launch = 0; launch < 1000; ++launch) {
+                if (Configuration::configure(kLargeSharedMemory) !=
+                    cutlass::Status::kSuccess) {
+                    ++failed;
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failed, 0);
+    EXPECT_EQ(set_attribute_calls, 2);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,363 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the device-wide grouped GEMM interface
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "../../common/cutlass_unit_test.h"
+
+#include "cutlass/util/device_memory.h"
+
+#include "testbed.h"
+
+namespace test {
+namespace gemm {
+namespace device {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Gemm>
+struct TestbedGrouped : public Testbed<Gemm> {
+    using Base = Testbed<Gemm>;
+
+    using ElementA = typename Gemm::ElementA;
+    using LayoutA = typename Gemm::LayoutA;
+    using ElementB = typename Gemm::ElementB;
+    using LayoutB = typename Gemm::LayoutB;
+    using ElementC = typename Gemm::ElementC;
+    using LayoutC = typename Gemm::LayoutC;
+    using ElementAccumulator = typename Base::ElementAccumulator;
+    using ElementCompute = typename Base::ElementCompute;
+
+    using ProblemVisitor = typename Gemm::ProblemVisitor;
+
+    //
+    // Methods
+    //
+
+    TestbedGrouped(cutlass::Distribution::Kind init_A_ =
+                           cutlass::Distribution::Uniform,
+                   cutlass::Distribution::Kind init_B_ =
+                           cutlass::Distribution::Uniform,
+                   cutlass::Distribution::Kind init_C_ =
+                           cutlass::Distribution::Uniform,
+                   uint64_t seed_ = 2080)
+            : Base(init_A_, init_B_, init_C_, seed_) {}
+
+    /// Executes one group with the given number of persistent threadblocks
+    bool run(std::vector<cutlass::gemm::GemmCoord> const& problem_sizes,
+             int threadblock_count, ElementCompute alpha = ElementCompute(1),
+             ElementCompute beta = ElementCompute(0)) {
+        // Waive test if insufficient CUDA device
+        if (!this->sufficient()) {
+            return true;
+        }
+
+        int problem_count = int(problem_sizes.size());
+
+        //
+        // Allocate and initialize the operands of each problem
+        //
+
+        std::vector<cutlass::HostTensor<ElementA, LayoutA>> tensor_A(
+                problem_count);
+        std::vector<cutlass::HostTensor<ElementB, LayoutB>> tensor_B(
+                problem_count);
+        std::vector<cutlass::HostTensor<ElementC, LayoutC>> tensor_C(
+                problem_count);
+        std::vector<cutlass::HostTensor<ElementC, LayoutC>> tensor_D(
+                problem_count);
+        std::vector<cutlass::HostTensor<ElementC, LayoutC>> reference_D(
+                problem_count);
+
+        std::vector<ElementA const*> ptr_A(problem_count);
+        std::vector<ElementB const*> ptr_B(problem_count);
+        std::vector<ElementC const*> ptr_C(problem_count);
+        std::vector<ElementC*> ptr_D(problem_count);
+
+        std::vector<int64_t> lda(problem_count);
+        std::vector<int64_t> ldb(problem_count);
+        std::vector<int64_t> ldc(problem_count);
+        std::vector<int64_t> ldd(problem_count);
+
+        for (int idx = 0; idx < problem_count; ++idx) {
+            cutlass::gemm::GemmCoord problem_size = problem_sizes[idx];
+
+            tensor_A[idx].reset(problem_size.mk());
+            tensor_B[idx].reset(problem_size.kn());
+            tensor_C[idx].reset(problem_size.mn());
+            tensor_D[idx].reset(problem_size.mn());
+            reference_D[idx].reset(problem_size.mn(), false);
+
+            EXPECT_TRUE(this->initialize_tensor(tensor_A[idx].host_view(),
+                                                this->init_A,
+                                                this->seed + 2019 + idx * 3));
+            EXPECT_TRUE(this->initialize_tensor(tensor_B[idx].host_view(),
+                                                this->init_B,
+                                                this->seed + 2018 + idx * 3));
+            EXPECT_TRUE(this->initialize_tensor(tensor_C[idx].host_view(),
+                                                this->init_C,
+                                                this->seed + 2017 + idx * 3));
+
+            cutlass::reference::host::TensorCopy(reference_D[idx].host_view(),
+                                                 tensor_C[idx].host_view());
+
+            tensor_A[idx].sync_device();
+            tensor_B[idx].sync_device();
+            tensor_C[idx].sync_device();
+            tensor_D[idx].sync_device();
+
+            ptr_A[idx] = tensor_A[idx].device_data();
+            ptr_B[idx] = tensor_B[idx].device_data();
+            ptr_C[idx] = tensor_C[idx].device_data();
+            ptr_D[idx] = tensor_D[idx].device_data();
+
+            lda[idx] = tensor_A[idx].layout().stride(0);
+            ldb[idx] = tensor_B[idx].layout().stride(0);
+            ldc[idx] = tensor_C[idx].layout().stride(0);
+            ldd[idx] = tensor_D[idx].layout().stride(0);
+
+            EXPECT_TRUE(Gemm::can_implement(problem_size, lda[idx], ldb[idx],
+                                            ldc[idx], ldd[idx]) ==
+                        cutlass::Status::kSuccess);
+        }
+
+        //
+        // Copy the problem descriptions to the device
+        //
+
+        cutlass::device_memory::allocation<cutlass::gemm::GemmCoord>
+                device_problem_sizes(problem_count);
+        cutlass::device_memory::allocation<ElementA const*> device_ptr_A(
+                problem_count);
+        cutlass::device_memory::allocation<ElementB const*> device_ptr_B(
+                problem_count);
+        cutlass::device_memory::allocation<ElementC const*> device_ptr_C(
+                problem_count);
+        cutlass::device_memory::allocation<ElementC*> device_ptr_D(
+                problem_count);
+        cutlass::device_memory::allocation<int64_t> device_lda(problem_count);
+        cutlass::device_memory::allocation<int64_t> device_ldb(problem_count);
+        cutlass::device_memory::allocation<int64_t> device_ldc(problem_count);
+        cutlass::device_memory::allocation<int64_t> device_ldd(problem_count);
+
+        cutlass::device_memory::copy_to_device(device_problem_sizes.get(),
+                                               problem_sizes.data(),
+                                               problem_count);
+        cutlass::device_memory::copy_to_device(device_ptr_A.get(),
+                                               ptr_A.data(), problem_count);
+        cutlass::device_memory::copy_to_device(device_ptr_B.get(),
+                                               ptr_B.data(), problem_count);
+        cutlass::device_memory::copy_to_device(device_ptr_C.get(),
+                                               ptr_C.data(), problem_count);
+        cutlass::device_memory::copy_to_device(device_ptr_D.get(),
+                                               ptr_D.data(), problem_count);
+        cutlass::device_memory::copy_to_device(device_lda.get(), lda.data(),
+                                               problem_count);
+        cutlass::device_memory::copy_to_device(device_ldb.get(), ldb.data(),
+                                               problem_count);
+        cutlass::device_memory::copy_to_device(device_ldc.get(), ldc.data(),
+                                               problem_count);
+        cutlass::device_memory::copy_to_device(device_ldd.get(), ldd.data(),
+                                               problem_count);
+
+        //
+        // Initialize the GEMM operator
+        //
+
+        typename Gemm::Arguments arguments{device_problem_sizes.get(),
+                                           problem_count,
+                                           threadblock_count,
+                                           {alpha, beta},
+                                           device_ptr_A.get(),
+                                           device_ptr_B.get(),
+                                           device_ptr_C.get(),
+                                           device_ptr_D.get(),
+                                           device_lda.get(),
+                                           device_ldb.get(),
+                                           device_ldc.get(),
+                                           device_ldd.get()};
+
+        EXPECT_TRUE(Gemm::can_implement(arguments) ==
+                    cutlass::Status::kSuccess);
+
+        Gemm gemm_op;
+
+        size_t workspace_size = Gemm::get_workspace_size(arguments);
+
+        cutlass::device_memory::allocation<uint8_t> workspace(workspace_size);
+
+        cutlass::Status status = gemm_op.initialize(arguments, workspace.get());
+
+        EXPECT_TRUE(status == cutlass::Status::kSuccess) << to_string(status);
+
+        //
+        // Run the GEMM
+        //
+
+        status = gemm_op();
+
+        EXPECT_TRUE(status == cutlass::Status::kSuccess) << to_string(status);
+
+        EXPECT_EQ(cudaDeviceSynchronize(), cudaSuccess);
+
+        //
+        // Verify each problem against the host reference
+        //
+
+        cutlass::reference::host::Gemm<ElementA, LayoutA, ElementB, LayoutB,
+                                       ElementC, LayoutC, ElementCompute,
+                                       ElementAccumulator,
+                                       typename Gemm::Operator>
+                reference_gemm;
+
+        bool passed = true;
+
+        for (int idx = 0; idx < problem_count; ++idx) {
+            cutlass::gemm::GemmCoord problem_size = problem_sizes[idx];
+
+            tensor_D[idx].sync_host();
+
+            reference_gemm(problem_size, alpha, tensor_A[idx].host_ref(),
+                           tensor_B[idx].host_ref(), beta,
+                           reference_D[idx].host_ref(), ElementAccumulator(0));
+
+            bool equal = cutlass::reference::host::TensorEquals(
+                    reference_D[idx].host_view(), tensor_D[idx].host_view());
+
+            EXPECT_TRUE(equal) << "problem " << idx << ": " << problem_size;
+
+            if (!equal) {
+                std::stringstream fname;
+
+                fname << "error_GemmGrouped_device_" << idx << "_"
+                      << problem_size.m() << "x" << problem_size.n() << "x"
+                      << problem_size.k() << "_" << Gemm::ThreadblockShape::kM
+                      << "x" << Gemm::ThreadblockShape::kN << "x"
+                      << Gemm::ThreadblockShape::kK << "_"
+                      << Gemm::WarpShape::kM << "x" << Gemm::WarpShape::kN
+                      << "x" << Gemm::WarpShape::kK << ".txt";
+
+                std::ofstream file(fname.str());
+
+                file << "problem: " << problem_size << ", alpha: " << alpha
+                     << ", beta: " << beta
+                     << ", threadblock_count: " << threadblock_count
+                     << "\n\n";
+
+                file << "A =\n"
+                     << tensor_A[idx].host_view() << "\nB =\n"
+                     << tensor_B[idx].host_view() << "\nC =\n"
+                     << tensor_C[idx].host_view() << "\n\nReference =\n"
+                     << reference_D[idx].host_view() << "\nComputed =\n"
+                     << tensor_D[idx].host_view();
+
+                passed = false;
+            }
+        }
+
+        return passed;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Gemm>
+bool TestAllGemmGrouped() {
+    bool passed = true;
+
+    using ProblemVisitor = typename Gemm::ProblemVisitor;
+
+    // Problems of different shapes within one group, including empty
+    // problems at the front, middle and back of the group
+    std::vector<std::vector<cutlass::gemm::GemmCoord>> groups = {
+            {{264, 72, 520}},
+            {{0, 64, 16},
+             {264, 72, 520},
+             {128, 520, 8},
+             {48, 0, 8},
+             {8, 8, 2056},
+             {520, 264, 120},
+             {0, 0, 32}},
+            {}};
+
+    // Small counts leave each threadblock several tiles spanning problem
+    // boundaries; zero selects the resident threadblock count
+    int threadblock_counts[] = {1, 2, 3, 0};
+
+    EXPECT_GT(ProblemVisitor::group_tile_count(groups[1].data(),
+                                               int(groups[1].size())),
+              3);
+
+    double problem_alpha[] = {0.5};
+
+    double problem_beta[] = {2.0};
+
+    using Testbed = TestbedGrouped<Gemm>;
+    using ElementCompute = typename Testbed::ElementCompute;
+
+    Testbed testbed;
+
+    for (auto const& problem_sizes : groups) {
+        for (int threadblock_count : threadblock_counts) {
+            for (double alpha : problem_alpha) {
+                for (double beta : problem_beta) {
+                    passed = testbed.run(problem_sizes, threadblock_count,
+                                         ElementCompute(alpha),
+                                         ElementCompute(beta));
+
+                    if (!passed) {
+                        std::cout << "Failed on a group of "
+                                  << problem_sizes.size()
+                                  << " problems with threadblock_count "
+                                  << threadblock_count << std::endl;
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    EXPECT_TRUE(passed);
+
+    return passed;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace device
+}  // namespace gemm
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
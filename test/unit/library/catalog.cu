@@ -0,0 +1,230 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the operation catalog of the CUTLASS Library.
+*/
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/catalog.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// GEMM requiring extents divisible by the alignment of its operands
+class MockAlignedGemmOperation : public Operation {
+    GemmDescription description_;
+
+public:
+    MockAlignedGemmOperation(GemmDescription const& description)
+            : description_(description) {}
+
+    OperationDescription const& description() const override {
+        return description_;
+    }
+
+    cutlass::Status can_implement(void const* configuration_ptr,
+                                  void const*) const override {
+        GemmConfiguration const* configuration =
+                static_cast<GemmConfiguration const*>(configuration_ptr);
+
+        int alignment = description_.A.alignment;
+        if (configuration->problem_size.m() % alignment ||
+            configuration->problem_size.n() % alignment ||
+            configuration->problem_size.k() % alignment) {
+            return cutlass::Status::kErrorMisalignedOperand;
+        }
+        return cutlass::Status::kSuccess;
+    }
+
+    uint64_t get_host_workspace_size(void const*) const override {
+        return 64;
+    }
+
+    uint64_t get_device_workspace_size(
+            void const* configuration_ptr) const override {
+        GemmConfiguration const* configuration =
+                static_cast<GemmConfiguration const*>(configuration_ptr);
+        return configuration->split_k_slices > 1
+                       ? uint64_t(configuration->problem_size.m()) *
+                                 configuration->problem_size.n() * 4
+                       : 0;
+    }
+
+    cutlass::Status initialize(void const*, void*, void*,
+                               cudaStream_t) const override {
+        return cutlass::Status::kSuccess;
+    }
+
+    cutlass::Status run(void const*, void*, void*,
+                        cudaStream_t) const override {
+        return cutlass::Status::kSuccess;
+    }
+};
+
+/// Appends a f16 GEMM with the given name, layout of A, alignment and cc
+void append_gemm(Manifest& manifest, char const* name, LayoutTypeID layout_A,
+                 int alignment, int cc) {
+    GemmDescription desc(
+            GemmKind::kGemm,
+            TensorDescription(NumericTypeID::kF16, layout_A, alignment),
+            TensorDescription(NumericTypeID::kF16, LayoutTypeID::kRowMajor,
+                              alignment),
+            TensorDescription(NumericTypeID::kF32, LayoutTypeID::kColumnMajor,
+                              alignment),
+            NumericTypeID::kF32);
+
+    desc.name = name;
+    desc.provider = Provider::kCUTLASS;
+    desc.kind = OperationKind::kGemm;
+    desc.tile_description.threadblock_shape =
+            cutlass::gemm::GemmCoord(128, 128, 32);
+    desc.tile_description.threadblock_stages = 3;
+    desc.tile_description.warp_count = cutlass::gemm::GemmCoord(2, 2, 1);
+    desc.tile_description.math_instruction.instruction_shape =
+            cutlass::gemm::GemmCoord(16, 8, 16);
+    desc.tile_description.math_instruction.element_accumulator =
+            NumericTypeID::kF32;
+    desc.tile_description.math_instruction.opcode_class =
+            OpcodeClassID::kTensorOp;
+    desc.tile_description.minimum_compute_capability = cc;
+    desc.tile_description.maximum_compute_capability = 1024;
+    desc.shared_memory_size = 49152;
+
+    manifest.append(new MockAlignedGemmOperation(desc));
+}
+
+/// Returns the names of records
+std::vector<std::string> record_names(CatalogRecordVector const& records) {
+    std::vector<std::string> names;
+    for (CatalogRecord const& record : records) {
+        names.push_back(record.operation->description().name);
+    }
+    return names;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SM50_library_catalog, lists_operations_by_name) {
+    using namespace test::library;
+
+    Manifest manifest;
+    append_gemm(manifest, "gemm_c", LayoutTypeID::kColumnMajor, 8, 80);
+    append_gemm(manifest, "gemm_a", LayoutTypeID::kColumnMajor, 1, 70);
+    append_gemm(manifest, "gemm_b", LayoutTypeID::kRowMajor, 8, 75);
+
+    CatalogRecordVector records = make_catalog(manifest);
+
+    std::vector<std::string> expected = {"gemm_a", "gemm_b", "gemm_c"};
+    EXPECT_EQ(record_names(records), expected);
+    EXPECT_EQ(records.front().host_workspace_size, 64u);
+
+    std::stringstream json;
+    write_catalog_json(json, records);
+    EXPECT_NE(json.str().find("\"name\": \"gemm_b\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"threadblock_shape\": [128, 128, 32]"),
+              std::string::npos);
+    EXPECT_NE(json.str().find("\"shared_memory_size\": 49152"),
+              std::string::npos);
+
+    // one header row and one row per operation, all with the same columns
+    std::stringstream csv;
+    write_catalog_csv(csv, records);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(csv, line);) {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), records.size() + 1);
+    for (std::string const& line : lines) {
+        EXPECT_EQ(std::count(line.begin(), line.end(), ','),
+                  std::count(lines[0].begin(), lines[0].end(), ','));
+    }
+    EXPECT_EQ(lines[1].compare(0, 7, "gemm_a,"), 0);
+}
+
+TEST(SM50_library_catalog, query_selects_implementable_operations) {
+    using namespace test::library;
+
+    Manifest manifest;
+    append_gemm(manifest, "gemm_align1_sm70", LayoutTypeID::kColumnMajor, 1,
+                70);
+    append_gemm(manifest, "gemm_align8_sm80", LayoutTypeID::kColumnMajor, 8,
+                80);
+    append_gemm(manifest, "gemm_row_align1_sm70", LayoutTypeID::kRowMajor, 1,
+                70);
+
+    CatalogQuery query;
+    query.kind = OperationKind::kGemm;
+    query.element_A = NumericTypeID::kF16;
+    query.layout_A = LayoutTypeID::kColumnMajor;
+    query.problem_size = cutlass::gemm::GemmCoord(1024, 512, 256);
+
+    std::vector<std::string> expected = {"gemm_align1_sm70",
+                                         "gemm_align8_sm80"};
+    EXPECT_EQ(record_names(query_catalog(manifest, query)), expected);
+
+    // devices below the minimum compute capability are excluded
+    query.compute_capability = 75;
+    expected = {"gemm_align1_sm70"};
+    EXPECT_EQ(record_names(query_catalog(manifest, query)), expected);
+
+    // misaligned extents are rejected by can_implement()
+    query.compute_capability = 80;
+    query.problem_size = cutlass::gemm::GemmCoord(1020, 512, 256);
+    expected = {"gemm_align1_sm70"};
+    EXPECT_EQ(record_names(query_catalog(manifest, query)), expected);
+
+    // the device workspace depends on the queried problem
+    query.split_k_slices = 4;
+    CatalogRecordVector records = query_catalog(manifest, query);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].device_workspace_size, uint64_t(1020 * 512 * 4));
+
+    // other kinds of operations do not match
+    query.kind = OperationKind::kConv2d;
+    EXPECT_TRUE(query_catalog(manifest, query).empty());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,309 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the pool of Handles of the CUTLASS Library.
+
+    Handles run host (CPU) operations on placeholder streams and draw
+    workspace from a host allocator, so the tests need no device.
+*/
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/handle_pool.h"
+#include "cutlass/library/library.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/// Hands out host memory
+class HostWorkspaceAllocator : public WorkspaceAllocator {
+public:
+    std::atomic<int> allocations;
+
+    HostWorkspaceAllocator() : allocations(0) {}
+
+    virtual void* allocate(size_t bytes, cudaStream_t) {
+        ++allocations;
+        return new char[bytes];
+    }
+
+    virtual void deallocate(void* ptr, size_t, cudaStream_t) {
+        delete[] static_cast<char*>(ptr);
+    }
+
+    virtual bool fill_zero(void*, size_t, cudaStream_t) { return true; }
+};
+
+/// Placeholder stream, never passed to the CUDA runtime
+cudaStream_t make_stream(int idx) {
+    return reinterpret_cast<cudaStream_t>(uintptr_t(idx + 1) * 64);
+}
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SM50_library_handle_pool, stream_arenas) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<HostWorkspaceAllocator>();
+    HandlePool pool(1 << 10, allocator);
+
+    std::shared_ptr<WorkspaceArena> arena_a;
+    std::shared_ptr<WorkspaceArena> arena_b;
+
+    {
+        HandleLease lease = pool.acquire(make_stream(0));
+        ASSERT_TRUE(bool(lease));
+        EXPECT_EQ(lease->get_stream(), make_stream(0));
+        arena_a = lease->get_workspace_arena();
+    }
+    {
+        HandleLease lease = pool.acquire(make_stream(1));
+        arena_b = lease->get_workspace_arena();
+    }
+    {
+        HandleLease lease = pool.acquire(make_stream(0));
+        EXPECT_EQ(lease->get_workspace_arena(), arena_a);
+    }
+
+    EXPECT_NE(arena_a, arena_b);
+    EXPECT_EQ(arena_a->capacity(), size_t(1 << 10));
+    EXPECT_EQ(allocator->allocations.load(), 2);
+
+    EXPECT_EQ(pool.stream_count(), size_t(2));
+    EXPECT_EQ(pool.handle_count(), size_t(1));
+}
+
+TEST(SM50_library_handle_pool, concurrent_leases_on_stream) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<HostWorkspaceAllocator>();
+    HandlePool pool(1 << 10, allocator);
+
+    std::shared_ptr<WorkspaceArena> arena_a;
+    std::shared_ptr<WorkspaceArena> arena_b;
+
+    {
+        // One thread may hold two leases on a stream, which receive
+        // distinct arenas
+        HandleLease lease_a = pool.acquire(make_stream(0));
+        HandleLease lease_b = pool.acquire(make_stream(0));
+
+        arena_a = lease_a->get_workspace_arena();
+        arena_b = lease_b->get_workspace_arena();
+
+        EXPECT_NE(lease_a.get(), lease_b.get());
+        EXPECT_NE(arena_a, arena_b);
+    }
+
+    // Both arenas are reused by later leases on the stream
+    {
+        HandleLease lease_a = pool.acquire(make_stream(0));
+        HandleLease lease_b = pool.acquire(make_stream(0));
+
+        std::set<WorkspaceArena*> arenas = {
+                lease_a->get_workspace_arena().get(),
+                lease_b->get_workspace_arena().get()};
+
+        EXPECT_EQ(arenas, (std::set<WorkspaceArena*>{arena_a.get(),
+                                                      arena_b.get()}));
+    }
+
+    EXPECT_EQ(allocator->allocations.load(), 2);
+    EXPECT_EQ(pool.stream_count(), size_t(1));
+}
+
+TEST(SM50_library_handle_pool, release_stream) {
+    using namespace test::library;
+
+    HandlePool pool(1 << 10, std::make_shared<HostWorkspaceAllocator>());
+
+    HandleLease lease = pool.acquire(make_stream(0));
+    std::weak_ptr<WorkspaceArena> leased = lease->get_workspace_arena();
+    std::weak_ptr<WorkspaceArena> idle;
+    {
+        HandleLease other = pool.acquire(make_stream(0));
+        idle = other->get_workspace_arena();
+    }
+    pool.acquire(make_stream(1));
+
+    EXPECT_EQ(pool.stream_count(), size_t(2));
+
+    // Idle arenas are released with the stream, and leased ones with their
+    // leases
+    pool.release_stream(make_stream(0));
+    pool.release_stream(make_stream(2));
+
+    EXPECT_EQ(pool.stream_count(), size_t(1));
+    EXPECT_TRUE(idle.expired());
+    EXPECT_FALSE(leased.expired());
+
+    lease.release();
+    EXPECT_TRUE(leased.expired());
+}
+
+TEST(SM50_library_handle_pool, lease_state) {
+    using namespace test::library;
+
+    HandlePool pool(0, std::make_shared<HostWorkspaceAllocator>());
+
+    Provider default_provider;
+    Handle* first;
+    {
+        HandleLease lease = pool.acquire(make_stream(0));
+        first = lease.get();
+        default_provider = lease->get_provider();
+
+        lease->set_provider(Provider::kReferenceHost);
+        lease->set_scalar_pointer_mode(ScalarPointerMode::kDevice);
+    }
+
+    // Leases start from the defaults, and concurrent leases receive
+    // distinct handles
+    HandleLease lease_a = pool.acquire(make_stream(0));
+    HandleLease lease_b = pool.acquire(make_stream(1));
+
+    EXPECT_EQ(lease_a.get(), first);
+    EXPECT_EQ(lease_a->get_provider(), default_provider);
+    EXPECT_EQ(lease_a->get_scalar_pointer_mode(), ScalarPointerMode::kHost);
+    EXPECT_NE(lease_a.get(), lease_b.get());
+    EXPECT_EQ(pool.handle_count(), size_t(2));
+
+    // Moving transfers the handle
+    HandleLease moved(std::move(lease_b));
+    EXPECT_FALSE(bool(lease_b));
+    EXPECT_TRUE(bool(moved));
+
+    moved.release();
+    EXPECT_FALSE(bool(moved));
+}
+
+TEST(SM50_library_handle_pool, stress) {
+    using namespace test::library;
+
+    int const kThreads = 8;
+    int const kStreams = 4;
+    int const kIterations = 200;
+    int const M = 12, N = 10, K = 6;
+
+    HandlePool pool(0, std::make_shared<HostWorkspaceAllocator>());
+
+    std::mutex in_use_mutex;
+    std::set<Handle*> in_use;
+    std::set<WorkspaceArena*> arenas_in_use;
+
+    std::atomic<int> failures(0);
+
+    auto worker = [&](int thread_idx) {
+        std::vector<float> A(M * K), B(K * N), C(M * N, 0), D(M * N);
+        float alpha = 1, beta = 0;
+
+        for (int iteration = 0; iteration < kIterations; ++iteration) {
+            int stream_idx = (thread_idx + iteration) % kStreams;
+
+            for (int i = 0; i < M * K; ++i) {
+                A[i] = float((i + iteration) % 5);
+            }
+            for (int i = 0; i < K * N; ++i) {
+                B[i] = float((i + thread_idx) % 3);
+            }
+
+            HandleLease lease = pool.acquire(make_stream(stream_idx));
+
+            // Each handle and arena serves one lease at a time
+            WorkspaceArena* arena = lease->get_workspace_arena().get();
+            {
+                std::lock_guard<std::mutex> lock(in_use_mutex);
+                if (!in_use.insert(lease.get()).second ||
+                    !arenas_in_use.insert(arena).second) {
+                    ++failures;
+                }
+            }
+
+            lease->set_provider(Provider::kHost);
+
+            cutlass::Status status = lease->gemm(
+                    M, N, K, NumericTypeID::kF32, NumericTypeID::kF32, &alpha,
+                    NumericTypeID::kF32, LayoutTypeID::kColumnMajor,
+                    ComplexTransform::kNone, A.data(), M, NumericTypeID::kF32,
+                    LayoutTypeID::kRowMajor, ComplexTransform::kNone, B.data(),
+                    N, &beta, NumericTypeID::kF32, C.data(), M, D.data(), M);
+
+            if (status != cutlass::Status::kSuccess ||
+                lease->get_stream() != make_stream(stream_idx)) {
+                ++failures;
+            }
+
+            for (int m = 0; m < M; ++m) {
+                for (int n = 0; n < N; ++n) {
+                    float expected = 0;
+                    for (int k = 0; k < K; ++k) {
+                        expected += A[m + k * M] * B[k * N + n];
+                    }
+                    if (D[m + n * M] != expected) {
+                        ++failures;
+                    }
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(in_use_mutex);
+                in_use.erase(lease.get());
+                arenas_in_use.erase(arena);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int idx = 0; idx < kThreads; ++idx) {
+        threads.emplace_back(worker, idx);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(pool.stream_count(), size_t(kStreams));
+
+    // Each thread holds one lease at a time
+    EXPECT_LE(pool.handle_count(), size_t(kStreams) + kThreads);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
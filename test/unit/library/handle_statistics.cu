@@ -0,0 +1,148 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the runtime statistics of cutlass::library::Handle.
+*/
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/handle.h"
+#include "cutlass/library/library.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/// Runs a small f32 GEMM with the host provider
+cutlass::Status run_host_gemm(Handle& handle, NumericTypeID element_A) {
+    int const M = 8, N = 8, K = 8;
+
+    std::vector<float> A(M * K, 1), B(K * N, 1), C(M * N, 0), D(M * N);
+    float alpha = 1, beta = 0;
+
+    return handle.gemm(M, N, K, NumericTypeID::kF32, NumericTypeID::kF32,
+                       &alpha, element_A, LayoutTypeID::kColumnMajor,
+                       ComplexTransform::kNone, A.data(), M,
+                       NumericTypeID::kF32, LayoutTypeID::kRowMajor,
+                       ComplexTransform::kNone, B.data(), N, &beta,
+                       NumericTypeID::kF32, C.data(), M, D.data(), M);
+}
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SM50_library_handle, statistics) {
+    using namespace test::library;
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+    handle.reset_statistics();
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(run_host_gemm(handle, NumericTypeID::kF32),
+                  cutlass::Status::kSuccess);
+    }
+
+    // No operation consumes f64 A operands with f32 B operands
+    EXPECT_EQ(run_host_gemm(handle, NumericTypeID::kF64),
+              cutlass::Status::kErrorNotSupported);
+
+    HandleStatistics statistics = handle.get_statistics();
+
+    EXPECT_EQ(statistics.calls(), uint64_t(3));
+    ASSERT_EQ(statistics.operation_calls.size(), size_t(1));
+    EXPECT_EQ(statistics.operation_calls.begin()->first,
+              handle.get_last_operation());
+    EXPECT_GT(statistics.dispatch_ns, 0);
+
+    EXPECT_EQ(statistics.miss_count(), uint64_t(1));
+    ASSERT_EQ(statistics.misses.size(), size_t(1));
+    EXPECT_EQ(statistics.misses.begin()->first.element_A,
+              NumericTypeID::kF64);
+    EXPECT_EQ(statistics.misses.begin()->first.provider, Provider::kHost);
+
+    handle.reset_statistics();
+    statistics = handle.get_statistics();
+
+    EXPECT_EQ(statistics.calls(), uint64_t(0));
+    EXPECT_EQ(statistics.miss_count(), uint64_t(0));
+    EXPECT_EQ(statistics.dispatch_ns, 0);
+}
+
+TEST(SM50_library_handle, statistics_workspace) {
+    using namespace test::library;
+
+    Handle handle;
+    handle.reset_statistics();
+
+    // Reallocation happens only on a CUDA device
+    bool has_device = handle.compute_capability() != 0;
+
+    handle.set_workspace_size(handle.get_workspace_size() + (1 << 10));
+    handle.set_workspace_size(handle.get_workspace_size());
+
+    HandleStatistics statistics = handle.get_statistics();
+
+    EXPECT_EQ(statistics.workspace_allocations, uint64_t(has_device ? 1 : 0));
+    EXPECT_EQ(statistics.workspace_bytes_allocated,
+              uint64_t(has_device ? handle.get_workspace_size() : 0));
+}
+
+TEST(SM50_library_handle, statistics_json) {
+    using namespace test::library;
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+    handle.reset_statistics();
+
+    ASSERT_EQ(run_host_gemm(handle, NumericTypeID::kF32),
+              cutlass::Status::kSuccess);
+    run_host_gemm(handle, NumericTypeID::kF64);
+
+    std::stringstream ss;
+    write_statistics_json(ss, handle.get_statistics());
+    std::string json = ss.str();
+
+    std::string name = handle.get_last_operation()->description().name;
+
+    EXPECT_NE(json.find("\"calls\": 1,"), std::string::npos);
+    EXPECT_NE(json.find("\"misses\": 1,"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\": \"" + name + "\", \"calls\": 1}"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"A\": \"f64:column:n\""), std::string::npos);
+    EXPECT_NE(json.find("\"count\": 1}"), std::string::npos);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
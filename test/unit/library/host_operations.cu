@@ -0,0 +1,477 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the host (CPU) provider of the CUTLASS Library.
+*/
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/handle.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/operation_table.h"
+#include "cutlass/library/singleton.h"
+
+#include "cutlass/util/reference/host/convolution.h"
+#include "cutlass/util/reference/host/gemm_complex.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Fills a tensor with small integers so that every product is exact
+template <typename Element>
+std::vector<Element> make_tensor(int64_t size, int seed) {
+    std::vector<Element> tensor(size);
+
+    for (int64_t i = 0; i < size; ++i) {
+        tensor[i] = Element(int((i * 7 + seed * 13) % 9) - 4);
+    }
+
+    return tensor;
+}
+
+std::vector<cutlass::complex<float> > make_complex_tensor(int64_t size,
+                                                          int seed) {
+    std::vector<cutlass::complex<float> > tensor(size);
+
+    for (int64_t i = 0; i < size; ++i) {
+        tensor[i] = cutlass::complex<float>(float((i * 5 + seed) % 7) - 3,
+                                            float((i * 3 + seed) % 5) - 2);
+    }
+
+    return tensor;
+}
+
+/// Runs a Conv2d operation of the host provider on packed NHWC tensors
+template <typename Element>
+cutlass::Status run_host_conv2d(ConvKind conv_kind,
+                                cutlass::conv::Conv2dProblemSize const& problem,
+                                Element const* A, Element const* B,
+                                Element const* C, Element* D, float alpha,
+                                float beta) {
+    ConvFunctionalKey key(Provider::kHost, conv_kind, NumericTypeID::kF32,
+                          LayoutTypeID::kTensorNHWC, NumericTypeID::kF32,
+                          LayoutTypeID::kTensorNHWC, NumericTypeID::kF32,
+                          LayoutTypeID::kTensorNHWC, NumericTypeID::kF32,
+                          NumericTypeID::kF32);
+
+    ConvOperationVectorMap const* operations =
+            Singleton::get().operation_table.find_conv2d_operations(key);
+
+    if (!operations || operations->empty()) {
+        return cutlass::Status::kErrorNotSupported;
+    }
+
+    Operation const* operation = operations->begin()->second.front();
+
+    Conv2dConfiguration configuration;
+    configuration.split_k_mode = cutlass::conv::SplitKMode::kSerial;
+    configuration.problem_size = problem;
+    configuration.layout_activations =
+            cutlass::layout::TensorNHWC::packed(problem.activation_extent());
+    configuration.layout_filters =
+            cutlass::layout::TensorNHWC::packed(problem.filter_extent());
+    configuration.layout_output =
+            cutlass::layout::TensorNHWC::packed(problem.output_extent());
+    configuration.layout_source = configuration.layout_output;
+
+    ConvArguments arguments{A,      B,     C, D, &alpha,
+                            &beta,  ScalarPointerMode::kHost};
+
+    std::vector<char> host_workspace(
+            operation->get_host_workspace_size(&configuration));
+
+    cutlass::Status status = operation->can_implement(&configuration,
+                                                      &arguments);
+    if (status != cutlass::Status::kSuccess) {
+        return status;
+    }
+
+    status = operation->initialize(&configuration, host_workspace.data());
+    if (status != cutlass::Status::kSuccess) {
+        return status;
+    }
+
+    return operation->run(&arguments, host_workspace.data());
+}
+
+/// Verifies one kind of Conv2d of the host provider against the host
+/// reference
+void verify_host_conv2d(cutlass::conv::Operator conv_operator,
+                        ConvKind conv_kind,
+                        cutlass::conv::Conv2dProblemSize const& problem) {
+    using Layout = cutlass::layout::TensorNHWC;
+
+    cutlass::Tensor4DCoord extent_a, extent_b, extent_c;
+
+    switch (conv_operator) {
+        case cutlass::conv::Operator::kFprop:
+            extent_a = problem.activation_extent();
+            extent_b = problem.filter_extent();
+            extent_c = problem.output_extent();
+            break;
+        case cutlass::conv::Operator::kDgrad:
+            extent_a = problem.output_extent();
+            extent_b = problem.filter_extent();
+            extent_c = problem.activation_extent();
+            break;
+        default:
+            extent_a = problem.output_extent();
+            extent_b = problem.activation_extent();
+            extent_c = problem.filter_extent();
+            break;
+    }
+
+    std::vector<float> A = make_tensor<float>(extent_a.product(), 1);
+    std::vector<float> B = make_tensor<float>(extent_b.product(), 2);
+    std::vector<float> C = make_tensor<float>(extent_c.product(), 3);
+    std::vector<float> D(C.size());
+    std::vector<float> D_reference(C.size());
+
+    ASSERT_EQ(run_host_conv2d(conv_kind, problem, A.data(), B.data(),
+                              C.data(), D.data(), 2.0f, -1.0f),
+              cutlass::Status::kSuccess);
+
+    cutlass::reference::host::Conv2d<float, Layout, float, Layout, float,
+                                     Layout, float, float>(
+            conv_operator, problem, {A.data(), Layout::packed(extent_a)},
+            {B.data(), Layout::packed(extent_b)},
+            {C.data(), Layout::packed(extent_c)},
+            {D_reference.data(), Layout::packed(extent_c)}, 2.0f, -1.0f);
+
+    EXPECT_EQ(D, D_reference);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SM50_library_host, gemm_f32) {
+    using namespace test::library;
+
+    int const M = 70, N = 45, K = 131;
+
+    std::vector<float> A = make_tensor<float>(M * K, 1);
+    std::vector<float> B = make_tensor<float>(K * N, 2);
+    std::vector<float> C = make_tensor<float>(M * N, 3);
+    std::vector<float> D(M * N);
+    std::vector<float> D_reference(M * N);
+
+    float alpha = 2, beta = -1;
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+
+    // column-major A, row-major B, column-major C
+    ASSERT_EQ(handle.gemm(M, N, K, NumericTypeID::kF32, NumericTypeID::kF32,
+                          &alpha, NumericTypeID::kF32,
+                          LayoutTypeID::kColumnMajor,
+                          ComplexTransform::kNone, A.data(), M,
+                          NumericTypeID::kF32, LayoutTypeID::kRowMajor,
+                          ComplexTransform::kNone, B.data(), N, &beta,
+                          NumericTypeID::kF32, C.data(), M, D.data(), M),
+              cutlass::Status::kSuccess);
+
+    EXPECT_EQ(handle.get_last_operation()->description().provider,
+              Provider::kHost);
+
+    cutlass::reference::host::GemmComplex(
+            {M, N, K}, alpha,
+            cutlass::TensorRef<float, cutlass::layout::ColumnMajor>(A.data(),
+                                                                    M),
+            cutlass::ComplexTransform::kNone,
+            cutlass::TensorRef<float, cutlass::layout::RowMajor>(B.data(), N),
+            cutlass::ComplexTransform::kNone, beta,
+            cutlass::TensorRef<float, cutlass::layout::ColumnMajor>(C.data(),
+                                                                    M),
+            cutlass::TensorRef<float, cutlass::layout::ColumnMajor>(
+                    D_reference.data(), M),
+            0.0f);
+
+    EXPECT_EQ(D, D_reference);
+}
+
+TEST(SM50_library_host, gemm_universal_batched_s8) {
+    using namespace test::library;
+
+    int const M = 33, N = 130, K = 300, kBatchCount = 3;
+
+    std::vector<int8_t> A = make_tensor<int8_t>(M * K * kBatchCount, 1);
+    std::vector<int8_t> B = make_tensor<int8_t>(K * N * kBatchCount, 2);
+    std::vector<int32_t> C = make_tensor<int32_t>(M * N * kBatchCount, 3);
+    std::vector<int32_t> D(C.size());
+    std::vector<int32_t> D_reference(C.size());
+
+    int32_t alpha = 1, beta = 2;
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+
+    // row-major A, column-major B, column-major C
+    ASSERT_EQ(handle.gemm_universal(
+                      GemmUniversalMode::kBatched, M, N, K,
+                      NumericTypeID::kS32, NumericTypeID::kS32, &alpha,
+                      NumericTypeID::kS8, LayoutTypeID::kRowMajor,
+                      ComplexTransform::kNone, A.data(), K, NumericTypeID::kS8,
+                      LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+                      B.data(), K, &beta, NumericTypeID::kS32, C.data(), M,
+                      D.data(), M, kBatchCount, M * K, K * N, M * N, M * N),
+              cutlass::Status::kSuccess);
+
+    cutlass::reference::host::GemmComplex(
+            {M, N, K}, alpha,
+            cutlass::TensorRef<int8_t, cutlass::layout::RowMajor>(A.data(), K),
+            cutlass::ComplexTransform::kNone,
+            cutlass::TensorRef<int8_t, cutlass::layout::ColumnMajor>(B.data(),
+                                                                     K),
+            cutlass::ComplexTransform::kNone, beta,
+            cutlass::TensorRef<int32_t, cutlass::layout::ColumnMajor>(C.data(),
+                                                                      M),
+            cutlass::TensorRef<int32_t, cutlass::layout::ColumnMajor>(
+                    D_reference.data(), M),
+            int32_t(0), kBatchCount, M * K, K * N, M * N, M * N);
+
+    EXPECT_EQ(D, D_reference);
+}
+
+TEST(SM50_library_host, gemm_universal_conjugate_cf32) {
+    using namespace test::library;
+
+    using Element = cutlass::complex<float>;
+
+    int const M = 21, N = 19, K = 40;
+
+    std::vector<Element> A = make_complex_tensor(M * K, 1);
+    std::vector<Element> B = make_complex_tensor(K * N, 2);
+    std::vector<Element> C = make_complex_tensor(M * N, 3);
+    std::vector<Element> D(M * N);
+    std::vector<Element> D_reference(M * N);
+
+    Element alpha(1, 1), beta(0, 0);
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+
+    ASSERT_EQ(handle.gemm_universal(
+                      GemmUniversalMode::kGemm, M, N, K, NumericTypeID::kCF32,
+                      NumericTypeID::kCF32, &alpha, NumericTypeID::kCF32,
+                      LayoutTypeID::kColumnMajor, ComplexTransform::kConjugate,
+                      A.data(), M, NumericTypeID::kCF32,
+                      LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+                      B.data(), K, &beta, NumericTypeID::kCF32, C.data(), M,
+                      D.data(), M, 1, 0, 0, 0, 0),
+              cutlass::Status::kSuccess);
+
+    cutlass::reference::host::GemmComplex(
+            {M, N, K}, alpha,
+            cutlass::TensorRef<Element, cutlass::layout::ColumnMajor>(A.data(),
+                                                                      M),
+            cutlass::ComplexTransform::kConjugate,
+            cutlass::TensorRef<Element, cutlass::layout::ColumnMajor>(B.data(),
+                                                                      K),
+            cutlass::ComplexTransform::kNone, beta,
+            cutlass::TensorRef<Element, cutlass::layout::ColumnMajor>(C.data(),
+                                                                      M),
+            cutlass::TensorRef<Element, cutlass::layout::ColumnMajor>(
+                    D_reference.data(), M),
+            Element());
+
+    for (int i = 0; i < M * N; ++i) {
+        EXPECT_EQ(D[i].real(), D_reference[i].real());
+        EXPECT_EQ(D[i].imag(), D_reference[i].imag());
+    }
+}
+
+TEST(SM50_library_host, gemm_grouped_f32) {
+    using namespace test::library;
+
+    // Problems of different shapes, including one without output elements
+    std::vector<cutlass::gemm::GemmCoord> problems = {
+            {70, 45, 131}, {1, 9, 3}, {0, 16, 8}, {33, 130, 20}, {64, 1, 0}};
+
+    int const kProblemCount = int(problems.size());
+
+    std::vector<std::vector<float> > A, B, C, D, D_reference;
+    std::vector<int64_t> lda, ldb, ldc, ldd;
+
+    for (int idx = 0; idx < kProblemCount; ++idx) {
+        cutlass::gemm::GemmCoord const& problem = problems[idx];
+
+        // Padded leading dimensions differ between problems
+        lda.push_back(problem.m() + idx);
+        ldb.push_back(problem.n() + 2 * idx);
+        ldc.push_back(problem.m() + 3);
+        ldd.push_back(problem.m() + 1);
+
+        A.push_back(make_tensor<float>(lda[idx] * problem.k(), idx + 1));
+        B.push_back(make_tensor<float>(problem.k() * ldb[idx], idx + 2));
+        C.push_back(make_tensor<float>(ldc[idx] * problem.n(), idx + 3));
+        D.push_back(std::vector<float>(ldd[idx] * problem.n()));
+        D_reference.push_back(D.back());
+    }
+
+    std::vector<void const*> ptr_A, ptr_B, ptr_C;
+    std::vector<void*> ptr_D;
+
+    for (int idx = 0; idx < kProblemCount; ++idx) {
+        ptr_A.push_back(A[idx].data());
+        ptr_B.push_back(B[idx].data());
+        ptr_C.push_back(C[idx].data());
+        ptr_D.push_back(D[idx].data());
+    }
+
+    float alpha = 2, beta = -1;
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+
+    // column-major A, row-major B, column-major C
+    ASSERT_EQ(handle.gemm_grouped(
+                      kProblemCount, problems.data(), NumericTypeID::kF32,
+                      NumericTypeID::kF32, &alpha, NumericTypeID::kF32,
+                      LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+                      ptr_A.data(), lda.data(), NumericTypeID::kF32,
+                      LayoutTypeID::kRowMajor, ComplexTransform::kNone,
+                      ptr_B.data(), ldb.data(), &beta, NumericTypeID::kF32,
+                      ptr_C.data(), ldc.data(), ptr_D.data(), ldd.data()),
+              cutlass::Status::kSuccess);
+
+    EXPECT_EQ(handle.get_last_operation()->description().provider,
+              Provider::kHost);
+    EXPECT_EQ(static_cast<GemmDescription const&>(
+                      handle.get_last_operation()->description())
+                      .gemm_kind,
+              GemmKind::kGrouped);
+
+    for (int idx = 0; idx < kProblemCount; ++idx) {
+        cutlass::reference::host::GemmComplex(
+                problems[idx], alpha,
+                cutlass::TensorRef<float, cutlass::layout::ColumnMajor>(
+                        A[idx].data(), int(lda[idx])),
+                cutlass::ComplexTransform::kNone,
+                cutlass::TensorRef<float, cutlass::layout::RowMajor>(
+                        B[idx].data(), int(ldb[idx])),
+                cutlass::ComplexTransform::kNone, beta,
+                cutlass::TensorRef<float, cutlass::layout::ColumnMajor>(
+                        C[idx].data(), int(ldc[idx])),
+                cutlass::TensorRef<float, cutlass::layout::ColumnMajor>(
+                        D_reference[idx].data(), int(ldd[idx])),
+                0.0f);
+
+        EXPECT_EQ(D[idx], D_reference[idx]) << "problem " << idx;
+    }
+
+    // An empty group succeeds without selecting an operation
+    EXPECT_EQ(handle.gemm_grouped(
+                      0, nullptr, NumericTypeID::kF32, NumericTypeID::kF32,
+                      &alpha, NumericTypeID::kF32, LayoutTypeID::kColumnMajor,
+                      ComplexTransform::kNone, nullptr, nullptr,
+                      NumericTypeID::kF32, LayoutTypeID::kRowMajor,
+                      ComplexTransform::kNone, nullptr, nullptr, &beta,
+                      NumericTypeID::kF32, nullptr, nullptr, nullptr,
+                      nullptr),
+              cutlass::Status::kSuccess);
+}
+
+TEST(SM50_library_host, conv2d_fprop_dgrad_wgrad) {
+    using namespace test::library;
+
+    // strided, padded and dilated, with an odd number of channels
+    cutlass::conv::Conv2dProblemSize problem(
+            {2, 11, 9, 7}, {5, 3, 3, 7}, {1, 1, 1, 1}, {2, 2}, {1, 2},
+            cutlass::conv::Mode::kCrossCorrelation);
+
+    verify_host_conv2d(cutlass::conv::Operator::kFprop, ConvKind::kFprop,
+                       problem);
+    verify_host_conv2d(cutlass::conv::Operator::kDgrad, ConvKind::kDgrad,
+                       problem);
+    verify_host_conv2d(cutlass::conv::Operator::kWgrad, ConvKind::kWgrad,
+                       problem);
+
+    problem.mode = cutlass::conv::Mode::kConvolution;
+
+    verify_host_conv2d(cutlass::conv::Operator::kFprop, ConvKind::kFprop,
+                       problem);
+}
+
+TEST(SM50_library_host, reduction_f32) {
+    using namespace test::library;
+
+    ReductionFunctionalKey key(Provider::kHost, NumericTypeID::kF32,
+                               NumericTypeID::kF32, NumericTypeID::kF32,
+                               NumericTypeID::kF32);
+
+    Operation const* operation =
+            Singleton::get().operation_table.find_reduction_operation(key);
+
+    ASSERT_NE(operation, nullptr);
+
+    int const kRows = 37, kColumns = 20, kPartitions = 3;
+
+    std::vector<float> workspace =
+            make_tensor<float>(kRows * kColumns * kPartitions, 1);
+    std::vector<float> source = make_tensor<float>(kRows * kColumns, 2);
+    std::vector<float> destination(kRows * kColumns);
+
+    float alpha = 2, beta = 1;
+
+    ReductionConfiguration configuration{{kRows, kColumns}, kPartitions,
+                                         kRows * kColumns,  kColumns,
+                                         kColumns,          kColumns};
+
+    ReductionArguments arguments{workspace.data(), source.data(),
+                                 destination.data(), nullptr, &alpha,
+                                 &beta, ScalarPointerMode::kHost};
+
+    std::vector<char> host_workspace(
+            operation->get_host_workspace_size(&configuration));
+
+    ASSERT_EQ(operation->initialize(&configuration, host_workspace.data()),
+              cutlass::Status::kSuccess);
+    ASSERT_EQ(operation->run(&arguments, host_workspace.data()),
+              cutlass::Status::kSuccess);
+
+    for (int i = 0; i < kRows * kColumns; ++i) {
+        float sum = 0;
+        for (int partition = 0; partition < kPartitions; ++partition) {
+            sum += workspace[partition * kRows * kColumns + i];
+        }
+
+        EXPECT_EQ(destination[i], alpha * sum + beta * source[i]);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,700 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the operation table of the CUTLASS Library.
+*/
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/operation_table.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Operation which only carries a description
+class MockGemmOperation : public Operation {
+    GemmDescription description_;
+
+public:
+    MockGemmOperation(GemmDescription const& description)
+            : description_(description) {}
+
+    OperationDescription const& description() const override {
+        return description_;
+    }
+
+    cutlass::Status can_implement(void const*, void const*) const override {
+        return cutlass::Status::kSuccess;
+    }
+
+    uint64_t get_host_workspace_size(void const*) const override { return 0; }
+
+    uint64_t get_device_workspace_size(void const*) const override {
+        return 0;
+    }
+
+    cutlass::Status initialize(void const*, void*, void*,
+                               cudaStream_t) const override {
+        return cutlass::Status::kSuccess;
+    }
+
+    cutlass::Status run(void const*, void*, void*,
+                        cudaStream_t) const override {
+        return cutlass::Status::kSuccess;
+    }
+};
+
+/// Describes a GEMM of the given functional key
+GemmDescription make_gemm_description(GemmFunctionalKey const& key, int cc,
+                                      int alignment, int tile_m) {
+    GemmDescription desc(
+            key.gemm_kind,
+            TensorDescription(key.element_A, key.layout_A, alignment),
+            TensorDescription(key.element_B, key.layout_B, alignment),
+            TensorDescription(key.element_C, LayoutTypeID::kColumnMajor,
+                              alignment),
+            key.element_scalar, SplitKMode::kNone, key.transform_A,
+            key.transform_B);
+
+    desc.name = "mock_gemm";
+    desc.provider = key.provider;
+    desc.kind = OperationKind::kGemm;
+    desc.tile_description.threadblock_shape =
+            cutlass::gemm::GemmCoord(tile_m, 128, 32);
+    desc.tile_description.threadblock_stages = 2;
+    desc.tile_description.math_instruction.element_accumulator =
+            key.element_compute;
+    desc.tile_description.minimum_compute_capability = cc;
+    desc.tile_description.maximum_compute_capability = 1024;
+
+    return desc;
+}
+
+/// Enumerates distinct GEMM functional keys
+std::vector<GemmFunctionalKey> make_gemm_functional_keys() {
+    NumericTypeID const elements[] = {
+            NumericTypeID::kF16, NumericTypeID::kBF16, NumericTypeID::kTF32,
+            NumericTypeID::kF32, NumericTypeID::kF64,  NumericTypeID::kS8,
+            NumericTypeID::kU8,  NumericTypeID::kCF32};
+
+    LayoutTypeID const layouts[] = {LayoutTypeID::kColumnMajor,
+                                    LayoutTypeID::kRowMajor};
+
+    NumericTypeID const outputs[] = {NumericTypeID::kF16, NumericTypeID::kF32,
+                                     NumericTypeID::kS32, NumericTypeID::kF64};
+
+    std::vector<GemmFunctionalKey> keys;
+
+    for (NumericTypeID element : elements) {
+        for (LayoutTypeID layout_A : layouts) {
+            for (LayoutTypeID layout_B : layouts) {
+                for (NumericTypeID element_C : outputs) {
+                    keys.emplace_back(Provider::kCUTLASS, GemmKind::kGemm,
+                                      NumericTypeID::kF32, NumericTypeID::kF32,
+                                      element, layout_A, ComplexTransform::kNone,
+                                      element, layout_B, ComplexTransform::kNone,
+                                      element_C);
+                }
+            }
+        }
+    }
+
+    return keys;
+}
+
+/// Appends GEMMs of every compute capability, alignment and tile size
+void append_gemm_operations(Manifest& manifest,
+                            std::vector<GemmFunctionalKey> const& keys) {
+    int const ccs[] = {50, 61, 70, 75, 80, 86};
+    int const alignments[] = {1, 2, 4, 8};
+    int const tiles[] = {64, 128, 256};
+
+    for (auto const& key : keys) {
+        for (int cc : ccs) {
+            for (int alignment : alignments) {
+                for (int tile_m : tiles) {
+                    manifest.append(new MockGemmOperation(
+                            make_gemm_description(key, cc, alignment, tile_m)));
+                }
+            }
+        }
+    }
+}
+
+/// Selects a GEMM by walking the preference map and reading descriptions
+Operation const* select_gemm_operation(GemmOperationVectorMap const& operators,
+                                       GemmPreferenceKey const& preference_key) {
+    auto cc_it = operators.upper_bound(preference_key);
+
+    while (cc_it != operators.begin()) {
+        --cc_it;
+
+        for (auto const* op : cc_it->second) {
+            GemmDescription const& desc =
+                    static_cast<GemmDescription const&>(op->description());
+
+            int alignment = std::max(std::max(desc.A.alignment, desc.B.alignment),
+                                     desc.C.alignment);
+
+            if (desc.tile_description.minimum_compute_capability <=
+                        preference_key.compute_capability &&
+                preference_key.compute_capability <=
+                        desc.tile_description.maximum_compute_capability &&
+                alignment <= preference_key.alignment) {
+                return op;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Number of times the lazily initialized entry was constructed
+int lazy_entry_constructions = 0;
+
+GemmFunctionalKey lazy_entry_key() {
+    return GemmFunctionalKey(Provider::kCUTLASS, GemmKind::kUniversal,
+                             NumericTypeID::kF32, NumericTypeID::kF32,
+                             NumericTypeID::kF16, LayoutTypeID::kRowMajor,
+                             ComplexTransform::kNone, NumericTypeID::kF16,
+                             LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+                             NumericTypeID::kF16);
+}
+
+void initialize_lazy_entry(Manifest& manifest) {
+    ++lazy_entry_constructions;
+    manifest.append(new MockGemmOperation(
+            make_gemm_description(lazy_entry_key(), 80, 8, 128)));
+}
+
+ManifestEntry const lazy_entries[] = {{
+        "mock_lazy_gemm", Provider::kCUTLASS, OperationKind::kGemm,
+        GemmKind::kUniversal, ConvKind::kInvalid, NumericTypeID::kF32,
+        NumericTypeID::kF32, NumericTypeID::kF16, LayoutTypeID::kRowMajor,
+        ComplexTransform::kNone, NumericTypeID::kF16,
+        LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+        NumericTypeID::kF16, LayoutTypeID::kColumnMajor, 80, 1024,
+        initialize_lazy_entry}};
+
+/// Entries of one functional key for two ranges of compute capabilities
+void initialize_sm50_entry(Manifest& manifest) {
+    manifest.append(new MockGemmOperation(
+            make_gemm_description(lazy_entry_key(), 50, 1, 128)));
+}
+
+void initialize_sm90_entry(Manifest& manifest) {
+    manifest.append(new MockGemmOperation(
+            make_gemm_description(lazy_entry_key(), 90, 8, 128)));
+}
+
+ManifestEntry const cc_range_entries[] = {
+        {"mock_sm50_gemm", Provider::kCUTLASS, OperationKind::kGemm,
+         GemmKind::kUniversal, ConvKind::kInvalid, NumericTypeID::kF32,
+         NumericTypeID::kF32, NumericTypeID::kF16, LayoutTypeID::kRowMajor,
+         ComplexTransform::kNone, NumericTypeID::kF16,
+         LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+         NumericTypeID::kF16, LayoutTypeID::kColumnMajor, 50, 89,
+         initialize_sm50_entry},
+        {"mock_sm90_gemm", Provider::kCUTLASS, OperationKind::kGemm,
+         GemmKind::kUniversal, ConvKind::kInvalid, NumericTypeID::kF32,
+         NumericTypeID::kF32, NumericTypeID::kF16, LayoutTypeID::kRowMajor,
+         ComplexTransform::kNone, NumericTypeID::kF16,
+         LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+         NumericTypeID::kF16, LayoutTypeID::kColumnMajor, 90, 1024,
+         initialize_sm90_entry}};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Functional keys of the startup benchmark, computed once
+std::vector<GemmFunctionalKey> const& benchmark_keys() {
+    static std::vector<GemmFunctionalKey> const keys =
+            make_gemm_functional_keys();
+    return keys;
+}
+
+/// Constructs one operation of a benchmark functional key
+template <int Key>
+void initialize_benchmark_entry(Manifest& manifest) {
+    manifest.append(new MockGemmOperation(
+            make_gemm_description(benchmark_keys()[Key], 50, 8, 128)));
+}
+
+/// Collects the initializers of benchmark keys [0, Count)
+template <int Count>
+struct BenchmarkInitializers {
+    static void append(std::vector<void (*)(Manifest&)>& initializers) {
+        BenchmarkInitializers<Count - 1>::append(initializers);
+        initializers.push_back(&initialize_benchmark_entry<Count - 1>);
+    }
+};
+
+template <>
+struct BenchmarkInitializers<0> {
+    static void append(std::vector<void (*)(Manifest&)>&) {}
+};
+
+/// Builds manifest entries for every benchmark key, compute capability,
+/// alignment and tile size, as the generator does for all kernels
+std::vector<ManifestEntry> make_benchmark_entries() {
+    int const kKeyCount = 128;
+
+    std::vector<void (*)(Manifest&)> initializers;
+    BenchmarkInitializers<kKeyCount>::append(initializers);
+
+    std::vector<GemmFunctionalKey> const& keys = benchmark_keys();
+
+    int const ccs[] = {50, 61, 70, 75, 80, 86, 90};
+    int const variants = 4 * 3;
+
+    std::vector<ManifestEntry> entries;
+
+    for (int key_idx = 0; key_idx < kKeyCount && key_idx < int(keys.size());
+         ++key_idx) {
+        GemmFunctionalKey const& key = keys[key_idx];
+
+        for (int cc : ccs) {
+            for (int variant = 0; variant < variants; ++variant) {
+                entries.push_back(ManifestEntry{
+                        "mock_benchmark_gemm", key.provider,
+                        OperationKind::kGemm, key.gemm_kind,
+                        ConvKind::kInvalid, key.element_compute,
+                        key.element_scalar, key.element_A, key.layout_A,
+                        key.transform_A, key.element_B, key.layout_B,
+                        key.transform_B, key.element_C,
+                        LayoutTypeID::kColumnMajor, cc, 1024,
+                        initializers[key_idx]});
+            }
+        }
+    }
+
+    return entries;
+}
+
+/// Returns the resident set size of the process in bytes, or zero if unknown
+size_t resident_set_bytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    statm >> total_pages >> resident_pages;
+
+    return resident_pages * size_t(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Convolution operation which only carries a description
+class MockConvolutionOperation : public MockGemmOperation {
+    ConvolutionDescription description_;
+
+public:
+    MockConvolutionOperation(ConvolutionDescription const& description)
+            : MockGemmOperation(GemmDescription()),
+              description_(description) {}
+
+    OperationDescription const& description() const override {
+        return description_;
+    }
+};
+
+/// Describes an int8 NCHW32 convolution with a bias add epilogue
+ConvolutionDescription make_convolution_description(OperationKind kind,
+                                                    int cc) {
+    ConvolutionDescription desc(ConvType::kConvolution,
+                                EpilogueKind::kBiasAddLinearCombinationClamp);
+
+    desc.name = "mock_convolution";
+    desc.provider = Provider::kCUTLASS;
+    desc.kind = kind;
+    desc.A = TensorDescription(NumericTypeID::kS8, LayoutTypeID::kTensorNC32HW32,
+                               16);
+    desc.B = TensorDescription(NumericTypeID::kS8,
+                               LayoutTypeID::kTensorC32RSK32, 16);
+    desc.C = TensorDescription(NumericTypeID::kS8, LayoutTypeID::kTensorNC32HW32,
+                               8);
+    desc.bias = TensorDescription(NumericTypeID::kS32,
+                                  LayoutTypeID::kTensorNC32HW32, 1);
+    desc.element_epilogue = NumericTypeID::kF32;
+    desc.tile_description.math_instruction.element_accumulator =
+            NumericTypeID::kS32;
+    desc.tile_description.minimum_compute_capability = cc;
+    desc.tile_description.maximum_compute_capability = 1024;
+
+    return desc;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(OperationTable, gemm_candidates_match_preference_map) {
+    using namespace test::library;
+
+    std::vector<GemmFunctionalKey> keys = make_gemm_functional_keys();
+
+    Manifest manifest;
+    append_gemm_operations(manifest, keys);
+
+    OperationTable table;
+    table.append(manifest);
+
+    int const ccs[] = {50, 60, 70, 75, 80, 86, 90};
+    int const alignments[] = {1, 2, 4, 8, 16};
+
+    for (auto const& key : keys) {
+        OperationCandidateVector const* candidates =
+                table.find_gemm_candidates(key);
+        GemmOperationVectorMap const* operators =
+                table.find_gemm_operations(key);
+
+        ASSERT_TRUE(candidates != nullptr);
+        ASSERT_TRUE(operators != nullptr);
+        EXPECT_EQ(candidates->size(), size_t(6 * 4 * 3));
+
+        for (int cc : ccs) {
+            for (int alignment : alignments) {
+                GemmPreferenceKey preference_key(cc, alignment);
+
+                EXPECT_EQ(select_gemm_operation(*operators, preference_key),
+                          find_gemm_operation(*candidates, preference_key));
+            }
+        }
+    }
+
+    GemmFunctionalKey missing = keys.front();
+    missing.element_C = NumericTypeID::kS8;
+
+    EXPECT_TRUE(table.find_gemm_candidates(missing) == nullptr);
+    EXPECT_TRUE(table.find_gemm_operations(missing) == nullptr);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(OperationTable, gemm_entries_constructed_on_first_query) {
+    using namespace test::library;
+
+    lazy_entry_constructions = 0;
+
+    Manifest manifest;
+    manifest.append(lazy_entries, sizeof(lazy_entries) / sizeof(ManifestEntry));
+
+    OperationTable table;
+    table.append(manifest);
+
+    EXPECT_EQ(lazy_entry_constructions, 0);
+    EXPECT_EQ(manifest.operations().size(), size_t(0));
+
+    OperationCandidateVector const* candidates =
+            table.find_gemm_candidates(lazy_entry_key());
+
+    ASSERT_TRUE(candidates != nullptr);
+    ASSERT_EQ(candidates->size(), size_t(1));
+    EXPECT_EQ(candidates->front().minimum_compute_capability, 80);
+    EXPECT_EQ(candidates->front().alignment, 8);
+    EXPECT_EQ(candidates->front().threadblock_shape.m(), 128);
+
+    table.find_gemm_candidates(lazy_entry_key());
+    table.initialize_all();
+
+    EXPECT_EQ(lazy_entry_constructions, 1);
+    EXPECT_EQ(manifest.operations().size(), size_t(1));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(OperationTable, convolution_operations_indexed_apart_from_conv2d) {
+    using namespace test::library;
+
+    Manifest manifest;
+    manifest.append(new MockConvolutionOperation(
+            make_convolution_description(OperationKind::kConvolution, 75)));
+    manifest.append(new MockConvolutionOperation(
+            make_convolution_description(OperationKind::kConvolution, 61)));
+
+    OperationTable table;
+    table.append(manifest);
+
+    ConvFunctionalKey key(Provider::kCUTLASS, ConvKind::kFprop,
+                          NumericTypeID::kS8, LayoutTypeID::kTensorNC32HW32,
+                          NumericTypeID::kS8, LayoutTypeID::kTensorC32RSK32,
+                          NumericTypeID::kS8, LayoutTypeID::kTensorNC32HW32,
+                          NumericTypeID::kS32, NumericTypeID::kF32);
+
+    ConvOperationVectorMap const* operators =
+            table.find_convolution_operations(key);
+    OperationCandidateVector const* candidates =
+            table.find_convolution_candidates(key);
+
+    ASSERT_TRUE(operators != nullptr);
+    ASSERT_TRUE(candidates != nullptr);
+    EXPECT_EQ(operators->size(), size_t(2));
+    EXPECT_EQ(candidates->size(), size_t(2));
+
+    EXPECT_TRUE(table.find_conv2d_operations(key) == nullptr);
+    EXPECT_TRUE(table.find_conv2d_candidates(key) == nullptr);
+
+    auto const& desc = static_cast<ConvolutionDescription const&>(
+            operators->begin()->second.front()->description());
+
+    EXPECT_EQ(desc.conv_type, ConvType::kConvolution);
+    EXPECT_EQ(desc.epilogue, EpilogueKind::kBiasAddLinearCombinationClamp);
+    EXPECT_EQ(desc.bias.element, NumericTypeID::kS32);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Compares the cost of selecting a GEMM through the preference maps against
+/// the flat index. Reports the time per lookup; both must select the same
+/// operations.
+TEST(OperationTable, gemm_lookup_benchmark) {
+    using namespace test::library;
+
+    std::vector<GemmFunctionalKey> keys = make_gemm_functional_keys();
+
+    Manifest manifest;
+    append_gemm_operations(manifest, keys);
+
+    OperationTable table;
+    table.append(manifest);
+
+    int const kIterations = 200;
+    GemmPreferenceKey preference_key(75, 4);
+
+    size_t map_checksum = 0;
+    auto map_start = std::chrono::steady_clock::now();
+
+    for (int iter = 0; iter < kIterations; ++iter) {
+        for (auto const& key : keys) {
+            auto it = table.gemm_operations.find(key);
+            map_checksum += size_t(
+                    select_gemm_operation(it->second, preference_key));
+        }
+    }
+
+    auto map_end = std::chrono::steady_clock::now();
+
+    size_t index_checksum = 0;
+    auto index_start = std::chrono::steady_clock::now();
+
+    for (int iter = 0; iter < kIterations; ++iter) {
+        for (auto const& key : keys) {
+            index_checksum += size_t(find_gemm_operation(
+                    *table.find_gemm_candidates(key), preference_key));
+        }
+    }
+
+    auto index_end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(map_checksum, index_checksum);
+
+    double lookups = double(kIterations) * double(keys.size());
+
+    std::cout << "GEMM lookup: preference map "
+              << std::chrono::duration<double, std::nano>(map_end - map_start)
+                                 .count() /
+                         lookups
+              << " ns, flat index "
+              << std::chrono::duration<double, std::nano>(index_end -
+                                                          index_start)
+                                 .count() /
+                         lookups
+              << " ns" << std::endl;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(OperationTable, entries_outside_compute_capabilities_not_indexed) {
+    using namespace test::library;
+
+    size_t const kEntryCount = sizeof(cc_range_entries) / sizeof(ManifestEntry);
+
+    // A device of compute capability 8.0 only constructs the SM50 entry
+    {
+        Manifest manifest;
+        manifest.append(cc_range_entries, kEntryCount);
+
+        OperationTable table;
+        table.append(manifest, std::vector<int>({80}));
+
+        OperationCandidateVector const* candidates =
+                table.find_gemm_candidates(lazy_entry_key());
+
+        ASSERT_TRUE(candidates != nullptr);
+        ASSERT_EQ(candidates->size(), size_t(1));
+        EXPECT_EQ(candidates->front().minimum_compute_capability, 50);
+        EXPECT_EQ(manifest.operations().size(), size_t(1));
+    }
+
+    // Devices of several compute capabilities index both entries
+    {
+        Manifest manifest;
+        manifest.append(cc_range_entries, kEntryCount);
+
+        OperationTable table;
+        table.append(manifest, std::vector<int>({75, 90}));
+
+        OperationCandidateVector const* candidates =
+                table.find_gemm_candidates(lazy_entry_key());
+
+        ASSERT_TRUE(candidates != nullptr);
+        EXPECT_EQ(candidates->size(), size_t(2));
+    }
+
+    // A key without entries for the device is absent
+    {
+        Manifest manifest;
+        manifest.append(cc_range_entries + 1, 1);
+
+        OperationTable table;
+        table.append(manifest, std::vector<int>({80}));
+
+        EXPECT_TRUE(table.find_gemm_candidates(lazy_entry_key()) == nullptr);
+        EXPECT_EQ(manifest.operations().size(), size_t(0));
+    }
+
+    // Without known devices every entry is indexed
+    {
+        Manifest manifest;
+        manifest.append(cc_range_entries, kEntryCount);
+
+        OperationTable table;
+        table.append(manifest);
+
+        OperationCandidateVector const* candidates =
+                table.find_gemm_candidates(lazy_entry_key());
+
+        ASSERT_TRUE(candidates != nullptr);
+        EXPECT_EQ(candidates->size(), size_t(2));
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Compares the startup cost of a manifest of generated entries constructed
+/// eagerly against one constructed on demand for a device of compute
+/// capability 8.0. Reports time and resident memory; eager construction is
+/// measured last so that memory released by the lazy table is not reused.
+TEST(OperationTable, startup_benchmark) {
+    using namespace test::library;
+
+    std::vector<ManifestEntry> entries = make_benchmark_entries();
+    std::vector<int> const compute_capabilities({80});
+
+    double const kMiB = double(1 << 20);
+
+    // Lazy: register entries, then query one functional key
+    size_t lazy_operations = 0;
+    double lazy_ms = 0;
+    double query_ms = 0;
+    double lazy_mib = 0;
+    {
+        size_t rss_begin = resident_set_bytes();
+        auto start = std::chrono::steady_clock::now();
+
+        Manifest manifest;
+        manifest.append(entries.data(), entries.size());
+
+        OperationTable table;
+        table.append(manifest, compute_capabilities);
+
+        auto registered = std::chrono::steady_clock::now();
+
+        ASSERT_TRUE(table.find_gemm_candidates(benchmark_keys().front()) !=
+                    nullptr);
+
+        auto queried = std::chrono::steady_clock::now();
+
+        lazy_operations = manifest.operations().size();
+        lazy_ms = std::chrono::duration<double, std::milli>(registered - start)
+                          .count();
+        query_ms = std::chrono::duration<double, std::milli>(queried -
+                                                             registered)
+                           .count();
+        lazy_mib = double(resident_set_bytes() - rss_begin) / kMiB;
+    }
+
+    // Eager: construct every operation, then index it
+    size_t eager_operations = 0;
+    double eager_ms = 0;
+    double eager_mib = 0;
+    {
+        size_t rss_begin = resident_set_bytes();
+        auto start = std::chrono::steady_clock::now();
+
+        Manifest manifest;
+        manifest.append(entries.data(), entries.size());
+        manifest.initialize_entries();
+
+        OperationTable table;
+        table.append(manifest);
+
+        auto end = std::chrono::steady_clock::now();
+
+        eager_operations = manifest.operations().size();
+        eager_ms = std::chrono::duration<double, std::milli>(end - start)
+                           .count();
+        eager_mib = double(resident_set_bytes() - rss_begin) / kMiB;
+    }
+
+    EXPECT_EQ(eager_operations, entries.size());
+
+    // One key, limited to entries of compute capability 8.0 or lower
+    EXPECT_EQ(lazy_operations, size_t(5 * 12));
+
+    std::cout << "Startup with " << entries.size() << " entries: eager "
+              << eager_ms << " ms, " << eager_mib << " MiB, "
+              << eager_operations << " operations; lazy " << lazy_ms
+              << " ms, " << lazy_mib << " MiB, first query " << query_ms
+              << " ms, " << lazy_operations << " operations" << std::endl;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,248 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for operation-level tracing of the CUTLASS Library.
+*/
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/handle.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/trace.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Enables tracing for the lifetime of a test, starting from an empty trace
+struct ScopedTrace {
+    ScopedTrace() {
+        trace_clear();
+        set_trace_enabled(true);
+    }
+
+    ~ScopedTrace() {
+        set_trace_enabled(false);
+        trace_clear();
+    }
+};
+
+/// Returns the events of a given kind
+TraceEventVector events_of_kind(TraceEventVector const& events,
+                                TraceEventKind kind) {
+    TraceEventVector selected;
+    for (auto const& event : events) {
+        if (event.kind == kind) {
+            selected.push_back(event);
+        }
+    }
+    return selected;
+}
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SM50_library_trace, disabled) {
+    using namespace test::library;
+
+    set_trace_enabled(false);
+    trace_clear();
+
+    {
+        TraceScope scope(TraceEventKind::kLaunch, "kernel");
+        EXPECT_FALSE(scope.active());
+    }
+    trace_record(TraceEventKind::kLaunch, "kernel", 0, 1);
+
+    EXPECT_TRUE(trace_snapshot().empty());
+}
+
+TEST(SM50_library_trace, scope) {
+    using namespace test::library;
+
+    ScopedTrace trace;
+
+    {
+        TraceScope scope(TraceEventKind::kSelect, "gemm");
+        ASSERT_TRUE(scope.active());
+        scope.set_detail("m=%d n=%d k=%d", 128, 64, 32);
+        scope.set_name("selected_kernel");
+    }
+
+    TraceScope finished(TraceEventKind::kVerify, "verify");
+    finished.finish();
+    EXPECT_FALSE(finished.active());
+
+    TraceEventVector events = trace_snapshot();
+    ASSERT_EQ(events.size(), size_t(2));
+
+    EXPECT_EQ(events[0].kind, TraceEventKind::kSelect);
+    EXPECT_STREQ(events[0].name, "selected_kernel");
+    EXPECT_STREQ(events[0].detail, "m=128 n=64 k=32");
+    EXPECT_GE(events[0].duration_ns, 0);
+
+    EXPECT_EQ(events[1].kind, TraceEventKind::kVerify);
+    EXPECT_GE(events[1].begin_ns, events[0].begin_ns);
+}
+
+TEST(SM50_library_trace, detail_truncated) {
+    using namespace test::library;
+
+    ScopedTrace trace;
+
+    std::string long_detail(2 * TraceEvent::kDetailCapacity, 'x');
+    trace_record(TraceEventKind::kLaunch, "kernel", 0, 10,
+                 long_detail.c_str());
+
+    TraceEventVector events = trace_snapshot();
+    ASSERT_EQ(events.size(), size_t(1));
+    EXPECT_EQ(std::strlen(events[0].detail),
+              size_t(TraceEvent::kDetailCapacity - 1));
+    EXPECT_EQ(events[0].duration_ns, 10);
+}
+
+TEST(SM50_library_trace, threads) {
+    using namespace test::library;
+
+    ScopedTrace trace;
+
+    int const kThreads = 4;
+    int const kEvents = 100;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < kEvents; ++i) {
+                TraceScope scope(TraceEventKind::kLaunch, "kernel");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    TraceEventVector events = trace_snapshot();
+    ASSERT_EQ(events.size(), size_t(kThreads * kEvents));
+
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_LE(events[i - 1].begin_ns, events[i].begin_ns);
+    }
+}
+
+TEST(SM50_library_trace, ring_overwrites_oldest) {
+    using namespace test::library;
+
+    ScopedTrace trace;
+
+    int const kEvents = 100000;
+    for (int i = 0; i < kEvents; ++i) {
+        trace_record(TraceEventKind::kLaunch, "kernel", i, i + 1);
+    }
+
+    TraceEventVector events = trace_snapshot();
+    ASSERT_FALSE(events.empty());
+    EXPECT_LT(events.size(), size_t(kEvents));
+
+    // The most recent events are retained in order
+    EXPECT_EQ(events.back().begin_ns, kEvents - 1);
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].begin_ns, events[i - 1].begin_ns + 1);
+    }
+}
+
+TEST(SM50_library_trace, chrome_trace) {
+    using namespace test::library;
+
+    ScopedTrace trace;
+
+    trace_record(TraceEventKind::kReference, "quoted \"name\"", 1000, 3500,
+                 "m=1 n=2 k=3");
+
+    std::stringstream ss;
+    write_chrome_trace(ss, trace_snapshot());
+    std::string json = ss.str();
+
+    EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"quoted \\\"name\\\"\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"cat\": \"reference\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\": \"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\": 1.000"), std::string::npos);
+    EXPECT_NE(json.find("\"dur\": 2.500"), std::string::npos);
+    EXPECT_NE(json.find("\"args\": {\"problem\": \"m=1 n=2 k=3\"}"),
+              std::string::npos);
+}
+
+TEST(SM50_library_trace, handle_gemm) {
+    using namespace test::library;
+
+    int const M = 16, N = 8, K = 4;
+
+    std::vector<float> A(M * K, 1), B(K * N, 1), C(M * N, 0), D(M * N);
+    float alpha = 1, beta = 0;
+
+    Handle handle;
+    handle.set_provider(Provider::kHost);
+
+    ScopedTrace trace;
+
+    ASSERT_EQ(handle.gemm(M, N, K, NumericTypeID::kF32, NumericTypeID::kF32,
+                          &alpha, NumericTypeID::kF32,
+                          LayoutTypeID::kColumnMajor,
+                          ComplexTransform::kNone, A.data(), M,
+                          NumericTypeID::kF32, LayoutTypeID::kRowMajor,
+                          ComplexTransform::kNone, B.data(), N, &beta,
+                          NumericTypeID::kF32, C.data(), M, D.data(), M),
+              cutlass::Status::kSuccess);
+
+    char const* name = handle.get_last_operation()->description().name;
+
+    TraceEventVector events = trace_snapshot();
+
+    for (TraceEventKind kind :
+         {TraceEventKind::kSelect, TraceEventKind::kInitialize,
+          TraceEventKind::kLaunch}) {
+        TraceEventVector selected = events_of_kind(events, kind);
+        ASSERT_EQ(selected.size(), size_t(1)) << to_string(kind);
+        EXPECT_STREQ(selected[0].name, name);
+        EXPECT_STREQ(selected[0].detail, "m=16 n=8 k=4 batch=1");
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,286 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the device workspace arena of the CUTLASS Library.
+
+    A mock allocator hands out host memory, so the growth policy is tested
+    without a device.
+*/
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/workspace.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/// Records the calls made by an arena
+class MockWorkspaceAllocator : public WorkspaceAllocator {
+public:
+    struct Call {
+        enum Kind { kAllocate, kDeallocate, kFillZero } kind;
+        size_t bytes;
+        cudaStream_t stream;
+    };
+
+    std::vector<Call> calls;
+
+    /// Number of allocations to serve before failing (negative: unlimited)
+    int remaining;
+
+    MockWorkspaceAllocator() : remaining(-1) {}
+
+    virtual void* allocate(size_t bytes, cudaStream_t stream) {
+        calls.push_back({Call::kAllocate, bytes, stream});
+        if (!remaining) {
+            return nullptr;
+        }
+        --remaining;
+        buffers_.emplace_back(new char[bytes]);
+        return buffers_.back().get();
+    }
+
+    virtual void deallocate(void*, size_t bytes, cudaStream_t stream) {
+        calls.push_back({Call::kDeallocate, bytes, stream});
+    }
+
+    virtual bool fill_zero(void*, size_t bytes, cudaStream_t stream) {
+        calls.push_back({Call::kFillZero, bytes, stream});
+        return true;
+    }
+
+    /// Returns the sizes of calls of one kind
+    std::vector<size_t> sizes(Call::Kind kind) const {
+        std::vector<size_t> result;
+        for (auto const& call : calls) {
+            if (call.kind == kind) {
+                result.push_back(call.bytes);
+            }
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::unique_ptr<char[]> > buffers_;
+};
+
+using Call = MockWorkspaceAllocator::Call;
+
+}  // namespace library
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(SM50_library_workspace, grows_geometrically) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<MockWorkspaceAllocator>();
+    WorkspaceArena arena(allocator);
+    cudaStream_t stream = reinterpret_cast<cudaStream_t>(0x10);
+
+    void* workspace = nullptr;
+
+    ASSERT_EQ(arena.acquire(1000, &workspace, stream),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(arena.capacity(), size_t(1024));
+    EXPECT_EQ(workspace, arena.data());
+
+    // Growth at least doubles the capacity
+    ASSERT_EQ(arena.acquire(1500, &workspace, stream),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(arena.capacity(), size_t(2048));
+
+    // Smaller and equal requests reuse the allocation
+    ASSERT_EQ(arena.acquire(2048, &workspace, stream),
+              cutlass::Status::kSuccess);
+    ASSERT_EQ(arena.acquire(10, &workspace, stream),
+              cutlass::Status::kSuccess);
+
+    // Requests beyond twice the capacity are served exactly
+    ASSERT_EQ(arena.acquire(10000, &workspace, stream),
+              cutlass::Status::kSuccess);
+    EXPECT_EQ(arena.capacity(), size_t(10240));
+
+    EXPECT_EQ(arena.allocation_count(), uint64_t(3));
+    EXPECT_EQ(allocator->sizes(Call::kAllocate),
+              (std::vector<size_t>{1024, 2048, 10240}));
+    EXPECT_EQ(allocator->sizes(Call::kDeallocate),
+              (std::vector<size_t>{1024, 2048}));
+
+    // Only the requested bytes are cleared
+    EXPECT_EQ(allocator->sizes(Call::kFillZero),
+              (std::vector<size_t>{1000, 1500, 2048, 10, 10000}));
+
+    // The previous allocation is released before the next is made, in
+    // stream order
+    ASSERT_EQ(allocator->calls[2].kind, Call::kDeallocate);
+    ASSERT_EQ(allocator->calls[3].kind, Call::kAllocate);
+    for (auto const& call : allocator->calls) {
+        EXPECT_EQ(call.stream, stream);
+    }
+}
+
+TEST(SM50_library_workspace, grows_across_streams) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<MockWorkspaceAllocator>();
+    cudaStream_t first = reinterpret_cast<cudaStream_t>(0x10);
+    cudaStream_t second = reinterpret_cast<cudaStream_t>(0x20);
+
+    {
+        WorkspaceArena arena(allocator);
+        void* workspace = nullptr;
+
+        ASSERT_EQ(arena.acquire(1000, &workspace, first),
+                  cutlass::Status::kSuccess);
+        ASSERT_EQ(arena.reserve(4096, second), cutlass::Status::kSuccess);
+        ASSERT_EQ(arena.acquire(10000, &workspace, first),
+                  cutlass::Status::kSuccess);
+    }
+
+    // Each allocation is released on the stream that last used it, which
+    // may still be reading it, rather than on the stream that grew the arena
+    std::vector<Call> deallocations;
+    for (auto const& call : allocator->calls) {
+        if (call.kind == Call::kDeallocate) {
+            deallocations.push_back(call);
+        }
+    }
+
+    ASSERT_EQ(deallocations.size(), size_t(3));
+    EXPECT_EQ(deallocations[0].bytes, size_t(1024));
+    EXPECT_EQ(deallocations[0].stream, first);
+    EXPECT_EQ(deallocations[1].bytes, size_t(4096));
+    EXPECT_EQ(deallocations[1].stream, second);
+    EXPECT_EQ(deallocations[2].bytes, size_t(10240));
+    EXPECT_EQ(deallocations[2].stream, first);
+}
+
+TEST(SM50_library_workspace, suballocation) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<MockWorkspaceAllocator>();
+    WorkspaceArena arena(allocator);
+
+    size_t const bytes[] = {100, 0, 300};
+    void* workspaces[3];
+
+    ASSERT_EQ(arena.acquire(bytes, workspaces, 3, nullptr),
+              cutlass::Status::kSuccess);
+
+    char* base = static_cast<char*>(arena.data());
+
+    EXPECT_EQ(workspaces[0], base);
+    EXPECT_EQ(workspaces[1], nullptr);
+    EXPECT_EQ(workspaces[2], base + WorkspaceArena::kAlignment);
+    EXPECT_EQ(arena.capacity(), size_t(3 * WorkspaceArena::kAlignment));
+
+    EXPECT_EQ(allocator->sizes(Call::kFillZero),
+              (std::vector<size_t>{100, 300}));
+}
+
+TEST(SM50_library_workspace, reserve_and_release) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<MockWorkspaceAllocator>();
+
+    {
+        WorkspaceArena arena(allocator);
+
+        ASSERT_EQ(arena.reserve(3000, nullptr), cutlass::Status::kSuccess);
+        EXPECT_EQ(arena.capacity(), size_t(3072));
+
+        // Reservations never shrink the arena nor clear it
+        ASSERT_EQ(arena.reserve(100, nullptr), cutlass::Status::kSuccess);
+        EXPECT_EQ(arena.capacity(), size_t(3072));
+        EXPECT_TRUE(allocator->sizes(Call::kFillZero).empty());
+
+        arena.release(nullptr);
+        EXPECT_EQ(arena.capacity(), size_t(0));
+        EXPECT_EQ(arena.data(), nullptr);
+
+        ASSERT_EQ(arena.reserve(256, nullptr), cutlass::Status::kSuccess);
+    }
+
+    // The destructor releases the last allocation
+    EXPECT_EQ(allocator->sizes(Call::kDeallocate),
+              (std::vector<size_t>{3072, 256}));
+}
+
+TEST(SM50_library_workspace, allocation_failure) {
+    using namespace test::library;
+
+    auto allocator = std::make_shared<MockWorkspaceAllocator>();
+    allocator->remaining = 1;
+
+    WorkspaceArena arena(allocator);
+    void* workspace = nullptr;
+
+    ASSERT_EQ(arena.acquire(256, &workspace, nullptr),
+              cutlass::Status::kSuccess);
+
+    EXPECT_EQ(arena.acquire(4096, &workspace, nullptr),
+              cutlass::Status::kErrorWorkspaceNull);
+    EXPECT_EQ(arena.capacity(), size_t(0));
+    EXPECT_EQ(arena.data(), nullptr);
+}
+
+TEST(SM50_library_workspace, callbacks) {
+    using namespace test::library;
+
+    std::vector<size_t> allocated;
+    std::vector<size_t> deallocated;
+    char buffer[512];
+
+    {
+        WorkspaceArena arena(std::make_shared<CallbackWorkspaceAllocator>(
+                [&](size_t bytes, cudaStream_t) -> void* {
+                    allocated.push_back(bytes);
+                    return buffer;
+                },
+                [&](void* ptr, size_t bytes, cudaStream_t) {
+                    EXPECT_EQ(ptr, buffer);
+                    deallocated.push_back(bytes);
+                }));
+
+        ASSERT_EQ(arena.reserve(sizeof(buffer), nullptr),
+                  cutlass::Status::kSuccess);
+        EXPECT_EQ(arena.data(), buffer);
+    }
+
+    EXPECT_EQ(allocated, std::vector<size_t>{sizeof(buffer)});
+    EXPECT_EQ(deallocated, std::vector<size_t>{sizeof(buffer)});
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
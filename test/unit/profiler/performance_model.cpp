@@ -0,0 +1,304 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the roofline and wave quantization model of the
+   CUTLASS Profiler.
+*/
+#include <cstring>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/util.h"
+
+#include "performance_model.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace cutlass::profiler;
+using cutlass::library::MathOperationID;
+using cutlass::library::NumericTypeID;
+using cutlass::library::OpcodeClassID;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+DeviceSpec make_spec(int compute_capability, int sm_count, double clock_ghz,
+                     double memory_bandwidth) {
+    DeviceSpec spec;
+    spec.compute_capability = compute_capability;
+    spec.sm_count = sm_count;
+    spec.clock_ghz = clock_ghz;
+    spec.memory_bandwidth = memory_bandwidth;
+    spec.shared_memory_per_sm = 164 << 10;
+    spec.max_threads_per_sm = 2048;
+    spec.max_ctas_per_sm = 32;
+    return spec;
+}
+
+/// Operation with a 128x128x32 threadblock tile of four warps
+cutlass::library::OperationDescription make_operation(
+        OpcodeClassID opcode_class, int stages) {
+    cutlass::library::OperationDescription desc;
+    desc.tile_description = cutlass::library::TileDescription(
+            {128, 128, 32}, stages, {2, 2, 1},
+            cutlass::library::MathInstructionDescription(
+                    {16, 8, 16}, NumericTypeID::kF32, opcode_class));
+    return desc;
+}
+
+}  // namespace profiler
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_performance_model, peak_math_throughput) {
+    using test::profiler::make_spec;
+
+    struct {
+        DeviceSpec spec;
+        OpcodeClassID opcode_class;
+        NumericTypeID element;
+        MathOperationID math_operation;
+        double tflops;
+    } cases[] = {
+            // V100
+            {make_spec(70, 80, 1.53, 900e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kF16, MathOperationID::kMultiplyAdd, 125.3},
+            {make_spec(70, 80, 1.53, 900e9), OpcodeClassID::kSimt,
+             NumericTypeID::kF32, MathOperationID::kMultiplyAdd, 15.67},
+            {make_spec(70, 80, 1.53, 900e9), OpcodeClassID::kSimt,
+             NumericTypeID::kF64, MathOperationID::kMultiplyAdd, 7.834},
+            // T4
+            {make_spec(75, 40, 1.59, 320e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kS8, MathOperationID::kMultiplyAdd, 130.3},
+            // A100
+            {make_spec(80, 108, 1.41, 1555e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kF16, MathOperationID::kMultiplyAdd, 311.9},
+            {make_spec(80, 108, 1.41, 1555e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kF32, MathOperationID::kMultiplyAdd, 155.9},
+            {make_spec(80, 108, 1.41, 1555e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kF32, MathOperationID::kMultiplyAddFastF16, 311.9},
+            {make_spec(80, 108, 1.41, 1555e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kCF64, MathOperationID::kMultiplyAddComplex, 19.49},
+            {make_spec(80, 108, 1.41, 1555e9), OpcodeClassID::kSparseTensorOp,
+             NumericTypeID::kF16, MathOperationID::kMultiplyAdd, 623.7},
+            // Unknown rates
+            {make_spec(52, 24, 1.0, 100e9), OpcodeClassID::kTensorOp,
+             NumericTypeID::kF16, MathOperationID::kMultiplyAdd, 0}};
+
+    for (auto const& c : cases) {
+        double peak = c.spec.peak_flops(c.opcode_class, c.element,
+                                        c.math_operation);
+
+        EXPECT_NEAR(peak / 1.0e12, c.tflops, c.tflops * 1.0e-3)
+                << "cc" << c.spec.compute_capability << " "
+                << cutlass::library::to_string(c.opcode_class) << " "
+                << cutlass::library::to_string(c.element);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_performance_model, roofline_efficiency) {
+    DeviceSpec spec = test::profiler::make_spec(80, 108, 1.41, 1555e9);
+
+    PerformanceModel model(test::profiler::make_operation(
+                                   OpcodeClassID::kTensorOp, 3),
+                           NumericTypeID::kF16, NumericTypeID::kF16, 0);
+
+    double peak =
+            spec.peak_flops(OpcodeClassID::kTensorOp, NumericTypeID::kF16);
+
+    // Memory bound: 10 flops per byte is far below the ridge point of ~200
+    int64_t bytes = int64_t(1) << 30;
+    int64_t flops = 10 * bytes;
+    double runtime = 1.0e3 * double(bytes) / (0.5 * spec.memory_bandwidth);
+
+    model.evaluate(spec, flops, bytes, runtime);
+
+    EXPECT_DOUBLE_EQ(model.arithmetic_intensity, 10.0);
+    EXPECT_DOUBLE_EQ(model.peak_flops, peak);
+    EXPECT_NEAR(model.roofline_flops, 10.0 * spec.memory_bandwidth, 1.0);
+    EXPECT_NEAR(model.memory_efficiency, 0.5, 1.0e-9);
+    EXPECT_NEAR(model.roofline_efficiency, 0.5, 1.0e-9);
+    EXPECT_LT(model.compute_efficiency, 0.05);
+
+    // Compute bound: the roofline is the math peak
+    flops = 1000 * bytes;
+    runtime = 1.0e3 * double(flops) / (0.8 * peak);
+
+    model.evaluate(spec, flops, bytes, runtime);
+
+    EXPECT_DOUBLE_EQ(model.roofline_flops, peak);
+    EXPECT_NEAR(model.compute_efficiency, 0.8, 1.0e-9);
+    EXPECT_NEAR(model.roofline_efficiency, 0.8, 1.0e-9);
+
+    // Nothing is derived without a measurement
+    model.evaluate(spec, flops, bytes, 0);
+
+    EXPECT_EQ(model.compute_efficiency, 0);
+    EXPECT_EQ(model.memory_efficiency, 0);
+    EXPECT_EQ(model.roofline_efficiency, 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_performance_model, wave_quantization) {
+    DeviceSpec spec = test::profiler::make_spec(80, 108, 1.41, 1555e9);
+
+    // Three stages of 128x32 half-precision tiles of A and B occupy 48 KiB,
+    // so shared memory limits residency to three CTAs per SM
+    cutlass::library::OperationDescription desc =
+            test::profiler::make_operation(OpcodeClassID::kTensorOp, 3);
+
+    struct {
+        int64_t tiles;
+        int64_t waves;
+        double wave_efficiency;
+    } cases[] = {{1, 1, 1.0 / 324},
+                 {324, 1, 1.0},
+                 {325, 2, 325.0 / 648},
+                 {648, 2, 1.0},
+                 {1000, 4, 1000.0 / 1296}};
+
+    for (auto const& c : cases) {
+        PerformanceModel model(desc, NumericTypeID::kF16, NumericTypeID::kF16,
+                               c.tiles);
+        EXPECT_EQ(model.threads_per_cta, 128);
+        EXPECT_EQ(model.shared_memory_per_cta, 48 << 10);
+
+        model.evaluate(spec, 0, 0, 0);
+
+        EXPECT_EQ(model.ctas_per_sm, 3);
+        EXPECT_EQ(model.waves, c.waves) << c.tiles << " tiles";
+        EXPECT_DOUBLE_EQ(model.wave_efficiency, c.wave_efficiency);
+    }
+
+    // Shared memory reported by the operation takes precedence
+    desc.shared_memory_size = 100 << 10;
+
+    PerformanceModel model(desc, NumericTypeID::kF16, NumericTypeID::kF16, 325);
+    model.evaluate(spec, 0, 0, 0);
+
+    EXPECT_EQ(model.ctas_per_sm, 1);
+    EXPECT_EQ(model.waves, 4);
+
+    // Unknown tiling yields no waves
+    PerformanceModel unknown;
+    unknown.evaluate(spec, 0, 0, 0);
+
+    EXPECT_EQ(unknown.waves, 0);
+    EXPECT_EQ(unknown.wave_efficiency, 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_performance_model, estimated_runtime) {
+    DeviceSpec spec = test::profiler::make_spec(80, 108, 1.41, 1555e9);
+
+    cutlass::library::OperationDescription desc =
+            test::profiler::make_operation(OpcodeClassID::kTensorOp, 3);
+
+    double peak =
+            spec.peak_flops(OpcodeClassID::kTensorOp, NumericTypeID::kF16);
+
+    int64_t bytes = int64_t(1) << 30;
+
+    // Memory bound: DRAM is saturated however the last wave is filled
+    PerformanceModel model(desc, NumericTypeID::kF16, NumericTypeID::kF16,
+                           325);
+    model.evaluate(spec, 10 * bytes, bytes, 0);
+
+    EXPECT_NEAR(model.estimated_runtime,
+                1.0e3 * double(bytes) / spec.memory_bandwidth, 1.0e-9);
+
+    // Compute bound: 325 tiles need two waves of 324 CTA slots
+    int64_t flops = 1000 * bytes;
+    model.evaluate(spec, flops, bytes, 0);
+
+    EXPECT_NEAR(model.estimated_runtime,
+                1.0e3 * double(flops) / peak * 648.0 / 325.0, 1.0e-9);
+
+    // Without tiling or math peak the estimate follows memory traffic alone
+    PerformanceModel unknown;
+    unknown.evaluate(spec, 0, bytes, 0);
+
+    EXPECT_NEAR(unknown.estimated_runtime,
+                1.0e3 * double(bytes) / spec.memory_bandwidth, 1.0e-9);
+
+    unknown.evaluate(DeviceSpec(), flops, bytes, 0);
+
+    EXPECT_EQ(unknown.estimated_runtime, 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_performance_model, device_spec_from_properties) {
+    cudaDeviceProp properties;
+    std::memset(&properties, 0, sizeof(properties));
+
+    properties.major = 8;
+    properties.minor = 6;
+    properties.multiProcessorCount = 82;
+    properties.clockRate = 1695000;
+    properties.memoryClockRate = 9751000;
+    properties.memoryBusWidth = 384;
+    properties.sharedMemPerMultiprocessor = 100 << 10;
+    properties.maxThreadsPerMultiProcessor = 1536;
+
+    DeviceSpec spec = DeviceSpec::from_properties(properties);
+
+    EXPECT_EQ(spec.compute_capability, 86);
+    EXPECT_EQ(spec.sm_count, 82);
+    EXPECT_DOUBLE_EQ(spec.clock_ghz, 1.695);
+    EXPECT_NEAR(spec.memory_bandwidth / 1.0e9, 936.0, 0.1);
+    EXPECT_EQ(spec.shared_memory_per_sm, 100 << 10);
+    EXPECT_EQ(spec.max_threads_per_sm, 1536);
+    EXPECT_EQ(spec.max_ctas_per_sm, 16);
+
+    EXPECT_NEAR(spec.peak_flops(OpcodeClassID::kSimt, NumericTypeID::kF32) /
+                        1.0e12,
+                35.58, 0.01);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_performance_model, tile_count) {
+    EXPECT_EQ(tile_count(0, 128), 0);
+    EXPECT_EQ(tile_count(1, 128), 1);
+    EXPECT_EQ(tile_count(128, 128), 1);
+    EXPECT_EQ(tile_count(129, 128), 2);
+    EXPECT_EQ(tile_count(5120, 256), 20);
+    EXPECT_EQ(tile_count(64, 0), 0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,253 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for sharded sweeps of the CUTLASS Profiler and the
+   merge of their reports.
+*/
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "json.h"
+#include "report_merge.h"
+#include "shard.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace profiler {
+
+/// Planned costs of a sweep over GEMMs of growing size with several
+/// operations per problem
+std::vector<double> sweep_costs() {
+    std::vector<double> costs;
+    for (int64_t m = 128; m <= 8192; m *= 2) {
+        for (int operation = 0; operation < 7; ++operation) {
+            int64_t flops = 2 * m * m * 4096;
+            int64_t bytes = 2 * (2 * m * 4096 + m * m);
+            costs.push_back(cutlass::profiler::planned_cost(flops, bytes, 21));
+        }
+    }
+    return costs;
+}
+
+/// Report columns of a GEMM sweep with one argument per problem dimension
+std::string csv_header() {
+    return "Problem,Provider,OperationKind,Operation,Disposition,Status,m,n,"
+           "Bytes,Flops,Runtime\n";
+}
+
+/// Parses a JSON report with the given results
+cutlass::profiler::JsonValue json_report(std::string const& results) {
+    std::stringstream ss(
+            "{\"version\": 1, \"operation_kind\": \"gemm\", "
+            "\"environment\": {\"device\": {\"name\": \"A100\"}}, "
+            "\"results\": [" +
+            results + "]}");
+    return cutlass::profiler::parse_json(ss);
+}
+
+std::string json_result(int problem_index, char const* provider,
+                        char const* operation, int m, double runtime) {
+    std::stringstream ss;
+    ss << "{\"problem_index\": " << problem_index << ", \"provider\": \""
+       << provider << "\", \"operation\": \"" << operation
+       << "\", \"arguments\": {\"m\": \"" << m << "\"}, \"runtime\": "
+       << runtime << "}";
+    return ss.str();
+}
+
+}  // namespace profiler
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_shard, parse) {
+    using cutlass::profiler::ShardSpec;
+
+    ShardSpec shard = ShardSpec::parse("2/5");
+    EXPECT_EQ(shard.index, 2);
+    EXPECT_EQ(shard.count, 5);
+    EXPECT_TRUE(shard.enabled());
+
+    EXPECT_FALSE(ShardSpec::parse("0/1").enabled());
+    EXPECT_FALSE(ShardSpec().enabled());
+
+    for (char const* text : {"", "3", "/4", "1/", "5/5", "-1/4", "1/0",
+                             "a/4", "1/4x", "1.5/4"}) {
+        EXPECT_THROW(ShardSpec::parse(text), std::runtime_error) << text;
+    }
+}
+
+TEST(profiler_shard, planned_cost) {
+    // Compute-bound at 100 TFLOP/s, memory-bound at 1 TB/s, plus 1 ms
+    EXPECT_DOUBLE_EQ(cutlass::profiler::planned_cost(int64_t(1e14), 0, 2),
+                     2001.0);
+    EXPECT_DOUBLE_EQ(cutlass::profiler::planned_cost(int64_t(1e9),
+                                                     int64_t(1e10), 3),
+                     31.0);
+    EXPECT_DOUBLE_EQ(cutlass::profiler::planned_cost(0, 0, 0), 1.0);
+}
+
+TEST(profiler_shard, assignment_covers_every_item_once) {
+    std::vector<double> costs = test::profiler::sweep_costs();
+
+    for (int count : {1, 2, 3, 4, 8, 64}) {
+        std::vector<int> shards =
+                cutlass::profiler::assign_shards(costs, count);
+        ASSERT_EQ(shards.size(), costs.size());
+
+        // Each process keeps the items assigned to its own index
+        std::vector<int> owners(costs.size(), 0);
+        for (int index = 0; index < count; ++index) {
+            std::vector<int> local =
+                    cutlass::profiler::assign_shards(costs, count);
+            EXPECT_EQ(local, shards);
+
+            for (size_t item = 0; item < local.size(); ++item) {
+                if (local[item] == index) {
+                    ++owners[item];
+                }
+            }
+        }
+
+        EXPECT_TRUE(std::all_of(owners.begin(), owners.end(),
+                                [](int owner) { return owner == 1; }))
+                << count << " shards";
+    }
+}
+
+TEST(profiler_shard, assignment_balances_cost) {
+    std::vector<double> costs = test::profiler::sweep_costs();
+    int const count = 4;
+
+    std::vector<int> shards = cutlass::profiler::assign_shards(costs, count);
+
+    std::vector<double> loads(count, 0);
+    for (size_t item = 0; item < costs.size(); ++item) {
+        loads[shards[item]] += costs[item];
+    }
+
+    double total = 0;
+    for (double load : loads) {
+        total += load;
+    }
+
+    // Greedy assignment is within the cost of the largest item of the mean
+    double largest = *std::max_element(costs.begin(), costs.end());
+    for (double load : loads) {
+        EXPECT_LE(load, total / count + largest);
+    }
+
+    // Items of equal cost are spread round robin
+    std::vector<int> uniform =
+            cutlass::profiler::assign_shards(std::vector<double>(6, 1.0), 3);
+    EXPECT_EQ(uniform, std::vector<int>({0, 1, 2, 0, 1, 2}));
+}
+
+TEST(profiler_shard, merge_csv_reports) {
+    std::string header = test::profiler::csv_header();
+
+    std::stringstream shard0(
+            header +
+            "0,CUTLASS,gemm,gemm_a,passed,success,128,128,10,20,0.5\n"
+            "0,cuBLAS,gemm,gemm_a,passed,success,128,128,10,20,0.4\n"
+            "2,CUTLASS,gemm,gemm_b,passed,success,512,128,10,20,2.0\n");
+
+    // Retry of shard 1 after its first run failed
+    std::stringstream shard1(
+            header +
+            "1,CUTLASS,gemm,gemm_b,failed,error_internal,256,128,10,20,\n"
+            "0,CUTLASS,gemm,gemm_b,passed,success,128,128,10,20,0.6\n"
+            "0,cuBLAS,gemm,gemm_b,passed,success,128,128,10,20,0.4\n"
+            "1,CUTLASS,gemm,gemm_b,passed,success,256,128,10,20,1.0\n");
+
+    cutlass::profiler::CsvReport merged = cutlass::profiler::merge_csv_reports(
+            {cutlass::profiler::read_csv_report(shard0),
+             cutlass::profiler::read_csv_report(shard1)});
+
+    std::stringstream out;
+    cutlass::profiler::print_csv_report(out, merged);
+
+    EXPECT_EQ(out.str(),
+              header +
+              "0,CUTLASS,gemm,gemm_a,passed,success,128,128,10,20,0.5\n"
+              "0,CUTLASS,gemm,gemm_b,passed,success,128,128,10,20,0.6\n"
+              "0,cuBLAS,gemm,gemm_b,passed,success,128,128,10,20,0.4\n"
+              "1,CUTLASS,gemm,gemm_b,passed,success,256,128,10,20,1.0\n"
+              "2,CUTLASS,gemm,gemm_b,passed,success,512,128,10,20,2.0\n");
+
+    std::stringstream other("Problem,Provider,Operation,Status,Bytes\n");
+    EXPECT_THROW(cutlass::profiler::merge_csv_reports(
+                         {merged, cutlass::profiler::read_csv_report(other)}),
+                 std::runtime_error);
+}
+
+TEST(profiler_shard, merge_json_reports) {
+    using test::profiler::json_result;
+
+    cutlass::profiler::JsonValue merged =
+            cutlass::profiler::merge_json_reports(
+                    {test::profiler::json_report(
+                             json_result(1, "cutlass", "gemm_b", 256, 3.0) +
+                             "," +
+                             json_result(0, "cublas", "gemm_a", 128, 0.4)),
+                     test::profiler::json_report(
+                             json_result(0, "cutlass", "gemm_a", 128, 0.5) +
+                             "," +
+                             json_result(0, "cublas", "gemm_c", 128, 0.3) +
+                             "," +
+                             json_result(1, "cutlass", "gemm_b", 256, 1.0))});
+
+    EXPECT_EQ(merged.find("environment")->find("device")->get_string("name"),
+              "A100");
+
+    std::vector<cutlass::profiler::JsonValue> const& results =
+            merged.find("results")->array;
+    ASSERT_EQ(results.size(), size_t(3));
+
+    EXPECT_EQ(results[0].get_string("operation"), "gemm_a");
+    EXPECT_EQ(results[0].get_string("provider"), "cutlass");
+    EXPECT_EQ(results[1].get_string("provider"), "cublas");
+    EXPECT_EQ(results[1].get_number("runtime"), 0.3);
+    EXPECT_EQ(results[2].get_number("problem_index"), 1);
+    EXPECT_EQ(results[2].get_number("runtime"), 1.0);
+
+    // The merged document reads back unchanged
+    std::stringstream ss;
+    cutlass::profiler::print_json(ss, merged);
+    cutlass::profiler::JsonValue parsed = cutlass::profiler::parse_json(ss);
+    ASSERT_EQ(parsed.find("results")->array.size(), size_t(3));
+    EXPECT_EQ(parsed.find("results")->array[1].get_string("operation"),
+              "gemm_c");
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,221 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for sampled and resumable problem-space sweeps of the
+   CUTLASS Profiler.
+*/
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/util/command_line.h"
+
+#include "problem_space.h"
+#include "sweep.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace profiler {
+
+using namespace cutlass::profiler;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Schema with two integer arguments and one scalar argument
+ArgumentDescriptionVector sweep_schema() {
+    return {{ArgumentTypeID::kInteger, {"m"}, "M dimension"},
+            {ArgumentTypeID::kScalar, {"split_k_mode"}, "Split-K mode"},
+            {ArgumentTypeID::kInteger, {"n"}, "N dimension"}};
+}
+
+cutlass::CommandLine sweep_command_line(std::vector<char const*> args) {
+    args.insert(args.begin(), "cutlass_profiler");
+    return cutlass::CommandLine(int(args.size()), args.data());
+}
+
+/// Returns the number of stratum [i / count, (i + 1) / count) holding each
+/// coordinate along one dimension
+std::set<size_t> strata(std::vector<std::vector<double>> const& points,
+                        size_t dim) {
+    std::set<size_t> result;
+    for (auto const& point : points) {
+        EXPECT_GE(point[dim], 0.0);
+        EXPECT_LT(point[dim], 1.0);
+        result.insert(size_t(point[dim] * double(points.size())));
+    }
+    return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace test
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(profiler_sweep, latin_hypercube_fills_every_stratum) {
+    size_t const count = 37;
+    auto points = cutlass::profiler::latin_hypercube(count, 5, 7);
+
+    ASSERT_EQ(points.size(), count);
+    for (size_t dim = 0; dim < 5; ++dim) {
+        EXPECT_EQ(test::profiler::strata(points, dim).size(), count);
+    }
+
+    // Identical seeds reproduce the sample
+    EXPECT_EQ(points, cutlass::profiler::latin_hypercube(count, 5, 7));
+    EXPECT_NE(points, cutlass::profiler::latin_hypercube(count, 5, 8));
+}
+
+TEST(profiler_sweep, sobol_sequence_is_stratified) {
+    size_t const count = 64;
+    int const dims = cutlass::profiler::kSobolMaxDimensions;
+    auto points = cutlass::profiler::sobol_sequence(count, dims);
+
+    ASSERT_EQ(points.size(), count);
+    EXPECT_EQ(points[1][0], 0.5);
+    EXPECT_EQ(points[2][1], 0.25);
+
+    // Every dimension of a Sobol sequence is a (0, m, 1)-net in base 2
+    for (int dim = 0; dim < dims; ++dim) {
+        EXPECT_EQ(test::profiler::strata(points, dim).size(), count);
+    }
+
+    EXPECT_THROW(cutlass::profiler::sobol_sequence(count, dims + 1),
+                 std::invalid_argument);
+}
+
+TEST(profiler_sweep, problem_space_indexing) {
+    auto schema = test::profiler::sweep_schema();
+    cutlass::profiler::ProblemSpace problem_space(
+            schema, test::profiler::sweep_command_line(
+                            {"--m=16:64:16", "--n=8,24,40"}));
+
+    std::vector<size_t> extents = problem_space.extents();
+    EXPECT_EQ(extents, std::vector<size_t>({4, 1, 3}));
+
+    // Exhaustive sampling matches the order of the problem space iterator
+    auto points = cutlass::profiler::sample_problem_space(
+            extents, cutlass::profiler::SamplingMode::kExhaustive, 0, 0);
+    ASSERT_EQ(points.size(), size_t(12));
+
+    auto problem_it = problem_space.begin();
+    for (auto const& indices : points) {
+        ASSERT_TRUE(problem_it != problem_space.end());
+        EXPECT_EQ(cutlass::profiler::problem_key(problem_space.at(indices)),
+                  cutlass::profiler::problem_key(problem_it.at()));
+        ++problem_it;
+    }
+    EXPECT_TRUE(problem_it == problem_space.end());
+
+    EXPECT_THROW(problem_space.at({4, 0, 0}), std::out_of_range);
+}
+
+TEST(profiler_sweep, sampled_points_are_distinct) {
+    std::vector<size_t> extents = {64, 1, 32, 8};
+
+    for (auto mode : {cutlass::profiler::SamplingMode::kLatinHypercube,
+                      cutlass::profiler::SamplingMode::kSobol}) {
+        auto points =
+                cutlass::profiler::sample_problem_space(extents, mode, 32, 1);
+
+        EXPECT_GT(points.size(), size_t(16));
+        EXPECT_LE(points.size(), size_t(32));
+
+        std::set<std::vector<size_t>> unique(points.begin(), points.end());
+        EXPECT_EQ(unique.size(), points.size());
+
+        std::set<size_t> m_values;
+        for (auto const& point : points) {
+            EXPECT_LT(point[0], extents[0]);
+            EXPECT_EQ(point[1], size_t(0));
+            EXPECT_LT(point[2], extents[2]);
+            EXPECT_LT(point[3], extents[3]);
+            m_values.insert(point[0]);
+        }
+
+        // The largest dimension is covered once per point
+        EXPECT_EQ(m_values.size(), points.size());
+    }
+
+    // Small spaces are swept exhaustively
+    EXPECT_EQ(cutlass::profiler::sample_problem_space(
+                      {2, 3}, cutlass::profiler::SamplingMode::kSobol, 6, 0)
+                      .size(),
+              size_t(6));
+}
+
+TEST(profiler_sweep, checkpoint_resumes_completed_problems) {
+    std::string const path = "profiler_sweep_checkpoint.txt";
+    std::remove(path.c_str());
+
+    {
+        cutlass::profiler::SweepCheckpoint checkpoint(path, "gemm");
+        EXPECT_TRUE(checkpoint.enabled());
+        EXPECT_EQ(checkpoint.resumed(), size_t(0));
+
+        checkpoint.complete("m: 16;n: 8");
+        checkpoint.complete("m: 32;n: 8");
+        checkpoint.complete("m: 32;n: 8");
+    }
+
+    // Simulates a record cut short by an interrupted write
+    {
+        std::ofstream file(path, std::ios_base::app);
+        file << "gemm\tm: 48";
+    }
+
+    {
+        cutlass::profiler::SweepCheckpoint checkpoint(path, "gemm");
+        EXPECT_EQ(checkpoint.resumed(), size_t(2));
+        EXPECT_TRUE(checkpoint.completed("m: 16;n: 8"));
+        EXPECT_FALSE(checkpoint.completed("m: 48"));
+        EXPECT_FALSE(checkpoint.completed("m: 64;n: 8"));
+
+        checkpoint.complete("m: 48;n: 8");
+
+        cutlass::profiler::SweepCheckpoint conv(path, "conv2d");
+        EXPECT_EQ(conv.resumed(), size_t(0));
+    }
+
+    {
+        cutlass::profiler::SweepCheckpoint checkpoint(path, "gemm");
+        EXPECT_EQ(checkpoint.resumed(), size_t(3));
+        EXPECT_TRUE(checkpoint.completed("m: 48;n: 8"));
+    }
+
+    EXPECT_FALSE(cutlass::profiler::SweepCheckpoint("", "gemm").enabled());
+
+    std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
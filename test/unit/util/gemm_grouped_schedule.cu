@@ -0,0 +1,207 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the tile schedule of persistent grouped GEMM kernels
+*/
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/kernel/gemm_grouped_problem_visitor.h"
+#include "cutlass/util/gemm_grouped_schedule.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using ThreadblockShape = cutlass::gemm::GemmShape<128, 64, 8>;
+
+using ProblemVisitor =
+        cutlass::gemm::kernel::GemmGroupedProblemVisitor<ThreadblockShape>;
+
+using TransposedProblemVisitor =
+        cutlass::gemm::kernel::GemmGroupedProblemVisitor<ThreadblockShape,
+                                                         true>;
+
+/// Problems of different shapes, including ones without output tiles
+std::vector<cutlass::gemm::GemmCoord> mixed_problems() {
+    return {{256, 128, 64}, {1, 1, 1},    {0, 64, 32},  {300, 70, 16},
+            {128, 0, 8},    {129, 65, 0}, {64, 512, 24}};
+}
+
+/// Checks that every tile of every problem is computed exactly once
+template <typename Visitor>
+void verify_coverage(std::vector<cutlass::gemm::GemmCoord> const& problems,
+                     int threadblock_count) {
+    auto assignments = cutlass::simulate_gemm_grouped_schedule<Visitor>(
+            problems.data(), int(problems.size()), threadblock_count);
+
+    std::map<std::tuple<int, int, int>, int> visits;
+
+    for (auto const& assignment : assignments) {
+        ++visits[std::make_tuple(assignment.problem_idx,
+                                 assignment.tile_offset.m(),
+                                 assignment.tile_offset.n())];
+    }
+
+    int expected_tiles = 0;
+
+    for (int idx = 0; idx < int(problems.size()); ++idx) {
+        cutlass::gemm::GemmCoord problem = problems[idx];
+
+        if (Visitor::kTransposed) {
+            problem = {problem.n(), problem.m(), problem.k()};
+        }
+
+        cutlass::gemm::GemmCoord grid = Visitor::grid_shape(problem);
+
+        for (int m = 0; m < grid.m(); ++m) {
+            for (int n = 0; n < grid.n(); ++n) {
+                EXPECT_EQ(visits[std::make_tuple(idx, m, n)], 1)
+                        << "problem " << idx << " tile (" << m << ", " << n
+                        << ") with " << threadblock_count << " threadblocks";
+            }
+        }
+
+        expected_tiles += grid.m() * grid.n();
+    }
+
+    EXPECT_EQ(int(assignments.size()), expected_tiles);
+    EXPECT_EQ(Visitor::group_tile_count(problems.data(), int(problems.size())),
+              expected_tiles);
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GemmGroupedSchedule, tile_count) {
+    EXPECT_EQ(ProblemVisitor::tile_count({256, 128, 64}), 2 * 2);
+    EXPECT_EQ(ProblemVisitor::tile_count({300, 70, 16}), 3 * 2);
+    EXPECT_EQ(ProblemVisitor::tile_count({1, 1, 1}), 1);
+    EXPECT_EQ(ProblemVisitor::tile_count({0, 64, 32}), 0);
+    EXPECT_EQ(ProblemVisitor::tile_count({129, 65, 0}), 2 * 2);
+
+    std::vector<cutlass::gemm::GemmCoord> problems = mixed_problems();
+
+    EXPECT_EQ(ProblemVisitor::group_tile_count(problems.data(),
+                                               int(problems.size())),
+              4 + 1 + 0 + 6 + 0 + 4 + 8);
+}
+
+TEST(GemmGroupedSchedule, every_tile_computed_once) {
+    std::vector<cutlass::gemm::GemmCoord> problems = mixed_problems();
+
+    for (int threadblock_count : {1, 2, 5, 7, 23, 64}) {
+        verify_coverage<ProblemVisitor>(problems, threadblock_count);
+    }
+}
+
+TEST(GemmGroupedSchedule, transposed_every_tile_computed_once) {
+    std::vector<cutlass::gemm::GemmCoord> problems = mixed_problems();
+
+    for (int threadblock_count : {1, 3, 16, 40}) {
+        verify_coverage<TransposedProblemVisitor>(problems, threadblock_count);
+    }
+
+    // The transpose of a tall problem is tiled along N
+    cutlass::gemm::GemmCoord tall(512, 64, 8);
+
+    auto assignments =
+            cutlass::simulate_gemm_grouped_schedule<TransposedProblemVisitor>(
+                    &tall, 1, 1);
+
+    ASSERT_EQ(assignments.size(), 1u * 8u);
+    EXPECT_EQ(assignments.back().tile_offset.m(), 0);
+    EXPECT_EQ(assignments.back().tile_offset.n(), 7);
+}
+
+TEST(GemmGroupedSchedule, balanced_across_threadblocks) {
+    std::vector<cutlass::gemm::GemmCoord> problems = mixed_problems();
+
+    int const kThreadblockCount = 5;
+
+    auto assignments = cutlass::simulate_gemm_grouped_schedule<ProblemVisitor>(
+            problems.data(), int(problems.size()), kThreadblockCount);
+
+    std::vector<int> tiles_per_block(kThreadblockCount, 0);
+
+    for (auto const& assignment : assignments) {
+        EXPECT_EQ(assignment.iteration,
+                  tiles_per_block[assignment.threadblock_idx]);
+        ++tiles_per_block[assignment.threadblock_idx];
+    }
+
+    // 23 tiles over 5 threadblocks
+    EXPECT_EQ(tiles_per_block, std::vector<int>({5, 5, 5, 4, 4}));
+}
+
+TEST(GemmGroupedSchedule, tiles_in_problem_order) {
+    std::vector<cutlass::gemm::GemmCoord> problems = mixed_problems();
+
+    auto assignments = cutlass::simulate_gemm_grouped_schedule<ProblemVisitor>(
+            problems.data(), int(problems.size()), 1);
+
+    // A single threadblock visits the problems in order and the tiles of each
+    // problem in row-major order
+    std::vector<std::tuple<int, int, int>> expected = {
+            std::make_tuple(0, 0, 0), std::make_tuple(0, 0, 1),
+            std::make_tuple(0, 1, 0), std::make_tuple(0, 1, 1),
+            std::make_tuple(1, 0, 0), std::make_tuple(3, 0, 0),
+            std::make_tuple(3, 0, 1), std::make_tuple(3, 1, 0),
+            std::make_tuple(3, 1, 1), std::make_tuple(3, 2, 0),
+            std::make_tuple(3, 2, 1)};
+
+    ASSERT_GE(assignments.size(), expected.size());
+
+    for (size_t idx = 0; idx < expected.size(); ++idx) {
+        EXPECT_EQ(std::make_tuple(assignments[idx].problem_idx,
+                                  assignments[idx].tile_offset.m(),
+                                  assignments[idx].tile_offset.n()),
+                  expected[idx]);
+    }
+}
+
+TEST(GemmGroupedSchedule, empty_group) {
+    auto assignments = cutlass::simulate_gemm_grouped_schedule<ProblemVisitor>(
+            nullptr, 0, 8);
+
+    EXPECT_TRUE(assignments.empty());
+
+    cutlass::gemm::GemmCoord empty(0, 0, 16);
+
+    assignments = cutlass::simulate_gemm_grouped_schedule<ProblemVisitor>(
+            &empty, 1, 8);
+
+    EXPECT_TRUE(assignments.empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,363 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Unit tests for the work decomposition of Stream-K GEMM kernels
+*/
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/array.h"
+#include "cutlass/epilogue/thread/linear_combination.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/threadblock/threadblock_swizzle.h"
+#include "cutlass/util/gemm_streamk_schedule.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using Swizzle = cutlass::gemm::threadblock::GemmStreamKThreadblockSwizzle;
+
+cutlass::gemm::GemmCoord const kTileSize(128, 128, 8);
+
+/// Returns the number of iterations computed by each threadblock
+std::vector<int> iters_per_block(
+        std::vector<cutlass::GemmStreamKWorkRange> const& ranges,
+        int block_count) {
+    std::vector<int> iters(block_count, 0);
+
+    for (auto const& range : ranges) {
+        iters[range.threadblock_idx] += range.k_iter_end - range.k_iter_begin;
+    }
+
+    return iters;
+}
+
+/// Checks that every iteration of every tile is computed exactly once and
+/// that the serial reduction of each tile only waits on higher threadblocks
+void verify_schedule(cutlass::gemm::GemmCoord problem_size,
+                     int threadblock_count) {
+    Swizzle swizzle(problem_size, kTileSize, threadblock_count);
+
+    auto ranges = cutlass::simulate_gemm_streamk_schedule(swizzle);
+
+    int tile_count = swizzle.get_tile_count();
+
+    std::vector<std::vector<int>> visits(
+            tile_count, std::vector<int>(swizzle.iters_per_tile, 0));
+
+    // Ranges of each tile, keyed by partition index
+    std::vector<std::map<int, cutlass::GemmStreamKWorkRange>> partitions(
+            tile_count);
+
+    for (auto const& range : ranges) {
+        ASSERT_GE(range.tile_idx, 0);
+        ASSERT_LT(range.tile_idx, tile_count);
+        ASSERT_LT(range.k_iter_begin, range.k_iter_end);
+
+        EXPECT_EQ(range.tile_offset.m(),
+                  range.tile_idx % swizzle.tiled_shape.m());
+        EXPECT_EQ(range.tile_offset.n(),
+                  range.tile_idx / swizzle.tiled_shape.m());
+
+        for (int k = range.k_iter_begin; k < range.k_iter_end; ++k) {
+            ++visits[range.tile_idx][k];
+        }
+
+        EXPECT_TRUE(partitions[range.tile_idx]
+                            .insert(std::make_pair(range.partition_idx, range))
+                            .second)
+                << "tile " << range.tile_idx << " partition "
+                << range.partition_idx << " computed twice";
+    }
+
+    for (int tile_idx = 0; tile_idx < tile_count; ++tile_idx) {
+        for (int k = 0; k < swizzle.iters_per_tile; ++k) {
+            EXPECT_EQ(visits[tile_idx][k], 1)
+                    << "tile " << tile_idx << " iteration " << k << " with "
+                    << threadblock_count << " threadblocks";
+        }
+
+        auto const& tile_partitions = partitions[tile_idx];
+        int partition_count = int(tile_partitions.size());
+
+        ASSERT_GE(partition_count, 1);
+
+        for (auto const& entry : tile_partitions) {
+            int partition_idx = entry.first;
+            cutlass::GemmStreamKWorkRange const& range = entry.second;
+
+            EXPECT_EQ(range.partition_count, partition_count);
+            EXPECT_LT(partition_idx, partition_count);
+
+            // Partitions are reduced from the last K iterations to the first,
+            // so that each threadblock waits only on threadblocks of higher
+            // index
+            if (partition_idx) {
+                cutlass::GemmStreamKWorkRange const& previous =
+                        tile_partitions.at(partition_idx - 1);
+
+                EXPECT_EQ(previous.threadblock_idx, range.threadblock_idx + 1);
+                EXPECT_EQ(previous.k_iter_begin, range.k_iter_end);
+            }
+        }
+
+        EXPECT_EQ(tile_partitions.at(0).k_iter_end, swizzle.iters_per_tile);
+        EXPECT_EQ(tile_partitions.at(partition_count - 1).k_iter_begin, 0);
+    }
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GemmStreamKSchedule, every_iteration_computed_once) {
+    std::vector<cutlass::gemm::GemmCoord> problems = {
+            {1024, 1024, 1024}, {128 * 109, 128, 1024}, {300, 70, 16},
+            {129, 65, 3},       {4096, 256, 24},        {128, 128, 4096}};
+
+    for (auto const& problem : problems) {
+        for (int threadblock_count : {1, 2, 7, 80, 108, 216}) {
+            verify_schedule(problem, threadblock_count);
+        }
+    }
+}
+
+TEST(GemmStreamKSchedule, balanced_across_threadblocks) {
+    for (int threadblock_count : {3, 13, 108, 132}) {
+        Swizzle swizzle({1000, 3000, 500}, kTileSize, threadblock_count);
+
+        auto ranges = cutlass::simulate_gemm_streamk_schedule(swizzle);
+        auto iters = iters_per_block(ranges, swizzle.block_count);
+
+        int total = 0;
+
+        for (int block_idx = 0; block_idx < swizzle.block_count; ++block_idx) {
+            EXPECT_GE(iters[block_idx], swizzle.iters_per_block);
+            EXPECT_LE(iters[block_idx], swizzle.iters_per_block + 1);
+
+            // Threadblocks computing an extra iteration come first
+            EXPECT_EQ(iters[block_idx] > swizzle.iters_per_block,
+                      block_idx < swizzle.extra_iters);
+
+            total += iters[block_idx];
+        }
+
+        EXPECT_EQ(total, swizzle.get_iter_count());
+
+        // The threadblock computing each iteration is the inverse of the
+        // ranges assigned to threadblocks
+        for (int block_idx = 0; block_idx < swizzle.block_count; ++block_idx) {
+            for (int iter = swizzle.get_block_iter_begin(block_idx);
+                 iter < swizzle.get_block_iter_end(block_idx); ++iter) {
+                ASSERT_EQ(swizzle.get_block_idx(iter), block_idx);
+            }
+        }
+    }
+}
+
+TEST(GemmStreamKSchedule, removes_partial_wave) {
+    int const kSmCount = 108;
+
+    // One tile more than the number of SMs leaves the second wave of a
+    // data-parallel launch almost empty
+    cutlass::gemm::GemmCoord problem(128 * (kSmCount + 1), 128, 1024);
+
+    Swizzle swizzle(problem, kTileSize, kSmCount);
+
+    EXPECT_EQ(swizzle.get_tile_count(), kSmCount + 1);
+    EXPECT_EQ(swizzle.iters_per_tile, 128);
+    EXPECT_EQ(swizzle.block_count, kSmCount);
+
+    auto ranges = cutlass::simulate_gemm_streamk_schedule(swizzle);
+    auto iters = iters_per_block(ranges, swizzle.block_count);
+
+    int critical_path = 0;
+
+    for (int block_iters : iters) {
+        critical_path = std::max(critical_path, block_iters);
+    }
+
+    // Iterations are spread evenly, where a data-parallel launch would
+    // compute two full tiles on its critical path
+    EXPECT_EQ(critical_path, (128 * (kSmCount + 1) + kSmCount - 1) / kSmCount);
+    EXPECT_LT(critical_path, 2 * swizzle.iters_per_tile);
+}
+
+TEST(GemmStreamKSchedule, data_parallel_when_tiles_divide_evenly) {
+    cutlass::gemm::GemmCoord problem(128 * 16, 128 * 8, 256);
+
+    auto ranges =
+            cutlass::simulate_gemm_streamk_schedule(problem, kTileSize, 64);
+
+    ASSERT_EQ(ranges.size(), 128u);
+
+    for (auto const& range : ranges) {
+        EXPECT_EQ(range.partition_count, 1);
+        EXPECT_EQ(range.partition_idx, 0);
+        EXPECT_EQ(range.k_iter_begin, 0);
+        EXPECT_EQ(range.k_iter_end, 32);
+        EXPECT_EQ(range.tile_idx / 2, range.threadblock_idx);
+    }
+}
+
+TEST(GemmStreamKSchedule, tile_shared_by_many_threadblocks) {
+    // A single tile divided among more threadblocks than it has iterations
+    Swizzle swizzle({128, 128, 40}, kTileSize, 16);
+
+    EXPECT_EQ(swizzle.iters_per_tile, 5);
+    EXPECT_EQ(swizzle.block_count, 5);
+
+    auto ranges = cutlass::simulate_gemm_streamk_schedule(swizzle);
+
+    ASSERT_EQ(ranges.size(), 5u);
+
+    for (int idx = 0; idx < 5; ++idx) {
+        EXPECT_EQ(ranges[idx].threadblock_idx, idx);
+        EXPECT_EQ(ranges[idx].k_iter_begin, idx);
+        EXPECT_EQ(ranges[idx].k_iter_end, idx + 1);
+        EXPECT_EQ(ranges[idx].partition_idx, 4 - idx);
+        EXPECT_EQ(ranges[idx].partition_count, 5);
+    }
+
+    verify_schedule({128, 128, 40}, 16);
+}
+
+TEST(GemmStreamKSchedule, degenerate_problems) {
+    // Tiles without K iterations still apply the epilogue once
+    Swizzle no_k({256, 256, 0}, kTileSize, 3);
+
+    EXPECT_EQ(no_k.iters_per_tile, 1);
+    EXPECT_EQ(no_k.block_count, 3);
+    EXPECT_EQ(cutlass::simulate_gemm_streamk_schedule(no_k).size(), 4u);
+
+    verify_schedule({256, 256, 0}, 3);
+
+    // Problems without output tiles launch nothing
+    Swizzle empty({0, 256, 64}, kTileSize, 108);
+
+    EXPECT_EQ(empty.block_count, 0);
+    EXPECT_EQ(empty.get_grid_shape().x, 0u);
+    EXPECT_TRUE(cutlass::simulate_gemm_streamk_schedule(empty).empty());
+
+    // At least one threadblock is launched
+    Swizzle single({256, 256, 64}, kTileSize, 0);
+
+    EXPECT_EQ(single.block_count, 1);
+    EXPECT_EQ(single.get_block_iter_end(0), single.get_iter_count());
+}
+
+TEST(GemmStreamKSchedule, serial_reduction_matches_gemm) {
+    using OutputOp =
+            cutlass::epilogue::thread::LinearCombination<float, 1, float,
+                                                         float>;
+
+    float const kAlpha = 2;
+    float const kBeta = -0.5f;
+    float const kSource = 3;
+
+    // Each K iteration of a tile contributes a distinct value
+    cutlass::gemm::GemmCoord problem(384, 256, 80);
+
+    for (int threadblock_count : {1, 4, 5, 7, 50}) {
+        Swizzle swizzle(problem, kTileSize, threadblock_count);
+
+        auto ranges = cutlass::simulate_gemm_streamk_schedule(swizzle);
+
+        // Applies the partitions of each tile in the order of the serial
+        // reduction, as the kernel's epilogue does
+        std::vector<float> output(swizzle.get_tile_count(), 0);
+        std::vector<int> semaphore(swizzle.get_tile_count(), 0);
+
+        bool progress = true;
+        std::vector<bool> done(ranges.size(), false);
+
+        while (progress) {
+            progress = false;
+
+            for (size_t idx = 0; idx < ranges.size(); ++idx) {
+                auto const& range = ranges[idx];
+
+                if (done[idx] ||
+                    semaphore[range.tile_idx] != range.partition_idx) {
+                    continue;
+                }
+
+                cutlass::Array<float, 1> accumulator;
+                accumulator[0] = 0;
+
+                for (int k = range.k_iter_begin; k < range.k_iter_end; ++k) {
+                    accumulator[0] += float(k + 1);
+                }
+
+                OutputOp output_op(typename OutputOp::Params(kAlpha, kBeta));
+
+                if (range.partition_count > 1) {
+                    output_op.set_k_partition(range.partition_idx,
+                                              range.partition_count);
+                }
+
+                cutlass::Array<float, 1> source;
+                source[0] = range.partition_idx ? output[range.tile_idx]
+                                                : kSource;
+
+                output[range.tile_idx] = output_op(accumulator, source)[0];
+
+                semaphore[range.tile_idx] =
+                        (range.partition_idx + 1 == range.partition_count)
+                                ? 0
+                                : range.partition_idx + 1;
+
+                done[idx] = true;
+                progress = true;
+            }
+        }
+
+        for (size_t idx = 0; idx < ranges.size(); ++idx) {
+            EXPECT_TRUE(done[idx]) << "range " << idx << " never released";
+        }
+
+        // Sum of 1..iters_per_tile
+        float expected_sum = float(swizzle.iters_per_tile *
+                                   (swizzle.iters_per_tile + 1) / 2);
+
+        for (int tile_idx = 0; tile_idx < swizzle.get_tile_count();
+             ++tile_idx) {
+            EXPECT_EQ(output[tile_idx], kAlpha * expected_sum + kBeta * kSource)
+                    << "tile " << tile_idx << " with " << threadblock_count
+                    << " threadblocks";
+            EXPECT_EQ(semaphore[tile_idx], 0);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,244 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief CUDA Runtime stub used to measure the host overhead of the CUTLASS
+           Library without a GPU.
+
+    Definitions in this file interpose over the shared CUDA Runtime. Kernel
+    launch configurations are pushed and popped here as well, so launches
+    through the triple-chevron syntax reach the stubbed cudaLaunchKernel. The
+    registration of device code is left to the CUDA Runtime, which defers it
+    until a device is first used.
+*/
+
+#include <cstring>
+
+#include <cuda_runtime_api.h>
+
+#include "cuda_runtime_stub.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+namespace benchmark {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Counts of stubbed calls. The benchmark is single-threaded.
+uint64_t call_counts[int(RuntimeCall::kInvalid)] = {};
+
+int compute_capability = 80;
+
+void count(RuntimeCall call) { ++call_counts[int(call)]; }
+
+/// Launch configuration pushed by the triple-chevron syntax
+struct CallConfiguration {
+    dim3 grid;
+    dim3 block;
+    size_t shared_memory;
+    cudaStream_t stream;
+};
+
+thread_local CallConfiguration call_configuration;
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint64_t runtime_call_count(RuntimeCall call) {
+    return call_counts[int(call)];
+}
+
+uint64_t runtime_call_count() {
+    uint64_t total = 0;
+    for (uint64_t calls : call_counts) {
+        total += calls;
+    }
+    return total;
+}
+
+void set_stub_compute_capability(int cc) { compute_capability = cc; }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace benchmark
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+using cutlass::library::benchmark::RuntimeCall;
+using cutlass::library::benchmark::call_configuration;
+using cutlass::library::benchmark::compute_capability;
+using cutlass::library::benchmark::count;
+
+extern "C" {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Launch configuration (declared by crt/host_runtime.h)
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+unsigned __cudaPushCallConfiguration(dim3 grid, dim3 block,
+                                     size_t shared_memory,
+                                     struct CUstream_st* stream) {
+    call_configuration.grid = grid;
+    call_configuration.block = block;
+    call_configuration.shared_memory = shared_memory;
+    call_configuration.stream = stream;
+    return 0;
+}
+
+cudaError_t __cudaPopCallConfiguration(dim3* grid, dim3* block,
+                                       size_t* shared_memory, void* stream) {
+    *grid = call_configuration.grid;
+    *block = call_configuration.block;
+    *shared_memory = call_configuration.shared_memory;
+    *static_cast<cudaStream_t*>(stream) = call_configuration.stream;
+    return cudaSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// CUDA Runtime API
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cudaError_t CUDARTAPI cudaLaunchKernel(void const*, dim3, dim3, void**, size_t,
+                                       cudaStream_t) {
+    count(RuntimeCall::kLaunchKernel);
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaFuncSetAttribute(void const*,
+                                           enum cudaFuncAttribute, int) {
+    count(RuntimeCall::kFuncSetAttribute);
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaMemsetAsync(void*, int, size_t, cudaStream_t) {
+    count(RuntimeCall::kMemset);
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaGetLastError(void) {
+    count(RuntimeCall::kError);
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaPeekAtLastError(void) {
+    count(RuntimeCall::kError);
+    return cudaSuccess;
+}
+
+char const* CUDARTAPI cudaGetErrorString(cudaError_t error) {
+    return error == cudaSuccess ? "no error" : "stubbed CUDA Runtime error";
+}
+
+cudaError_t CUDARTAPI cudaGetDevice(int* device) {
+    count(RuntimeCall::kQuery);
+    *device = 0;
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaGetDeviceCount(int* device_count) {
+    count(RuntimeCall::kQuery);
+    *device_count = 1;
+    return cudaSuccess;
+}
+
+/// Describes an A100-like device with the configured compute capability
+cudaError_t CUDARTAPI cudaGetDeviceProperties(struct cudaDeviceProp* prop,
+                                              int) {
+    count(RuntimeCall::kQuery);
+    std::memset(prop, 0, sizeof(*prop));
+    std::strcpy(prop->name, "CUDA Runtime stub");
+    prop->major = compute_capability / 10;
+    prop->minor = compute_capability % 10;
+    prop->multiProcessorCount = 108;
+    prop->warpSize = 32;
+    prop->maxThreadsPerBlock = 1024;
+    prop->maxThreadsPerMultiProcessor = 2048;
+    prop->regsPerMultiprocessor = 65536;
+    prop->sharedMemPerBlock = 48 << 10;
+    prop->sharedMemPerBlockOptin = 163 << 10;
+    prop->sharedMemPerMultiprocessor = 164 << 10;
+    prop->totalGlobalMem = size_t(40) << 30;
+    prop->l2CacheSize = 40 << 20;
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaDeviceGetAttribute(int* value,
+                                             enum cudaDeviceAttr attr, int) {
+    count(RuntimeCall::kQuery);
+    switch (attr) {
+        case cudaDevAttrComputeCapabilityMajor:
+            *value = compute_capability / 10;
+            break;
+        case cudaDevAttrComputeCapabilityMinor:
+            *value = compute_capability % 10;
+            break;
+        case cudaDevAttrMultiProcessorCount:
+            *value = 108;
+            break;
+        case cudaDevAttrMaxSharedMemoryPerBlockOptin:
+            *value = 163 << 10;
+            break;
+        default:
+            *value = 0;
+            break;
+    }
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+        int* blocks, void const*, int, size_t) {
+    count(RuntimeCall::kQuery);
+    *blocks = 1;
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaFuncGetAttributes(struct cudaFuncAttributes* attr,
+                                            void const*) {
+    count(RuntimeCall::kQuery);
+    std::memset(attr, 0, sizeof(*attr));
+    attr->maxThreadsPerBlock = 1024;
+    return cudaSuccess;
+}
+
+cudaError_t CUDARTAPI cudaStreamSynchronize(cudaStream_t) {
+    return cudaSuccess;
+}
+
+}  // extern "C"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
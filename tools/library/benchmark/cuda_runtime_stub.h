@@ -0,0 +1,76 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief CUDA Runtime stub used to measure the host overhead of the CUTLASS
+           Library without a GPU.
+
+    The functions of the CUDA Runtime called by the host path of library
+    operations (kernel launches, attributes, queries and errors) are defined
+    by cuda_runtime_stub.cpp, which must be linked into the executable ahead
+    of the shared CUDA Runtime. Stubbed calls succeed without side effects and
+    are counted.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+namespace benchmark {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Groups of stubbed runtime calls
+enum class RuntimeCall {
+    kLaunchKernel,      ///< cudaLaunchKernel
+    kFuncSetAttribute,  ///< cudaFuncSetAttribute
+    kMemset,            ///< cudaMemsetAsync
+    kQuery,             ///< device, occupancy and function attribute queries
+    kError,             ///< cudaGetLastError, cudaPeekAtLastError
+    kInvalid
+};
+
+/// Number of calls of one group since the start of the process
+uint64_t runtime_call_count(RuntimeCall call);
+
+/// Number of calls of all groups since the start of the process
+uint64_t runtime_call_count();
+
+/// Sets the compute capability of the emulated device (default: 80)
+void set_stub_compute_capability(int compute_capability);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace benchmark
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
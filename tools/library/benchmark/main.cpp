@@ -0,0 +1,693 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Measures the host overhead of the operations of the CUTLASS Library.
+
+    Each phase of the Operation interface (can_implement, workspace queries,
+    initialize and run) is timed for representative problems of every kind of
+    operation. The CUDA Runtime is stubbed by cuda_runtime_stub.cpp, so no GPU
+    is needed and run() measures argument marshalling, update() and the
+    runtime calls issued per launch rather than kernel execution.
+
+    With --startup, it instead measures the time and resident memory spent
+    constructing the library and its operations.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "cutlass/util/command_line.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/singleton.h"
+#include "cutlass/library/util.h"
+
+#include "cuda_runtime_stub.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace cutlass::library;
+using cutlass::library::benchmark::RuntimeCall;
+using cutlass::library::benchmark::runtime_call_count;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void print_usage(std::ostream& out) {
+    out << "cutlass_library_benchmark [options]\n\n"
+        << "  Measures the host overhead of the operations of the CUTLASS "
+           "Library with a stubbed\n"
+        << "  CUDA Runtime. Reports nanoseconds per call of each phase of the "
+           "Operation interface.\n\n"
+        << "  --kernels=<names>        Comma-separated substrings of the "
+           "operations to measure\n"
+        << "  --operations=<int>       Operations measured per kind "
+           "(default: 4, 0 for all)\n"
+        << "  --cc=<int>               Compute capability of the emulated "
+           "device (default: 80)\n"
+        << "  --samples=<int>          Samples per phase (default: 100)\n"
+        << "  --batch=<int>            Calls per sample (default: 100)\n"
+        << "  --output=<file>          Writes the statistics of every "
+           "operation as CSV\n"
+        << "  --startup                Measures the time and resident memory "
+           "of library\n"
+        << "                           initialization instead. Compare runs "
+           "with and without\n"
+        << "                           CUTLASS_LIBRARY_LAZY_INIT=0.\n\n"
+        << "Example:\n"
+        << "  $ cutlass_library_benchmark --kernels=conv --operations=0 "
+           "--output=overhead.csv\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Representative problems of every kind of operation. Tensor pointers are
+/// distinct, aligned and never dereferenced; scalars point to zero.
+struct BenchmarkProblem {
+    GemmConfiguration gemm_configuration;
+    GemmArguments gemm_arguments;
+
+    GemmUniversalConfiguration gemm_universal_configuration;
+    GemmUniversalArguments gemm_universal_arguments;
+
+    GemmPlanarComplexConfiguration gemm_planar_complex_configuration;
+    GemmPlanarComplexArguments gemm_planar_complex_arguments;
+
+    Conv2dConfiguration conv2d_configuration;
+    Conv3dConfiguration conv3d_configuration;
+    ConvArguments conv_arguments;
+
+    ConvolutionConfiguration convolution_configuration;
+    ConvolutionArguments convolution_arguments;
+
+    /// Storage for alpha, beta and gamma, large enough for any scalar type
+    uint64_t scalars[3][2];
+
+    BenchmarkProblem();
+
+    /// Returns the configuration of an operation, or null if its kind is not
+    /// measured
+    void const* configuration(OperationDescription const& desc) const;
+
+    /// Returns the arguments matching configuration()
+    void const* arguments(OperationDescription const& desc) const;
+};
+
+/// Returns a distinct device address aligned to 256 bytes
+static void* fake_pointer(int index) {
+    return reinterpret_cast<void*>(uintptr_t(index + 1) << 32);
+}
+
+BenchmarkProblem::BenchmarkProblem() {
+    std::fill(&scalars[0][0], &scalars[0][0] + 6, uint64_t(0));
+
+    int const m = 256, n = 256, k = 256;
+    cutlass::gemm::GemmCoord problem_size(m, n, k);
+
+    // packed matrices; leading dimensions suit either layout of a square
+    // problem
+    gemm_configuration = {problem_size, m, k, m, m, 1};
+
+    gemm_arguments = {fake_pointer(0), fake_pointer(1), fake_pointer(2),
+                      fake_pointer(3), scalars[0],      scalars[1],
+                      ScalarPointerMode::kHost};
+
+    gemm_universal_configuration = {cutlass::gemm::GemmUniversalMode::kGemm,
+                                    problem_size,
+                                    1,
+                                    m,
+                                    k,
+                                    m,
+                                    m};
+
+    gemm_universal_arguments = {fake_pointer(0),
+                                fake_pointer(1),
+                                fake_pointer(2),
+                                fake_pointer(3),
+                                scalars[0],
+                                scalars[1],
+                                ScalarPointerMode::kHost,
+                                int64_t(m) * k,
+                                int64_t(k) * n,
+                                int64_t(m) * n,
+                                int64_t(m) * n};
+
+    gemm_planar_complex_configuration = {
+            cutlass::gemm::GemmUniversalMode::kGemm,
+            problem_size,
+            1,
+            m,
+            m,
+            k,
+            k,
+            m,
+            m,
+            m,
+            m};
+
+    gemm_planar_complex_arguments = {fake_pointer(0),
+                                     fake_pointer(1),
+                                     fake_pointer(2),
+                                     fake_pointer(3),
+                                     fake_pointer(4),
+                                     fake_pointer(5),
+                                     fake_pointer(6),
+                                     fake_pointer(7),
+                                     scalars[0],
+                                     scalars[1],
+                                     ScalarPointerMode::kHost,
+                                     int64_t(m) * k,
+                                     int64_t(m) * k,
+                                     int64_t(k) * n,
+                                     int64_t(k) * n,
+                                     int64_t(m) * n,
+                                     int64_t(m) * n,
+                                     int64_t(m) * n,
+                                     int64_t(m) * n};
+
+    cutlass::conv::Conv2dProblemSize conv2d(
+            8, 28, 28, 64, 64, 3, 3, 28, 28, 1, 1, 1, 1, 1, 1,
+            cutlass::conv::Mode::kCrossCorrelation, 1);
+
+    conv2d_configuration.split_k_mode = cutlass::conv::SplitKMode::kSerial;
+    conv2d_configuration.problem_size = conv2d;
+    conv2d_configuration.layout_activations =
+            cutlass::layout::TensorNHWC::packed(
+                    {conv2d.N, conv2d.H, conv2d.W, conv2d.C});
+    conv2d_configuration.layout_filters = cutlass::layout::TensorNHWC::packed(
+            {conv2d.K, conv2d.R, conv2d.S, conv2d.C});
+    conv2d_configuration.layout_output = cutlass::layout::TensorNHWC::packed(
+            {conv2d.N, conv2d.P, conv2d.Q, conv2d.K});
+    conv2d_configuration.layout_source = conv2d_configuration.layout_output;
+
+    cutlass::conv::Conv3dProblemSize conv3d(
+            2, 8, 16, 16, 64, 64, 3, 3, 3, 8, 16, 16, 1, 1, 1, 1, 1, 1, 1, 1,
+            1, cutlass::conv::Mode::kCrossCorrelation, 1);
+
+    conv3d_configuration.split_k_mode = cutlass::conv::SplitKMode::kSerial;
+    conv3d_configuration.problem_size = conv3d;
+    conv3d_configuration.layout_activations =
+            cutlass::layout::TensorNDHWC::packed(
+                    {conv3d.N, conv3d.D, conv3d.H, conv3d.W, conv3d.C});
+    conv3d_configuration.layout_filters =
+            cutlass::layout::TensorNDHWC::packed(
+                    {conv3d.K, conv3d.T, conv3d.R, conv3d.S, conv3d.C});
+    conv3d_configuration.layout_output = cutlass::layout::TensorNDHWC::packed(
+            {conv3d.N, conv3d.Z, conv3d.P, conv3d.Q, conv3d.K});
+    conv3d_configuration.layout_source = conv3d_configuration.layout_output;
+
+    conv_arguments = {fake_pointer(0), fake_pointer(1), fake_pointer(2),
+                      fake_pointer(3), scalars[0],      scalars[1],
+                      ScalarPointerMode::kHost};
+
+    convolution_configuration.problem_size = conv2d;
+
+    convolution_arguments = {fake_pointer(0), fake_pointer(1),
+                             fake_pointer(2), fake_pointer(3),
+                             fake_pointer(4), scalars[0],
+                             scalars[1],      scalars[2],
+                             ScalarPointerMode::kHost};
+}
+
+void const* BenchmarkProblem::configuration(
+        OperationDescription const& desc) const {
+    switch (desc.kind) {
+        case OperationKind::kGemm:
+            switch (static_cast<GemmDescription const&>(desc).gemm_kind) {
+                case GemmKind::kGemm:
+                    return &gemm_configuration;
+                case GemmKind::kUniversal:
+                    return &gemm_universal_configuration;
+                case GemmKind::kPlanarComplex:
+                    return &gemm_planar_complex_configuration;
+                default:
+                    return nullptr;
+            }
+        case OperationKind::kConv2d:
+            return &conv2d_configuration;
+        case OperationKind::kConv3d:
+            return &conv3d_configuration;
+        case OperationKind::kConvolution:
+            return &convolution_configuration;
+        default:
+            return nullptr;
+    }
+}
+
+void const* BenchmarkProblem::arguments(
+        OperationDescription const& desc) const {
+    switch (desc.kind) {
+        case OperationKind::kGemm:
+            switch (static_cast<GemmDescription const&>(desc).gemm_kind) {
+                case GemmKind::kGemm:
+                    return &gemm_arguments;
+                case GemmKind::kUniversal:
+                    return &gemm_universal_arguments;
+                case GemmKind::kPlanarComplex:
+                    return &gemm_planar_complex_arguments;
+                default:
+                    return nullptr;
+            }
+        case OperationKind::kConv2d:
+        case OperationKind::kConv3d:
+            return &conv_arguments;
+        case OperationKind::kConvolution:
+            return &convolution_arguments;
+        default:
+            return nullptr;
+    }
+}
+
+/// Name of the kind of an operation, distinguishing kinds of GEMM
+static std::string benchmark_kind(OperationDescription const& desc) {
+    if (desc.kind == OperationKind::kGemm) {
+        GemmKind gemm_kind = static_cast<GemmDescription const&>(desc).gemm_kind;
+        if (gemm_kind != GemmKind::kGemm) {
+            return std::string("gemm_") + to_string(gemm_kind);
+        }
+    }
+    return to_string(desc.kind);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Nanoseconds per call of one phase of one operation
+struct PhaseStatistics {
+    std::string kind;
+    std::string operation;
+    std::string phase;
+
+    double min_ns;
+    double mean_ns;
+    double median_ns;
+    double p90_ns;
+    double p99_ns;
+
+    /// Stubbed runtime calls per call of the phase
+    double runtime_calls;
+    double launches;
+    double func_set_attribute_calls;
+};
+
+/// Returns the given percentile of sorted samples by linear interpolation
+static double percentile(std::vector<double> const& sorted, double p) {
+    double position = p * double(sorted.size() - 1);
+    size_t lower = size_t(position);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    double weight = position - double(lower);
+    return sorted[lower] * (1 - weight) + sorted[upper] * weight;
+}
+
+/// Times a phase. Each sample is the mean of `batch` consecutive calls,
+/// preceded by one untimed call.
+static PhaseStatistics measure(std::string const& kind,
+                               std::string const& operation,
+                               std::string const& phase, int samples,
+                               int batch,
+                               std::function<void()> const& call) {
+    using clock = std::chrono::steady_clock;
+
+    call();
+
+    uint64_t runtime_calls = runtime_call_count();
+    uint64_t launches = runtime_call_count(RuntimeCall::kLaunchKernel);
+    uint64_t func_set_attribute_calls =
+            runtime_call_count(RuntimeCall::kFuncSetAttribute);
+
+    std::vector<double> ns_per_call;
+    ns_per_call.reserve(samples);
+
+    for (int sample = 0; sample < samples; ++sample) {
+        clock::time_point start = clock::now();
+        for (int i = 0; i < batch; ++i) {
+            call();
+        }
+        clock::time_point stop = clock::now();
+        ns_per_call.push_back(
+                std::chrono::duration<double, std::nano>(stop - start)
+                        .count() /
+                batch);
+    }
+
+    double calls = double(samples) * batch;
+
+    std::sort(ns_per_call.begin(), ns_per_call.end());
+
+    PhaseStatistics stats;
+    stats.kind = kind;
+    stats.operation = operation;
+    stats.phase = phase;
+    stats.min_ns = ns_per_call.front();
+    stats.mean_ns = 0;
+    for (double ns : ns_per_call) {
+        stats.mean_ns += ns / samples;
+    }
+    stats.median_ns = percentile(ns_per_call, 0.5);
+    stats.p90_ns = percentile(ns_per_call, 0.9);
+    stats.p99_ns = percentile(ns_per_call, 0.99);
+    stats.runtime_calls = (runtime_call_count() - runtime_calls) / calls;
+    stats.launches =
+            (runtime_call_count(RuntimeCall::kLaunchKernel) - launches) /
+            calls;
+    stats.func_set_attribute_calls =
+            (runtime_call_count(RuntimeCall::kFuncSetAttribute) -
+             func_set_attribute_calls) /
+            calls;
+    return stats;
+}
+
+/// Times every phase of an operation able to implement the problem
+static void measure_operation(Operation const* operation,
+                              BenchmarkProblem const& problem, int samples,
+                              int batch,
+                              std::vector<PhaseStatistics>& results) {
+    OperationDescription const& desc = operation->description();
+    std::string kind = benchmark_kind(desc);
+
+    void const* configuration = problem.configuration(desc);
+    void const* arguments = problem.arguments(desc);
+
+    std::vector<uint8_t> host_workspace(
+            operation->get_host_workspace_size(configuration));
+    uint64_t device_workspace_size =
+            operation->get_device_workspace_size(configuration);
+    void* device_workspace =
+            device_workspace_size ? fake_pointer(16) : nullptr;
+
+    results.push_back(measure(kind, desc.name, "can_implement", samples,
+                              batch, [&]() {
+                                  operation->can_implement(configuration,
+                                                           arguments);
+                              }));
+
+    results.push_back(measure(kind, desc.name, "get_host_workspace_size",
+                              samples, batch, [&]() {
+                                  operation->get_host_workspace_size(
+                                          configuration);
+                              }));
+
+    results.push_back(measure(kind, desc.name, "get_device_workspace_size",
+                              samples, batch, [&]() {
+                                  operation->get_device_workspace_size(
+                                          configuration);
+                              }));
+
+    results.push_back(measure(kind, desc.name, "initialize", samples, batch,
+                              [&]() {
+                                  operation->initialize(
+                                          configuration,
+                                          host_workspace.data(),
+                                          device_workspace);
+                              }));
+
+    // run() marshals the arguments, calls update() and launches the kernel
+    results.push_back(measure(kind, desc.name, "run", samples, batch, [&]() {
+        operation->run(arguments, host_workspace.data(), device_workspace);
+    }));
+}
+
+/// Returns true if the name contains one of the filters, or no filter is
+/// given
+static bool name_matches(std::string const& name,
+                         std::vector<std::string> const& filters) {
+    if (filters.empty()) {
+        return true;
+    }
+    for (std::string const& filter : filters) {
+        if (name.find(filter) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void write_csv(std::ostream& out,
+                      std::vector<PhaseStatistics> const& results) {
+    out << "Kind,Operation,Phase,MinNs,MeanNs,MedianNs,P90Ns,P99Ns,"
+           "RuntimeCalls,Launches,FuncSetAttributeCalls\n";
+    for (PhaseStatistics const& stats : results) {
+        out << stats.kind << "," << stats.operation << "," << stats.phase
+            << "," << stats.min_ns << "," << stats.mean_ns << ","
+            << stats.median_ns << "," << stats.p90_ns << "," << stats.p99_ns
+            << "," << stats.runtime_calls << "," << stats.launches << ","
+            << stats.func_set_attribute_calls << "\n";
+    }
+}
+
+/// Prints, for each kind and phase, the median over operations of the
+/// median and 99th percentile nanoseconds per call
+static void print_summary(std::ostream& out,
+                          std::vector<PhaseStatistics> const& results) {
+    struct Summary {
+        std::vector<double> median_ns;
+        std::vector<double> p99_ns;
+        double runtime_calls = 0;
+        double func_set_attribute_calls = 0;
+    };
+
+    std::vector<std::pair<std::string, std::string>> order;
+    std::map<std::pair<std::string, std::string>, Summary> summaries;
+
+    for (PhaseStatistics const& stats : results) {
+        auto key = std::make_pair(stats.kind, stats.phase);
+        if (!summaries.count(key)) {
+            order.push_back(key);
+        }
+        Summary& summary = summaries[key];
+        summary.median_ns.push_back(stats.median_ns);
+        summary.p99_ns.push_back(stats.p99_ns);
+        summary.runtime_calls =
+                std::max(summary.runtime_calls, stats.runtime_calls);
+        summary.func_set_attribute_calls =
+                std::max(summary.func_set_attribute_calls,
+                         stats.func_set_attribute_calls);
+    }
+
+    out << std::left << std::setw(26) << "Kind" << std::setw(28) << "Phase"
+        << std::right << std::setw(6) << "Ops" << std::setw(14)
+        << "Median ns" << std::setw(14) << "P99 ns" << std::setw(14)
+        << "Runtime calls" << std::setw(14) << "SetAttribute"
+        << "\n";
+
+    out << std::fixed << std::setprecision(1);
+
+    for (auto const& key : order) {
+        Summary& summary = summaries[key];
+        std::sort(summary.median_ns.begin(), summary.median_ns.end());
+        std::sort(summary.p99_ns.begin(), summary.p99_ns.end());
+
+        out << std::left << std::setw(26) << key.first << std::setw(28)
+            << key.second << std::right << std::setw(6)
+            << summary.median_ns.size() << std::setw(14)
+            << percentile(summary.median_ns, 0.5) << std::setw(14)
+            << percentile(summary.p99_ns, 0.5) << std::setw(14)
+            << summary.runtime_calls << std::setw(14)
+            << summary.func_set_attribute_calls << "\n";
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the resident set size of the process in bytes
+static size_t resident_set_bytes() {
+    std::ifstream statm("/proc/self/statm");
+
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    statm >> total_pages >> resident_pages;
+
+    return resident_pages * size_t(sysconf(_SC_PAGESIZE));
+}
+
+/// Milliseconds elapsed since a time point
+static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+}
+
+/// Measures the cost of constructing the library singleton, of the first
+/// GEMM query and of constructing every remaining operation
+static void measure_startup(std::ostream& out) {
+    char const* lazy = std::getenv("CUTLASS_LIBRARY_LAZY_INIT");
+    double const kMiB = double(1 << 20);
+
+    size_t rss_begin = resident_set_bytes();
+    auto start = std::chrono::steady_clock::now();
+
+    Singleton const& singleton = Singleton::get();
+
+    double initialize_ms = elapsed_ms(start);
+    size_t rss_initialized = resident_set_bytes();
+    size_t initialized_operations = singleton.manifest.operations().size();
+
+    // First query of an arbitrary functional key
+    double query_ms = 0;
+    if (!singleton.operation_table.gemm_operations.empty()) {
+        GemmFunctionalKey key =
+                singleton.operation_table.gemm_operations.begin()->first;
+
+        start = std::chrono::steady_clock::now();
+        singleton.operation_table.find_gemm_candidates(key);
+        query_ms = elapsed_ms(start);
+    }
+
+    size_t queried_operations = singleton.manifest.operations().size();
+
+    start = std::chrono::steady_clock::now();
+    singleton.operation_table.initialize_all();
+
+    double all_ms = elapsed_ms(start);
+    size_t rss_all = resident_set_bytes();
+
+    out << std::fixed << std::setprecision(2) << "Lazy initialization: "
+        << ((lazy && !std::strcmp(lazy, "0")) ? "disabled" : "enabled")
+        << "\n"
+        << "  Manifest entries:        " << singleton.manifest.entries().size()
+        << "\n"
+        << "  Singleton::get():        " << initialize_ms << " ms, "
+        << double(rss_initialized - rss_begin) / kMiB << " MiB, "
+        << initialized_operations << " operations\n"
+        << "  First GEMM query:        " << query_ms << " ms, "
+        << (queried_operations - initialized_operations)
+        << " operations constructed\n"
+        << "  All operations:          " << all_ms << " ms, "
+        << double(rss_all - rss_begin) / kMiB << " MiB total, "
+        << singleton.manifest.operations().size() << " operations\n";
+}
+
+int main(int argc, char const* arg[]) {
+    cutlass::CommandLine cmdline(argc, arg);
+
+    if (cmdline.check_cmd_line_flag("help")) {
+        print_usage(std::cout);
+        return 0;
+    }
+
+    std::vector<std::string> kernels;
+    cmdline.get_cmd_line_arguments("kernels", kernels);
+
+    int operations_per_kind, compute_capability, samples, batch;
+    cmdline.get_cmd_line_argument("operations", operations_per_kind, 4);
+    cmdline.get_cmd_line_argument("cc", compute_capability, 80);
+    cmdline.get_cmd_line_argument("samples", samples, 100);
+    cmdline.get_cmd_line_argument("batch", batch, 100);
+
+    std::string output_path;
+    cmdline.get_cmd_line_argument("output", output_path);
+
+    if (samples < 1 || batch < 1) {
+        std::cerr << "--samples and --batch must be positive\n";
+        return 1;
+    }
+
+    cutlass::library::benchmark::set_stub_compute_capability(
+            compute_capability);
+
+    if (cmdline.check_cmd_line_flag("startup")) {
+        measure_startup(std::cout);
+        return 0;
+    }
+
+    Singleton const& singleton = Singleton::get();
+    singleton.operation_table.initialize_all();
+
+    // measure operations in name order so runs are comparable
+    std::vector<Operation const*> operations;
+    for (auto const& operation : singleton.manifest) {
+        operations.push_back(operation.get());
+    }
+    std::sort(operations.begin(), operations.end(),
+              [](Operation const* lhs, Operation const* rhs) {
+                  return std::string(lhs->description().name) <
+                         std::string(rhs->description().name);
+              });
+
+    BenchmarkProblem problem;
+    std::map<std::string, int> measured;
+    std::vector<PhaseStatistics> results;
+
+    for (Operation const* operation : operations) {
+        OperationDescription const& desc = operation->description();
+
+        if (!problem.configuration(desc) ||
+            !name_matches(desc.name, kernels) ||
+            compute_capability <
+                    desc.tile_description.minimum_compute_capability ||
+            compute_capability >
+                    desc.tile_description.maximum_compute_capability) {
+            continue;
+        }
+
+        int& count = measured[benchmark_kind(desc)];
+        if (operations_per_kind > 0 && count >= operations_per_kind) {
+            continue;
+        }
+
+        if (operation->can_implement(problem.configuration(desc),
+                                     problem.arguments(desc)) !=
+            cutlass::Status::kSuccess) {
+            continue;
+        }
+
+        measure_operation(operation, problem, samples, batch, results);
+        ++count;
+    }
+
+    if (results.empty()) {
+        std::cerr << "No operation of the library implements the benchmark "
+                     "problems\n";
+        return 1;
+    }
+
+    print_summary(std::cout, results);
+
+    if (!output_path.empty()) {
+        std::ofstream output_file(output_path.c_str());
+        if (!output_file.good()) {
+            std::cerr << "Failed to open " << output_path << "\n";
+            return 1;
+        }
+        write_csv(output_file, results);
+    }
+
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,283 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Exports the catalog of the CUTLASS Library and finds operations able
+           to implement a problem. Runs without a GPU.
+*/
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "cutlass/util/command_line.h"
+
+#include "cutlass/library/catalog.h"
+#include "cutlass/library/singleton.h"
+#include "cutlass/library/util.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+using namespace cutlass::library;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void print_usage(std::ostream& out) {
+    out << "cutlass_library_catalog [options]\n\n"
+        << "  Lists the operations of the CUTLASS Library. If --operation is "
+           "given, only operations\n"
+        << "  able to implement the problem described by the options are "
+           "listed.\n\n"
+        << "  --output=<file>          Output file (default: stdout)\n"
+        << "  --format=<json|csv>      Output format (default: json, or csv "
+           "if the output ends with .csv)\n"
+        << "  --operation=<kind>       gemm, conv2d, conv3d or convolution\n"
+        << "  --cc=<int>               Compute capability of the target "
+           "device\n"
+        << "  --A=<type>:<layout>      Data type and layout of A (also --B, "
+           "--C)\n"
+        << "  --accumulator-type=<t>   Data type of the accumulator\n\n"
+        << "  GEMM:   --m --n --k --lda --ldb --ldc --split_k_slices "
+           "--batch_count\n"
+        << "  Conv2d: --conv_kind --n --h --w --c --k --r --s --p --q --pad_h "
+           "--pad_w\n"
+        << "          --stride_h --stride_w --dilation_h --dilation_w\n"
+        << "  Conv3d: Conv2d options and --d --t --z --pad_d --stride_d "
+           "--dilation_d\n\n"
+        << "Example:\n"
+        << "  $ cutlass_library_catalog --operation=gemm --cc=80 "
+           "--A=f16:column --B=f16:row --m=1024 --n=512 --k=4096\n";
+}
+
+/// Parses <type>:<layout>; either part may be omitted
+static bool parse_operand(cutlass::CommandLine const& cmdline,
+                          char const* name, NumericTypeID& element,
+                          LayoutTypeID& layout) {
+    std::string text;
+    cmdline.get_cmd_line_argument(name, text);
+
+    if (text.empty()) {
+        return true;
+    }
+
+    size_t separator = text.find(':');
+    std::string element_text = text.substr(0, separator);
+    std::string layout_text = separator == std::string::npos
+                                      ? std::string()
+                                      : text.substr(separator + 1);
+
+    if (!element_text.empty()) {
+        element = from_string<NumericTypeID>(element_text);
+        if (element == NumericTypeID::kInvalid) {
+            return false;
+        }
+    }
+
+    if (!layout_text.empty()) {
+        layout = from_string<LayoutTypeID>(layout_text);
+        if (layout == LayoutTypeID::kInvalid) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Output extent of a convolution along one dimension
+static int conv_output_extent(int input, int filter, int pad, int stride,
+                              int dilation) {
+    return (input + 2 * pad - dilation * (filter - 1) - 1) / stride + 1;
+}
+
+static bool parse_query(cutlass::CommandLine const& cmdline,
+                        CatalogQuery& query) {
+    std::string operation;
+    cmdline.get_cmd_line_argument("operation", operation);
+
+    query.kind = from_string<OperationKind>(operation);
+    if (query.kind != OperationKind::kGemm &&
+        query.kind != OperationKind::kConv2d &&
+        query.kind != OperationKind::kConv3d &&
+        query.kind != OperationKind::kConvolution) {
+        std::cerr << "Unsupported operation: " << operation << "\n";
+        return false;
+    }
+
+    cmdline.get_cmd_line_argument("cc", query.compute_capability, 0);
+
+    if (!parse_operand(cmdline, "A", query.element_A, query.layout_A) ||
+        !parse_operand(cmdline, "B", query.element_B, query.layout_B) ||
+        !parse_operand(cmdline, "C", query.element_C, query.layout_C)) {
+        std::cerr << "Invalid operand. Expected <type>:<layout>\n";
+        return false;
+    }
+
+    std::string accumulator_type;
+    cmdline.get_cmd_line_argument("accumulator-type", accumulator_type);
+    if (!accumulator_type.empty()) {
+        query.element_accumulator =
+                from_string<NumericTypeID>(accumulator_type);
+    }
+
+    if (query.kind == OperationKind::kGemm) {
+        int m, n, k;
+        cmdline.get_cmd_line_argument("m", m, 1024);
+        cmdline.get_cmd_line_argument("n", n, 1024);
+        cmdline.get_cmd_line_argument("k", k, 1024);
+        query.problem_size = cutlass::gemm::GemmCoord(m, n, k);
+
+        cmdline.get_cmd_line_argument("lda", query.lda, int64_t(0));
+        cmdline.get_cmd_line_argument("ldb", query.ldb, int64_t(0));
+        cmdline.get_cmd_line_argument("ldc", query.ldc, int64_t(0));
+        cmdline.get_cmd_line_argument("split_k_slices", query.split_k_slices,
+                                      1);
+        cmdline.get_cmd_line_argument("batch_count", query.batch_count, 1);
+        return true;
+    }
+
+    std::string conv_kind;
+    cmdline.get_cmd_line_argument("conv_kind", conv_kind);
+    if (!conv_kind.empty()) {
+        query.conv_kind = from_string<ConvKind>(conv_kind);
+    }
+
+    int n, h, w, c, k, r, s, pad_h, pad_w, stride_h, stride_w, dilation_h,
+            dilation_w;
+    cmdline.get_cmd_line_argument("n", n, 1);
+    cmdline.get_cmd_line_argument("h", h, 16);
+    cmdline.get_cmd_line_argument("w", w, 16);
+    cmdline.get_cmd_line_argument("c", c, 64);
+    cmdline.get_cmd_line_argument("k", k, 64);
+    cmdline.get_cmd_line_argument("r", r, 3);
+    cmdline.get_cmd_line_argument("s", s, 3);
+    cmdline.get_cmd_line_argument("pad_h", pad_h, r / 2);
+    cmdline.get_cmd_line_argument("pad_w", pad_w, s / 2);
+    cmdline.get_cmd_line_argument("stride_h", stride_h, 1);
+    cmdline.get_cmd_line_argument("stride_w", stride_w, 1);
+    cmdline.get_cmd_line_argument("dilation_h", dilation_h, 1);
+    cmdline.get_cmd_line_argument("dilation_w", dilation_w, 1);
+
+    int p, q;
+    cmdline.get_cmd_line_argument(
+            "p", p, conv_output_extent(h, r, pad_h, stride_h, dilation_h));
+    cmdline.get_cmd_line_argument(
+            "q", q, conv_output_extent(w, s, pad_w, stride_w, dilation_w));
+
+    int split_k_slices;
+    cmdline.get_cmd_line_argument("split_k_slices", split_k_slices, 1);
+
+    if (query.kind == OperationKind::kConv2d ||
+        query.kind == OperationKind::kConvolution) {
+        query.conv2d_problem_size = cutlass::conv::Conv2dProblemSize(
+                n, h, w, c, k, r, s, p, q, pad_h, pad_w, stride_h, stride_w,
+                dilation_h, dilation_w, cutlass::conv::Mode::kCrossCorrelation,
+                split_k_slices);
+        return true;
+    }
+
+    int d, t, pad_d, stride_d, dilation_d, z;
+    cmdline.get_cmd_line_argument("d", d, 16);
+    cmdline.get_cmd_line_argument("t", t, 3);
+    cmdline.get_cmd_line_argument("pad_d", pad_d, t / 2);
+    cmdline.get_cmd_line_argument("stride_d", stride_d, 1);
+    cmdline.get_cmd_line_argument("dilation_d", dilation_d, 1);
+    cmdline.get_cmd_line_argument(
+            "z", z, conv_output_extent(d, t, pad_d, stride_d, dilation_d));
+
+    query.conv3d_problem_size = cutlass::conv::Conv3dProblemSize(
+            n, d, h, w, c, k, t, r, s, z, p, q, pad_d, pad_h, pad_w, stride_d,
+            stride_h, stride_w, dilation_d, dilation_h, dilation_w,
+            cutlass::conv::Mode::kCrossCorrelation, split_k_slices);
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char const* arg[]) {
+    cutlass::CommandLine cmdline(argc, arg);
+
+    if (cmdline.check_cmd_line_flag("help")) {
+        print_usage(std::cout);
+        return 0;
+    }
+
+    std::string output_path;
+    cmdline.get_cmd_line_argument("output", output_path);
+
+    bool is_csv_path = output_path.size() > 4 &&
+                       output_path.compare(output_path.size() - 4, 4,
+                                           ".csv") == 0;
+
+    std::string format;
+    cmdline.get_cmd_line_argument("format", format,
+                                  std::string(is_csv_path ? "csv" : "json"));
+
+    if (format != "json" && format != "csv") {
+        std::cerr << "Unsupported format: " << format << "\n";
+        return 1;
+    }
+
+    // describing the library does not require a device, but every
+    // operation must be constructed
+    Singleton const& singleton = Singleton::get();
+    singleton.operation_table.initialize_all();
+
+    CatalogRecordVector records;
+
+    if (cmdline.check_cmd_line_flag("operation")) {
+        CatalogQuery query;
+        if (!parse_query(cmdline, query)) {
+            print_usage(std::cerr);
+            return 1;
+        }
+        records = query_catalog(singleton.manifest, query);
+    } else {
+        records = make_catalog(singleton.manifest);
+    }
+
+    std::ofstream output_file;
+    if (!output_path.empty()) {
+        output_file.open(output_path.c_str());
+        if (!output_file.good()) {
+            std::cerr << "Failed to open " << output_path << "\n";
+            return 1;
+        }
+    }
+
+    std::ostream& out = output_path.empty() ? std::cout : output_file;
+
+    if (format == "csv") {
+        write_catalog_csv(out, records);
+    } else {
+        write_catalog_json(out, records);
+    }
+
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
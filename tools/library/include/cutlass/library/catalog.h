@@ -0,0 +1,150 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Catalog of the operations contained in the CUTLASS Library
+
+    The catalog describes operations without launching them, so it may be
+    exported and queried on hosts without a GPU.
+*/
+
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Describes an operation of the catalog
+struct CatalogRecord {
+    /// Operation described
+    Operation const* operation;
+
+    /// Host workspace required by the operation (in bytes)
+    uint64_t host_workspace_size;
+
+    /// Device workspace required by the queried problem (in bytes, zero if
+    /// no problem was queried)
+    uint64_t device_workspace_size;
+
+    CatalogRecord(Operation const* operation = nullptr,
+                  uint64_t host_workspace_size = 0,
+                  uint64_t device_workspace_size = 0)
+            : operation(operation),
+              host_workspace_size(host_workspace_size),
+              device_workspace_size(device_workspace_size) {}
+};
+
+using CatalogRecordVector = std::vector<CatalogRecord>;
+
+/// Problem queried against the catalog.
+//
+// Fields set to their default values match any operation. The problem is
+// tested with Operation::can_implement() using null tensor pointers, so no
+// device memory is needed.
+struct CatalogQuery {
+    /// Kind of operation (kGemm, kConv2d or kConv3d)
+    OperationKind kind;
+
+    /// Compute capability of the target device
+    int compute_capability;
+
+    /// Data types and layouts of the operands
+    NumericTypeID element_A;
+    LayoutTypeID layout_A;
+    NumericTypeID element_B;
+    LayoutTypeID layout_B;
+    NumericTypeID element_C;
+    LayoutTypeID layout_C;
+    NumericTypeID element_accumulator;
+
+    /// Kind of convolution
+    ConvKind conv_kind;
+
+    /// GEMM problem. Leading dimensions of zero denote packed matrices.
+    gemm::GemmCoord problem_size;
+    int64_t lda;
+    int64_t ldb;
+    int64_t ldc;
+    int split_k_slices;
+    int batch_count;
+
+    /// Convolution problems with packed NHWC / NDHWC tensors
+    conv::Conv2dProblemSize conv2d_problem_size;
+    conv::Conv3dProblemSize conv3d_problem_size;
+
+    CatalogQuery()
+            : kind(OperationKind::kGemm),
+              compute_capability(0),
+              element_A(NumericTypeID::kInvalid),
+              layout_A(LayoutTypeID::kInvalid),
+              element_B(NumericTypeID::kInvalid),
+              layout_B(LayoutTypeID::kInvalid),
+              element_C(NumericTypeID::kInvalid),
+              layout_C(LayoutTypeID::kInvalid),
+              element_accumulator(NumericTypeID::kInvalid),
+              conv_kind(ConvKind::kInvalid),
+              lda(0),
+              ldb(0),
+              ldc(0),
+              split_k_slices(1),
+              batch_count(1) {}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns a record for each operation of the manifest, ordered by name.
+//
+// Operations constructed on demand are not listed until they are constructed.
+// Call OperationTable::initialize_all() to list all of them.
+CatalogRecordVector make_catalog(Manifest const& manifest);
+
+/// Returns the records of operations able to implement the queried problem,
+/// ordered by name.
+CatalogRecordVector query_catalog(Manifest const& manifest,
+                                  CatalogQuery const& query);
+
+/// Writes records as a JSON array of objects
+void write_catalog_json(std::ostream& out, CatalogRecordVector const& records);
+
+/// Writes records as CSV with a header row
+void write_catalog_csv(std::ostream& out, CatalogRecordVector const& records);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
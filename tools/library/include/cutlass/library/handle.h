@@ -30,8 +30,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <ostream>
+#include <unordered_map>
+
 #include "cutlass/library/library.h"
+#include "cutlass/library/operation_table.h"
+#include "cutlass/library/workspace.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -40,6 +46,47 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Runtime statistics gathered by a Handle.
+//
+// Counters are owned by the handle and updated by the thread using it without
+// synchronization, so they add no contention to dispatch.
+struct HandleStatistics {
+    /// Number of times each operation was run
+    std::unordered_map<Operation const*, uint64_t> operation_calls;
+
+    /// Number of calls for which no operation was found, by functional key
+    std::unordered_map<GemmFunctionalKey, uint64_t, GemmFunctionalKeyHasher>
+            misses;
+
+    /// Number of device workspace allocations
+    uint64_t workspace_allocations;
+
+    /// Total size of device workspace allocations in bytes
+    uint64_t workspace_bytes_allocated;
+
+    /// Host time spent in computation calls, from entry until the operation
+    /// returns from run(), in nanoseconds
+    int64_t dispatch_ns;
+
+    HandleStatistics()
+            : workspace_allocations(0),
+              workspace_bytes_allocated(0),
+              dispatch_ns(0) {}
+
+    /// Returns the number of operations run
+    uint64_t calls() const;
+
+    /// Returns the number of calls for which no operation was found
+    uint64_t miss_count() const;
+};
+
+/// Writes statistics as a JSON object. Operations are ordered by decreasing
+/// number of calls.
+void write_statistics_json(std::ostream& out,
+                           HandleStatistics const& statistics);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Handle object
 class Handle {
 private:
@@ -55,11 +102,9 @@ private:
     /// CUDA stream
     cudaStream_t stream_;
 
-    /// Device workspace
-    void* workspace_;
-
-    /// Size of device workspace in bytes
-    size_t workspace_size_;
+    /// Device workspace, grown on demand. May be shared with handles using
+    /// the same stream.
+    std::shared_ptr<WorkspaceArena> workspace_;
 
     /// Indicates whether scalars are host or device pointers
     ScalarPointerMode scalar_pointer_mode_;
@@ -67,8 +112,25 @@ private:
     /// Pointer to the most recently executed operation
     Operation const* last_operation_;
 
+    /// Counters of operations run, misses and workspace allocations
+    HandleStatistics statistics_;
+
+    /// Returns true if the handle was created on a CUDA device
+    bool has_device_() const;
+
+    /// Acquires `count` disjoint, zero-filled device workspaces from the
+    /// arena, growing it if needed. Workspaces of zero bytes are null.
+    Status acquire_workspace_(uint64_t const* bytes, void** workspaces,
+                              int count);
+
+    /// Acquires a single zero-filled device workspace of `bytes`
+    Status acquire_workspace_(uint64_t bytes, void** workspace) {
+        return acquire_workspace_(&bytes, workspace, 1);
+    }
+
 public:
-    /// Constructor
+    /// Constructor. Without a CUDA device, operations default to
+    /// Provider::kHost and no device workspace is allocated.
     Handle(cudaStream_t stream = nullptr, size_t workspace_size = (4 << 20));
 
     /// Destructor
@@ -105,10 +167,25 @@ public:
     /// Gets a pointer to the device workspace allocation in Global Memory
     void* get_workspace() const;
 
-    /// Sets the size of device workspace, invalidating calls to
-    /// get_device_workspace()
+    /// Grows the device workspace to at least `bytes`, invalidating calls to
+    /// get_device_workspace(). A size of zero releases the workspace.
+    //
+    // Computations grow the workspace as needed, so this only avoids
+    // allocations on first use.
     void set_workspace_size(size_t bytes);
 
+    /// Replaces the source of device workspace, releasing the current
+    /// workspace. A null allocator selects DeviceWorkspaceAllocator.
+    void set_workspace_allocator(std::shared_ptr<WorkspaceAllocator> allocator);
+
+    /// Gets the arena providing device workspace
+    std::shared_ptr<WorkspaceArena> get_workspace_arena() const;
+
+    /// Draws device workspace from an arena, e.g. one shared by handles
+    /// enqueuing work on the same stream. Handles sharing an arena must not
+    /// be used concurrently. A null arena selects a new, empty one.
+    void set_workspace_arena(std::shared_ptr<WorkspaceArena> arena);
+
     /// Gets the scalar pointer mode
     ScalarPointerMode get_scalar_pointer_mode() const;
 
@@ -118,6 +195,13 @@ public:
     /// Gets the most recently executed operation
     Operation const* get_last_operation() const;
 
+    /// Returns a snapshot of the statistics gathered since construction or
+    /// the last call to reset_statistics()
+    HandleStatistics get_statistics() const;
+
+    /// Clears the statistics
+    void reset_statistics();
+
     //
     // Computations
     //
@@ -168,7 +252,9 @@ public:
     /// Executes a GEMM computation: D <= alpha * A*B + beta * C.
     //
     // Supports batched-strided, batched array or split-K serial or split-K
-    // parallel.
+    // parallel. In split-K parallel mode, device kernels accumulate partial
+    // products in the handle's workspace and a reduction operation combines
+    // them into D.
     //
     Status gemm_universal(
 
@@ -361,6 +447,52 @@ public:
             int ldd_real,  /// Leading dimension of real part of D matrix
             int ldd_imag   /// Leading dimension of imaginary part of D matrix
     );
+
+    /// Grouped GEMM computing many independent problems of different shapes
+    /// in a single launch. Every array is in host memory and holds one entry
+    /// per problem; it may be reused once the call returns.
+    Status gemm_grouped(
+
+            int problem_count,  /// Number of GEMM problems in the group
+
+            gemm::GemmCoord const* problem_sizes,  /// Size of each problem
+
+            NumericTypeID
+                    element_compute,  /// Data type of internal accumulation
+
+            NumericTypeID element_scalar,  /// Data type of alpha/beta scalars
+
+            void const* alpha,  /// Pointer to alpha scalar
+
+            NumericTypeID element_A,  /// Data type of A matrix elements
+            LayoutTypeID layout_A,    /// Layout of A matrix
+            ComplexTransform
+                    transform_A,  /// Complex transformation applied to A matrix
+
+            void const* const* ptr_A,  /// Pointer to each A matrix
+            int64_t const* lda,        /// Leading dimension of each A matrix
+
+            NumericTypeID element_B,  /// Data type of B matrix elements
+            LayoutTypeID layout_B,    /// Layout of B matrix
+            ComplexTransform
+                    transform_B,  /// Complex transformation applied to B matrix
+
+            void const* const* ptr_B,  /// Pointer to each B matrix
+            int64_t const* ldb,        /// Leading dimension of each B matrix
+
+            void const* beta,  /// Pointer to beta scalar
+
+            NumericTypeID element_C,  /// Data type of C and D matrices
+
+            void const* const* ptr_C,  /// Pointer to each C matrix
+            int64_t const* ldc,        /// Leading dimension of each C matrix
+
+            void* const* ptr_D,  /// Pointer to each D matrix
+            int64_t const* ldd,  /// Leading dimension of each D matrix
+
+            int threadblock_count = 0  /// Number of persistent threadblocks;
+                                       /// zero selects from occupancy
+    );
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,184 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Pool of Handles leased to concurrent callers, each bound to a
+      caller's stream.
+
+    A Handle holds mutable state (stream, workspace, provider, last operation)
+    and so serves one thread at a time. The pool hands out leases on pooled
+    handles instead of having each thread construct its own. All handles share
+    the operation table of the Singleton. Each stream keeps the workspace
+    arenas of its leases, and a lease reuses an arena released by a previous
+    lease on its stream, which is safe since their work is ordered by that
+    stream. Concurrent leases on one stream receive distinct arenas.
+
+    Idle handles and per-stream arenas are spread over shards selected by
+    thread and stream, so concurrent callers rarely contend for a lock.
+*/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "cutlass/library/handle.h"
+#include "cutlass/library/workspace.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class HandlePool;
+
+/// Exclusive use of a pooled Handle and workspace arena bound to a stream.
+/// Both return to the pool when the lease is destroyed.
+class HandleLease {
+public:
+    /// Constructs an empty lease
+    HandleLease();
+
+    HandleLease(HandleLease&& lease);
+    HandleLease& operator=(HandleLease&& lease);
+
+    HandleLease(HandleLease const&) = delete;
+    HandleLease& operator=(HandleLease const&) = delete;
+
+    ~HandleLease();
+
+    /// Returns the handle to the pool
+    void release();
+
+    /// True if the lease holds a handle
+    explicit operator bool() const { return bool(handle_); }
+
+    Handle* get() const { return handle_.get(); }
+    Handle* operator->() const { return handle_.get(); }
+    Handle& operator*() const { return *handle_; }
+
+private:
+    friend class HandlePool;
+
+    HandlePool* pool_;
+    std::unique_ptr<Handle> handle_;
+
+    /// Shard of the idle list the handle returns to
+    int shard_;
+
+    /// Stream the lease is bound to
+    cudaStream_t stream_;
+
+    /// Arena returned to the stream's idle arenas
+    std::shared_ptr<WorkspaceArena> arena_;
+};
+
+/// Thread-safe pool of Handles. The pool must outlive its leases.
+class HandlePool {
+public:
+    /// Number of shards of idle handles and per-stream arenas
+    static int const kShardCount = 16;
+
+    /// Constructs a pool serving the current CUDA device. Each stream's arena
+    /// initially reserves `workspace_size` bytes. A null allocator selects
+    /// DeviceWorkspaceAllocator.
+    explicit HandlePool(size_t workspace_size = 0,
+                        std::shared_ptr<WorkspaceAllocator> allocator =
+                                std::shared_ptr<WorkspaceAllocator>());
+
+    ~HandlePool();
+
+    HandlePool(HandlePool const&) = delete;
+    HandlePool& operator=(HandlePool const&) = delete;
+
+    /// Leases a handle bound to a stream. The handle's provider and scalar
+    /// pointer mode are reset to their defaults.
+    HandleLease acquire(cudaStream_t stream = nullptr);
+
+    /// Releases the idle arenas of a stream, in the stream's order, and
+    /// forgets the stream. Arenas of outstanding leases are released when
+    /// the leases are. Call before destroying the stream.
+    void release_stream(cudaStream_t stream);
+
+    /// Number of handles constructed by the pool
+    size_t handle_count() const;
+
+    /// Number of streams with arenas
+    size_t stream_count() const;
+
+private:
+    friend class HandleLease;
+
+    /// Idle arenas of the handles leased on one stream
+    struct StreamWorkspace {
+        std::vector<std::shared_ptr<WorkspaceArena>> arenas;
+    };
+
+    /// Idle handles
+    struct HandleShard {
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<Handle>> handles;
+        size_t constructed;
+
+        HandleShard() : constructed(0) {}
+    };
+
+    /// Arenas of the streams hashing to one shard
+    struct StreamShard {
+        mutable std::mutex mutex;
+        std::unordered_map<cudaStream_t, StreamWorkspace> streams;
+    };
+
+    /// Takes an idle arena of a stream, creating one if none is idle
+    std::shared_ptr<WorkspaceArena> acquire_arena_(cudaStream_t stream);
+
+    /// Returns a handle to its idle list and an arena to its stream's
+    void release_(std::unique_ptr<Handle> handle, int shard,
+                  cudaStream_t stream, std::shared_ptr<WorkspaceArena> arena);
+
+    size_t workspace_size_;
+    std::shared_ptr<WorkspaceAllocator> allocator_;
+
+    /// Provider selected by a newly constructed handle
+    Provider default_provider_;
+
+    /// Empty arena held by idle handles
+    std::shared_ptr<WorkspaceArena> idle_arena_;
+
+    std::unique_ptr<HandleShard[]> handle_shards_;
+    std::unique_ptr<StreamShard[]> stream_shards_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
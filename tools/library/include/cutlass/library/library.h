@@ -92,6 +92,10 @@ enum class LayoutTypeID {
     kTensorC32RSK32,
     kTensorNC64HW64,
     kTensorC64RSK64,
+    kTensorNC4HW4,
+    kTensorC4RSK4,
+    kTensorNC8HW8,
+    kTensorNC16HW16,
     kInvalid
 };
 
@@ -148,6 +152,7 @@ enum class Provider {
     kReferenceDevice,
     kCUBLAS,
     kCUDNN,
+    kHost,  ///< optimized host (CPU) implementations
     kInvalid
 };
 
@@ -161,6 +166,7 @@ enum class OperationKind {
     kEqGemm,
     kSparseGemm,
     kReduction,
+    kConvolution,
     kInvalid
 };
 
@@ -200,6 +206,7 @@ enum class GemmKind {
     kUniversal,
     kPlanarComplex,
     kPlanarComplexArray,
+    kGrouped,
     kInvalid
 };
 
@@ -222,6 +229,21 @@ enum class EpilogueKind {
     kLinearCombinationPlanarComplex,
     kLinearCombinationRelu,
     kLinearCombinationSigmoid,
+    kBiasAddLinearCombination,
+    kBiasAddLinearCombinationClamp,
+    kBiasAddLinearCombinationRelu,
+    kBiasAddLinearCombinationReluClamp,
+    kBiasAddLinearCombinationHSwish,
+    kBiasAddLinearCombinationHSwishClamp,
+    kInvalid
+};
+
+/// Enumeration indicating the kind of Convolution operation to perform
+enum class ConvType {
+    kConvolution,
+    kBatchConvolution,
+    kLocal,
+    kLocalShare,
     kInvalid
 };
 
@@ -343,6 +365,9 @@ struct OperationDescription {
     /// Describes the tiled structure of a GEMM-like computation
     TileDescription tile_description;
 
+    /// Shared memory allocated statically by each threadblock (in bytes)
+    int shared_memory_size;
+
     //
     // Methods
     //
@@ -350,8 +375,12 @@ struct OperationDescription {
             char const* name = "unknown",
             Provider Provider = Provider::kInvalid,
             OperationKind kind = OperationKind::kInvalid,
-            TileDescription const& tile_description = TileDescription())
-            : name(name), kind(kind), tile_description(tile_description) {}
+            TileDescription const& tile_description = TileDescription(),
+            int shared_memory_size = 0)
+            : name(name),
+              kind(kind),
+              tile_description(tile_description),
+              shared_memory_size(shared_memory_size) {}
 };
 
 /// Structure describing the properties of a tensor
@@ -548,6 +577,35 @@ struct ConvDescription : public OperationDescription {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Description of convolution operations with a fused bias and residual
+/// (z) tensor. A is the source, B the filter and C the destination tensor;
+/// Z shares the element and layout of C.
+struct ConvolutionDescription : public ConvDescription {
+    /// Describes the kind of convolution (dense, batch, local, ...)
+    ConvType conv_type;
+
+    /// Describes the bias operand
+    TensorDescription bias;
+
+    /// Describes the epilogue functor
+    EpilogueKind epilogue;
+
+    //
+    // Methods
+    //
+
+    ConvolutionDescription(ConvType conv_type = ConvType::kInvalid,
+                           EpilogueKind epilogue = EpilogueKind::kInvalid)
+            : conv_type(conv_type), epilogue(epilogue) {
+        conv_dim = 2;
+        conv_kind = ConvKind::kFprop;
+        iterator_algorithm = IteratorAlgorithmID::kNone;
+        element_epilogue = NumericTypeID::kInvalid;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Base class for all operations
 class Operation {
 public:
@@ -837,6 +895,64 @@ struct GemmPlanarComplexArrayArguments {
     ScalarPointerMode pointer_mode;
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Grouped GEMM computing many independent problems of different shapes in
+/// a single launch
+//
+// OperationKind: Gemm
+// GemmKind:      Grouped
+//
+// Problem descriptors are given in host memory. Device operations copy them
+// into their device workspace, so the arrays may be reused as soon as the
+// call returns.
+
+struct GemmGroupedConfiguration {
+    /// Number of problems in the group
+    int problem_count;
+
+    /// Number of persistent threadblocks; zero selects from occupancy
+    int threadblock_count;
+
+    /// Size of each problem
+    gemm::GemmCoord const* problem_sizes;
+
+    /// Leading dimension of each A matrix
+    int64_t const* lda;
+
+    /// Leading dimension of each B matrix
+    int64_t const* ldb;
+
+    /// Leading dimension of each C matrix
+    int64_t const* ldc;
+
+    /// Leading dimension of each D matrix
+    int64_t const* ldd;
+};
+
+struct GemmGroupedArguments {
+    /// Pointer to each A matrix
+    void const* const* A;
+
+    /// Pointer to each B matrix
+    void const* const* B;
+
+    /// Pointer to each C matrix
+    void const* const* C;
+
+    /// Pointer to each D matrix
+    void* const* D;
+
+    /// Host or device pointer to alpha scalar shared by all problems
+    void const* alpha;
+
+    /// Host or device pointer to beta scalar shared by all problems
+    void const* beta;
+
+    /// Enumerant indicating whether alpha/beta point to host or device memory
+    ScalarPointerMode pointer_mode;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // OperationKind: kSparseGemm
@@ -1055,6 +1171,49 @@ struct ConvArguments {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Convolution with a fused bias and residual tensor
+//
+// OperationKind: Convolution
+//
+struct ConvolutionConfiguration {
+    /// Convolution problem size (N,H,W,C,K,R,S,P,Q,padding,stride,dilation,
+    /// mode). All tensors are densely packed in the layout of the operation.
+    conv::Conv2dProblemSize problem_size;
+};
+
+/// Arguments for Convolution
+struct ConvolutionArguments {
+    /// pointer to source tensor
+    void const* src;
+
+    /// pointer to filter tensor
+    void const* filter;
+
+    /// pointer to bias tensor
+    void const* bias;
+
+    /// pointer to residual tensor added to the output
+    void const* z;
+
+    /// pointer to destination tensor
+    void* dst;
+
+    /// Host or device pointer to alpha scalar (scales the accumulators)
+    void const* alpha;
+
+    /// Host or device pointer to beta scalar (scales the bias)
+    void const* beta;
+
+    /// Host or device pointer to gamma scalar (scales z)
+    void const* gamma;
+
+    /// Enumerant indicating whether alpha/beta/gamma point to host or device
+    /// memory
+    ScalarPointerMode pointer_mode;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Configuration for Reduction operations
 //
 // OperationKind: Reduction
@@ -36,6 +36,7 @@
 #include <list>
 #include <memory>
 #include <map>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -65,6 +66,59 @@ using OperationVector = std::vector<std::unique_ptr<Operation>>;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Compile-time descriptor of a procedurally generated operation.
+//
+// generator.py emits a static table of these for each operation kind. The
+// fields identify the functional behavior of the operation so that it may be
+// located without constructing it; `initialize` constructs the operation and
+// appends it to the manifest.
+//
+struct ManifestEntry {
+    /// Procedural name of the operation
+    char const* name;
+
+    /// Operation provider
+    Provider provider;
+
+    /// Kind of operation
+    OperationKind kind;
+
+    /// Kind of GEMM (kInvalid for operations other than GEMMs)
+    GemmKind gemm_kind;
+
+    /// Kind of convolution (kInvalid for operations other than convolutions)
+    ConvKind conv_kind;
+
+    /// Data type of the internal accumulator
+    NumericTypeID element_accumulator;
+
+    /// Data type of the scalars passed to the epilogue
+    NumericTypeID element_epilogue;
+
+    /// Describes the A operand
+    NumericTypeID element_A;
+    LayoutTypeID layout_A;
+    ComplexTransform transform_A;
+
+    /// Describes the B operand
+    NumericTypeID element_B;
+    LayoutTypeID layout_B;
+    ComplexTransform transform_B;
+
+    /// Describes the C operand
+    NumericTypeID element_C;
+    LayoutTypeID layout_C;
+
+    /// Range of compute capabilities declared by the generator
+    int minimum_compute_capability;
+    int maximum_compute_capability;
+
+    /// Constructs the operation and appends it to the manifest
+    void (*initialize)(Manifest& manifest);
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Manifest of CUTLASS Library
 class Manifest {
 private:
@@ -74,12 +128,21 @@ private:
     /// Global list of operations
     OperationVector operations_;
 
+    /// Descriptors of procedurally generated operations
+    std::vector<ManifestEntry const*> entries_;
+
+    /// Indicates whether the operation described by each entry was constructed
+    std::vector<bool> entry_initialized_;
+
 public:
     Manifest(Provider provider = library::Provider::kCUTLASS)
             : provider_(provider) {}
 
-    /// Top-level initialization
-    Status initialize();
+    /// Top-level initialization.
+    //
+    // If lazy is true, procedurally generated operations are only registered
+    // through their entries and must be constructed with initialize_entry().
+    Status initialize(bool lazy = false);
 
     /// Used for initialization
     void reserve(size_t operation_count);
@@ -90,6 +153,26 @@ public:
     /// Appends an operation and takes ownership
     void append(Operation* operation_ptr);
 
+    /// Registers a table of operations which are constructed on demand. The
+    /// table must outlive the manifest.
+    void append(ManifestEntry const* entries, size_t entry_count);
+
+    /// Returns the descriptors of procedurally generated operations
+    std::vector<ManifestEntry const*> const& entries() const;
+
+    /// Returns true if the operation described by an entry was constructed
+    bool entry_initialized(size_t entry_idx) const;
+
+    /// Constructs the operation described by an entry, if not yet constructed.
+    /// Returns the index in operations() of the first operation appended.
+    //
+    // Not thread-safe. Concurrent callers must be serialized (see
+    // OperationTable).
+    size_t initialize_entry(size_t entry_idx);
+
+    /// Constructs the operations of all entries not yet constructed
+    void initialize_entries();
+
     /// Returns an iterator to the first operation
     OperationVector const& operations() const;
 
@@ -35,6 +35,11 @@
 #include <iosfwd>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
@@ -430,27 +435,262 @@ using ReductionOperationFunctionalMap =
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Selection metadata of an operation inlined into the operation index so that
+/// choosing a kernel does not dereference its OperationDescription
+struct OperationCandidate {
+    /// Compute capability range of the operation
+    int minimum_compute_capability;
+    int maximum_compute_capability;
+
+    /// Largest alignment requirement among the operands (kGemm)
+    int alignment;
+
+    /// Iterator algorithm (kConv2d, kConv3d)
+    IteratorAlgorithmID iterator_algorithm;
+
+    /// Threadblock tile shape and number of mainloop stages
+    gemm::GemmCoord threadblock_shape;
+    int stages;
+
+    Operation const* operation;
+};
+
+/// Candidates of a functional key in descending order of preference
+using OperationCandidateVector = std::vector<OperationCandidate>;
+
+/// Finds the best GEMM among candidates in descending order of preference
+inline Operation const* find_gemm_operation(
+        OperationCandidateVector const& candidates,
+        GemmPreferenceKey const& preference_key) {
+    // Skip candidates preferred over the key, which cannot satisfy it (see
+    // GemmPreferenceKey::operator<)
+    auto it = std::lower_bound(
+            candidates.begin(), candidates.end(), preference_key,
+            [](OperationCandidate const& candidate, GemmPreferenceKey const& key) {
+                return key < GemmPreferenceKey(
+                                     candidate.minimum_compute_capability,
+                                     candidate.alignment);
+            });
+
+    // Search tile sizes in order, for now.
+    for (; it != candidates.end(); ++it) {
+        if ((it->minimum_compute_capability <= preference_key.compute_capability) &&
+            (preference_key.compute_capability <= it->maximum_compute_capability) &&
+            (it->alignment <= preference_key.alignment)) {
+            return it->operation;
+        }
+    }
+
+    return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Immutable index of functional keys built once a manifest is appended
+//
+// Keys are held in a flat array sorted by hash, so a lookup is a binary search
+// over integers followed by (almost always) a single key comparison. Each key
+// refers to a slot holding its candidates contiguously. Slots of keys whose
+// operations are constructed lazily record the manifest entries to construct
+// and are filled in on first query.
+//
+template <typename FunctionalKey, typename Hasher>
+class OperationIndex {
+public:
+    struct Slot {
+        /// Indices of deferred entries in Manifest::entries()
+        std::vector<size_t> entries;
+
+        /// Set once the operations of all entries are constructed and the
+        /// candidates are computed
+        mutable std::atomic<bool> initialized;
+
+        /// Candidates in descending order of preference
+        mutable OperationCandidateVector candidates;
+
+        Slot() : initialized(false) {}
+    };
+
+    /// Pairs of functional key and deferred manifest entries
+    using KeyEntries = std::vector<std::pair<FunctionalKey, std::vector<size_t> > >;
+
+private:
+    std::vector<size_t> hashes_;
+    std::vector<FunctionalKey> keys_;
+    std::unique_ptr<Slot[]> slots_;
+
+public:
+    /// Replaces the contents of the index. Keys must be unique.
+    void build(KeyEntries const& key_entries) {
+        Hasher hasher;
+
+        std::vector<std::pair<size_t, size_t> > order;
+        order.reserve(key_entries.size());
+
+        for (size_t idx = 0; idx < key_entries.size(); ++idx) {
+            order.emplace_back(hasher(key_entries[idx].first), idx);
+        }
+
+        std::sort(order.begin(), order.end());
+
+        hashes_.clear();
+        keys_.clear();
+        hashes_.reserve(order.size());
+        keys_.reserve(order.size());
+        slots_.reset(new Slot[order.size()]);
+
+        for (size_t idx = 0; idx < order.size(); ++idx) {
+            hashes_.push_back(order[idx].first);
+            keys_.push_back(key_entries[order[idx].second].first);
+            slots_[idx].entries = key_entries[order[idx].second].second;
+        }
+    }
+
+    /// Returns the slot of a functional key or nullptr
+    Slot const* find(FunctionalKey const& key) const {
+        size_t hash = Hasher()(key);
+
+        auto it = std::lower_bound(hashes_.begin(), hashes_.end(), hash);
+
+        for (; it != hashes_.end() && *it == hash; ++it) {
+            size_t idx = size_t(it - hashes_.begin());
+            if (keys_[idx] == key) {
+                return &slots_[idx];
+            }
+        }
+
+        return nullptr;
+    }
+
+    /// Number of functional keys
+    size_t size() const { return keys_.size(); }
+
+    FunctionalKey const& key(size_t idx) const { return keys_[idx]; }
+
+    Slot const& slot(size_t idx) const { return slots_[idx]; }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Table of cutlass::library::Operation instances
+//
+// Operations of a lazily initialized Manifest are constructed the first time
+// their functional key is queried through one of the find_*() methods. Every
+// functional key is inserted when the manifest is appended, so the maps are
+// never rehashed afterwards and queries only lock while constructing.
+//
+// Kernel selection should use the find_*_candidates() methods, which search
+// a flat index and return contiguous candidates with inlined metadata. The
+// maps remain available for exact preference-key queries.
+//
 class OperationTable {
 public:
     /// Map of all operations of type kGemm
     // provider (kCUTLASS)
-    GemmOperationFunctionalMap gemm_operations;
+    mutable GemmOperationFunctionalMap gemm_operations;
 
     /// Map of all operations of type kConv2d
-    // provider (kCUTLASS, kReferenceHost, kReferenceDevice)
-    ConvOperationFunctionalMap conv2d_operations;
+    // provider (kCUTLASS, kReferenceHost, kReferenceDevice, kHost)
+    mutable ConvOperationFunctionalMap conv2d_operations;
 
     /// Map of all operations of type kConv3d
-    // provider (kCUTLASS, kReferenceHost, kReferenceDevice)
-    ConvOperationFunctionalMap conv3d_operations;
+    // provider (kCUTLASS, kReferenceHost, kReferenceDevice, kHost)
+    mutable ConvOperationFunctionalMap conv3d_operations;
+
+    /// Map of all operations of type kConvolution
+    // provider (kCUTLASS, kReferenceHost)
+    mutable ConvOperationFunctionalMap convolution_operations;
 
     /// Map of all operations of type kConv2d
     // provider (kCUTLASS)
     ReductionOperationFunctionalMap reduction_operations;
 
+private:
+    /// Manifest owning the deferred operations
+    Manifest* manifest_;
+
+    /// Index of functional keys of kind kGemm
+    OperationIndex<GemmFunctionalKey, GemmFunctionalKeyHasher> gemm_index_;
+
+    /// Index of functional keys of kind kConv2d
+    OperationIndex<ConvFunctionalKey, ConvFunctionalKeyHasher> conv2d_index_;
+
+    /// Index of functional keys of kind kConv3d
+    OperationIndex<ConvFunctionalKey, ConvFunctionalKeyHasher> conv3d_index_;
+
+    /// Index of functional keys of kind kConvolution
+    OperationIndex<ConvFunctionalKey, ConvFunctionalKeyHasher>
+            convolution_index_;
+
+    /// Serializes construction of deferred operations
+    mutable std::mutex mutex_;
+
 public:
-    void append(Manifest const& manifest);
+    OperationTable() : manifest_(nullptr) {}
+
+    /// Inserts all constructed operations and registers the remaining
+    /// manifest entries to be constructed on demand. If compute_capabilities
+    /// is not empty, entries whose compute capability range contains none of
+    /// them are not registered.
+    void append(Manifest& manifest,
+                std::vector<int> const& compute_capabilities =
+                        std::vector<int>());
+
+    /// Returns the GEMM operations matching a functional key or nullptr
+    GemmOperationVectorMap const* find_gemm_operations(
+            GemmFunctionalKey const& key) const;
+
+    /// Returns the Conv2d operations matching a functional key or nullptr
+    ConvOperationVectorMap const* find_conv2d_operations(
+            ConvFunctionalKey const& key) const;
+
+    /// Returns the Conv3d operations matching a functional key or nullptr
+    ConvOperationVectorMap const* find_conv3d_operations(
+            ConvFunctionalKey const& key) const;
+
+    /// Returns the Convolution operations matching a functional key or
+    /// nullptr
+    ConvOperationVectorMap const* find_convolution_operations(
+            ConvFunctionalKey const& key) const;
+
+    /// Returns the GEMM candidates matching a functional key or nullptr
+    OperationCandidateVector const* find_gemm_candidates(
+            GemmFunctionalKey const& key) const;
+
+    /// Returns the Conv2d candidates matching a functional key or nullptr
+    OperationCandidateVector const* find_conv2d_candidates(
+            ConvFunctionalKey const& key) const;
+
+    /// Returns the Conv3d candidates matching a functional key or nullptr
+    OperationCandidateVector const* find_conv3d_candidates(
+            ConvFunctionalKey const& key) const;
+
+    /// Returns the Convolution candidates matching a functional key or
+    /// nullptr
+    OperationCandidateVector const* find_convolution_candidates(
+            ConvFunctionalKey const& key) const;
+
+    /// Returns the reduction operation matching a functional key or nullptr
+    Operation const* find_reduction_operation(
+            ReductionFunctionalKey const& key) const;
+
+    /// Constructs every deferred operation of the manifest
+    void initialize_all() const;
+
+private:
+    /// Inserts a GEMM or convolution operation into the maps. If deferred is
+    /// true, only keys already present are accepted.
+    bool insert_(Operation const* operation, bool deferred) const;
+
+    /// Constructs the operations of deferred entries and computes the
+    /// candidates of a slot on first use
+    template <typename FunctionalKey, typename Hasher, typename OperationMap>
+    OperationCandidateVector const* find_candidates_(
+            OperationIndex<FunctionalKey, Hasher> const& index,
+            OperationMap const& operations, FunctionalKey const& key) const;
+
+    /// Constructs the operations of deferred entries
+    void initialize_deferred_(std::vector<size_t> const& entries) const;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
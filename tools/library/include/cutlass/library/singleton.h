@@ -39,6 +39,10 @@ namespace library {
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Singleton instance stores a Manifest and Operation table
+//
+// Procedurally generated operations are constructed when their functional key
+// is first queried through the operation table. Call
+// operation_table.initialize_all() before enumerating the manifest.
 class Singleton {
 public:
     /// Manifest object
@@ -0,0 +1,181 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Operation-level tracing of the CUTLASS Library
+
+    Events record kernel selection, initialization, workspace resizes,
+    launches, verification and reference computations. Recording is always
+    compiled in and enabled at runtime, either with set_trace_enabled() or by
+    setting the environment variable CUTLASS_LIBRARY_TRACE to the path of a
+    file receiving a Chrome trace when the process exits.
+
+    Each thread appends to its own ring buffer, so recording takes no locks.
+    When a buffer is full, the oldest events of that thread are overwritten.
+    The trace may be opened with chrome://tracing or https://ui.perfetto.dev.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Kinds of traced events
+enum class TraceEventKind {
+    kSelect,      ///< selection of an operation among candidates
+    kInitialize,  ///< initialization of an operation and its workspaces
+    kWorkspace,   ///< allocation of device workspace
+    kLaunch,      ///< launch of one or more kernels
+    kVerify,      ///< verification of results
+    kReference,   ///< computation of reference results
+    kInvalid
+};
+
+/// A traced event
+struct TraceEvent {
+    /// Capacity of the detail string, including the terminating null
+    static int const kDetailCapacity = 64;
+
+    /// Kind of event
+    TraceEventKind kind;
+
+    /// Name of the event, typically that of an operation. Must have static
+    /// storage duration.
+    char const* name;
+
+    /// Start of the event in nanoseconds since the trace clock's origin
+    int64_t begin_ns;
+
+    /// Duration of the event in nanoseconds
+    int64_t duration_ns;
+
+    /// Index of the recording thread, assigned in order of first event
+    int thread;
+
+    /// Description of the problem (e.g. "m=128 n=128 k=64"), possibly empty
+    char detail[kDetailCapacity];
+};
+
+using TraceEventVector = std::vector<TraceEvent>;
+
+/// Returns the name of a kind of event
+char const* to_string(TraceEventKind kind, bool pretty = false);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Set while events are recorded
+extern std::atomic<bool> trace_enabled;
+
+}  // namespace detail
+
+/// Returns true if events are recorded
+inline bool trace_enabled() {
+    return detail::trace_enabled.load(std::memory_order_relaxed);
+}
+
+/// Enables or disables recording
+void set_trace_enabled(bool enabled);
+
+/// Returns the current time of the trace clock in nanoseconds
+int64_t trace_clock_ns();
+
+/// Records an event if recording is enabled. Lock-free except for the first
+/// event of each thread, which registers the thread's buffer.
+void trace_record(TraceEventKind kind, char const* name, int64_t begin_ns,
+                  int64_t end_ns, char const* detail = nullptr);
+
+/// Returns the events retained by all threads, ordered by start time
+TraceEventVector trace_snapshot();
+
+/// Discards the events recorded so far
+void trace_clear();
+
+/// Writes events in the Chrome trace event format
+void write_chrome_trace(std::ostream& out, TraceEventVector const& events);
+
+/// Writes the events retained by all threads to a file in the Chrome trace
+/// event format. Returns false if the file could not be written.
+bool write_chrome_trace(char const* path);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Records an event spanning the lifetime of the scope.
+//
+// Does nothing unless recording was enabled when the scope was constructed.
+class TraceScope {
+public:
+    TraceScope(TraceEventKind kind, char const* name);
+
+    ~TraceScope();
+
+    TraceScope(TraceScope const&) = delete;
+    TraceScope& operator=(TraceScope const&) = delete;
+
+    /// Returns true if the event will be recorded
+    bool active() const { return active_; }
+
+    /// Changes the name of the event. Must have static storage duration.
+    void set_name(char const* name);
+
+    /// Sets the detail string with printf-style formatting, truncating it to
+    /// the capacity of TraceEvent::detail
+    void set_detail(char const* format, ...)
+#if defined(__GNUC__)
+            __attribute__((format(printf, 2, 3)))
+#endif
+            ;
+
+    /// Records the event now rather than at the end of the scope
+    void finish();
+
+    /// Discards the event
+    void cancel() { active_ = false; }
+
+private:
+    TraceEventKind kind_;
+    char const* name_;
+    int64_t begin_ns_;
+    bool active_;
+    char detail_[TraceEvent::kDetailCapacity];
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
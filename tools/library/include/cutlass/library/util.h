@@ -117,6 +117,13 @@ char const* to_string(OpcodeClassID type, bool pretty = false);
 template <>
 OpcodeClassID from_string<OpcodeClassID>(std::string const& str);
 
+/// Converts a MathOperationID enumerant to a string
+char const* to_string(MathOperationID type, bool pretty = false);
+
+/// Converts a MathOperationID enumerant from a string
+template <>
+MathOperationID from_string<MathOperationID>(std::string const& str);
+
 /// Converts a ComplexTransform enumerant to a string
 char const* to_string(ComplexTransform type, bool pretty = false);
 
@@ -152,6 +159,20 @@ char const* to_string(ConvKind type, bool pretty = false);
 template <>
 ConvKind from_string<ConvKind>(std::string const& str);
 
+/// Converts a ConvType enumerant to a string
+char const* to_string(ConvType type, bool pretty = false);
+
+/// Converts a ConvType enumerant from a string
+template <>
+ConvType from_string<ConvType>(std::string const& str);
+
+/// Converts an EpilogueKind enumerant to a string
+char const* to_string(EpilogueKind type, bool pretty = false);
+
+/// Converts an EpilogueKind enumerant from a string
+template <>
+EpilogueKind from_string<EpilogueKind>(std::string const& str);
+
 /// Lexical cast from int64_t to string
 std::string lexical_cast(int64_t int_value);
 
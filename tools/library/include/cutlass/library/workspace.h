@@ -0,0 +1,205 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Growable, stream-ordered arena of device workspace.
+
+    Operations report the device workspace they need for each problem. Rather
+    than freeing and allocating whenever that size changes, the arena grows
+    geometrically and partitions its allocation among the workspaces of
+    chained operations (e.g. a GEMM and its parallel split-K reduction).
+    Memory is obtained from a WorkspaceAllocator, which may be replaced to
+    draw from an application's allocator or mocked in tests.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <cuda_runtime.h>
+
+#include "cutlass/cutlass.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Source of device memory for workspaces
+class WorkspaceAllocator {
+public:
+    virtual ~WorkspaceAllocator() {}
+
+    /// Allocates device memory usable by work enqueued on a stream. Returns
+    /// nullptr on failure.
+    virtual void* allocate(size_t bytes, cudaStream_t stream) = 0;
+
+    /// Releases an allocation once prior work on a stream completes
+    virtual void deallocate(void* ptr, size_t bytes, cudaStream_t stream) = 0;
+
+    /// Zero-fills device memory in stream order. Returns false on failure.
+    virtual bool fill_zero(void* ptr, size_t bytes, cudaStream_t stream) = 0;
+};
+
+/// Allocates from the CUDA stream-ordered allocator where the device
+/// supports memory pools, and with cudaMalloc() otherwise
+class DeviceWorkspaceAllocator : public WorkspaceAllocator {
+public:
+    DeviceWorkspaceAllocator();
+
+    virtual void* allocate(size_t bytes, cudaStream_t stream);
+
+    virtual void deallocate(void* ptr, size_t bytes, cudaStream_t stream);
+
+    virtual bool fill_zero(void* ptr, size_t bytes, cudaStream_t stream);
+
+private:
+    /// True if cudaMallocAsync() and cudaFreeAsync() are used
+    bool stream_ordered_;
+};
+
+/// Allocates with functions supplied by the application, e.g. to share the
+/// caching allocator of a framework. Memory is zero-filled with
+/// cudaMemsetAsync().
+class CallbackWorkspaceAllocator : public WorkspaceAllocator {
+public:
+    using AllocateFunction = std::function<void*(size_t, cudaStream_t)>;
+    using DeallocateFunction =
+            std::function<void(void*, size_t, cudaStream_t)>;
+
+    CallbackWorkspaceAllocator(AllocateFunction allocate,
+                               DeallocateFunction deallocate)
+            : allocate_(allocate), deallocate_(deallocate) {}
+
+    virtual void* allocate(size_t bytes, cudaStream_t stream);
+
+    virtual void deallocate(void* ptr, size_t bytes, cudaStream_t stream);
+
+    virtual bool fill_zero(void* ptr, size_t bytes, cudaStream_t stream);
+
+private:
+    AllocateFunction allocate_;
+    DeallocateFunction deallocate_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Growable allocation of device memory partitioned among the workspaces of
+/// one or more operations. Its host-side state is guarded by a mutex, but
+/// workspaces acquired by one thread are invalidated by the next acquire or
+/// release on any thread.
+class WorkspaceArena {
+public:
+    /// Alignment of each workspace in bytes
+    static size_t const kAlignment = 256;
+
+    /// Factor by which capacity at least grows when a request exceeds it
+    static size_t const kGrowthFactor = 2;
+
+    /// Constructs an empty arena. A null allocator selects
+    /// DeviceWorkspaceAllocator.
+    explicit WorkspaceArena(std::shared_ptr<WorkspaceAllocator> allocator =
+                                    std::shared_ptr<WorkspaceAllocator>());
+
+    /// Releases the allocation in the order of the stream last used
+    ~WorkspaceArena();
+
+    WorkspaceArena(WorkspaceArena const&) = delete;
+    WorkspaceArena& operator=(WorkspaceArena const&) = delete;
+
+    /// Pointer to the allocation (null if the arena is empty)
+    void* data() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return data_;
+    }
+
+    /// Size of the allocation in bytes
+    size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    /// Number of allocations made since construction
+    uint64_t allocation_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return allocation_count_;
+    }
+
+    /// Rounds a size up to the alignment of workspaces
+    static size_t aligned_size(size_t bytes) {
+        return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    /// Grows the capacity to at least `bytes`, exactly. Invalidates
+    /// previously acquired workspaces if the arena grows.
+    Status reserve(size_t bytes, cudaStream_t stream);
+
+    /// Releases the allocation in stream order
+    void release(cudaStream_t stream);
+
+    /// Partitions the arena into `count` disjoint, aligned workspaces of the
+    /// given sizes and zero-fills them. Grows the capacity geometrically if
+    /// it is insufficient. Workspaces of zero bytes are null. Invalidates
+    /// previously acquired workspaces.
+    Status acquire(size_t const* bytes, void** workspaces, int count,
+                   cudaStream_t stream);
+
+    /// Acquires a single workspace
+    Status acquire(size_t bytes, void** workspace, cudaStream_t stream) {
+        return acquire(&bytes, workspace, 1, stream);
+    }
+
+private:
+    /// Replaces the allocation with one of `bytes`, releasing the previous
+    /// one on the stream that last used it
+    Status reallocate_(size_t bytes, cudaStream_t stream);
+
+    /// Releases the allocation in stream order with the mutex held
+    void release_(cudaStream_t stream);
+
+    /// Guards the members below
+    mutable std::mutex mutex_;
+
+    std::shared_ptr<WorkspaceAllocator> allocator_;
+    void* data_;
+    size_t capacity_;
+    uint64_t allocation_count_;
+
+    /// Stream of the most recent use, on which the allocation is released
+    cudaStream_t stream_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
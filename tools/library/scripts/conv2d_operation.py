@@ -6,6 +6,7 @@
 #
 
 import enum
+import io
 import os.path
 import shutil
 
@@ -305,7 +306,7 @@ void initialize_${configuration_name}(Manifest &manifest) {
 
   #
   def __enter__(self):
-    self.configuration_file = open(self.configuration_path, "w")
+    self.configuration_file = io.StringIO()
     self.configuration_file.write(SubstituteTemplate(self.header_template, {
       'configuration_name': self.configuration_name
       }))
@@ -336,7 +337,7 @@ void initialize_${configuration_name}(Manifest &manifest) {
 
     self.configuration_file.write(self.configuration_epilogue)
     self.configuration_file.write(self.epilogue_template)
-    self.configuration_file.close()
+    WriteIfChanged(self.configuration_path, self.configuration_file.getvalue())
 
 
 ###################################################################################################
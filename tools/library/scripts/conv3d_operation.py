@@ -6,6 +6,7 @@
 #
 
 import enum
+import io
 import os.path
 import shutil
 
@@ -32,6 +33,10 @@ class Conv3dOperation:
     self.stride_support = stride_support
     self.swizzling_functor = swizzling_functor
 
+  #
+  def accumulator_type(self):
+    return self.tile_description.math_instruction.element_accumulator
+
   #
   def core_name(self):
     ''' The basic operation kind is prefixed with a letter indicating the accumulation type. '''
@@ -282,7 +287,7 @@ void initialize_${configuration_name}(Manifest &manifest) {
 
   #
   def __enter__(self):
-    self.configuration_file = open(self.configuration_path, "w")
+    self.configuration_file = io.StringIO()
     self.configuration_file.write(SubstituteTemplate(self.header_template, {
       'configuration_name': self.configuration_name
       }))
@@ -313,7 +318,7 @@ void initialize_${configuration_name}(Manifest &manifest) {
 
     self.configuration_file.write(self.configuration_epilogue)
     self.configuration_file.write(self.epilogue_template)
-    self.configuration_file.close()
+    WriteIfChanged(self.configuration_path, self.configuration_file.getvalue())
 
 
 ###################################################################################################
@@ -0,0 +1,312 @@
+#
+# \file generator.py
+#
+# \brief Generates the CUTLASS Library's instances
+#
+#
+
+import enum
+import io
+import os.path
+import shutil
+
+from library import *
+
+###################################################################################################
+
+#
+class ConvolutionOperation:
+  #
+  def __init__(self, conv_type, arch, tile_description, src, flt, bias, dst, element_epilogue, \
+    epilogue_functor = EpilogueFunctor.BiasAddLinearCombinationClamp, \
+    swizzling_functor = SwizzlingFunctor.ConvFpropNCxHWx, need_load_from_const = True, \
+    implicit_gemm_mode = ImplicitGemmMode.GemmNT):
+
+    self.operation_kind = OperationKind.Convolution
+    self.conv_kind = ConvKind.Fprop
+    self.conv_type = conv_type
+    self.arch = arch
+    self.tile_description = tile_description
+    self.src = src
+    self.flt = flt
+    self.bias = bias
+    self.dst = dst
+    self.element_epilogue = element_epilogue
+    self.epilogue_functor = epilogue_functor
+    self.swizzling_functor = swizzling_functor
+    self.need_load_from_const = need_load_from_const
+    self.implicit_gemm_mode = implicit_gemm_mode
+
+    # operand aliases used by the manifest
+    self.A = src
+    self.B = flt
+    self.C = dst
+
+  #
+  def accumulator_type(self):
+    return self.tile_description.math_instruction.element_accumulator
+
+  #
+  def core_name(self):
+    ''' The basic operation kind is prefixed with a letter indicating the accumulation type. '''
+
+    if self.tile_description.math_instruction.opcode_class == OpcodeClass.TensorOp:
+      inst_shape = "%d%d%d" % tuple(self.tile_description.math_instruction.instruction_shape)
+    else:
+      inst_shape = ''
+
+    return "%s%s%s_%s" % (ShortDataTypeNames[self.accumulator_type()], inst_shape, \
+      ConvKindNames[self.conv_kind], ShortEpilogueNames[self.epilogue_functor])
+
+  #
+  def extended_name(self):
+    ''' Append data types if they differ from compute type. '''
+    if self.dst.element != self.src.element:
+      extended_name = "${element_dst}_${core_name}_${element_src}"
+    else:
+      extended_name = "${core_name}_${element_src}"
+
+    return SubstituteTemplate(extended_name, {
+      'element_src': DataTypeNames[self.src.element],
+      'element_dst': DataTypeNames[self.dst.element],
+      'core_name': self.core_name()
+      })
+
+  #
+  def layout_name(self):
+    return "%s_%s" % (ShortLayoutTypeNames[self.src.layout], ShortLayoutTypeNames[self.flt.layout])
+
+  #
+  def configuration_name(self):
+    ''' The full procedural name indicates architecture, extended name, tile size, and layout. '''
+
+    opcode_class_name = OpcodeClassNames[self.tile_description.math_instruction.opcode_class]
+
+    warp_shape = [int(self.tile_description.threadblock_shape[idx] / self.tile_description.warp_count[idx]) \
+      for idx in range(3)]
+
+    threadblock = "%dx%dx%d_%dx%dx%d_%d" % (
+      self.tile_description.threadblock_shape[0],
+      self.tile_description.threadblock_shape[1],
+      self.tile_description.threadblock_shape[2],
+      warp_shape[0],
+      warp_shape[1],
+      warp_shape[2],
+      self.tile_description.stages
+    )
+
+    configuration_name = "cutlass_${opcode_class}_${extended_name}_${threadblock}_${layout}"
+
+    return SubstituteTemplate(
+      configuration_name,
+      {
+        'opcode_class': opcode_class_name,
+        'extended_name': self.extended_name(),
+        'threadblock': threadblock,
+        'layout': self.layout_name(),
+      }
+    )
+
+  #
+  def procedural_name(self):
+    ''' The full procedural name indicates architecture, extended name, tile size, and layout. '''
+    return self.configuration_name()
+
+###################################################################################################
+#
+# Emits single instances of a CUTLASS device-wide operator
+#
+###################################################################################################
+
+class EmitConvolutionInstance:
+  def __init__(self):
+    self.template = """
+  // kernel instance "${operation_name}" generated by cutlass generator
+  using ${operation_name}_base =
+  cutlass::conv::device::Convolution<
+    ${element_src},
+    ${layout_src},
+    ${element_flt},
+    ${layout_flt},
+    ${element_dst},
+    ${layout_dst},
+    ${element_bias},
+    ${layout_bias},
+    ${element_accumulator},
+    ${conv_type},
+    ${opcode_class},
+    ${arch},
+    cutlass::gemm::GemmShape<${threadblock_shape_m}, ${threadblock_shape_n}, ${threadblock_shape_k}>,
+    cutlass::gemm::GemmShape<${warp_shape_m}, ${warp_shape_n}, ${warp_shape_k}>,
+    cutlass::gemm::GemmShape<${instruction_shape_m}, ${instruction_shape_n}, ${instruction_shape_k}>,
+    ${epilogue_functor}<
+      ${element_dst},
+      ${epilogue_vector_length},
+      ${element_accumulator},
+      ${element_bias},
+      ${element_epilogue}
+    >,
+    ${swizzling_functor},
+    ${stages},
+    ${alignment_src},
+    ${alignment_filter},
+    ${need_load_from_const},
+    ${math_operation},
+    ${implicit_gemm_mode}
+  >;
+"""
+
+
+  def emit(self, operation):
+
+    warp_shape = [int(operation.tile_description.threadblock_shape[idx] / operation.tile_description.warp_count[idx]) for idx in range(3)]
+
+    epilogue_vector_length = int(min(operation.dst.alignment * DataTypeSize[operation.dst.element], 128) / DataTypeSize[operation.dst.element])
+
+    values = {
+      'operation_name': operation.procedural_name(),
+      'conv_type': ConvTypeTag[operation.conv_type],
+      'element_src': DataTypeTag[operation.src.element],
+      'layout_src': LayoutTag[operation.src.layout],
+      'element_flt': DataTypeTag[operation.flt.element],
+      'layout_flt': LayoutTag[operation.flt.layout],
+      'element_dst': DataTypeTag[operation.dst.element],
+      'layout_dst': LayoutTag[operation.dst.layout],
+      'element_bias': DataTypeTag[operation.bias.element],
+      'layout_bias': LayoutTag[operation.bias.layout],
+      'element_accumulator': DataTypeTag[operation.accumulator_type()],
+      'opcode_class': OpcodeClassTag[operation.tile_description.math_instruction.opcode_class],
+      'arch': "cutlass::arch::Sm%d" % operation.arch,
+      'threadblock_shape_m': str(operation.tile_description.threadblock_shape[0]),
+      'threadblock_shape_n': str(operation.tile_description.threadblock_shape[1]),
+      'threadblock_shape_k': str(operation.tile_description.threadblock_shape[2]),
+      'warp_shape_m': str(warp_shape[0]),
+      'warp_shape_n': str(warp_shape[1]),
+      'warp_shape_k': str(warp_shape[2]),
+      'instruction_shape_m': str(operation.tile_description.math_instruction.instruction_shape[0]),
+      'instruction_shape_n': str(operation.tile_description.math_instruction.instruction_shape[1]),
+      'instruction_shape_k': str(operation.tile_description.math_instruction.instruction_shape[2]),
+      'epilogue_vector_length': str(epilogue_vector_length),
+      'epilogue_functor': EpilogueFunctorTag[operation.epilogue_functor],
+      'element_epilogue': str(DataTypeTag[operation.element_epilogue]),
+      'swizzling_functor': SwizzlingFunctorTag[operation.swizzling_functor],
+      'stages': str(operation.tile_description.stages),
+      'alignment_src': str(operation.src.alignment),
+      'alignment_filter': str(operation.flt.alignment),
+      'need_load_from_const': 'true' if operation.need_load_from_const else 'false',
+      'math_operation': MathOperationTag[operation.tile_description.math_instruction.math_operation],
+      'implicit_gemm_mode': ImplicitGemmModeTag[operation.implicit_gemm_mode]
+    }
+
+    return SubstituteTemplate(self.template, values)
+
+###################################################################################################
+#
+# Emitters functions for all targets
+#
+###################################################################################################
+
+class EmitConvolutionConfigurationLibrary:
+  def __init__(self, operation_path, configuration_name):
+    self.configuration_name = configuration_name
+    self.configuration_path = os.path.join(operation_path, "%s.cu" % configuration_name)
+
+    self.instance_emitter = EmitConvolutionInstance()
+
+    self.instance_template = """
+${operation_instance}
+
+// Derived class
+struct ${operation_name} :
+  public ${operation_name}_base { };
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+"""
+    self.header_template = """
+/*
+  Generated by convolution_operation.py - Do not edit.
+*/
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cutlass/cutlass.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+
+#include "library_internal.h"
+#include "convolution_operation.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+"""
+
+    self.configuration_header = """
+
+namespace cutlass {
+namespace library {
+
+// Initialize all instances
+void initialize_${configuration_name}(Manifest &manifest) {
+
+"""
+
+    self.configuration_instance = """
+  manifest.append(new cutlass::library::ConvolutionOperation<
+    ${operation_name}>(
+      "${operation_name}"));
+
+"""
+
+    self.configuration_epilogue = """
+}
+"""
+    self.epilogue_template = """
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+"""
+
+  #
+  def __enter__(self):
+    self.configuration_file = io.StringIO()
+    self.configuration_file.write(SubstituteTemplate(self.header_template, {
+      'configuration_name': self.configuration_name
+      }))
+    self.operations = []
+    return self
+
+  #
+  def emit(self, operation):
+    self.operations.append(operation)
+    self.configuration_file.write(SubstituteTemplate(self.instance_template, {
+      'configuration_name': self.configuration_name,
+      'operation_name': operation.procedural_name(),
+      'operation_instance': self.instance_emitter.emit(operation)
+      }))
+
+  #
+  def __exit__(self, exception_type, exception_value, traceback):
+
+    self.configuration_file.write(SubstituteTemplate(self.configuration_header, {
+      'configuration_name': self.configuration_name
+      }))
+
+    for operation in self.operations:
+      self.configuration_file.write(SubstituteTemplate(self.configuration_instance, {
+        'configuration_name': self.configuration_name,
+        'operation_name': operation.procedural_name()
+      }))
+
+    self.configuration_file.write(self.configuration_epilogue)
+    self.configuration_file.write(self.epilogue_template)
+    WriteIfChanged(self.configuration_path, self.configuration_file.getvalue())
+
+
+###################################################################################################
+###################################################################################################
+
@@ -5,6 +5,7 @@
 #
 
 import enum
+import io
 import os.path
 import shutil
 import functools
@@ -615,6 +616,77 @@ class EmitGemmPlanarComplexArrayInstance:
 
 ###################################################################################################
 
+#
+class EmitGemmGroupedInstance:
+  ''' Responsible for emitting a CUTLASS template definition'''
+
+  def __init__(self):
+    self.gemm_template = """
+  // Gemm operator ${operation_name}
+  using Operation_${operation_name} = cutlass::gemm::device::GemmGrouped<
+    typename cutlass::gemm::kernel::DefaultGemmGrouped<
+      ${element_a}, ${layout_a}, ${align_a},
+      ${element_b}, ${layout_b}, ${align_b},
+      ${element_c}, ${layout_c},
+      ${element_accumulator},
+      ${opcode_class},
+      ${arch},
+      cutlass::gemm::GemmShape<${threadblock_shape_m}, ${threadblock_shape_n}, ${threadblock_shape_k}>,
+      cutlass::gemm::GemmShape<${warp_shape_m}, ${warp_shape_n}, ${warp_shape_k}>,
+      cutlass::gemm::GemmShape<${instruction_shape_m}, ${instruction_shape_n}, ${instruction_shape_k}>,
+      ${epilogue_functor}<
+        ${element_c},
+        ${epilogue_vector_length},
+        ${element_accumulator},
+        ${element_epilogue}
+      >,
+      ${swizzling_functor},
+      ${stages},
+      ${math_operation}
+    >::GemmKernel
+  >;
+"""
+
+  def emit(self, operation):
+
+    warp_shape = [operation.tile_description.threadblock_shape[idx] // operation.tile_description.warp_count[idx] for idx in range(3)]
+
+    epilogue_vector_length = int(min(operation.C.alignment * DataTypeSize[operation.C.element], 128) / DataTypeSize[operation.C.element])
+
+    values = {
+      'operation_name': operation.procedural_name(),
+      'element_a': DataTypeTag[operation.A.element],
+      'layout_a': LayoutTag[operation.A.layout],
+      'element_b': DataTypeTag[operation.B.element],
+      'layout_b': LayoutTag[operation.B.layout],
+      'element_c': DataTypeTag[operation.C.element],
+      'layout_c': LayoutTag[operation.C.layout],
+      'element_accumulator': DataTypeTag[operation.accumulator_type()],
+      'opcode_class': OpcodeClassTag[operation.tile_description.math_instruction.opcode_class],
+      'arch': "cutlass::arch::Sm%d" % operation.arch,
+      'threadblock_shape_m': str(operation.tile_description.threadblock_shape[0]),
+      'threadblock_shape_n': str(operation.tile_description.threadblock_shape[1]),
+      'threadblock_shape_k': str(operation.tile_description.threadblock_shape[2]),
+      'warp_shape_m': str(warp_shape[0]),
+      'warp_shape_n': str(warp_shape[1]),
+      'warp_shape_k': str(warp_shape[2]),
+      'instruction_shape_m': str(operation.tile_description.math_instruction.instruction_shape[0]),
+      'instruction_shape_n': str(operation.tile_description.math_instruction.instruction_shape[1]),
+      'instruction_shape_k': str(operation.tile_description.math_instruction.instruction_shape[2]),
+      'epilogue_vector_length': str(epilogue_vector_length),
+      'element_epilogue': str(DataTypeTag[operation.element_epilogue]),
+      'epilogue_functor': EpilogueFunctorTag[operation.epilogue_functor],
+      'swizzling_functor': SwizzlingFunctorTag[operation.swizzling_functor],
+      'stages': str(operation.tile_description.stages),
+      'align_a': str(operation.A.alignment),
+      'align_b': str(operation.B.alignment),
+      'math_operation': MathOperationTag[operation.tile_description.math_instruction.math_operation]
+    }
+
+    return SubstituteTemplate(self.gemm_template, values)
+
+###################################################################################################
+
 
 ###################################################################################################
 #
@@ -632,7 +704,8 @@ class EmitGemmConfigurationLibrary:
       GemmKind.Sparse: EmitSparseGemmInstance,
       GemmKind.Universal: EmitGemmUniversalInstance,
       GemmKind.PlanarComplex: EmitGemmPlanarComplexInstance,
-      GemmKind.PlanarComplexArray: EmitGemmPlanarComplexArrayInstance
+      GemmKind.PlanarComplexArray: EmitGemmPlanarComplexArrayInstance,
+      GemmKind.Grouped: EmitGemmGroupedInstance
     }
 
     self.gemm_kind_wrappers = {
@@ -640,7 +713,8 @@ class EmitGemmConfigurationLibrary:
       GemmKind.Sparse: 'GemmSparseOperation',
       GemmKind.Universal: 'GemmUniversalOperation',
       GemmKind.PlanarComplex: 'GemmPlanarComplexOperation',
-      GemmKind.PlanarComplexArray: 'GemmPlanarComplexArrayOperation'
+      GemmKind.PlanarComplexArray: 'GemmPlanarComplexArrayOperation',
+      GemmKind.Grouped: 'GemmGroupedOperation'
     }
 
     self.wmma_guard_start = "#if defined(CUTLASS_ARCH_WMMA_SM${sm_number}_ENABLED)"
@@ -676,6 +750,11 @@ ${compile_guard_start}
     cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>
   >("${operation_name}"));
 ${compile_guard_end}
+""",
+      GemmKind.Grouped: """
+${compile_guard_start}
+  manifest.append(new ${gemm_kind}<Operation_${operation_name}>("${operation_name}"));
+${compile_guard_end}
 """
     }
 
@@ -723,7 +802,7 @@ void initialize_${configuration_name}(Manifest &manifest) {
 """
 
   def __enter__(self):
-    self.configuration_file = open(self.configuration_path, "w")
+    self.configuration_file = io.StringIO()
     self.configuration_file.write(self.header_template)
 
     self.instance_definitions = []
@@ -764,7 +843,7 @@ void initialize_${configuration_name}(Manifest &manifest) {
       self.configuration_file.write(instance_wrapper) 
 
     self.configuration_file.write(self.epilogue_template)
-    self.configuration_file.close()
+    WriteIfChanged(self.configuration_path, self.configuration_file.getvalue())
 
 ###################################################################################################
 ###################################################################################################
@@ -11,6 +11,7 @@ import argparse
 
 from library import *
 from manifest import *
+from workload import *
 ###################################################################################################
 
 #
@@ -68,6 +69,38 @@ def CreateGemmOperator(manifest, layouts, tile_descriptions, data_type, \
 
   return operations
 
+#
+def CreateGemmGroupedOperator(manifest, layouts, tile_descriptions, data_type, \
+  alignment_constraints, epilogue_functor = EpilogueFunctor.LinearCombination, \
+  swizzling_functor = SwizzlingFunctor.Identity8):
+
+  element_a, element_b, element_c, element_epilogue = data_type
+
+  operations = []
+
+  # by default, only generate the largest tile and largest alignment
+  if manifest.args.kernels == '':
+    tile_descriptions = [tile_descriptions[0],]
+    alignment_constraints = [alignment_constraints[0],]
+
+  for layout in layouts:
+    for tile_description in tile_descriptions:
+      for alignment in alignment_constraints:
+
+        alignment_c = min(8, alignment)
+
+        A = TensorDescription(element_a, layout[0], alignment)
+        B = TensorDescription(element_b, layout[1], alignment)
+        C = TensorDescription(element_c, layout[2], alignment_c)
+
+        new_operation = GemmOperation(GemmKind.Grouped, tile_description.minimum_compute_capability, \
+          tile_description, A, B, C, element_epilogue, epilogue_functor, swizzling_functor)
+
+        manifest.append(new_operation)
+        operations.append(new_operation)
+
+  return operations
+
 #
 def CreateSparseGemmOperator(manifest, layouts, tile_descriptions, data_type, \
   alignment_constraints, complex_transforms = None, epilogue_functor = EpilogueFunctor.LinearCombination, \
@@ -236,6 +269,40 @@ def CreateConv3dOperator(manifest, layout, tile_descriptions, data_type, alignme
 
   return operations
 
+# Convolution operators of the MegEngine device::Convolution (forward, with bias)
+def CreateConvolutionOperator(manifest, layouts, tile_descriptions, data_type, alignment, \
+  swizzling_functor, need_load_from_const = True, implicit_gemm_mode = ImplicitGemmMode.GemmNT, \
+  epilogue_functors = [EpilogueFunctor.BiasAddLinearCombinationClamp, \
+    EpilogueFunctor.BiasAddLinearCombinationReluClamp, \
+    EpilogueFunctor.BiasAddLinearCombinationHSwishClamp]):
+
+  element_src, element_flt, element_bias, element_dst, element_epilogue = data_type
+  alignment_src, alignment_flt, alignment_dst = alignment
+
+  # by default, only generate the largest tile size
+  if manifest.args.kernels == '':
+    tile_descriptions = [tile_descriptions[0],]
+
+  operations = []
+
+  for layout in layouts:
+    layout_src, layout_flt, layout_dst, layout_bias = layout
+    for tile in tile_descriptions:
+      for epilogue_functor in epilogue_functors:
+        src = TensorDescription(element_src, layout_src, alignment_src)
+        flt = TensorDescription(element_flt, layout_flt, alignment_flt)
+        bias = TensorDescription(element_bias, layout_bias, 1)
+        dst = TensorDescription(element_dst, layout_dst, alignment_dst)
+
+        new_operation = ConvolutionOperation(ConvType.Convolution, tile.minimum_compute_capability, \
+          tile, src, flt, bias, dst, element_epilogue, epilogue_functor, swizzling_functor, \
+          need_load_from_const, implicit_gemm_mode)
+
+        manifest.append(new_operation)
+        operations.append(new_operation)
+
+  return operations
+
 ###################################################################################################
 ###################################################################################################
 
@@ -287,6 +354,9 @@ def GenerateSM50_Simt(manifest, args):
       data_type, alignment_constraints)
 
     if math_inst.element_a == DataType.f32:
+      CreateGemmGroupedOperator(manifest, layouts, tile_descriptions, \
+        data_type, alignment_constraints)
+
       conv_layout = (LayoutType.TensorNHWC, LayoutType.TensorNHWC, LayoutType.TensorNHWC)
       CreateConv2dOperator(manifest, conv_layout, tile_descriptions, data_type, 1)
 #
@@ -445,9 +515,60 @@ def GenerateSM61_Simt(manifest, args):
       data_type_mixed, alignment_constraints)
 #
 
+#
+def GenerateSM61_Simt_Convolution(manifest, args):
+
+  math_instructions = [
+    MathInstruction(                                  \
+      [1, 1, 4],                                      \
+      DataType.s8, DataType.s8, DataType.s32,         \
+      OpcodeClass.Simt,                               \
+      MathOperation.multiply_add),
+  ]
+
+  min_cc = 61
+  max_cc = 1024
+
+  for math_inst in math_instructions:
+    data_type = [
+      math_inst.element_a,
+      math_inst.element_b,
+      math_inst.element_accumulator,
+      math_inst.element_a,
+      DataType.f32,
+    ]
+
+    # NCHW4 activations with NCHW4 filters
+    tile_descriptions = [
+      TileDescription([128,  64, 32], 2, [2, 2, 1], math_inst, min_cc, max_cc),
+      TileDescription([ 64,  64, 32], 2, [2, 2, 1], math_inst, min_cc, max_cc),
+    ]
+
+    layouts = [
+      (LayoutType.TensorNC4HW4, LayoutType.TensorC4RSK4, LayoutType.TensorNC4HW4, LayoutType.TensorNC4HW4),
+    ]
+
+    CreateConvolutionOperator(manifest, layouts, tile_descriptions, data_type, [4, 16, 4], \
+      SwizzlingFunctor.ConvFpropNCxHWx)
+
+    # CHWN4 activations with CHWN4 filters
+    tile_descriptions = [
+      TileDescription([128,  64, 32], 2, [4, 1, 1], math_inst, min_cc, max_cc),
+      TileDescription([ 64,  64, 32], 2, [2, 1, 1], math_inst, min_cc, max_cc),
+    ]
+
+    layouts = [
+      (LayoutType.TensorC4RSK4, LayoutType.TensorC4RSK4, LayoutType.TensorC4RSK4, LayoutType.TensorC4RSK4),
+    ]
+
+    CreateConvolutionOperator(manifest, layouts, tile_descriptions, data_type, [4, 16, 4], \
+      SwizzlingFunctor.ConvFpropCxRSKx)
+#
+
 #
 def GenerateSM61(manifest, args):
   GenerateSM61_Simt(manifest, args)
+  GenerateSM61_Simt_Convolution(manifest, args)
 
 ###################################################################################################
 ###################################################################################################
@@ -1213,6 +1334,81 @@ def GenerateSM75_Simt_complex(manifest, args):
     CreateConv2dOperator(manifest, conv_layout, tile_descriptions, data_type, 1)
 #
 
+#
+def GenerateSM75_TensorOp_Convolution(manifest, args):
+
+  if not CudaToolkitVersionSatisfies(args.cuda_version, 10, 2):
+    return
+
+  min_cc = 75
+  max_cc = 1024
+
+  # NCHW32 activations, 8-bit integer
+  math_inst = MathInstruction(                        \
+    [8, 8, 16],                                       \
+    DataType.s8, DataType.s8, DataType.s32,           \
+    OpcodeClass.TensorOp,                             \
+    MathOperation.multiply_add_saturate)
+
+  tile_descriptions = [
+    TileDescription([256, 128, 64], 2, [4, 2, 1], math_inst, min_cc, max_cc),
+    TileDescription([128, 128, 64], 2, [2, 2, 1], math_inst, min_cc, max_cc),
+    TileDescription([ 64, 128, 64], 2, [2, 2, 1], math_inst, min_cc, max_cc),
+  ]
+
+  layouts = [
+    (LayoutType.TensorNC32HW32, LayoutType.TensorC32RSK32, LayoutType.TensorNC32HW32, LayoutType.TensorNC32HW32),
+  ]
+
+  data_type = [DataType.s8, DataType.s8, DataType.s32, DataType.s8, DataType.f32]
+
+  CreateConvolutionOperator(manifest, layouts, tile_descriptions, data_type, [16, 16, 8], \
+    SwizzlingFunctor.ConvFpropNCxHWx)
+
+  # NCHW64 activations, 4-bit signed and unsigned integer
+  for element_src in [DataType.s4, DataType.u4]:
+    math_inst = MathInstruction(                      \
+      [8, 8, 32],                                     \
+      element_src, DataType.s4, DataType.s32,         \
+      OpcodeClass.TensorOp,                           \
+      MathOperation.multiply_add_saturate)
+
+    tile_descriptions = [
+      TileDescription([128, 128, 128], 2, [2, 2, 1], math_inst, min_cc, max_cc),
+      TileDescription([256, 128, 128], 2, [4, 2, 1], math_inst, min_cc, max_cc),
+    ]
+
+    layouts = [
+      (LayoutType.TensorNC64HW64, LayoutType.TensorC64RSK64, LayoutType.TensorNC64HW64, LayoutType.TensorNC64HW64),
+    ]
+
+    data_type = [element_src, DataType.s4, DataType.s32, DataType.s4, DataType.f32]
+
+    CreateConvolutionOperator(manifest, layouts, tile_descriptions, data_type, [32, 32, 16], \
+      SwizzlingFunctor.ConvFpropNCxHWx)
+
+  # NHWC activations, 4-bit signed integer, computed as a TN implicit GEMM
+  math_inst = MathInstruction(                        \
+    [8, 8, 32],                                       \
+    DataType.s4, DataType.s4, DataType.s32,           \
+    OpcodeClass.TensorOp,                             \
+    MathOperation.multiply_add_saturate)
+
+  tile_descriptions = [
+    TileDescription([128, 32, 64], 2, [2, 1, 1], math_inst, min_cc, max_cc),
+    TileDescription([128, 64, 64], 2, [2, 1, 1], math_inst, min_cc, max_cc),
+  ]
+
+  layouts = [
+    (LayoutType.TensorNHWC, LayoutType.TensorNC16HW16, LayoutType.TensorNHWC, LayoutType.TensorNHWC),
+  ]
+
+  data_type = [DataType.s4, DataType.s4, DataType.s32, DataType.s4, DataType.f32]
+
+  CreateConvolutionOperator(manifest, layouts, tile_descriptions, data_type, [16, 16, 8], \
+    SwizzlingFunctor.ConvFpropTrans, True, ImplicitGemmMode.GemmTN)
+#
+
 def GenerateSM75(manifest, args):
   GenerateSM75_TensorOp_1688(manifest, args)
   GenerateSM75_PlanarComplexTensorOp_1688(manifest, args)
@@ -1221,6 +1417,7 @@ def GenerateSM75(manifest, args):
   GenerateSM75_TensorOp_8832_TN(manifest, args)
   GenerateSM75_TensorOp_8832_Interleaved(manifest, args)
   GenerateSM75_TensorOp_88128(manifest, args)
+  GenerateSM75_TensorOp_Convolution(manifest, args)
   #GenerateSM75_WmmaTensorOp_161616(manifest, args)
   GenerateSM75_Simt_complex(manifest, args)
 
@@ -1295,6 +1492,9 @@ def GenerateSM80_TensorOp_16816(manifest, args):
     CreateGemmOperator(manifest, layouts, tile_descriptions, \
       data_type, alignment_constraints)
 
+    CreateGemmGroupedOperator(manifest, layouts, tile_descriptions, \
+      data_type, alignment_constraints)
+
     conv_layout = (LayoutType.TensorNHWC, LayoutType.TensorNHWC, LayoutType.TensorNHWC)
     CreateConv2dOperator(manifest, conv_layout, tile_descriptions, data_type, 8)
     CreateConv3dOperator(manifest, LayoutType.TensorNDHWC, tile_descriptions, data_type, 8)
@@ -2456,9 +2656,20 @@ if __name__ == "__main__":
   parser.add_argument('--kernel-filter-file',   type=str, default=None, required=False, help='Full path of filter file')
   parser.add_argument('--selected-kernel-list',   type=str, default=None, required=False,
                         help='Specify the output log file containing all enabled kernels in this build')
+  parser.add_argument('--workload-file', type=str, default='', required=False,
+                        help='CSV trace of problems (see workload.py). Only kernels ranked in the top-k for some problem are emitted.')
+  parser.add_argument('--workload-top-k', type=int, default=2, help='Kernels retained per problem of the workload trace')
+  parser.add_argument('--workload-sm-count', type=int, default=0,
+                        help='SM count of the device modeled for the workload trace (default: by architecture)')
+  parser.add_argument('--compilation-unit-cost', type=float, default=0,
+                        help='Estimated cost of each compilation unit, in kernels. Configurations are grouped into units of about this cost (default: one unit per configuration)')
 
   args = parser.parse_args()
 
+  # rank all tile sizes and alignments against the workload unless kernels are filtered by name
+  if args.workload_file != '' and args.kernels == '':
+    args.kernels = 'all'
+
   manifest = Manifest(args)
 
   GenerateSM50(manifest, args)
@@ -2467,6 +2678,11 @@ if __name__ == "__main__":
   GenerateSM70(manifest, args)
   GenerateSM75(manifest, args)
   GenerateSM80(manifest, args)
+
+  if args.workload_file != '':
+    workload = Workload(args.workload_file, manifest.compute_capabilities, args.workload_top_k, args.workload_sm_count)
+    manifest.select_for_workload(workload, os.path.join(args.curr_build_dir, 'workload_coverage.csv'))
+
   if 'library' in args.generator_target.split(','):
     manifest.emit(GeneratorTarget.Library)
 
@@ -4,6 +4,8 @@
 # \brief Generates the CUTLASS Library's instances
 #
 
+import hashlib
+import os.path
 import re
 
 ###################################################################################################
@@ -152,6 +154,41 @@ DataTypeTag = {
   DataType.cs64: "cutlass::complex<cutlass::int64_t>",
 }
 
+# Enumerants of cutlass::library::NumericTypeID
+DataTypeLibraryTag = {
+  DataType.b1: "NumericTypeID::kB1",
+  DataType.u4: "NumericTypeID::kU4",
+  DataType.u8: "NumericTypeID::kU8",
+  DataType.u16: "NumericTypeID::kU16",
+  DataType.u32: "NumericTypeID::kU32",
+  DataType.u64: "NumericTypeID::kU64",
+  DataType.s4: "NumericTypeID::kS4",
+  DataType.s8: "NumericTypeID::kS8",
+  DataType.s16: "NumericTypeID::kS16",
+  DataType.s32: "NumericTypeID::kS32",
+  DataType.s64: "NumericTypeID::kS64",
+  DataType.f16: "NumericTypeID::kF16",
+  DataType.bf16: "NumericTypeID::kBF16",
+  DataType.f32: "NumericTypeID::kF32",
+  DataType.tf32: "NumericTypeID::kTF32",
+  DataType.f64: "NumericTypeID::kF64",
+  DataType.cf16: "NumericTypeID::kCF16",
+  DataType.cbf16: "NumericTypeID::kCBF16",
+  DataType.cf32: "NumericTypeID::kCF32",
+  DataType.ctf32: "NumericTypeID::kCTF32",
+  DataType.cf64: "NumericTypeID::kCF64",
+  DataType.cu4: "NumericTypeID::kCU4",
+  DataType.cu8: "NumericTypeID::kCU8",
+  DataType.cu16: "NumericTypeID::kCU16",
+  DataType.cu32: "NumericTypeID::kCU32",
+  DataType.cu64: "NumericTypeID::kCU64",
+  DataType.cs4: "NumericTypeID::kCS4",
+  DataType.cs8: "NumericTypeID::kCS8",
+  DataType.cs16: "NumericTypeID::kCS16",
+  DataType.cs32: "NumericTypeID::kCS32",
+  DataType.cs64: "NumericTypeID::kCS64",
+}
+
 DataTypeSize = {
   DataType.b1: 1,
   DataType.u4: 4,
@@ -199,6 +236,12 @@ ComplexTransformTag = {
   ComplexTransform.conj: 'cutlass::ComplexTransform::kConjugate',
 }
 
+# Enumerants of cutlass::library::ComplexTransform
+ComplexTransformLibraryTag = {
+  ComplexTransform.none: 'ComplexTransform::kNone',
+  ComplexTransform.conj: 'ComplexTransform::kConjugate',
+}
+
 #
 RealComplexBijection = [
   (DataType.f16, DataType.cf16),
@@ -275,6 +318,10 @@ class LayoutType(enum.Enum):
   TensorNC64HW64 = enum_auto()
   TensorC32RSK32 = enum_auto()
   TensorC64RSK64 = enum_auto()
+  TensorNC4HW4 = enum_auto()
+  TensorC4RSK4 = enum_auto()
+  TensorNC8HW8 = enum_auto()
+  TensorNC16HW16 = enum_auto()
 
 #
 LayoutTag = {
@@ -294,6 +341,34 @@ LayoutTag = {
   LayoutType.TensorC32RSK32: 'cutlass::layout::TensorCxRSKx<32>',
   LayoutType.TensorNC64HW64: 'cutlass::layout::TensorNCxHWx<64>',
   LayoutType.TensorC64RSK64: 'cutlass::layout::TensorCxRSKx<64>',
+  LayoutType.TensorNC4HW4: 'cutlass::layout::TensorNCxHWx<4>',
+  LayoutType.TensorC4RSK4: 'cutlass::layout::TensorCxRSKx<4>',
+  LayoutType.TensorNC8HW8: 'cutlass::layout::TensorNCxHWx<8>',
+  LayoutType.TensorNC16HW16: 'cutlass::layout::TensorNCxHWx<16>',
+}
+
+# Enumerants of cutlass::library::LayoutTypeID
+LayoutLibraryTag = {
+  LayoutType.ColumnMajor: 'LayoutTypeID::kColumnMajor',
+  LayoutType.RowMajor: 'LayoutTypeID::kRowMajor',
+  LayoutType.ColumnMajorInterleaved2: 'LayoutTypeID::kColumnMajorInterleavedK2',
+  LayoutType.RowMajorInterleaved2: 'LayoutTypeID::kRowMajorInterleavedK2',
+  LayoutType.ColumnMajorInterleaved32: 'LayoutTypeID::kColumnMajorInterleavedK32',
+  LayoutType.RowMajorInterleaved32: 'LayoutTypeID::kRowMajorInterleavedK32',
+  LayoutType.ColumnMajorInterleaved64: 'LayoutTypeID::kColumnMajorInterleavedK64',
+  LayoutType.RowMajorInterleaved64: 'LayoutTypeID::kRowMajorInterleavedK64',
+  LayoutType.TensorNHWC: 'LayoutTypeID::kTensorNHWC',
+  LayoutType.TensorNDHWC: 'LayoutTypeID::kTensorNDHWC',
+  LayoutType.TensorNCHW: 'LayoutTypeID::kTensorNCHW',
+  LayoutType.TensorNGHWC: 'LayoutTypeID::kUnknown',
+  LayoutType.TensorNC32HW32: 'LayoutTypeID::kTensorNC32HW32',
+  LayoutType.TensorC32RSK32: 'LayoutTypeID::kTensorC32RSK32',
+  LayoutType.TensorNC64HW64: 'LayoutTypeID::kTensorNC64HW64',
+  LayoutType.TensorC64RSK64: 'LayoutTypeID::kTensorC64RSK64',
+  LayoutType.TensorNC4HW4: 'LayoutTypeID::kTensorNC4HW4',
+  LayoutType.TensorC4RSK4: 'LayoutTypeID::kTensorC4RSK4',
+  LayoutType.TensorNC8HW8: 'LayoutTypeID::kTensorNC8HW8',
+  LayoutType.TensorNC16HW16: 'LayoutTypeID::kTensorNC16HW16',
 }
 
 #
@@ -326,7 +401,11 @@ ShortLayoutTypeNames = {
   LayoutType.TensorNC32HW32: 'nc32hw32',
   LayoutType.TensorNC64HW64: 'nc64hw64',
   LayoutType.TensorC32RSK32: 'c32rsk32',
-  LayoutType.TensorC64RSK64: 'c64rsk64'
+  LayoutType.TensorC64RSK64: 'c64rsk64',
+  LayoutType.TensorNC4HW4: 'nc4hw4',
+  LayoutType.TensorC4RSK4: 'c4rsk4',
+  LayoutType.TensorNC8HW8: 'nc8hw8',
+  LayoutType.TensorNC16HW16: 'nc16hw16'
 }
 
 #
@@ -363,12 +442,14 @@ class OperationKind(enum.Enum):
   Gemm = enum_auto()
   Conv2d = enum_auto()        
   Conv3d = enum_auto()        
+  Convolution = enum_auto()
 
 #
 OperationKindNames = {
   OperationKind.Gemm: 'gemm'
   , OperationKind.Conv2d: 'conv2d'  
   , OperationKind.Conv3d: 'conv3d' 
+  , OperationKind.Convolution: 'convolution'
 }
 
 # 
@@ -400,6 +481,33 @@ def SubstituteTemplate(template, values):
       text = newtext
   return text
 
+#
+# Number of generated files written and left untouched by WriteIfChanged()
+#
+EmitStatistics = {'written': 0, 'unchanged': 0}
+
+#
+def ContentHash(text):
+  return hashlib.sha256(text.encode('utf-8')).hexdigest()
+
+#
+def WriteIfChanged(path, text):
+  ''' 
+    Writes a generated file unless it already holds the same content. Unchanged files keep their
+    timestamp, so build systems do not recompile them. Returns true if the file was written.
+  '''
+  if os.path.isfile(path):
+    with open(path, 'r') as existing_file:
+      if ContentHash(existing_file.read()) == ContentHash(text):
+        EmitStatistics['unchanged'] += 1
+        return False
+
+  with open(path, 'w') as generated_file:
+    generated_file.write(text)
+
+  EmitStatistics['written'] += 1
+  return True
+
 ###################################################################################################
 
 #
@@ -409,6 +517,7 @@ class GemmKind(enum.Enum):
   Universal = enum_auto()
   PlanarComplex = enum_auto()
   PlanarComplexArray = enum_auto()
+  Grouped = enum_auto()
 
 #
 GemmKindNames = {
@@ -417,17 +526,50 @@ GemmKindNames = {
   GemmKind.Universal: "gemm",
   GemmKind.PlanarComplex: "gemm_planar_complex",
   GemmKind.PlanarComplexArray: "gemm_planar_complex_array",
+  GemmKind.Grouped: "gemm_grouped",
+}
+
+# Enumerants of cutlass::library::GemmKind
+GemmKindLibraryTag = {
+  GemmKind.Gemm: "GemmKind::kGemm",
+  GemmKind.Sparse: "GemmKind::kSparse",
+  GemmKind.Universal: "GemmKind::kUniversal",
+  GemmKind.PlanarComplex: "GemmKind::kPlanarComplex",
+  GemmKind.PlanarComplexArray: "GemmKind::kPlanarComplexArray",
+  GemmKind.Grouped: "GemmKind::kGrouped",
 }
 
 #
 class EpilogueFunctor(enum.Enum):
   LinearCombination = enum_auto()
   LinearCombinationClamp = enum_auto()
+  BiasAddLinearCombination = enum_auto()
+  BiasAddLinearCombinationClamp = enum_auto()
+  BiasAddLinearCombinationRelu = enum_auto()
+  BiasAddLinearCombinationReluClamp = enum_auto()
+  BiasAddLinearCombinationHSwish = enum_auto()
+  BiasAddLinearCombinationHSwishClamp = enum_auto()
 
 #
 EpilogueFunctorTag = {
   EpilogueFunctor.LinearCombination: 'cutlass::epilogue::thread::LinearCombination',
   EpilogueFunctor.LinearCombinationClamp: 'cutlass::epilogue::thread::LinearCombinationClamp',
+  EpilogueFunctor.BiasAddLinearCombination: 'cutlass::epilogue::thread::BiasAddLinearCombination',
+  EpilogueFunctor.BiasAddLinearCombinationClamp: 'cutlass::epilogue::thread::BiasAddLinearCombinationClamp',
+  EpilogueFunctor.BiasAddLinearCombinationRelu: 'cutlass::epilogue::thread::BiasAddLinearCombinationRelu',
+  EpilogueFunctor.BiasAddLinearCombinationReluClamp: 'cutlass::epilogue::thread::BiasAddLinearCombinationReluClamp',
+  EpilogueFunctor.BiasAddLinearCombinationHSwish: 'cutlass::epilogue::thread::BiasAddLinearCombinationHSwish',
+  EpilogueFunctor.BiasAddLinearCombinationHSwishClamp: 'cutlass::epilogue::thread::BiasAddLinearCombinationHSwishClamp',
+}
+
+#
+ShortEpilogueNames = {
+  EpilogueFunctor.BiasAddLinearCombination: 'id',
+  EpilogueFunctor.BiasAddLinearCombinationClamp: 'id_clamp',
+  EpilogueFunctor.BiasAddLinearCombinationRelu: 'relu',
+  EpilogueFunctor.BiasAddLinearCombinationReluClamp: 'relu_clamp',
+  EpilogueFunctor.BiasAddLinearCombinationHSwish: 'hswish',
+  EpilogueFunctor.BiasAddLinearCombinationHSwishClamp: 'hswish_clamp',
 }
 
 #
@@ -436,6 +578,9 @@ class SwizzlingFunctor(enum.Enum):
   Identity2 = enum_auto()
   Identity4 = enum_auto()
   Identity8 = enum_auto()
+  ConvFpropNCxHWx = enum_auto()
+  ConvFpropCxRSKx = enum_auto()
+  ConvFpropTrans = enum_auto()
 
 #
 SwizzlingFunctorTag = {
@@ -443,6 +588,9 @@ SwizzlingFunctorTag = {
   SwizzlingFunctor.Identity2: 'cutlass::gemm::threadblock::GemmIdentityThreadblockSwizzle<2>',
   SwizzlingFunctor.Identity4: 'cutlass::gemm::threadblock::GemmIdentityThreadblockSwizzle<4>',
   SwizzlingFunctor.Identity8: 'cutlass::gemm::threadblock::GemmIdentityThreadblockSwizzle<8>',
+  SwizzlingFunctor.ConvFpropNCxHWx: 'cutlass::conv::threadblock::ConvolutionFpropNCxHWxThreadblockSwizzle',
+  SwizzlingFunctor.ConvFpropCxRSKx: 'cutlass::conv::threadblock::ConvolutionFpropCxRSKxThreadblockSwizzle',
+  SwizzlingFunctor.ConvFpropTrans: 'cutlass::conv::threadblock::ConvolutionFpropTransThreadblockSwizzle',
 }
 
 ###################################################################################################
@@ -460,12 +608,45 @@ ConvKindTag = {
   ConvKind.Wgrad: 'cutlass::conv::Operator::kWgrad'
 }
 
+# Enumerants of cutlass::library::ConvKind
+ConvKindLibraryTag = {
+  ConvKind.Fprop: 'ConvKind::kFprop',
+  ConvKind.Dgrad: 'ConvKind::kDgrad',
+  ConvKind.Wgrad: 'ConvKind::kWgrad'
+}
+
 ConvKindNames = {
   ConvKind.Fprop: 'fprop',
   ConvKind.Dgrad: 'dgrad',
   ConvKind.Wgrad: 'wgrad',
 }
 
+#
+class ConvType(enum.Enum):
+  Convolution = enum_auto()
+  BatchConvolution = enum_auto()
+  Local = enum_auto()
+  LocalShare = enum_auto()
+
+#
+ConvTypeTag = {
+  ConvType.Convolution: 'cutlass::conv::ConvType::kConvolution',
+  ConvType.BatchConvolution: 'cutlass::conv::ConvType::kBatchConvolution',
+  ConvType.Local: 'cutlass::conv::ConvType::kLocal',
+  ConvType.LocalShare: 'cutlass::conv::ConvType::kLocalShare',
+}
+
+#
+class ImplicitGemmMode(enum.Enum):
+  GemmNT = enum_auto()
+  GemmTN = enum_auto()
+
+#
+ImplicitGemmModeTag = {
+  ImplicitGemmMode.GemmNT: 'cutlass::conv::ImplicitGemmMode::GEMM_NT',
+  ImplicitGemmMode.GemmTN: 'cutlass::conv::ImplicitGemmMode::GEMM_TN',
+}
+
 #
 class IteratorAlgorithm(enum.Enum):
   Analytic = enum_auto()
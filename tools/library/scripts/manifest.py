@@ -5,13 +5,111 @@
 #
 
 import enum
+import io
+import json
+import math
+import os
 import os.path
 import shutil
+import zlib
 
 from library import *
 from gemm_operation import *
 from conv2d_operation import *  
 from conv3d_operation import *  
+from convolution_operation import *
+
+###################################################################################################
+
+#
+def ManifestEntryValues(operation):
+  ''' Fields of the cutlass::library::ManifestEntry describing an operation '''
+
+  if operation.operation_kind == OperationKind.Gemm:
+    operation_kind = 'OperationKind::kSparseGemm' if operation.gemm_kind == GemmKind.Sparse else 'OperationKind::kGemm'
+    gemm_kind = GemmKindLibraryTag[operation.gemm_kind]
+    conv_kind = 'ConvKind::kInvalid'
+  else:
+    operation_kind = {
+      OperationKind.Conv2d: 'OperationKind::kConv2d',
+      OperationKind.Conv3d: 'OperationKind::kConv3d',
+      OperationKind.Convolution: 'OperationKind::kConvolution',
+    }[operation.operation_kind]
+    gemm_kind = 'GemmKind::kInvalid'
+    conv_kind = ConvKindLibraryTag[operation.conv_kind]
+
+  return {
+    'operation_kind': operation_kind,
+    'gemm_kind': gemm_kind,
+    'conv_kind': conv_kind,
+    'element_accumulator': DataTypeLibraryTag[operation.accumulator_type()],
+    'element_epilogue': DataTypeLibraryTag[operation.element_epilogue],
+    'element_a': DataTypeLibraryTag[operation.A.element],
+    'layout_a': LayoutLibraryTag[operation.A.layout],
+    'transform_a': ComplexTransformLibraryTag[operation.A.complex_transform],
+    'element_b': DataTypeLibraryTag[operation.B.element],
+    'layout_b': LayoutLibraryTag[operation.B.layout],
+    'transform_b': ComplexTransformLibraryTag[operation.B.complex_transform],
+    'element_c': DataTypeLibraryTag[operation.C.element],
+    'layout_c': LayoutLibraryTag[operation.C.layout],
+    'minimum_compute_capability': str(operation.tile_description.minimum_compute_capability),
+    'maximum_compute_capability': str(operation.tile_description.maximum_compute_capability),
+  }
+
+#
+def EstimatedCompileCost(operation):
+  ''' 
+    Relative cost of compiling an operation, about 1 for a typical GEMM. The mainloop is fully
+    unrolled, so compile time grows with the math instructions a thread issues per iteration. 
+  '''
+  tile = operation.tile_description
+  math_instruction = tile.math_instruction
+  warp_shape = [tile.threadblock_shape[idx] // tile.warp_count[idx] for idx in range(3)]
+
+  instructions = 1
+  for idx in range(3):
+    instructions *= max(1, warp_shape[idx] // math_instruction.instruction_shape[idx])
+
+  # SIMT instructions are issued per thread
+  if math_instruction.opcode_class == OpcodeClass.Simt:
+    instructions = max(1, instructions // 32)
+
+  cost = 0.5 + math.sqrt(instructions) / 16.0
+
+  # implicit GEMM iterators are considerably heavier to instantiate
+  if operation.operation_kind != OperationKind.Gemm:
+    cost *= 1.5
+
+  return cost
+
+#
+def ShardConfigurations(configurations, target_cost):
+  ''' 
+    Groups configurations into compilation units of about target_cost. Unit boundaries are chosen
+    by the hash of configuration names, so adding or removing a configuration only changes the
+    units around it.
+  '''
+  units = []
+  unit = []
+  unit_cost = 0.0
+  period = max(1, int(target_cost / 2))
+
+  for configuration in sorted(configurations, key = lambda configuration: configuration['name']):
+    unit.append(configuration)
+    unit_cost += configuration['estimated_cost']
+
+    boundary = unit_cost >= 2 * target_cost or (unit_cost >= target_cost / 2 and \
+      zlib.crc32(configuration['name'].encode('utf-8')) % period == 0)
+
+    if boundary:
+      units.append(unit)
+      unit = []
+      unit_cost = 0.0
+
+  if len(unit):
+    units.append(unit)
+
+  return units
 
 ###################################################################################################
 
@@ -25,9 +123,15 @@ class EmitOperationKindLibrary:
       OperationKind.Gemm: EmitGemmConfigurationLibrary
       , OperationKind.Conv2d: EmitConv2dConfigurationLibrary  
       , OperationKind.Conv3d: EmitConv3dConfigurationLibrary  
+      , OperationKind.Convolution: EmitConvolutionConfigurationLibrary
     }
 
     self.configurations = [];
+    self.entries = [];
+    self.compilation_units = [];
+
+    # compilation units are not used unless a target cost is given
+    self.compilation_unit_cost = getattr(args, 'compilation_unit_cost', 0)
 
     self.header_template ="""
 /*
@@ -44,18 +148,36 @@ namespace library {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 """
-    self.entry_template = """
+    self.entry_table_template = """
 
 //
-// Entry point to construct operations
+// Descriptors of all operations, each constructed by its initializer on demand
+//
+static ManifestEntry const k_${operation_name}_manifest_entries[] = {
+"""
+    self.entry_template = """};
+
+//
+// Entry point to register operations
 //
 void initialize_all_${operation_name}_operations(Manifest &manifest) {
+  manifest.append(k_${operation_name}_manifest_entries,
+    sizeof(k_${operation_name}_manifest_entries) / sizeof(ManifestEntry));
 """
     self.configuration_prototype_template = "void initialize_${configuration_name}(Manifest &manifest);\n"
-    self.configuration_template ="  initialize_${configuration_name}(manifest);\n"
+    self.configuration_template ="""  {
+    "${configuration_name}",
+    Provider::kCUTLASS, ${operation_kind}, ${gemm_kind}, ${conv_kind},
+    ${element_accumulator}, ${element_epilogue},
+    ${element_a}, ${layout_a}, ${transform_a},
+    ${element_b}, ${layout_b}, ${transform_b},
+    ${element_c}, ${layout_c},
+    ${minimum_compute_capability}, ${maximum_compute_capability},
+    initialize_${configuration_name}
+  },
+"""
 
     self.epilogue_template ="""
-
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -64,15 +186,22 @@ void initialize_all_${operation_name}_operations(Manifest &manifest) {
 } // namespace cutlass
 
 """
+    self.unit_header_template ="""
+/*
+ Generated by manifest.py - Do not edit.
+*/
+
+"""
+    self.unit_include_template = "#include \"${configuration_file}\"\n"
 
   #
   def __enter__(self):
     self.operation_path = os.path.join(self.generated_path, OperationKindNames[self.kind])
-    os.mkdir(self.operation_path)
+    os.makedirs(self.operation_path, exist_ok = True)
 
     self.top_level_path = os.path.join(self.operation_path, "all_%s_operations.cu" % OperationKindNames[self.kind])
 
-    self.top_level_file = open(self.top_level_path, "w")
+    self.top_level_file = io.StringIO()
     self.top_level_file.write(self.header_template)
 
     self.source_files = [self.top_level_path,]
@@ -85,21 +214,65 @@ void initialize_all_${operation_name}_operations(Manifest &manifest) {
     with self.emitters[self.kind](self.operation_path, configuration_name) as configuration_emitter:
       for operation in operations:
         configuration_emitter.emit(operation)
-      
-      self.source_files.append(configuration_emitter.configuration_path)
 
-    self.configurations.append(configuration_name)
+    configuration_path = configuration_emitter.configuration_path
+
+    # a configuration's initializer constructs all of its operations, so they must share one entry
+    entries = [ManifestEntryValues(operation) for operation in operations]
+    if any(entry != entries[0] for entry in entries):
+      raise Exception("Operations of configuration %s are not functionally equivalent" % configuration_name)
+
+    entry = entries[0]
+    entry['configuration_name'] = configuration_name
+
+    self.configurations.append({
+      'name': configuration_name,
+      'path': configuration_path,
+      'operations': [operation.procedural_name() for operation in operations],
+      'estimated_cost': sum([EstimatedCompileCost(operation) for operation in operations]),
+      'content_hash': ContentHash(configuration_emitter.configuration_file.getvalue())
+    })
+    self.entries.append(entry)
     self.top_level_file.write(SubstituteTemplate(self.configuration_prototype_template, {'configuration_name': configuration_name} ))
 
   #
   def __exit__(self, exception_type, exception_value, traceback):
-    self.top_level_file.write(SubstituteTemplate(self.entry_template, {'operation_name': OperationKindNames[self.kind]}))
+    self.top_level_file.write(SubstituteTemplate(self.entry_table_template, {'operation_name': OperationKindNames[self.kind]}))
 
-    for configuration_name in self.configurations:
-      self.top_level_file.write(SubstituteTemplate(self.configuration_template, {'configuration_name': configuration_name}))
+    for entry in self.entries:
+      self.top_level_file.write(SubstituteTemplate(self.configuration_template, entry))
+
+    self.top_level_file.write(SubstituteTemplate(self.entry_template, {'operation_name': OperationKindNames[self.kind]}))
 
     self.top_level_file.write(self.epilogue_template)
-    self.top_level_file.close()
+    WriteIfChanged(self.top_level_path, self.top_level_file.getvalue())
+
+    if self.compilation_unit_cost > 0:
+      self.emit_compilation_units_()
+    else:
+      for configuration in self.configurations:
+        self.compilation_units.append({'path': configuration['path'], 'configurations': [configuration,]})
+
+    self.source_files += [unit['path'] for unit in self.compilation_units]
+    self.emitted_files = self.source_files + [configuration['path'] for configuration in self.configurations]
+
+  #
+  def emit_compilation_units_(self):
+    ''' Emits compilation units, each including several configurations '''
+
+    for configurations in ShardConfigurations(self.configurations, self.compilation_unit_cost):
+
+      # a unit is named after its first configuration, which is stable across regenerations
+      unit_path = os.path.join(self.operation_path, "%s_unit_%08x.cu" % (OperationKindNames[self.kind],
+        zlib.crc32(configurations[0]['name'].encode('utf-8')) & 0xffffffff))
+
+      unit_text = self.unit_header_template
+      for configuration in configurations:
+        unit_text += SubstituteTemplate(self.unit_include_template,
+          {'configuration_file': os.path.basename(configuration['path'])})
+
+      WriteIfChanged(unit_path, unit_text)
+      self.compilation_units.append({'path': unit_path, 'configurations': configurations})
 
 ###################################################################################################
 ###################################################################################################
@@ -131,6 +304,7 @@ class Manifest:
         OperationKind.Gemm
         , OperationKind.Conv2d    
         , OperationKind.Conv3d    
+        , OperationKind.Convolution
       ] 
 
       self.operations_enabled = [x for x in operations_list if OperationKindNames[x] in args.operations.split(',')]
@@ -282,6 +456,87 @@ void initialize_all(Manifest &manifest) {
       self.operation_count += 1
   #
 
+  #
+  def select_for_workload(self, workload, report_path = None):
+    ''' 
+      Retains only the operations an offline model ranks in the top-k for some problem of the
+      workload. Optionally writes a report of the workload's expected coverage.
+    '''
+
+    operations = list(self.operations_by_name.values())
+
+    selected, rankings = workload.select(operations)
+
+    if report_path is not None:
+      workload.write_report(report_path, len(operations), selected, rankings)
+
+    for operation_kind in list(self.operations.keys()):
+      configurations = self.operations[operation_kind]
+
+      for configuration_name in list(configurations.keys()):
+        configurations[configuration_name] = [op for op in configurations[configuration_name] \
+          if op.procedural_name() in selected]
+
+        if not len(configurations[configuration_name]):
+          del configurations[configuration_name]
+
+      if not len(configurations):
+        del self.operations[operation_kind]
+
+    self.selected_kernels = [x for x in self.selected_kernels if x in selected]
+    self.operations_by_name = {k: v for k, v in self.operations_by_name.items() if k in selected}
+    self.operation_count = len(self.operations_by_name)
+  #
+
+  #
+  def emit_json_(self, generated_path, compilation_units):
+    ''' Describes each compilation unit and the configurations and operations it contains '''
+
+    def relative_path(path):
+      return os.path.relpath(path, generated_path).replace('\\', '/')
+
+    units = []
+    for unit in compilation_units:
+      configurations = [{
+          'name': configuration['name'],
+          'path': relative_path(configuration['path']),
+          'operations': configuration['operations'],
+          'estimated_cost': round(configuration['estimated_cost'], 3),
+          'content_hash': configuration['content_hash'],
+        } for configuration in unit['configurations']]
+
+      units.append({
+        'path': relative_path(unit['path']),
+        'operation_kind': unit['operation_kind'],
+        'estimated_cost': round(sum([configuration['estimated_cost'] for configuration in unit['configurations']]), 3),
+        'configurations': configurations,
+      })
+
+    manifest = {
+      'operation_count': self.operation_count,
+      'configuration_count': sum([len(unit['configurations']) for unit in units]),
+      'compilation_unit_cost': getattr(self.args, 'compilation_unit_cost', 0),
+      'estimated_cost': round(sum([unit['estimated_cost'] for unit in units]), 3),
+      'compilation_units': units,
+    }
+
+    return json.dumps(manifest, sort_keys = True, indent = 2) + "\n"
+
+  #
+  def remove_stale_files_(self, generated_path, emitted_files):
+    ''' Removes files left in generated/ by earlier runs with different kernel selections '''
+
+    emitted_files = set([os.path.abspath(path) for path in emitted_files])
+
+    for directory, subdirectories, files in os.walk(generated_path, topdown = False):
+      for file_name in files:
+        path = os.path.abspath(os.path.join(directory, file_name))
+        if path not in emitted_files:
+          os.remove(path)
+
+      if directory != generated_path and not os.listdir(directory):
+        os.rmdir(directory)
+
   #
   def emit(self, target = GeneratorTarget.Library):
 
@@ -291,64 +546,84 @@ void initialize_all(Manifest &manifest) {
 
     generated_path = os.path.join(self.args.curr_build_dir, 'generated')
 
-    # create generated/
-    if os.path.exists(generated_path):
-      shutil.rmtree(generated_path)
-
-    os.mkdir(generated_path)
+    # create generated/ if needed; files whose content is unchanged are left untouched
+    os.makedirs(generated_path, exist_ok = True)
 
     source_files = []
+    emitted_files = []
+    compilation_units = []
 
     top_level_path = os.path.join(generated_path, 'initialize_all.cpp')
-    with open(top_level_path, 'w') as top_level_file:
+    top_level_file = io.StringIO()
 
-      if target == GeneratorTarget.Library:
-        source_files.append(top_level_path)
+    if target == GeneratorTarget.Library:
+      source_files.append(top_level_path)
 
-      prototypes = []
-      for operation_kind, configurations in self.operations.items():
-        prototypes.append(SubstituteTemplate(
-          "void initialize_all_${operation_kind}_operations(Manifest &manifest);",
-          {'operation_kind': OperationKindNames[operation_kind]}))
+    prototypes = []
+    for operation_kind, configurations in self.operations.items():
+      prototypes.append(SubstituteTemplate(
+        "void initialize_all_${operation_kind}_operations(Manifest &manifest);",
+        {'operation_kind': OperationKindNames[operation_kind]}))
 
-      top_level_file.write(SubstituteTemplate(self.top_level_prologue,
-        {'prototypes': "\n".join(prototypes)}))
+    top_level_file.write(SubstituteTemplate(self.top_level_prologue,
+      {'prototypes': "\n".join(prototypes)}))
 
-      top_level_file.write(SubstituteTemplate(
-        self.top_level_reserve, {'operation_count': str(self.operation_count)}))
+    top_level_file.write(SubstituteTemplate(
+      self.top_level_reserve, {'operation_count': str(self.operation_count)}))
 
-      # for each operation kind, emit initializer for all configurations
-      for operation_kind, configurations in self.operations.items():
-        
-        with operation_emitters[target](generated_path, operation_kind, self.args) as operation_kind_emitter:
-          for configuration_name, operations in configurations.items():
-            operation_kind_emitter.emit(configuration_name, operations)
+    # for each operation kind, emit initializer for all configurations
+    for operation_kind, configurations in self.operations.items():
+      
+      with operation_emitters[target](generated_path, operation_kind, self.args) as operation_kind_emitter:
+        for configuration_name, operations in configurations.items():
+          operation_kind_emitter.emit(configuration_name, operations)
 
-          source_files += operation_kind_emitter.source_files
+      source_files += operation_kind_emitter.source_files
+      emitted_files += operation_kind_emitter.emitted_files
 
-        top_level_file.write(SubstituteTemplate(
-          "  initialize_all_${operation_kind}_operations(manifest);\n",
-          {'operation_kind': OperationKindNames[operation_kind]}))
+      for unit in operation_kind_emitter.compilation_units:
+        unit['operation_kind'] = OperationKindNames[operation_kind]
+        compilation_units.append(unit)
 
-      top_level_file.write(self.top_level_epilogue)
+      top_level_file.write(SubstituteTemplate(
+        "  initialize_all_${operation_kind}_operations(manifest);\n",
+        {'operation_kind': OperationKindNames[operation_kind]}))
+
+    top_level_file.write(self.top_level_epilogue)
+    WriteIfChanged(top_level_path, top_level_file.getvalue())
 
     # write the manifest.cmake file containing paths from all targets
     manifest_path = os.path.join(generated_path, "manifest.cmake")
-    with open(manifest_path, "w") as manifest_file:
+    manifest_file = io.StringIO()
+
+    target_name = 'cutlass_library_objs'
 
-      target_name = 'cutlass_library_objs'
+    # compilation units are already balanced, so CMake must not batch them again
+    sharded = getattr(self.args, 'compilation_unit_cost', 0) > 0
 
-      target_text = SubstituteTemplate("""cutlass_target_sources(
+    target_text = SubstituteTemplate("""cutlass_target_sources(
   ${target_name}
-  BATCH_SOURCES ON
+  BATCH_SOURCES ${batch_sources}
   PRIVATE
-""", { 'target_name': target_name})
+""", { 'target_name': target_name, 'batch_sources': 'OFF' if sharded else 'ON'})
+
+    manifest_file.write(target_text)
+
+    for source_file in source_files:
+      manifest_file.write("    %s\n" % str(source_file.replace('\\', '/')))
+    manifest_file.write(")")
+
+    WriteIfChanged(manifest_path, manifest_file.getvalue())
+
+    # write the manifest.json file describing compilation units
+    json_path = os.path.join(generated_path, "manifest.json")
+    WriteIfChanged(json_path, self.emit_json_(generated_path, compilation_units))
 
-      manifest_file.write(target_text)
+    emitted_files += [top_level_path, manifest_path, json_path]
+    self.remove_stale_files_(generated_path, emitted_files)
 
-      for source_file in source_files:
-        manifest_file.write("    %s\n" % str(source_file.replace('\\', '/')))
-      manifest_file.write(")")
+    print("Generated %d files: %d written, %d unchanged" % (
+      EmitStatistics['written'] + EmitStatistics['unchanged'], EmitStatistics['written'], EmitStatistics['unchanged']))
   #
 
 ###################################################################################################
@@ -0,0 +1,379 @@
+#
+# \file workload.py
+#
+# \brief Selects the CUTLASS Library's instances needed by a workload trace
+#
+
+import csv
+import math
+
+from library import *
+
+###################################################################################################
+#
+# A workload trace is a CSV file whose first non-comment row names the columns. Rows describe
+# problems as they are issued by an application. Columns not relevant to a row are left empty.
+#
+#   operation             gemm, conv2d, or conv3d
+#   frequency             relative weight of the problem (default: 1)
+#   element_a/b/c         data types (e.g. f16, f32, s8, cf32)
+#   element_accumulator   accumulator data type (default: any)
+#   element_math          data type consumed by the math instruction (default: element_a)
+#
+#   gemm:    m, n, k, layout_a, layout_b (n or t), layout_c (default: any),
+#            transform_a, transform_b (n or c, default: n), batch_count (default: 1)
+#
+#   conv:    conv_kind (fprop, dgrad, wgrad), n, h, w, c, k, r, s, pad_h, pad_w, stride_h,
+#            stride_w, dilation_h, dilation_w, and additionally d, t, pad_d, stride_d,
+#            dilation_d for conv3d. Padding defaults to 0, stride and dilation to 1.
+#
+# Example:
+#
+#   operation,frequency,element_a,element_b,element_c,element_accumulator,layout_a,layout_b,m,n,k
+#   gemm,1200,f16,f16,f16,f32,n,t,4096,1024,1024
+#
+###################################################################################################
+
+#
+# Per-SM resources of the device a workload runs on, by compute capability:
+#   (SM count, shared memory capacity in bytes, L2 bytes per clock and SM)
+#
+DeviceResources = {
+  50: (16, 64 << 10, 24),
+  60: (56, 64 << 10, 24),
+  61: (28, 96 << 10, 24),
+  70: (80, 96 << 10, 32),
+  75: (40, 64 << 10, 32),
+  80: (108, 164 << 10, 32),
+  86: (84, 100 << 10, 24),
+}
+
+#
+def DeviceResourcesFor(cc):
+  ''' Resources of the newest listed architecture not exceeding cc '''
+  eligible = [x for x in DeviceResources.keys() if x <= cc]
+  return DeviceResources[max(eligible) if len(eligible) else min(DeviceResources.keys())]
+
+#
+def MathThroughput(opcode_class, element, cc):
+  ''' Approximate multiply-accumulate operations per clock and SM '''
+
+  if opcode_class == OpcodeClass.TensorOp or opcode_class == OpcodeClass.WmmaTensorOp:
+    scale = 2 if cc >= 80 else 1
+    if element in [DataType.f16, DataType.bf16]:
+      return 512 * scale
+    if element == DataType.tf32:
+      return 512
+    if element in [DataType.s8, DataType.u8]:
+      return 1024 * scale
+    if element in [DataType.s4, DataType.u4]:
+      return 2048 * scale
+    if element == DataType.b1:
+      return 8192 * scale
+    if element == DataType.f64:
+      return 64
+    return 256
+
+  # SIMT
+  if element in [DataType.f64, DataType.cf64]:
+    return 32 if cc in [60, 70, 80] else 2
+  if element in [DataType.s8, DataType.u8]:
+    return 256
+  if element == DataType.f16:
+    return 128
+  return 64
+
+###################################################################################################
+
+#
+class WorkloadProblem:
+  def __init__(self, row, line):
+    self.line = line
+    self.values = row
+    self.operation = row['operation'].strip().lower()
+    self.frequency = float(self.get('frequency', 1))
+
+    self.element_a = self.data_type('element_a')
+    self.element_b = self.data_type('element_b')
+    self.element_c = self.data_type('element_c')
+    self.element_accumulator = self.data_type('element_accumulator', required = False)
+    self.element_math = self.data_type('element_math', required = False)
+
+    if self.operation == 'gemm':
+      self.m, self.n, self.k = [int(self.get(x)) for x in ['m', 'n', 'k']]
+      self.batch_count = int(self.get('batch_count', 1))
+      self.layout_a = self.get('layout_a').lower()
+      self.layout_b = self.get('layout_b').lower()
+      self.layout_c = self.get('layout_c', '').lower()
+      self.transform_a = self.get('transform_a', 'n').lower()
+      self.transform_b = self.get('transform_b', 'n').lower()
+    elif self.operation in ['conv2d', 'conv3d']:
+      self.conv_kind = self.get('conv_kind').lower()
+      self.layout = self.get('layout', 'nhwc' if self.operation == 'conv2d' else 'ndhwc').lower()
+
+      dims = ['h', 'w'] if self.operation == 'conv2d' else ['d', 'h', 'w']
+      filter_dims = {'d': 't', 'h': 'r', 'w': 's'}
+
+      self.n, self.c, self.k = [int(self.get(x)) for x in ['n', 'c', 'k']]
+
+      # output extent of each spatial dimension
+      self.output_extent = 1
+      self.filter_extent = 1
+      self.input_extent = 1
+      self.unity_stride = True
+
+      for dim in dims:
+        extent = int(self.get(dim))
+        filter_extent = int(self.get(filter_dims[dim]))
+        pad = int(self.get('pad_' + dim, 0))
+        stride = int(self.get('stride_' + dim, 1))
+        dilation = int(self.get('dilation_' + dim, 1))
+
+        output = (extent + 2 * pad - dilation * (filter_extent - 1) - 1) // stride + 1
+
+        self.input_extent *= extent
+        self.filter_extent *= filter_extent
+        self.output_extent *= output
+        self.unity_stride = self.unity_stride and stride == 1
+    else:
+      raise Exception("line %d: unsupported operation '%s'" % (line, self.operation))
+
+  #
+  def get(self, column, default = None):
+    value = self.values.get(column)
+    if value is None or value.strip() == '':
+      if default is None:
+        raise Exception("line %d: column '%s' is required for %s" % (self.line, column, self.operation))
+      return default
+    return value.strip()
+
+  #
+  def data_type(self, column, required = True):
+    name = self.get(column, None if required else '')
+    if name == '':
+      return None
+    for data_type, data_type_name in DataTypeNames.items():
+      if data_type_name == name.lower():
+        return data_type
+    raise Exception("line %d: unknown data type '%s'" % (self.line, name))
+
+  #
+  def implicit_gemm_extent(self):
+    ''' Problem size (M, N, K) of the GEMM computing the problem '''
+    if self.operation == 'gemm':
+      return (self.m, self.n, self.k)
+    if self.conv_kind == 'fprop':
+      return (self.n * self.output_extent, self.k, self.c * self.filter_extent)
+    if self.conv_kind == 'dgrad':
+      return (self.n * self.input_extent, self.c, self.k * self.filter_extent)
+    return (self.k, self.c * self.filter_extent, self.n * self.output_extent)
+
+  #
+  def contiguous_extents(self):
+    ''' Extents of the contiguous dimension of A, B, and C '''
+    if self.operation == 'gemm':
+      # C depends on the layout of the operation unless the trace specifies it
+      extent_c = {'n': self.m, 't': self.n}.get(self.layout_c)
+      return ({'n': self.m, 't': self.k}[self.layout_a], {'n': self.k, 't': self.n}[self.layout_b], extent_c)
+    if self.conv_kind == 'fprop':
+      return (self.c, self.c, self.k)
+    return (self.k, self.c, self.c)
+
+  #
+  def description(self):
+    if self.operation == 'gemm':
+      return "gemm %dx%dx%d %s%s" % (self.m, self.n, self.k, self.layout_a, self.layout_b)
+    return "%s %s n%d c%d k%d" % (self.operation, self.conv_kind, self.n, self.c, self.k)
+
+###################################################################################################
+
+#
+class Workload:
+  def __init__(self, path, compute_capabilities, top_k = 2, sm_count = 0):
+    self.path = path
+    self.top_k = top_k
+    self.cc = max(compute_capabilities)
+
+    sm, smem, bandwidth = DeviceResourcesFor(self.cc)
+    self.sm_count = sm_count if sm_count > 0 else sm
+    self.shared_memory = smem
+    self.bandwidth = bandwidth
+
+    self.problems = []
+
+    with open(path, 'r') as trace_file:
+      lines = [(idx + 1, line) for idx, line in enumerate(trace_file) \
+        if line.strip() != '' and not line.lstrip().startswith('#')]
+
+    reader = csv.DictReader([line for _, line in lines])
+    for (line, _), row in zip(lines[1:], reader):
+      self.problems.append(WorkloadProblem(row, line))
+
+  #
+  def matches(self, operation, problem):
+    ''' Returns true if the operation computes the problem '''
+
+    kind = OperationKindNames[operation.operation_kind]
+    if kind != problem.operation:
+      return False
+
+    math_instruction = operation.tile_description.math_instruction
+
+    if operation.A.element != problem.element_a or operation.B.element != problem.element_b or \
+      operation.C.element != problem.element_c:
+      return False
+
+    if problem.element_accumulator is not None and \
+      operation.accumulator_type() != problem.element_accumulator:
+      return False
+
+    # never trade precision for speed unless the trace asks for it
+    element_math = problem.element_math if problem.element_math is not None else problem.element_a
+    if math_instruction.element_a != element_math and \
+      not (is_complex(element_math) and math_instruction.element_a == get_real_from_complex(element_math)):
+      return False
+
+    if problem.operation == 'gemm':
+      if operation.gemm_kind != GemmKind.Universal:
+        return False
+      if ShortLayoutTypeNames[operation.A.layout] != problem.layout_a or \
+        ShortLayoutTypeNames[operation.B.layout] != problem.layout_b:
+        return False
+      if problem.layout_c != '' and ShortLayoutTypeNames[operation.C.layout] != problem.layout_c:
+        return False
+      transforms = {'n': ComplexTransform.none, 'c': ComplexTransform.conj}
+      if operation.A.complex_transform != transforms[problem.transform_a] or \
+        operation.B.complex_transform != transforms[problem.transform_b]:
+        return False
+    else:
+      if operation.conv_kind.name.lower() != problem.conv_kind:
+        return False
+      if ShortLayoutTypeNames[operation.A.layout] != problem.layout:
+        return False
+      if operation.stride_support == StrideSupport.Unity and not problem.unity_stride:
+        return False
+
+    # alignment constraints of the operands along their contiguous dimension
+    extent_a, extent_b, extent_c = problem.contiguous_extents()
+    if extent_a % operation.A.alignment or extent_b % operation.B.alignment:
+      return False
+    if extent_c is not None and extent_c % operation.C.alignment:
+      return False
+
+    if problem.operation == 'gemm' and extent_c is None:
+      extent_c = problem.m if operation.C.layout == LayoutType.ColumnMajor else problem.n
+      if extent_c % operation.C.alignment:
+        return False
+
+    return True
+
+  #
+  def estimate(self, operation, problem):
+    ''' Modeled time of the operation computing the problem (in SM clocks) '''
+
+    tile = operation.tile_description
+    math_instruction = tile.math_instruction
+    tile_m, tile_n, tile_k = tile.threadblock_shape
+
+    m, n, k = problem.implicit_gemm_extent()
+    batch_count = problem.batch_count if problem.operation == 'gemm' else 1
+
+    tiles = int(math.ceil(m / float(tile_m))) * int(math.ceil(n / float(tile_n))) * batch_count
+    k_iterations = int(math.ceil(k / float(tile_k)))
+
+    # threadblocks resident on each SM limited by shared memory and threads
+    bytes_a = DataTypeSize[operation.A.element] // 8 or 1
+    bytes_b = DataTypeSize[operation.B.element] // 8 or 1
+    shared_memory = tile.stages * tile_k * (tile_m * bytes_a + tile_n * bytes_b)
+    warps = tile.warp_count[0] * tile.warp_count[1] * tile.warp_count[2]
+
+    occupancy = max(1, min(self.shared_memory // max(1, shared_memory), 64 // max(1, warps)))
+
+    # each mainloop iteration is bound by math or by loading the operand tiles
+    # tensor core instructions of older architectures issue at their native rate
+    throughput_cc = self.cc if math_instruction.opcode_class == OpcodeClass.Simt else tile.minimum_compute_capability
+    throughput = MathThroughput(math_instruction.opcode_class, math_instruction.element_a, throughput_cc)
+    math_clocks = tile_m * tile_n * tile_k / float(throughput)
+    load_clocks = tile_k * (tile_m * bytes_a + tile_n * bytes_b) / float(self.bandwidth)
+
+    iteration_clocks = max(math_clocks, load_clocks)
+
+    # pipelining hides part of the latency of each mainloop iteration
+    if tile.stages < 3:
+      iteration_clocks *= 1.1
+
+    # resident threadblocks share the SM, so its time is proportional to the threadblocks it
+    # computes. Too few resident warps cannot hide the latency of the mainloop.
+    threadblocks_per_sm = int(math.ceil(tiles / float(self.sm_count)))
+    resident_warps = min(occupancy, threadblocks_per_sm) * warps
+    latency = max(1.0, 8.0 / resident_warps)
+
+    clocks = threadblocks_per_sm * k_iterations * iteration_clocks * latency
+
+    if problem.operation != 'gemm' and operation.iterator_algorithm == IteratorAlgorithm.Analytic:
+      clocks *= 1.1
+
+    return clocks
+
+  #
+  def efficiency(self, operation, problem, clocks):
+    ''' Fraction of the device's peak math throughput achieved by a modeled time '''
+    m, n, k = problem.implicit_gemm_extent()
+    batch_count = problem.batch_count if problem.operation == 'gemm' else 1
+    math_instruction = operation.tile_description.math_instruction
+    peak = MathThroughput(math_instruction.opcode_class, math_instruction.element_a, self.cc) * self.sm_count
+    return m * n * k * batch_count / (peak * clocks) if clocks > 0 else 0
+
+  #
+  def select(self, operations):
+    ''' Returns the names of operations ranked in the top-k for any problem, and the ranking '''
+
+    selected = set()
+    rankings = []
+
+    for problem in self.problems:
+      candidates = [op for op in operations if self.matches(op, problem)]
+
+      ranked = sorted(candidates, key = lambda op: (self.estimate(op, problem), \
+        -op.A.alignment, op.procedural_name()))
+
+      rankings.append((problem, len(candidates), ranked[:self.top_k]))
+      for op in ranked[:self.top_k]:
+        selected.add(op.procedural_name())
+
+    return selected, rankings
+
+  #
+  def write_report(self, path, total_operations, selected, rankings):
+    ''' Writes the expected coverage of the workload by the selected operations '''
+
+    total_frequency = sum(problem.frequency for problem in self.problems)
+    covered_frequency = sum(problem.frequency for problem, _, ranked in rankings if len(ranked))
+
+    with open(path, 'w') as report:
+      report.write("# Workload coverage of %s\n" % self.path)
+      report.write("# device model: cc %d, %d SMs\n" % (self.cc, self.sm_count))
+      report.write("# operations: %d of %d retained (top-%d per problem)\n" % \
+        (len(selected), total_operations, self.top_k))
+      report.write("# problems covered: %d of %d\n" % \
+        (len([x for x in rankings if len(x[2])]), len(rankings)))
+      report.write("# frequency covered: %.2f%%\n" % \
+        (100.0 * covered_frequency / total_frequency if total_frequency > 0 else 100.0))
+
+      weighted_efficiency = 0
+      for problem, _, ranked in rankings:
+        if len(ranked):
+          weighted_efficiency += problem.frequency * \
+            self.efficiency(ranked[0], problem, self.estimate(ranked[0], problem))
+      if covered_frequency > 0:
+        report.write("# modeled efficiency (frequency weighted): %.2f%%\n" % \
+          (100.0 * weighted_efficiency / covered_frequency))
+
+      report.write("line,problem,frequency,candidates,modeled_efficiency,operations\n")
+
+      for problem, candidate_count, ranked in rankings:
+        efficiency = self.efficiency(ranked[0], problem, self.estimate(ranked[0], problem)) if len(ranked) else 0
+        report.write("%d,%s,%g,%d,%.3f,%s\n" % (problem.line, problem.description(), problem.frequency, \
+          candidate_count, efficiency, ' '.join(op.procedural_name() for op in ranked) if len(ranked) else 'UNCOVERED'))
+
+###################################################################################################
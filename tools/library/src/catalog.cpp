@@ -0,0 +1,542 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+/*! \file
+    \brief Catalog of the operations contained in the CUTLASS Library
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "cutlass/library/catalog.h"
+#include "cutlass/library/util.h"
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Configurations and arguments of every kind of operation the catalog can
+/// query. Tensor pointers are null and scalars point to zero.
+struct CatalogProblem {
+    GemmConfiguration gemm_configuration;
+    GemmArguments gemm_arguments;
+
+    GemmUniversalConfiguration gemm_universal_configuration;
+    GemmUniversalArguments gemm_universal_arguments;
+
+    Conv2dConfiguration conv2d_configuration;
+    Conv3dConfiguration conv3d_configuration;
+    ConvArguments conv_arguments;
+
+    ConvolutionConfiguration convolution_configuration;
+    ConvolutionArguments convolution_arguments;
+
+    /// Storage for alpha, beta and gamma, large enough for any scalar type
+    uint64_t scalars[3][2];
+
+    explicit CatalogProblem(CatalogQuery const& query);
+
+    /// Returns the configuration of an operation, or null if its kind
+    /// cannot be queried
+    void const* configuration(OperationDescription const& desc) const;
+
+    /// Returns the arguments matching configuration()
+    void const* arguments(OperationDescription const& desc) const;
+};
+
+/// Leading dimension of a packed matrix
+int64_t packed_leading_dimension(LayoutTypeID layout, int rows,
+                                        int columns) {
+    return layout == LayoutTypeID::kRowMajor ? columns : rows;
+}
+
+CatalogProblem::CatalogProblem(CatalogQuery const& query) {
+    std::fill(&scalars[0][0], &scalars[0][0] + 6, uint64_t(0));
+
+    gemm::GemmCoord problem_size = query.problem_size;
+
+    int64_t lda = query.lda ? query.lda
+                            : packed_leading_dimension(query.layout_A,
+                                                       problem_size.m(),
+                                                       problem_size.k());
+    int64_t ldb = query.ldb ? query.ldb
+                            : packed_leading_dimension(query.layout_B,
+                                                       problem_size.k(),
+                                                       problem_size.n());
+    int64_t ldc = query.ldc ? query.ldc
+                            : packed_leading_dimension(query.layout_C,
+                                                       problem_size.m(),
+                                                       problem_size.n());
+
+    gemm_configuration = {problem_size, lda, ldb, ldc, ldc,
+                          query.split_k_slices};
+
+    gemm_arguments = {nullptr,     nullptr,     nullptr,
+                      nullptr,     scalars[0], scalars[1],
+                      ScalarPointerMode::kHost};
+
+    gemm_universal_configuration = {
+            query.batch_count > 1 ? gemm::GemmUniversalMode::kBatched
+                                  : gemm::GemmUniversalMode::kGemm,
+            problem_size,
+            query.batch_count,
+            lda,
+            ldb,
+            ldc,
+            ldc};
+
+    gemm_universal_arguments = {nullptr,
+                                nullptr,
+                                nullptr,
+                                nullptr,
+                                scalars[0],
+                                scalars[1],
+                                ScalarPointerMode::kHost,
+                                lda * problem_size.k(),
+                                ldb * problem_size.n(),
+                                ldc * problem_size.n(),
+                                ldc * problem_size.n()};
+
+    conv::Conv2dProblemSize const& conv2d = query.conv2d_problem_size;
+
+    conv2d_configuration.split_k_mode = conv::SplitKMode::kSerial;
+    conv2d_configuration.problem_size = conv2d;
+    conv2d_configuration.layout_activations = layout::TensorNHWC::packed(
+            {conv2d.N, conv2d.H, conv2d.W, conv2d.C});
+    conv2d_configuration.layout_filters = layout::TensorNHWC::packed(
+            {conv2d.K, conv2d.R, conv2d.S, conv2d.C});
+    conv2d_configuration.layout_output = layout::TensorNHWC::packed(
+            {conv2d.N, conv2d.P, conv2d.Q, conv2d.K});
+    conv2d_configuration.layout_source = conv2d_configuration.layout_output;
+
+    conv::Conv3dProblemSize const& conv3d = query.conv3d_problem_size;
+
+    conv3d_configuration.split_k_mode = conv::SplitKMode::kSerial;
+    conv3d_configuration.problem_size = conv3d;
+    conv3d_configuration.layout_activations = layout::TensorNDHWC::packed(
+            {conv3d.N, conv3d.D, conv3d.H, conv3d.W, conv3d.C});
+    conv3d_configuration.layout_filters = layout::TensorNDHWC::packed(
+            {conv3d.K, conv3d.T, conv3d.R, conv3d.S, conv3d.C});
+    conv3d_configuration.layout_output = layout::TensorNDHWC::packed(
+            {conv3d.N, conv3d.Z, conv3d.P, conv3d.Q, conv3d.K});
+    conv3d_configuration.layout_source = conv3d_configuration.layout_output;
+
+    conv_arguments = {nullptr,    nullptr,    nullptr,
+                      nullptr,    scalars[0], scalars[1],
+                      ScalarPointerMode::kHost};
+
+    convolution_configuration.problem_size = conv2d;
+
+    convolution_arguments = {nullptr,    nullptr,    nullptr,
+                             nullptr,    nullptr,    scalars[0],
+                             scalars[1], scalars[2], ScalarPointerMode::kHost};
+}
+
+void const* CatalogProblem::configuration(
+        OperationDescription const& desc) const {
+    switch (desc.kind) {
+        case OperationKind::kGemm:
+            switch (static_cast<GemmDescription const&>(desc).gemm_kind) {
+                case GemmKind::kGemm:
+                    return &gemm_configuration;
+                case GemmKind::kUniversal:
+                    return &gemm_universal_configuration;
+                default:
+                    return nullptr;
+            }
+        case OperationKind::kConv2d:
+            return &conv2d_configuration;
+        case OperationKind::kConv3d:
+            return &conv3d_configuration;
+        case OperationKind::kConvolution:
+            return &convolution_configuration;
+        default:
+            return nullptr;
+    }
+}
+
+void const* CatalogProblem::arguments(OperationDescription const& desc) const {
+    switch (desc.kind) {
+        case OperationKind::kGemm:
+            switch (static_cast<GemmDescription const&>(desc).gemm_kind) {
+                case GemmKind::kGemm:
+                    return &gemm_arguments;
+                case GemmKind::kUniversal:
+                    return &gemm_universal_arguments;
+                default:
+                    return nullptr;
+            }
+        case OperationKind::kConv2d:
+        case OperationKind::kConv3d:
+            return &conv_arguments;
+        case OperationKind::kConvolution:
+            return &convolution_arguments;
+        default:
+            return nullptr;
+    }
+}
+
+/// Operand descriptions of GEMMs and convolutions
+struct CatalogOperands {
+    TensorDescription const* A;
+    TensorDescription const* B;
+    TensorDescription const* C;
+
+    explicit CatalogOperands(OperationDescription const& desc)
+            : A(nullptr), B(nullptr), C(nullptr) {
+        if (desc.kind == OperationKind::kGemm ||
+            desc.kind == OperationKind::kSparseGemm) {
+            GemmDescription const& gemm_desc =
+                    static_cast<GemmDescription const&>(desc);
+            A = &gemm_desc.A;
+            B = &gemm_desc.B;
+            C = &gemm_desc.C;
+        } else if (desc.kind == OperationKind::kConv2d ||
+                   desc.kind == OperationKind::kConv3d ||
+                   desc.kind == OperationKind::kConvolution) {
+            ConvDescription const& conv_desc =
+                    static_cast<ConvDescription const&>(desc);
+            A = &conv_desc.A;
+            B = &conv_desc.B;
+            C = &conv_desc.C;
+        }
+    }
+};
+
+char const* gemm_kind_name(OperationDescription const& desc) {
+    if (desc.kind == OperationKind::kGemm ||
+        desc.kind == OperationKind::kSparseGemm) {
+        return to_string(static_cast<GemmDescription const&>(desc).gemm_kind);
+    }
+    return "";
+}
+
+char const* conv_kind_name(OperationDescription const& desc) {
+    if (desc.kind == OperationKind::kConv2d ||
+        desc.kind == OperationKind::kConv3d ||
+        desc.kind == OperationKind::kConvolution) {
+        return to_string(static_cast<ConvDescription const&>(desc).conv_kind);
+    }
+    return "";
+}
+
+char const* iterator_algorithm_name(OperationDescription const& desc) {
+    if (desc.kind == OperationKind::kConv2d ||
+        desc.kind == OperationKind::kConv3d ||
+        desc.kind == OperationKind::kConvolution) {
+        return to_string(static_cast<ConvDescription const&>(desc)
+                                 .iterator_algorithm);
+    }
+    return "";
+}
+
+char const* element_epilogue_name(OperationDescription const& desc) {
+    if (desc.kind == OperationKind::kGemm ||
+        desc.kind == OperationKind::kSparseGemm) {
+        return to_string(
+                static_cast<GemmDescription const&>(desc).element_epilogue);
+    }
+    if (desc.kind == OperationKind::kConv2d ||
+        desc.kind == OperationKind::kConv3d ||
+        desc.kind == OperationKind::kConvolution) {
+        return to_string(
+                static_cast<ConvDescription const&>(desc).element_epilogue);
+    }
+    return "";
+}
+
+char const* split_k_mode_name(OperationDescription const& desc) {
+    if (desc.kind == OperationKind::kGemm ||
+        desc.kind == OperationKind::kSparseGemm) {
+        return to_string(static_cast<GemmDescription const&>(desc).split_k_mode);
+    }
+    return "";
+}
+
+/// Returns true if the operand matches the element and layout of the query
+bool operand_matches(TensorDescription const* tensor,
+                            NumericTypeID element, LayoutTypeID layout) {
+    if (element == NumericTypeID::kInvalid &&
+        layout == LayoutTypeID::kInvalid) {
+        return true;
+    }
+    if (!tensor) {
+        return false;
+    }
+    return (element == NumericTypeID::kInvalid ||
+            tensor->element == element) &&
+           (layout == LayoutTypeID::kInvalid || tensor->layout == layout);
+}
+
+/// Returns true if the operation is functionally able to compute the query
+bool functional_match(OperationDescription const& desc,
+                             CatalogQuery const& query) {
+    if (desc.kind != query.kind) {
+        return false;
+    }
+
+    if (query.compute_capability &&
+        (query.compute_capability <
+                 desc.tile_description.minimum_compute_capability ||
+         query.compute_capability >
+                 desc.tile_description.maximum_compute_capability)) {
+        return false;
+    }
+
+    if (query.element_accumulator != NumericTypeID::kInvalid &&
+        query.element_accumulator !=
+                desc.tile_description.math_instruction.element_accumulator) {
+        return false;
+    }
+
+    if (query.conv_kind != ConvKind::kInvalid &&
+        std::string(conv_kind_name(desc)) != to_string(query.conv_kind)) {
+        return false;
+    }
+
+    CatalogOperands operands(desc);
+
+    return operand_matches(operands.A, query.element_A, query.layout_A) &&
+           operand_matches(operands.B, query.element_B, query.layout_B) &&
+           operand_matches(operands.C, query.element_C, query.layout_C);
+}
+
+/// Orders records by operation name
+void sort_records(CatalogRecordVector& records) {
+    std::sort(records.begin(), records.end(),
+              [](CatalogRecord const& lhs, CatalogRecord const& rhs) {
+                  return std::string(lhs.operation->description().name) <
+                         std::string(rhs.operation->description().name);
+              });
+}
+
+/// Escapes a string for JSON
+std::string json_string(char const* text) {
+    std::stringstream ss;
+    ss << '"';
+    for (char const* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            ss << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            ss << ' ';
+        } else {
+            ss << *c;
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+std::string json_coord(gemm::GemmCoord const& coord) {
+    std::stringstream ss;
+    ss << "[" << coord.m() << ", " << coord.n() << ", " << coord.k() << "]";
+    return ss.str();
+}
+
+std::string json_tensor(TensorDescription const* tensor) {
+    if (!tensor) {
+        return "null";
+    }
+    std::stringstream ss;
+    ss << "{\"element\": " << json_string(to_string(tensor->element))
+       << ", \"layout\": " << json_string(to_string(tensor->layout))
+       << ", \"alignment\": " << tensor->alignment << "}";
+    return ss.str();
+}
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+CatalogRecordVector make_catalog(Manifest const& manifest) {
+    CatalogProblem problem((CatalogQuery()));
+
+    CatalogRecordVector records;
+    records.reserve(manifest.operations().size());
+
+    for (auto const& operation : manifest) {
+        // host workspaces do not depend on the problem size
+        records.emplace_back(operation.get(),
+                             operation->get_host_workspace_size(
+                                     problem.configuration(
+                                             operation->description())));
+    }
+
+    sort_records(records);
+    return records;
+}
+
+CatalogRecordVector query_catalog(Manifest const& manifest,
+                                  CatalogQuery const& query) {
+    CatalogProblem problem(query);
+
+    CatalogRecordVector records;
+
+    for (auto const& operation : manifest) {
+        OperationDescription const& desc = operation->description();
+
+        if (!functional_match(desc, query)) {
+            continue;
+        }
+
+        void const* configuration = problem.configuration(desc);
+
+        if (!configuration || operation->can_implement(
+                                      configuration, problem.arguments(desc)) !=
+                                      Status::kSuccess) {
+            continue;
+        }
+
+        records.emplace_back(
+                operation.get(),
+                operation->get_host_workspace_size(configuration),
+                operation->get_device_workspace_size(configuration));
+    }
+
+    sort_records(records);
+    return records;
+}
+
+void write_catalog_json(std::ostream& out, CatalogRecordVector const& records) {
+    out << "[";
+
+    char const* separator = "\n";
+    for (CatalogRecord const& record : records) {
+        OperationDescription const& desc = record.operation->description();
+        TileDescription const& tile = desc.tile_description;
+        CatalogOperands operands(desc);
+
+        out << separator << "  {\n"
+            << "    \"name\": " << json_string(desc.name) << ",\n"
+            << "    \"provider\": " << json_string(to_string(desc.provider))
+            << ",\n"
+            << "    \"operation_kind\": " << json_string(to_string(desc.kind))
+            << ",\n"
+            << "    \"gemm_kind\": " << json_string(gemm_kind_name(desc))
+            << ",\n"
+            << "    \"conv_kind\": " << json_string(conv_kind_name(desc))
+            << ",\n"
+            << "    \"iterator_algorithm\": "
+            << json_string(iterator_algorithm_name(desc)) << ",\n"
+            << "    \"threadblock_shape\": "
+            << json_coord(tile.threadblock_shape) << ",\n"
+            << "    \"stages\": " << tile.threadblock_stages << ",\n"
+            << "    \"warp_count\": " << json_coord(tile.warp_count) << ",\n"
+            << "    \"instruction_shape\": "
+            << json_coord(tile.math_instruction.instruction_shape) << ",\n"
+            << "    \"opcode_class\": "
+            << json_string(to_string(tile.math_instruction.opcode_class))
+            << ",\n"
+            << "    \"math_operation\": "
+            << json_string(to_string(tile.math_instruction.math_operation))
+            << ",\n"
+            << "    \"element_accumulator\": "
+            << json_string(to_string(tile.math_instruction.element_accumulator))
+            << ",\n"
+            << "    \"element_epilogue\": "
+            << json_string(element_epilogue_name(desc)) << ",\n"
+            << "    \"split_k_mode\": " << json_string(split_k_mode_name(desc))
+            << ",\n"
+            << "    \"minimum_compute_capability\": "
+            << tile.minimum_compute_capability << ",\n"
+            << "    \"maximum_compute_capability\": "
+            << tile.maximum_compute_capability << ",\n"
+            << "    \"A\": " << json_tensor(operands.A) << ",\n"
+            << "    \"B\": " << json_tensor(operands.B) << ",\n"
+            << "    \"C\": " << json_tensor(operands.C) << ",\n"
+            << "    \"shared_memory_size\": " << desc.shared_memory_size
+            << ",\n"
+            << "    \"host_workspace_size\": " << record.host_workspace_size
+            << ",\n"
+            << "    \"device_workspace_size\": "
+            << record.device_workspace_size << "\n"
+            << "  }";
+
+        separator = ",\n";
+    }
+
+    out << "\n]\n";
+}
+
+void write_catalog_csv(std::ostream& out, CatalogRecordVector const& records) {
+    out << "name,provider,operation_kind,gemm_kind,conv_kind,"
+        << "iterator_algorithm,threadblock_m,threadblock_n,threadblock_k,"
+        << "stages,warps_m,warps_n,warps_k,inst_m,inst_n,inst_k,"
+        << "opcode_class,math_operation,element_accumulator,"
+        << "element_epilogue,split_k_mode,min_cc,max_cc,"
+        << "element_A,layout_A,alignment_A,element_B,layout_B,alignment_B,"
+        << "element_C,layout_C,alignment_C,"
+        << "shared_memory_size,host_workspace_size,device_workspace_size\n";
+
+    for (CatalogRecord const& record : records) {
+        OperationDescription const& desc = record.operation->description();
+        TileDescription const& tile = desc.tile_description;
+        CatalogOperands operands(desc);
+
+        out << desc.name << "," << to_string(desc.provider) << ","
+            << to_string(desc.kind) << "," << gemm_kind_name(desc) << ","
+            << conv_kind_name(desc) << "," << iterator_algorithm_name(desc)
+            << "," << tile.threadblock_shape.m() << ","
+            << tile.threadblock_shape.n() << "," << tile.threadblock_shape.k()
+            << "," << tile.threadblock_stages << "," << tile.warp_count.m()
+            << "," << tile.warp_count.n() << "," << tile.warp_count.k() << ","
+            << tile.math_instruction.instruction_shape.m() << ","
+            << tile.math_instruction.instruction_shape.n() << ","
+            << tile.math_instruction.instruction_shape.k() << ","
+            << to_string(tile.math_instruction.opcode_class) << ","
+            << to_string(tile.math_instruction.math_operation) << ","
+            << to_string(tile.math_instruction.element_accumulator) << ","
+            << element_epilogue_name(desc) << "," << split_k_mode_name(desc)
+            << "," << tile.minimum_compute_capability << ","
+            << tile.maximum_compute_capability;
+
+        for (TensorDescription const* tensor :
+             {operands.A, operands.B, operands.C}) {
+            if (tensor) {
+                out << "," << to_string(tensor->element) << ","
+                    << to_string(tensor->layout) << "," << tensor->alignment;
+            } else {
+                out << ",,,";
+            }
+        }
+
+        out << "," << desc.shared_memory_size << ","
+            << record.host_workspace_size << ","
+            << record.device_workspace_size << "\n";
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
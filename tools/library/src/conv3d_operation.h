@@ -115,6 +115,9 @@ public:
                 ArchMap<typename Operator::ArchTag,
                         typename Operator::OperatorClass>::kMax;
 
+        description_.shared_memory_size =
+                int(sizeof(typename Operator::ImplicitGemmKernel::SharedStorage));
+
         description_.A = make_TensorDescription<ElementA, LayoutA>();
         description_.B = make_TensorDescription<ElementB, LayoutB>();
         description_.C = make_TensorDescription<ElementC, LayoutC>();
@@ -0,0 +1,378 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+  \brief Defines operations for convolutions with a fused bias and residual
+  tensor (cutlass::conv::device::Convolution) in CUTLASS Library.
+*/
+
+#pragma once
+#include "cutlass/cutlass.h"
+#include "cutlass/convolution/device/convolution.h"
+#include "cutlass/epilogue/thread/bias_add_linear_combination.h"
+#include "cutlass/epilogue/thread/bias_add_linear_combination_clamp.h"
+#include "cutlass/epilogue/thread/bias_add_linear_combination_hswish.h"
+#include "cutlass/epilogue/thread/bias_add_linear_combination_hswish_clamp.h"
+#include "cutlass/epilogue/thread/bias_add_linear_combination_relu.h"
+#include "cutlass/epilogue/thread/bias_add_linear_combination_relu_clamp.h"
+
+#include "cutlass/library/library.h"
+#include "library_internal.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename EpilogueOutputOp>
+struct EpilogueKindMap {
+    static EpilogueKind const kId = EpilogueKind::kUnknown;
+};
+
+template <typename ElementOutput, int Count, typename ElementAccumulator,
+          typename ElementBias, typename ElementCompute, FloatRoundStyle Round,
+          typename Policy>
+struct EpilogueKindMap<epilogue::thread::BiasAddLinearCombination<
+        ElementOutput, Count, ElementAccumulator, ElementBias, ElementCompute,
+        Round, Policy>> {
+    static EpilogueKind const kId = EpilogueKind::kBiasAddLinearCombination;
+};
+
+template <typename ElementOutput, int Count, typename ElementAccumulator,
+          typename ElementBias, typename ElementCompute, FloatRoundStyle Round,
+          typename Policy>
+struct EpilogueKindMap<epilogue::thread::BiasAddLinearCombinationClamp<
+        ElementOutput, Count, ElementAccumulator, ElementBias, ElementCompute,
+        Round, Policy>> {
+    static EpilogueKind const kId =
+            EpilogueKind::kBiasAddLinearCombinationClamp;
+};
+
+template <typename ElementOutput, int Count, typename ElementAccumulator,
+          typename ElementBias, typename ElementCompute, FloatRoundStyle Round,
+          typename Policy>
+struct EpilogueKindMap<epilogue::thread::BiasAddLinearCombinationRelu<
+        ElementOutput, Count, ElementAccumulator, ElementBias, ElementCompute,
+        Round, Policy>> {
+    static EpilogueKind const kId = EpilogueKind::kBiasAddLinearCombinationRelu;
+};
+
+template <typename ElementOutput, int Count, typename ElementAccumulator,
+          typename ElementBias, typename ElementCompute, FloatRoundStyle Round,
+          typename Policy>
+struct EpilogueKindMap<epilogue::thread::BiasAddLinearCombinationReluClamp<
+        ElementOutput, Count, ElementAccumulator, ElementBias, ElementCompute,
+        Round, Policy>> {
+    static EpilogueKind const kId =
+            EpilogueKind::kBiasAddLinearCombinationReluClamp;
+};
+
+template <typename ElementOutput, int Count, typename ElementAccumulator,
+          typename ElementBias, typename ElementCompute, FloatRoundStyle Round,
+          typename Policy>
+struct EpilogueKindMap<epilogue::thread::BiasAddLinearCombinationHSwish<
+        ElementOutput, Count, ElementAccumulator, ElementBias, ElementCompute,
+        Round, Policy>> {
+    static EpilogueKind const kId =
+            EpilogueKind::kBiasAddLinearCombinationHSwish;
+};
+
+template <typename ElementOutput, int Count, typename ElementAccumulator,
+          typename ElementBias, typename ElementCompute, FloatRoundStyle Round,
+          typename Policy>
+struct EpilogueKindMap<epilogue::thread::BiasAddLinearCombinationHSwishClamp<
+        ElementOutput, Count, ElementAccumulator, ElementBias, ElementCompute,
+        Round, Policy>> {
+    static EpilogueKind const kId =
+            EpilogueKind::kBiasAddLinearCombinationHSwishClamp;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Convolution library operation class for cutlass profiler
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename Operator_>
+class ConvolutionOperation : public Operation {
+public:
+    using Operator = Operator_;
+
+    using ElementSrc = typename Operator::ElementSrc;
+    using LayoutSrc = typename Operator::LayoutSrc;
+    using ElementFilter = typename Operator::ElementFilter;
+    using LayoutFilter = typename Operator::LayoutFilter;
+    using ElementDst = typename Operator::ElementDst;
+    using LayoutDst = typename Operator::LayoutDst;
+    using ElementBias = typename Operator::ElementBias;
+    using LayoutBias = typename Operator::LayoutBias;
+    using ElementAccumulator = typename Operator::ElementAccumulator;
+    using EpilogueOutputOp = typename Operator::EpilogueOutputOp;
+    using ElementCompute = typename EpilogueOutputOp::ElementCompute;
+
+    using OperatorArguments = typename Operator::Arguments;
+
+protected:
+    ///
+    ConvolutionDescription description_;
+
+public:
+    /// Constructor
+    ConvolutionOperation(char const* name = "unknown_convolution")
+            : description_(ConvTypeMap<Operator::kConvolutionType>::kId,
+                           EpilogueKindMap<EpilogueOutputOp>::kId) {
+        description_.name = name;
+        description_.provider = Provider::kCUTLASS;
+        description_.kind = OperationKind::kConvolution;
+
+        description_.tile_description.threadblock_shape = make_Coord(
+                Operator::ThreadblockShape::kM, Operator::ThreadblockShape::kN,
+                Operator::ThreadblockShape::kK);
+
+        description_.tile_description.threadblock_stages = Operator::kStages;
+
+        description_.tile_description.warp_count =
+                make_Coord(Operator::ConvolutionKernel::WarpCount::kM,
+                           Operator::ConvolutionKernel::WarpCount::kN,
+                           Operator::ConvolutionKernel::WarpCount::kK);
+
+        description_.tile_description.math_instruction.instruction_shape =
+                make_Coord(Operator::InstructionShape::kM,
+                           Operator::InstructionShape::kN,
+                           Operator::InstructionShape::kK);
+
+        description_.tile_description.math_instruction.element_accumulator =
+                NumericTypeMap<ElementAccumulator>::kId;
+
+        description_.tile_description.math_instruction.opcode_class =
+                OpcodeClassMap<typename Operator::OperatorClass>::kId;
+
+        description_.tile_description.math_instruction.math_operation =
+                MathOperationMap<typename Operator::Operator>::kId;
+
+        description_.tile_description.minimum_compute_capability =
+                ArchMap<typename Operator::ArchTag,
+                        typename Operator::OperatorClass>::kMin;
+
+        description_.tile_description.maximum_compute_capability =
+                ArchMap<typename Operator::ArchTag,
+                        typename Operator::OperatorClass>::kMax;
+
+        description_.shared_memory_size = int(
+                sizeof(typename Operator::ConvolutionKernel::SharedStorage));
+
+        description_.A = make_TensorDescription<ElementSrc, LayoutSrc>(
+                Operator::kAlignmentSrc);
+        description_.B = make_TensorDescription<ElementFilter, LayoutFilter>(
+                Operator::kAlignmentFilter);
+        description_.C = make_TensorDescription<ElementDst, LayoutDst>(
+                Operator::kAlignmentDst);
+        description_.bias = make_TensorDescription<ElementBias, LayoutBias>(
+                Operator::kAlignmentDst);
+        description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+    }
+
+    /// Returns the description of the Convolution operation
+    virtual OperationDescription const& description() const {
+        return description_;
+    }
+
+protected:
+    /// Constructs the arguments structure given the configuration and arguments
+    static Status construct_arguments_(
+            OperatorArguments& operator_args,
+            ConvolutionConfiguration const* configuration) {
+        conv::Conv2dProblemSize const& problem_size =
+                configuration->problem_size;
+
+        operator_args.problem_size = problem_size;
+
+        operator_args.ref_src = {
+                nullptr,
+                LayoutSrc::packed({problem_size.N, problem_size.H,
+                                   problem_size.W, problem_size.C})};
+
+        operator_args.ref_filter = {
+                nullptr,
+                LayoutFilter::packed({problem_size.K, problem_size.R,
+                                      problem_size.S, problem_size.C})};
+
+        operator_args.ref_bias = {
+                nullptr, LayoutBias::packed({1, 1, 1, problem_size.K})};
+
+        operator_args.ref_z = {
+                nullptr,
+                LayoutDst::packed({problem_size.N, problem_size.P,
+                                   problem_size.Q, problem_size.K})};
+
+        operator_args.ref_dst = {
+                nullptr,
+                LayoutDst::packed({problem_size.N, problem_size.P,
+                                   problem_size.Q, problem_size.K})};
+
+        return Status::kSuccess;
+    }
+
+    /// Constructs the arguments structure given the configuration and arguments
+    static Status update_arguments_(OperatorArguments& operator_args,
+                                    ConvolutionArguments const* arguments) {
+        // Default construction keeps the defaults of epilogue specific
+        // parameters (e.g. the HSwish output scale).
+        typename EpilogueOutputOp::Params params;
+
+        if (arguments->pointer_mode == ScalarPointerMode::kHost) {
+            params.alpha =
+                    *static_cast<ElementCompute const*>(arguments->alpha);
+            params.beta = *static_cast<ElementCompute const*>(arguments->beta);
+            params.gamma =
+                    *static_cast<ElementCompute const*>(arguments->gamma);
+        } else if (arguments->pointer_mode == ScalarPointerMode::kDevice) {
+            params.alpha_ptr =
+                    static_cast<ElementCompute const*>(arguments->alpha);
+            params.beta_ptr =
+                    static_cast<ElementCompute const*>(arguments->beta);
+            params.gamma_ptr =
+                    static_cast<ElementCompute const*>(arguments->gamma);
+        } else {
+            return Status::kErrorInvalidProblem;
+        }
+
+        operator_args.output_op = params;
+
+        operator_args.ref_src.reset(
+                static_cast<ElementSrc*>(const_cast<void*>(arguments->src)));
+        operator_args.ref_filter.reset(static_cast<ElementFilter*>(
+                const_cast<void*>(arguments->filter)));
+        operator_args.ref_bias.reset(
+                static_cast<ElementBias*>(const_cast<void*>(arguments->bias)));
+        operator_args.ref_z.reset(
+                static_cast<ElementDst*>(const_cast<void*>(arguments->z)));
+        operator_args.ref_dst.reset(
+                static_cast<ElementDst*>(arguments->dst));
+
+        return Status::kSuccess;
+    }
+
+public:
+    /// Returns success if the operation can proceed
+    virtual Status can_implement(void const* configuration_ptr,
+                                 void const* arguments_ptr) const {
+        ConvolutionConfiguration const* configuration =
+                static_cast<ConvolutionConfiguration const*>(
+                        configuration_ptr);
+
+        ConvolutionArguments const* arguments =
+                static_cast<ConvolutionArguments const*>(arguments_ptr);
+
+        OperatorArguments args;
+
+        Status status = construct_arguments_(args, configuration);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        status = update_arguments_(args, arguments);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        return Operator::can_implement(args);
+    }
+
+    /// Gets the host-side workspace
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(Operator);
+    }
+
+    /// Gets the device-side workspace
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration_ptr) const {
+        OperatorArguments args;
+
+        Status status = construct_arguments_(
+                args, static_cast<ConvolutionConfiguration const*>(
+                              configuration_ptr));
+
+        if (status != Status::kSuccess) {
+            return 0;
+        }
+
+        return Operator::get_workspace_size(args);
+    }
+
+    /// Initializes the workspace
+    virtual Status initialize(void const* configuration_ptr,
+                              void* host_workspace, void* device_workspace,
+                              cudaStream_t stream = nullptr) const {
+        OperatorArguments args;
+
+        Status status = construct_arguments_(
+                args, static_cast<ConvolutionConfiguration const*>(
+                              configuration_ptr));
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        Operator* op = new (host_workspace) Operator;
+
+        return op->initialize(args, device_workspace, stream);
+    }
+
+    /// Runs the kernel
+    virtual Status run(void const* arguments_ptr, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        OperatorArguments args;
+
+        Status status = update_arguments_(
+                args, static_cast<ConvolutionArguments const*>(arguments_ptr));
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        Operator* op = static_cast<Operator*>(host_workspace);
+
+        status = op->update(args, device_workspace);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        return op->run(stream);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
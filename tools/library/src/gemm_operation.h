@@ -29,6 +29,9 @@
 */
 
 #pragma once
+#include <cstdint>
+#include <vector>
+
 #include "cutlass/cutlass.h"
 
 #include "cutlass/gemm/device/gemm.h"
@@ -37,8 +40,10 @@
 #include "cutlass/gemm/device/gemm_batched.h"
 #include "cutlass/gemm/device/gemm_array.h"
 #include "cutlass/gemm/device/gemm_universal_adapter.h"
+#include "cutlass/gemm/device/gemm_grouped.h"
 #include "cutlass/gemm/kernel/default_gemm_universal.h"
 #include "cutlass/gemm/kernel/default_gemm_planar_complex_universal.h"
+#include "cutlass/gemm/kernel/default_gemm_grouped.h"
 
 #include "cutlass/library/library.h"
 #include "library_internal.h"
@@ -110,6 +115,9 @@ public:
                 ArchMap<typename Operator::ArchTag,
                         typename Operator::OperatorClass>::kMax;
 
+        description_.shared_memory_size =
+                int(sizeof(typename Operator::GemmKernel::SharedStorage));
+
         description_.A = make_TensorDescription<ElementA, LayoutA>(
                 Operator::kAlignmentA);
         description_.B = make_TensorDescription<ElementB, LayoutB>(
@@ -1029,6 +1037,300 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Grouped GEMM. The problem descriptors given in host memory are copied into
+/// the device workspace, laid out as
+///
+///   [lda | ldb | ldc | ldd | A | B | C | D | problem sizes]
+///
+/// with leading dimensions and problem sizes written by initialize() and the
+/// operand pointers by run().
+template <typename Operator_>
+class GemmGroupedOperation : public GemmOperationBase<Operator_> {
+public:
+    using Operator = Operator_;
+    using ElementA = typename Operator::ElementA;
+    using LayoutA = typename Operator::LayoutA;
+    using ElementB = typename Operator::ElementB;
+    using LayoutB = typename Operator::LayoutB;
+    using ElementC = typename Operator::ElementC;
+    using LayoutC = typename Operator::LayoutC;
+    using ElementAccumulator = typename Operator::ElementAccumulator;
+    using ElementCompute = typename Operator::EpilogueOutputOp::ElementCompute;
+
+    using OperatorArguments = typename Operator::Arguments;
+
+protected:
+    /// State kept in the host workspace between initialize() and run()
+    struct HostWorkspace {
+        Operator op;
+        OperatorArguments args;
+    };
+
+public:
+    /// Constructor
+    GemmGroupedOperation(char const* name = "unknown_gemm")
+            : GemmOperationBase<Operator_>(name) {
+        this->description_.gemm_kind = GemmKind::kGrouped;
+    }
+
+protected:
+    /// Bytes of leading dimensions and operand pointers per problem
+    static size_t const kDescriptorBytes =
+            4 * sizeof(int64_t) + 4 * sizeof(void const*);
+
+    /// Size of the device workspace holding the descriptors of a group
+    static uint64_t descriptor_workspace_size_(int problem_count) {
+        return uint64_t(problem_count) *
+               (kDescriptorBytes + sizeof(gemm::GemmCoord));
+    }
+
+    /// Constructs the arguments structure given the configuration, pointing
+    /// the descriptor arrays into the device workspace
+    static Status construct_arguments_(
+            OperatorArguments& operator_args,
+            GemmGroupedConfiguration const* configuration,
+            void* device_workspace) {
+        int count = configuration->problem_count;
+
+        int64_t* ld = static_cast<int64_t*>(device_workspace);
+        void** pointers = reinterpret_cast<void**>(ld + 4 * count);
+
+        operator_args.problem_count = count;
+        operator_args.threadblock_count = configuration->threadblock_count;
+
+        operator_args.lda = ld;
+        operator_args.ldb = ld + count;
+        operator_args.ldc = ld + 2 * count;
+        operator_args.ldd = ld + 3 * count;
+
+        operator_args.ptr_A =
+                reinterpret_cast<ElementA const* const*>(pointers);
+        operator_args.ptr_B =
+                reinterpret_cast<ElementB const* const*>(pointers + count);
+        operator_args.ptr_C =
+                reinterpret_cast<ElementC const* const*>(pointers + 2 * count);
+        operator_args.ptr_D =
+                reinterpret_cast<ElementC* const*>(pointers + 3 * count);
+
+        operator_args.problem_sizes = reinterpret_cast<gemm::GemmCoord const*>(
+                pointers + 4 * count);
+
+        return Status::kSuccess;
+    }
+
+    /// True if an operand of `alignment` elements of `Element` may be
+    /// accessed through the pointer
+    template <typename Element>
+    static bool is_aligned_(void const* ptr, int alignment) {
+        size_t const bytes = (sizeof_bits<Element>::value * alignment + 7) / 8;
+        return !(reinterpret_cast<std::uintptr_t>(ptr) % bytes);
+    }
+
+    /// Constructs the arguments structure given the configuration and arguments
+    static Status update_arguments_(OperatorArguments& operator_args,
+                                    GemmGroupedArguments const* arguments) {
+        if (arguments->pointer_mode == ScalarPointerMode::kHost) {
+            typename Operator::EpilogueOutputOp::Params params(
+                    *static_cast<ElementCompute const*>(arguments->alpha),
+                    *static_cast<ElementCompute const*>(arguments->beta));
+            operator_args.epilogue = params;
+        } else if (arguments->pointer_mode == ScalarPointerMode::kDevice) {
+            typename Operator::EpilogueOutputOp::Params params(
+                    static_cast<ElementCompute const*>(arguments->alpha),
+                    static_cast<ElementCompute const*>(arguments->beta));
+            operator_args.epilogue = params;
+        } else {
+            return Status::kErrorInvalidProblem;
+        }
+
+        return Status::kSuccess;
+    }
+
+public:
+    /// Returns success if the operation can proceed
+    virtual Status can_implement(void const* configuration_ptr,
+                                 void const* arguments_ptr) const {
+        GemmGroupedConfiguration const* configuration =
+                static_cast<GemmGroupedConfiguration const*>(
+                        configuration_ptr);
+
+        GemmGroupedArguments const* arguments =
+                static_cast<GemmGroupedArguments const*>(arguments_ptr);
+
+        if (configuration->problem_count < 0 ||
+            configuration->threadblock_count < 0) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        if (configuration->problem_count &&
+            (!arguments->A || !arguments->B || !arguments->C ||
+             !arguments->D)) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        OperatorArguments args;
+
+        Status status = update_arguments_(args, arguments);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        for (int idx = 0; idx < configuration->problem_count; ++idx) {
+            // Checks leading dimensions and extents against the alignment
+            status = Operator::can_implement(
+                    configuration->problem_sizes[idx], configuration->lda[idx],
+                    configuration->ldb[idx], configuration->ldc[idx],
+                    configuration->ldd[idx]);
+
+            if (status != Status::kSuccess) {
+                return status;
+            }
+
+            if (!is_aligned_<ElementA>(arguments->A[idx],
+                                       Operator::kAlignmentA) ||
+                !is_aligned_<ElementB>(arguments->B[idx],
+                                       Operator::kAlignmentB) ||
+                !is_aligned_<ElementC>(arguments->C[idx],
+                                       Operator::kAlignmentC) ||
+                !is_aligned_<ElementC>(arguments->D[idx],
+                                       Operator::kAlignmentC)) {
+                return Status::kErrorMisalignedOperand;
+            }
+        }
+
+        return Status::kSuccess;
+    }
+
+    /// Gets the host-side workspace
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(HostWorkspace);
+    }
+
+    /// Gets the device-side workspace
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration_ptr) const {
+        return descriptor_workspace_size_(
+                static_cast<GemmGroupedConfiguration const*>(configuration_ptr)
+                        ->problem_count);
+    }
+
+    /// Initializes the workspace
+    virtual Status initialize(void const* configuration_ptr,
+                              void* host_workspace, void* device_workspace,
+                              cudaStream_t stream = nullptr) const {
+        GemmGroupedConfiguration const* configuration =
+                static_cast<GemmGroupedConfiguration const*>(
+                        configuration_ptr);
+
+        int count = configuration->problem_count;
+
+        if (count && !device_workspace) {
+            return Status::kErrorWorkspaceNull;
+        }
+
+        HostWorkspace* workspace = new (host_workspace) HostWorkspace;
+
+        Status status = construct_arguments_(workspace->args, configuration,
+                                             device_workspace);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        // Launch no more threadblocks than the group has tiles
+        if (!workspace->args.threadblock_count && count) {
+            workspace->args.threadblock_count =
+                    Operator::sufficient(configuration->problem_sizes, count);
+
+            if (!workspace->args.threadblock_count) {
+                return Status::kErrorInternal;
+            }
+        }
+
+        if (count) {
+            std::vector<int64_t> ld(4 * size_t(count));
+
+            for (int idx = 0; idx < count; ++idx) {
+                ld[idx] = configuration->lda[idx];
+                ld[count + idx] = configuration->ldb[idx];
+                ld[2 * count + idx] = configuration->ldc[idx];
+                ld[3 * count + idx] = configuration->ldd[idx];
+            }
+
+            cudaError_t result = cudaMemcpyAsync(
+                    const_cast<int64_t*>(workspace->args.lda), ld.data(),
+                    sizeof(int64_t) * ld.size(), cudaMemcpyHostToDevice,
+                    stream);
+
+            if (result == cudaSuccess) {
+                result = cudaMemcpyAsync(
+                        const_cast<gemm::GemmCoord*>(
+                                workspace->args.problem_sizes),
+                        configuration->problem_sizes,
+                        sizeof(gemm::GemmCoord) * count,
+                        cudaMemcpyHostToDevice, stream);
+            }
+
+            if (result != cudaSuccess) {
+                return Status::kErrorInternal;
+            }
+        }
+
+        return workspace->op.initialize(workspace->args, device_workspace,
+                                        stream);
+    }
+
+    /// Runs the kernel
+    virtual Status run(void const* arguments_ptr, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        GemmGroupedArguments const* arguments =
+                static_cast<GemmGroupedArguments const*>(arguments_ptr);
+
+        HostWorkspace* workspace = static_cast<HostWorkspace*>(host_workspace);
+        OperatorArguments& args = workspace->args;
+
+        Status status = update_arguments_(args, arguments);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        int count = args.problem_count;
+
+        if (count) {
+            std::vector<void const*> pointers(4 * size_t(count));
+
+            for (int idx = 0; idx < count; ++idx) {
+                pointers[idx] = arguments->A[idx];
+                pointers[count + idx] = arguments->B[idx];
+                pointers[2 * count + idx] = arguments->C[idx];
+                pointers[3 * count + idx] = arguments->D[idx];
+            }
+
+            cudaError_t result = cudaMemcpyAsync(
+                    const_cast<ElementA const**>(args.ptr_A), pointers.data(),
+                    sizeof(void const*) * pointers.size(),
+                    cudaMemcpyHostToDevice, stream);
+
+            if (result != cudaSuccess) {
+                return Status::kErrorInternal;
+            }
+        }
+
+        status = workspace->op.update(args, device_workspace);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        return workspace->op.run(stream);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 }  // namespace library
 }  // namespace cutlass
 
@@ -28,12 +28,19 @@
 /*! \file
     \brief CUTLASS Library handle.
 */
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
 
 #include "cutlass/library/handle.h"
 #include "cutlass/library/singleton.h"
+#include "cutlass/library/trace.h"
 #include "cutlass/library/util.h"
 
 namespace cutlass {
@@ -41,17 +48,105 @@ namespace library {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Returns the number of operations run
+uint64_t HandleStatistics::calls() const {
+    uint64_t count = 0;
+    for (auto const& entry : operation_calls) {
+        count += entry.second;
+    }
+    return count;
+}
+
+/// Returns the number of calls for which no operation was found
+uint64_t HandleStatistics::miss_count() const {
+    uint64_t count = 0;
+    for (auto const& entry : misses) {
+        count += entry.second;
+    }
+    return count;
+}
+
+/// Writes statistics as a JSON object
+void write_statistics_json(std::ostream& out,
+                           HandleStatistics const& statistics) {
+    using OperationCount = std::pair<std::string, uint64_t>;
+
+    std::vector<OperationCount> operations;
+    for (auto const& entry : statistics.operation_calls) {
+        operations.emplace_back(entry.first->description().name, entry.second);
+    }
+
+    std::sort(operations.begin(), operations.end(),
+              [](OperationCount const& lhs, OperationCount const& rhs) {
+                  return lhs.second != rhs.second ? lhs.second > rhs.second
+                                                  : lhs.first < rhs.first;
+              });
+
+    out << "{\n"
+        << "  \"calls\": " << statistics.calls() << ",\n"
+        << "  \"misses\": " << statistics.miss_count() << ",\n"
+        << "  \"dispatch_ns\": " << statistics.dispatch_ns << ",\n"
+        << "  \"workspace_allocations\": "
+        << statistics.workspace_allocations << ",\n"
+        << "  \"workspace_bytes_allocated\": "
+        << statistics.workspace_bytes_allocated << ",\n"
+        << "  \"operations\": [";
+
+    for (size_t i = 0; i < operations.size(); ++i) {
+        out << (i ? ",\n" : "\n") << "    {\"name\": \""
+            << operations[i].first << "\", \"calls\": " << operations[i].second
+            << "}";
+    }
+
+    out << (operations.empty() ? "" : "\n  ") << "],\n"
+        << "  \"missed_keys\": [";
+
+    size_t idx = 0;
+    for (auto const& entry : statistics.misses) {
+        GemmFunctionalKey const& key = entry.first;
+
+        out << (idx++ ? ",\n" : "\n") << "    {"
+            << "\"provider\": \"" << to_string(key.provider) << "\", "
+            << "\"gemm_kind\": \"" << to_string(key.gemm_kind) << "\", "
+            << "\"element_compute\": \"" << to_string(key.element_compute)
+            << "\", "
+            << "\"element_scalar\": \"" << to_string(key.element_scalar)
+            << "\", "
+            << "\"A\": \"" << to_string(key.element_A) << ":"
+            << to_string(key.layout_A) << ":" << to_string(key.transform_A)
+            << "\", "
+            << "\"B\": \"" << to_string(key.element_B) << ":"
+            << to_string(key.layout_B) << ":" << to_string(key.transform_B)
+            << "\", "
+            << "\"element_C\": \"" << to_string(key.element_C) << "\", "
+            << "\"count\": " << entry.second << "}";
+    }
+
+    out << (statistics.misses.empty() ? "" : "\n  ") << "]\n"
+        << "}\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Constructor
 Handle::Handle(cudaStream_t stream, size_t workspace_size)
         : provider_(Provider::kCUTLASS),
           stream_(stream),
-          workspace_(nullptr),
-          workspace_size_(0),
+          workspace_(std::make_shared<WorkspaceArena>()),
           scalar_pointer_mode_(ScalarPointerMode::kHost),
           last_operation_(nullptr) {
     int device_idx = -1;
 
     cudaError_t error = cudaGetDevice(&device_idx);
+    if (error == cudaErrorNoDevice || error == cudaErrorInsufficientDriver) {
+        // Without a device, operations are served by the host provider
+        cudaGetLastError();
+        std::memset(&device_, 0, sizeof(device_));
+        provider_ = Provider::kHost;
+        Singleton::get();
+        return;
+    }
+
     if (error != cudaSuccess) {
         throw std::runtime_error("cudaGetDevice() failed");
     }
@@ -67,40 +162,28 @@ Handle::Handle(cudaStream_t stream, size_t workspace_size)
 }
 
 /// Destructor
-Handle::~Handle() {
-    if (workspace_) {
-        if (workspace_) {
-            cudaFree(workspace_);
-        }
-
-        workspace_ = nullptr;
-        workspace_size_ = 0;
-    }
-}
+Handle::~Handle() {}
 
 /// Move constructor
 Handle::Handle(Handle&& handle) {
+    provider_ = handle.provider_;
     device_ = handle.device_;
-    workspace_size_ = handle.workspace_size_;
-    workspace_ = handle.workspace_;
+    workspace_ = std::move(handle.workspace_);
     stream_ = handle.stream_;
     scalar_pointer_mode_ = handle.scalar_pointer_mode_;
-
-    handle.workspace_ = nullptr;
-    handle.workspace_size_ = 0;
+    last_operation_ = handle.last_operation_;
+    statistics_ = std::move(handle.statistics_);
 }
 
 /// Move assignment operator
 Handle& Handle::operator=(Handle&& handle) {
     provider_ = handle.provider_;
     device_ = handle.device_;
-    workspace_size_ = handle.workspace_size_;
-    workspace_ = handle.workspace_;
+    workspace_ = std::move(handle.workspace_);
     stream_ = handle.stream_;
     scalar_pointer_mode_ = handle.scalar_pointer_mode_;
-
-    handle.workspace_ = nullptr;
-    handle.workspace_size_ = 0;
+    last_operation_ = handle.last_operation_;
+    statistics_ = std::move(handle.statistics_);
 
     return *this;
 }
@@ -109,6 +192,11 @@ int Handle::compute_capability() const {
     return device_.major * 10 + device_.minor;
 }
 
+/// Returns true if the handle was created on a CUDA device
+bool Handle::has_device_() const {
+    return device_.major != 0;
+}
+
 /// Sets the current CUDA stream
 void Handle::set_stream(cudaStream_t stream) {
     stream_ = stream;
@@ -131,42 +219,99 @@ void Handle::set_provider(Provider provider) {
 
 /// Gets the device workspace size
 size_t Handle::get_workspace_size() const {
-    return workspace_size_;
+    return workspace_ ? workspace_->capacity() : 0;
 }
 
 /// Gets a pointer to the device workspace allocation in Global Memory
 void* Handle::get_workspace() const {
-    return workspace_;
+    return workspace_ ? workspace_->data() : nullptr;
 }
 
-/// Sets the size of device workspace, invalidating previous calls to
-/// get_device_workspace()
+/// Grows the device workspace to at least `bytes`, invalidating previous
+/// calls to get_device_workspace()
 void Handle::set_workspace_size(size_t bytes) {
-    if (bytes != workspace_size_) {
-        if (workspace_) {
-            cudaFree(workspace_);
-        }
+    // Host operations need no device workspace
+    if (!has_device_()) {
+        return;
+    }
 
-        workspace_ = nullptr;
-        workspace_size_ = bytes;
+    if (!workspace_) {
+        workspace_ = std::make_shared<WorkspaceArena>();
+    }
 
-        if (workspace_size_) {
-            cudaError_t error =
-                    cudaMalloc((void**)&workspace_, workspace_size_);
+    if (!bytes) {
+        workspace_->release(stream_);
+        return;
+    }
 
-            if (error != cudaSuccess) {
-                throw std::runtime_error("Failed to allocate workspace");
-            }
-        }
+    if (bytes <= workspace_->capacity()) {
+        return;
     }
 
-    if (workspace_) {
-        cudaError_t error = cudaMemset(workspace_, 0, workspace_size_);
+    TraceScope workspace_scope(TraceEventKind::kWorkspace, "workspace");
+    workspace_scope.set_detail("bytes=%zu", bytes);
 
-        if (error != cudaSuccess) {
-            throw std::runtime_error("Failed to clear workspace");
-        }
+    if (workspace_->reserve(bytes, stream_) != Status::kSuccess) {
+        throw std::runtime_error("Failed to allocate workspace");
     }
+
+    ++statistics_.workspace_allocations;
+    statistics_.workspace_bytes_allocated += workspace_->capacity();
+}
+
+/// Replaces the source of device workspace
+void Handle::set_workspace_allocator(
+        std::shared_ptr<WorkspaceAllocator> allocator) {
+    workspace_ = std::make_shared<WorkspaceArena>(allocator);
+}
+
+/// Gets the arena providing device workspace
+std::shared_ptr<WorkspaceArena> Handle::get_workspace_arena() const {
+    return workspace_;
+}
+
+/// Draws device workspace from an arena
+void Handle::set_workspace_arena(std::shared_ptr<WorkspaceArena> arena) {
+    workspace_ = arena ? arena : std::make_shared<WorkspaceArena>();
+}
+
+/// Acquires zero-filled device workspaces, growing the arena if needed
+Status Handle::acquire_workspace_(uint64_t const* bytes, void** workspaces,
+                                  int count) {
+    std::vector<size_t> sizes(count);
+    size_t total = 0;
+
+    for (int i = 0; i < count; ++i) {
+        workspaces[i] = nullptr;
+        sizes[i] = size_t(bytes[i]);
+        total += sizes[i];
+    }
+
+    if (!total) {
+        return Status::kSuccess;
+    }
+
+    if (!workspace_) {
+        workspace_ = std::make_shared<WorkspaceArena>();
+    }
+
+    uint64_t allocation_count = workspace_->allocation_count();
+
+    TraceScope workspace_scope(TraceEventKind::kWorkspace, "workspace");
+
+    Status status =
+            workspace_->acquire(sizes.data(), workspaces, count, stream_);
+
+    if (workspace_->allocation_count() != allocation_count) {
+        ++statistics_.workspace_allocations;
+        statistics_.workspace_bytes_allocated += workspace_->capacity();
+        workspace_scope.set_detail("bytes=%zu", workspace_->capacity());
+    } else {
+        // Only growth of the workspace is traced
+        workspace_scope.cancel();
+    }
+
+    return status;
 }
 
 /// Gets the scalar pointer mode
@@ -184,22 +329,22 @@ Operation const* Handle::get_last_operation() const {
     return last_operation_;
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
+/// Returns a snapshot of the statistics
+HandleStatistics Handle::get_statistics() const { return statistics_; }
 
-/// Returns the maximum required alignment for each operator
-static int maximum_alignment_requirement(GemmDescription const& desc) {
-    return std::max(std::max(desc.A.alignment, desc.B.alignment),
-                    desc.C.alignment);
-}
+/// Clears the statistics
+void Handle::reset_statistics() { statistics_ = HandleStatistics(); }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Returns the largest alignment (in units of elements) the problem satisfies,
 /// starting from a given upper limit.
 static int gemm_problem_alignment(
         int M, int N, int K, NumericTypeID element_A, void const* ptr_A,
-        int lda, int64_t batch_stride_A, NumericTypeID element_B,
-        void const* ptr_B, int ldb, int64_t batch_stride_B,
-        NumericTypeID element_C, void const* ptr_C, int ldc,
-        int64_t batch_stride_C, void const* ptr_D, int ldd,
+        int64_t lda, int64_t batch_stride_A, NumericTypeID element_B,
+        void const* ptr_B, int64_t ldb, int64_t batch_stride_B,
+        NumericTypeID element_C, void const* ptr_C, int64_t ldc,
+        int64_t batch_stride_C, void const* ptr_D, int64_t ldd,
         int64_t batch_stride_D, int max_alignment_in_bytes = 16) {
     void const* pointers[] = {ptr_A, ptr_B, ptr_C, ptr_D};
 
@@ -264,43 +409,36 @@ static int gemm_problem_alignment(
     return 0;
 }
 
-/// Find the best kernel in descending order of preference.
-static Operation const* find_gemm_operation(
-        GemmOperationFunctionalMap::const_iterator operators_it,
-        GemmPreferenceKey const preference_key) {
-    auto cc_it = operators_it->second.upper_bound(preference_key);
-
-    if (cc_it == operators_it->second.begin()) {
-        return nullptr;
-    }
-
-    Operation const* operation = nullptr;
-
-    // Search in descending order of compute capability
-    do {
-        --cc_it;
-
-        // Search tile sizes in order, for now.
-        for (auto const* op : cc_it->second) {
-            GemmDescription const& desc =
-                    static_cast<GemmDescription const&>(op->description());
+/// Describes a GEMM problem in a traced event
+static void set_trace_problem(TraceScope& scope, int M, int N, int K,
+                              int batch_count) {
+    scope.set_detail("m=%d n=%d k=%d batch=%d", M, N, K, batch_count);
+}
 
-            int min_cc = desc.tile_description.minimum_compute_capability;
-            int max_cc = desc.tile_description.maximum_compute_capability;
+/// Kind of event traced when running an operation of the given provider
+static TraceEventKind run_trace_kind(Provider provider) {
+    return (provider == Provider::kReferenceHost ||
+            provider == Provider::kReferenceDevice)
+                   ? TraceEventKind::kReference
+                   : TraceEventKind::kLaunch;
+}
 
-            int op_alignment = maximum_alignment_requirement(desc);
+/// Adds the host time elapsed during its lifetime to a counter
+class DispatchTimer {
+public:
+    explicit DispatchTimer(int64_t& total_ns)
+            : total_ns_(total_ns), start_(std::chrono::steady_clock::now()) {}
 
-            if ((min_cc <= preference_key.compute_capability) &&
-                (preference_key.compute_capability <= max_cc) &&
-                (op_alignment <= preference_key.alignment)) {
-                operation = op;
-                break;
-            }
-        }
-    } while (!operation && cc_it != operators_it->second.begin());
+    ~DispatchTimer() {
+        total_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start_)
+                             .count();
+    }
 
-    return operation;
-}
+private:
+    int64_t& total_ns_;
+    std::chrono::steady_clock::time_point start_;
+};
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -345,23 +483,24 @@ Status Handle::gemm(
         void* ptr_D,  /// Pointer to D matrix
         int ldd       /// Leading dimension of D matrix
 ) {
+    DispatchTimer dispatch_timer(statistics_.dispatch_ns);
+
     //
     // Find the operation
     //
 
+    TraceScope select_scope(TraceEventKind::kSelect, "gemm");
+    set_trace_problem(select_scope, M, N, K, 1);
+
     GemmFunctionalKey key(provider_, GemmKind::kGemm, element_compute,
                           element_scalar, element_A, layout_A, transform_A,
                           element_B, layout_B, transform_B, element_C);
 
-    auto operators_it =
-            Singleton::get().operation_table.gemm_operations.find(key);
-
-    if (operators_it ==
-        Singleton::get().operation_table.gemm_operations.end()) {
-        return cutlass::Status::kErrorNotSupported;
-    }
+    OperationCandidateVector const* candidates =
+            Singleton::get().operation_table.find_gemm_candidates(key);
 
-    if (operators_it->second.empty()) {
+    if (!candidates || candidates->empty()) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
@@ -383,14 +522,18 @@ Status Handle::gemm(
     GemmPreferenceKey preference_key(compute_capability(), alignment);
 
     Operation const* operation =
-            find_gemm_operation(operators_it, preference_key);
+            find_gemm_operation(*candidates, preference_key);
 
     if (!operation) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
     last_operation_ = operation;
 
+    select_scope.set_name(operation->description().name);
+    select_scope.finish();
+
     //
     // Configure operation
     //
@@ -411,13 +554,24 @@ Status Handle::gemm(
     uint64_t device_workspace_size_needed =
             operation->get_device_workspace_size(&configuration);
 
-    if (uint64_t(workspace_size_) < device_workspace_size_needed) {
-        return cutlass::Status::kErrorNotSupported;
+    void* device_workspace = nullptr;
+
+    Status status = acquire_workspace_(device_workspace_size_needed,
+                                       &device_workspace);
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
     }
 
     // Initialize host and device workspaces
-    Status status = operation->initialize(&configuration, host_workspace,
-                                          workspace_, stream_);
+    TraceScope initialize_scope(TraceEventKind::kInitialize,
+                                operation->description().name);
+    set_trace_problem(initialize_scope, M, N, K, 1);
+
+    status = operation->initialize(&configuration, host_workspace,
+                                   device_workspace, stream_);
+
+    initialize_scope.finish();
 
     if (status != cutlass::Status::kSuccess) {
         return status;
@@ -427,7 +581,14 @@ Status Handle::gemm(
     GemmArguments arguments{
             ptr_A, ptr_B, ptr_C, ptr_D, alpha, beta, scalar_pointer_mode_};
 
-    return operation->run(&arguments, host_workspace, workspace_, stream_);
+    TraceScope run_scope(run_trace_kind(provider_),
+                         operation->description().name);
+    set_trace_problem(run_scope, M, N, K, 1);
+
+    ++statistics_.operation_calls[operation];
+
+    return operation->run(&arguments, host_workspace, device_workspace,
+                          stream_);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -487,23 +648,33 @@ Status Handle::gemm_universal(
         int64_t batch_stride_C,  /// Batch stride of C operand
         int64_t batch_stride_D   /// Batch stride of D operand
 ) {
+    DispatchTimer dispatch_timer(statistics_.dispatch_ns);
+
     //
     // Find the operation
     //
 
+    TraceScope select_scope(TraceEventKind::kSelect, "gemm_universal");
+    set_trace_problem(select_scope, M, N, K, batch_count);
+
+    // Device kernels in split-K parallel mode write one partial product per
+    // slice, which are accumulated in workspace and reduced into D. Host
+    // operations compute the whole reduction in one pass.
+    bool reduce_partials = (mode == GemmUniversalMode::kGemmSplitKParallel &&
+                            provider_ == Provider::kCUTLASS);
+
+    NumericTypeID element_partial =
+            reduce_partials ? element_compute : element_C;
+
     GemmFunctionalKey key(provider_, GemmKind::kUniversal, element_compute,
                           element_scalar, element_A, layout_A, transform_A,
-                          element_B, layout_B, transform_B, element_C);
+                          element_B, layout_B, transform_B, element_partial);
 
-    auto operators_it =
-            Singleton::get().operation_table.gemm_operations.find(key);
+    OperationCandidateVector const* candidates =
+            Singleton::get().operation_table.find_gemm_candidates(key);
 
-    if (operators_it ==
-        Singleton::get().operation_table.gemm_operations.end()) {
-        return cutlass::Status::kErrorNotSupported;
-    }
-
-    if (operators_it->second.empty()) {
+    if (!candidates || candidates->empty()) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
@@ -528,10 +699,22 @@ Status Handle::gemm_universal(
         ptr_D_check = nullptr;
     }
 
+    int ldc_check = ldc;
+    int ldd_check = ldd;
+
+    // Partial products are written to aligned workspace with a leading
+    // dimension of M or N, both of which are checked as extents
+    if (reduce_partials) {
+        ptr_C_check = nullptr;
+        ptr_D_check = nullptr;
+        ldc_check = M;
+        ldd_check = M;
+    }
+
     int alignment = gemm_problem_alignment(
             M, N, K, element_A, ptr_A_check, lda, 0, element_B, ptr_B_check,
-            ldb, 0, element_C, ptr_C_check, ldc, 0, ptr_D_check, ldd, 0,
-            kMaximumAlignmentSize);
+            ldb, 0, element_partial, ptr_C_check, ldc_check, 0, ptr_D_check,
+            ldd_check, 0, kMaximumAlignmentSize);
 
     //
     // Find the best kernel in descending order of preference.
@@ -540,20 +723,65 @@ Status Handle::gemm_universal(
     GemmPreferenceKey preference_key(compute_capability(), alignment);
 
     Operation const* operation =
-            find_gemm_operation(operators_it, preference_key);
+            find_gemm_operation(*candidates, preference_key);
 
     if (!operation) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
     last_operation_ = operation;
 
+    select_scope.set_name(operation->description().name);
+    select_scope.finish();
+
     //
     // Configure operation
     //
 
-    GemmUniversalConfiguration configuration{mode, {M, N, K}, batch_count, lda,
-                                             ldb,  ldc,       ldd};
+    // Partial products share the layout of the operation's C operand
+    bool row_major_partials =
+            static_cast<GemmDescription const&>(operation->description())
+                    .C.layout == LayoutTypeID::kRowMajor;
+
+    int ld_partial = row_major_partials ? N : M;
+    int64_t partial_stride = int64_t(M) * N;
+
+    GemmUniversalConfiguration configuration{
+            mode,
+            {M, N, K},
+            batch_count,
+            lda,
+            ldb,
+            reduce_partials ? ld_partial : ldc,
+            reduce_partials ? ld_partial : ldd};
+
+    Operation const* reduction = nullptr;
+    ReductionConfiguration reduction_configuration;
+
+    if (reduce_partials) {
+        ReductionFunctionalKey reduction_key(Provider::kCUTLASS,
+                                             element_compute, element_compute,
+                                             element_C, element_scalar);
+
+        reduction = Singleton::get().operation_table.find_reduction_operation(
+                reduction_key);
+
+        if (!reduction) {
+            ++statistics_.misses[key];
+            return cutlass::Status::kErrorNotSupported;
+        }
+
+        // The reduction is elementwise, so a column-major problem is reduced
+        // as its row-major transpose
+        reduction_configuration.problem_size =
+                row_major_partials ? MatrixCoord(M, N) : MatrixCoord(N, M);
+        reduction_configuration.partitions = batch_count;
+        reduction_configuration.partition_stride = partial_stride;
+        reduction_configuration.ldw = ld_partial;
+        reduction_configuration.lds = ldc;
+        reduction_configuration.ldd = ldd;
+    }
 
     // Query host work space size
     uint64_t host_workspace_size_needed =
@@ -565,17 +793,52 @@ Status Handle::gemm_universal(
 
     char host_workspace[kHostWorkspaceSize];
 
-    // Query device workspace size
-    uint64_t device_workspace_size_needed =
-            operation->get_device_workspace_size(&configuration);
+    char reduction_host_workspace[kHostWorkspaceSize];
 
-    if (uint64_t(workspace_size_) < device_workspace_size_needed) {
+    if (reduction &&
+        uint64_t(kHostWorkspaceSize) <
+                reduction->get_host_workspace_size(&reduction_configuration)) {
         return cutlass::Status::kErrorNotSupported;
     }
 
+    // Query device workspace sizes of the GEMM, the partial products and the
+    // reduction, which are suballocated from one arena
+    uint64_t device_workspace_sizes[3] = {
+            operation->get_device_workspace_size(&configuration), 0, 0};
+
+    if (reduction) {
+        device_workspace_sizes[1] = uint64_t(partial_stride) * batch_count *
+                                    library::sizeof_bits(element_partial) / 8;
+        device_workspace_sizes[2] =
+                reduction->get_device_workspace_size(&reduction_configuration);
+    }
+
+    void* device_workspaces[3];
+
+    Status status = acquire_workspace_(device_workspace_sizes,
+                                       device_workspaces, reduction ? 3 : 1);
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
+    }
+
+    void* device_workspace = device_workspaces[0];
+
     // Initialize host and device workspaces
-    Status status = operation->initialize(&configuration, host_workspace,
-                                          workspace_, stream_);
+    TraceScope initialize_scope(TraceEventKind::kInitialize,
+                                operation->description().name);
+    set_trace_problem(initialize_scope, M, N, K, batch_count);
+
+    status = operation->initialize(&configuration, host_workspace,
+                                   device_workspace, stream_);
+
+    if (status == cutlass::Status::kSuccess && reduction) {
+        status = reduction->initialize(&reduction_configuration,
+                                       reduction_host_workspace,
+                                       device_workspaces[2], stream_);
+    }
+
+    initialize_scope.finish();
 
     if (status != cutlass::Status::kSuccess) {
         return status;
@@ -594,7 +857,56 @@ Status Handle::gemm_universal(
                                      batch_stride_C,
                                      batch_stride_D};
 
-    return operation->run(&arguments, host_workspace, workspace_, stream_);
+    std::vector<uint8_t> one;
+    std::vector<uint8_t> zero;
+
+    if (reduction) {
+        // The GEMM writes unscaled partial products, and the reduction
+        // applies alpha and beta
+        if (!cast_from_double(one, element_scalar, 1) ||
+            !cast_from_double(zero, element_scalar, 0)) {
+            return cutlass::Status::kErrorNotSupported;
+        }
+
+        arguments.C = device_workspaces[1];
+        arguments.D = device_workspaces[1];
+        arguments.alpha = one.data();
+        arguments.beta = zero.data();
+        arguments.pointer_mode = ScalarPointerMode::kHost;
+        arguments.batch_stride_C = partial_stride;
+        arguments.batch_stride_D = partial_stride;
+    }
+
+    TraceScope run_scope(run_trace_kind(provider_),
+                         operation->description().name);
+    set_trace_problem(run_scope, M, N, K, batch_count);
+
+    ++statistics_.operation_calls[operation];
+
+    status = operation->run(&arguments, host_workspace, device_workspace,
+                            stream_);
+
+    run_scope.finish();
+
+    if (status != cutlass::Status::kSuccess || !reduction) {
+        return status;
+    }
+
+    ReductionArguments reduction_arguments{device_workspaces[1],
+                                           ptr_C,
+                                           ptr_D,
+                                           nullptr,
+                                           alpha,
+                                           beta,
+                                           scalar_pointer_mode_};
+
+    TraceScope reduction_scope(run_trace_kind(provider_),
+                               reduction->description().name);
+
+    ++statistics_.operation_calls[reduction];
+
+    return reduction->run(&reduction_arguments, reduction_host_workspace,
+                          device_workspaces[2], stream_);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -655,23 +967,24 @@ Status Handle::gemm_planar_complex(
         int64_t batch_stride_C_real, int64_t batch_stride_C_imag,
 
         int64_t batch_stride_D_real, int64_t batch_stride_D_imag) {
+    DispatchTimer dispatch_timer(statistics_.dispatch_ns);
+
     //
     // Find the operation
     //
 
+    TraceScope select_scope(TraceEventKind::kSelect, "gemm_planar_complex");
+    set_trace_problem(select_scope, M, N, K, batch_count);
+
     GemmFunctionalKey key(provider_, GemmKind::kPlanarComplex, element_compute,
                           element_scalar, element_A, layout_A, transform_A,
                           element_B, layout_B, transform_B, element_C);
 
-    auto operators_it =
-            Singleton::get().operation_table.gemm_operations.find(key);
+    OperationCandidateVector const* candidates =
+            Singleton::get().operation_table.find_gemm_candidates(key);
 
-    if (operators_it ==
-        Singleton::get().operation_table.gemm_operations.end()) {
-        return cutlass::Status::kErrorNotSupported;
-    }
-
-    if (operators_it->second.empty()) {
+    if (!candidates || candidates->empty()) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
@@ -703,14 +1016,18 @@ Status Handle::gemm_planar_complex(
     GemmPreferenceKey preference_key(compute_capability(), alignment);
 
     Operation const* operation =
-            find_gemm_operation(operators_it, preference_key);
+            find_gemm_operation(*candidates, preference_key);
 
     if (!operation) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
     last_operation_ = operation;
 
+    select_scope.set_name(operation->description().name);
+    select_scope.finish();
+
     //
     // Configure operation
     //
@@ -741,13 +1058,24 @@ Status Handle::gemm_planar_complex(
     uint64_t device_workspace_size_needed =
             operation->get_device_workspace_size(&configuration);
 
-    if (uint64_t(workspace_size_) < device_workspace_size_needed) {
-        return cutlass::Status::kErrorNotSupported;
+    void* device_workspace = nullptr;
+
+    Status status = acquire_workspace_(device_workspace_size_needed,
+                                       &device_workspace);
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
     }
 
     // Initialize host and device workspaces
-    Status status = operation->initialize(&configuration, host_workspace,
-                                          workspace_, stream_);
+    TraceScope initialize_scope(TraceEventKind::kInitialize,
+                                operation->description().name);
+    set_trace_problem(initialize_scope, M, N, K, batch_count);
+
+    status = operation->initialize(&configuration, host_workspace,
+                                   device_workspace, stream_);
+
+    initialize_scope.finish();
 
     if (status != cutlass::Status::kSuccess) {
         return status;
@@ -774,7 +1102,14 @@ Status Handle::gemm_planar_complex(
                                          batch_stride_D_real,
                                          batch_stride_D_imag};
 
-    return operation->run(&arguments, host_workspace, workspace_, stream_);
+    TraceScope run_scope(run_trace_kind(provider_),
+                         operation->description().name);
+    set_trace_problem(run_scope, M, N, K, batch_count);
+
+    ++statistics_.operation_calls[operation];
+
+    return operation->run(&arguments, host_workspace, device_workspace,
+                          stream_);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -848,24 +1183,25 @@ Status Handle::gemm_planar_complex_array(
         int ldd_real,  /// Leading dimension of real part of D matrix
         int ldd_imag   /// Leading dimension of imaginary part of D matrix
 ) {
+    DispatchTimer dispatch_timer(statistics_.dispatch_ns);
+
     //
     // Find the operation
     //
 
+    TraceScope select_scope(TraceEventKind::kSelect, "gemm_planar_complex_array");
+    set_trace_problem(select_scope, expected_M, expected_N, expected_K, batch_count);
+
     GemmFunctionalKey key(provider_, GemmKind::kPlanarComplexArray,
                           element_compute, element_scalar, element_A, layout_A,
                           transform_A, element_B, layout_B, transform_B,
                           element_C);
 
-    auto operators_it =
-            Singleton::get().operation_table.gemm_operations.find(key);
+    OperationCandidateVector const* candidates =
+            Singleton::get().operation_table.find_gemm_candidates(key);
 
-    if (operators_it ==
-        Singleton::get().operation_table.gemm_operations.end()) {
-        return cutlass::Status::kErrorNotSupported;
-    }
-
-    if (operators_it->second.empty()) {
+    if (!candidates || candidates->empty()) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
@@ -895,14 +1231,18 @@ Status Handle::gemm_planar_complex_array(
     GemmPreferenceKey preference_key(compute_capability(), alignment);
 
     Operation const* operation =
-            find_gemm_operation(operators_it, preference_key);
+            find_gemm_operation(*candidates, preference_key);
 
     if (!operation) {
+        ++statistics_.misses[key];
         return cutlass::Status::kErrorNotSupported;
     }
 
     last_operation_ = operation;
 
+    select_scope.set_name(operation->description().name);
+    select_scope.finish();
+
     //
     // Configure operation
     //
@@ -933,13 +1273,24 @@ Status Handle::gemm_planar_complex_array(
     uint64_t device_workspace_size_needed =
             operation->get_device_workspace_size(&configuration);
 
-    if (uint64_t(workspace_size_) < device_workspace_size_needed) {
-        return cutlass::Status::kErrorNotSupported;
+    void* device_workspace = nullptr;
+
+    Status status = acquire_workspace_(device_workspace_size_needed,
+                                       &device_workspace);
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
     }
 
     // Initialize host and device workspaces
-    Status status = operation->initialize(&configuration, host_workspace,
-                                          workspace_, stream_);
+    TraceScope initialize_scope(TraceEventKind::kInitialize,
+                                operation->description().name);
+    set_trace_problem(initialize_scope, expected_M, expected_N, expected_K, batch_count);
+
+    status = operation->initialize(&configuration, host_workspace,
+                                   device_workspace, stream_);
+
+    initialize_scope.finish();
 
     if (status != cutlass::Status::kSuccess) {
         return status;
@@ -951,7 +1302,192 @@ Status Handle::gemm_planar_complex_array(
             ptr_B_real, ptr_B_imag, ptr_C_real, ptr_C_imag,          ptr_D_real,
             ptr_D_imag, alpha,      beta,       scalar_pointer_mode_};
 
-    return operation->run(&arguments, host_workspace, workspace_, stream_);
+    TraceScope run_scope(run_trace_kind(provider_),
+                         operation->description().name);
+    set_trace_problem(run_scope, expected_M, expected_N, expected_K, batch_count);
+
+    ++statistics_.operation_calls[operation];
+
+    return operation->run(&arguments, host_workspace, device_workspace,
+                          stream_);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Grouped GEMM computing many independent problems of different shapes in a
+/// single launch
+Status Handle::gemm_grouped(
+
+        int problem_count,  /// Number of GEMM problems in the group
+
+        gemm::GemmCoord const* problem_sizes,  /// Size of each problem
+
+        NumericTypeID element_compute,  /// Data type of internal accumulation
+
+        NumericTypeID element_scalar,  /// Data type of alpha/beta scalars
+
+        void const* alpha,  /// Pointer to alpha scalar
+
+        NumericTypeID element_A,  /// Data type of A matrix elements
+        LayoutTypeID layout_A,    /// Layout of A matrix
+        ComplexTransform
+                transform_A,  /// Complex transformation applied to A matrix
+
+        void const* const* ptr_A,  /// Pointer to each A matrix
+        int64_t const* lda,        /// Leading dimension of each A matrix
+
+        NumericTypeID element_B,  /// Data type of B matrix elements
+        LayoutTypeID layout_B,    /// Layout of B matrix
+        ComplexTransform
+                transform_B,  /// Complex transformation applied to B matrix
+
+        void const* const* ptr_B,  /// Pointer to each B matrix
+        int64_t const* ldb,        /// Leading dimension of each B matrix
+
+        void const* beta,  /// Pointer to beta scalar
+
+        NumericTypeID element_C,  /// Data type of C and D matrices
+
+        void const* const* ptr_C,  /// Pointer to each C matrix
+        int64_t const* ldc,        /// Leading dimension of each C matrix
+
+        void* const* ptr_D,  /// Pointer to each D matrix
+        int64_t const* ldd,  /// Leading dimension of each D matrix
+
+        int threadblock_count  /// Number of persistent threadblocks
+) {
+    if (problem_count < 0 || threadblock_count < 0) {
+        return cutlass::Status::kErrorInvalidProblem;
+    }
+
+    // An empty group has nothing to compute
+    if (!problem_count) {
+        return cutlass::Status::kSuccess;
+    }
+
+    DispatchTimer dispatch_timer(statistics_.dispatch_ns);
+
+    //
+    // Find the operation
+    //
+
+    TraceScope select_scope(TraceEventKind::kSelect, "gemm_grouped");
+    select_scope.set_detail("problems=%d", problem_count);
+
+    GemmFunctionalKey key(provider_, GemmKind::kGrouped, element_compute,
+                          element_scalar, element_A, layout_A, transform_A,
+                          element_B, layout_B, transform_B, element_C);
+
+    OperationCandidateVector const* candidates =
+            Singleton::get().operation_table.find_gemm_candidates(key);
+
+    if (!candidates || candidates->empty()) {
+        ++statistics_.misses[key];
+        return cutlass::Status::kErrorNotSupported;
+    }
+
+    //
+    // Compute the largest alignment restriction every problem satisfies.
+    //
+
+    // Maximum alignment expectation among all kernels (in units of bytes)
+    int const kMaximumAlignmentSize = 16;
+
+    int alignment = std::numeric_limits<int>::max();
+
+    for (int idx = 0; idx < problem_count; ++idx) {
+        alignment = std::min(
+                alignment,
+                gemm_problem_alignment(
+                        problem_sizes[idx].m(), problem_sizes[idx].n(),
+                        problem_sizes[idx].k(), element_A, ptr_A[idx],
+                        lda[idx], 0, element_B, ptr_B[idx], ldb[idx], 0,
+                        element_C, ptr_C[idx], ldc[idx], 0, ptr_D[idx],
+                        ldd[idx], 0, kMaximumAlignmentSize));
+    }
+
+    //
+    // Find the best kernel in descending order of preference.
+    //
+
+    GemmPreferenceKey preference_key(compute_capability(), alignment);
+
+    Operation const* operation =
+            find_gemm_operation(*candidates, preference_key);
+
+    if (!operation) {
+        ++statistics_.misses[key];
+        return cutlass::Status::kErrorNotSupported;
+    }
+
+    last_operation_ = operation;
+
+    select_scope.set_name(operation->description().name);
+    select_scope.finish();
+
+    //
+    // Configure operation
+    //
+
+    GemmGroupedConfiguration configuration{
+            problem_count, threadblock_count, problem_sizes, lda, ldb, ldc,
+            ldd};
+
+    GemmGroupedArguments arguments{ptr_A, ptr_B, ptr_C, ptr_D,
+                                   alpha, beta,  scalar_pointer_mode_};
+
+    Status status = operation->can_implement(&configuration, &arguments);
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
+    }
+
+    // Query host work space size
+    uint64_t host_workspace_size_needed =
+            operation->get_host_workspace_size(&configuration);
+
+    if (uint64_t(kHostWorkspaceSize) < host_workspace_size_needed) {
+        return cutlass::Status::kErrorNotSupported;
+    }
+
+    char host_workspace[kHostWorkspaceSize];
+
+    // Query device workspace size
+    uint64_t device_workspace_size_needed =
+            operation->get_device_workspace_size(&configuration);
+
+    void* device_workspace = nullptr;
+
+    status = acquire_workspace_(device_workspace_size_needed,
+                                &device_workspace);
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
+    }
+
+    // Initialize host and device workspaces
+    TraceScope initialize_scope(TraceEventKind::kInitialize,
+                                operation->description().name);
+    initialize_scope.set_detail("problems=%d", problem_count);
+
+    status = operation->initialize(&configuration, host_workspace,
+                                   device_workspace, stream_);
+
+    initialize_scope.finish();
+
+    if (status != cutlass::Status::kSuccess) {
+        return status;
+    }
+
+    // Run the operator
+    TraceScope run_scope(run_trace_kind(provider_),
+                         operation->description().name);
+    run_scope.set_detail("problems=%d", problem_count);
+
+    ++statistics_.operation_calls[operation];
+
+    return operation->run(&arguments, host_workspace, device_workspace,
+                          stream_);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -981,39 +1517,30 @@ Operation const* find_conv_operation_for_parallel_reduction(
             conv_desc.tile_description.math_instruction.element_accumulator,
             conv_desc.element_epilogue);
 
-    // conv operation table for conv2d or conv3d
-    auto conv_operations =
+    // find ConvFunctionalKey in conv2d or conv3d operation table
+    OperationCandidateVector const* candidates =
             (conv_desc.kind == OperationKind::kConv2d)
-                    ? Singleton::get().operation_table.conv2d_operations
-                    : Singleton::get().operation_table.conv3d_operations;
-
-    // find ConvFunctionalKey in convolution operation table
-    auto operators_it = conv_operations.find(key);
-
-    if (operators_it == conv_operations.end()) {
-        return nullptr;
-    }
-
-    if (operators_it->second.empty()) {
-        return nullptr;
-    }
-
-    // conv operation for same compute capability and iterator algorithm
-    ConvPreferenceKey preference_key(
-            conv_desc.tile_description.minimum_compute_capability,
-            conv_desc.iterator_algorithm);
-
-    auto it = operators_it->second.find(preference_key);
+                    ? Singleton::get().operation_table.find_conv2d_candidates(
+                              key)
+                    : Singleton::get().operation_table.find_conv3d_candidates(
+                              key);
 
-    if (it == operators_it->second.end()) {
+    if (!candidates || candidates->empty()) {
         return nullptr;
     }
 
-    // return matching conv opertion (same tile sizes and instruction)
-    for (auto op : it->second) {
-        if (op->description().tile_description ==
-            operation->description().tile_description) {
-            return op;
+    TileDescription const& tile = conv_desc.tile_description;
+
+    // return matching conv opertion for same compute capability and iterator
+    // algorithm (same tile sizes and instruction)
+    for (auto const& candidate : *candidates) {
+        if (candidate.minimum_compute_capability ==
+                    tile.minimum_compute_capability &&
+            candidate.iterator_algorithm == conv_desc.iterator_algorithm &&
+            candidate.threadblock_shape == tile.threadblock_shape &&
+            candidate.stages == tile.threadblock_stages &&
+            candidate.operation->description().tile_description == tile) {
+            return candidate.operation;
         }
     }
 
@@ -0,0 +1,239 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Pool of Handles leased to concurrent callers, each bound to a
+      caller's stream.
+*/
+
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include "cutlass/library/handle_pool.h"
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Shard of the idle handles used by the calling thread
+int thread_shard() {
+    static thread_local int shard =
+            int(std::hash<std::thread::id>()(std::this_thread::get_id()) %
+                HandlePool::kShardCount);
+    return shard;
+}
+
+/// Shard of the arena of a stream
+int stream_shard(cudaStream_t stream) {
+    return int(std::hash<cudaStream_t>()(stream) % HandlePool::kShardCount);
+}
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+HandleLease::HandleLease() : pool_(nullptr), shard_(0), stream_(nullptr) {}
+
+HandleLease::HandleLease(HandleLease&& lease)
+        : pool_(lease.pool_),
+          handle_(std::move(lease.handle_)),
+          shard_(lease.shard_),
+          stream_(lease.stream_),
+          arena_(std::move(lease.arena_)) {}
+
+HandleLease& HandleLease::operator=(HandleLease&& lease) {
+    if (this != &lease) {
+        release();
+        pool_ = lease.pool_;
+        handle_ = std::move(lease.handle_);
+        shard_ = lease.shard_;
+        stream_ = lease.stream_;
+        arena_ = std::move(lease.arena_);
+    }
+    return *this;
+}
+
+HandleLease::~HandleLease() { release(); }
+
+/// Returns the handle to the pool
+void HandleLease::release() {
+    if (handle_) {
+        pool_->release_(std::move(handle_), shard_, stream_,
+                        std::move(arena_));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+HandlePool::HandlePool(size_t workspace_size,
+                       std::shared_ptr<WorkspaceAllocator> allocator)
+        : workspace_size_(workspace_size),
+          allocator_(allocator),
+          idle_arena_(std::make_shared<WorkspaceArena>(allocator)),
+          handle_shards_(new HandleShard[kShardCount]),
+          stream_shards_(new StreamShard[kShardCount]) {
+    // The first handle determines the default provider, which is kHost
+    // without a CUDA device
+    std::unique_ptr<Handle> handle(new Handle(nullptr, 0));
+    default_provider_ = handle->get_provider();
+    handle->set_workspace_arena(idle_arena_);
+
+    HandleShard& shard = handle_shards_[thread_shard()];
+    shard.handles.push_back(std::move(handle));
+    shard.constructed = 1;
+}
+
+HandlePool::~HandlePool() {}
+
+/// Takes an idle arena of a stream, creating one if none is idle
+std::shared_ptr<WorkspaceArena> HandlePool::acquire_arena_(
+        cudaStream_t stream) {
+    StreamShard& shard = stream_shards_[stream_shard(stream)];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        std::vector<std::shared_ptr<WorkspaceArena>>& arenas =
+                shard.streams[stream].arenas;
+
+        if (!arenas.empty()) {
+            std::shared_ptr<WorkspaceArena> arena = std::move(arenas.back());
+            arenas.pop_back();
+            return arena;
+        }
+    }
+
+    // Allocation happens outside the lock, as it may synchronize
+    std::shared_ptr<WorkspaceArena> arena =
+            std::make_shared<WorkspaceArena>(allocator_);
+
+    if (workspace_size_ &&
+        arena->reserve(workspace_size_, stream) != Status::kSuccess) {
+        throw std::runtime_error("Failed to allocate workspace");
+    }
+
+    return arena;
+}
+
+HandleLease HandlePool::acquire(cudaStream_t stream) {
+    HandleLease lease;
+    lease.pool_ = this;
+    lease.shard_ = thread_shard();
+    lease.stream_ = stream;
+    lease.arena_ = acquire_arena_(stream);
+
+    HandleShard& shard = handle_shards_[lease.shard_];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.handles.empty()) {
+            lease.handle_ = std::move(shard.handles.back());
+            shard.handles.pop_back();
+        }
+    }
+
+    if (!lease.handle_) {
+        lease.handle_.reset(new Handle(stream, 0));
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.constructed;
+    }
+
+    lease.handle_->set_stream(stream);
+    lease.handle_->set_provider(default_provider_);
+    lease.handle_->set_scalar_pointer_mode(ScalarPointerMode::kHost);
+    lease.handle_->set_workspace_arena(lease.arena_);
+
+    return lease;
+}
+
+/// Returns a handle to its idle list and an arena to its stream's
+void HandlePool::release_(std::unique_ptr<Handle> handle, int shard,
+                          cudaStream_t stream,
+                          std::shared_ptr<WorkspaceArena> arena) {
+    // Idle handles hold an empty arena, so that the lease's arena may be
+    // handed to another lease or released with its stream
+    handle->set_workspace_arena(idle_arena_);
+    {
+        std::lock_guard<std::mutex> lock(handle_shards_[shard].mutex);
+        handle_shards_[shard].handles.push_back(std::move(handle));
+    }
+
+    StreamShard& streams = stream_shards_[stream_shard(stream)];
+    std::lock_guard<std::mutex> lock(streams.mutex);
+
+    // Arenas of a released stream are dropped
+    auto it = streams.streams.find(stream);
+    if (it != streams.streams.end()) {
+        it->second.arenas.push_back(std::move(arena));
+    }
+}
+
+/// Releases the idle arenas of a stream and forgets the stream
+void HandlePool::release_stream(cudaStream_t stream) {
+    StreamWorkspace workspace;
+    {
+        StreamShard& shard = stream_shards_[stream_shard(stream)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.streams.find(stream);
+        if (it == shard.streams.end()) {
+            return;
+        }
+        workspace = std::move(it->second);
+        shard.streams.erase(it);
+    }
+
+    // The arenas are destroyed outside the lock, releasing their allocations
+    // on the stream
+}
+
+size_t HandlePool::handle_count() const {
+    size_t count = 0;
+    for (int idx = 0; idx < kShardCount; ++idx) {
+        std::lock_guard<std::mutex> lock(handle_shards_[idx].mutex);
+        count += handle_shards_[idx].constructed;
+    }
+    return count;
+}
+
+size_t HandlePool::stream_count() const {
+    size_t count = 0;
+    for (int idx = 0; idx < kShardCount; ++idx) {
+        std::lock_guard<std::mutex> lock(stream_shards_[idx].mutex);
+        count += stream_shards_[idx].streams.size();
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
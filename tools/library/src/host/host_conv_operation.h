@@ -0,0 +1,532 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+  \brief Defines host (CPU) operations for Conv2d and Conv3d operation kinds in
+  CUTLASS Library
+
+    Convolutions are computed as implicit GEMMs by the engine in
+    host_kernels.h:
+
+      Fprop: M = N*Z*P*Q, N = K, K = T*R*S*C
+      Dgrad: M = N*D*H*W, N = C, K = T*R*S*K
+      Wgrad: M = K,       N = T*R*S*C, K = N*Z*P*Q
+
+    Conv2d problems are handled as Conv3d problems with D = T = Z = 1.
+*/
+
+#pragma once
+
+#include <cstring>
+#include <sstream>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_conversion.h"
+#include "cutlass/tensor_ref.h"
+#include "cutlass/layout/tensor.h"
+#include "cutlass/conv/conv2d_problem_size.h"
+#include "cutlass/conv/conv3d_problem_size.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+#include "library_internal.h"
+
+#include "host_kernels.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Convolution problem and operand layouts in NDHWC form
+struct HostConvProblem {
+    conv::Conv3dProblemSize problem_size;
+    layout::TensorNDHWC layout_a;
+    layout::TensorNDHWC layout_b;
+    layout::TensorNDHWC layout_c;
+};
+
+/// Views an NHWC layout as an NDHWC layout of depth 1
+inline layout::TensorNDHWC make_ndhwc(layout::TensorNHWC const& layout) {
+    return layout::TensorNDHWC(layout.stride()[0], layout.stride()[1],
+                               layout.stride()[2], layout.stride()[2]);
+}
+
+inline HostConvProblem make_host_conv_problem(
+        Conv2dConfiguration const& configuration, ConvKind conv_kind) {
+    HostConvProblem problem;
+
+    static_cast<conv::Conv2dProblemSize&>(problem.problem_size) =
+            configuration.problem_size;
+
+    problem.problem_size.D = 1;
+    problem.problem_size.T = 1;
+    problem.problem_size.Z = 1;
+    problem.problem_size.pad_d = 0;
+    problem.problem_size.stride_d = 1;
+    problem.problem_size.dilation_d = 1;
+
+    problem.layout_a = make_ndhwc(configuration.layout_a(conv_kind));
+    problem.layout_b = make_ndhwc(configuration.layout_b(conv_kind));
+    problem.layout_c = make_ndhwc(configuration.layout_c(conv_kind));
+
+    return problem;
+}
+
+inline HostConvProblem make_host_conv_problem(
+        Conv3dConfiguration const& configuration, ConvKind conv_kind) {
+    HostConvProblem problem;
+
+    problem.problem_size = configuration.problem_size;
+    problem.layout_a = configuration.layout_a(conv_kind);
+    problem.layout_b = configuration.layout_b(conv_kind);
+    problem.layout_c = configuration.layout_c(conv_kind);
+
+    return problem;
+}
+
+/// Position (n, z, p, q) or (n, d, h, w) of an activation-like tensor
+struct HostConvPosition {
+    int n;
+    int d;
+    int h;
+    int w;
+
+    HostConvPosition(int index, int D, int H, int W) {
+        w = index % W;
+        index /= W;
+        h = index % H;
+        index /= H;
+        d = index % D;
+        n = index / D;
+    }
+};
+
+/// Filter tap (t, r, s) and channel of a T*R*S*channels GEMM index. The tap
+/// is flipped for cross-correlation versus convolution as in the reference.
+struct HostConvFilterTap {
+    int t;
+    int r;
+    int s;
+    int channel;
+
+    /// Flipped tap used to compute activation offsets
+    int filter_t;
+    int filter_r;
+    int filter_s;
+
+    HostConvFilterTap(int index, int channels,
+                      conv::Conv3dProblemSize const& problem_size) {
+        channel = index % channels;
+        index /= channels;
+        s = index % problem_size.S;
+        index /= problem_size.S;
+        r = index % problem_size.R;
+        t = index / problem_size.R;
+
+        filter_t = t;
+        filter_r = r;
+        filter_s = s;
+
+        if (problem_size.mode == conv::Mode::kConvolution) {
+            filter_t = problem_size.T - 1 - t;
+            filter_r = problem_size.R - 1 - r;
+            filter_s = problem_size.S - 1 - s;
+        }
+    }
+};
+
+}  // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Convolution executed on the host by the blocked, multithreaded engine in
+/// host_kernels.h
+template <conv::Operator ConvolutionalOperator, int ConvDim,
+          typename ElementA_, typename LayoutA_, typename ElementB_,
+          typename LayoutB_, typename ElementC_, typename LayoutC_,
+          typename ElementCompute_,
+          typename ElementAccumulator_ = ElementCompute_,
+          typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_> >
+class HostConvOperation : public Operation {
+public:
+    static conv::Operator const kConvolutionalOperator = ConvolutionalOperator;
+    static int const kConvDim = ConvDim;
+
+    using ElementA = ElementA_;
+    using LayoutA = LayoutA_;
+    using ElementB = ElementB_;
+    using LayoutB = LayoutB_;
+    using ElementC = ElementC_;
+    using LayoutC = LayoutC_;
+    using ElementCompute = ElementCompute_;
+    using ElementAccumulator = ElementAccumulator_;
+    using ConvertOp = ConvertOp_;
+
+    /// Type in which the engine accumulates
+    using HostAccumulator =
+            typename host::HostAccumulator<ElementAccumulator>::Type;
+
+    using Configuration =
+            typename std::conditional<kConvDim == 2, Conv2dConfiguration,
+                                      Conv3dConfiguration>::type;
+
+protected:
+    /// Storage for the name string
+    std::string name_;
+
+    ///
+    ConvDescription description_;
+
+public:
+    /// Constructor
+    HostConvOperation() {
+        // Basic information
+        description_.provider = Provider::kHost;
+        description_.kind = (kConvDim == 2 ? OperationKind::kConv2d
+                                           : OperationKind::kConv3d);
+        description_.conv_kind = ConvKindMap<kConvolutionalOperator>::kId;
+        description_.conv_dim = kConvDim;
+
+        // Tensor description
+        description_.A = make_TensorDescription<ElementA, LayoutA>();
+        description_.B = make_TensorDescription<ElementB, LayoutB>();
+        description_.C = make_TensorDescription<ElementC, LayoutC>();
+
+        // Epilogue compute and accumulator type description
+        description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+
+        description_.tile_description.math_instruction.element_accumulator =
+                NumericTypeMap<ElementAccumulator>::kId;
+
+        description_.tile_description.threadblock_shape = make_Coord(
+                host::GemmBlocking<HostAccumulator>::kMC,
+                host::GemmBlocking<HostAccumulator>::kNC,
+                host::GemmBlocking<HostAccumulator>::kKC);
+
+        description_.iterator_algorithm = IteratorAlgorithmID::kNone;
+
+        // Host operations do not depend on a device
+        description_.tile_description.minimum_compute_capability = 0;
+        description_.tile_description.maximum_compute_capability = 1024;
+
+        // Procedural name
+        std::stringstream ss;
+
+        ss << "conv" << kConvDim << "d_" << to_string(description_.conv_kind)
+           << "_" << to_string(description_.provider) << "_"
+           << to_string(description_.A.element)
+           << to_string(description_.A.layout) << "_"
+           << to_string(description_.B.element)
+           << to_string(description_.B.layout) << "_"
+           << to_string(description_.C.element)
+           << to_string(description_.C.layout) << "_"
+           << to_string(description_.tile_description.math_instruction
+                                .element_accumulator);
+
+        name_ = ss.str();
+
+        description_.name = name_.c_str();
+    }
+
+    /// Returns the description of the convolution operation
+    virtual OperationDescription const& description() const {
+        return description_;
+    }
+
+    virtual Status can_implement(void const* configuration_ptr,
+                                 void const* arguments_ptr) const {
+        Configuration const& configuration =
+                *static_cast<Configuration const*>(configuration_ptr);
+        ConvArguments const& arguments =
+                *static_cast<ConvArguments const*>(arguments_ptr);
+
+        if (arguments.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        if (configuration.problem_size.groups != 1) {
+            return Status::kErrorNotSupported;
+        }
+
+        return Status::kSuccess;
+    }
+
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(Configuration);
+    }
+
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration) const {
+        return 0;
+    }
+
+    virtual Status initialize(void const* configuration, void* host_workspace,
+                              void* device_workspace = nullptr,
+                              cudaStream_t stream = nullptr) const {
+        std::memcpy(host_workspace, configuration,
+                    get_host_workspace_size(configuration));
+
+        return Status::kSuccess;
+    }
+
+    virtual Status run(void const* arguments_ptr, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        Configuration const& configuration =
+                *static_cast<Configuration const*>(host_workspace);
+        ConvArguments const& arguments =
+                *static_cast<ConvArguments const*>(arguments_ptr);
+
+        if (arguments.pointer_mode != ScalarPointerMode::kHost ||
+            configuration.problem_size.groups != 1) {
+            return Status::kErrorNotSupported;
+        }
+
+        detail::HostConvProblem problem = detail::make_host_conv_problem(
+                configuration, ConvKindMap<kConvolutionalOperator>::kId);
+
+        ElementCompute alpha =
+                *static_cast<ElementCompute const*>(arguments.alpha);
+        ElementCompute beta =
+                *static_cast<ElementCompute const*>(arguments.beta);
+
+        TensorRef<ElementA, layout::TensorNDHWC> ref_A(
+                static_cast<ElementA*>(const_cast<void*>(arguments.A)),
+                problem.layout_a);
+        TensorRef<ElementB, layout::TensorNDHWC> ref_B(
+                static_cast<ElementB*>(const_cast<void*>(arguments.B)),
+                problem.layout_b);
+        TensorRef<ElementC, layout::TensorNDHWC> ref_C(
+                static_cast<ElementC*>(const_cast<void*>(arguments.C)),
+                problem.layout_c);
+        TensorRef<ElementC, layout::TensorNDHWC> ref_D(
+                static_cast<ElementC*>(arguments.D), problem.layout_c);
+
+        switch (kConvolutionalOperator) {
+            case conv::Operator::kFprop:
+                fprop_(problem.problem_size, ref_A, ref_B, ref_C, ref_D, alpha,
+                       beta);
+                break;
+            case conv::Operator::kDgrad:
+                dgrad_(problem.problem_size, ref_A, ref_B, ref_C, ref_D, alpha,
+                       beta);
+                break;
+            case conv::Operator::kWgrad:
+                wgrad_(problem.problem_size, ref_A, ref_B, ref_C, ref_D, alpha,
+                       beta);
+                break;
+            default:
+                return Status::kErrorNotSupported;
+        }
+
+        return Status::kSuccess;
+    }
+
+protected:
+    template <typename Element>
+    static HostAccumulator load_(Element const& x) {
+        return HostAccumulator(ElementAccumulator(x));
+    }
+
+    /// Applies the linear combination epilogue to one element of the output
+    static void store_(TensorRef<ElementC, layout::TensorNDHWC> ref_C,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_D,
+                       Tensor5DCoord const& coord, HostAccumulator const& accum,
+                       ElementCompute alpha, ElementCompute beta) {
+        ConvertOp convert_op;
+
+        ElementCompute result =
+                alpha * ElementCompute(ElementAccumulator(accum));
+
+        if (!(beta == ElementCompute())) {
+            ElementC c = ref_C.at(coord);
+            result = result + beta * ElementCompute(c);
+        }
+
+        ref_D.at(coord) = convert_op(result);
+    }
+
+    /// y = fprop(x, w)
+    static void fprop_(conv::Conv3dProblemSize const& ps,
+                       TensorRef<ElementA, layout::TensorNDHWC> ref_x,
+                       TensorRef<ElementB, layout::TensorNDHWC> ref_w,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_y_in,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_y_out,
+                       ElementCompute alpha, ElementCompute beta) {
+        auto load_a = [&](int, int m, int k) {
+            detail::HostConvPosition out(m, ps.Z, ps.P, ps.Q);
+            detail::HostConvFilterTap tap(k, ps.C, ps);
+
+            int d = out.d * ps.stride_d - ps.pad_d +
+                    tap.filter_t * ps.dilation_d;
+            int h = out.h * ps.stride_h - ps.pad_h +
+                    tap.filter_r * ps.dilation_h;
+            int w = out.w * ps.stride_w - ps.pad_w +
+                    tap.filter_s * ps.dilation_w;
+
+            if (d < 0 || d >= ps.D || h < 0 || h >= ps.H || w < 0 ||
+                w >= ps.W) {
+                return HostAccumulator();
+            }
+
+            ElementA x = ref_x.at(Tensor5DCoord(out.n, d, h, w, tap.channel));
+            return load_(x);
+        };
+
+        auto load_b = [&](int, int k, int n) {
+            detail::HostConvFilterTap tap(k, ps.C, ps);
+
+            ElementB w =
+                    ref_w.at(Tensor5DCoord(n, tap.t, tap.r, tap.s, tap.channel));
+            return load_(w);
+        };
+
+        auto store = [&](int, int m, int n, HostAccumulator const& accum) {
+            detail::HostConvPosition out(m, ps.Z, ps.P, ps.Q);
+
+            store_(ref_y_in, ref_y_out,
+                   Tensor5DCoord(out.n, out.d, out.h, out.w, n), accum, alpha,
+                   beta);
+        };
+
+        host::gemm<HostAccumulator>(1, ps.N * ps.Z * ps.P * ps.Q, ps.K,
+                                    ps.T * ps.R * ps.S * ps.C, load_a, load_b,
+                                    store);
+    }
+
+    /// dx = dgrad(dy, w)
+    static void dgrad_(conv::Conv3dProblemSize const& ps,
+                       TensorRef<ElementA, layout::TensorNDHWC> ref_dy,
+                       TensorRef<ElementB, layout::TensorNDHWC> ref_w,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_dx_in,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_dx_out,
+                       ElementCompute alpha, ElementCompute beta) {
+        auto load_a = [&](int, int m, int k) {
+            detail::HostConvPosition in(m, ps.D, ps.H, ps.W);
+            detail::HostConvFilterTap tap(k, ps.K, ps);
+
+            int z = in.d + ps.pad_d - tap.filter_t * ps.dilation_d;
+            int p = in.h + ps.pad_h - tap.filter_r * ps.dilation_h;
+            int q = in.w + ps.pad_w - tap.filter_s * ps.dilation_w;
+
+            if (z < 0 || (z % ps.stride_d) || p < 0 || (p % ps.stride_h) ||
+                q < 0 || (q % ps.stride_w)) {
+                return HostAccumulator();
+            }
+
+            z /= ps.stride_d;
+            p /= ps.stride_h;
+            q /= ps.stride_w;
+
+            if (z >= ps.Z || p >= ps.P || q >= ps.Q) {
+                return HostAccumulator();
+            }
+
+            ElementA dy = ref_dy.at(Tensor5DCoord(in.n, z, p, q, tap.channel));
+            return load_(dy);
+        };
+
+        auto load_b = [&](int, int k, int n) {
+            detail::HostConvFilterTap tap(k, ps.K, ps);
+
+            ElementB w =
+                    ref_w.at(Tensor5DCoord(tap.channel, tap.t, tap.r, tap.s, n));
+            return load_(w);
+        };
+
+        auto store = [&](int, int m, int n, HostAccumulator const& accum) {
+            detail::HostConvPosition in(m, ps.D, ps.H, ps.W);
+
+            store_(ref_dx_in, ref_dx_out,
+                   Tensor5DCoord(in.n, in.d, in.h, in.w, n), accum, alpha,
+                   beta);
+        };
+
+        host::gemm<HostAccumulator>(1, ps.N * ps.D * ps.H * ps.W, ps.C,
+                                    ps.T * ps.R * ps.S * ps.K, load_a, load_b,
+                                    store);
+    }
+
+    /// dw = wgrad(dy, x)
+    static void wgrad_(conv::Conv3dProblemSize const& ps,
+                       TensorRef<ElementA, layout::TensorNDHWC> ref_dy,
+                       TensorRef<ElementB, layout::TensorNDHWC> ref_x,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_dw_in,
+                       TensorRef<ElementC, layout::TensorNDHWC> ref_dw_out,
+                       ElementCompute alpha, ElementCompute beta) {
+        auto load_a = [&](int, int m, int k) {
+            detail::HostConvPosition out(k, ps.Z, ps.P, ps.Q);
+
+            ElementA dy = ref_dy.at(Tensor5DCoord(out.n, out.d, out.h, out.w, m));
+            return load_(dy);
+        };
+
+        auto load_b = [&](int, int k, int n) {
+            detail::HostConvPosition out(k, ps.Z, ps.P, ps.Q);
+            detail::HostConvFilterTap tap(n, ps.C, ps);
+
+            int d = out.d * ps.stride_d - ps.pad_d +
+                    tap.filter_t * ps.dilation_d;
+            int h = out.h * ps.stride_h - ps.pad_h +
+                    tap.filter_r * ps.dilation_h;
+            int w = out.w * ps.stride_w - ps.pad_w +
+                    tap.filter_s * ps.dilation_w;
+
+            if (d < 0 || d >= ps.D || h < 0 || h >= ps.H || w < 0 ||
+                w >= ps.W) {
+                return HostAccumulator();
+            }
+
+            ElementB x = ref_x.at(Tensor5DCoord(out.n, d, h, w, tap.channel));
+            return load_(x);
+        };
+
+        auto store = [&](int, int m, int n, HostAccumulator const& accum) {
+            detail::HostConvFilterTap tap(n, ps.C, ps);
+
+            store_(ref_dw_in, ref_dw_out,
+                   Tensor5DCoord(m, tap.t, tap.r, tap.s, tap.channel), accum,
+                   alpha, beta);
+        };
+
+        host::gemm<HostAccumulator>(1, ps.K, ps.T * ps.R * ps.S * ps.C,
+                                    ps.N * ps.Z * ps.P * ps.Q, load_a, load_b,
+                                    store);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
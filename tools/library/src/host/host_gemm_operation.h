@@ -0,0 +1,617 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Defines host (CPU) operations for GEMM operation kinds in CUTLASS
+   Library
+*/
+
+#pragma once
+
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_conversion.h"
+#include "cutlass/tensor_ref.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+#include "library_internal.h"
+
+#include "host_kernels.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// GEMM executed on the host by the blocked, multithreaded engine in
+/// host_kernels.h. Supports GemmKind::kGemm and GemmKind::kUniversal in the
+/// kGemm, kGemmSplitKParallel, kBatched and kArray modes.
+template <GemmKind GemmKind_, typename ElementA_, typename LayoutA_,
+          cutlass::ComplexTransform TransformA, typename ElementB_,
+          typename LayoutB_, cutlass::ComplexTransform TransformB,
+          typename ElementC_, typename LayoutC_, typename ElementCompute_,
+          typename ElementAccumulator_ = ElementCompute_,
+          typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_> >
+class HostGemmOperation : public Operation {
+public:
+    static GemmKind const kGemmKind = GemmKind_;
+
+    using ElementA = ElementA_;
+    using LayoutA = LayoutA_;
+    using TensorRefA = TensorRef<ElementA, LayoutA>;
+    static cutlass::ComplexTransform const kTransformA = TransformA;
+    using ElementB = ElementB_;
+    using LayoutB = LayoutB_;
+    using TensorRefB = TensorRef<ElementB, LayoutB>;
+    static cutlass::ComplexTransform const kTransformB = TransformB;
+    using ElementC = ElementC_;
+    using LayoutC = LayoutC_;
+    using TensorRefC = TensorRef<ElementC, LayoutC>;
+    using ElementCompute = ElementCompute_;
+    using ElementAccumulator = ElementAccumulator_;
+    using ConvertOp = ConvertOp_;
+
+    /// Type in which the engine accumulates
+    using HostAccumulator =
+            typename host::HostAccumulator<ElementAccumulator>::Type;
+
+    static_assert(kGemmKind == GemmKind::kGemm ||
+                          kGemmKind == GemmKind::kUniversal,
+                  "Host GEMM supports GemmKind::kGemm and GemmKind::kUniversal");
+
+    using Configuration =
+            typename std::conditional<kGemmKind == GemmKind::kGemm,
+                                      GemmConfiguration,
+                                      GemmUniversalConfiguration>::type;
+
+    using Arguments = typename std::conditional<kGemmKind == GemmKind::kGemm,
+                                                GemmArguments,
+                                                GemmUniversalArguments>::type;
+
+protected:
+    /// Storage for the name string
+    std::string name_;
+
+    ///
+    GemmDescription description_;
+
+    /// Problem and operands common to all supported GEMM kinds
+    struct Problem {
+        gemm::GemmCoord problem_size;
+        int batch_count;
+        GemmUniversalMode mode;
+        int64_t lda;
+        int64_t ldb;
+        int64_t ldc;
+        int64_t ldd;
+        void const* A;
+        void const* B;
+        void const* C;
+        void* D;
+        void const* alpha;
+        void const* beta;
+        ScalarPointerMode pointer_mode;
+        int64_t batch_stride_A;
+        int64_t batch_stride_B;
+        int64_t batch_stride_C;
+        int64_t batch_stride_D;
+    };
+
+public:
+    /// Constructor
+    HostGemmOperation() {
+        // Basic information
+        description_.provider = Provider::kHost;
+        description_.kind = OperationKind::kGemm;
+        description_.gemm_kind = kGemmKind;
+
+        // Tensor description
+        description_.A = make_TensorDescription<ElementA, LayoutA>();
+        description_.transform_A = ComplexTransformMap<kTransformA>::kId;
+        description_.B = make_TensorDescription<ElementB, LayoutB>();
+        description_.transform_B = ComplexTransformMap<kTransformB>::kId;
+        description_.C = make_TensorDescription<ElementC, LayoutC>();
+
+        // Epilogue compute and accumulator type description
+        description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+
+        description_.tile_description.math_instruction.element_accumulator =
+                NumericTypeMap<ElementAccumulator>::kId;
+
+        description_.tile_description.threadblock_shape = make_Coord(
+                host::GemmBlocking<HostAccumulator>::kMC,
+                host::GemmBlocking<HostAccumulator>::kNC,
+                host::GemmBlocking<HostAccumulator>::kKC);
+
+        // Host operations do not depend on a device
+        description_.tile_description.minimum_compute_capability = 0;
+        description_.tile_description.maximum_compute_capability = 1024;
+
+        // Procedural name
+        std::stringstream ss;
+
+        ss << "gemm"
+           << (kGemmKind == GemmKind::kUniversal ? "_universal" : "") << "_"
+           << to_string(description_.provider) << "_"
+           << to_string(description_.A.element)
+           << to_string(description_.A.layout) << "_"
+           << to_string(description_.B.element)
+           << to_string(description_.B.layout) << "_"
+           << to_string(description_.C.element)
+           << to_string(description_.C.layout) << "_"
+           << to_string(description_.tile_description.math_instruction
+                                .element_accumulator);
+
+        name_ = ss.str();
+
+        description_.name = name_.c_str();
+    }
+
+    /// Returns the description of the GEMM operation
+    virtual OperationDescription const& description() const {
+        return description_;
+    }
+
+    virtual Status can_implement(void const* configuration_ptr,
+                                 void const* arguments_ptr) const {
+        Configuration const& configuration =
+                *static_cast<Configuration const*>(configuration_ptr);
+        Arguments const& arguments =
+                *static_cast<Arguments const*>(arguments_ptr);
+
+        Problem problem = make_problem_(configuration, arguments);
+
+        if (problem.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        if (problem.problem_size.m() < 0 || problem.problem_size.n() < 0 ||
+            problem.problem_size.k() < 0 || problem.batch_count < 0) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        return Status::kSuccess;
+    }
+
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(Configuration);
+    }
+
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration) const {
+        return 0;
+    }
+
+    virtual Status initialize(void const* configuration, void* host_workspace,
+                              void* device_workspace = nullptr,
+                              cudaStream_t stream = nullptr) const {
+        std::memcpy(host_workspace, configuration,
+                    get_host_workspace_size(configuration));
+
+        return Status::kSuccess;
+    }
+
+    virtual Status run(void const* arguments_ptr, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        Configuration const& configuration =
+                *static_cast<Configuration const*>(host_workspace);
+        Arguments const& arguments =
+                *static_cast<Arguments const*>(arguments_ptr);
+
+        Problem problem = make_problem_(configuration, arguments);
+
+        if (problem.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        ElementCompute alpha =
+                *static_cast<ElementCompute const*>(problem.alpha);
+        ElementCompute beta = *static_cast<ElementCompute const*>(problem.beta);
+
+        // Split-K modes compute the whole reduction in one pass
+        int batch_count = 1;
+        if (problem.mode == GemmUniversalMode::kBatched ||
+            problem.mode == GemmUniversalMode::kArray) {
+            batch_count = problem.batch_count;
+        }
+
+        std::vector<TensorRefA> refs_A;
+        std::vector<TensorRefB> refs_B;
+        std::vector<TensorRefC> refs_C;
+        std::vector<TensorRefC> refs_D;
+
+        for (int batch = 0; batch < batch_count; ++batch) {
+            refs_A.push_back(batch_ref_<ElementA, LayoutA>(
+                    problem, problem.A, problem.lda, problem.batch_stride_A,
+                    batch));
+            refs_B.push_back(batch_ref_<ElementB, LayoutB>(
+                    problem, problem.B, problem.ldb, problem.batch_stride_B,
+                    batch));
+            refs_C.push_back(batch_ref_<ElementC, LayoutC>(
+                    problem, problem.C, problem.ldc, problem.batch_stride_C,
+                    batch));
+            refs_D.push_back(batch_ref_<ElementC, LayoutC>(
+                    problem, problem.D, problem.ldd, problem.batch_stride_D,
+                    batch));
+        }
+
+        bool const read_source = !(beta == ElementCompute());
+
+        auto load_a = [&](int batch, int m, int k) {
+            ElementA a = refs_A[batch].at(MatrixCoord(m, k));
+            return HostAccumulator(host::apply_transform(
+                    ElementAccumulator(a), kTransformA));
+        };
+
+        auto load_b = [&](int batch, int k, int n) {
+            ElementB b = refs_B[batch].at(MatrixCoord(k, n));
+            return HostAccumulator(host::apply_transform(
+                    ElementAccumulator(b), kTransformB));
+        };
+
+        auto store = [&](int batch, int m, int n,
+                         HostAccumulator const& accum) {
+            MatrixCoord coord(m, n);
+            ConvertOp convert_op;
+
+            ElementCompute result =
+                    alpha * ElementCompute(ElementAccumulator(accum));
+
+            if (read_source) {
+                ElementC c = refs_C[batch].at(coord);
+                result = result + beta * ElementCompute(c);
+            }
+
+            refs_D[batch].at(coord) = convert_op(result);
+        };
+
+        host::gemm<HostAccumulator>(batch_count, problem.problem_size.m(),
+                                    problem.problem_size.n(),
+                                    problem.problem_size.k(), load_a, load_b,
+                                    store);
+
+        return Status::kSuccess;
+    }
+
+protected:
+    static Problem make_problem_(GemmConfiguration const& configuration,
+                                 GemmArguments const& arguments) {
+        return Problem{configuration.problem_size,
+                       1,
+                       GemmUniversalMode::kGemm,
+                       configuration.lda,
+                       configuration.ldb,
+                       configuration.ldc,
+                       configuration.ldd,
+                       arguments.A,
+                       arguments.B,
+                       arguments.C,
+                       arguments.D,
+                       arguments.alpha,
+                       arguments.beta,
+                       arguments.pointer_mode,
+                       0,
+                       0,
+                       0,
+                       0};
+    }
+
+    static Problem make_problem_(
+            GemmUniversalConfiguration const& configuration,
+            GemmUniversalArguments const& arguments) {
+        return Problem{configuration.problem_size,
+                       configuration.batch_count,
+                       configuration.mode,
+                       configuration.lda,
+                       configuration.ldb,
+                       configuration.ldc,
+                       configuration.ldd,
+                       arguments.A,
+                       arguments.B,
+                       arguments.C,
+                       arguments.D,
+                       arguments.alpha,
+                       arguments.beta,
+                       arguments.pointer_mode,
+                       arguments.batch_stride_A,
+                       arguments.batch_stride_B,
+                       arguments.batch_stride_C,
+                       arguments.batch_stride_D};
+    }
+
+    /// Returns the operand of one batch: in kArray mode, pointer is an array
+    /// of per-batch pointers; otherwise batches are batch_stride apart.
+    template <typename Element, typename Layout>
+    static TensorRef<Element, Layout> batch_ref_(Problem const& problem,
+                                                 void const* pointer,
+                                                 int64_t ld,
+                                                 int64_t batch_stride,
+                                                 int batch) {
+        if (problem.mode == GemmUniversalMode::kArray) {
+            void const* const* pointers =
+                    static_cast<void const* const*>(pointer);
+
+            return TensorRef<Element, Layout>(
+                    static_cast<Element*>(const_cast<void*>(pointers[batch])),
+                    Layout(int(ld)));
+        }
+
+        TensorRef<Element, Layout> ref(
+                static_cast<Element*>(const_cast<void*>(pointer)),
+                Layout(int(ld)));
+
+        ref.add_pointer_offset(batch_stride * batch);
+
+        return ref;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Grouped GEMM executed on the host. Problems are computed one after another,
+/// each by the blocked, multithreaded engine in host_kernels.h.
+template <typename ElementA_, typename LayoutA_,
+          cutlass::ComplexTransform TransformA, typename ElementB_,
+          typename LayoutB_, cutlass::ComplexTransform TransformB,
+          typename ElementC_, typename LayoutC_, typename ElementCompute_,
+          typename ElementAccumulator_ = ElementCompute_,
+          typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_> >
+class HostGemmGroupedOperation : public Operation {
+public:
+    using ElementA = ElementA_;
+    using LayoutA = LayoutA_;
+    static cutlass::ComplexTransform const kTransformA = TransformA;
+    using ElementB = ElementB_;
+    using LayoutB = LayoutB_;
+    static cutlass::ComplexTransform const kTransformB = TransformB;
+    using ElementC = ElementC_;
+    using LayoutC = LayoutC_;
+    using ElementCompute = ElementCompute_;
+    using ElementAccumulator = ElementAccumulator_;
+    using ConvertOp = ConvertOp_;
+
+    /// Type in which the engine accumulates
+    using HostAccumulator =
+            typename host::HostAccumulator<ElementAccumulator>::Type;
+
+protected:
+    /// Storage for the name string
+    std::string name_;
+
+    ///
+    GemmDescription description_;
+
+public:
+    /// Constructor
+    HostGemmGroupedOperation() {
+        // Basic information
+        description_.provider = Provider::kHost;
+        description_.kind = OperationKind::kGemm;
+        description_.gemm_kind = GemmKind::kGrouped;
+
+        // Tensor description
+        description_.A = make_TensorDescription<ElementA, LayoutA>();
+        description_.transform_A = ComplexTransformMap<kTransformA>::kId;
+        description_.B = make_TensorDescription<ElementB, LayoutB>();
+        description_.transform_B = ComplexTransformMap<kTransformB>::kId;
+        description_.C = make_TensorDescription<ElementC, LayoutC>();
+
+        // Epilogue compute and accumulator type description
+        description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+
+        description_.tile_description.math_instruction.element_accumulator =
+                NumericTypeMap<ElementAccumulator>::kId;
+
+        description_.tile_description.threadblock_shape = make_Coord(
+                host::GemmBlocking<HostAccumulator>::kMC,
+                host::GemmBlocking<HostAccumulator>::kNC,
+                host::GemmBlocking<HostAccumulator>::kKC);
+
+        // Host operations do not depend on a device
+        description_.tile_description.minimum_compute_capability = 0;
+        description_.tile_description.maximum_compute_capability = 1024;
+
+        // Procedural name
+        std::stringstream ss;
+
+        ss << "gemm_grouped_" << to_string(description_.provider) << "_"
+           << to_string(description_.A.element)
+           << to_string(description_.A.layout) << "_"
+           << to_string(description_.B.element)
+           << to_string(description_.B.layout) << "_"
+           << to_string(description_.C.element)
+           << to_string(description_.C.layout) << "_"
+           << to_string(description_.tile_description.math_instruction
+                                .element_accumulator);
+
+        name_ = ss.str();
+
+        description_.name = name_.c_str();
+    }
+
+    /// Returns the description of the GEMM operation
+    virtual OperationDescription const& description() const {
+        return description_;
+    }
+
+    virtual Status can_implement(void const* configuration_ptr,
+                                 void const* arguments_ptr) const {
+        GemmGroupedConfiguration const& configuration =
+                *static_cast<GemmGroupedConfiguration const*>(
+                        configuration_ptr);
+        GemmGroupedArguments const& arguments =
+                *static_cast<GemmGroupedArguments const*>(arguments_ptr);
+
+        if (arguments.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        if (configuration.problem_count < 0) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        for (int idx = 0; idx < configuration.problem_count; ++idx) {
+            gemm::GemmCoord const& problem = configuration.problem_sizes[idx];
+
+            if (problem.m() < 0 || problem.n() < 0 || problem.k() < 0) {
+                return Status::kErrorInvalidProblem;
+            }
+        }
+
+        return Status::kSuccess;
+    }
+
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(GemmGroupedConfiguration);
+    }
+
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration) const {
+        return 0;
+    }
+
+    /// The descriptor arrays are referenced, not copied, and must remain
+    /// valid until run() returns.
+    virtual Status initialize(void const* configuration, void* host_workspace,
+                              void* device_workspace = nullptr,
+                              cudaStream_t stream = nullptr) const {
+        std::memcpy(host_workspace, configuration,
+                    get_host_workspace_size(configuration));
+
+        return Status::kSuccess;
+    }
+
+    virtual Status run(void const* arguments_ptr, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        GemmGroupedConfiguration const& configuration =
+                *static_cast<GemmGroupedConfiguration const*>(host_workspace);
+        GemmGroupedArguments const& arguments =
+                *static_cast<GemmGroupedArguments const*>(arguments_ptr);
+
+        if (arguments.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        ElementCompute alpha =
+                *static_cast<ElementCompute const*>(arguments.alpha);
+        ElementCompute beta =
+                *static_cast<ElementCompute const*>(arguments.beta);
+
+        bool const read_source = !(beta == ElementCompute());
+
+        for (int idx = 0; idx < configuration.problem_count; ++idx) {
+            gemm::GemmCoord problem = configuration.problem_sizes[idx];
+
+            TensorRef<ElementA, LayoutA> ref_A(
+                    static_cast<ElementA*>(const_cast<void*>(arguments.A[idx])),
+                    LayoutA(int(configuration.lda[idx])));
+            TensorRef<ElementB, LayoutB> ref_B(
+                    static_cast<ElementB*>(const_cast<void*>(arguments.B[idx])),
+                    LayoutB(int(configuration.ldb[idx])));
+            TensorRef<ElementC, LayoutC> ref_C(
+                    static_cast<ElementC*>(const_cast<void*>(arguments.C[idx])),
+                    LayoutC(int(configuration.ldc[idx])));
+            TensorRef<ElementC, LayoutC> ref_D(
+                    static_cast<ElementC*>(arguments.D[idx]),
+                    LayoutC(int(configuration.ldd[idx])));
+
+            auto load_a = [&](int, int m, int k) {
+                ElementA a = ref_A.at(MatrixCoord(m, k));
+                return HostAccumulator(host::apply_transform(
+                        ElementAccumulator(a), kTransformA));
+            };
+
+            auto load_b = [&](int, int k, int n) {
+                ElementB b = ref_B.at(MatrixCoord(k, n));
+                return HostAccumulator(host::apply_transform(
+                        ElementAccumulator(b), kTransformB));
+            };
+
+            auto store = [&](int, int m, int n, HostAccumulator const& accum) {
+                MatrixCoord coord(m, n);
+                ConvertOp convert_op;
+
+                ElementCompute result =
+                        alpha * ElementCompute(ElementAccumulator(accum));
+
+                if (read_source) {
+                    ElementC c = ref_C.at(coord);
+                    result = result + beta * ElementCompute(c);
+                }
+
+                ref_D.at(coord) = convert_op(result);
+            };
+
+            host::gemm<HostAccumulator>(1, problem.m(), problem.n(),
+                                        problem.k(), load_a, load_b, store);
+        }
+
+        return Status::kSuccess;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Appends the host GEMM operations of every supported GemmKind
+template <typename ElementA_, typename LayoutA_,
+          cutlass::ComplexTransform TransformA, typename ElementB_,
+          typename LayoutB_, cutlass::ComplexTransform TransformB,
+          typename ElementC_, typename LayoutC_, typename ElementCompute_,
+          typename ElementAccumulator_ = ElementCompute_,
+          typename ConvertOp_ = NumericConverter<ElementC_, ElementCompute_> >
+void make_host_gemm(Manifest& manifest) {
+    manifest.append(new HostGemmOperation<
+                    GemmKind::kGemm, ElementA_, LayoutA_, TransformA, ElementB_,
+                    LayoutB_, TransformB, ElementC_, LayoutC_, ElementCompute_,
+                    ElementAccumulator_, ConvertOp_>);
+
+    manifest.append(new HostGemmOperation<
+                    GemmKind::kUniversal, ElementA_, LayoutA_, TransformA,
+                    ElementB_, LayoutB_, TransformB, ElementC_, LayoutC_,
+                    ElementCompute_, ElementAccumulator_, ConvertOp_>);
+
+    manifest.append(new HostGemmGroupedOperation<
+                    ElementA_, LayoutA_, TransformA, ElementB_, LayoutB_,
+                    TransformB, ElementC_, LayoutC_, ElementCompute_,
+                    ElementAccumulator_, ConvertOp_>);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
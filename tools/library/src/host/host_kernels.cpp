@@ -0,0 +1,153 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Thread pool used by the host (CPU) provider of the CUTLASS Library.
+*/
+
+#include <cstdlib>
+
+#include "host_kernels.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+namespace host {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Number of threads requested by CUTLASS_HOST_THREADS, or the number of
+/// hardware threads if unset.
+static int host_thread_count() {
+    char const* value = std::getenv("CUTLASS_HOST_THREADS");
+
+    int count = value ? std::atoi(value) : 0;
+
+    if (count <= 0) {
+        count = int(std::thread::hardware_concurrency());
+    }
+
+    return std::max(count, 1);
+}
+
+ThreadPool& ThreadPool::get() {
+    static ThreadPool pool(host_thread_count());
+    return pool;
+}
+
+ThreadPool::ThreadPool(int thread_count)
+        : task_(nullptr),
+          count_(0),
+          next_(0),
+          active_(0),
+          generation_(0),
+          stop_(false) {
+    for (int i = 1; i < thread_count; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+
+    wake_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallel_for(int count,
+                              std::function<void(int)> const& task) {
+    std::unique_lock<std::mutex> run_lock(run_mutex_, std::defer_lock);
+
+    if (count <= 1 || workers_.empty() || !run_lock.try_lock()) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_ = 0;
+        active_ = int(workers_.size());
+        ++generation_;
+    }
+
+    wake_.notify_all();
+
+    run_tasks_();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::run_tasks_() {
+    for (int i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+        (*task_)(i);
+    }
+}
+
+void ThreadPool::worker_() {
+    uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        wake_.wait(lock,
+                   [&] { return stop_ || generation_ != generation; });
+
+        if (stop_) {
+            return;
+        }
+
+        generation = generation_;
+
+        lock.unlock();
+        run_tasks_();
+        lock.lock();
+
+        if (--active_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace host
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
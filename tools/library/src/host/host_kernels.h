@@ -0,0 +1,325 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Blocked, multithreaded GEMM engine backing the host (CPU) provider
+   of the CUTLASS Library.
+
+    Operands are fetched through functors so that GEMMs and implicit-GEMM
+    convolutions share the same engine. Each task packs an MC-by-KC panel of A
+    and a KC-by-NC panel of B into contiguous buffers converted to the
+    accumulator type, then runs a 4-by-NR register-blocked micro-kernel whose
+    inner loop has unit stride and no conditionals so the compiler can
+    vectorize it.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/complex.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+namespace host {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Fixed pool of worker threads shared by all host operations.
+///
+/// The number of threads defaults to std::thread::hardware_concurrency() and
+/// may be overridden with the CUTLASS_HOST_THREADS environment variable.
+class ThreadPool {
+public:
+    /// Returns the process-wide pool
+    static ThreadPool& get();
+
+    ~ThreadPool();
+
+    /// Number of threads executing a parallel_for(), including the caller
+    int thread_count() const { return int(workers_.size()) + 1; }
+
+    /// Calls task(i) for every i in [0, count). The calling thread
+    /// participates. Concurrent or nested calls run serially on the caller.
+    void parallel_for(int count, std::function<void(int)> const& task);
+
+private:
+    explicit ThreadPool(int thread_count);
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    void worker_();
+    void run_tasks_();
+
+    std::vector<std::thread> workers_;
+
+    /// Held for the duration of a parallel_for()
+    std::mutex run_mutex_;
+
+    /// Guards the fields below
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    std::function<void(int)> const* task_;
+    int count_;
+    std::atomic<int> next_;
+    int active_;
+    uint64_t generation_;
+    bool stop_;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Type in which host kernels accumulate. Narrow floating-point accumulators
+/// are widened to float, matching what a device mainloop keeps in registers.
+template <typename T>
+struct HostAccumulator {
+    using Type = T;
+};
+
+template <>
+struct HostAccumulator<half_t> {
+    using Type = float;
+};
+
+template <>
+struct HostAccumulator<bfloat16_t> {
+    using Type = float;
+};
+
+template <>
+struct HostAccumulator<tfloat32_t> {
+    using Type = float;
+};
+
+/// Applies a complex transformation to an operand element
+template <typename T>
+T apply_transform(T const& x, cutlass::ComplexTransform transform) {
+    return transform == cutlass::ComplexTransform::kConjugate ? conj(x) : x;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Tiling parameters of the host GEMM engine
+template <typename Accumulator>
+struct GemmBlocking {
+    /// Rows of the micro-tile (see gemm_micro_kernel)
+    static int const kMR = 4;
+
+    /// Columns of the micro-tile: 64 bytes of accumulators per row
+    static int const kNR = (64 / int(sizeof(Accumulator)) < 4)
+                                   ? 4
+                                   : 64 / int(sizeof(Accumulator));
+
+    /// Rows of C computed by one task
+    static int const kMC = 64;
+
+    /// Columns of C computed by one task
+    static int const kNC = 256;
+
+    /// Depth of the packed panels
+    static int const kKC = 256;
+
+    /// Problems with fewer multiply-adds than this run on the calling thread
+    static int64_t const kSerialThreshold = (int64_t(1) << 18);
+};
+
+/// Computes a 4-by-NR block of C from packed panels of A and B. The four rows
+/// are held in separate arrays so that compilers keep them in vector
+/// registers and vectorize the unit-stride loop over columns.
+template <typename Accumulator, int NR>
+inline void gemm_micro_kernel(int kc, Accumulator const* a,
+                              Accumulator const* b, Accumulator* c, int ldc) {
+    Accumulator accum0[NR];
+    Accumulator accum1[NR];
+    Accumulator accum2[NR];
+    Accumulator accum3[NR];
+
+    for (int j = 0; j < NR; ++j) {
+        accum0[j] = c[j];
+        accum1[j] = c[ldc + j];
+        accum2[j] = c[2 * ldc + j];
+        accum3[j] = c[3 * ldc + j];
+    }
+
+    for (int k = 0; k < kc; ++k) {
+        Accumulator const* a_k = a + k * 4;
+        Accumulator const* b_k = b + k * NR;
+
+        Accumulator a0 = a_k[0];
+        Accumulator a1 = a_k[1];
+        Accumulator a2 = a_k[2];
+        Accumulator a3 = a_k[3];
+
+        for (int j = 0; j < NR; ++j) {
+            Accumulator b_kj = b_k[j];
+
+            accum0[j] += a0 * b_kj;
+            accum1[j] += a1 * b_kj;
+            accum2[j] += a2 * b_kj;
+            accum3[j] += a3 * b_kj;
+        }
+    }
+
+    for (int j = 0; j < NR; ++j) {
+        c[j] = accum0[j];
+        c[ldc + j] = accum1[j];
+        c[2 * ldc + j] = accum2[j];
+        c[3 * ldc + j] = accum3[j];
+    }
+}
+
+/// Computes batch_count independent M-by-N-by-K matrix products.
+///
+///   load_a(batch, m, k) returns A[m][k] converted to Accumulator
+///   load_b(batch, k, n) returns B[k][n] converted to Accumulator
+///   store(batch, m, n, accum) applies the epilogue to one element of the
+///     product; each (batch, m, n) is stored exactly once.
+template <typename Accumulator, typename LoadA, typename LoadB, typename Store>
+void gemm(int batch_count, int M, int N, int K, LoadA const& load_a,
+          LoadB const& load_b, Store const& store) {
+    using Blocking = GemmBlocking<Accumulator>;
+
+    int const kMR = Blocking::kMR;
+    int const kNR = Blocking::kNR;
+    int const kMC = Blocking::kMC;
+    int const kNC = Blocking::kNC;
+    int const kKC = Blocking::kKC;
+
+    if (batch_count <= 0 || M <= 0 || N <= 0) {
+        return;
+    }
+
+    int tiles_m = (M + kMC - 1) / kMC;
+    int tiles_n = (N + kNC - 1) / kNC;
+    int task_count = batch_count * tiles_m * tiles_n;
+
+    auto compute_tile = [&](int task) {
+        int tile_n = task % tiles_n;
+        int tile_m = (task / tiles_n) % tiles_m;
+        int batch = task / (tiles_n * tiles_m);
+
+        int m_begin = tile_m * kMC;
+        int n_begin = tile_n * kNC;
+        int mc = std::min(kMC, M - m_begin);
+        int nc = std::min(kNC, N - n_begin);
+
+        int mr_blocks = (mc + kMR - 1) / kMR;
+        int nr_blocks = (nc + kNR - 1) / kNR;
+        int ldc = nr_blocks * kNR;
+
+        // Panels are reused across tasks executed by the same thread
+        thread_local std::vector<Accumulator> packed_a;
+        thread_local std::vector<Accumulator> packed_b;
+        thread_local std::vector<Accumulator> block_c;
+
+        packed_a.resize(size_t(kMC) * kKC);
+        packed_b.resize(size_t(kKC) * kNC);
+        block_c.assign(size_t(mr_blocks) * kMR * ldc, Accumulator());
+
+        for (int k_begin = 0; k_begin < K; k_begin += kKC) {
+            int kc = std::min(kKC, K - k_begin);
+
+            // Pack A into MR-row slivers, zero-filling rows beyond M
+            for (int ib = 0; ib < mr_blocks; ++ib) {
+                Accumulator* sliver = packed_a.data() + size_t(ib) * kc * kMR;
+
+                for (int i = 0; i < kMR; ++i) {
+                    int m = m_begin + ib * kMR + i;
+
+                    for (int k = 0; k < kc; ++k) {
+                        sliver[k * kMR + i] =
+                                (m < M ? load_a(batch, m, k_begin + k)
+                                       : Accumulator());
+                    }
+                }
+            }
+
+            // Pack B into NR-column slivers, zero-filling columns beyond N
+            for (int jb = 0; jb < nr_blocks; ++jb) {
+                Accumulator* sliver = packed_b.data() + size_t(jb) * kc * kNR;
+
+                for (int j = 0; j < kNR; ++j) {
+                    int n = n_begin + jb * kNR + j;
+
+                    for (int k = 0; k < kc; ++k) {
+                        sliver[k * kNR + j] =
+                                (n < N ? load_b(batch, k_begin + k, n)
+                                       : Accumulator());
+                    }
+                }
+            }
+
+            for (int jb = 0; jb < nr_blocks; ++jb) {
+                for (int ib = 0; ib < mr_blocks; ++ib) {
+                    gemm_micro_kernel<Accumulator,
+                                      GemmBlocking<Accumulator>::kNR>(
+                            kc, packed_a.data() + size_t(ib) * kc * kMR,
+                            packed_b.data() + size_t(jb) * kc * kNR,
+                            block_c.data() + size_t(ib) * kMR * ldc + jb * kNR,
+                            ldc);
+                }
+            }
+        }
+
+        for (int i = 0; i < mc; ++i) {
+            for (int j = 0; j < nc; ++j) {
+                store(batch, m_begin + i, n_begin + j,
+                      block_c[size_t(i) * ldc + j]);
+            }
+        }
+    };
+
+    int64_t multiply_adds = int64_t(batch_count) * M * N * std::max(K, 1);
+
+    if (task_count == 1 || multiply_adds < Blocking::kSerialThreshold) {
+        for (int task = 0; task < task_count; ++task) {
+            compute_tile(task);
+        }
+    } else {
+        ThreadPool::get().parallel_for(task_count, compute_tile);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace host
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
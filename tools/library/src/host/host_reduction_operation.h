@@ -0,0 +1,219 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Defines host (CPU) operations for the reduction operation kind in
+   CUTLASS Library
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_conversion.h"
+
+#include "cutlass/library/library.h"
+#include "library_internal.h"
+
+#include "host_kernels.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Split-K reduction executed on the host:
+///
+///   D = alpha * sum(workspace partitions) + beta * C
+///
+/// Rows of the problem are distributed across the host thread pool.
+template <typename ElementWorkspace_, typename ElementAccumulator_,
+          typename ElementOutput_, typename ElementCompute_,
+          typename ConvertOp_ = NumericConverter<ElementOutput_, ElementCompute_> >
+class HostReductionOperation : public Operation {
+public:
+    using ElementWorkspace = ElementWorkspace_;
+    using ElementAccumulator = ElementAccumulator_;
+    using ElementOutput = ElementOutput_;
+    using ElementCompute = ElementCompute_;
+    using ConvertOp = ConvertOp_;
+
+    /// Rows reduced by one task
+    static int const kRowsPerTask = 16;
+
+protected:
+    ///
+    ReductionDescription description_;
+
+public:
+    /// Constructor
+    HostReductionOperation(char const* name = "unknown_reduction") {
+        description_.name = name;
+        description_.provider = Provider::kHost;
+        description_.kind = OperationKind::kReduction;
+
+        description_.tile_description.threadblock_shape =
+                make_Coord(kRowsPerTask, 1, 1);
+
+        description_.tile_description.math_instruction.instruction_shape =
+                make_Coord(1, 1, 1);
+        description_.tile_description.math_instruction.element_accumulator =
+                NumericTypeMap<ElementAccumulator>::kId;
+        description_.tile_description.math_instruction.math_operation =
+                MathOperationID::kAdd;
+
+        // Host operations do not depend on a device
+        description_.tile_description.minimum_compute_capability = 0;
+        description_.tile_description.maximum_compute_capability = 1024;
+
+        description_.element_workspace = NumericTypeMap<ElementWorkspace>::kId;
+        description_.element_output = NumericTypeMap<ElementOutput>::kId;
+        description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+    }
+
+    /// Returns the description of the Reduction operation
+    virtual OperationDescription const& description() const {
+        return description_;
+    }
+
+    virtual Status can_implement(void const* configuration_ptr,
+                                 void const* arguments_ptr) const {
+        ReductionConfiguration const& configuration =
+                *static_cast<ReductionConfiguration const*>(configuration_ptr);
+        ReductionArguments const& arguments =
+                *static_cast<ReductionArguments const*>(arguments_ptr);
+
+        if (arguments.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        if (configuration.problem_size.row() < 0 ||
+            configuration.problem_size.column() < 0 ||
+            configuration.partitions < 1) {
+            return Status::kErrorInvalidProblem;
+        }
+
+        return Status::kSuccess;
+    }
+
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(ReductionConfiguration);
+    }
+
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration) const {
+        return 0;
+    }
+
+    virtual Status initialize(void const* configuration, void* host_workspace,
+                              void* device_workspace = nullptr,
+                              cudaStream_t stream = nullptr) const {
+        std::memcpy(host_workspace, configuration,
+                    get_host_workspace_size(configuration));
+
+        return Status::kSuccess;
+    }
+
+    virtual Status run(void const* arguments_ptr, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        ReductionConfiguration const& configuration =
+                *static_cast<ReductionConfiguration const*>(host_workspace);
+        ReductionArguments const& arguments =
+                *static_cast<ReductionArguments const*>(arguments_ptr);
+
+        if (arguments.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        ElementCompute alpha =
+                *static_cast<ElementCompute const*>(arguments.alpha);
+        ElementCompute beta =
+                *static_cast<ElementCompute const*>(arguments.beta);
+
+        bool const read_source = !(beta == ElementCompute());
+
+        ElementWorkspace const* workspace =
+                static_cast<ElementWorkspace const*>(arguments.workspace);
+        ElementOutput const* source =
+                static_cast<ElementOutput const*>(arguments.source);
+        ElementOutput* destination =
+                static_cast<ElementOutput*>(arguments.destination);
+
+        int rows = configuration.problem_size.row();
+        int columns = configuration.problem_size.column();
+
+        auto reduce_rows = [&](int task) {
+            ConvertOp convert_op;
+
+            int row_end = std::min(rows, (task + 1) * kRowsPerTask);
+
+            for (int row = task * kRowsPerTask; row < row_end; ++row) {
+                for (int column = 0; column < columns; ++column) {
+                    int64_t offset = row * configuration.ldw + column;
+
+                    ElementAccumulator accum = ElementAccumulator();
+
+                    for (int partition = 0; partition < configuration.partitions;
+                         ++partition) {
+                        accum += ElementAccumulator(
+                                workspace[offset + partition *
+                                                           configuration
+                                                                   .partition_stride]);
+                    }
+
+                    ElementCompute result = alpha * ElementCompute(accum);
+
+                    if (read_source) {
+                        result = result +
+                                 beta * ElementCompute(
+                                                source[row * configuration.lds +
+                                                       column]);
+                    }
+
+                    destination[row * configuration.ldd + column] =
+                            convert_op(result);
+                }
+            }
+        };
+
+        host::ThreadPool::get().parallel_for(
+                (rows + kRowsPerTask - 1) / kRowsPerTask, reduce_rows);
+
+        return Status::kSuccess;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -297,6 +297,26 @@ struct LayoutMap<cutlass::layout::TensorCxRSKx<64>> {
     static LayoutTypeID const kId = LayoutTypeID::kTensorC64RSK64;
 };
 
+template <>
+struct LayoutMap<cutlass::layout::TensorNCxHWx<4>> {
+    static LayoutTypeID const kId = LayoutTypeID::kTensorNC4HW4;
+};
+
+template <>
+struct LayoutMap<cutlass::layout::TensorNCxHWx<8>> {
+    static LayoutTypeID const kId = LayoutTypeID::kTensorNC8HW8;
+};
+
+template <>
+struct LayoutMap<cutlass::layout::TensorNCxHWx<16>> {
+    static LayoutTypeID const kId = LayoutTypeID::kTensorNC16HW16;
+};
+
+template <>
+struct LayoutMap<cutlass::layout::TensorCxRSKx<4>> {
+    static LayoutTypeID const kId = LayoutTypeID::kTensorC4RSK4;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename T>
@@ -379,6 +399,32 @@ template <>
 struct IteratorAlgorithmMap<conv::IteratorAlgorithm::kOptimized> {
     static IteratorAlgorithmID const kId = IteratorAlgorithmID::kOptimized;
 };
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <cutlass::conv::ConvType T>
+struct ConvTypeMap;
+
+template <>
+struct ConvTypeMap<conv::ConvType::kConvolution> {
+    static ConvType const kId = ConvType::kConvolution;
+};
+
+template <>
+struct ConvTypeMap<conv::ConvType::kBatchConvolution> {
+    static ConvType const kId = ConvType::kBatchConvolution;
+};
+
+template <>
+struct ConvTypeMap<conv::ConvType::kLocal> {
+    static ConvType const kId = ConvType::kLocal;
+};
+
+template <>
+struct ConvTypeMap<conv::ConvType::kLocalShare> {
+    static ConvType const kId = ConvType::kLocalShare;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename Element, typename Layout>
@@ -44,14 +44,22 @@ void initialize_reference_operations(Manifest& manifest);
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Top-level initialization
-Status Manifest::initialize() {
+Status Manifest::initialize(bool lazy) {
     if (!operations_.empty()) {
         operations_.clear();
     }
 
-    // initialize procedurally generated cutlass op in manifest object
+    entries_.clear();
+    entry_initialized_.clear();
+
+    // register procedurally generated cutlass op in manifest object
     initialize_all(*this);
 
+    // construct them unless they are constructed on demand
+    if (!lazy) {
+        initialize_entries();
+    }
+
     // initialize manually instanced conv3d reference op in manifest object
     initialize_reference_operations(*this);
 
@@ -63,12 +71,14 @@ Status Manifest::initialize() {
 
 /// Used for initialization
 void Manifest::reserve(size_t operation_count) {
-    operations_.reserve(operation_count);
+    entries_.reserve(operation_count);
 }
 
 /// Graceful shutdown
 Status Manifest::release() {
     operations_.clear();
+    entries_.clear();
+    entry_initialized_.clear();
     return Status::kSuccess;
 }
 
@@ -77,6 +87,50 @@ void Manifest::append(Operation* operation_ptr) {
     operations_.emplace_back(operation_ptr);
 }
 
+/// Registers a table of operations which are constructed on demand
+void Manifest::append(ManifestEntry const* entries, size_t entry_count) {
+    for (size_t idx = 0; idx < entry_count; ++idx) {
+        entries_.push_back(entries + idx);
+        entry_initialized_.push_back(false);
+    }
+}
+
+/// Returns the descriptors of procedurally generated operations
+std::vector<ManifestEntry const*> const& Manifest::entries() const {
+    return entries_;
+}
+
+/// Returns true if the operation described by an entry was constructed
+bool Manifest::entry_initialized(size_t entry_idx) const {
+    return entry_initialized_.at(entry_idx);
+}
+
+/// Constructs the operation described by an entry
+size_t Manifest::initialize_entry(size_t entry_idx) {
+    size_t first_operation = operations_.size();
+
+    if (!entry_initialized_.at(entry_idx)) {
+        entry_initialized_[entry_idx] = true;
+        entries_[entry_idx]->initialize(*this);
+    }
+
+    return first_operation;
+}
+
+/// Constructs the operations of all entries not yet constructed
+void Manifest::initialize_entries() {
+    size_t pending = 0;
+    for (bool initialized : entry_initialized_) {
+        pending += (initialized ? 0 : 1);
+    }
+
+    operations_.reserve(operations_.size() + pending);
+
+    for (size_t idx = 0; idx < entries_.size(); ++idx) {
+        initialize_entry(idx);
+    }
+}
+
 /// Returns an iterator to the first operation
 OperationVector const& Manifest::operations() const {
     return operations_;
@@ -31,6 +31,7 @@
 */
 
 #include "cutlass/library/operation_table.h"
+#include "cutlass/trace.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,67 +40,139 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-void OperationTable::append(Manifest const& manifest) {
-    // Insert operations into appropriate data structure
-    for (auto const& operation : manifest) {
-        OperationDescription const& desc = operation->description();
+/// Functional key of a GEMM described by a manifest entry
+static GemmFunctionalKey make_gemm_functional_key(ManifestEntry const& entry) {
+    return GemmFunctionalKey(entry.provider, entry.gemm_kind,
+                             entry.element_accumulator, entry.element_epilogue,
+                             entry.element_A, entry.layout_A, entry.transform_A,
+                             entry.element_B, entry.layout_B, entry.transform_B,
+                             entry.element_C);
+}
 
-        // insert all gemm operation into operation table
-        if (desc.kind == OperationKind::kGemm) {
-            GemmDescription const& gemm_desc =
-                    static_cast<GemmDescription const&>(desc);
+/// Functional key of a convolution described by a manifest entry
+static ConvFunctionalKey make_conv_functional_key(ManifestEntry const& entry) {
+    return ConvFunctionalKey(entry.provider, entry.conv_kind, entry.element_A,
+                             entry.layout_A, entry.element_B, entry.layout_B,
+                             entry.element_C, entry.layout_C,
+                             entry.element_accumulator, entry.element_epilogue);
+}
 
-            GemmFunctionalKey functional_key(
-                    gemm_desc.provider, gemm_desc.gemm_kind,
-                    gemm_desc.tile_description.math_instruction
-                            .element_accumulator,
-                    gemm_desc.element_epilogue, gemm_desc.A.element,
-                    gemm_desc.A.layout, gemm_desc.transform_A,
-                    gemm_desc.B.element, gemm_desc.B.layout,
-                    gemm_desc.transform_B, gemm_desc.C.element);
+/// Returns true if an entry may run on one of the given compute capabilities.
+/// An empty list accepts every entry.
+static bool entry_supported(ManifestEntry const& entry,
+                            std::vector<int> const& compute_capabilities) {
+    if (compute_capabilities.empty()) {
+        return true;
+    }
+
+    for (int cc : compute_capabilities) {
+        if (entry.minimum_compute_capability <= cc &&
+            cc <= entry.maximum_compute_capability) {
+            return true;
+        }
+    }
+
+    return false;
+}
 
-            Operation const* op = operation.get();
+/// Selection metadata common to all kinds of operations
+static OperationCandidate make_candidate(Operation const* op) {
+    TileDescription const& tile = op->description().tile_description;
 
-            int cc = gemm_desc.tile_description.minimum_compute_capability;
+    OperationCandidate candidate;
+    candidate.minimum_compute_capability = tile.minimum_compute_capability;
+    candidate.maximum_compute_capability = tile.maximum_compute_capability;
+    candidate.alignment = 1;
+    candidate.iterator_algorithm = IteratorAlgorithmID::kNone;
+    candidate.threadblock_shape = tile.threadblock_shape;
+    candidate.stages = tile.threadblock_stages;
+    candidate.operation = op;
 
-            int alignment = std::max(
-                    std::max(gemm_desc.A.alignment, gemm_desc.B.alignment),
-                    gemm_desc.C.alignment);
+    return candidate;
+}
 
-            GemmPreferenceKey preference_key(cc, alignment);
+/// Flattens GEMM operations in descending order of preference
+static OperationCandidateVector make_candidates(
+        GemmOperationVectorMap const& operations) {
+    OperationCandidateVector candidates;
 
-            gemm_operations[functional_key][preference_key].push_back(op);
+    for (auto it = operations.rbegin(); it != operations.rend(); ++it) {
+        for (Operation const* op : it->second) {
+            GemmDescription const& desc =
+                    static_cast<GemmDescription const&>(op->description());
+
+            OperationCandidate candidate = make_candidate(op);
+            candidate.alignment =
+                    std::max(std::max(desc.A.alignment, desc.B.alignment),
+                             desc.C.alignment);
+
+            candidates.push_back(candidate);
         }
+    }
 
-        // insert all conv2d or conv3d operation into operation table
-        if (desc.kind == OperationKind::kConv2d ||
-            desc.kind == OperationKind::kConv3d) {
-            auto& conv_desc =
-                    static_cast<library::ConvDescription const&>(desc);
-
-            ConvFunctionalKey functional_key(
-                    conv_desc.provider, conv_desc.conv_kind,
-                    conv_desc.A.element, conv_desc.A.layout,
-                    conv_desc.B.element, conv_desc.B.layout,
-                    conv_desc.C.element, conv_desc.C.layout,
-                    conv_desc.tile_description.math_instruction
-                            .element_accumulator,
-                    conv_desc.element_epilogue);
+    return candidates;
+}
+
+/// Flattens convolution operations in descending order of preference
+static OperationCandidateVector make_candidates(
+        ConvOperationVectorMap const& operations) {
+    OperationCandidateVector candidates;
+
+    for (auto it = operations.rbegin(); it != operations.rend(); ++it) {
+        for (Operation const* op : it->second) {
+            ConvDescription const& desc =
+                    static_cast<ConvDescription const&>(op->description());
+
+            OperationCandidate candidate = make_candidate(op);
+            candidate.iterator_algorithm = desc.iterator_algorithm;
+
+            candidates.push_back(candidate);
+        }
+    }
+
+    return candidates;
+}
+
+/// Builds the index of all functional keys in a map. Keys without deferred
+/// entries are complete and their candidates are computed immediately.
+template <typename FunctionalKey, typename Hasher, typename OperationMap,
+          typename EntryMap>
+static void build_index(OperationIndex<FunctionalKey, Hasher>& index,
+                        OperationMap const& operations,
+                        EntryMap const& deferred_entries) {
+    typename OperationIndex<FunctionalKey, Hasher>::KeyEntries key_entries;
+    key_entries.reserve(operations.size());
 
-            Operation const* op = operation.get();
+    for (auto const& operation : operations) {
+        auto it = deferred_entries.find(operation.first);
 
-            int cc = conv_desc.tile_description.minimum_compute_capability;
+        key_entries.emplace_back(operation.first,
+                                 it == deferred_entries.end()
+                                         ? std::vector<size_t>()
+                                         : it->second);
+    }
+
+    index.build(key_entries);
 
-            ConvPreferenceKey preference_key(cc, conv_desc.iterator_algorithm);
+    for (size_t idx = 0; idx < index.size(); ++idx) {
+        auto const& slot = index.slot(idx);
 
-            // insert conv operation to conv2d_operations or conv3d_operations
-            // map
-            (desc.kind == OperationKind::kConv2d)
-                    ? conv2d_operations[functional_key][preference_key]
-                              .push_back(op)
-                    : conv3d_operations[functional_key][preference_key]
-                              .push_back(op);
+        if (slot.entries.empty()) {
+            slot.candidates = make_candidates(operations.at(index.key(idx)));
+            slot.initialized.store(true, std::memory_order_release);
         }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OperationTable::append(Manifest& manifest,
+                            std::vector<int> const& compute_capabilities) {
+    manifest_ = &manifest;
+
+    // Insert operations into appropriate data structure
+    for (auto const& operation : manifest) {
+        OperationDescription const& desc = operation->description();
 
         // insert all reduction operation into operation table
         if (desc.kind == OperationKind::kReduction) {
@@ -114,11 +187,291 @@ void OperationTable::append(Manifest const& manifest) {
                     library::MathOperationID::kAdd,
                     library::EpilogueKind::kLinearCombination);
 
-            Operation const* op = operation.get();
+            reduction_operations[functional_key] = operation.get();
+        } else {
+            insert_(operation.get(), false);
+        }
+    }
+
+    // Register entries constructed on demand. This also inserts their
+    // functional keys so the maps are not rehashed by later queries.
+    std::unordered_map<GemmFunctionalKey, std::vector<size_t>,
+                       GemmFunctionalKeyHasher>
+            deferred_gemm_entries;
+    std::unordered_map<ConvFunctionalKey, std::vector<size_t>,
+                       ConvFunctionalKeyHasher>
+            deferred_conv2d_entries;
+    std::unordered_map<ConvFunctionalKey, std::vector<size_t>,
+                       ConvFunctionalKeyHasher>
+            deferred_conv3d_entries;
+    std::unordered_map<ConvFunctionalKey, std::vector<size_t>,
+                       ConvFunctionalKeyHasher>
+            deferred_convolution_entries;
+
+    auto const& entries = manifest.entries();
+
+    for (size_t idx = 0; idx < entries.size(); ++idx) {
+        if (manifest.entry_initialized(idx)) {
+            continue;
+        }
+
+        ManifestEntry const& entry = *entries[idx];
+
+        // Entries which cannot run on any visible device are never indexed,
+        // so their operations are not constructed by queries
+        if (!entry_supported(entry, compute_capabilities)) {
+            continue;
+        }
+
+        if (entry.kind == OperationKind::kGemm) {
+            GemmFunctionalKey functional_key = make_gemm_functional_key(entry);
+
+            gemm_operations[functional_key];
+            deferred_gemm_entries[functional_key].push_back(idx);
+        } else if (entry.kind == OperationKind::kConv2d) {
+            ConvFunctionalKey functional_key = make_conv_functional_key(entry);
+
+            conv2d_operations[functional_key];
+            deferred_conv2d_entries[functional_key].push_back(idx);
+        } else if (entry.kind == OperationKind::kConv3d) {
+            ConvFunctionalKey functional_key = make_conv_functional_key(entry);
+
+            conv3d_operations[functional_key];
+            deferred_conv3d_entries[functional_key].push_back(idx);
+        } else if (entry.kind == OperationKind::kConvolution) {
+            ConvFunctionalKey functional_key = make_conv_functional_key(entry);
+
+            convolution_operations[functional_key];
+            deferred_convolution_entries[functional_key].push_back(idx);
+        }
+    }
+
+    build_index(gemm_index_, gemm_operations, deferred_gemm_entries);
+    build_index(conv2d_index_, conv2d_operations, deferred_conv2d_entries);
+    build_index(conv3d_index_, conv3d_operations, deferred_conv3d_entries);
+    build_index(convolution_index_, convolution_operations,
+                deferred_convolution_entries);
+}
+
+/// Inserts an operation into the maps
+bool OperationTable::insert_(Operation const* op, bool deferred) const {
+    OperationDescription const& desc = op->description();
+
+    // insert all gemm operation into operation table
+    if (desc.kind == OperationKind::kGemm) {
+        GemmDescription const& gemm_desc =
+                static_cast<GemmDescription const&>(desc);
+
+        GemmFunctionalKey functional_key(
+                gemm_desc.provider, gemm_desc.gemm_kind,
+                gemm_desc.tile_description.math_instruction.element_accumulator,
+                gemm_desc.element_epilogue, gemm_desc.A.element,
+                gemm_desc.A.layout, gemm_desc.transform_A, gemm_desc.B.element,
+                gemm_desc.B.layout, gemm_desc.transform_B,
+                gemm_desc.C.element);
 
-            reduction_operations[functional_key] = op;
+        int cc = gemm_desc.tile_description.minimum_compute_capability;
+
+        int alignment =
+                std::max(std::max(gemm_desc.A.alignment, gemm_desc.B.alignment),
+                         gemm_desc.C.alignment);
+
+        GemmPreferenceKey preference_key(cc, alignment);
+
+        if (deferred) {
+            auto it = gemm_operations.find(functional_key);
+            if (it == gemm_operations.end()) {
+                return false;
+            }
+            it->second[preference_key].push_back(op);
+        } else {
+            gemm_operations[functional_key][preference_key].push_back(op);
         }
     }
+
+    // insert all conv2d, conv3d or convolution operation into operation table
+    if (desc.kind == OperationKind::kConv2d ||
+        desc.kind == OperationKind::kConv3d ||
+        desc.kind == OperationKind::kConvolution) {
+        auto& conv_desc = static_cast<library::ConvDescription const&>(desc);
+
+        ConvFunctionalKey functional_key(
+                conv_desc.provider, conv_desc.conv_kind, conv_desc.A.element,
+                conv_desc.A.layout, conv_desc.B.element, conv_desc.B.layout,
+                conv_desc.C.element, conv_desc.C.layout,
+                conv_desc.tile_description.math_instruction.element_accumulator,
+                conv_desc.element_epilogue);
+
+        int cc = conv_desc.tile_description.minimum_compute_capability;
+
+        ConvPreferenceKey preference_key(cc, conv_desc.iterator_algorithm);
+
+        // insert conv operation to conv2d_operations, conv3d_operations or
+        // convolution_operations map
+        ConvOperationFunctionalMap& conv_operations =
+                (desc.kind == OperationKind::kConv2d)
+                        ? conv2d_operations
+                        : (desc.kind == OperationKind::kConv3d
+                                   ? conv3d_operations
+                                   : convolution_operations);
+
+        if (deferred) {
+            auto it = conv_operations.find(functional_key);
+            if (it == conv_operations.end()) {
+                return false;
+            }
+            it->second[preference_key].push_back(op);
+        } else {
+            conv_operations[functional_key][preference_key].push_back(op);
+        }
+    }
+
+    return true;
+}
+
+/// Constructs the operations of deferred entries. The caller holds mutex_.
+void OperationTable::initialize_deferred_(
+        std::vector<size_t> const& entries) const {
+    for (size_t entry_idx : entries) {
+        size_t first = manifest_->initialize_entry(entry_idx);
+
+        for (size_t idx = first; idx < manifest_->operations().size(); ++idx) {
+            Operation const* op = manifest_->operations()[idx].get();
+
+            // The generated entry disagrees with the instantiated operation.
+            // It remains in the manifest but cannot be found by functional
+            // key.
+            if (!insert_(op, true)) {
+                CUTLASS_TRACE_HOST("OperationTable: functional key of "
+                                   << op->description().name
+                                   << " does not match its manifest entry");
+            }
+        }
+    }
+}
+
+/// Constructs the operations of deferred entries and computes the candidates
+/// of a slot on first use
+template <typename FunctionalKey, typename Hasher, typename OperationMap>
+OperationCandidateVector const* OperationTable::find_candidates_(
+        OperationIndex<FunctionalKey, Hasher> const& index,
+        OperationMap const& operations, FunctionalKey const& key) const {
+    auto slot = index.find(key);
+
+    if (!slot) {
+        return nullptr;
+    }
+
+    if (!slot->initialized.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (!slot->initialized.load(std::memory_order_relaxed)) {
+            initialize_deferred_(slot->entries);
+
+            slot->candidates = make_candidates(operations.at(key));
+            slot->initialized.store(true, std::memory_order_release);
+        }
+    }
+
+    return &slot->candidates;
+}
+
+/// Returns the GEMM candidates matching a functional key or nullptr
+OperationCandidateVector const* OperationTable::find_gemm_candidates(
+        GemmFunctionalKey const& key) const {
+    return find_candidates_(gemm_index_, gemm_operations, key);
+}
+
+/// Returns the Conv2d candidates matching a functional key or nullptr
+OperationCandidateVector const* OperationTable::find_conv2d_candidates(
+        ConvFunctionalKey const& key) const {
+    return find_candidates_(conv2d_index_, conv2d_operations, key);
+}
+
+/// Returns the Conv3d candidates matching a functional key or nullptr
+OperationCandidateVector const* OperationTable::find_conv3d_candidates(
+        ConvFunctionalKey const& key) const {
+    return find_candidates_(conv3d_index_, conv3d_operations, key);
+}
+
+/// Returns the Convolution candidates matching a functional key or nullptr
+OperationCandidateVector const* OperationTable::find_convolution_candidates(
+        ConvFunctionalKey const& key) const {
+    return find_candidates_(convolution_index_, convolution_operations, key);
+}
+
+/// Returns the GEMM operations matching a functional key or nullptr
+GemmOperationVectorMap const* OperationTable::find_gemm_operations(
+        GemmFunctionalKey const& key) const {
+    if (!find_gemm_candidates(key)) {
+        return nullptr;
+    }
+
+    return &gemm_operations.at(key);
+}
+
+/// Returns the Conv2d operations matching a functional key or nullptr
+ConvOperationVectorMap const* OperationTable::find_conv2d_operations(
+        ConvFunctionalKey const& key) const {
+    if (!find_conv2d_candidates(key)) {
+        return nullptr;
+    }
+
+    return &conv2d_operations.at(key);
+}
+
+/// Returns the Conv3d operations matching a functional key or nullptr
+ConvOperationVectorMap const* OperationTable::find_conv3d_operations(
+        ConvFunctionalKey const& key) const {
+    if (!find_conv3d_candidates(key)) {
+        return nullptr;
+    }
+
+    return &conv3d_operations.at(key);
+}
+
+/// Returns the Convolution operations matching a functional key or nullptr
+ConvOperationVectorMap const* OperationTable::find_convolution_operations(
+        ConvFunctionalKey const& key) const {
+    if (!find_convolution_candidates(key)) {
+        return nullptr;
+    }
+
+    return &convolution_operations.at(key);
+}
+
+/// Returns the reduction operation matching a functional key or nullptr
+Operation const* OperationTable::find_reduction_operation(
+        ReductionFunctionalKey const& key) const {
+    auto it = reduction_operations.find(key);
+
+    return it == reduction_operations.end() ? nullptr : it->second;
+}
+
+/// Constructs every deferred operation of the manifest
+void OperationTable::initialize_all() const {
+    for (size_t idx = 0; idx < gemm_index_.size(); ++idx) {
+        find_gemm_candidates(gemm_index_.key(idx));
+    }
+
+    for (size_t idx = 0; idx < conv2d_index_.size(); ++idx) {
+        find_conv2d_candidates(conv2d_index_.key(idx));
+    }
+
+    for (size_t idx = 0; idx < conv3d_index_.size(); ++idx) {
+        find_conv3d_candidates(conv3d_index_.key(idx));
+    }
+
+    for (size_t idx = 0; idx < convolution_index_.size(); ++idx) {
+        find_convolution_candidates(convolution_index_.key(idx));
+    }
+
+    // Construct the remaining entries (e.g. sparse GEMMs) which are not
+    // indexed by this table but enumerated through the manifest
+    if (manifest_) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        manifest_->initialize_entries();
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +42,7 @@ void initialize_reduce_add_linear_combination_f32_f32_f16(Manifest& manifest);
 void initialize_reduce_add_linear_combination_f32_f32_f32(Manifest& manifest);
 void initialize_reduce_add_linear_combination_cf32_cf32_cf32(
         Manifest& manifest);
+void initialize_reduce_host_operations(Manifest& manifest);
 
 //
 // Entry point to construct operations
@@ -50,6 +51,7 @@ void initialize_all_reduction_op(Manifest& manifest) {
     initialize_reduce_add_linear_combination_f32_f32_f16(manifest);
     initialize_reduce_add_linear_combination_f32_f32_f32(manifest);
     initialize_reduce_add_linear_combination_cf32_cf32_cf32(manifest);
+    initialize_reduce_host_operations(manifest);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +44,8 @@
 #include "cutlass/util/reference/host/convolution.h"
 #include "cutlass/util/reference/device/convolution.h"
 
+#include "host/host_conv_operation.h"
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace cutlass {
@@ -310,7 +312,7 @@ public:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Constructs Fprop reference operators.
+/// Constructs Fprop reference and host operators.
 template <int kConvDim, typename ElementA_, typename LayoutA_,
           typename ElementB_, typename LayoutB_, typename ElementC_,
           typename LayoutC_, typename ElementCompute_,
@@ -329,9 +331,14 @@ void make_conv_fprop(Manifest& manifest) {
                     kConvDim, ElementA_, LayoutA_, ElementB_, LayoutB_,
                     ElementC_, LayoutC_, ElementCompute_, ElementAccumulator_,
                     ConvertOp_, InnerProductOp_>);
+
+    manifest.append(new HostConvOperation<
+                    conv::Operator::kFprop, kConvDim, ElementA_, LayoutA_,
+                    ElementB_, LayoutB_, ElementC_, LayoutC_, ElementCompute_,
+                    ElementAccumulator_, ConvertOp_>);
 }
 
-/// Constructs Dgrad and Wgrad reference operators.
+/// Constructs Dgrad and Wgrad reference and host operators.
 template <int kConvDim, typename ElementA_, typename LayoutA_,
           typename ElementB_, typename LayoutB_, typename ElementC_,
           typename LayoutC_, typename ElementCompute_,
@@ -351,6 +358,11 @@ void make_conv_backwards(Manifest& manifest) {
                     ElementC_, LayoutC_, ElementCompute_, ElementAccumulator_,
                     ConvertOp_, InnerProductOp_>);
 
+    manifest.append(new HostConvOperation<
+                    conv::Operator::kDgrad, kConvDim, ElementA_, LayoutA_,
+                    ElementB_, LayoutB_, ElementC_, LayoutC_, ElementCompute_,
+                    ElementAccumulator_, ConvertOp_>);
+
     manifest.append(new ConvReferenceOperation<
                     Provider::kReferenceHost, conv::Operator::kWgrad, kConvDim,
                     ElementA_, LayoutA_, ElementB_, LayoutB_, ElementC_,
@@ -362,9 +374,14 @@ void make_conv_backwards(Manifest& manifest) {
                     kConvDim, ElementA_, LayoutA_, ElementB_, LayoutB_,
                     ElementC_, LayoutC_, ElementCompute_, ElementAccumulator_,
                     ConvertOp_, InnerProductOp_>);
+
+    manifest.append(new HostConvOperation<
+                    conv::Operator::kWgrad, kConvDim, ElementA_, LayoutA_,
+                    ElementB_, LayoutB_, ElementC_, LayoutC_, ElementCompute_,
+                    ElementAccumulator_, ConvertOp_>);
 }
 
-/// Six operators for the price of one.
+/// Nine operators for the price of one.
 template <int kConvDim, typename ElementA_, typename LayoutA_,
           typename ElementB_, typename LayoutB_, typename ElementC_,
           typename LayoutC_, typename ElementCompute_,
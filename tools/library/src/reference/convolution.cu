@@ -0,0 +1,101 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Host reference instances for convolutions with a fused bias and
+   residual tensor.
+*/
+
+#include "cutlass/cutlass.h"
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+
+#include "convolution_reference_operation.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void initialize_convolution_reference_operations(Manifest& manifest) {
+    // nchw4 / chwn4 (SIMT dp4a)
+    make_convolution<int8_t, cutlass::layout::TensorNCxHWx<4>, int8_t,
+                     cutlass::layout::TensorCxRSKx<4>, int8_t,
+                     cutlass::layout::TensorNCxHWx<4>, int32_t,
+                     cutlass::layout::TensorNCxHWx<4>, float, int32_t>(
+            manifest);
+
+    make_convolution<int8_t, cutlass::layout::TensorCxRSKx<4>, int8_t,
+                     cutlass::layout::TensorCxRSKx<4>, int8_t,
+                     cutlass::layout::TensorCxRSKx<4>, int32_t,
+                     cutlass::layout::TensorCxRSKx<4>, float, int32_t>(
+            manifest);
+
+    // nchw32 (int8 tensor op)
+    make_convolution<int8_t, cutlass::layout::TensorNCxHWx<32>, int8_t,
+                     cutlass::layout::TensorCxRSKx<32>, int8_t,
+                     cutlass::layout::TensorNCxHWx<32>, int32_t,
+                     cutlass::layout::TensorNCxHWx<32>, float, int32_t>(
+            manifest);
+
+    // nchw64 (int4 tensor op)
+    make_convolution<cutlass::int4b_t, cutlass::layout::TensorNCxHWx<64>,
+                     cutlass::int4b_t, cutlass::layout::TensorCxRSKx<64>,
+                     cutlass::int4b_t, cutlass::layout::TensorNCxHWx<64>,
+                     int32_t, cutlass::layout::TensorNCxHWx<64>, float,
+                     int32_t>(manifest);
+
+    make_convolution<cutlass::uint4b_t, cutlass::layout::TensorNCxHWx<64>,
+                     cutlass::int4b_t, cutlass::layout::TensorCxRSKx<64>,
+                     cutlass::int4b_t, cutlass::layout::TensorNCxHWx<64>,
+                     int32_t, cutlass::layout::TensorNCxHWx<64>, float,
+                     int32_t>(manifest);
+
+    // nhwc (int4 tensor op, filter interleaved by the access size)
+    make_convolution<cutlass::int4b_t, cutlass::layout::TensorNHWC,
+                     cutlass::int4b_t, cutlass::layout::TensorNCxHWx<8>,
+                     cutlass::int4b_t, cutlass::layout::TensorNHWC, int32_t,
+                     cutlass::layout::TensorNHWC, float, int32_t>(manifest);
+
+    make_convolution<cutlass::int4b_t, cutlass::layout::TensorNHWC,
+                     cutlass::int4b_t, cutlass::layout::TensorNCxHWx<16>,
+                     cutlass::int4b_t, cutlass::layout::TensorNHWC, int32_t,
+                     cutlass::layout::TensorNHWC, float, int32_t>(manifest);
+
+    make_convolution<cutlass::int4b_t, cutlass::layout::TensorNHWC,
+                     cutlass::int4b_t, cutlass::layout::TensorNCxHWx<32>,
+                     cutlass::int4b_t, cutlass::layout::TensorNHWC, int32_t,
+                     cutlass::layout::TensorNHWC, float, int32_t>(manifest);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,235 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+  \brief Defines host reference operations for convolutions with a fused bias
+  and residual tensor in CUTLASS Library
+*/
+
+#pragma once
+
+#include <sstream>
+#include <cstring>
+
+#include "cutlass/cutlass.h"
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/util.h"
+#include "library_internal.h"
+
+#include "cutlass/util/reference/host/convolution.h"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Host reference for OperationKind::kConvolution. Computes
+///   dst = convert(alpha * accum + beta * bias + gamma * z)
+/// which matches the BiasAddLinearCombination(Clamp) epilogues; operations
+/// with other epilogues are not verified against it.
+template <conv::ConvType ConvolutionType, typename ElementSrc_,
+          typename LayoutSrc_, typename ElementFilter_, typename LayoutFilter_,
+          typename ElementDst_, typename LayoutDst_, typename ElementBias_,
+          typename LayoutBias_, typename ElementCompute_,
+          typename ElementAccumulator_>
+class ConvolutionReferenceOperation : public Operation {
+public:
+    static conv::ConvType const kConvolutionType = ConvolutionType;
+
+    using ElementSrc = ElementSrc_;
+    using LayoutSrc = LayoutSrc_;
+    using ElementFilter = ElementFilter_;
+    using LayoutFilter = LayoutFilter_;
+    using ElementDst = ElementDst_;
+    using LayoutDst = LayoutDst_;
+    using ElementBias = ElementBias_;
+    using LayoutBias = LayoutBias_;
+    using ElementCompute = ElementCompute_;
+    using ElementAccumulator = ElementAccumulator_;
+
+    using ReferenceOp = reference::host::Convolution<
+            kConvolutionType, ElementSrc, LayoutSrc, ElementFilter,
+            LayoutFilter, ElementDst, LayoutDst, ElementBias, LayoutBias,
+            ElementCompute, ElementAccumulator>;
+
+protected:
+    /// Storage for the name string
+    std::string name_;
+
+    ///
+    ConvolutionDescription description_;
+
+public:
+    /// Constructor
+    ConvolutionReferenceOperation()
+            : description_(ConvTypeMap<kConvolutionType>::kId,
+                           EpilogueKind::kBiasAddLinearCombinationClamp) {
+        // Basic information
+        description_.provider = Provider::kReferenceHost;
+        description_.kind = OperationKind::kConvolution;
+
+        // Tensor description
+        description_.A = make_TensorDescription<ElementSrc, LayoutSrc>();
+        description_.B = make_TensorDescription<ElementFilter, LayoutFilter>();
+        description_.C = make_TensorDescription<ElementDst, LayoutDst>();
+        description_.bias = make_TensorDescription<ElementBias, LayoutBias>();
+
+        // Epilogue compute and accumulator type description
+        description_.element_epilogue = NumericTypeMap<ElementCompute>::kId;
+
+        description_.tile_description.math_instruction.element_accumulator =
+                NumericTypeMap<ElementAccumulator>::kId;
+
+        // Compute capability for host reference
+        description_.tile_description.minimum_compute_capability = 0;
+        description_.tile_description.maximum_compute_capability = 1024;
+
+        // Procedural name
+        std::stringstream ss;
+
+        ss << "convolution_" << to_string(description_.conv_type)
+           << "_reference_" << to_string(description_.provider) << "_"
+           << to_string(description_.A.element)
+           << to_string(description_.A.layout) << "_"
+           << to_string(description_.B.element)
+           << to_string(description_.B.layout) << "_"
+           << to_string(description_.C.element)
+           << to_string(description_.C.layout) << "_"
+           << to_string(description_.tile_description.math_instruction
+                                .element_accumulator);
+
+        name_ = ss.str();
+
+        description_.name = name_.c_str();
+    }
+
+    /// Returns the description of the Convolution operation
+    virtual OperationDescription const& description() const {
+        return description_;
+    }
+
+    virtual Status can_implement(void const* configuration,
+                                 void const* arguments) const {
+        return Status::kSuccess;
+    }
+
+    virtual uint64_t get_host_workspace_size(void const* configuration) const {
+        return sizeof(ConvolutionConfiguration);
+    }
+
+    virtual uint64_t get_device_workspace_size(
+            void const* configuration) const {
+        return 0;
+    }
+
+    virtual Status initialize(void const* configuration, void* host_workspace,
+                              void* device_workspace = nullptr,
+                              cudaStream_t stream = nullptr) const {
+        std::memcpy(host_workspace, configuration,
+                    get_host_workspace_size(configuration));
+
+        return Status::kSuccess;
+    }
+
+    /// Runs the reference on host-resident tensors. Scalars must be host
+    /// pointers.
+    virtual Status run(void const* arguments, void* host_workspace,
+                       void* device_workspace = nullptr,
+                       cudaStream_t stream = nullptr) const {
+        ConvolutionConfiguration const& config =
+                *static_cast<ConvolutionConfiguration const*>(host_workspace);
+
+        ConvolutionArguments const& args =
+                *static_cast<ConvolutionArguments const*>(arguments);
+
+        if (args.pointer_mode != ScalarPointerMode::kHost) {
+            return Status::kErrorNotSupported;
+        }
+
+        conv::Conv2dProblemSize const& problem_size = config.problem_size;
+
+        TensorRef<ElementSrc, LayoutSrc> ref_src(
+                static_cast<ElementSrc*>(const_cast<void*>(args.src)),
+                LayoutSrc::packed({problem_size.N, problem_size.H,
+                                   problem_size.W, problem_size.C}));
+
+        TensorRef<ElementFilter, LayoutFilter> ref_filter(
+                static_cast<ElementFilter*>(const_cast<void*>(args.filter)),
+                LayoutFilter::packed({problem_size.K, problem_size.R,
+                                      problem_size.S, problem_size.C}));
+
+        TensorRef<ElementBias, LayoutBias> ref_bias(
+                static_cast<ElementBias*>(const_cast<void*>(args.bias)),
+                LayoutBias::packed({1, 1, 1, problem_size.K}));
+
+        LayoutDst layout_dst = LayoutDst::packed(
+                {problem_size.N, problem_size.P, problem_size.Q,
+                 problem_size.K});
+
+        TensorRef<ElementDst, LayoutDst> ref_z(
+                static_cast<ElementDst*>(const_cast<void*>(args.z)),
+                layout_dst);
+
+        TensorRef<ElementDst, LayoutDst> ref_dst(
+                static_cast<ElementDst*>(args.dst), layout_dst);
+
+        ReferenceOp reference_op;
+
+        reference_op(problem_size,
+                     *static_cast<ElementCompute const*>(args.alpha), ref_src,
+                     ref_filter, *static_cast<ElementCompute const*>(args.beta),
+                     ref_bias, *static_cast<ElementCompute const*>(args.gamma),
+                     ref_z, ref_dst, ElementAccumulator(0));
+
+        return Status::kSuccess;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Constructs a host reference operator for dense convolutions.
+template <typename ElementSrc_, typename LayoutSrc_, typename ElementFilter_,
+          typename LayoutFilter_, typename ElementDst_, typename LayoutDst_,
+          typename ElementBias_, typename LayoutBias_,
+          typename ElementCompute_, typename ElementAccumulator_>
+void make_convolution(Manifest& manifest) {
+    manifest.append(new ConvolutionReferenceOperation<
+                    conv::ConvType::kConvolution, ElementSrc_, LayoutSrc_,
+                    ElementFilter_, LayoutFilter_, ElementDst_, LayoutDst_,
+                    ElementBias_, LayoutBias_, ElementCompute_,
+                    ElementAccumulator_>);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,6 +45,8 @@
 #include "cutlass/util/reference/host/gemm_complex.h"
 #include "cutlass/util/reference/device/gemm_complex.h"
 
+#include "host/host_gemm_operation.h"
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace cutlass {
@@ -240,6 +242,11 @@ void make_gemm(Manifest& manifest) {
                     ElementB_, LayoutB_, TransformB, ElementC_, LayoutC_,
                     ElementCompute_, ElementAccumulator_, ConvertOp_,
                     InnerProductOp_>);
+
+    // Every GEMM verified by a reference is also served by the host provider
+    make_host_gemm<ElementA_, LayoutA_, TransformA, ElementB_, LayoutB_,
+                   TransformB, ElementC_, LayoutC_, ElementCompute_,
+                   ElementAccumulator_, ConvertOp_>(manifest);
 }
 
 /// Helper to create NN, NT, TN, and TT GEMM layouts.
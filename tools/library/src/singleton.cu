@@ -25,7 +25,10 @@
  *
  **************************************************************************************************/
 
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <vector>
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/operation_table.h"
@@ -42,10 +45,49 @@ static std::unique_ptr<Singleton> instance;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Procedurally generated operations are constructed on demand unless
+/// CUTLASS_LIBRARY_LAZY_INIT=0 is set in the environment.
+static bool lazy_initialization_enabled() {
+    char const* value = std::getenv("CUTLASS_LIBRARY_LAZY_INIT");
+
+    return !(value && !std::strcmp(value, "0"));
+}
+
+/// Returns the compute capabilities of all visible devices, or an empty list
+/// if they cannot be determined.
+static std::vector<int> device_compute_capabilities() {
+    std::vector<int> compute_capabilities;
+
+    int device_count = 0;
+
+    if (cudaGetDeviceCount(&device_count) != cudaSuccess) {
+        cudaGetLastError();
+        return compute_capabilities;
+    }
+
+    for (int device_idx = 0; device_idx < device_count; ++device_idx) {
+        int major = 0;
+        int minor = 0;
+
+        if (cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor,
+                                   device_idx) != cudaSuccess ||
+            cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor,
+                                   device_idx) != cudaSuccess) {
+            cudaGetLastError();
+            return std::vector<int>();
+        }
+
+        compute_capabilities.push_back(major * 10 + minor);
+    }
+
+    return compute_capabilities;
+}
+
 Singleton::Singleton() {
-    manifest.initialize();
+    manifest.initialize(lazy_initialization_enabled());
 
-    operation_table.append(manifest);
+    // Operations which cannot run on any visible device are not indexed
+    operation_table.append(manifest, device_compute_capabilities());
 }
 
 Singleton const& Singleton::get() {
@@ -0,0 +1,366 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Operation-level tracing of the CUTLASS Library
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cutlass/library/trace.h"
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+std::atomic<bool> trace_enabled(false);
+
+}  // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Ring buffer of the events recorded by one thread.
+//
+// Only the owning thread writes. Each slot carries a sequence number which
+// is odd while the slot is being written, so readers can discard slots
+// overwritten while they were copied.
+struct TraceBuffer {
+    static int const kCapacity = 8192;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        TraceEvent event;
+
+        Slot() : sequence(0) {}
+    };
+
+    /// Number of events ever written
+    std::atomic<uint64_t> head;
+
+    /// Events before this index were discarded by trace_clear()
+    std::atomic<uint64_t> first;
+
+    int thread;
+
+    std::unique_ptr<Slot[]> slots;
+
+    TraceBuffer(int thread)
+            : head(0), first(0), thread(thread), slots(new Slot[kCapacity]) {}
+
+    void push(TraceEventKind kind, char const* name, int64_t begin_ns,
+              int64_t end_ns, char const* detail) {
+        uint64_t index = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[index % kCapacity];
+
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.event.kind = kind;
+        slot.event.name = name ? name : "";
+        slot.event.begin_ns = begin_ns;
+        slot.event.duration_ns = end_ns - begin_ns;
+        slot.event.thread = thread;
+
+        if (detail) {
+            std::strncpy(slot.event.detail, detail,
+                         TraceEvent::kDetailCapacity - 1);
+            slot.event.detail[TraceEvent::kDetailCapacity - 1] = '\0';
+        } else {
+            slot.event.detail[0] = '\0';
+        }
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    /// Appends a consistent copy of the retained events
+    void snapshot(TraceEventVector& events) const {
+        uint64_t end = head.load(std::memory_order_acquire);
+        uint64_t begin = first.load(std::memory_order_acquire);
+
+        if (end > uint64_t(kCapacity) && begin < end - kCapacity) {
+            begin = end - kCapacity;
+        }
+
+        for (uint64_t index = begin; index < end; ++index) {
+            Slot const& slot = slots[index % kCapacity];
+
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2) {
+                continue;
+            }
+
+            TraceEvent event = slot.event;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+
+            events.push_back(event);
+        }
+    }
+};
+
+/// Buffers of all threads that recorded events. Buffers are never released
+/// so that events of exited threads remain available.
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+    std::chrono::steady_clock::time_point origin;
+
+    TraceRegistry() : origin(std::chrono::steady_clock::now()) {}
+
+    TraceBuffer* add_buffer() {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.emplace_back(new TraceBuffer(int(buffers.size())));
+        return buffers.back().get();
+    }
+};
+
+TraceRegistry& trace_registry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+TraceBuffer* local_trace_buffer() {
+    static thread_local TraceBuffer* buffer = nullptr;
+    if (!buffer) {
+        buffer = trace_registry().add_buffer();
+    }
+    return buffer;
+}
+
+/// Escapes a string for JSON
+void write_json_string(std::ostream& out, char const* text) {
+    out << '"';
+    for (char const* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            out << ' ';
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+/// Path of the trace written at exit
+std::string& exit_trace_path() {
+    static std::string path;
+    return path;
+}
+
+void write_exit_trace() {
+    if (!write_chrome_trace(exit_trace_path().c_str())) {
+        std::fprintf(stderr, "Failed to write CUTLASS Library trace to '%s'\n",
+                     exit_trace_path().c_str());
+    }
+}
+
+/// Enables tracing when CUTLASS_LIBRARY_TRACE names an output file
+struct TraceEnvironment {
+    TraceEnvironment() {
+        char const* path = std::getenv("CUTLASS_LIBRARY_TRACE");
+        if (!path || !*path) {
+            return;
+        }
+
+        // Construct the registry first so it outlives the exit handler
+        trace_registry();
+        exit_trace_path() = path;
+        std::atexit(write_exit_trace);
+        set_trace_enabled(true);
+    }
+};
+
+TraceEnvironment trace_environment;
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+char const* to_string(TraceEventKind kind, bool pretty) {
+    switch (kind) {
+        case TraceEventKind::kSelect:
+            return pretty ? "Select" : "select";
+        case TraceEventKind::kInitialize:
+            return pretty ? "Initialize" : "initialize";
+        case TraceEventKind::kWorkspace:
+            return pretty ? "Workspace" : "workspace";
+        case TraceEventKind::kLaunch:
+            return pretty ? "Launch" : "launch";
+        case TraceEventKind::kVerify:
+            return pretty ? "Verify" : "verify";
+        case TraceEventKind::kReference:
+            return pretty ? "Reference" : "reference";
+        default:
+            break;
+    }
+    return pretty ? "Invalid" : "invalid";
+}
+
+void set_trace_enabled(bool enabled) {
+    if (enabled) {
+        // Fix the clock's origin before the first event
+        trace_registry();
+    }
+    detail::trace_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t trace_clock_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - trace_registry().origin)
+            .count();
+}
+
+void trace_record(TraceEventKind kind, char const* name, int64_t begin_ns,
+                  int64_t end_ns, char const* detail) {
+    if (!trace_enabled()) {
+        return;
+    }
+    local_trace_buffer()->push(kind, name, begin_ns, end_ns, detail);
+}
+
+TraceEventVector trace_snapshot() {
+    TraceEventVector events;
+    TraceRegistry& registry = trace_registry();
+
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto const& buffer : registry.buffers) {
+            buffer->snapshot(events);
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](TraceEvent const& lhs, TraceEvent const& rhs) {
+                         return lhs.begin_ns < rhs.begin_ns;
+                     });
+    return events;
+}
+
+void trace_clear() {
+    TraceRegistry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto const& buffer : registry.buffers) {
+        buffer->first.store(buffer->head.load(std::memory_order_acquire),
+                            std::memory_order_release);
+    }
+}
+
+void write_chrome_trace(std::ostream& out, TraceEventVector const& events) {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        TraceEvent const& event = events[i];
+
+        out << (i ? ",\n" : "\n") << "  {\"name\": ";
+        write_json_string(out, event.name);
+        out << ", \"cat\": \"" << to_string(event.kind) << "\""
+            << ", \"ph\": \"X\""
+            << ", \"ts\": " << double(event.begin_ns) / 1000.0
+            << ", \"dur\": " << double(event.duration_ns) / 1000.0
+            << ", \"pid\": 0, \"tid\": " << event.thread;
+
+        if (event.detail[0]) {
+            out << ", \"args\": {\"problem\": ";
+            write_json_string(out, event.detail);
+            out << "}";
+        }
+        out << "}";
+    }
+
+    out << "\n]}\n";
+    out.flags(flags);
+}
+
+bool write_chrome_trace(char const* path) {
+    std::ofstream file(path);
+    if (!file.good()) {
+        return false;
+    }
+    write_chrome_trace(file, trace_snapshot());
+    return file.good();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TraceScope::TraceScope(TraceEventKind kind, char const* name)
+        : kind_(kind), name_(name), begin_ns_(0), active_(trace_enabled()) {
+    detail_[0] = '\0';
+    if (active_) {
+        begin_ns_ = trace_clock_ns();
+    }
+}
+
+TraceScope::~TraceScope() { finish(); }
+
+void TraceScope::set_name(char const* name) { name_ = name; }
+
+void TraceScope::set_detail(char const* format, ...) {
+    if (!active_) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(detail_, sizeof(detail_), format, args);
+    va_end(args);
+}
+
+void TraceScope::finish() {
+    if (!active_) {
+        return;
+    }
+    active_ = false;
+    trace_record(kind_, name_, begin_ns_, trace_clock_ns(), detail_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +52,7 @@ static struct {
         {"device", "reference_device", Provider::kReferenceDevice},
         {"cublas", "cuBLAS", Provider::kCUBLAS},
         {"cudnn", "cuDNN", Provider::kCUDNN},
+        {"cpu", "CPU", Provider::kHost},
 };
 
 /// Converts a Provider enumerant to a string
@@ -95,6 +96,7 @@ static struct {
         {"planar_complex", "<PlanarComplex>", GemmKind::kPlanarComplex},
         {"planar_complex_array", "<PlanarComplexArray>",
          GemmKind::kPlanarComplexArray},
+        {"grouped", "<Grouped>", GemmKind::kGrouped},
 };
 
 /// Converts a GemmKind enumerant to a string
@@ -126,6 +128,7 @@ static struct {
         {"conv2d", "Conv2d", OperationKind::kConv2d},
         {"conv3d", "Conv3d", OperationKind::kConv3d},
         {"spgemm", "SparseGemm", OperationKind::kSparseGemm},
+        {"convolution", "Convolution", OperationKind::kConvolution},
 };
 
 /// Converts a Status enumerant to a string
@@ -507,6 +510,15 @@ static struct {
                       {LayoutTypeID::kTensorNC64HW64, "nc64hw64"},
                       {LayoutTypeID::kTensorC32RSK32, "c32rsk32"},
                       {LayoutTypeID::kTensorC64RSK64, "c64rsk64"},
+                      {LayoutTypeID::kTensorNC4HW4, "nc4hw4"},
+                      {LayoutTypeID::kTensorC4RSK4, "c4rsk4"},
+                      {LayoutTypeID::kTensorNC8HW8, "nc8hw8"},
+                      {LayoutTypeID::kTensorNC16HW16, "nc16hw16"},
+
+                      {LayoutTypeID::kTensorNC4HW4, "nchw4"},
+                      {LayoutTypeID::kTensorC4RSK4, "chwn4"},
+                      {LayoutTypeID::kTensorNC32HW32, "nchw32"},
+                      {LayoutTypeID::kTensorNC64HW64, "nchw64"},
 
                       {LayoutTypeID::kUnknown, "*"},
                       {LayoutTypeID::kInvalid, nullptr}};
@@ -573,6 +585,14 @@ int get_layout_stride_rank(LayoutTypeID layout_id) {
             return cutlass::layout::TensorCxRSKx<32>::kStrideRank;
         case LayoutTypeID::kTensorC64RSK64:
             return cutlass::layout::TensorCxRSKx<64>::kStrideRank;
+        case LayoutTypeID::kTensorNC4HW4:
+            return cutlass::layout::TensorNCxHWx<4>::kStrideRank;
+        case LayoutTypeID::kTensorC4RSK4:
+            return cutlass::layout::TensorCxRSKx<4>::kStrideRank;
+        case LayoutTypeID::kTensorNC8HW8:
+            return cutlass::layout::TensorNCxHWx<8>::kStrideRank;
+        case LayoutTypeID::kTensorNC16HW16:
+            return cutlass::layout::TensorNCxHWx<16>::kStrideRank;
         default:
             throw std::runtime_error(
                     "Unsupported LayoutTypeID in LayoutType::get_stride_rank");
@@ -622,6 +642,56 @@ OpcodeClassID from_string<OpcodeClassID>(std::string const& str) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+static struct {
+    char const* text;
+    char const* pretty;
+    MathOperationID enumerant;
+} MathOperationID_enumerants[] = {
+        {"add", "<add>", MathOperationID::kAdd},
+        {"multiply_add", "<multiply_add>", MathOperationID::kMultiplyAdd},
+        {"multiply_add_saturate", "<multiply_add_saturate>",
+         MathOperationID::kMultiplyAddSaturate},
+        {"multiply_add_fast_bf16", "<multiply_add_fast_bf16>",
+         MathOperationID::kMultiplyAddFastBF16},
+        {"multiply_add_fast_f16", "<multiply_add_fast_f16>",
+         MathOperationID::kMultiplyAddFastF16},
+        {"multiply_add_complex", "<multiply_add_complex>",
+         MathOperationID::kMultiplyAddComplex},
+        {"multiply_add_gaussian_complex", "<multiply_add_gaussian_complex>",
+         MathOperationID::kMultiplyAddGaussianComplex},
+        {"xor_popc", "<xor_popc>", MathOperationID::kXorPopc},
+};
+
+/// Converts a MathOperationID enumerant to a string
+char const* to_string(MathOperationID type, bool pretty) {
+    for (auto const& possible : MathOperationID_enumerants) {
+        if (type == possible.enumerant) {
+            if (pretty) {
+                return possible.pretty;
+            } else {
+                return possible.text;
+            }
+        }
+    }
+
+    return pretty ? "Invalid" : "invalid";
+}
+
+/// Converts a MathOperationID enumerant from a string
+template <>
+MathOperationID from_string<MathOperationID>(std::string const& str) {
+    for (auto const& possible : MathOperationID_enumerants) {
+        if ((str.compare(possible.text) == 0) ||
+            (str.compare(possible.pretty) == 0)) {
+            return possible.enumerant;
+        }
+    }
+
+    return MathOperationID::kInvalid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 static struct {
     char const* text;
     char const* pretty;
@@ -811,6 +881,108 @@ ConvKind from_string<ConvKind>(std::string const& str) {
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+static struct {
+    char const* text;
+    char const* pretty;
+    ConvType enumerant;
+} ConvType_enumerants[] = {
+        {"convolution", "<convolution>", ConvType::kConvolution},
+        {"batch_convolution", "<batch_convolution>",
+         ConvType::kBatchConvolution},
+        {"local", "<local>", ConvType::kLocal},
+        {"local_share", "<local_share>", ConvType::kLocalShare},
+};
+
+/// Converts a ConvType enumerant to a string
+char const* to_string(ConvType type, bool pretty) {
+    for (auto const& possible : ConvType_enumerants) {
+        if (type == possible.enumerant) {
+            if (pretty) {
+                return possible.pretty;
+            } else {
+                return possible.text;
+            }
+        }
+    }
+
+    return pretty ? "Invalid" : "invalid";
+}
+
+/// Converts a ConvType enumerant from a string
+template <>
+ConvType from_string<ConvType>(std::string const& str) {
+    for (auto const& possible : ConvType_enumerants) {
+        if ((str.compare(possible.text) == 0) ||
+            (str.compare(possible.pretty) == 0)) {
+            return possible.enumerant;
+        }
+    }
+
+    return ConvType::kInvalid;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static struct {
+    char const* text;
+    char const* pretty;
+    EpilogueKind enumerant;
+} EpilogueKind_enumerants[] = {
+        {"unknown", "Unknown", EpilogueKind::kUnknown},
+        {"conversion", "Conversion", EpilogueKind::kConversion},
+        {"linear_combination", "LinearCombination",
+         EpilogueKind::kLinearCombination},
+        {"linear_combination_clamp", "LinearCombinationClamp",
+         EpilogueKind::kLinearCombinationClamp},
+        {"linear_combination_planar_complex", "LinearCombinationPlanarComplex",
+         EpilogueKind::kLinearCombinationPlanarComplex},
+        {"linear_combination_relu", "LinearCombinationRelu",
+         EpilogueKind::kLinearCombinationRelu},
+        {"linear_combination_sigmoid", "LinearCombinationSigmoid",
+         EpilogueKind::kLinearCombinationSigmoid},
+        {"bias_add", "BiasAddLinearCombination",
+         EpilogueKind::kBiasAddLinearCombination},
+        {"bias_add_clamp", "BiasAddLinearCombinationClamp",
+         EpilogueKind::kBiasAddLinearCombinationClamp},
+        {"bias_add_relu", "BiasAddLinearCombinationRelu",
+         EpilogueKind::kBiasAddLinearCombinationRelu},
+        {"bias_add_relu_clamp", "BiasAddLinearCombinationReluClamp",
+         EpilogueKind::kBiasAddLinearCombinationReluClamp},
+        {"bias_add_hswish", "BiasAddLinearCombinationHSwish",
+         EpilogueKind::kBiasAddLinearCombinationHSwish},
+        {"bias_add_hswish_clamp", "BiasAddLinearCombinationHSwishClamp",
+         EpilogueKind::kBiasAddLinearCombinationHSwishClamp},
+};
+
+/// Converts an EpilogueKind enumerant to a string
+char const* to_string(EpilogueKind type, bool pretty) {
+    for (auto const& possible : EpilogueKind_enumerants) {
+        if (type == possible.enumerant) {
+            if (pretty) {
+                return possible.pretty;
+            } else {
+                return possible.text;
+            }
+        }
+    }
+
+    return pretty ? "Invalid" : "invalid";
+}
+
+/// Converts an EpilogueKind enumerant from a string
+template <>
+EpilogueKind from_string<EpilogueKind>(std::string const& str) {
+    for (auto const& possible : EpilogueKind_enumerants) {
+        if ((str.compare(possible.text) == 0) ||
+            (str.compare(possible.pretty) == 0)) {
+            return possible.enumerant;
+        }
+    }
+
+    return EpilogueKind::kInvalid;
+}
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Lexical cast a string to a byte array. Returns true if cast is successful or
 /// false if invalid.
 bool lexical_cast(std::vector<uint8_t>& bytes, NumericTypeID type,
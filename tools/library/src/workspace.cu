@@ -0,0 +1,209 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Growable, stream-ordered arena of device workspace.
+*/
+
+#include "cutlass/library/workspace.h"
+
+namespace cutlass {
+namespace library {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+DeviceWorkspaceAllocator::DeviceWorkspaceAllocator() : stream_ordered_(false) {
+#if CUDART_VERSION >= 11020
+    int device = 0;
+    int supported = 0;
+
+    if (cudaGetDevice(&device) == cudaSuccess &&
+        cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported,
+                               device) == cudaSuccess) {
+        stream_ordered_ = (supported != 0);
+    }
+
+    // Clear errors of devices predating the attribute
+    cudaGetLastError();
+#endif
+}
+
+void* DeviceWorkspaceAllocator::allocate(size_t bytes, cudaStream_t stream) {
+    void* ptr = nullptr;
+    cudaError_t error;
+
+#if CUDART_VERSION >= 11020
+    if (stream_ordered_) {
+        error = cudaMallocAsync(&ptr, bytes, stream);
+    } else {
+        error = cudaMalloc(&ptr, bytes);
+    }
+#else
+    error = cudaMalloc(&ptr, bytes);
+#endif
+
+    if (error != cudaSuccess) {
+        cudaGetLastError();
+        return nullptr;
+    }
+    return ptr;
+}
+
+void DeviceWorkspaceAllocator::deallocate(void* ptr, size_t,
+                                          cudaStream_t stream) {
+#if CUDART_VERSION >= 11020
+    if (stream_ordered_) {
+        cudaFreeAsync(ptr, stream);
+        return;
+    }
+#endif
+    cudaFree(ptr);
+}
+
+bool DeviceWorkspaceAllocator::fill_zero(void* ptr, size_t bytes,
+                                         cudaStream_t stream) {
+    return cudaMemsetAsync(ptr, 0, bytes, stream) == cudaSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void* CallbackWorkspaceAllocator::allocate(size_t bytes, cudaStream_t stream) {
+    return allocate_(bytes, stream);
+}
+
+void CallbackWorkspaceAllocator::deallocate(void* ptr, size_t bytes,
+                                            cudaStream_t stream) {
+    deallocate_(ptr, bytes, stream);
+}
+
+bool CallbackWorkspaceAllocator::fill_zero(void* ptr, size_t bytes,
+                                           cudaStream_t stream) {
+    return cudaMemsetAsync(ptr, 0, bytes, stream) == cudaSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+WorkspaceArena::WorkspaceArena(std::shared_ptr<WorkspaceAllocator> allocator)
+        : allocator_(allocator),
+          data_(nullptr),
+          capacity_(0),
+          allocation_count_(0),
+          stream_(nullptr) {
+    if (!allocator_) {
+        allocator_ = std::make_shared<DeviceWorkspaceAllocator>();
+    }
+}
+
+WorkspaceArena::~WorkspaceArena() { release_(stream_); }
+
+/// Replaces the allocation with one of `bytes`
+Status WorkspaceArena::reallocate_(size_t bytes, cudaStream_t stream) {
+    // Releasing first lets a stream-ordered allocator reuse the memory. The
+    // old allocation is released on the stream that last used it, which the
+    // work enqueued there may still be reading.
+    release_(stream_);
+    stream_ = stream;
+
+    data_ = allocator_->allocate(bytes, stream);
+    if (!data_) {
+        return Status::kErrorWorkspaceNull;
+    }
+
+    capacity_ = bytes;
+    ++allocation_count_;
+
+    return Status::kSuccess;
+}
+
+Status WorkspaceArena::reserve(size_t bytes, cudaStream_t stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (bytes <= capacity_) {
+        stream_ = stream;
+        return Status::kSuccess;
+    }
+    return reallocate_(aligned_size(bytes), stream);
+}
+
+void WorkspaceArena::release(cudaStream_t stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    release_(stream);
+}
+
+void WorkspaceArena::release_(cudaStream_t stream) {
+    if (data_) {
+        allocator_->deallocate(data_, capacity_, stream);
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+}
+
+Status WorkspaceArena::acquire(size_t const* bytes, void** workspaces,
+                               int count, cudaStream_t stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t total = 0;
+    for (int i = 0; i < count; ++i) {
+        total += aligned_size(bytes[i]);
+    }
+
+    if (total > capacity_) {
+        size_t grown = kGrowthFactor * capacity_;
+        Status status =
+                reallocate_(aligned_size(total > grown ? total : grown), stream);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+    }
+    stream_ = stream;
+
+    char* ptr = static_cast<char*>(data_);
+
+    for (int i = 0; i < count; ++i) {
+        if (!bytes[i]) {
+            workspaces[i] = nullptr;
+            continue;
+        }
+
+        // Only the bytes the operation needs are cleared
+        if (!allocator_->fill_zero(ptr, bytes[i], stream)) {
+            return Status::kErrorInternal;
+        }
+
+        workspaces[i] = ptr;
+        ptr += aligned_size(bytes[i]);
+    }
+
+    return Status::kSuccess;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace library
+}  // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -573,6 +573,17 @@ void Conv2dOperationProfiler::initialize_result_(
 
     // Measured runtime
     result.runtime = 0;
+
+    // Tiles of the equivalent implicit GEMM, one grid per split-K slice
+    cutlass::gemm::GemmCoord mnk =
+            problem_.eq_gemm_size(operation_desc.conv_kind);
+    cutlass::gemm::GemmCoord const& tile =
+            operation_desc.tile_description.threadblock_shape;
+
+    result.model = PerformanceModel(
+            operation_desc, operation_desc.A.element, operation_desc.B.element,
+            tile_count(mnk.m(), tile.m()) * tile_count(mnk.n(), tile.n()) *
+                    problem_.split_k_slices);
 }
 
 /// Initialize reduction problem dimenstions and library::Operation
@@ -630,18 +641,17 @@ bool Conv2dOperationProfiler::initialize_reduction_configuration_(
 #if 0  // debug print to check which reduction instance is selected
     std::cout << reduction_key << "\n";
 #endif
-    auto reduction_it =
-            Singleton::get().operation_table.reduction_operations.find(
+    library::Operation const* reduction_op =
+            Singleton::get().operation_table.find_reduction_operation(
                     reduction_key);
 
-    if (reduction_it ==
-        Singleton::get().operation_table.reduction_operations.end()) {
+    if (!reduction_op) {
         return false;
     }
 
     // initialize reduction operation required for parallel split-k conv2d
     // operator
-    reduction_op_ = reduction_it->second;
+    reduction_op_ = reduction_op;
 
     // reduction operation found and initialized
     return true;
@@ -670,19 +680,26 @@ Status Conv2dOperationProfiler::initialize_workspace(
                     underlying_operation->description());
 
     // Compute the number of copies of the problem to avoid L2 camping.
-    if (!options.profiling.workspace_count) {
-        int64_t bytes = problem_.bytes(operation_desc);
-        if (bytes < 3 * int64_t(options.device.properties.l2CacheSize)) {
-            conv_workspace_.problem_count =
-                    1 +
-                    int((3 * int64_t(options.device.properties.l2CacheSize)) /
-                        bytes);
-        } else {
-            conv_workspace_.problem_count = 1;
-        }
-    } else {
-        conv_workspace_.problem_count = options.profiling.workspace_count;
-    }
+    conv_workspace_.problem_count =
+            workspace_problem_count_(options, problem_.bytes(operation_desc));
+
+    // Device memory of A, B, C, the computed D and the reference D
+    int64_t workspace_bytes =
+            DeviceAllocation::bytes(
+                    operation_desc.A.element, operation_desc.A.layout,
+                    problem_.extent_a(operation_desc.conv_kind),
+                    conv_workspace_.stride_a(operation_desc.conv_kind),
+                    conv_workspace_.problem_count) +
+            DeviceAllocation::bytes(
+                    operation_desc.B.element, operation_desc.B.layout,
+                    problem_.extent_b(operation_desc.conv_kind),
+                    conv_workspace_.stride_b(operation_desc.conv_kind),
+                    conv_workspace_.problem_count) +
+            3 * DeviceAllocation::bytes(
+                        operation_desc.C.element, operation_desc.C.layout,
+                        problem_.extent_c(operation_desc.conv_kind),
+                        conv_workspace_.stride_c(operation_desc.conv_kind),
+                        conv_workspace_.problem_count);
 
     if (options.execution_mode != ExecutionMode::kDryRun) {
         conv_workspace_.A = device_context.allocate_tensor(
@@ -722,16 +739,18 @@ Status Conv2dOperationProfiler::initialize_workspace(
     Status status = Status::kSuccess;
 
     if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        uint64_t device_workspace_size =
+                underlying_operation->get_device_workspace_size(
+                        &conv_workspace_.configuration);
+
         if (options.execution_mode != ExecutionMode::kDryRun) {
             uint64_t workspace_size =
                     underlying_operation->get_host_workspace_size(
                             &conv_workspace_.configuration);
             conv_workspace_.host_workspace.resize(workspace_size, 0);
 
-            workspace_size = underlying_operation->get_device_workspace_size(
-                    &conv_workspace_.configuration);
             conv_workspace_.device_workspace.reset(library::NumericTypeID::kU8,
-                                                   workspace_size);
+                                                   device_workspace_size);
 
             status = underlying_operation->initialize(
                     &conv_workspace_.configuration,
@@ -767,6 +786,8 @@ Status Conv2dOperationProfiler::initialize_workspace(
         results_.back().provider = library::Provider::kCUTLASS;
         results_.back().op_kind = library::OperationKind::kConv2d;
         results_.back().disposition = Disposition::kNotRun;
+        results_.back().workspace_bytes =
+                workspace_bytes + int64_t(device_workspace_size);
 
         for (auto provider : verification_providers_) {
             results_.back().verification_map[provider] = Disposition::kNotRun;
@@ -991,11 +1012,10 @@ bool Conv2dOperationProfiler::verify_with_host_reference_(
     std::cout << conv2d_key << "\n";
 #endif
 
-    auto operators_it =
-            Singleton::get().operation_table.conv2d_operations.find(conv2d_key);
+    library::ConvOperationVectorMap const* operators =
+            Singleton::get().operation_table.find_conv2d_operations(conv2d_key);
 
-    if (operators_it ==
-        Singleton::get().operation_table.conv2d_operations.end()) {
+    if (!operators) {
         results_.back().verification_map[library::Provider::kReferenceHost] =
                 Disposition::kNotRun;
         return true;
@@ -1004,9 +1024,9 @@ bool Conv2dOperationProfiler::verify_with_host_reference_(
     // conv2d host reference minimum cc is 0 (CPU) and no iterator algorithm
     library::ConvPreferenceKey preference_key(
             0, library::IteratorAlgorithmID::kNone);
-    auto cc_it = operators_it->second.find(preference_key);
+    auto cc_it = operators->find(preference_key);
 
-    if (cc_it == operators_it->second.end()) {
+    if (cc_it == operators->end()) {
         results_.back().verification_map[library::Provider::kReferenceHost] =
                 Disposition::kNotRun;
         return true;
@@ -1015,6 +1035,11 @@ bool Conv2dOperationProfiler::verify_with_host_reference_(
     // host refernce has only one instances in Conv2dOperationVectorMap
     library::Operation const* reference_op = cc_it->second[0];
 
+    if (options.verification.host_async()) {
+        verify_with_host_reference_async_(options, reference_op);
+        return true;
+    }
+
     //
     // Copy input tensors A, B, and C from device to host buffers
     //
@@ -1053,9 +1078,15 @@ bool Conv2dOperationProfiler::verify_with_host_reference_(
     //
     // Run host reference operation
     //
+    library::TraceScope reference_scope(
+            library::TraceEventKind::kReference,
+            reference_op->description().name);
+
     status = reference_op->run(&conv_workspace_.arguments,
                                host_workspace_reference_op.data());
 
+    reference_scope.finish();
+
     // Handle errors
     if (status != Status::kSuccess) {
         results_.back().verification_map[library::Provider::kReferenceHost] =
@@ -1091,6 +1122,69 @@ bool Conv2dOperationProfiler::verify_with_host_reference_(
     return true;
 }
 
+/// Verifies CUTLASS against a host reference operation on the verification
+/// threads
+void Conv2dOperationProfiler::verify_with_host_reference_async_(
+        Options const& options, library::Operation const* reference_op) {
+    // The check owns host copies of its operands since device allocations
+    // are released before it completes
+    auto host_A = copy_to_host_(*conv_workspace_.A);
+    auto host_B = copy_to_host_(*conv_workspace_.B);
+    auto host_C = copy_to_host_(*conv_workspace_.C);
+    auto host_computed = copy_to_host_(*conv_workspace_.Computed);
+
+    library::Conv2dConfiguration configuration =
+            conv_workspace_.configuration;
+
+    std::vector<uint8_t> alpha = problem_.alpha;
+    std::vector<uint8_t> beta = problem_.beta;
+
+    library::NumericTypeID element_D = conv_workspace_.Computed->type();
+    size_t count = conv_workspace_.Computed->batch_stride();
+    double epsilon = options.verification.epsilon;
+    double nonzero_floor = options.verification.nonzero_floor;
+
+    verify_on_host_async_(
+            options, library::Provider::kReferenceHost,
+            [=]() -> Disposition {
+                // The host reference accumulates into its copy of C
+                library::ConvArguments arguments;
+                arguments.A = host_A->data();
+                arguments.B = host_B->data();
+                arguments.C = host_C->data();
+                arguments.D = host_C->data();
+                arguments.alpha = alpha.data();
+                arguments.beta = beta.data();
+                arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+                std::vector<uint8_t> host_workspace(
+                        reference_op->get_host_workspace_size(&configuration),
+                        0);
+
+                reference_op->initialize(&configuration,
+                                         host_workspace.data());
+
+                library::TraceScope reference_scope(
+                        library::TraceEventKind::kReference,
+                        reference_op->description().name);
+
+                Status status =
+                        reference_op->run(&arguments, host_workspace.data());
+
+                reference_scope.finish();
+
+                if (status != Status::kSuccess) {
+                    return Disposition::kNotVerified;
+                }
+
+                return host_block_compare(element_D, host_computed->data(),
+                                          host_C->data(), count, epsilon,
+                                          nonzero_floor)
+                               ? Disposition::kPassed
+                               : Disposition::kIncorrect;
+            });
+}
+
 /// Verifies CUTLASS against host reference
 bool Conv2dOperationProfiler::verify_with_device_reference_(
         Options const& options, PerformanceReport& report,
@@ -1113,11 +1207,10 @@ bool Conv2dOperationProfiler::verify_with_device_reference_(
             conv_desc.tile_description.math_instruction.element_accumulator,
             conv_desc.element_epilogue);
 
-    auto operators_it =
-            Singleton::get().operation_table.conv2d_operations.find(conv2d_key);
+    library::ConvOperationVectorMap const* operators =
+            Singleton::get().operation_table.find_conv2d_operations(conv2d_key);
 
-    if (operators_it ==
-        Singleton::get().operation_table.conv2d_operations.end()) {
+    if (!operators) {
         results_.back().verification_map[library::Provider::kReferenceDevice] =
                 Disposition::kNotRun;
 
@@ -1127,9 +1220,9 @@ bool Conv2dOperationProfiler::verify_with_device_reference_(
     // conv2d device reference minimum cc is 50 and no iterator algorithm
     library::ConvPreferenceKey preference_key(
             50, library::IteratorAlgorithmID::kNone);
-    auto cc_it = operators_it->second.find(preference_key);
+    auto cc_it = operators->find(preference_key);
 
-    if (cc_it == operators_it->second.end()) {
+    if (cc_it == operators->end()) {
         results_.back().verification_map[library::Provider::kReferenceDevice] =
                 Disposition::kNotRun;
 
@@ -1163,9 +1256,15 @@ bool Conv2dOperationProfiler::verify_with_device_reference_(
     //
     // Run device reference operation
     //
+    library::TraceScope reference_scope(
+            library::TraceEventKind::kReference,
+            reference_op->description().name);
+
     status = reference_op->run(&conv_workspace_.arguments,
                                host_workspace_reference_op.data());
 
+    reference_scope.finish();
+
     // Handle errors
     if (status != Status::kSuccess) {
         results_.back().verification_map[library::Provider::kReferenceDevice] =
@@ -1236,20 +1335,28 @@ bool Conv2dOperationProfiler::profile(Options const& options,
         }
 
         results_.back().status =
-                profile_cutlass_(results_.back().runtime, options, operation,
+                profile_cutlass_(results_.back(), options, operation,
                                  &conv_workspace_.arguments,
                                  conv_workspace_.host_workspace.data(),
                                  conv_workspace_.device_workspace.data());
     }
+
+#if CUTLASS_ENABLE_CUDNN
+    if (options.profiling.provider_enabled(library::Provider::kCUDNN) &&
+        !results_.empty() && vendor_profiling_pending_(results_.back())) {
+        profile_cudnn_(options, operation);
+    }
+#endif
+
     return true;
 }
 
 /// Method to profile a CUTLASS Operation
 Status Conv2dOperationProfiler::profile_cutlass_(
-        double& runtime, Options const& options,
+        PerformanceResult& result, Options const& options,
         library::Operation const* operation, void* arguments,
         void* host_workspace, void* device_workspace) {
-    GpuTimer timer;
+    GpuSampledTimer timer(options.profiling.iterations_per_sample);
 
     // initialize conv2d underlying operation to handle parallel reduction
     library::Operation const* underlying_operation = operation;
@@ -1330,10 +1437,10 @@ Status Conv2dOperationProfiler::profile_cutlass_(
     // Profiling loop
     //
 
-    int Iterations = options.profiling.iterations;
-
     int iteration = 0;
-    for (; iteration < Iterations; ++iteration) {
+    for (; !profiling_complete_(options, timer); ++iteration) {
+        flush_cache_(options, timer);
+
         // Setup rotating workspace
         int problem_idx = (iteration % conv_workspace_.problem_count);
 
@@ -1371,6 +1478,8 @@ Status Conv2dOperationProfiler::profile_cutlass_(
         if (status != Status::kSuccess) {
             return status;
         }
+
+        timer.iteration_complete();
     }
 
     //
@@ -1383,7 +1492,7 @@ Status Conv2dOperationProfiler::profile_cutlass_(
     // Update performance result
     //
 
-    runtime = timer.duration(iteration);
+    set_runtime_(result, options, timer);
 
     return status;
 }
@@ -1486,6 +1595,84 @@ bool Conv2dOperationProfiler::verify_with_cudnn_(
     return true;
 }
 
+/// Measures the runtime of cuDNN on the current problem
+void Conv2dOperationProfiler::profile_cudnn_(
+        Options const& options, library::Operation const* operation) {
+    auto& conv_desc = static_cast<library::ConvDescription const&>(
+            operation->description());
+
+    // The cuDNN result shares the problem, bytes and flops of the CUTLASS
+    // result
+    PerformanceResult result = results_.back();
+    result.provider = library::Provider::kCUDNN;
+    result.operation_name = "cudnnConvolution";
+    result.status = Status::kErrorNotSupported;
+    result.disposition = Disposition::kNotVerified;
+    result.verification_map.clear();
+    result.runtime = 0;
+    result.runtime_statistics = RuntimeStatistics();
+
+    // The vendor library chooses its own tiling
+    result.model.tiles = 0;
+
+    CudnnCreate handle;
+    if (handle.get_cudnn_create_status() != CUDNN_STATUS_SUCCESS) {
+        return;
+    }
+
+    conv_workspace_.arguments.A = conv_workspace_.A->data();
+    conv_workspace_.arguments.B = conv_workspace_.B->data();
+    conv_workspace_.arguments.D = conv_workspace_.Reference->data();
+    conv_workspace_.arguments.alpha = problem_.alpha.data();
+    conv_workspace_.arguments.beta = problem_.beta.data();
+    conv_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+    // cuDNN does not support four tensor arguments
+    conv_workspace_.arguments.C = conv_workspace_.arguments.D;
+
+    try {
+        detail::cudnnConvDispatcher conv_op(conv_desc,
+                                            conv_workspace_.configuration,
+                                            conv_workspace_.arguments, handle);
+
+        if (conv_op.status != Status::kSuccess) {
+            return;
+        }
+
+        sleep(options.profiling.sleep_duration);
+
+        for (int iteration = 0; iteration < options.profiling.warmup_iterations;
+             ++iteration) {
+            if (conv_op(handle) != CUDNN_STATUS_SUCCESS) {
+                return;
+            }
+        }
+
+        GpuSampledTimer timer(options.profiling.iterations_per_sample);
+
+        timer.start();
+
+        while (!profiling_complete_(options, timer)) {
+            flush_cache_(options, timer);
+
+            if (conv_op(handle) != CUDNN_STATUS_SUCCESS) {
+                return;
+            }
+
+            timer.iteration_complete();
+        }
+
+        timer.stop_and_wait();
+
+        result.status = Status::kSuccess;
+        set_runtime_(result, options, timer);
+    } catch (...) {
+        return;
+    }
+
+    results_.push_back(result);
+}
+
 #endif  // #if CUTLASS_ENABLE_CUDNN
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
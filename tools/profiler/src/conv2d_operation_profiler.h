@@ -397,7 +397,8 @@ public:
 
 protected:
     /// Method to profile an initialized CUTLASS operation
-    virtual Status profile_cutlass_(double& runtime, Options const& options,
+    virtual Status profile_cutlass_(PerformanceResult& result,
+                                    Options const& options,
                                     library::Operation const* operation,
                                     void* arguments, void* host_workspace,
                                     void* device_workspace);
@@ -422,6 +423,11 @@ protected:
                                      ProblemSpace const& problem_space,
                                      ProblemSpace::Problem const& problem);
 
+    /// Verifies CUTLASS against a host reference operation on the
+    /// verification threads
+    void verify_with_host_reference_async_(
+            Options const& options, library::Operation const* reference_op);
+
     /// Verifies CUTLASS against device reference
     bool verify_with_device_reference_(Options const& options,
                                        PerformanceReport& report,
@@ -439,6 +445,11 @@ protected:
                             ProblemSpace const& problem_space,
                             ProblemSpace::Problem const& problem);
 
+    /// Measures the runtime of cuDNN on the current problem and appends it
+    /// as a result of the cuDNN provider
+    void profile_cudnn_(Options const& options,
+                        library::Operation const* operation);
+
 #endif  //#if CUTLASS_ENABLE_CUDNN
 };
 
@@ -617,6 +617,17 @@ void Conv3dOperationProfiler::initialize_result_(
 
     // Measured runtime
     result.runtime = 0;
+
+    // Tiles of the equivalent implicit GEMM, one grid per split-K slice
+    cutlass::gemm::GemmCoord mnk =
+            problem_.eq_gemm_size(operation_desc.conv_kind);
+    cutlass::gemm::GemmCoord const& tile =
+            operation_desc.tile_description.threadblock_shape;
+
+    result.model = PerformanceModel(
+            operation_desc, operation_desc.A.element, operation_desc.B.element,
+            tile_count(mnk.m(), tile.m()) * tile_count(mnk.n(), tile.n()) *
+                    problem_.split_k_slices);
 }
 
 /// Initialize reduction problem dimenstions and library::Operation
@@ -674,18 +685,17 @@ bool Conv3dOperationProfiler::initialize_reduction_configuration_(
 #if 0  // debug print to check which reduction instance is selected
     std::cout << reduction_key << "\n";
 #endif
-    auto reduction_it =
-            Singleton::get().operation_table.reduction_operations.find(
+    library::Operation const* reduction_op =
+            Singleton::get().operation_table.find_reduction_operation(
                     reduction_key);
 
-    if (reduction_it ==
-        Singleton::get().operation_table.reduction_operations.end()) {
+    if (!reduction_op) {
         return false;
     }
 
     // initialize reduction operation required for parallel split-k conv2d
     // operator
-    reduction_op_ = reduction_it->second;
+    reduction_op_ = reduction_op;
 
     // reduction operation found and initialized
     return true;
@@ -714,19 +724,26 @@ Status Conv3dOperationProfiler::initialize_workspace(
                     underlying_operation->description());
 
     // Compute the number of copies of the problem to avoid L2 camping.
-    if (!options.profiling.workspace_count) {
-        int64_t bytes = problem_.bytes(operation_desc);
-        if (bytes < 3 * int64_t(options.device.properties.l2CacheSize)) {
-            conv_workspace_.problem_count =
-                    1 +
-                    int((3 * int64_t(options.device.properties.l2CacheSize)) /
-                        bytes);
-        } else {
-            conv_workspace_.problem_count = 1;
-        }
-    } else {
-        conv_workspace_.problem_count = options.profiling.workspace_count;
-    }
+    conv_workspace_.problem_count =
+            workspace_problem_count_(options, problem_.bytes(operation_desc));
+
+    // Device memory of A, B, C, the computed D and the reference D
+    int64_t workspace_bytes =
+            DeviceAllocation::bytes(
+                    operation_desc.A.element, operation_desc.A.layout,
+                    problem_.extent_a(operation_desc.conv_kind),
+                    conv_workspace_.stride_a(operation_desc.conv_kind),
+                    conv_workspace_.problem_count) +
+            DeviceAllocation::bytes(
+                    operation_desc.B.element, operation_desc.B.layout,
+                    problem_.extent_b(operation_desc.conv_kind),
+                    conv_workspace_.stride_b(operation_desc.conv_kind),
+                    conv_workspace_.problem_count) +
+            3 * DeviceAllocation::bytes(
+                        operation_desc.C.element, operation_desc.C.layout,
+                        problem_.extent_c(operation_desc.conv_kind),
+                        conv_workspace_.stride_c(operation_desc.conv_kind),
+                        conv_workspace_.problem_count);
 
     if (options.execution_mode != ExecutionMode::kDryRun) {
         conv_workspace_.A = device_context.allocate_tensor(
@@ -766,16 +783,18 @@ Status Conv3dOperationProfiler::initialize_workspace(
     Status status = Status::kSuccess;
 
     if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        uint64_t device_workspace_size =
+                underlying_operation->get_device_workspace_size(
+                        &conv_workspace_.configuration);
+
         if (options.execution_mode != ExecutionMode::kDryRun) {
             uint64_t workspace_size =
                     underlying_operation->get_host_workspace_size(
                             &conv_workspace_.configuration);
             conv_workspace_.host_workspace.resize(workspace_size, 0);
 
-            workspace_size = underlying_operation->get_device_workspace_size(
-                    &conv_workspace_.configuration);
             conv_workspace_.device_workspace.reset(library::NumericTypeID::kU8,
-                                                   workspace_size);
+                                                   device_workspace_size);
 
             status = underlying_operation->initialize(
                     &conv_workspace_.configuration,
@@ -811,6 +830,8 @@ Status Conv3dOperationProfiler::initialize_workspace(
         results_.back().provider = library::Provider::kCUTLASS;
         results_.back().op_kind = library::OperationKind::kConv3d;
         results_.back().disposition = Disposition::kNotRun;
+        results_.back().workspace_bytes =
+                workspace_bytes + int64_t(device_workspace_size);
 
         for (auto provider : verification_providers_) {
             results_.back().verification_map[provider] = Disposition::kNotRun;
@@ -999,11 +1020,10 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
     std::cout << conv_key << "\n";
 #endif
 
-    auto operators_it =
-            Singleton::get().operation_table.conv3d_operations.find(conv_key);
+    library::ConvOperationVectorMap const* operators =
+            Singleton::get().operation_table.find_conv3d_operations(conv_key);
 
-    if (operators_it ==
-        Singleton::get().operation_table.conv3d_operations.end()) {
+    if (!operators) {
         results_.back().verification_map[library::Provider::kReferenceHost] =
                 Disposition::kNotRun;
         return true;
@@ -1012,9 +1032,9 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
     // conv3d host reference minimum cc is 0 (CPU) and no iterator algorithm
     library::ConvPreferenceKey preference_key(
             0, library::IteratorAlgorithmID::kNone);
-    auto cc_it = operators_it->second.find(preference_key);
+    auto cc_it = operators->find(preference_key);
 
-    if (cc_it == operators_it->second.end()) {
+    if (cc_it == operators->end()) {
         results_.back().verification_map[library::Provider::kReferenceHost] =
                 Disposition::kNotRun;
         return true;
@@ -1023,6 +1043,11 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
     // host refernce has only one instances in ConvOperationVectorMap
     library::Operation const* reference_op = cc_it->second[0];
 
+    if (options.verification.host_async()) {
+        verify_with_host_reference_async_(options, reference_op);
+        return true;
+    }
+
     //
     // Copy input tensors A, B, and C from device to host buffers
     //
@@ -1059,9 +1084,15 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
     //
     // Run host reference operation
     //
+    library::TraceScope reference_scope(
+            library::TraceEventKind::kReference,
+            reference_op->description().name);
+
     status = reference_op->run(&conv_workspace_.arguments,
                                host_workspace_reference_op.data());
 
+    reference_scope.finish();
+
     // Handle errors
     if (status != Status::kSuccess) {
         results_.back().verification_map[library::Provider::kReferenceHost] =
@@ -1097,6 +1128,69 @@ bool Conv3dOperationProfiler::verify_with_host_reference_(
     return true;
 }
 
+/// Verifies CUTLASS against a host reference operation on the verification
+/// threads
+void Conv3dOperationProfiler::verify_with_host_reference_async_(
+        Options const& options, library::Operation const* reference_op) {
+    // The check owns host copies of its operands since device allocations
+    // are released before it completes
+    auto host_A = copy_to_host_(*conv_workspace_.A);
+    auto host_B = copy_to_host_(*conv_workspace_.B);
+    auto host_C = copy_to_host_(*conv_workspace_.C);
+    auto host_computed = copy_to_host_(*conv_workspace_.Computed);
+
+    library::Conv3dConfiguration configuration =
+            conv_workspace_.configuration;
+
+    std::vector<uint8_t> alpha = problem_.alpha;
+    std::vector<uint8_t> beta = problem_.beta;
+
+    library::NumericTypeID element_D = conv_workspace_.Computed->type();
+    size_t count = conv_workspace_.Computed->batch_stride();
+    double epsilon = options.verification.epsilon;
+    double nonzero_floor = options.verification.nonzero_floor;
+
+    verify_on_host_async_(
+            options, library::Provider::kReferenceHost,
+            [=]() -> Disposition {
+                // The host reference accumulates into its copy of C
+                library::ConvArguments arguments;
+                arguments.A = host_A->data();
+                arguments.B = host_B->data();
+                arguments.C = host_C->data();
+                arguments.D = host_C->data();
+                arguments.alpha = alpha.data();
+                arguments.beta = beta.data();
+                arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+                std::vector<uint8_t> host_workspace(
+                        reference_op->get_host_workspace_size(&configuration),
+                        0);
+
+                reference_op->initialize(&configuration,
+                                         host_workspace.data());
+
+                library::TraceScope reference_scope(
+                        library::TraceEventKind::kReference,
+                        reference_op->description().name);
+
+                Status status =
+                        reference_op->run(&arguments, host_workspace.data());
+
+                reference_scope.finish();
+
+                if (status != Status::kSuccess) {
+                    return Disposition::kNotVerified;
+                }
+
+                return host_block_compare(element_D, host_computed->data(),
+                                          host_C->data(), count, epsilon,
+                                          nonzero_floor)
+                               ? Disposition::kPassed
+                               : Disposition::kIncorrect;
+            });
+}
+
 /// Verifies CUTLASS against host reference
 bool Conv3dOperationProfiler::verify_with_device_reference_(
         Options const& options, PerformanceReport& report,
@@ -1120,7 +1214,7 @@ bool Conv3dOperationProfiler::profile(Options const& options,
         set_cutlass_operator_arguments_();
 
         results_.back().status =
-                profile_cutlass_(results_.back().runtime, options, operation,
+                profile_cutlass_(results_.back(), options, operation,
                                  &conv_workspace_.arguments,
                                  conv_workspace_.host_workspace.data(),
                                  conv_workspace_.device_workspace.data());
@@ -1164,10 +1258,10 @@ void Conv3dOperationProfiler::set_cutlass_operator_arguments_(int problem_idx) {
 
 /// Method to profile a CUTLASS Operation
 Status Conv3dOperationProfiler::profile_cutlass_(
-        double& runtime, Options const& options,
+        PerformanceResult& result, Options const& options,
         library::Operation const* operation, void* arguments,
         void* host_workspace, void* device_workspace) {
-    GpuTimer timer;
+    GpuSampledTimer timer(options.profiling.iterations_per_sample);
 
     // initialize conv2d underlying operation to handle parallel reduction
     library::Operation const* underlying_operation = operation;
@@ -1228,10 +1322,10 @@ Status Conv3dOperationProfiler::profile_cutlass_(
     // Profiling loop
     //
 
-    int Iterations = options.profiling.iterations;
-
     int iteration = 0;
-    for (; iteration < Iterations; ++iteration) {
+    for (; !profiling_complete_(options, timer); ++iteration) {
+        flush_cache_(options, timer);
+
         // Setup rotating workspace
         int problem_idx = (iteration % conv_workspace_.problem_count);
 
@@ -1252,6 +1346,8 @@ Status Conv3dOperationProfiler::profile_cutlass_(
         if (status != Status::kSuccess) {
             return status;
         }
+
+        timer.iteration_complete();
     }
 
     //
@@ -1264,7 +1360,7 @@ Status Conv3dOperationProfiler::profile_cutlass_(
     // Update performance result
     //
 
-    runtime = timer.duration(iteration);
+    set_runtime_(result, options, timer);
 
     return status;
 }
@@ -406,7 +406,8 @@ protected:
     void set_cutlass_operator_arguments_(int problem_idx = 0);
 
     /// Method to profile an initialized CUTLASS operation
-    virtual Status profile_cutlass_(double& runtime, Options const& options,
+    virtual Status profile_cutlass_(PerformanceResult& result,
+                                    Options const& options,
                                     library::Operation const* operation,
                                     void* arguments, void* host_workspace,
                                     void* device_workspace);
@@ -431,6 +432,11 @@ protected:
                                      ProblemSpace const& problem_space,
                                      ProblemSpace::Problem const& problem);
 
+    /// Verifies CUTLASS against a host reference operation on the
+    /// verification threads
+    void verify_with_host_reference_async_(
+            Options const& options, library::Operation const* reference_op);
+
     /// Verifies CUTLASS against device reference
     bool verify_with_device_reference_(Options const& options,
                                        PerformanceReport& report,
@@ -0,0 +1,1005 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief MegEngine convolution profiling
+*/
+
+#include <iostream>
+#include <stdexcept>
+#include <iomanip>
+#include <ios>
+
+#include "cutlass/core_io.h"
+
+#include "convolution_operation_profiler.h"
+#include "gpu_timer.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+using namespace cutlass::library;
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Ctor
+ConvolutionOperationProfiler::ConvolutionOperationProfiler(
+        Options const& options)
+        : OperationProfiler(
+                  options, library::OperationKind::kConvolution,
+                  {
+                          {ArgumentTypeID::kEnumerated,
+                           {"conv_type"},
+                           "Convolution type (convolution, batch_convolution, "
+                           "local, local_share)"},
+                          {ArgumentTypeID::kInteger,
+                           {"n", "input_n"},
+                           "Input N dimension of the Convolution problem space"},
+                          {ArgumentTypeID::kInteger,
+                           {"h", "input_h"},
+                           "Input H dimension of the Convolution problem space"},
+                          {ArgumentTypeID::kInteger,
+                           {"w", "input_w"},
+                           "Input W dimension of the Convolution problem space"},
+                          {ArgumentTypeID::kInteger,
+                           {"c", "input_c"},
+                           "Input C dimension of the Convolution problem space"},
+                          {ArgumentTypeID::kInteger,
+                           {"k", "filter_k"},
+                           "Filter K dimension of the Convolution problem "
+                           "space"},
+                          {ArgumentTypeID::kInteger,
+                           {"r", "filter_r"},
+                           "Filter R dimension of the Convolution problem "
+                           "space"},
+                          {ArgumentTypeID::kInteger,
+                           {"s", "filter_s"},
+                           "Filter S dimension of the Convolution problem "
+                           "space"},
+                          {ArgumentTypeID::kInteger,
+                           {"p", "output_p"},
+                           "Output P dimension of the Convolution problem "
+                           "space"},
+                          {ArgumentTypeID::kInteger,
+                           {"q", "output_q"},
+                           "Output Q dimension of the Convolution problem "
+                           "space"},
+                          {ArgumentTypeID::kInteger,
+                           {"pad_h"},
+                           "Padding in H direction"},
+                          {ArgumentTypeID::kInteger,
+                           {"pad_w"},
+                           "Padding in W direction"},
+                          {ArgumentTypeID::kInteger,
+                           {"stride_h"},
+                           "Stride in H direction"},
+                          {ArgumentTypeID::kInteger,
+                           {"stride_w"},
+                           "Stride in W direction"},
+                          {ArgumentTypeID::kInteger,
+                           {"dilation_h"},
+                           "Dilation in H direction"},
+                          {ArgumentTypeID::kInteger,
+                           {"dilation_w"},
+                           "Dilation in W direction"},
+                          {ArgumentTypeID::kTensor,
+                           {"Src"},
+                           "Tensor storing the Src operand"},
+                          {ArgumentTypeID::kTensor,
+                           {"Filter"},
+                           "Tensor storing the Filter operand"},
+                          {ArgumentTypeID::kTensor,
+                           {"Bias"},
+                           "Tensor storing the Bias operand"},
+                          {ArgumentTypeID::kTensor,
+                           {"Dst"},
+                           "Tensor storing the Dst operand"},
+                          {ArgumentTypeID::kEnumerated,
+                           {"epilogue"},
+                           "Epilogue functor (bias_add_clamp, "
+                           "bias_add_relu_clamp, bias_add_hswish_clamp, ...)"},
+                          {ArgumentTypeID::kScalar,
+                           {"alpha", "epilogue::alpha"},
+                           "Epilogue scalar alpha (scales the accumulators)"},
+                          {ArgumentTypeID::kScalar,
+                           {"beta", "epilogue::beta"},
+                           "Epilogue scalar beta (scales the bias)"},
+                          {ArgumentTypeID::kScalar,
+                           {"gamma", "epilogue::gamma"},
+                           "Epilogue scalar gamma (scales the residual Z)"},
+                  },
+                  {library::Provider::kReferenceHost}) {
+    description_ =
+            "      Convolution operation. Dst(Tensor4D) = epilogue(alpha * "
+            "Src(Tensor4D) * Filter(Tensor4D) + beta * Bias + gamma * "
+            "Z(Tensor4D))";
+}
+
+/// Destructor
+ConvolutionOperationProfiler::~ConvolutionOperationProfiler() {}
+
+/// Prints usage statement for the math function
+void ConvolutionOperationProfiler::print_usage(std::ostream& out) const {
+    out << "Convolution"
+        << "\n\n";
+
+    OperationProfiler::print_usage(out);
+}
+
+/// Prints examples
+void ConvolutionOperationProfiler::print_examples(std::ostream& out) const {
+    out << "\nExamples:\n\n"
+        << "Profile a particular convolution (specify all the convolution "
+           "parameters):\n"
+        << " $ cutlass_profiler --operation=Convolution"
+           " --Src=s8:nc32hw32 --Filter=s8:c32rsk32 --Dst=s8:nc32hw32"
+           " --epilogue=bias_add_relu_clamp"
+           " --n=32 --h=14 --w=14 --c=256 --k=256 --r=3 --s=3"
+           " --pad_h=1 --pad_w=1 --stride_h=1 --stride_w=1\n\n"
+        << "Profile int4 convolutions with NCHW64 activations and a residual "
+           "input:\n"
+        << " $ cutlass_profiler --operation=Convolution"
+           " --Src=s4:nc64hw64 --n=16 --h=28 --w=28 --c=128 --k=128"
+           " --r=3 --s=3 --gamma=1\n\n";
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Total number of bytes loaded
+int64_t ConvolutionOperationProfiler::ConvolutionProblem::bytes(
+        library::ConvolutionDescription const& operation_desc) const {
+    // Source and filter are read once, the destination is written once
+    int64_t bytes_ =
+            int64_t(library::sizeof_bits(operation_desc.A.element)) * n * h *
+                    w * c / 8 +
+            int64_t(library::sizeof_bits(operation_desc.B.element)) * k * r *
+                    s * c / 8 +
+            int64_t(library::sizeof_bits(operation_desc.bias.element)) * k /
+                    8 +
+            int64_t(library::sizeof_bits(operation_desc.C.element)) * n * p *
+                    q * k / 8;
+
+    // The residual tensor is only read for non-zero gamma
+    bool is_gamma_zero = std::all_of(gamma.begin(), gamma.end(),
+                                     [](uint8_t i) { return i == 0; });
+
+    if (!is_gamma_zero) {
+        bytes_ += int64_t(library::sizeof_bits(operation_desc.C.element)) * n *
+                  p * q * k / 8;
+    }
+
+    return bytes_;
+}
+
+/// Total number of flops computed
+int64_t ConvolutionOperationProfiler::ConvolutionProblem::flops(
+        library::ConvolutionDescription const& operation_desc) const {
+    cutlass::gemm::GemmCoord mnk = eq_gemm_size();
+
+    int64_t flops_mainloop_ = int64_t(mnk.m()) * mnk.n() * mnk.k() * 2;
+    int64_t flops_epilogue_ = int64_t(mnk.m()) * int64_t(mnk.n()) * 2;
+
+    return flops_mainloop_ + flops_epilogue_;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Extracts the problem dimensions
+Status ConvolutionOperationProfiler::initialize_configuration(
+        Options const& options, PerformanceReport& report,
+        DeviceContext& device_context, library::Operation const* operation,
+        ProblemSpace const& problem_space,
+        ProblemSpace::Problem const& problem) {
+    library::ConvolutionDescription const& operation_desc =
+            static_cast<library::ConvolutionDescription const&>(
+                    operation->description());
+
+    if (!arg_as_int(problem_.n, "n", problem_space, problem)) {
+        // default value
+        problem_.n = 1;
+    }
+
+    if (!arg_as_int(problem_.h, "h", problem_space, problem)) {
+        // default value
+        problem_.h = 16;
+    }
+
+    if (!arg_as_int(problem_.w, "w", problem_space, problem)) {
+        // default value
+        problem_.w = 16;
+    }
+
+    if (!arg_as_int(problem_.c, "c", problem_space, problem)) {
+        // default value
+        problem_.c = 64;
+    }
+
+    if (!arg_as_int(problem_.k, "k", problem_space, problem)) {
+        // default value
+        problem_.k = 64;
+    }
+
+    if (!arg_as_int(problem_.r, "r", problem_space, problem)) {
+        // default value
+        problem_.r = 3;
+    }
+
+    if (!arg_as_int(problem_.s, "s", problem_space, problem)) {
+        // default value
+        problem_.s = 3;
+    }
+
+    if (!arg_as_int(problem_.pad_h, "pad_h", problem_space, problem)) {
+        // default value
+        problem_.pad_h = 1;
+    }
+
+    if (!arg_as_int(problem_.pad_w, "pad_w", problem_space, problem)) {
+        // default value
+        problem_.pad_w = 1;
+    }
+
+    if (!arg_as_int(problem_.stride_h, "stride_h", problem_space, problem)) {
+        // default value
+        problem_.stride_h = 1;
+    }
+
+    if (!arg_as_int(problem_.stride_w, "stride_w", problem_space, problem)) {
+        // default value
+        problem_.stride_w = 1;
+    }
+
+    if (!arg_as_int(problem_.dilation_h, "dilation_h", problem_space,
+                    problem)) {
+        // default value
+        problem_.dilation_h = 1;
+    }
+
+    if (!arg_as_int(problem_.dilation_w, "dilation_w", problem_space,
+                    problem)) {
+        // default value
+        problem_.dilation_w = 1;
+    }
+
+    // output extents default to the cuDNN formula, as for Conv2d
+    if (!arg_as_int(problem_.p, "p", problem_space, problem)) {
+        problem_.p = (problem_.h + 2 * problem_.pad_h -
+                      ((problem_.r - 1) * problem_.dilation_h + 1)) /
+                             (problem_.stride_h) +
+                     1;
+    }
+
+    if (!arg_as_int(problem_.q, "q", problem_space, problem)) {
+        problem_.q = (problem_.w + 2 * problem_.pad_w -
+                      ((problem_.s - 1) * problem_.dilation_w + 1)) /
+                             (problem_.stride_w) +
+                     1;
+    }
+
+    if (!conv_type_satisfies(operation_desc.conv_type, "conv_type",
+                             problem_space, problem)) {
+        return Status::kErrorInvalidProblem;
+    }
+
+    if (!epilogue_satisfies(operation_desc.epilogue, "epilogue", problem_space,
+                            problem)) {
+        return Status::kErrorInvalidProblem;
+    }
+
+    if (!tensor_description_satisfies(operation_desc.A, "Src", problem_space,
+                                      problem)) {
+        return Status::kErrorInvalidProblem;
+    }
+
+    if (!tensor_description_satisfies(operation_desc.B, "Filter",
+                                      problem_space, problem)) {
+        return Status::kErrorInvalidProblem;
+    }
+
+    if (!tensor_description_satisfies(operation_desc.bias, "Bias",
+                                      problem_space, problem)) {
+        return Status::kErrorInvalidProblem;
+    }
+
+    if (!tensor_description_satisfies(operation_desc.C, "Dst", problem_space,
+                                      problem)) {
+        return Status::kErrorInvalidProblem;
+    }
+
+    if (!arg_as_scalar(problem_.alpha, operation_desc.element_epilogue, "alpha",
+                       problem_space, problem)) {
+        if (!cast_from_double(problem_.alpha, operation_desc.element_epilogue,
+                              1)) {
+            return Status::kErrorInternal;
+        }
+    }
+
+    if (!arg_as_scalar(problem_.beta, operation_desc.element_epilogue, "beta",
+                       problem_space, problem)) {
+        if (!cast_from_double(problem_.beta, operation_desc.element_epilogue,
+                              1)) {
+            return Status::kErrorInternal;
+        }
+    }
+
+    if (!arg_as_scalar(problem_.gamma, operation_desc.element_epilogue, "gamma",
+                       problem_space, problem)) {
+        if (!cast_from_double(problem_.gamma, operation_desc.element_epilogue,
+                              0)) {
+            return Status::kErrorInternal;
+        }
+    }
+
+    // initialize library::ConvolutionConfiguration
+    conv_workspace_.configuration.problem_size = conv::Conv2dProblemSize(
+            int(problem_.n), int(problem_.h), int(problem_.w), int(problem_.c),
+            int(problem_.k), int(problem_.r), int(problem_.s), int(problem_.p),
+            int(problem_.q), int(problem_.pad_h), int(problem_.pad_w),
+            int(problem_.stride_h), int(problem_.stride_w),
+            int(problem_.dilation_h), int(problem_.dilation_w),
+            conv::Mode::kCrossCorrelation,
+            1,  // split_k_slices
+            1   // groups
+    );
+
+    // initialize library::ConvolutionArguments
+    conv_workspace_.arguments.src = nullptr;
+    conv_workspace_.arguments.filter = nullptr;
+    conv_workspace_.arguments.bias = nullptr;
+    conv_workspace_.arguments.z = nullptr;
+    conv_workspace_.arguments.dst = nullptr;
+    conv_workspace_.arguments.alpha = problem_.alpha.data();
+    conv_workspace_.arguments.beta = problem_.beta.data();
+    conv_workspace_.arguments.gamma = problem_.gamma.data();
+    conv_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+    initialize_result_(this->model_result_, options, operation_desc,
+                       problem_space);
+
+    return operation->can_implement(&conv_workspace_.configuration,
+                                    &conv_workspace_.arguments);
+}
+
+/// Initializes the performance result
+void ConvolutionOperationProfiler::initialize_result_(
+        PerformanceResult& result, Options const& options,
+        library::ConvolutionDescription const& operation_desc,
+        ProblemSpace const& problem_space) {
+    result.provider = library::Provider::kCUTLASS;
+    result.disposition = Disposition::kNotRun;
+    result.status = Status::kSuccess;
+    result.operation_name = operation_desc.name;
+
+    result.arguments.resize(problem_space.rank());
+
+    set_argument(result, "Src", problem_space,
+                 std::string(library::to_string(operation_desc.A.element)) +
+                         ":" + library::to_string(operation_desc.A.layout));
+
+    set_argument(result, "Filter", problem_space,
+                 std::string(library::to_string(operation_desc.B.element)) +
+                         ":" + library::to_string(operation_desc.B.layout));
+
+    set_argument(
+            result, "Bias", problem_space,
+            std::string(library::to_string(operation_desc.bias.element)) +
+                    ":" + library::to_string(operation_desc.bias.layout));
+
+    set_argument(result, "Dst", problem_space,
+                 std::string(library::to_string(operation_desc.C.element)) +
+                         ":" + library::to_string(operation_desc.C.layout));
+
+    set_argument(result, "conv_type", problem_space,
+                 library::to_string(operation_desc.conv_type));
+
+    set_argument(result, "epilogue", problem_space,
+                 library::to_string(operation_desc.epilogue));
+
+    set_argument(result, "n", problem_space, problem_.n);
+    set_argument(result, "h", problem_space, problem_.h);
+    set_argument(result, "w", problem_space, problem_.w);
+    set_argument(result, "c", problem_space, problem_.c);
+
+    set_argument(result, "k", problem_space, problem_.k);
+    set_argument(result, "r", problem_space, problem_.r);
+    set_argument(result, "s", problem_space, problem_.s);
+
+    set_argument(result, "p", problem_space, problem_.p);
+    set_argument(result, "q", problem_space, problem_.q);
+
+    set_argument(result, "pad_h", problem_space, problem_.pad_h);
+    set_argument(result, "pad_w", problem_space, problem_.pad_w);
+
+    set_argument(result, "stride_h", problem_space, problem_.stride_h);
+    set_argument(result, "stride_w", problem_space, problem_.stride_w);
+
+    set_argument(result, "dilation_h", problem_space, problem_.dilation_h);
+    set_argument(result, "dilation_w", problem_space, problem_.dilation_w);
+
+    set_argument(result, "alpha", problem_space,
+                 library::lexical_cast(problem_.alpha,
+                                       operation_desc.element_epilogue));
+
+    set_argument(result, "beta", problem_space,
+                 library::lexical_cast(problem_.beta,
+                                       operation_desc.element_epilogue));
+
+    set_argument(result, "gamma", problem_space,
+                 library::lexical_cast(problem_.gamma,
+                                       operation_desc.element_epilogue));
+
+    OperationProfiler::initialize_result_(result, operation_desc,
+                                          problem_space);
+
+    result.bytes = problem_.bytes(operation_desc);
+    result.flops = problem_.flops(operation_desc);
+    result.runtime = 0;
+
+    // Tiles of the equivalent implicit GEMM
+    cutlass::gemm::GemmCoord mnk = problem_.eq_gemm_size();
+    cutlass::gemm::GemmCoord const& tile =
+            operation_desc.tile_description.threadblock_shape;
+
+    result.model = PerformanceModel(
+            operation_desc, operation_desc.A.element, operation_desc.B.element,
+            tile_count(mnk.m(), tile.m()) * tile_count(mnk.n(), tile.n()));
+}
+
+/// Initializes workspace
+Status ConvolutionOperationProfiler::initialize_workspace(
+        Options const& options, PerformanceReport& report,
+        DeviceContext& device_context, library::Operation const* operation,
+        ProblemSpace const& problem_space,
+        ProblemSpace::Problem const& problem) {
+    library::ConvolutionDescription const& operation_desc =
+            static_cast<library::ConvolutionDescription const&>(
+                    operation->description());
+
+    // Compute the number of copies of the problem to avoid L2 camping.
+    conv_workspace_.problem_count =
+            workspace_problem_count_(options, problem_.bytes(operation_desc));
+
+    // Device memory of src, filter, bias, z, the computed dst and the
+    // reference dst
+    int64_t workspace_bytes =
+            DeviceAllocation::bytes(operation_desc.A.element,
+                                    operation_desc.A.layout,
+                                    problem_.extent_src(), {},
+                                    conv_workspace_.problem_count) +
+            DeviceAllocation::bytes(operation_desc.B.element,
+                                    operation_desc.B.layout,
+                                    problem_.extent_filter(), {},
+                                    conv_workspace_.problem_count) +
+            DeviceAllocation::bytes(operation_desc.bias.element,
+                                    operation_desc.bias.layout,
+                                    problem_.extent_bias(), {},
+                                    conv_workspace_.problem_count) +
+            3 * DeviceAllocation::bytes(operation_desc.C.element,
+                                        operation_desc.C.layout,
+                                        problem_.extent_dst(), {},
+                                        conv_workspace_.problem_count);
+
+    if (options.execution_mode != ExecutionMode::kDryRun) {
+        conv_workspace_.src = device_context.allocate_tensor(
+                options, "Src", operation_desc.A.element,
+                operation_desc.A.layout, problem_.extent_src(), {},
+                conv_workspace_.problem_count);
+
+        conv_workspace_.filter = device_context.allocate_tensor(
+                options, "Filter", operation_desc.B.element,
+                operation_desc.B.layout, problem_.extent_filter(), {},
+                conv_workspace_.problem_count);
+
+        conv_workspace_.bias = device_context.allocate_tensor(
+                options, "Bias", operation_desc.bias.element,
+                operation_desc.bias.layout, problem_.extent_bias(), {},
+                conv_workspace_.problem_count);
+
+        conv_workspace_.z = device_context.allocate_tensor(
+                options, "Z", operation_desc.C.element, operation_desc.C.layout,
+                problem_.extent_dst(), {}, conv_workspace_.problem_count);
+
+        conv_workspace_.Computed = device_context.allocate_tensor(
+                "Dst", operation_desc.C.element, operation_desc.C.layout,
+                problem_.extent_dst(), {}, conv_workspace_.problem_count);
+
+        conv_workspace_.Reference = device_context.allocate_tensor(
+                "Reference", operation_desc.C.element, operation_desc.C.layout,
+                problem_.extent_dst(), {}, conv_workspace_.problem_count);
+    }
+
+    //
+    // Initialize the CUTLASS operation
+    //
+    Status status = Status::kSuccess;
+
+    if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        uint64_t device_workspace_size = operation->get_device_workspace_size(
+                &conv_workspace_.configuration);
+
+        if (options.execution_mode != ExecutionMode::kDryRun) {
+            uint64_t workspace_size = operation->get_host_workspace_size(
+                    &conv_workspace_.configuration);
+            conv_workspace_.host_workspace.resize(workspace_size, 0);
+
+            conv_workspace_.device_workspace.reset(library::NumericTypeID::kU8,
+                                                   device_workspace_size);
+
+            status = operation->initialize(
+                    &conv_workspace_.configuration,
+                    conv_workspace_.host_workspace.data(),
+                    conv_workspace_.device_workspace.data());
+
+            if (status != Status::kSuccess) {
+                return status;
+            }
+        }
+
+        //
+        // If CUTLASS is enabled, generate a result for it
+        //
+        results_.push_back(model_result_);
+        results_.back().provider = library::Provider::kCUTLASS;
+        results_.back().op_kind = library::OperationKind::kConvolution;
+        results_.back().disposition = Disposition::kNotRun;
+        results_.back().workspace_bytes =
+                workspace_bytes + int64_t(device_workspace_size);
+
+        for (auto provider : verification_providers_) {
+            results_.back().verification_map[provider] = Disposition::kNotRun;
+        }
+    }
+
+    return status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Verifies CUTLASS against references
+bool ConvolutionOperationProfiler::verify_cutlass(
+        Options const& options, PerformanceReport& report,
+        DeviceContext& device_context, library::Operation const* operation,
+        ProblemSpace const& problem_space,
+        ProblemSpace::Problem const& problem) {
+    if (!options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        return true;
+    }
+
+    if (options.execution_mode == ExecutionMode::kDryRun) {
+        return true;
+    }
+
+    // Initialize structure containing Convolution arguments
+    conv_workspace_.arguments.src = conv_workspace_.src->data();
+    conv_workspace_.arguments.filter = conv_workspace_.filter->data();
+    conv_workspace_.arguments.bias = conv_workspace_.bias->data();
+    conv_workspace_.arguments.z = conv_workspace_.z->data();
+    conv_workspace_.arguments.dst = conv_workspace_.Computed->data();
+    conv_workspace_.arguments.alpha = problem_.alpha.data();
+    conv_workspace_.arguments.beta = problem_.beta.data();
+    conv_workspace_.arguments.gamma = problem_.gamma.data();
+    conv_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+    //
+    // Run the CUTLASS operation
+    //
+    results_.back().status = operation->run(
+            &conv_workspace_.arguments, conv_workspace_.host_workspace.data(),
+            conv_workspace_.device_workspace.data());
+
+    if (results_.back().status != Status::kSuccess) {
+        results_.back().disposition = Disposition::kFailed;
+        return false;
+    }
+
+    cudaError_t result = cudaDeviceSynchronize();
+    if (result != cudaSuccess) {
+        results_.back().disposition = Disposition::kFailed;
+        return false;
+    }
+
+    // CUTLASS op ran the but not yet verified against any verification provider
+    results_.back().disposition = Disposition::kNotVerified;
+
+    //
+    // Run verification providers
+    //
+
+    if (options.verification.enabled) {
+        if (options.verification.provider_enabled(
+                    library::Provider::kReferenceHost)) {
+            verify_with_host_reference_(options, report, device_context,
+                                        operation, problem_space, problem);
+        }
+
+        // Update disposition to worst case verification outcome among all
+        // verification providers which are supported
+        bool is_any_verification_run_passed = false;
+        for (auto& m : results_.back().verification_map) {
+            if (m.second == Disposition::kFailed ||
+                m.second == Disposition::kIncorrect) {
+                results_.back().disposition = m.second;
+                return true;
+            }
+            if (!is_any_verification_run_passed &&
+                m.second == Disposition::kPassed) {
+                is_any_verification_run_passed = true;
+            }
+        }
+
+        if (is_any_verification_run_passed) {
+            results_.back().disposition = Disposition::kPassed;
+        }
+    }
+
+    // Return true means continue profiling
+    return true;
+}
+
+/// Returns the host reference operation matching an operation
+library::Operation const* ConvolutionOperationProfiler::find_host_reference_(
+        library::ConvolutionDescription const& operation_desc) const {
+    // The host reference implements the linear combination epilogues only
+    if (operation_desc.epilogue !=
+                library::EpilogueKind::kBiasAddLinearCombination &&
+        operation_desc.epilogue !=
+                library::EpilogueKind::kBiasAddLinearCombinationClamp) {
+        return nullptr;
+    }
+
+    library::ConvFunctionalKey key(
+            library::Provider::kReferenceHost, operation_desc.conv_kind,
+            operation_desc.A.element, operation_desc.A.layout,
+            operation_desc.B.element, operation_desc.B.layout,
+            operation_desc.C.element, operation_desc.C.layout,
+            operation_desc.tile_description.math_instruction
+                    .element_accumulator,
+            operation_desc.element_epilogue);
+
+    library::ConvOperationVectorMap const* operators =
+            Singleton::get().operation_table.find_convolution_operations(key);
+
+    if (!operators) {
+        return nullptr;
+    }
+
+    // host reference minimum cc is 0 (CPU) and no iterator algorithm
+    auto cc_it = operators->find(library::ConvPreferenceKey(
+            0, library::IteratorAlgorithmID::kNone));
+
+    if (cc_it == operators->end() || cc_it->second.empty()) {
+        return nullptr;
+    }
+
+    // the bias is not part of the functional key
+    for (library::Operation const* reference_op : cc_it->second) {
+        auto const& reference_desc =
+                static_cast<library::ConvolutionDescription const&>(
+                        reference_op->description());
+
+        if (reference_desc.conv_type == operation_desc.conv_type &&
+            reference_desc.bias.element == operation_desc.bias.element &&
+            reference_desc.bias.layout == operation_desc.bias.layout) {
+            return reference_op;
+        }
+    }
+
+    return nullptr;
+}
+
+/// Verifies CUTLASS against host reference
+bool ConvolutionOperationProfiler::verify_with_host_reference_(
+        Options const& options, PerformanceReport& report,
+        DeviceContext& device_context, library::Operation const* operation,
+        ProblemSpace const& problem_space,
+        ProblemSpace::Problem const& problem) {
+    auto const& operation_desc =
+            static_cast<library::ConvolutionDescription const&>(
+                    operation->description());
+
+    library::Operation const* reference_op =
+            find_host_reference_(operation_desc);
+
+    if (!reference_op) {
+        results_.back().verification_map[library::Provider::kReferenceHost] =
+                Disposition::kNotSupported;
+        return true;
+    }
+
+    if (options.verification.host_async()) {
+        verify_with_host_reference_async_(options, reference_op);
+        return true;
+    }
+
+    //
+    // Copy input tensors from device to host buffers
+    //
+    std::vector<uint8_t> host_src(conv_workspace_.src->bytes());
+    std::vector<uint8_t> host_filter(conv_workspace_.filter->bytes());
+    std::vector<uint8_t> host_bias(conv_workspace_.bias->bytes());
+    std::vector<uint8_t> host_z(conv_workspace_.z->bytes());
+    std::vector<uint8_t> host_dst(conv_workspace_.Reference->bytes());
+
+    conv_workspace_.src->copy_to_host(host_src.data());
+    conv_workspace_.filter->copy_to_host(host_filter.data());
+    conv_workspace_.bias->copy_to_host(host_bias.data());
+    conv_workspace_.z->copy_to_host(host_z.data());
+
+    library::ConvolutionArguments arguments = conv_workspace_.arguments;
+    arguments.src = host_src.data();
+    arguments.filter = host_filter.data();
+    arguments.bias = host_bias.data();
+    arguments.z = host_z.data();
+    arguments.dst = host_dst.data();
+
+    //
+    // Intialize and run host reference operation
+    //
+    std::vector<uint8_t> host_workspace_reference_op(
+            reference_op->get_host_workspace_size(
+                    &conv_workspace_.configuration),
+            0);
+
+    reference_op->initialize(&conv_workspace_.configuration,
+                             host_workspace_reference_op.data());
+
+    library::TraceScope reference_scope(
+            library::TraceEventKind::kReference,
+            reference_op->description().name);
+
+    Status status =
+            reference_op->run(&arguments, host_workspace_reference_op.data());
+
+    reference_scope.finish();
+
+    if (status != Status::kSuccess) {
+        results_.back().verification_map[library::Provider::kReferenceHost] =
+                Disposition::kNotVerified;
+        return true;
+    }
+
+    //
+    // Copy host reference output to device memory for equality check on device
+    //
+    conv_workspace_.Reference->copy_from_host(host_dst.data());
+
+    //
+    // Verify results
+    //
+    results_.back().verification_map[library::Provider::kReferenceHost] =
+            compare_tensors(options, *conv_workspace_.Computed,
+                            *conv_workspace_.Reference,
+                            conv_workspace_.Computed->batch_stride());
+
+    // Save workspace if incorrect
+    if (options.verification.save_workspace == SaveWorkspace::kIncorrect &&
+        results_.back().verification_map[library::Provider::kReferenceHost] ==
+                Disposition::kIncorrect) {
+        save_workspace(device_context, options, operation_desc,
+                       library::Provider::kCUTLASS,
+                       library::Provider::kReferenceHost);
+    }
+
+    // Return true means continue profiling
+    return true;
+}
+
+/// Verifies CUTLASS against a host reference operation on the verification
+/// threads
+void ConvolutionOperationProfiler::verify_with_host_reference_async_(
+        Options const& options, library::Operation const* reference_op) {
+    // The check owns host copies of its operands since device allocations
+    // are released before it completes
+    auto host_src = copy_to_host_(*conv_workspace_.src);
+    auto host_filter = copy_to_host_(*conv_workspace_.filter);
+    auto host_bias = copy_to_host_(*conv_workspace_.bias);
+    auto host_z = copy_to_host_(*conv_workspace_.z);
+    auto host_computed = copy_to_host_(*conv_workspace_.Computed);
+
+    library::ConvolutionConfiguration configuration =
+            conv_workspace_.configuration;
+
+    std::vector<uint8_t> alpha = problem_.alpha;
+    std::vector<uint8_t> beta = problem_.beta;
+    std::vector<uint8_t> gamma = problem_.gamma;
+
+    library::NumericTypeID element_dst = conv_workspace_.Computed->type();
+    size_t count = conv_workspace_.Computed->batch_stride();
+    double epsilon = options.verification.epsilon;
+    double nonzero_floor = options.verification.nonzero_floor;
+
+    verify_on_host_async_(
+            options, library::Provider::kReferenceHost,
+            [=]() -> Disposition {
+                std::vector<uint8_t> host_dst(host_computed->size());
+
+                library::ConvolutionArguments arguments;
+                arguments.src = host_src->data();
+                arguments.filter = host_filter->data();
+                arguments.bias = host_bias->data();
+                arguments.z = host_z->data();
+                arguments.dst = host_dst.data();
+                arguments.alpha = alpha.data();
+                arguments.beta = beta.data();
+                arguments.gamma = gamma.data();
+                arguments.pointer_mode = library::ScalarPointerMode::kHost;
+
+                std::vector<uint8_t> host_workspace(
+                        reference_op->get_host_workspace_size(&configuration),
+                        0);
+
+                reference_op->initialize(&configuration,
+                                         host_workspace.data());
+
+                library::TraceScope reference_scope(
+                        library::TraceEventKind::kReference,
+                        reference_op->description().name);
+
+                Status status =
+                        reference_op->run(&arguments, host_workspace.data());
+
+                reference_scope.finish();
+
+                if (status != Status::kSuccess) {
+                    return Disposition::kNotVerified;
+                }
+
+                return host_block_compare(element_dst, host_computed->data(),
+                                          host_dst.data(), count, epsilon,
+                                          nonzero_floor)
+                               ? Disposition::kPassed
+                               : Disposition::kIncorrect;
+            });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Measures performance results
+bool ConvolutionOperationProfiler::profile(
+        Options const& options, PerformanceReport& report,
+        DeviceContext& device_context, library::Operation const* operation,
+        ProblemSpace const& problem_space,
+        ProblemSpace::Problem const& problem) {
+    if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        // Initialize structure containing Convolution arguments
+        conv_workspace_.arguments.src = conv_workspace_.src->data();
+        conv_workspace_.arguments.filter = conv_workspace_.filter->data();
+        conv_workspace_.arguments.bias = conv_workspace_.bias->data();
+        conv_workspace_.arguments.z = conv_workspace_.z->data();
+        conv_workspace_.arguments.dst = conv_workspace_.Computed->data();
+        conv_workspace_.arguments.alpha = problem_.alpha.data();
+        conv_workspace_.arguments.beta = problem_.beta.data();
+        conv_workspace_.arguments.gamma = problem_.gamma.data();
+        conv_workspace_.arguments.pointer_mode =
+                library::ScalarPointerMode::kHost;
+
+        results_.back().status =
+                profile_cutlass_(results_.back(), options, operation,
+                                 &conv_workspace_.arguments,
+                                 conv_workspace_.host_workspace.data(),
+                                 conv_workspace_.device_workspace.data());
+    }
+
+    return true;
+}
+
+/// Method to profile a CUTLASS Operation
+Status ConvolutionOperationProfiler::profile_cutlass_(
+        PerformanceResult& result, Options const& options,
+        library::Operation const* operation, void* arguments,
+        void* host_workspace, void* device_workspace) {
+    GpuSampledTimer timer(options.profiling.iterations_per_sample);
+
+    library::ConvolutionArguments* conv_arguments =
+            static_cast<library::ConvolutionArguments*>(arguments);
+
+    //
+    // Optional sleep to limit power consumption and thermals
+    //
+
+    sleep(options.profiling.sleep_duration);
+
+    //
+    // Warmup loop
+    //
+
+    Status status;
+
+    for (int iteration = 0; iteration < options.profiling.warmup_iterations;
+         ++iteration) {
+        // Setup rotating workspace
+        int workspace_idx = options.profiling.warmup_iterations + iteration;
+        int problem_idx = (workspace_idx % conv_workspace_.problem_count);
+
+        conv_arguments->src = conv_workspace_.src->batch_data(problem_idx);
+        conv_arguments->filter =
+                conv_workspace_.filter->batch_data(problem_idx);
+        conv_arguments->bias = conv_workspace_.bias->batch_data(problem_idx);
+        conv_arguments->z = conv_workspace_.z->batch_data(problem_idx);
+        conv_arguments->dst = conv_workspace_.Computed->batch_data(problem_idx);
+
+        status = operation->run(arguments, host_workspace, device_workspace);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+    }
+
+    //
+    // Initialize GPU timer
+    //
+
+    timer.start();
+
+    //
+    // Profiling loop
+    //
+
+    int iteration = 0;
+    for (; !profiling_complete_(options, timer); ++iteration) {
+        flush_cache_(options, timer);
+
+        // Setup rotating workspace
+        int problem_idx = (iteration % conv_workspace_.problem_count);
+
+        conv_arguments->src = conv_workspace_.src->batch_data(problem_idx);
+        conv_arguments->filter =
+                conv_workspace_.filter->batch_data(problem_idx);
+        conv_arguments->bias = conv_workspace_.bias->batch_data(problem_idx);
+        conv_arguments->z = conv_workspace_.z->batch_data(problem_idx);
+        conv_arguments->dst = conv_workspace_.Computed->batch_data(problem_idx);
+
+        status = operation->run(arguments, host_workspace, device_workspace);
+
+        if (status != Status::kSuccess) {
+            return status;
+        }
+
+        timer.iteration_complete();
+    }
+
+    //
+    // Wait for completion
+    //
+
+    timer.stop_and_wait();
+
+    //
+    // Update performance result
+    //
+
+    set_runtime_(result, options, timer);
+
+    return status;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
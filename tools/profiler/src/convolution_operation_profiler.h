@@ -0,0 +1,253 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Defines profiling functionality for MegEngine convolution operations
+          (implicit GEMM forward convolution with bias)
+*/
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+
+// CUTLASS Library includes
+#include "cutlass/library/library.h"
+#include "cutlass/library/util.h"
+#include "cutlass/library/handle.h"
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/singleton.h"
+
+// Profiler includes
+#include "options.h"
+#include "device_context.h"
+#include "operation_profiler.h"
+#include "performance_result.h"
+#include "problem_space.h"
+#include "debug.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Profiles cutlass::conv::device::Convolution operations
+class ConvolutionOperationProfiler : public OperationProfiler {
+public:
+    /// Problem structure obtained from problem space
+    struct ConvolutionProblem {
+        int64_t n, h, w, c, p, q, k, r, s;
+        int64_t pad_h, pad_w;
+        int64_t stride_h, stride_w;
+        int64_t dilation_h, dilation_w;
+
+        /// Scales the accumulators
+        std::vector<uint8_t> alpha;
+
+        /// Scales the bias
+        std::vector<uint8_t> beta;
+
+        /// Scales the residual tensor z
+        std::vector<uint8_t> gamma;
+
+        //
+        // Methods
+        //
+
+        /// Total number of bytes loaded
+        int64_t bytes(
+                library::ConvolutionDescription const& operation_desc) const;
+
+        /// Total number of flops computed
+        int64_t flops(
+                library::ConvolutionDescription const& operation_desc) const;
+
+        /// Returns the equivalent implicit GEMM problem size
+        cutlass::gemm::GemmCoord eq_gemm_size() const {
+            return cutlass::gemm::GemmCoord(int(n * p * q), int(k),
+                                            int(r * s * c));
+        }
+
+        /// Returns extent of the source tensor
+        std::vector<int> extent_src() const {
+            return {int(n), int(h), int(w), int(c)};
+        }
+
+        /// Returns extent of the filter tensor
+        std::vector<int> extent_filter() const {
+            return {int(k), int(r), int(s), int(c)};
+        }
+
+        /// Returns extent of the bias tensor
+        std::vector<int> extent_bias() const { return {1, 1, 1, int(k)}; }
+
+        /// Returns extent of the destination and residual tensors
+        std::vector<int> extent_dst() const {
+            return {int(n), int(p), int(q), int(k)};
+        }
+    };
+
+    /// Workspace used
+    struct ConvolutionWorkspace {
+        /// Device allocations
+        DeviceAllocation* src;
+        DeviceAllocation* filter;
+        DeviceAllocation* bias;
+        DeviceAllocation* z;
+        DeviceAllocation* Computed;
+        DeviceAllocation* Reference;
+
+        /// Library configuration and arguments
+        library::ConvolutionConfiguration configuration;
+        library::ConvolutionArguments arguments;
+
+        /// Number of copies of the problem workspace which are visited
+        /// sequentially during profiling to avoid camping in the last level
+        /// cache.
+        int problem_count;
+
+        /// Buffer used for the operation's host workspace
+        std::vector<uint8_t> host_workspace;
+
+        /// Buffer used for the operation's device workspace
+        DeviceAllocation device_workspace;
+
+        //
+        // Methods
+        //
+
+        ConvolutionWorkspace()
+                : src(nullptr),
+                  filter(nullptr),
+                  bias(nullptr),
+                  z(nullptr),
+                  Computed(nullptr),
+                  Reference(nullptr),
+                  problem_count(1) {}
+    };
+
+protected:
+    //
+    // Data members
+    //
+
+    /// Problem obtained from problem space
+    ConvolutionProblem problem_;
+
+    /// Device memory allocations
+    ConvolutionWorkspace conv_workspace_;
+
+public:
+    //
+    // Methods
+    //
+
+    /// Ctor
+    ConvolutionOperationProfiler(Options const& options);
+
+    /// Destructor
+    virtual ~ConvolutionOperationProfiler();
+
+    /// Prints usage statement for the math function
+    virtual void print_usage(std::ostream& out) const;
+
+    /// Prints examples
+    virtual void print_examples(std::ostream& out) const;
+
+    /// Extracts the problem dimensions
+    virtual Status initialize_configuration(
+            Options const& options, PerformanceReport& report,
+            DeviceContext& device_context, library::Operation const* operation,
+            ProblemSpace const& problem_space,
+            ProblemSpace::Problem const& problem);
+
+    /// Initializes workspace
+    virtual Status initialize_workspace(Options const& options,
+                                        PerformanceReport& report,
+                                        DeviceContext& device_context,
+                                        library::Operation const* operation,
+                                        ProblemSpace const& problem_space,
+                                        ProblemSpace::Problem const& problem);
+
+    /// Verifies CUTLASS against references
+    virtual bool verify_cutlass(Options const& options,
+                                PerformanceReport& report,
+                                DeviceContext& device_context,
+                                library::Operation const* operation,
+                                ProblemSpace const& problem_space,
+                                ProblemSpace::Problem const& problem);
+
+    /// Measures performance results
+    virtual bool profile(Options const& options, PerformanceReport& report,
+                         DeviceContext& device_context,
+                         library::Operation const* operation,
+                         ProblemSpace const& problem_space,
+                         ProblemSpace::Problem const& problem);
+
+protected:
+    /// Method to profile an initialized CUTLASS operation
+    virtual Status profile_cutlass_(PerformanceResult& result,
+                                    Options const& options,
+                                    library::Operation const* operation,
+                                    void* arguments, void* host_workspace,
+                                    void* device_workspace);
+
+    /// Initializes the performance result
+    void initialize_result_(
+            PerformanceResult& result, Options const& options,
+            library::ConvolutionDescription const& operation_desc,
+            ProblemSpace const& problem_space);
+
+    /// Returns the host reference operation matching an operation, or
+    /// nullptr if there is none or its epilogue cannot be verified
+    library::Operation const* find_host_reference_(
+            library::ConvolutionDescription const& operation_desc) const;
+
+    /// Verifies CUTLASS against host reference
+    bool verify_with_host_reference_(Options const& options,
+                                     PerformanceReport& report,
+                                     DeviceContext& device_context,
+                                     library::Operation const* operation,
+                                     ProblemSpace const& problem_space,
+                                     ProblemSpace::Problem const& problem);
+
+    /// Verifies CUTLASS against a host reference operation on the
+    /// verification threads
+    void verify_with_host_reference_async_(
+            Options const& options, library::Operation const* reference_op);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
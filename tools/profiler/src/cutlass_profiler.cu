@@ -28,6 +28,7 @@
    \brief Execution environment
 */
 
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
@@ -36,6 +37,7 @@
 #include "gemm_operation_profiler.h"
 #include "conv2d_operation_profiler.h"
 #include "conv3d_operation_profiler.h"
+#include "convolution_operation_profiler.h"
 #include "sparse_gemm_operation_profiler.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -53,6 +55,9 @@ CutlassProfiler::CutlassProfiler(Options const& options) : options_(options) {
     operation_profilers_.emplace_back(new Conv2dOperationProfiler(options));
 
     operation_profilers_.emplace_back(new Conv3dOperationProfiler(options));
+
+    operation_profilers_.emplace_back(
+            new ConvolutionOperationProfiler(options));
 }
 
 CutlassProfiler::~CutlassProfiler() {}
@@ -87,8 +92,25 @@ int CutlassProfiler::operator()() {
     if (options_.execution_mode == ExecutionMode::kProfile ||
         options_.execution_mode == ExecutionMode::kDryRun ||
         options_.execution_mode == ExecutionMode::kTrace) {
+        if (!options_.report.chrome_trace_path.empty()) {
+            library::set_trace_enabled(true);
+        }
+
         // Profiles all operations
         profile_();
+
+        if (!options_.report.chrome_trace_path.empty()) {
+            if (!library::write_chrome_trace(
+                        options_.report.chrome_trace_path.c_str())) {
+                std::cerr << "Could not write trace to '"
+                          << options_.report.chrome_trace_path << "'"
+                          << std::endl;
+            } else if (options_.report.verbose) {
+                std::cout << "\nWrote trace to '"
+                          << options_.report.chrome_trace_path << "'"
+                          << std::endl;
+            }
+        }
     } else if (options_.execution_mode == ExecutionMode::kEnumerate) {
         // Enumerates all operations
         enumerate_();
@@ -107,6 +129,14 @@ int CutlassProfiler::profile_() {
     int result = 0;
     DeviceContext device_context;
 
+    // Profilers enumerate the manifest, so construct every operation which
+    // would otherwise be deferred until its functional key is queried.
+    library::Singleton::get().operation_table.initialize_all();
+
+    if (!options_.workload_path.empty()) {
+        return profile_workload_(device_context);
+    }
+
     // For all profilers
     for (auto& profiler : operation_profilers_) {
         if (options_.operation_kind == library::OperationKind::kInvalid ||
@@ -124,6 +154,48 @@ int CutlassProfiler::profile_() {
     return result;
 }
 
+/// Profiles the records of a workload trace
+int CutlassProfiler::profile_workload_(DeviceContext& device_context) {
+    WorkloadRecordVector records;
+
+    try {
+        std::ifstream workload_file(options_.workload_path);
+        if (!workload_file.good()) {
+            throw std::runtime_error("could not open '" +
+                                     options_.workload_path + "'");
+        }
+        records = read_workload(workload_file);
+    } catch (std::exception const& error) {
+        std::cerr << "Failed to read workload: " << error.what() << std::endl;
+        return 1;
+    }
+
+    WorkloadSummary summary(records);
+
+    int result = 0;
+
+    for (auto& profiler : operation_profilers_) {
+        bool has_records = false;
+        for (auto const& record : records) {
+            has_records = has_records || record.op_kind == profiler->kind();
+        }
+
+        if (has_records) {
+            result = profiler->profile_workload(
+                    options_, library::Singleton::get().manifest,
+                    device_context, summary);
+
+            if (result) {
+                return result;
+            }
+        }
+    }
+
+    summary.print(std::cout);
+
+    return result;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Prints all options
@@ -33,6 +33,7 @@
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/singleton.h"
+#include "cutlass/library/trace.h"
 
 #include "options.h"
 #include "operation_profiler.h"
@@ -73,6 +74,9 @@ private:
     /// Profiles all operations
     int profile_();
 
+    /// Profiles the records of a workload trace
+    int profile_workload_(DeviceContext& device_context);
+
 public:
     CutlassProfiler(Options const& options);
     ~CutlassProfiler();
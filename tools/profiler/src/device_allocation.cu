@@ -53,6 +53,21 @@ size_t DeviceAllocation::bytes(library::NumericTypeID type, size_t capacity) {
     return size_t(cutlass::library::sizeof_bits(type)) * capacity / 8;
 }
 
+size_t DeviceAllocation::bytes(library::NumericTypeID type,
+                               library::LayoutTypeID layout_id,
+                               std::vector<int> const& extent,
+                               std::vector<int> const& stride,
+                               int batch_count) {
+    std::vector<uint8_t> layout_buffer(
+            sizeof(int) * library::get_layout_stride_rank(layout_id), 0);
+    std::vector<int> layout_stride = stride;
+
+    size_t batch_stride = construct_layout(layout_buffer.data(), layout_id,
+                                           extent, layout_stride);
+
+    return bytes(type, batch_stride * size_t(batch_count));
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename Layout>
@@ -169,6 +184,26 @@ std::vector<int> DeviceAllocation::get_packed_layout(
                     get_packed_layout_stride<cutlass::layout::TensorCxRSKx<64>>(
                             extent);
             break;
+        case library::LayoutTypeID::kTensorNC4HW4:
+            stride =
+                    get_packed_layout_stride<cutlass::layout::TensorNCxHWx<4>>(
+                            extent);
+            break;
+        case library::LayoutTypeID::kTensorNC8HW8:
+            stride =
+                    get_packed_layout_stride<cutlass::layout::TensorNCxHWx<8>>(
+                            extent);
+            break;
+        case library::LayoutTypeID::kTensorNC16HW16:
+            stride =
+                    get_packed_layout_stride<cutlass::layout::TensorNCxHWx<16>>(
+                            extent);
+            break;
+        case library::LayoutTypeID::kTensorC4RSK4:
+            stride =
+                    get_packed_layout_stride<cutlass::layout::TensorCxRSKx<4>>(
+                            extent);
+            break;
         default:
             break;
     }
@@ -309,6 +344,22 @@ size_t DeviceAllocation::construct_layout(void* bytes,
             return construct_layout_<cutlass::layout::TensorCxRSKx<64>>(
                     bytes, layout_id, extent, stride);
 
+        case library::LayoutTypeID::kTensorNC4HW4:
+            return construct_layout_<cutlass::layout::TensorNCxHWx<4>>(
+                    bytes, layout_id, extent, stride);
+
+        case library::LayoutTypeID::kTensorNC8HW8:
+            return construct_layout_<cutlass::layout::TensorNCxHWx<8>>(
+                    bytes, layout_id, extent, stride);
+
+        case library::LayoutTypeID::kTensorNC16HW16:
+            return construct_layout_<cutlass::layout::TensorNCxHWx<16>>(
+                    bytes, layout_id, extent, stride);
+
+        case library::LayoutTypeID::kTensorC4RSK4:
+            return construct_layout_<cutlass::layout::TensorCxRSKx<4>>(
+                    bytes, layout_id, extent, stride);
+
         default:
             break;
     }
@@ -1274,6 +1325,22 @@ static void write_tensor_csv_static_type(std::ostream& out,
             write_tensor_csv_static_tensor_view<T, layout::TensorCxRSKx<64>>(
                     out, allocation);
             break;
+        case library::LayoutTypeID::kTensorNC4HW4:
+            write_tensor_csv_static_tensor_view<T, layout::TensorNCxHWx<4>>(
+                    out, allocation);
+            break;
+        case library::LayoutTypeID::kTensorNC8HW8:
+            write_tensor_csv_static_tensor_view<T, layout::TensorNCxHWx<8>>(
+                    out, allocation);
+            break;
+        case library::LayoutTypeID::kTensorNC16HW16:
+            write_tensor_csv_static_tensor_view<T, layout::TensorNCxHWx<16>>(
+                    out, allocation);
+            break;
+        case library::LayoutTypeID::kTensorC4RSK4:
+            write_tensor_csv_static_tensor_view<T, layout::TensorCxRSKx<4>>(
+                    out, allocation);
+            break;
         default:
             throw std::runtime_error("Unhandled layout");
     }
@@ -89,6 +89,14 @@ public:
     static std::vector<int> get_packed_layout(library::LayoutTypeID layout_id,
                                               std::vector<int> const& extent);
 
+    /// Determines the number of bytes a batch of tensors of the given layout
+    /// occupies without allocating them
+    static size_t bytes(library::NumericTypeID type,
+                        library::LayoutTypeID layout_id,
+                        std::vector<int> const& extent,
+                        std::vector<int> const& stride = std::vector<int>(),
+                        int batch_count = 1);
+
     /// returns the capacity needed
     static size_t construct_layout(void* bytes, library::LayoutTypeID layout_id,
                                    std::vector<int> const& extent,
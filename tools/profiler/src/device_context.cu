@@ -28,6 +28,10 @@
    \brief
 */
 
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
 #include "device_context.h"
 
 namespace cutlass {
@@ -35,6 +39,78 @@ namespace profiler {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Identifies a tensor by everything determining its contents except the
+/// batch count. A cached batch serves requests for fewer tensors.
+std::string tensor_key(std::string const& name, library::NumericTypeID type,
+                       library::LayoutTypeID layout_id,
+                       std::vector<int> const& extent,
+                       std::vector<int> const& stride, Options const& options) {
+    std::stringstream ss;
+
+    ss << name << ";" << library::to_string(type) << ";"
+       << library::to_string(layout_id) << ";";
+
+    for (int dim : extent) {
+        ss << dim << "x";
+    }
+    ss << ";";
+
+    for (int dim : stride) {
+        ss << dim << "x";
+    }
+
+    ss << ";" << library::to_string(options.initialization.provider) << ";"
+       << options.initialization.seed;
+
+    return ss.str();
+}
+
+/// Distribution of random tensor elements of a numeric type
+Distribution data_distribution(Options const& options,
+                               library::NumericTypeID type) {
+    Distribution data_distribution = options.initialization.data_distribution;
+
+    // check if data distribution is allowed to change
+    if (!options.initialization.fix_data_distribution) {
+        // change data distribution based on bit width
+        switch (type) {
+            case library::NumericTypeID::kB1:
+                data_distribution.set_uniform(0, 1, 0);
+                break;
+            case library::NumericTypeID::kS2:
+                data_distribution.set_uniform(-1, 1, 0);
+                break;
+            case library::NumericTypeID::kS4:
+                data_distribution.set_uniform(-2, 2, 0);
+                break;
+            case library::NumericTypeID::kU2:
+                data_distribution.set_uniform(0, 2, 0);
+                break;
+            case library::NumericTypeID::kU4:
+                data_distribution.set_uniform(0, 2, 0);
+                break;
+            case library::NumericTypeID::kS8:
+                data_distribution.set_uniform(-3, 3, 0);
+                break;
+            case library::NumericTypeID::kU8:
+                data_distribution.set_uniform(0, 4, 0);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return data_distribution;
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+DeviceContext::DeviceContext() : tensor_cache_bytes_(0), use_clock_(0) {}
+
 /// Allocates memory of a given type, capacity (elements), and name
 DeviceAllocation* DeviceContext::allocate_block(std::string const& name,
                                                 library::NumericTypeID type,
@@ -58,60 +134,61 @@ DeviceAllocation* DeviceContext::allocate_tensor(
     return allocation;
 }
 
-/// Allocates memory of a given type, capacity (elements), and name
+/// Allocates memory of a given type, capacity (elements), and name and
+/// initializes it as selected by the options. An identical tensor
+/// initialized for a previous operation is reused if it is still cached.
 DeviceAllocation* DeviceContext::allocate_tensor(
         Options const& options, std::string const& name,
         library::NumericTypeID type, library::LayoutTypeID layout_id,
         std::vector<int> const& extent, std::vector<int> const& stride,
         int batch_count) {
-    DeviceAllocation* allocation =
-            allocate_tensor(name, type, layout_id, extent, stride, batch_count);
-
-    if (options.initialization.enabled) {
-        Distribution data_distribution =
-                options.initialization.data_distribution;
-
-        // check if data distribution is allowed to change
-        if (!options.initialization.fix_data_distribution) {
-            // change data distribution based on bit width
-            switch (type) {
-                case library::NumericTypeID::kB1:
-                    data_distribution.set_uniform(0, 1, 0);
-                    break;
-                case library::NumericTypeID::kS2:
-                    data_distribution.set_uniform(-1, 1, 0);
-                    break;
-                case library::NumericTypeID::kS4:
-                    data_distribution.set_uniform(-2, 2, 0);
-                    break;
-                case library::NumericTypeID::kU2:
-                    data_distribution.set_uniform(0, 2, 0);
-                    break;
-                case library::NumericTypeID::kU4:
-                    data_distribution.set_uniform(0, 2, 0);
-                    break;
-                case library::NumericTypeID::kS8:
-                    data_distribution.set_uniform(-3, 3, 0);
-                    break;
-                case library::NumericTypeID::kU8:
-                    data_distribution.set_uniform(0, 4, 0);
-                    break;
-                default:
-                    break;
-            }
-        }
+    if (!options.initialization.enabled) {
+        return allocate_tensor(name, type, layout_id, extent, stride,
+                               batch_count);
+    }
+
+    Distribution distribution = data_distribution(options, type);
+
+    std::stringstream key;
+    key << std::setprecision(17)
+        << tensor_key(name, type, layout_id, extent, stride, options) << ";"
+        << int(distribution.kind) << ";" << distribution.int_scale;
+
+    switch (distribution.kind) {
+        case Distribution::Uniform:
+            key << ";" << distribution.uniform.min << ";"
+                << distribution.uniform.max;
+            break;
+        case Distribution::Gaussian:
+            key << ";" << distribution.gaussian.mean << ";"
+                << distribution.gaussian.stddev;
+            break;
+        case Distribution::Sequential:
+            key << ";" << distribution.sequential.start << ";"
+                << distribution.sequential.delta;
+            break;
+        default:
+            break;
+    }
+
+    DeviceAllocation* allocation = find_cached_(key.str(), batch_count);
+
+    if (!allocation) {
+        allocation = allocate_cached_(options, key.str(), type, layout_id,
+                                      extent, stride, batch_count);
 
         if (options.initialization.provider ==
             library::Provider::kReferenceDevice) {
             allocation->initialize_random_device(options.initialization.seed,
-                                                 data_distribution);
+                                                 distribution);
         } else if (options.initialization.provider ==
                    library::Provider::kReferenceHost) {
             allocation->initialize_random_host(options.initialization.seed,
-                                               data_distribution);
+                                               distribution);
         }
     }
 
+    allocations_[name] = allocation;
     return allocation;
 }
 
@@ -121,13 +198,23 @@ DeviceAllocation* DeviceContext::allocate_sparsemeta_tensor(
         library::NumericTypeID type, library::LayoutTypeID layout_id,
         library::NumericTypeID type_a, std::vector<int> const& extent,
         std::vector<int> const& stride, int batch_count) {
-    DeviceAllocation* allocation =
-            allocate_tensor(name, type, layout_id, extent, stride, batch_count);
+    if (!options.initialization.enabled) {
+        return allocate_tensor(name, type, layout_id, extent, stride,
+                               batch_count);
+    }
+
+    // TF32 has 4bit meta data.  The rest has 2bit.
+    int MetaSizeInBits = (cutlass::library::sizeof_bits(type_a) == 32) ? 4 : 2;
 
-    if (options.initialization.enabled) {
-        // TF32 has 4bit meta data.  The rest has 2bit.
-        int MetaSizeInBits =
-                (cutlass::library::sizeof_bits(type_a) == 32) ? 4 : 2;
+    std::stringstream key;
+    key << tensor_key(name, type, layout_id, extent, stride, options)
+        << ";meta" << MetaSizeInBits;
+
+    DeviceAllocation* allocation = find_cached_(key.str(), batch_count);
+
+    if (!allocation) {
+        allocation = allocate_cached_(options, key.str(), type, layout_id,
+                                      extent, stride, batch_count);
 
         if (options.initialization.provider ==
             library::Provider::kReferenceDevice) {
@@ -140,14 +227,35 @@ DeviceAllocation* DeviceContext::allocate_sparsemeta_tensor(
         }
     }
 
+    allocations_[name] = allocation;
     return allocation;
 }
+
+/// Removes the named tensor from the cache
+void DeviceContext::invalidate(std::string const& name) {
+    auto named = allocations_.find(name);
+    if (named == allocations_.end()) {
+        return;
+    }
+
+    for (auto it = tensor_cache_.begin(); it != tensor_cache_.end(); ++it) {
+        if (&*it->allocation == named->second) {
+            // The operation keeps using the tensor until free()
+            tensor_cache_bytes_ -= it->allocation->bytes();
+            device_memory_.splice(device_memory_.end(), cached_memory_,
+                                  it->allocation);
+            tensor_cache_.erase(it);
+            return;
+        }
+    }
+}
+
 /// Clears named allocations (but does not necessarily free memory)
 void DeviceContext::clear() {
     allocations_.clear();
 }
 
-/// Frees all device memory allocations
+/// Frees all device memory allocations except cached tensors
 void DeviceContext::free() {
     allocations_.clear();
     device_memory_.clear();
@@ -170,6 +278,100 @@ DeviceContext::AllocationMap::iterator DeviceContext::end() {
     return allocations_.end();
 }
 
+/// Returns a cached tensor matching the key and holding at least
+/// batch_count tensors, or nullptr
+DeviceAllocation* DeviceContext::find_cached_(std::string const& key,
+                                              int batch_count) {
+    for (auto& entry : tensor_cache_) {
+        if (entry.key == key && entry.allocation->batch_count() >= batch_count &&
+            !in_use_(&*entry.allocation)) {
+            entry.last_use = ++use_clock_;
+            return &*entry.allocation;
+        }
+    }
+
+    return nullptr;
+}
+
+/// Allocates a tensor to be initialized by the caller, keeping it in the
+/// cache if it fits within the budget of the options
+DeviceAllocation* DeviceContext::allocate_cached_(
+        Options const& options, std::string const& key,
+        library::NumericTypeID type, library::LayoutTypeID layout_id,
+        std::vector<int> const& extent, std::vector<int> const& stride,
+        int batch_count) {
+    size_t budget = options.initialization.tensor_cache_budget >= 0
+                            ? size_t(options.initialization.tensor_cache_budget)
+                            : options.device.properties.totalGlobalMem / 4;
+
+    size_t bytes = DeviceAllocation::bytes(type, layout_id, extent, stride,
+                                           batch_count);
+
+    auto evict = [&](std::vector<CachedTensor>::iterator it) {
+        tensor_cache_bytes_ -= it->allocation->bytes();
+        cached_memory_.erase(it->allocation);
+        return tensor_cache_.erase(it);
+    };
+
+    // Smaller batches of the same tensor are superseded, so a cached tensor
+    // grows to the largest batch requested
+    for (auto it = tensor_cache_.begin(); it != tensor_cache_.end();) {
+        if (it->key == key && !in_use_(&*it->allocation)) {
+            it = evict(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Least recently used tensors are evicted to stay within the budget.
+    // Tensors of the current operation are kept.
+    while (bytes <= budget && tensor_cache_bytes_ + bytes > budget) {
+        auto victim = tensor_cache_.end();
+        for (auto it = tensor_cache_.begin(); it != tensor_cache_.end();
+             ++it) {
+            if (!in_use_(&*it->allocation) &&
+                (victim == tensor_cache_.end() ||
+                 it->last_use < victim->last_use)) {
+                victim = it;
+            }
+        }
+
+        if (victim == tensor_cache_.end()) {
+            break;
+        }
+
+        evict(victim);
+    }
+
+    if (bytes > budget || tensor_cache_bytes_ + bytes > budget) {
+        device_memory_.emplace_back(type, layout_id, extent, stride,
+                                    batch_count);
+        return &device_memory_.back();
+    }
+
+    cached_memory_.emplace_back(type, layout_id, extent, stride, batch_count);
+
+    CachedTensor entry;
+    entry.key = key;
+    entry.allocation = std::prev(cached_memory_.end());
+    entry.last_use = ++use_clock_;
+    tensor_cache_.push_back(entry);
+
+    tensor_cache_bytes_ += entry.allocation->bytes();
+
+    return &*entry.allocation;
+}
+
+/// Returns true if the allocation is named by the current operation
+bool DeviceContext::in_use_(DeviceAllocation const* allocation) const {
+    for (auto const& named : allocations_) {
+        if (named.second == allocation) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 }  // namespace profiler
@@ -30,8 +30,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "cutlass/library/library.h"
 #include "cutlass/library/util.h"
@@ -63,7 +65,34 @@ private:
     /// Non-owning set of named allocations
     AllocationMap allocations_;
 
+    /// Initialized input tensor retained across operations and problems
+    struct CachedTensor {
+        /// Name, type, layout, extent, stride and initialization of the tensor
+        std::string key;
+
+        /// Owned by cached_memory_
+        DeviceAllocationList::iterator allocation;
+
+        /// Value of use_clock_ when the tensor was last handed out
+        uint64_t last_use;
+    };
+
+    /// Memory of cached tensors (owning)
+    DeviceAllocationList cached_memory_;
+
+    /// Cached tensors. Few tensors are live at once, so they are searched
+    /// linearly.
+    std::vector<CachedTensor> tensor_cache_;
+
+    /// Bytes held by cached_memory_
+    size_t tensor_cache_bytes_;
+
+    /// Counts allocations to order cached tensors by their last use
+    uint64_t use_clock_;
+
 public:
+    DeviceContext();
+
     /// Allocates memory of a given type, capacity (elements), and name
     DeviceAllocation* allocate_block(std::string const& name,
                                      library::NumericTypeID type,
@@ -76,7 +105,9 @@ public:
             std::vector<int> const& stride = std::vector<int>(),
             int batch_count = 1);
 
-    /// Allocates memory of a given type, capacity (elements), and name
+    /// Allocates memory of a given type, capacity (elements), and name and
+    /// initializes it as selected by the options. An identical tensor
+    /// initialized for a previous operation is reused if it is still cached.
     DeviceAllocation* allocate_tensor(
             Options const& options, std::string const& name,
             library::NumericTypeID type, library::LayoutTypeID layout_id,
@@ -92,10 +123,15 @@ public:
             std::vector<int> const& stride = std::vector<int>(),
             int batch_count = 1);
 
+    /// Removes the named tensor from the cache. Must be called before an
+    /// operation writes to an input tensor in place, so that later
+    /// operations do not read its output as their input.
+    void invalidate(std::string const& name);
+
     /// Clears named allocations (but does not necessarily free memory)
     void clear();
 
-    /// Frees all device memory allocations
+    /// Frees all device memory allocations except cached tensors
     void free();
 
     /// Gets the allocation by name
@@ -105,6 +141,22 @@ public:
 
     AllocationMap::iterator begin();
     AllocationMap::iterator end();
+
+private:
+    /// Returns a cached tensor matching the key and holding at least
+    /// batch_count tensors, or nullptr
+    DeviceAllocation* find_cached_(std::string const& key, int batch_count);
+
+    /// Allocates a tensor to be initialized by the caller, keeping it in the
+    /// cache if it fits within the budget of the options
+    DeviceAllocation* allocate_cached_(
+            Options const& options, std::string const& key,
+            library::NumericTypeID type, library::LayoutTypeID layout_id,
+            std::vector<int> const& extent, std::vector<int> const& stride,
+            int batch_count);
+
+    /// Returns true if the allocation is named by the current operation
+    bool in_use_(DeviceAllocation const* allocation) const;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
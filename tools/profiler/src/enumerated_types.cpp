@@ -115,6 +115,84 @@ AlgorithmMode from_string<AlgorithmMode>(std::string const& str) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+static struct {
+    char const* text;
+    char const* pretty;
+    SamplingMode enumerant;
+} SamplingMode_enumerants[] = {
+        {"exhaustive", "Exhaustive", SamplingMode::kExhaustive},
+        {"lhs", "Latin hypercube", SamplingMode::kLatinHypercube},
+        {"latin_hypercube", "Latin hypercube", SamplingMode::kLatinHypercube},
+        {"sobol", "Sobol", SamplingMode::kSobol}};
+
+/// Converts a SamplingMode enumerant to a string
+char const* to_string(SamplingMode mode, bool pretty) {
+    for (auto const& possible : SamplingMode_enumerants) {
+        if (mode == possible.enumerant) {
+            if (pretty) {
+                return possible.pretty;
+            } else {
+                return possible.text;
+            }
+        }
+    }
+
+    return pretty ? "Invalid" : "invalid";
+}
+
+/// Parses a SamplingMode enumerant from a string
+template <>
+SamplingMode from_string<SamplingMode>(std::string const& str) {
+    for (auto const& possible : SamplingMode_enumerants) {
+        if ((str.compare(possible.text) == 0) ||
+            (str.compare(possible.pretty) == 0)) {
+            return possible.enumerant;
+        }
+    }
+
+    return SamplingMode::kInvalid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+static struct {
+    char const* text;
+    char const* pretty;
+    CacheMode enumerant;
+} CacheMode_enumerants[] = {{"warm", "Warm", CacheMode::kWarm},
+                            {"rotating", "Rotating", CacheMode::kRotating},
+                            {"cold", "Cold", CacheMode::kCold}};
+
+/// Converts a CacheMode enumerant to a string
+char const* to_string(CacheMode mode, bool pretty) {
+    for (auto const& possible : CacheMode_enumerants) {
+        if (mode == possible.enumerant) {
+            if (pretty) {
+                return possible.pretty;
+            } else {
+                return possible.text;
+            }
+        }
+    }
+
+    return pretty ? "Invalid" : "invalid";
+}
+
+/// Parses a CacheMode enumerant from a string
+template <>
+CacheMode from_string<CacheMode>(std::string const& str) {
+    for (auto const& possible : CacheMode_enumerants) {
+        if ((str.compare(possible.text) == 0) ||
+            (str.compare(possible.pretty) == 0)) {
+            return possible.enumerant;
+        }
+    }
+
+    return CacheMode::kInvalid;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 static struct {
     char const* text;
     char const* pretty;
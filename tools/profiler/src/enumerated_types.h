@@ -87,6 +87,40 @@ AlgorithmMode from_string<AlgorithmMode>(std::string const& str);
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Strategy used to visit points of a problem space
+enum class SamplingMode {
+    kExhaustive,      ///< visits the full cartesian product
+    kLatinHypercube,  ///< stratified random sample of the problem space
+    kSobol,           ///< low-discrepancy quasi-random sample
+    kInvalid
+};
+
+/// Converts a SamplingMode enumerant to a string
+char const* to_string(SamplingMode mode, bool pretty = false);
+
+/// Parses a SamplingMode enumerant from a string
+template <>
+SamplingMode from_string<SamplingMode>(std::string const& str);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// State of the L2 cache when a timed kernel launches
+enum class CacheMode {
+    kWarm,      ///< every launch reuses one copy of the operands
+    kRotating,  ///< launches rotate through more operand copies than fit in L2
+    kCold,      ///< the L2 is flushed before every launch, outside the timing
+    kInvalid
+};
+
+/// Converts a CacheMode enumerant to a string
+char const* to_string(CacheMode mode, bool pretty = false);
+
+/// Parses a CacheMode enumerant from a string
+template <>
+CacheMode from_string<CacheMode>(std::string const& str);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Outcome of a performance test
 enum class Disposition {
     kPassed,
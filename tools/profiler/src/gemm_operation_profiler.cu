@@ -404,6 +404,15 @@ void GemmOperationProfiler::initialize_result_(
     result.bytes = problem_.bytes(operation_desc);
     result.flops = problem_.flops(operation_desc);
     result.runtime = 0;
+
+    // Each split-K slice of each batch launches its own grid of output tiles
+    cutlass::gemm::GemmCoord const& tile =
+            operation_desc.tile_description.threadblock_shape;
+
+    result.model = PerformanceModel(
+            operation_desc, operation_desc.A.element, operation_desc.B.element,
+            tile_count(problem_.m, tile.m()) * tile_count(problem_.n, tile.n()) *
+                    problem_.batch_count * problem_.split_k_slices);
 }
 
 /// Initializes workspace
@@ -417,19 +426,24 @@ Status GemmOperationProfiler::initialize_workspace(
                     operation->description());
 
     // Compute the number of copies of the problem to avoid L2 camping.
-    if (!options.profiling.workspace_count) {
-        int64_t bytes = problem_.bytes(operation_desc);
-        if (bytes < 3 * int64_t(options.device.properties.l2CacheSize)) {
-            gemm_workspace_.problem_count =
-                    1 +
-                    int((3 * int64_t(options.device.properties.l2CacheSize)) /
-                        bytes);
-        } else {
-            gemm_workspace_.problem_count = 1;
-        }
-    } else {
-        gemm_workspace_.problem_count = options.profiling.workspace_count;
-    }
+    gemm_workspace_.problem_count =
+            workspace_problem_count_(options, problem_.bytes(operation_desc));
+
+    // Device memory of A, B, C, the computed D and the reference D
+    int batch_count = problem_.batch_count * gemm_workspace_.problem_count;
+    int64_t workspace_bytes =
+            DeviceAllocation::bytes(operation_desc.A.element,
+                                    operation_desc.A.layout,
+                                    {int(problem_.m), int(problem_.k)},
+                                    {int(problem_.lda)}, batch_count) +
+            DeviceAllocation::bytes(operation_desc.B.element,
+                                    operation_desc.B.layout,
+                                    {int(problem_.k), int(problem_.n)},
+                                    {int(problem_.ldb)}, batch_count) +
+            3 * DeviceAllocation::bytes(operation_desc.C.element,
+                                        operation_desc.C.layout,
+                                        {int(problem_.m), int(problem_.n)},
+                                        {int(problem_.ldc)}, batch_count);
 
     if (options.execution_mode != ExecutionMode::kDryRun) {
         gemm_workspace_.A = device_context.allocate_tensor(
@@ -466,15 +480,16 @@ Status GemmOperationProfiler::initialize_workspace(
     Status status = Status::kSuccess;
 
     if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        uint64_t device_workspace_size = operation->get_device_workspace_size(
+                &gemm_workspace_.configuration);
+
         if (options.execution_mode != ExecutionMode::kDryRun) {
             uint64_t workspace_size = operation->get_host_workspace_size(
                     &gemm_workspace_.configuration);
             gemm_workspace_.host_workspace.resize(workspace_size, 0);
 
-            workspace_size = operation->get_device_workspace_size(
-                    &gemm_workspace_.configuration);
             gemm_workspace_.device_workspace.reset(library::NumericTypeID::kU8,
-                                                   workspace_size);
+                                                   device_workspace_size);
 
             status = operation->initialize(
                     &gemm_workspace_.configuration,
@@ -489,6 +504,8 @@ Status GemmOperationProfiler::initialize_workspace(
         results_.back().provider = library::Provider::kCUTLASS;
         results_.back().op_kind = library::OperationKind::kGemm;
         results_.back().disposition = Disposition::kNotRun;
+        results_.back().workspace_bytes =
+                workspace_bytes + int64_t(device_workspace_size);
 
         for (auto provider : verification_providers_) {
             results_.back().verification_map[provider] = Disposition::kNotRun;
@@ -681,8 +698,13 @@ bool GemmOperationProfiler::verify_with_cublas_(
 
         results_.back().status = Status::kSuccess;
 
+        library::TraceScope reference_scope(library::TraceEventKind::kReference,
+                                            "cublasGemmEx");
+
         status = gemm_op(handle);
 
+        reference_scope.finish();
+
         // Handle errors
         if (status != CUBLAS_STATUS_SUCCESS) {
             results_.back().verification_map[library::Provider::kCUBLAS] =
@@ -743,6 +765,12 @@ bool GemmOperationProfiler::verify_with_reference_(
             continue;
         }
 
+        if (provider == library::Provider::kReferenceHost &&
+            options.verification.host_async()) {
+            verify_with_host_reference_async_(options, operation);
+            continue;
+        }
+
         void* ptr_A = gemm_workspace_.A->data();
         void* ptr_B = gemm_workspace_.B->data();
         void* ptr_C = gemm_workspace_.C->data();
@@ -840,6 +868,86 @@ bool GemmOperationProfiler::verify_with_reference_(
     return true;
 }
 
+/// Verifies CUTLASS against the host reference on the verification threads
+void GemmOperationProfiler::verify_with_host_reference_async_(
+        Options const& options, library::Operation const* operation) {
+    library::GemmDescription const* gemm_desc =
+            static_cast<library::GemmDescription const*>(
+                    &operation->description());
+
+    // The check owns host copies of its operands since device allocations
+    // are released before it completes
+    auto host_A = copy_to_host_(*gemm_workspace_.A);
+    auto host_B = copy_to_host_(*gemm_workspace_.B);
+    auto host_C = copy_to_host_(*gemm_workspace_.C);
+    auto host_computed = copy_to_host_(*gemm_workspace_.Computed);
+
+    auto handle = std::make_shared<library::Handle>(nullptr, 0);
+    handle->set_provider(library::Provider::kReferenceHost);
+
+    library::GemmUniversalConfiguration configuration =
+            gemm_workspace_.configuration;
+
+    std::vector<uint8_t> alpha = problem_.alpha;
+    std::vector<uint8_t> beta = problem_.beta;
+
+    int64_t batch_stride_A = gemm_workspace_.A->batch_stride();
+    int64_t batch_stride_B = gemm_workspace_.B->batch_stride();
+    int64_t batch_stride_C = gemm_workspace_.C->batch_stride();
+    int64_t batch_stride_D = gemm_workspace_.Reference->batch_stride();
+    size_t reference_bytes = gemm_workspace_.Reference->bytes();
+
+    library::NumericTypeID element_D = gemm_workspace_.Computed->type();
+    size_t count = gemm_workspace_.Computed->batch_stride();
+    double epsilon = options.verification.epsilon;
+    double nonzero_floor = options.verification.nonzero_floor;
+
+    verify_on_host_async_(
+            options, library::Provider::kReferenceHost,
+            [=]() -> Disposition {
+                std::vector<uint8_t> host_D(reference_bytes);
+
+                Status status = handle->gemm_universal(
+                        library::GemmUniversalMode::kGemm,
+                        configuration.problem_size.m(),
+                        configuration.problem_size.n(),
+                        configuration.problem_size.k(),
+                        gemm_desc->tile_description.math_instruction
+                                .element_accumulator,
+                        gemm_desc->element_epilogue,
+
+                        alpha.data(),
+
+                        gemm_desc->A.element, gemm_desc->A.layout,
+                        gemm_desc->transform_A, host_A->data(),
+                        int(configuration.lda),
+
+                        gemm_desc->B.element, gemm_desc->B.layout,
+                        gemm_desc->transform_B, host_B->data(),
+                        int(configuration.ldb),
+
+                        beta.data(),
+
+                        gemm_desc->C.element, host_C->data(),
+                        int(configuration.ldc),
+
+                        host_D.data(), int(configuration.ldd),
+
+                        configuration.batch_count, batch_stride_A,
+                        batch_stride_B, batch_stride_C, batch_stride_D);
+
+                if (status != Status::kSuccess) {
+                    return Disposition::kNotRun;
+                }
+
+                return host_block_compare(element_D, host_computed->data(),
+                                          host_D.data(), count, epsilon,
+                                          nonzero_floor)
+                               ? Disposition::kPassed
+                               : Disposition::kIncorrect;
+            });
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Measures performance results
@@ -869,22 +977,128 @@ bool GemmOperationProfiler::profile(Options const& options,
                 gemm_workspace_.Computed->batch_stride();
 
         results_.back().status =
-                profile_cutlass_(results_.back().runtime, options, operation,
+                profile_cutlass_(results_.back(), options, operation,
                                  &gemm_workspace_.arguments,
                                  gemm_workspace_.host_workspace.data(),
                                  gemm_workspace_.device_workspace.data());
     }
+
+#if CUTLASS_ENABLE_CUBLAS
+    if (options.profiling.provider_enabled(library::Provider::kCUBLAS) &&
+        !results_.empty() && vendor_profiling_pending_(results_.back())) {
+        profile_cublas_(options, operation);
+    }
+#endif
+
     return true;
 }
 
+#if CUTLASS_ENABLE_CUBLAS
+
+/// Measures the runtime of cuBLAS on the current problem
+void GemmOperationProfiler::profile_cublas_(
+        Options const& options, library::Operation const* operation) {
+    library::GemmDescription const& gemm_desc =
+            static_cast<library::GemmDescription const&>(
+                    operation->description());
+
+    // The cuBLAS result shares the problem, bytes and flops of the CUTLASS
+    // result
+    PerformanceResult result = results_.back();
+    result.provider = library::Provider::kCUBLAS;
+    result.operation_name = "cublasGemmEx";
+    result.status = Status::kErrorNotSupported;
+    result.disposition = Disposition::kNotVerified;
+    result.verification_map.clear();
+    result.runtime = 0;
+    result.runtime_statistics = RuntimeStatistics();
+
+    // The vendor library chooses its own tiling
+    result.model.tiles = 0;
+
+    CublasCreate handle;
+    if (handle.get_cublas_create_status() != CUBLAS_STATUS_SUCCESS) {
+        return;
+    }
+
+    std::vector<cublasGemmAlgo_t> algorithms;
+
+    detail::select_cublas_algorithms(algorithms, options, gemm_desc);
+
+    if (algorithms.empty()) {
+        return;
+    }
+
+    try {
+        gemm_workspace_.arguments.A = gemm_workspace_.A->data();
+        gemm_workspace_.arguments.batch_stride_A =
+                gemm_workspace_.A->batch_stride();
+        gemm_workspace_.arguments.B = gemm_workspace_.B->data();
+        gemm_workspace_.arguments.batch_stride_B =
+                gemm_workspace_.B->batch_stride();
+        gemm_workspace_.arguments.C = gemm_workspace_.Reference->data();
+        gemm_workspace_.arguments.batch_stride_C =
+                gemm_workspace_.Reference->batch_stride();
+        gemm_workspace_.arguments.D = gemm_workspace_.Reference->data();
+        gemm_workspace_.arguments.batch_stride_D =
+                gemm_workspace_.Reference->batch_stride();
+        gemm_workspace_.arguments.alpha = problem_.alpha.data();
+        gemm_workspace_.arguments.beta = problem_.beta.data();
+        gemm_workspace_.arguments.pointer_mode =
+                library::ScalarPointerMode::kHost;
+
+        detail::cublasGemmExDispatcher gemm_op(
+                gemm_desc, gemm_workspace_.configuration,
+                gemm_workspace_.arguments, algorithms.front());
+
+        if (gemm_op.status != Status::kSuccess) {
+            return;
+        }
+
+        sleep(options.profiling.sleep_duration);
+
+        for (int iteration = 0; iteration < options.profiling.warmup_iterations;
+             ++iteration) {
+            if (gemm_op(handle) != CUBLAS_STATUS_SUCCESS) {
+                return;
+            }
+        }
+
+        GpuSampledTimer timer(options.profiling.iterations_per_sample);
+
+        timer.start();
+
+        while (!profiling_complete_(options, timer)) {
+            flush_cache_(options, timer);
+
+            if (gemm_op(handle) != CUBLAS_STATUS_SUCCESS) {
+                return;
+            }
+
+            timer.iteration_complete();
+        }
+
+        timer.stop_and_wait();
+
+        result.status = Status::kSuccess;
+        set_runtime_(result, options, timer);
+    } catch (...) {
+        return;
+    }
+
+    results_.push_back(result);
+}
+
+#endif
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Method to profile a CUTLASS Operation
 Status GemmOperationProfiler::profile_cutlass_(
-        double& runtime, Options const& options,
+        PerformanceResult& result, Options const& options,
         library::Operation const* operation, void* arguments,
         void* host_workspace, void* device_workspace) {
-    GpuTimer timer;
+    GpuSampledTimer timer(options.profiling.iterations_per_sample);
 
     //
     // Optional sleep to limit power consumption and thermals
@@ -931,10 +1145,10 @@ Status GemmOperationProfiler::profile_cutlass_(
     // Profiling loop
     //
 
-    int Iterations = options.profiling.iterations;
-
     int iteration = 0;
-    for (; iteration < Iterations; ++iteration) {
+    for (; !profiling_complete_(options, timer); ++iteration) {
+        flush_cache_(options, timer);
+
         // Iterate over copies of the problem in memory
         int workspace_idx = options.profiling.warmup_iterations + iteration;
         int problem_idx = (workspace_idx % gemm_workspace_.problem_count) *
@@ -954,6 +1168,8 @@ Status GemmOperationProfiler::profile_cutlass_(
         if (status != Status::kSuccess) {
             return status;
         }
+
+        timer.iteration_complete();
     }
 
     //
@@ -966,7 +1182,7 @@ Status GemmOperationProfiler::profile_cutlass_(
     // Update performance result
     //
 
-    runtime = timer.duration(iteration);
+    set_runtime_(result, options, timer);
 
     return status;
 }
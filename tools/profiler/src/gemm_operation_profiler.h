@@ -218,8 +218,21 @@ protected:
                                 ProblemSpace const& problem_space,
                                 ProblemSpace::Problem const& problem);
 
+    /// Verifies CUTLASS against the host reference on the verification
+    /// threads
+    void verify_with_host_reference_async_(Options const& options,
+                                           library::Operation const* operation);
+
+#if CUTLASS_ENABLE_CUBLAS
+    /// Measures the runtime of cuBLAS on the current problem and appends it
+    /// as a result of the cuBLAS provider
+    void profile_cublas_(Options const& options,
+                         library::Operation const* operation);
+#endif
+
     /// Method to profile a CUTLASS Operation
-    Status profile_cutlass_(double& runtime, Options const& options,
+    Status profile_cutlass_(PerformanceResult& result,
+                            Options const& options,
                             library::Operation const* operation,
                             void* arguments, void* host_workspace,
                             void* device_workspace);
@@ -104,5 +104,164 @@ double GpuTimer::duration(int iterations) const {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+GpuSampledTimer::GpuSampledTimer(int batch_size)
+        : recorded(0),
+          batch_size(batch_size > 0 ? batch_size : 1),
+          iterations(0),
+          paused(0) {}
+
+GpuSampledTimer::~GpuSampledTimer() {
+    for (auto& event : events) {
+        cudaEventDestroy(event);
+    }
+    for (auto& event : pause_events) {
+        cudaEventDestroy(event);
+    }
+}
+
+/// Records the next event, creating events as needed
+void GpuSampledTimer::record_(cudaStream_t stream) {
+    if (recorded == int(events.size())) {
+        cudaEvent_t event;
+        if (cudaEventCreate(&event) != cudaSuccess) {
+            throw std::runtime_error("Failed to create CUDA event");
+        }
+        events.push_back(event);
+    }
+
+    if (cudaEventRecord(events[recorded], stream) != cudaSuccess) {
+        throw std::runtime_error("Failed to record sample event.");
+    }
+
+    event_iterations.resize(recorded + 1);
+    event_iterations[recorded] = iterations;
+    ++recorded;
+}
+
+/// Records one of the events bracketing a pause, creating events as needed
+void GpuSampledTimer::record_pause_(int index, cudaStream_t stream) {
+    if (index == int(pause_events.size())) {
+        cudaEvent_t event;
+        if (cudaEventCreate(&event) != cudaSuccess) {
+            throw std::runtime_error("Failed to create CUDA event");
+        }
+        pause_events.push_back(event);
+    }
+
+    if (cudaEventRecord(pause_events[index], stream) != cudaSuccess) {
+        throw std::runtime_error("Failed to record pause event.");
+    }
+}
+
+/// Records a start event in the stream
+void GpuSampledTimer::start(cudaStream_t stream) {
+    recorded = 0;
+    iterations = 0;
+    paused = 0;
+    record_(stream);
+}
+
+/// Counts a completed iteration, recording an event after each batch
+void GpuSampledTimer::iteration_complete(cudaStream_t stream) {
+    ++iterations;
+    if (iterations % batch_size == 0) {
+        record_(stream);
+    }
+}
+
+/// Stops measuring work enqueued in the stream until resume()
+void GpuSampledTimer::pause(cudaStream_t stream) {
+    pause_after.resize(paused + 1);
+    pause_after[paused] = recorded - 1;
+    record_pause_(2 * paused, stream);
+}
+
+/// Resumes measuring work enqueued in the stream
+void GpuSampledTimer::resume(cudaStream_t stream) {
+    record_pause_(2 * paused + 1, stream);
+    ++paused;
+}
+
+/// Records a stop event in the stream and synchronizes on it
+void GpuSampledTimer::stop_and_wait(cudaStream_t stream) {
+    // a partial batch contributes to the duration but not to the samples
+    if (iterations != event_iterations[recorded - 1]) {
+        record_(stream);
+    }
+    wait();
+}
+
+/// Waits until all recorded events have completed
+void GpuSampledTimer::wait() const {
+    if (cudaEventSynchronize(events[recorded - 1]) != cudaSuccess) {
+        throw std::runtime_error("Failed to synchronize with CUDA event.");
+    }
+}
+
+/// Returns the elapsed time between two events in miliseconds
+static double elapsed_time(cudaEvent_t first, cudaEvent_t last) {
+    float ms;
+
+    cudaError_t result = cudaEventElapsedTime(&ms, first, last);
+    if (result != cudaSuccess) {
+        throw std::runtime_error(
+                "Failed to query elapsed time from CUDA events.");
+    }
+
+    return double(ms);
+}
+
+std::vector<double> GpuSampledTimer::paused_before_() const {
+    std::vector<double> paused_ms(recorded, 0);
+
+    // Pauses are enqueued between launches, so each falls between the sample
+    // events recorded before and after it; each pause is read exactly once
+    for (int idx = 0; idx < paused; ++idx) {
+        int event = pause_after[idx] + 1;
+        if (event < recorded) {
+            paused_ms[event] += elapsed_time(pause_events[2 * idx],
+                                             pause_events[2 * idx + 1]);
+        }
+    }
+
+    for (int idx = 1; idx < recorded; ++idx) {
+        paused_ms[idx] += paused_ms[idx - 1];
+    }
+
+    return paused_ms;
+}
+
+double GpuSampledTimer::elapsed_(int first, int last,
+                                 std::vector<double> const& paused_ms) const {
+    return elapsed_time(events[first], events[last]) -
+           (paused_ms[last] - paused_ms[first]);
+}
+
+/// Returns the runtime of each complete batch in miliseconds per iteration
+std::vector<double> GpuSampledTimer::samples() const {
+    std::vector<double> runtimes;
+    std::vector<double> paused_ms = paused_before_();
+
+    for (int idx = 1; idx < recorded; ++idx) {
+        if (event_iterations[idx] - event_iterations[idx - 1] == batch_size) {
+            runtimes.push_back(elapsed_(idx - 1, idx, paused_ms) /
+                               double(batch_size));
+        }
+    }
+
+    return runtimes;
+}
+
+/// Returns the average duration of an iteration in miliseconds
+double GpuSampledTimer::duration() const {
+    if (recorded < 2 || !event_iterations[recorded - 1]) {
+        return 0;
+    }
+    return elapsed_(0, recorded - 1, paused_before_()) /
+           double(event_iterations[recorded - 1]);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 }  // namespace profiler
 }  // namespace cutlass
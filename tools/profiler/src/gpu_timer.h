@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <cuda_runtime.h>
 
 namespace cutlass {
@@ -62,5 +64,85 @@ struct GpuTimer {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Records an event after each batch of iterations to measure the
+/// distribution of runtimes as well as their average
+struct GpuSampledTimer {
+    /// Events recorded at the start and after each batch
+    std::vector<cudaEvent_t> events;
+
+    /// Number of iterations completed when each event was recorded
+    std::vector<int> event_iterations;
+
+    /// Number of events recorded since start()
+    int recorded;
+
+    /// Number of iterations measured by each sample
+    int batch_size;
+
+    /// Number of iterations completed since start()
+    int iterations;
+
+    /// Events bracketing each paused interval, two per pause
+    std::vector<cudaEvent_t> pause_events;
+
+    /// Index of the last event recorded before each pause
+    std::vector<int> pause_after;
+
+    /// Number of pauses since start()
+    int paused;
+
+    //
+    // Methods
+    //
+
+    GpuSampledTimer(int batch_size = 1);
+    ~GpuSampledTimer();
+
+    GpuSampledTimer(GpuSampledTimer const&) = delete;
+    GpuSampledTimer& operator=(GpuSampledTimer const&) = delete;
+
+    /// Records a start event in the stream
+    void start(cudaStream_t stream = nullptr);
+
+    /// Counts a completed iteration, recording an event after each batch
+    void iteration_complete(cudaStream_t stream = nullptr);
+
+    /// Stops measuring work enqueued in the stream until resume()
+    void pause(cudaStream_t stream = nullptr);
+
+    /// Resumes measuring work enqueued in the stream
+    void resume(cudaStream_t stream = nullptr);
+
+    /// Records a stop event in the stream and synchronizes on it
+    void stop_and_wait(cudaStream_t stream = nullptr);
+
+    /// Waits until all recorded events have completed
+    void wait() const;
+
+    /// Returns the runtime of each complete batch in miliseconds per iteration
+    std::vector<double> samples() const;
+
+    /// Returns the average duration of an iteration in miliseconds
+    double duration() const;
+
+private:
+    /// Records the next event
+    void record_(cudaStream_t stream);
+
+    /// Records one of the events bracketing a pause
+    void record_pause_(int index, cudaStream_t stream);
+
+    /// Returns the time paused before each recorded event in miliseconds,
+    /// accumulated from start()
+    std::vector<double> paused_before_() const;
+
+    /// Returns the elapsed time between two recorded events in miliseconds,
+    /// less the time paused in between
+    double elapsed_(int first, int last,
+                    std::vector<double> const& paused_ms) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 }  // namespace profiler
 }  // namespace cutlass
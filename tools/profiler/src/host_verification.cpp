@@ -0,0 +1,237 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Asynchronous verification against host references
+*/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/relatively_equal.h"
+#include "cutlass/subbyte_reference.h"
+
+#include "host_verification.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Compares two blocks element by element
+template <typename Element>
+bool host_block_compare_(void const* ptr_A, void const* ptr_B,
+                         size_t capacity, double epsilon,
+                         double nonzero_floor) {
+    Element const* block_A = reinterpret_cast<Element const*>(ptr_A);
+    Element const* block_B = reinterpret_cast<Element const*>(ptr_B);
+
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        Element a = ReferenceFactory<Element>::get(block_A, idx);
+        Element b = ReferenceFactory<Element>::get(block_B, idx);
+
+        if (epsilon == 0) {
+            if (a != b) {
+                return false;
+            }
+        } else if (!relatively_equal(a, b, static_cast<Element>(epsilon),
+                                     static_cast<Element>(nonzero_floor))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Complex numbers require bitwise equality as on the device
+template <typename Element>
+bool host_block_compare_equal_(void const* ptr_A, void const* ptr_B,
+                               size_t capacity) {
+    Element const* block_A = reinterpret_cast<Element const*>(ptr_A);
+    Element const* block_B = reinterpret_cast<Element const*>(ptr_B);
+
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        if (block_A[idx] != block_B[idx]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool host_block_compare(library::NumericTypeID numeric_type, void const* ptr_A,
+                        void const* ptr_B, size_t capacity, double epsilon,
+                        double nonzero_floor) {
+    switch (numeric_type) {
+        case library::NumericTypeID::kF16:
+            return host_block_compare_<half_t>(ptr_A, ptr_B, capacity, epsilon,
+                                               nonzero_floor);
+        case library::NumericTypeID::kBF16:
+            return host_block_compare_<bfloat16_t>(ptr_A, ptr_B, capacity,
+                                                   epsilon, nonzero_floor);
+        case library::NumericTypeID::kTF32:
+            return host_block_compare_<tfloat32_t>(ptr_A, ptr_B, capacity,
+                                                   epsilon, nonzero_floor);
+        case library::NumericTypeID::kF32:
+            return host_block_compare_<float>(ptr_A, ptr_B, capacity, epsilon,
+                                              nonzero_floor);
+        case library::NumericTypeID::kF64:
+            return host_block_compare_<double>(ptr_A, ptr_B, capacity, epsilon,
+                                               nonzero_floor);
+        case library::NumericTypeID::kS2:
+            return host_block_compare_<int2b_t>(ptr_A, ptr_B, capacity,
+                                                epsilon, nonzero_floor);
+        case library::NumericTypeID::kS4:
+            return host_block_compare_<int4b_t>(ptr_A, ptr_B, capacity,
+                                                epsilon, nonzero_floor);
+        case library::NumericTypeID::kS8:
+            return host_block_compare_<int8_t>(ptr_A, ptr_B, capacity, epsilon,
+                                               nonzero_floor);
+        case library::NumericTypeID::kS16:
+            return host_block_compare_<int16_t>(ptr_A, ptr_B, capacity,
+                                                epsilon, nonzero_floor);
+        case library::NumericTypeID::kS32:
+            return host_block_compare_<int32_t>(ptr_A, ptr_B, capacity,
+                                                epsilon, nonzero_floor);
+        case library::NumericTypeID::kS64:
+            return host_block_compare_<int64_t>(ptr_A, ptr_B, capacity,
+                                                epsilon, nonzero_floor);
+        case library::NumericTypeID::kB1:
+            return host_block_compare_<uint1b_t>(ptr_A, ptr_B, capacity,
+                                                 epsilon, nonzero_floor);
+        case library::NumericTypeID::kU2:
+            return host_block_compare_<uint2b_t>(ptr_A, ptr_B, capacity,
+                                                 epsilon, nonzero_floor);
+        case library::NumericTypeID::kU4:
+            return host_block_compare_<uint4b_t>(ptr_A, ptr_B, capacity,
+                                                 epsilon, nonzero_floor);
+        case library::NumericTypeID::kU8:
+            return host_block_compare_<uint8_t>(ptr_A, ptr_B, capacity,
+                                                epsilon, nonzero_floor);
+        case library::NumericTypeID::kU16:
+            return host_block_compare_<uint16_t>(ptr_A, ptr_B, capacity,
+                                                 epsilon, nonzero_floor);
+        case library::NumericTypeID::kU32:
+            return host_block_compare_<uint32_t>(ptr_A, ptr_B, capacity,
+                                                 epsilon, nonzero_floor);
+        case library::NumericTypeID::kU64:
+            return host_block_compare_<uint64_t>(ptr_A, ptr_B, capacity,
+                                                 epsilon, nonzero_floor);
+        case library::NumericTypeID::kCF16:
+            return host_block_compare_equal_<complex<half_t>>(ptr_A, ptr_B,
+                                                              capacity);
+        case library::NumericTypeID::kCF32:
+            return host_block_compare_equal_<complex<float>>(ptr_A, ptr_B,
+                                                             capacity);
+        case library::NumericTypeID::kCF64:
+            return host_block_compare_equal_<complex<double>>(ptr_A, ptr_B,
+                                                              capacity);
+        default:
+            throw std::runtime_error(
+                    "Unsupported numeric type for host comparison");
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+HostVerificationPool::HostVerificationPool(int threads, size_t max_queued)
+        : max_queued_(max_queued ? max_queued : size_t(2 * threads)),
+          stopping_(false) {
+    for (int idx = 0; idx < std::max(threads, 1); ++idx) {
+        workers_.emplace_back(&HostVerificationPool::run_, this);
+    }
+}
+
+HostVerificationPool::~HostVerificationPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    queued_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+HostVerificationPool::Outcome HostVerificationPool::submit(Task task) {
+    std::packaged_task<Disposition()> check([task]() {
+        try {
+            return task();
+        } catch (...) {
+            return Disposition::kFailed;
+        }
+    });
+
+    Outcome outcome = check.get_future().share();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        dequeued_.wait(lock, [this]() { return queue_.size() < max_queued_; });
+        queue_.push_back(std::move(check));
+    }
+    queued_.notify_one();
+
+    return outcome;
+}
+
+void HostVerificationPool::run_() {
+    while (true) {
+        std::packaged_task<Disposition()> check;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queued_.wait(lock,
+                         [this]() { return stopping_ || !queue_.empty(); });
+
+            // Pending checks are completed before stopping
+            if (queue_.empty()) {
+                return;
+            }
+
+            check = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        dequeued_.notify_one();
+
+        check();
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
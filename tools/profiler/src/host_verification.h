@@ -0,0 +1,114 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Asynchronous verification against host references
+
+  Host references run orders of magnitude slower than the kernels they verify.
+  When enabled with --verification-threads, computed outputs and inputs are
+  copied to host buffers, and the reference and comparison run on a pool of
+  CPU threads while the profiler proceeds with the next operation. Outcomes
+  are merged into their performance results before these are reported.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cutlass/library/library.h"
+
+#include "enumerated_types.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns true if two blocks in host memory hold the same values. If epsilon
+/// is zero, values must be equal. Otherwise, they must be relatively equal as
+/// in DeviceAllocation::block_compare_relatively_equal().
+bool host_block_compare(library::NumericTypeID numeric_type, void const* ptr_A,
+                        void const* ptr_B, size_t capacity, double epsilon,
+                        double nonzero_floor);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Pool of CPU threads running host reference checks
+class HostVerificationPool {
+public:
+    /// Runs a host reference check and returns its outcome
+    using Task = std::function<Disposition()>;
+
+    /// Outcome of a submitted check
+    using Outcome = std::shared_future<Disposition>;
+
+    /// Starts the given number of threads. At most max_queued checks wait for
+    /// a thread; submit() blocks beyond that to bound the host memory held by
+    /// pending checks. If max_queued is zero, twice the number of threads is
+    /// used.
+    explicit HostVerificationPool(int threads, size_t max_queued = 0);
+
+    /// Completes all submitted checks and joins the threads
+    ~HostVerificationPool();
+
+    HostVerificationPool(HostVerificationPool const&) = delete;
+    HostVerificationPool& operator=(HostVerificationPool const&) = delete;
+
+    /// Queues a check. Exceptions thrown by the task yield
+    /// Disposition::kFailed.
+    Outcome submit(Task task);
+
+    /// Number of threads
+    int threads() const { return int(workers_.size()); }
+
+private:
+    /// Body of each worker thread
+    void run_();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::packaged_task<Disposition()>> queue_;
+    size_t max_queued_;
+    bool stopping_;
+
+    std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable dequeued_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,356 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Minimal JSON document model used by the profiler's machine readable
+   reports
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "json.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Recursive descent parser over an in-memory document
+class JsonParser {
+private:
+    std::string const& text_;
+    size_t pos_;
+
+public:
+    explicit JsonParser(std::string const& text) : text_(text), pos_(0) {}
+
+    JsonValue parse_document() {
+        JsonValue value = parse_value_();
+        skip_whitespace_();
+        if (pos_ != text_.size()) {
+            error_("unexpected trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void error_(char const* message) const {
+        std::stringstream ss;
+        ss << "JSON parse error at offset " << pos_ << ": " << message;
+        throw std::runtime_error(ss.str());
+    }
+
+    void skip_whitespace_() {
+        while (pos_ < text_.size() &&
+               (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                text_[pos_] == '\n' || text_[pos_] == '\r')) {
+            ++pos_;
+        }
+    }
+
+    char peek_() {
+        skip_whitespace_();
+        if (pos_ == text_.size()) {
+            error_("unexpected end of document");
+        }
+        return text_[pos_];
+    }
+
+    void expect_(char c) {
+        if (!consume_(c)) {
+            std::string message = std::string("expected '") + c + "'";
+            error_(message.c_str());
+        }
+    }
+
+    bool consume_(char c) {
+        if (peek_() != c) {
+            return false;
+        }
+        ++pos_;
+        return true;
+    }
+
+    void expect_literal_(char const* literal) {
+        for (char const* c = literal; *c; ++c, ++pos_) {
+            if (pos_ == text_.size() || text_[pos_] != *c) {
+                error_("invalid literal");
+            }
+        }
+    }
+
+    JsonValue parse_value_() {
+        JsonValue value;
+
+        char c = peek_();
+        if (c == '{') {
+            value.kind = JsonValue::Kind::kObject;
+            ++pos_;
+            if (peek_() == '}') {
+                ++pos_;
+                return value;
+            }
+            do {
+                if (peek_() != '"') {
+                    error_("expected member name");
+                }
+                std::string key = parse_string_();
+                expect_(':');
+                value.object.emplace_back(key, parse_value_());
+            } while (consume_(','));
+            expect_('}');
+        } else if (c == '[') {
+            value.kind = JsonValue::Kind::kArray;
+            ++pos_;
+            if (peek_() == ']') {
+                ++pos_;
+                return value;
+            }
+            do {
+                value.array.push_back(parse_value_());
+            } while (consume_(','));
+            expect_(']');
+        } else if (c == '"') {
+            value.kind = JsonValue::Kind::kString;
+            value.string = parse_string_();
+        } else if (c == 't') {
+            expect_literal_("true");
+            value.kind = JsonValue::Kind::kBool;
+            value.boolean = true;
+        } else if (c == 'f') {
+            expect_literal_("false");
+            value.kind = JsonValue::Kind::kBool;
+        } else if (c == 'n') {
+            expect_literal_("null");
+        } else {
+            char const* begin = text_.c_str() + pos_;
+            char* end = nullptr;
+            value.kind = JsonValue::Kind::kNumber;
+            value.number = std::strtod(begin, &end);
+            if (end == begin) {
+                error_("unexpected character");
+            }
+            pos_ += size_t(end - begin);
+        }
+
+        return value;
+    }
+
+    std::string parse_string_() {
+        expect_('"');
+
+        std::string result;
+        while (true) {
+            if (pos_ == text_.size()) {
+                error_("unterminated string");
+            }
+
+            char c = text_[pos_++];
+            if (c == '"') {
+                break;
+            }
+            if (c != '\\') {
+                result.push_back(c);
+                continue;
+            }
+
+            if (pos_ == text_.size()) {
+                error_("unterminated escape sequence");
+            }
+
+            c = text_[pos_++];
+            switch (c) {
+                case 'b': result.push_back('\b'); break;
+                case 'f': result.push_back('\f'); break;
+                case 'n': result.push_back('\n'); break;
+                case 'r': result.push_back('\r'); break;
+                case 't': result.push_back('\t'); break;
+                case 'u': {
+                    if (pos_ + 4 > text_.size()) {
+                        error_("truncated unicode escape");
+                    }
+                    unsigned code = static_cast<unsigned>(std::strtoul(
+                            text_.substr(pos_, 4).c_str(), nullptr, 16));
+                    pos_ += 4;
+
+                    // encode as UTF-8; surrogate pairs are not combined
+                    if (code < 0x80) {
+                        result.push_back(char(code));
+                    } else if (code < 0x800) {
+                        result.push_back(char(0xc0 | (code >> 6)));
+                        result.push_back(char(0x80 | (code & 0x3f)));
+                    } else {
+                        result.push_back(char(0xe0 | (code >> 12)));
+                        result.push_back(char(0x80 | ((code >> 6) & 0x3f)));
+                        result.push_back(char(0x80 | (code & 0x3f)));
+                    }
+                } break;
+                default:
+                    result.push_back(c);
+                    break;
+            }
+        }
+
+        return result;
+    }
+};
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the member of an object or nullptr if it does not exist
+JsonValue const* JsonValue::find(std::string const& key) const {
+    for (auto const& member : object) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+/// Returns a member as a string or `default_value` if it is not a string
+std::string JsonValue::get_string(std::string const& key,
+                                  std::string const& default_value) const {
+    JsonValue const* value = find(key);
+    if (value && value->kind == Kind::kString) {
+        return value->string;
+    }
+    return default_value;
+}
+
+/// Returns a member as a number or `default_value` if it is not a number
+double JsonValue::get_number(std::string const& key,
+                             double default_value) const {
+    JsonValue const* value = find(key);
+    if (value && value->kind == Kind::kNumber) {
+        return value->number;
+    }
+    return default_value;
+}
+
+/// Parses a JSON document. Throws std::runtime_error on malformed input.
+JsonValue parse_json(std::istream& in) {
+    std::string text((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+
+    return JsonParser(text).parse_document();
+}
+
+/// Quotes and escapes a string for JSON output
+std::string json_string(std::string const& text) {
+    std::stringstream ss;
+    ss << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            ss << '\\' << c;
+        } else if (c == '\n') {
+            ss << "\\n";
+        } else if (c == '\t') {
+            ss << "\\t";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            ss << ' ';
+        } else {
+            ss << c;
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+/// Writes a JSON document with two spaces of indentation per level
+std::ostream& print_json(std::ostream& out, JsonValue const& value,
+                         int indent) {
+    std::string padding(2 * (indent + 1), ' ');
+
+    switch (value.kind) {
+        case JsonValue::Kind::kNull:
+            out << "null";
+            break;
+
+        case JsonValue::Kind::kBool:
+            out << (value.boolean ? "true" : "false");
+            break;
+
+        case JsonValue::Kind::kNumber:
+            // Byte and flop counts exceed the precision of the reports'
+            // floating-point output
+            if (std::floor(value.number) == value.number &&
+                std::fabs(value.number) < 9.0e15) {
+                out << static_cast<long long>(value.number);
+            } else {
+                out << std::setprecision(10) << value.number;
+            }
+            break;
+
+        case JsonValue::Kind::kString:
+            out << json_string(value.string);
+            break;
+
+        case JsonValue::Kind::kArray:
+            out << "[";
+            for (size_t idx = 0; idx < value.array.size(); ++idx) {
+                out << (idx ? ",\n" : "\n") << padding;
+                print_json(out, value.array[idx], indent + 1);
+            }
+            if (!value.array.empty()) {
+                out << "\n" << std::string(2 * indent, ' ');
+            }
+            out << "]";
+            break;
+
+        case JsonValue::Kind::kObject:
+            out << "{";
+            for (size_t idx = 0; idx < value.object.size(); ++idx) {
+                out << (idx ? ",\n" : "\n") << padding
+                    << json_string(value.object[idx].first) << ": ";
+                print_json(out, value.object[idx].second, indent + 1);
+            }
+            if (!value.object.empty()) {
+                out << "\n" << std::string(2 * indent, ' ');
+            }
+            out << "}";
+            break;
+    }
+
+    return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,93 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Minimal JSON document model used by the profiler's machine readable
+   reports
+*/
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Parsed JSON value
+struct JsonValue {
+    enum class Kind { kNull, kBool, kNumber, kString, kArray, kObject };
+
+    Kind kind;
+
+    bool boolean;
+
+    double number;
+
+    std::string string;
+
+    std::vector<JsonValue> array;
+
+    /// Object members in document order
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    //
+    // Methods
+    //
+
+    JsonValue() : kind(Kind::kNull), boolean(false), number(0) {}
+
+    /// Returns the member of an object or nullptr if it does not exist
+    JsonValue const* find(std::string const& key) const;
+
+    /// Returns a member as a string or `default_value` if it is not a string
+    std::string get_string(std::string const& key,
+                           std::string const& default_value = "") const;
+
+    /// Returns a member as a number or `default_value` if it is not a number
+    double get_number(std::string const& key, double default_value = 0) const;
+};
+
+/// Parses a JSON document. Throws std::runtime_error on malformed input.
+JsonValue parse_json(std::istream& in);
+
+/// Quotes and escapes a string for JSON output
+std::string json_string(std::string const& text);
+
+/// Writes a JSON document with two spaces of indentation per level
+std::ostream& print_json(std::ostream& out, JsonValue const& value,
+                         int indent = 0);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
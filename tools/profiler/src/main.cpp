@@ -33,11 +33,24 @@
 #include "options.h"
 
 #include "cutlass_profiler.h"
+#include "performance_comparison.h"
+#include "report_merge.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char const* arg[]) {
     cutlass::CommandLine cmdline(argc, arg);
+
+    // Comparing and merging reports run on the host before any device is
+    // queried
+    if (cutlass::profiler::PerformanceComparison::enabled(cmdline)) {
+        return cutlass::profiler::PerformanceComparison(cmdline)();
+    }
+
+    if (cutlass::profiler::ReportMerge::enabled(cmdline)) {
+        return cutlass::profiler::ReportMerge(cmdline)();
+    }
+
     cutlass::profiler::Options options(cmdline);
 
     cutlass::profiler::CutlassProfiler profiler(options);
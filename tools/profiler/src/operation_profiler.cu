@@ -29,10 +29,12 @@
 */
 
 #include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <iomanip>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <sstream>
 
 #ifdef __unix__
@@ -46,6 +48,8 @@
 #include "options.h"
 #include "operation_profiler.h"
 #include "gpu_timer.h"
+#include "shard.h"
+#include "sweep.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -55,14 +59,19 @@ namespace profiler {
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 OperationProfiler::OperationProfiler()
-        : kind_(library::OperationKind::kInvalid) {}
+        : kind_(library::OperationKind::kInvalid),
+          sharded_(false),
+          problem_idx_(0) {}
 
 /// Ctor
 OperationProfiler::OperationProfiler(
         Options const& options, library::OperationKind kind,
         ArgumentDescriptionVector const& arguments,
         ProviderVector const& verification_providers)
-        : kind_(kind), arguments_(arguments) {
+        : kind_(kind),
+          arguments_(arguments),
+          sharded_(false),
+          problem_idx_(0) {
     ArgumentDescriptionVector tile_description_arguments{
             {ArgumentTypeID::kEnumerated,
              {"op_class", "opcode-class"},
@@ -268,61 +277,298 @@ int OperationProfiler::profile_all(Options const& options,
     // 1. Construct performance report
     PerformanceReport report(options, problem_space.argument_names(), kind_);
 
-    // 2. For each problem in problem space
-    ProblemSpace::Iterator problem_it = problem_space.begin();
-    ProblemSpace::Iterator problem_end = problem_space.end();
+    // 2. Problems completed by an interrupted sweep are skipped
+    SweepCheckpoint checkpoint(options.sweep.checkpoint_path,
+                               library::to_string(kind_));
+
+    if (checkpoint.resumed() && options.report.verbose) {
+        std::cout << "Resuming from checkpoint '"
+                  << options.sweep.checkpoint_path << "': "
+                  << checkpoint.resumed() << " completed problems of kind "
+                  << library::to_string(kind_) << " are skipped." << std::endl;
+    }
 
     bool continue_profiling = true, internal_error = false;
 
-    // For each problem in problem space
-    for (; continue_profiling && problem_it != problem_end; ++problem_it) {
-        ProblemSpace::Problem problem = problem_it.at();
+    // 3. Points of the problem space in sweep order. Stops when the visitor
+    // returns false.
+    std::vector<std::vector<size_t>> points;
+    if (options.sweep.mode != SamplingMode::kExhaustive) {
+        points = sample_problem_space(problem_space.extents(),
+                                      options.sweep.mode, options.sweep.samples,
+                                      options.sweep.seed);
+    }
 
-        report.next_problem();
+    auto visit_problems =
+            [&](std::function<bool(ProblemSpace::Problem const&)> visit) {
+                if (options.sweep.mode == SamplingMode::kExhaustive) {
+                    ProblemSpace::Iterator problem_it = problem_space.begin();
+                    ProblemSpace::Iterator problem_end = problem_space.end();
 
-        // For each operation in manifest
-        for (auto const& operation_ptr : manifest) {
-            library::Operation const* operation = operation_ptr.get();
-
-            auto min_cc = operation->description()
-                                  .tile_description.minimum_compute_capability;
-            auto max_cc = operation->description()
-                                  .tile_description.maximum_compute_capability;
-
-            // Execute compatible cutlass operations if they satisfy the current
-            // device's compute capability
-            if (operation->description().kind == kind_ &&
-                operation->description().provider ==
-                        library::Provider::kCUTLASS &&
-                options.device.compute_capability() >= min_cc &&
-                options.device.compute_capability() <= max_cc) {
-                std::string operation_name(operation->description().name);
-
-                // Filter kernels by name
-                bool filtered_by_name = options.operation_names.empty();
-                if (!filtered_by_name) {
-                    for (auto const& op_name : options.operation_names) {
-                        if (find_string_matches_(op_name, operation_name)) {
-                            filtered_by_name = true;
+                    for (; problem_it != problem_end; ++problem_it) {
+                        if (!visit(problem_it.at())) {
                             break;
                         }
                     }
-                }
-
-                for (auto const& op_name : options.excluded_operation_names) {
-                    if (find_string_matches_(op_name, operation_name)) {
-                        filtered_by_name = false;
-                        break;
+                } else {
+                    for (auto const& point : points) {
+                        if (!visit(problem_space.at(point))) {
+                            break;
+                        }
                     }
                 }
+            };
+
+    // 4. A sharded sweep enumerates every work item to assign them the same
+    // way in each process, then profiles its own
+    shard_work_.clear();
+    sharded_ = options.sweep.shard.enabled();
+
+    if (sharded_) {
+        std::vector<std::pair<size_t, library::Operation const*>> items;
+        std::vector<double> costs;
+
+        int launches = options.profiling.warmup_iterations +
+                       options.profiling.iterations +
+                       (options.verification.enabled ? 1 : 0);
+
+        size_t problem_idx = 0;
 
-                if (!filtered_by_name || !satisfies(operation->description(),
-                                                    problem_space, problem)) {
+        visit_problems([&](ProblemSpace::Problem const& problem) {
+            for (auto const& operation_ptr : manifest) {
+                library::Operation const* operation = operation_ptr.get();
+
+                if (!selected_(options, operation, problem_space, problem) ||
+                    this->initialize_configuration(
+                            options, report, device_context, operation,
+                            problem_space, problem) != Status::kSuccess) {
                     continue;
                 }
 
-                // A. Initialize configuration
-                Status status = this->initialize_configuration(
+                items.push_back(std::make_pair(problem_idx, operation));
+                costs.push_back(planned_cost(model_result_.flops,
+                                             model_result_.bytes, launches));
+            }
+
+            ++problem_idx;
+            return true;
+        });
+
+        std::vector<int> shards =
+                assign_shards(costs, options.sweep.shard.count);
+
+        double total_cost = 0, shard_cost = 0;
+        for (size_t idx = 0; idx < items.size(); ++idx) {
+            total_cost += costs[idx];
+            if (shards[idx] == options.sweep.shard.index) {
+                shard_work_.insert(items[idx]);
+                shard_cost += costs[idx];
+            }
+        }
+
+        if (options.report.verbose) {
+            std::cout << "Shard " << options.sweep.shard.index << "/"
+                      << options.sweep.shard.count << ": " << shard_work_.size()
+                      << " of " << items.size() << " work items of kind "
+                      << library::to_string(kind_) << ", "
+                      << std::fixed << std::setprecision(1)
+                      << (total_cost > 0 ? 100 * shard_cost / total_cost : 0)
+                      << "% of the estimated cost." << std::endl;
+            std::cout.unsetf(std::ios::floatfield);
+        }
+    }
+
+    // 5. For each problem in problem space
+    problem_idx_ = 0;
+
+    visit_problems([&](ProblemSpace::Problem const& problem) {
+        report.next_problem();
+
+        std::string key;
+        if (checkpoint.enabled()) {
+            key = problem_key(problem);
+        }
+
+        if (!checkpoint.enabled() || !checkpoint.completed(key)) {
+            bool problem_error = false;
+            continue_profiling =
+                    profile_problem_(options, manifest, device_context, report,
+                                     problem_space, problem, problem_error);
+
+            internal_error = internal_error || problem_error;
+
+            // Problems interrupted by an error are repeated when resuming,
+            // and dry runs complete nothing
+            if (continue_profiling && !problem_error &&
+                options.execution_mode != ExecutionMode::kDryRun) {
+                checkpoint.complete(key);
+            }
+        }
+
+        ++problem_idx_;
+        return continue_profiling;
+    });
+
+    sharded_ = false;
+    shard_work_.clear();
+
+    return internal_error ? 1 : 0;
+}
+
+/// Entry point to profile the records of a workload trace matching this
+/// operation kind
+int OperationProfiler::profile_workload(Options const& options,
+                                        library::Manifest const& manifest,
+                                        DeviceContext& device_context,
+                                        WorkloadSummary& summary) {
+    // Column names are defined by the schema and shared by all records
+    PerformanceReport report(
+            options, ProblemSpace(arguments_, options.cmdline).argument_names(),
+            kind_);
+
+    bool continue_profiling = true, internal_error = false;
+
+    WorkloadRecordVector const& records = summary.records();
+
+    for (size_t record_idx = 0;
+         continue_profiling && record_idx < records.size(); ++record_idx) {
+        if (records[record_idx].op_kind != kind_) {
+            continue;
+        }
+
+        ProblemSpace problem_space(
+                arguments_, records[record_idx].command_line(options.cmdline));
+
+        ProblemSpace::Iterator problem_it = problem_space.begin();
+        ProblemSpace::Iterator problem_end = problem_space.end();
+
+        for (; continue_profiling && problem_it != problem_end; ++problem_it) {
+            ProblemSpace::Problem problem = problem_it.at();
+
+            report.next_problem();
+
+            PerformanceResultVector results;
+            continue_profiling = profile_problem_(
+                    options, manifest, device_context, report, problem_space,
+                    problem, internal_error, &results);
+
+            summary.append_results(record_idx, results);
+        }
+    }
+
+    return internal_error ? 1 : 0;
+}
+
+/// Returns true if an operation is profiled for a problem on the current
+/// device given the kernel filters of the command line
+bool OperationProfiler::selected_(Options const& options,
+                                  library::Operation const* operation,
+                                  ProblemSpace const& problem_space,
+                                  ProblemSpace::Problem const& problem) {
+    library::OperationDescription const& desc = operation->description();
+
+    if (desc.kind != kind_ || desc.provider != library::Provider::kCUTLASS ||
+        options.device.compute_capability() <
+                desc.tile_description.minimum_compute_capability ||
+        options.device.compute_capability() >
+                desc.tile_description.maximum_compute_capability) {
+        return false;
+    }
+
+    std::string operation_name(desc.name);
+
+    // Filter kernels by name
+    bool filtered_by_name = options.operation_names.empty();
+    if (!filtered_by_name) {
+        for (auto const& op_name : options.operation_names) {
+            if (find_string_matches_(op_name, operation_name)) {
+                filtered_by_name = true;
+                break;
+            }
+        }
+    }
+
+    for (auto const& op_name : options.excluded_operation_names) {
+        if (find_string_matches_(op_name, operation_name)) {
+            filtered_by_name = false;
+            break;
+        }
+    }
+
+    return filtered_by_name && satisfies(desc, problem_space, problem);
+}
+
+/// Describes the integer arguments of a problem in traced events (e.g.
+/// "m=128 n=128 k=64")
+static std::string trace_problem_detail(ProblemSpace::Problem const& problem) {
+    std::stringstream ss;
+    char const* separator = "";
+
+    for (auto const& value : problem) {
+        if (!value || !value->not_null ||
+            value->argument->description->type != ArgumentTypeID::kInteger) {
+            continue;
+        }
+        ss << separator << value->argument->qualified_name() << "=";
+        value->print(ss);
+        separator = " ";
+    }
+
+    return ss.str();
+}
+
+/// Verifies and profiles every operation in the manifest satisfying one
+/// problem. Returns false if profiling should stop.
+bool OperationProfiler::profile_problem_(
+        Options const& options, library::Manifest const& manifest,
+        DeviceContext& device_context, PerformanceReport& report,
+        ProblemSpace const& problem_space, ProblemSpace::Problem const& problem,
+        bool& internal_error, PerformanceResultVector* collected_results) {
+    bool continue_profiling = true;
+
+    vendor_profiled_arguments_.clear();
+
+    std::string trace_detail;
+    if (library::trace_enabled()) {
+        trace_detail = trace_problem_detail(problem);
+    }
+
+    // For each operation in manifest
+    for (auto const& operation_ptr : manifest) {
+        library::Operation const* operation = operation_ptr.get();
+
+        // Execute compatible cutlass operations if they satisfy the current
+        // device's compute capability
+        if (selected_(options, operation, problem_space, problem)) {
+            // Sharded sweeps skip the work items of other processes
+            if (sharded_ && !shard_work_.count(
+                                    std::make_pair(problem_idx_, operation))) {
+                continue;
+            }
+
+            char const* operation_name = operation->description().name;
+
+            // A. Initialize configuration
+            library::TraceScope initialize_scope(
+                    library::TraceEventKind::kInitialize, operation_name);
+            initialize_scope.set_detail("%s", trace_detail.c_str());
+
+            Status status = this->initialize_configuration(
+                    options, report, device_context, operation,
+                    problem_space, problem);
+
+            if (status == Status::kErrorInternal) {
+                // Stop profiling if there was an internal error
+                internal_error = true;
+                break;
+            } else if (status != Status::kSuccess) {
+                // If the workspace could not be initialized for any other
+                // reason, continue to the next operation.
+                continue;
+            }
+
+            if (continue_profiling) {
+                status = this->initialize_workspace(
                         options, report, device_context, operation,
                         problem_space, problem);
 
@@ -331,82 +577,180 @@ int OperationProfiler::profile_all(Options const& options,
                     internal_error = true;
                     break;
                 } else if (status != Status::kSuccess) {
-                    // If the workspace could not be initialized for any other
-                    // reason, continue to the next operation.
+                    // If the workspace could not be initialized for any
+                    // other reason, continue to the next operation.
                     continue;
                 }
+            }
 
-                if (continue_profiling) {
-                    status = this->initialize_workspace(
-                            options, report, device_context, operation,
-                            problem_space, problem);
-
-                    if (status == Status::kErrorInternal) {
-                        // Stop profiling if there was an internal error
-                        internal_error = true;
-                        break;
-                    } else if (status != Status::kSuccess) {
-                        // If the workspace could not be initialized for any
-                        // other reason, continue to the next operation.
-                        continue;
-                    }
-                }
+            initialize_scope.finish();
 
-                //
-                // Profile CUTLASS if it is enabled
-                //
+            //
+            // Profile CUTLASS if it is enabled
+            //
 
-                // B. Verify CUTLASS
+            // B. Verify CUTLASS
 
-                if (continue_profiling &&
-                    options.profiling.provider_enabled(
-                            library::Provider::kCUTLASS)) {
-                    continue_profiling = this->verify_cutlass(
-                            options, report, device_context, operation,
-                            problem_space, problem);
-                }
+            if (continue_profiling &&
+                options.profiling.provider_enabled(
+                        library::Provider::kCUTLASS)) {
+                library::TraceScope verify_scope(
+                        library::TraceEventKind::kVerify, operation_name);
+                verify_scope.set_detail("%s", trace_detail.c_str());
 
-                if (options.execution_mode == ExecutionMode::kDryRun) {
-                    report.append_results(results_);
-                    results_.clear();
-                    continue;
-                }
+                continue_profiling = this->verify_cutlass(
+                        options, report, device_context, operation,
+                        problem_space, problem);
+            }
 
-                //
-                // C. Optionally save workspace
-                //
+            if (options.execution_mode == ExecutionMode::kDryRun) {
+                report.append_results(results_);
+                results_.clear();
+                continue;
+            }
 
-                if (options.verification.save_workspace ==
-                    SaveWorkspace::kAlways) {
-                    save_workspace(device_context, options,
-                                   operation->description(),
-                                   library::Provider::kCUTLASS);
-                }
+            //
+            // C. Optionally save workspace
+            //
 
-                //
-                // D. Profile
-                //
+            if (options.verification.save_workspace ==
+                SaveWorkspace::kAlways) {
+                save_workspace(device_context, options,
+                               operation->description(),
+                               library::Provider::kCUTLASS);
+            }
 
-                if (continue_profiling && options.profiling.enabled) {
-                    continue_profiling =
-                            this->profile(options, report, device_context,
-                                          operation, problem_space, problem);
-                }
+            //
+            // D. Profile
+            //
 
-                // Clear named allocations
-                device_context.free();
+            if (continue_profiling && options.profiling.enabled) {
+                // Spans the warmup and timed launches of every provider
+                library::TraceScope launch_scope(
+                        library::TraceEventKind::kLaunch, operation_name);
+                launch_scope.set_detail("%s", trace_detail.c_str());
 
-                report.append_results(results_);
-                results_.clear();
+                continue_profiling =
+                        this->profile(options, report, device_context,
+                                      operation, problem_space, problem);
             }
 
-            if (!continue_profiling) {
-                break;
+            // Clear named allocations
+            device_context.free();
+
+            report_results_(report, false, collected_results);
+        }
+
+        if (!continue_profiling) {
+            break;
+        }
+    }
+
+    // Results are numbered by problem, so every check of this problem
+    // completes before the next one begins
+    report_results_(report, true, collected_results);
+
+    return continue_profiling;
+}
+
+/// Copies a device allocation to a host buffer
+std::shared_ptr<std::vector<uint8_t>> OperationProfiler::copy_to_host_(
+        DeviceAllocation& allocation) {
+    auto buffer = std::make_shared<std::vector<uint8_t>>(allocation.bytes());
+    allocation.copy_to_host(buffer->data());
+    return buffer;
+}
+
+/// Hands a host reference check of the most recent result to the
+/// verification threads
+void OperationProfiler::verify_on_host_async_(Options const& options,
+                                              library::Provider provider,
+                                              HostVerificationPool::Task task) {
+    if (!host_verification_pool_) {
+        host_verification_pool_.reset(
+                new HostVerificationPool(options.verification.threads));
+    }
+
+    PendingVerification verification;
+    verification.result_index = results_.size() - 1;
+    verification.provider = provider;
+    verification.outcome = host_verification_pool_->submit(task);
+
+    pending_verifications_.push_back(verification);
+}
+
+/// Moves results to the report once their host reference checks complete
+void OperationProfiler::report_results_(
+        PerformanceReport& report, bool wait,
+        PerformanceResultVector* collected_results) {
+    for (size_t idx = 0; idx < results_.size(); ++idx) {
+        DeferredResult deferred;
+        deferred.result = results_[idx];
+
+        for (auto const& verification : pending_verifications_) {
+            if (verification.result_index == idx) {
+                deferred.verifications.push_back(verification);
             }
         }
+
+        deferred_results_.push_back(deferred);
     }
 
-    return internal_error ? 1 : 0;
+    results_.clear();
+    pending_verifications_.clear();
+
+    PerformanceResultVector ready_results;
+
+    while (!deferred_results_.empty()) {
+        DeferredResult& deferred = deferred_results_.front();
+
+        bool ready = true;
+        for (auto const& verification : deferred.verifications) {
+            if (!wait && verification.outcome.wait_for(std::chrono::seconds(
+                                 0)) != std::future_status::ready) {
+                ready = false;
+            }
+        }
+
+        if (!ready) {
+            break;
+        }
+
+        PerformanceResult& result = deferred.result;
+
+        // Merges outcomes as verify_cutlass() does: the worst failure among
+        // all providers, otherwise passed if any provider passed
+        for (auto const& verification : deferred.verifications) {
+            Disposition outcome = verification.outcome.get();
+
+            result.verification_map[verification.provider] = outcome;
+
+            if (outcome == Disposition::kFailed ||
+                outcome == Disposition::kIncorrect) {
+                if (result.disposition != Disposition::kFailed &&
+                    result.disposition != Disposition::kIncorrect) {
+                    result.disposition = outcome;
+                }
+            } else if (outcome == Disposition::kPassed &&
+                       result.disposition == Disposition::kNotVerified) {
+                result.disposition = Disposition::kPassed;
+            }
+        }
+
+        ready_results.push_back(result);
+        deferred_results_.pop_front();
+    }
+
+    if (ready_results.empty()) {
+        return;
+    }
+
+    if (collected_results) {
+        collected_results->insert(collected_results->end(),
+                                  ready_results.begin(), ready_results.end());
+    }
+
+    report.append_results(ready_results);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -487,14 +831,108 @@ void OperationProfiler::save_workspace(
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Returns true once enough iterations were profiled
+bool OperationProfiler::profiling_complete_(Options const& options,
+                                            GpuSampledTimer const& timer) {
+    int iterations = timer.iterations;
+
+    if (iterations < options.profiling.iterations) {
+        return false;
+    }
+
+    if (!options.profiling.adaptive() ||
+        iterations >= options.profiling.max_iterations) {
+        return true;
+    }
+
+    // test the confidence interval after each further round of iterations
+    if (iterations % std::max(options.profiling.iterations, 1)) {
+        return false;
+    }
+
+    timer.wait();
+
+    RuntimeStatistics statistics = compute_runtime_statistics(
+            timer.samples(), options.profiling.confidence);
+
+    return statistics.relative_ci_width() <= options.profiling.target_ci_width;
+}
+
+/// Returns true the first time a vendor library should be profiled for the
+/// arguments of a result within the current problem
+bool OperationProfiler::vendor_profiling_pending_(
+        PerformanceResult const& result) {
+    std::string key;
+    for (auto const& arg : result.arguments) {
+        key += arg.first + "=" + arg.second + ";";
+    }
+
+    return vendor_profiled_arguments_.insert(key).second;
+}
+
+/// Returns the number of copies of a problem occupying the given bytes which
+/// timed launches rotate through
+int OperationProfiler::workspace_problem_count_(Options const& options,
+                                                int64_t bytes) {
+    if (options.profiling.workspace_count) {
+        return options.profiling.workspace_count;
+    }
+
+    if (options.profiling.cache_mode != CacheMode::kRotating) {
+        return 1;
+    }
+
+    // Rotate through enough copies to exceed the L2 three times over
+    int64_t rotated_bytes = 3 * int64_t(options.device.properties.l2CacheSize);
+    if (bytes > 0 && bytes < rotated_bytes) {
+        return 1 + int(rotated_bytes / bytes);
+    }
+
+    return 1;
+}
+
+/// In cold cache mode, evicts the L2 before a timed launch without measuring
+/// the eviction
+void OperationProfiler::flush_cache_(Options const& options,
+                                     GpuSampledTimer& timer) {
+    if (options.profiling.cache_mode != CacheMode::kCold) {
+        return;
+    }
+
+    // Writing twice the capacity of the L2 evicts every line of the operands
+    size_t bytes = 2 * size_t(options.device.properties.l2CacheSize);
+    if (l2_flush_buffer_.bytes() < bytes) {
+        l2_flush_buffer_.reset(library::NumericTypeID::kU8, bytes);
+    }
+
+    timer.pause();
+
+    if (cudaMemsetAsync(l2_flush_buffer_.data(), 0, bytes) != cudaSuccess) {
+        throw std::runtime_error("Failed to flush the L2 cache.");
+    }
+
+    timer.resume();
+}
+
+/// Sets the runtime of a result and its distribution
+void OperationProfiler::set_runtime_(PerformanceResult& result,
+                                     Options const& options,
+                                     GpuSampledTimer const& timer) {
+    result.runtime = timer.duration();
+    result.runtime_statistics = compute_runtime_statistics(
+            timer.samples(), options.profiling.confidence);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Method to profile a CUTLASS Operation
-Status OperationProfiler::profile_cutlass_(double& runtime,
+Status OperationProfiler::profile_cutlass_(PerformanceResult& result,
                                            Options const& options,
                                            library::Operation const* operation,
                                            void* arguments,
                                            void* host_workspace,
                                            void* device_workspace) {
-    GpuTimer timer;
+    GpuSampledTimer timer(options.profiling.iterations_per_sample);
 
     //
     // Optional sleep to limit power consumption and thermals
@@ -527,15 +965,16 @@ Status OperationProfiler::profile_cutlass_(double& runtime,
     // Profiling loop
     //
 
-    int Iterations = options.profiling.iterations;
+    while (!profiling_complete_(options, timer)) {
+        flush_cache_(options, timer);
 
-    int iteration = 0;
-    for (; iteration < Iterations; ++iteration) {
         status = operation->run(arguments, host_workspace, device_workspace);
 
         if (status != Status::kSuccess) {
             return status;
         }
+
+        timer.iteration_complete();
     }
 
     //
@@ -548,7 +987,7 @@ Status OperationProfiler::profile_cutlass_(double& runtime,
     // Update performance result
     //
 
-    runtime = timer.duration(iteration);
+    set_runtime_(result, options, timer);
 
     return status;
 }
@@ -30,22 +30,28 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 #include <string>
 #include <memory>
+#include <set>
 #include <unordered_map>
 
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
 #include "cutlass/library/util.h"
 #include "cutlass/library/manifest.h"
+#include "cutlass/library/trace.h"
 
 // Profiler includes
 #include "options.h"
 #include "device_context.h"
+#include "gpu_timer.h"
+#include "host_verification.h"
 #include "performance_result.h"
 #include "performance_report.h"
 #include "problem_space.h"
+#include "workload.h"
 #include "debug.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -82,6 +88,48 @@ protected:
     /// Performance result vector constructed by profiling the operation
     PerformanceResultVector results_;
 
+    /// Arguments of the results profiled with vendor libraries during the
+    /// current problem. A vendor library is timed once per distinct problem
+    /// rather than once per CUTLASS operation.
+    std::set<std::string> vendor_profiled_arguments_;
+
+    /// Work items of a sharded sweep assigned to this process, identified by
+    /// the index of their problem within the sweep
+    std::set<std::pair<size_t, library::Operation const*>> shard_work_;
+
+    /// True while profiling only the work items in shard_work_
+    bool sharded_;
+
+    /// Index of the current problem within the sweep
+    size_t problem_idx_;
+
+    /// Host reference check of a result running on the verification threads
+    struct PendingVerification {
+        size_t result_index;
+        library::Provider provider;
+        HostVerificationPool::Outcome outcome;
+    };
+
+    /// Result held back from the report until its host reference checks
+    /// complete
+    struct DeferredResult {
+        PerformanceResult result;
+        std::vector<PendingVerification> verifications;
+    };
+
+    /// Checks submitted for the entries of results_
+    std::vector<PendingVerification> pending_verifications_;
+
+    /// Results of previous operations of the current problem in report order
+    std::deque<DeferredResult> deferred_results_;
+
+    /// Threads running host references. Created on first use.
+    std::unique_ptr<HostVerificationPool> host_verification_pool_;
+
+    /// Buffer overwritten to evict the L2 in cold cache mode. Allocated on
+    /// first use.
+    DeviceAllocation l2_flush_buffer_;
+
 public:
     //
     // Methods
@@ -124,6 +172,13 @@ public:
                             library::Manifest const& manifest,
                             DeviceContext& device_context);
 
+    /// Entry point to profile the records of a workload trace matching this
+    /// operation kind
+    virtual int profile_workload(Options const& options,
+                                 library::Manifest const& manifest,
+                                 DeviceContext& device_context,
+                                 WorkloadSummary& summary);
+
 public:
     //
     // Operation-specific phases of verification and profiling
@@ -201,8 +256,66 @@ protected:
             library::OperationDescription const& operation_desc,
             ProblemSpace const& problem_space);
 
+    /// Returns true once enough iterations were profiled. In adaptive mode,
+    /// synchronizes periodically to test the width of the confidence interval.
+    static bool profiling_complete_(Options const& options,
+                                    GpuSampledTimer const& timer);
+
+    /// Returns the number of copies of a problem occupying the given bytes
+    /// which timed launches rotate through
+    static int workspace_problem_count_(Options const& options,
+                                        int64_t bytes);
+
+    /// In cold cache mode, evicts the L2 before a timed launch without
+    /// measuring the eviction
+    void flush_cache_(Options const& options, GpuSampledTimer& timer);
+
+    /// Sets the runtime of a result and its distribution
+    static void set_runtime_(PerformanceResult& result, Options const& options,
+                             GpuSampledTimer const& timer);
+
+    /// Returns true the first time a vendor library should be profiled for
+    /// the arguments of a result within the current problem
+    bool vendor_profiling_pending_(PerformanceResult const& result);
+
+    /// Copies a device allocation to a host buffer shared with checks
+    /// running on the verification threads
+    static std::shared_ptr<std::vector<uint8_t>> copy_to_host_(
+            DeviceAllocation& allocation);
+
+    /// Hands a host reference check of the most recent result to the
+    /// verification threads. Its outcome is merged into the result before
+    /// the result is reported.
+    void verify_on_host_async_(Options const& options,
+                               library::Provider provider,
+                               HostVerificationPool::Task task);
+
+    /// Moves results_ to the report once their host reference checks are
+    /// complete, preserving their order. If wait is true, blocks until every
+    /// result has been reported.
+    void report_results_(PerformanceReport& report, bool wait,
+                         PerformanceResultVector* collected_results = nullptr);
+
+    /// Returns true if an operation is profiled for a problem on the current
+    /// device given the kernel filters of the command line
+    bool selected_(Options const& options, library::Operation const* operation,
+                   ProblemSpace const& problem_space,
+                   ProblemSpace::Problem const& problem);
+
+    /// Verifies and profiles every operation in the manifest satisfying one
+    /// problem. Returns false if profiling should stop.
+    bool profile_problem_(Options const& options,
+                          library::Manifest const& manifest,
+                          DeviceContext& device_context,
+                          PerformanceReport& report,
+                          ProblemSpace const& problem_space,
+                          ProblemSpace::Problem const& problem,
+                          bool& internal_error,
+                          PerformanceResultVector* collected_results = nullptr);
+
     /// Method to profile an initialized CUTLASS operation
-    virtual Status profile_cutlass_(double& runtime, Options const& options,
+    virtual Status profile_cutlass_(PerformanceResult& result,
+                                    Options const& options,
                                     library::Operation const* operation,
                                     void* arguments, void* host_workspace,
                                     void* device_workspace);
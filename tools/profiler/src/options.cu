@@ -29,6 +29,10 @@
 */
 
 #include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/version.h"
@@ -50,20 +54,79 @@ static char const* end_of_line =
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-Options::Device::Device(cutlass::CommandLine const& cmdline) {
+/// Returns true if the command line requests a dry run
+static bool dry_run_requested(cutlass::CommandLine const& cmdline) {
+    bool dry_run = false;
+    cmdline.get_cmd_line_argument("dry-run", dry_run, false);
+
+    if (cmdline.check_cmd_line_flag("mode")) {
+        std::string token;
+        cmdline.get_cmd_line_argument("mode", token);
+
+        ExecutionMode mode = from_string<ExecutionMode>(token);
+        dry_run = dry_run || mode == ExecutionMode::kDryRun ||
+                  mode == ExecutionMode::kEnumerate;
+    }
+
+    return dry_run;
+}
+
+/// Describes the device planned for when a dry run finds no CUDA device. The
+/// defaults are those of an A100-SXM4-40GB.
+static cudaDeviceProp emulated_device_properties(
+        cutlass::CommandLine const& cmdline) {
+    cudaDeviceProp properties;
+    std::memset(&properties, 0, sizeof(properties));
+
+    int cc = 80;
+    cmdline.get_cmd_line_argument("compute-capability", cc, cc);
+    properties.major = cc / 10;
+    properties.minor = cc % 10;
+
+    std::string name = "SM" + std::to_string(cc);
+    std::strncpy(properties.name, name.c_str(), sizeof(properties.name) - 1);
+
+    cmdline.get_cmd_line_argument("sm-count", properties.multiProcessorCount,
+                                  108);
+
+    properties.clockRate = 1410000;
+    properties.memoryClockRate = 1215000;
+    properties.memoryBusWidth = 5120;
+    properties.l2CacheSize = 40 << 20;
+    properties.totalGlobalMem = size_t(40) << 30;
+    properties.sharedMemPerBlock = 48 << 10;
+    properties.sharedMemPerBlockOptin = 163 << 10;
+    properties.sharedMemPerMultiprocessor = 164 << 10;
+    properties.regsPerMultiprocessor = 64 << 10;
+    properties.maxThreadsPerMultiProcessor = 2048;
+    properties.maxThreadsPerBlock = 1024;
+    properties.warpSize = 32;
+
+    return properties;
+}
+
+Options::Device::Device(cutlass::CommandLine const& cmdline)
+        : emulated(false) {
     cmdline.get_cmd_line_argument("device", device, 0);
 
     cudaError_t result;
     result = cudaGetDeviceProperties(&properties, device);
 
     if (result != cudaSuccess) {
-        throw std::runtime_error(
-                "cudaGetDeviceProperties() failed for given device");
-    }
+        // Dry runs launch nothing, so they may plan for an absent device
+        if (!dry_run_requested(cmdline)) {
+            throw std::runtime_error(
+                    "cudaGetDeviceProperties() failed for given device");
+        }
 
-    result = cudaSetDevice(device);
-    if (result != cudaSuccess) {
-        throw std::runtime_error("cudaSetDevice() failed for given device.");
+        properties = emulated_device_properties(cmdline);
+        emulated = true;
+    } else {
+        result = cudaSetDevice(device);
+        if (result != cudaSuccess) {
+            throw std::runtime_error(
+                    "cudaSetDevice() failed for given device.");
+        }
     }
 
     // Permit overriding the compute capability
@@ -119,6 +182,13 @@ void Options::Device::print_usage(std::ostream& out) const {
     out << "  --compute-capability=<int>                   "
         << "    Override the compute capability.\n\n"
 
+        << "  --sm-count=<int>                             "
+        << "    Number of SMs of the device a dry run plans for when no CUDA"
+        << end_of_line
+        << "      device is present (default: 108). Other properties default "
+           "to"
+        << end_of_line << "      those of an A100-SXM4-40GB.\n\n"
+
         << "  --llc-capacity=<capacity in KiB>             "
         << "    Capacity of last-level cache in kilobytes. If this is non-zero,"
         << end_of_line
@@ -158,7 +228,8 @@ void Options::Device::print_device_info(std::ostream& out) const {
 }
 
 void Options::Device::print_options(std::ostream& out, int indent) const {
-    out << indent_str(indent) << "device: " << device << "\n"
+    out << indent_str(indent) << "device: " << device
+        << (emulated ? " (emulated)" : "") << "\n"
         << indent_str(indent)
         << "clock: " << int(double(properties.clockRate) / 1000.0) << "\n"
         << indent_str(indent) << "compute-capability: " << compute_capability()
@@ -192,6 +263,13 @@ Options::Initialization::Initialization(cutlass::CommandLine const& cmdline) {
 
     cmdline.get_cmd_line_argument("seed", seed, 2019);
 
+    // Given in MiB on the command line
+    cmdline.get_cmd_line_argument("tensor-cache-budget", tensor_cache_budget,
+                                  int64_t(-1));
+    if (tensor_cache_budget > 0) {
+        tensor_cache_budget <<= 20;
+    }
+
     if (cmdline.check_cmd_line_flag("dist")) {
         // user has set the data distribution (fix data distribution once set)
         fix_data_distribution = true;
@@ -303,7 +381,15 @@ void Options::Initialization::print_usage(std::ostream& out) const {
 
         << "  --seed=<int>                                 "
         << "    Random number generator seed. Used to enforce deterministic"
-        << end_of_line << "      initialization.\n\n";
+        << end_of_line << "      initialization.\n\n"
+
+        << "  --tensor-cache-budget=<MiB>                  "
+        << "    Device memory held by initialized input tensors reused across "
+           "operations"
+        << end_of_line
+        << "      and problems. 0 reinitializes the tensors of every "
+           "operation."
+        << end_of_line << "      (default: a quarter of device memory)\n\n";
 }
 
 void Options::Initialization::print_options(std::ostream& out,
@@ -376,9 +462,27 @@ void Options::Library::print_options(std::ostream& out, int indent) const {
 
 Options::Profiling::Profiling(cutlass::CommandLine const& cmdline) {
     cmdline.get_cmd_line_argument("workspace-count", workspace_count, 0);
+
+    if (cmdline.check_cmd_line_flag("cache-mode")) {
+        std::string token;
+        cmdline.get_cmd_line_argument("cache-mode", token);
+        cache_mode = from_string<CacheMode>(token);
+        if (cache_mode == CacheMode::kInvalid) {
+            throw std::runtime_error("Invalid cache mode '" + token + "'");
+        }
+    } else {
+        cache_mode = CacheMode::kRotating;
+    }
+
     cmdline.get_cmd_line_argument("warmup-iterations", warmup_iterations, 10);
     cmdline.get_cmd_line_argument("profiling-iterations", iterations, 100);
     cmdline.get_cmd_line_argument("sleep-duration", sleep_duration, 50);
+    cmdline.get_cmd_line_argument("iterations-per-sample",
+                                  iterations_per_sample, 1);
+    cmdline.get_cmd_line_argument("confidence", confidence, 0.95);
+    cmdline.get_cmd_line_argument("target-ci-width", target_ci_width, 0.0);
+    cmdline.get_cmd_line_argument("max-profiling-iterations", max_iterations,
+                                  10000);
     cmdline.get_cmd_line_argument("profiling-enabled", enabled, true);
 
     if (cmdline.check_cmd_line_flag("providers")) {
@@ -408,6 +512,21 @@ void Options::Profiling::print_usage(std::ostream& out) const {
            "based on "
         << end_of_line << "    capacity of the last-level cache.\n\n"
 
+        << "  --cache-mode=<mode>                          "
+        << "    State of the L2 cache when each timed kernel launches."
+        << end_of_line
+        << "       --cache-mode=warm      every launch reuses one workspace"
+        << end_of_line
+        << "       --cache-mode=rotating  launches rotate through enough "
+           "workspaces"
+        << end_of_line
+        << "                               to exceed the L2 (default)"
+        << end_of_line
+        << "       --cache-mode=cold      the L2 is flushed before every "
+           "launch;"
+        << end_of_line
+        << "                               the flush is not timed\n\n"
+
         << "  --profiling-iterations=<iterations>          "
         << "    Number of iterations to profile each kernel. If zero, kernels"
         << end_of_line << "      are launched up to the profiling duration.\n\n"
@@ -416,6 +535,28 @@ void Options::Profiling::print_usage(std::ostream& out) const {
         << "    Number of iterations to execute each kernel prior to "
            "profiling.\n\n"
 
+        << "  --iterations-per-sample=<iterations>         "
+        << "    Number of iterations timed by each runtime sample. Median, "
+           "percentiles and"
+        << end_of_line
+        << "      standard deviation are computed over samples. (default: "
+           "1)\n\n"
+
+        << "  --confidence=<level>                         "
+        << "    Confidence level of the bootstrap interval on the median "
+           "runtime. (default: 0.95)\n\n"
+
+        << "  --target-ci-width=<fraction>                 "
+        << "    If nonzero, kernels are profiled beyond --profiling-iterations "
+           "until the"
+        << end_of_line
+        << "      confidence interval is narrower than this fraction of the "
+           "median runtime.\n\n"
+
+        << "  --max-profiling-iterations=<iterations>      "
+        << "    Maximum number of iterations profiled when "
+           "--target-ci-width is set.\n\n"
+
         << "  --sleep-duration=<duration>                  "
         << "    Number of ms to sleep between profiling periods (ms).\n\n"
 
@@ -431,8 +572,16 @@ void Options::Profiling::print_usage(std::ostream& out) const {
 }
 
 void Options::Profiling::print_options(std::ostream& out, int indent) const {
-    out << indent_str(indent) << "profiling_iterations: " << iterations << "\n"
+    out << indent_str(indent) << "cache_mode: " << to_string(cache_mode)
+        << "\n"
+        << indent_str(indent) << "profiling_iterations: " << iterations << "\n"
         << indent_str(indent) << "sleep_duration: " << sleep_duration << "\n"
+        << indent_str(indent) << "iterations_per_sample: "
+        << iterations_per_sample << "\n"
+        << indent_str(indent) << "confidence: " << confidence << "\n"
+        << indent_str(indent) << "target_ci_width: " << target_ci_width << "\n"
+        << indent_str(indent) << "max_profiling_iterations: " << max_iterations
+        << "\n"
         << indent_str(indent) << "profiling_enabled: " << enabled << "\n"
         << indent_str(indent) << "providers: [";
 
@@ -478,6 +627,12 @@ Options::Verification::Verification(cutlass::CommandLine const& cmdline) {
         save_workspace = SaveWorkspace::kNever;
     }
 
+    cmdline.get_cmd_line_argument("verification-threads", threads, 0);
+
+    if (threads < 0) {
+        threads = std::max(int(std::thread::hardware_concurrency()), 1);
+    }
+
     if (cmdline.check_cmd_line_flag("verification-providers")) {
         std::vector<std::string> tokens;
         cmdline.get_cmd_line_arguments("verification-providers", tokens);
@@ -523,6 +678,14 @@ void Options::Verification::print_usage(std::ostream& out) const {
         << end_of_line
         << "       --save-workspace=always     always save workspace\n\n"
 
+        << "  --verification-threads=<int>                 "
+        << "    Number of CPU threads running host references while the GPU "
+           "proceeds"
+        << end_of_line
+        << "      with the next kernel. Zero (default) runs them serially, and "
+           "-1 uses"
+        << end_of_line << "      every hardware thread.\n\n"
+
         << "  --verification-providers=<providers>         "
         << "    List of providers used to verify result. (default: '*')"
         << end_of_line << "      Gemm verification-providers {cublas*}"
@@ -536,6 +699,7 @@ void Options::Verification::print_options(std::ostream& out, int indent) const {
         << indent_str(indent) << "epsilon: " << epsilon << "\n"
         << indent_str(indent) << "save_workspace: " << to_string(save_workspace)
         << "\n"
+        << indent_str(indent) << "verification_threads: " << threads << "\n"
         << indent_str(indent) << "verification_providers: [";
 
     int j = 0;
@@ -551,6 +715,13 @@ bool Options::Verification::provider_enabled(library::Provider provider) const {
            providers.end();
 }
 
+/// Returns true if host references run on verification threads
+bool Options::Verification::host_async() const {
+    // Saving the workspace of incorrect results requires the device tensors
+    // which are released before asynchronous checks complete
+    return threads > 0 && save_workspace != SaveWorkspace::kIncorrect;
+}
+
 /// Returns the index of a provider if its enabled
 size_t Options::Verification::index(library::Provider provider) const {
     size_t idx = 0;
@@ -569,6 +740,8 @@ Options::Report::Report(cutlass::CommandLine const& cmdline) {
     cmdline.get_cmd_line_argument("append", append, false);
     cmdline.get_cmd_line_argument("output", output_path);
     cmdline.get_cmd_line_argument("junit-output", junit_output_path);
+    cmdline.get_cmd_line_argument("json-output", json_output_path);
+    cmdline.get_cmd_line_argument("chrome-trace", chrome_trace_path);
 
     if (cmdline.check_cmd_line_flag("tags")) {
         cmdline.get_cmd_line_argument_pairs("tags", pivot_tags);
@@ -595,6 +768,19 @@ void Options::Report::print_usage(std::ostream& out) const {
         << "    Path to junit output file for result reporting. Operation kind "
            "and '.junit.xml' is appended.\n\n"
 
+        << "  --json-output=<path>                         "
+        << "    Path to JSON output file including timing statistics and the "
+           "environment."
+        << end_of_line
+        << "      Operation kind and '.json' is appended.\n\n"
+
+        << "  --chrome-trace=<path>                        "
+        << "    Path to a file receiving a trace of kernel selection, "
+           "initialization,"
+        << end_of_line
+        << "      verification and launches. Open it with chrome://tracing "
+           "or Perfetto.\n\n"
+
         << "  --report-not-run=<bool>                      "
         << "    If true, reports the status of all kernels including those that"
         << end_of_line << "      do not satisfy the given arguments.\n\n"
@@ -614,6 +800,9 @@ void Options::Report::print_options(std::ostream& out, int indent) const {
     out << indent_str(indent) << "append: " << append << "\n"
         << indent_str(indent) << "output: " << output_path << "\n"
         << indent_str(indent) << "junit-output: " << junit_output_path << "\n"
+        << indent_str(indent) << "json-output: " << json_output_path << "\n"
+        << indent_str(indent) << "chrome-trace: " << chrome_trace_path
+        << "\n"
         << indent_str(indent) << "report_not_run: " << report_not_run << "\n"
         << indent_str(indent) << "tags:\n";
 
@@ -627,6 +816,80 @@ void Options::Report::print_options(std::ostream& out, int indent) const {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+Options::Sweep::Sweep(cutlass::CommandLine const& cmdline) {
+    if (cmdline.check_cmd_line_flag("sampling")) {
+        std::string token;
+        cmdline.get_cmd_line_argument("sampling", token);
+        mode = from_string<SamplingMode>(token);
+        if (mode == SamplingMode::kInvalid) {
+            throw std::runtime_error("Invalid sampling mode '" + token + "'");
+        }
+    } else {
+        mode = SamplingMode::kExhaustive;
+    }
+
+    cmdline.get_cmd_line_argument("samples", samples, size_t(256));
+    cmdline.get_cmd_line_argument("sampling-seed", seed, uint64_t(2020));
+    cmdline.get_cmd_line_argument("checkpoint", checkpoint_path);
+
+    if (cmdline.check_cmd_line_flag("shard")) {
+        std::string token;
+        cmdline.get_cmd_line_argument("shard", token);
+        shard = ShardSpec::parse(token);
+    }
+
+    if (mode != SamplingMode::kExhaustive && samples == 0) {
+        throw std::runtime_error("--samples must be greater than zero");
+    }
+}
+
+void Options::Sweep::print_usage(std::ostream& out) const {
+    out << "Sweep:\n"
+
+        << "  --sampling=<mode>                            "
+        << "    Selects the points of the problem space to profile."
+        << end_of_line
+        << "       --sampling=exhaustive  every point (default)" << end_of_line
+        << "       --sampling=lhs         Latin hypercube sample" << end_of_line
+        << "       --sampling=sobol       Sobol sequence\n\n"
+
+        << "  --samples=<int>                              "
+        << "    Number of points drawn by --sampling=lhs|sobol. Spaces with "
+           "no more"
+        << end_of_line
+        << "      points are swept exhaustively. (default: 256)\n\n"
+
+        << "  --sampling-seed=<int>                        "
+        << "    Random seed for --sampling=lhs. (default: 2020)\n\n"
+
+        << "  --checkpoint=<path>                          "
+        << "    Records each completed problem in this file and skips problems "
+           "it"
+        << end_of_line
+        << "      already lists. Results are appended to --output if the file "
+           "exists.\n\n"
+
+        << "  --shard=<index>/<count>                      "
+        << "    Profiles one of <count> disjoint shares of the sweep, balanced "
+           "by"
+        << end_of_line
+        << "      estimated cost. Shards are numbered from 0 and their reports "
+           "are"
+        << end_of_line
+        << "      combined with --merge.\n\n";
+}
+
+void Options::Sweep::print_options(std::ostream& out, int indent) const {
+    out << indent_str(indent) << "sampling: " << to_string(mode) << "\n"
+        << indent_str(indent) << "samples: " << samples << "\n"
+        << indent_str(indent) << "sampling-seed: " << seed << "\n"
+        << indent_str(indent) << "checkpoint: " << checkpoint_path << "\n"
+        << indent_str(indent) << "shard: " << shard.index << "/" << shard.count
+        << "\n";
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 Options::About::About(cutlass::CommandLine const& cmdline) {
     help = cmdline.check_cmd_line_flag("help");
     version = cmdline.check_cmd_line_flag("version");
@@ -661,6 +924,7 @@ Options::Options(cutlass::CommandLine const& cmdline)
           profiling(cmdline),
           verification(cmdline),
           report(cmdline),
+          sweep(cmdline),
           about(cmdline) {
     if (cmdline.check_cmd_line_flag("mode")) {
         std::string token;
@@ -670,6 +934,11 @@ Options::Options(cutlass::CommandLine const& cmdline)
         execution_mode = ExecutionMode::kProfile;
     }
 
+    // --dry-run is shorthand for --mode=dry_run
+    if (dry_run_requested(cmdline)) {
+        execution_mode = ExecutionMode::kDryRun;
+    }
+
     // Enumerating kernels is equivalent to a dry run.
     if (execution_mode == ExecutionMode::kEnumerate) {
         execution_mode = ExecutionMode::kDryRun;
@@ -698,6 +967,15 @@ Options::Options(cutlass::CommandLine const& cmdline)
                                        excluded_operation_names);
     }
 
+    cmdline.get_cmd_line_argument("workload", workload_path);
+
+    // Resumed sweeps extend the results of the interrupted run
+    if (!sweep.checkpoint_path.empty() &&
+        !cmdline.check_cmd_line_flag("append") &&
+        std::ifstream(sweep.checkpoint_path).good()) {
+        report.append = true;
+    }
+
     // Prevent launches on the device for anything other than CUTLASS operation
     if (execution_mode == ExecutionMode::kTrace) {
         initialization.provider = library::Provider::kReferenceHost;
@@ -720,6 +998,8 @@ void Options::print_usage(std::ostream& out) const {
         << "       --mode=dry_run    no kernels are launched or workspaces "
            "allocated"
         << end_of_line
+        << "                          (also --dry-run). Needs no CUDA device."
+        << end_of_line
         << "       --mode=enumerate  lists all operation kind and operations"
         << end_of_line
         << "       --mode=trace      executes a single device-side computation "
@@ -744,7 +1024,41 @@ void Options::print_usage(std::ostream& out) const {
            "s884*tn*align8\"\n\n"
 
         << "  --ignore-kernels=<string_list>               "
-        << "    Excludes kernels whose names match anything in this list.\n\n";
+        << "    Excludes kernels whose names match anything in this list.\n\n"
+
+        << "  --workload=<path>                            "
+        << "    Profiles the problems of a CSV workload trace instead of the "
+           "problem space"
+        << end_of_line
+        << "      and reports runtimes weighted by the frequency of each "
+           "problem.\n\n"
+
+        << "  --compare=<baseline.json,candidate.json>     "
+        << "    Compares two JSON reports written with --json-output without "
+           "using a GPU."
+        << end_of_line
+        << "      Exits with 1 if the candidate regresses and 2 if a report "
+           "cannot be read.\n\n"
+
+        << "  --compare-threshold=<fraction>               "
+        << "    Smallest relative change of the median runtime reported by "
+           "--compare."
+        << end_of_line
+        << "      Changes within the confidence intervals are treated as "
+           "noise. (default: 0.05)\n\n"
+
+        << "  --compare-output=<path>                      "
+        << "    Path to CSV file listing every comparison made by --compare.\n\n"
+
+        << "  --merge=<report,report,...>                  "
+        << "    Combines the CSV or JSON reports of the shards of a sweep without "
+           "using"
+        << end_of_line
+        << "      a GPU. Results repeated by a later report replace earlier "
+           "ones.\n\n"
+
+        << "  --merge-output=<path>                        "
+        << "    Path to the report written by --merge. (default: stdout)\n\n";
 
     //
     // Detailed options
@@ -768,6 +1082,9 @@ void Options::print_usage(std::ostream& out) const {
     report.print_usage(out);
     out << "\n";
 
+    sweep.print_usage(out);
+    out << "\n";
+
     about.print_usage(out);
     out << "\n";
 }
@@ -791,6 +1108,9 @@ void Options::print_options(std::ostream& out) const {
 
     out << "  report:\n";
     report.print_options(out, 2);
+
+    out << "  sweep:\n";
+    sweep.print_options(out, 2);
 }
 
 std::string Options::indent_str(int indent) {
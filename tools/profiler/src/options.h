@@ -41,6 +41,7 @@
 #include "cutlass/library/library.h"
 
 #include "enumerated_types.h"
+#include "shard.h"
 
 namespace cutlass {
 namespace profiler {
@@ -80,6 +81,10 @@ public:
         /// CUDA Device properties
         cudaDeviceProp properties;
 
+        /// If true, no CUDA device was found and the properties describe the
+        /// device a dry run plans for
+        bool emulated;
+
         /// Total memory allocation on device
         size_t maximum_capacity;
 
@@ -118,6 +123,11 @@ public:
         /// Random number generator seed.
         int seed;
 
+        /// Device memory in bytes held by initialized input tensors reused
+        /// across operations and problems. Negative selects a quarter of the
+        /// device memory; zero disables reuse.
+        int64_t tensor_cache_budget;
+
         //
         // Methods
         //
@@ -154,6 +164,10 @@ public:
         /// Indicates when to save the workspace
         SaveWorkspace save_workspace;
 
+        /// Number of CPU threads running host references asynchronously. If
+        /// zero, host references run serially after each kernel.
+        int threads;
+
         //
         // Methods
         //
@@ -168,6 +182,9 @@ public:
 
         /// Returns the index of a provider if its enabled
         size_t index(library::Provider provider) const;
+
+        /// Returns true if host references run on verification threads
+        bool host_async() const;
     };
 
     /// Options related to profiling
@@ -176,6 +193,9 @@ public:
         /// working sets
         int workspace_count;
 
+        /// State of the L2 cache when each timed kernel launches
+        CacheMode cache_mode;
+
         /// Number of iterations to warmup each kernel prior to profiling
         int warmup_iterations;
 
@@ -186,6 +206,19 @@ public:
         /// Number of ms to sleep between profiling periods (ms)
         int sleep_duration;
 
+        /// Number of iterations measured by each runtime sample
+        int iterations_per_sample;
+
+        /// Confidence level of the interval reported on the median runtime
+        double confidence;
+
+        /// If nonzero, profiling continues past `iterations` until the
+        /// confidence interval is narrower than this fraction of the median
+        double target_ci_width;
+
+        /// Maximum number of iterations profiled in adaptive mode
+        int max_iterations;
+
         /// If true, profiling is actually conducted.
         bool enabled;
 
@@ -201,6 +234,10 @@ public:
         void print_usage(std::ostream& out) const;
         void print_options(std::ostream& out, int indent = 0) const;
 
+        /// Returns true if profiling continues until the confidence interval
+        /// reaches its target width
+        bool adaptive() const { return target_ci_width > 0; }
+
         /// Returns true if a provider is enabled
         bool provider_enabled(library::Provider provider) const;
 
@@ -219,6 +256,13 @@ public:
         /// Path to a file containing junit xml results
         std::string junit_output_path;
 
+        /// Path to a file containing JSON results
+        std::string json_output_path;
+
+        /// Path to a file receiving a Chrome trace of library and profiler
+        /// events
+        std::string chrome_trace_path;
+
         /// Sequence of tags to attach to each result
         std::vector<std::pair<std::string, std::string>> pivot_tags;
 
@@ -240,6 +284,34 @@ public:
         void print_options(std::ostream& out, int indent = 0) const;
     };
 
+    /// Options related to the points of the problem space visited
+    struct Sweep {
+        /// Strategy used to select points of the problem space
+        SamplingMode mode;
+
+        /// Number of points drawn by sampled sweeps
+        size_t samples;
+
+        /// Seed of the random number generator used by sampled sweeps
+        uint64_t seed;
+
+        /// Path to a file recording completed problems. Problems listed in
+        /// this file are skipped.
+        std::string checkpoint_path;
+
+        /// Share of the work items profiled by this process
+        ShardSpec shard;
+
+        //
+        // Methods
+        //
+
+        Sweep(CommandLine const& cmdline);
+
+        void print_usage(std::ostream& out) const;
+        void print_options(std::ostream& out, int indent = 0) const;
+    };
+
     /// Options related to printing usage and version information
     struct About {
         /// If true, usage is printed and the program ends.
@@ -280,6 +352,9 @@ public:
     /// Vector of operation name substrings
     std::vector<std::string> excluded_operation_names;
 
+    /// Path to a workload trace replayed instead of the problem space
+    std::string workload_path;
+
     //
     // Detailed configuration options
     //
@@ -292,6 +367,7 @@ public:
     Verification verification;
     Profiling profiling;
     Report report;
+    Sweep sweep;
     About about;
 
 public:
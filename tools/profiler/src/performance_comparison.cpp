@@ -0,0 +1,472 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Compares two JSON performance reports and classifies the change of
+   each result
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "cutlass/library/util.h"
+
+#include "performance_comparison.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+static struct {
+    char const* text;
+    char const* pretty;
+    ComparisonOutcome enumerant;
+} ComparisonOutcome_enumerants[] = {
+        {"unchanged", "Unchanged", ComparisonOutcome::kUnchanged},
+        {"improved", "Improved", ComparisonOutcome::kImproved},
+        {"regressed", "Regressed", ComparisonOutcome::kRegressed},
+        {"failed", "Failed", ComparisonOutcome::kFailed},
+        {"fixed", "Fixed", ComparisonOutcome::kFixed},
+        {"missing", "Missing", ComparisonOutcome::kMissing},
+        {"added", "Added", ComparisonOutcome::kAdded}};
+
+/// Converts a ComparisonOutcome enumerant to a string
+char const* to_string(ComparisonOutcome outcome, bool pretty) {
+    for (auto const& possible : ComparisonOutcome_enumerants) {
+        if (outcome == possible.enumerant) {
+            if (pretty) {
+                return possible.pretty;
+            } else {
+                return possible.text;
+            }
+        }
+    }
+
+    return pretty ? "Invalid" : "invalid";
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Parses a Status from the string written by library::to_string()
+Status status_from_string(std::string const& str) {
+    Status const statuses[] = {Status::kSuccess,
+                               Status::kErrorMisalignedOperand,
+                               Status::kErrorInvalidDataType,
+                               Status::kErrorInvalidLayout,
+                               Status::kErrorInvalidProblem,
+                               Status::kErrorNotSupported,
+                               Status::kErrorWorkspaceNull,
+                               Status::kErrorInternal,
+                               Status::kErrorArchMismatch,
+                               Status::kErrorInsufficientDriver};
+
+    for (Status status : statuses) {
+        if (str == library::to_string(status)) {
+            return status;
+        }
+    }
+    return Status::kInvalid;
+}
+
+/// Returns true if a result failed verification or could not be run
+bool result_failed(PerformanceResult const& result) {
+    return result.disposition == Disposition::kFailed ||
+           result.disposition == Disposition::kIncorrect;
+}
+
+/// Central runtime of a result: the median if samples were recorded
+double central_runtime(PerformanceResult const& result) {
+    return result.runtime_statistics.good() ? result.runtime_statistics.median
+                                            : result.runtime;
+}
+
+/// Returns the arguments of a result as a command line fragment
+std::string arguments_string(PerformanceResult const& result) {
+    std::stringstream ss;
+    int column_idx = 0;
+    for (auto const& arg : result.arguments) {
+        if (!arg.second.empty()) {
+            ss << (column_idx++ ? " " : "") << "--" << arg.first << "="
+               << arg.second;
+        }
+    }
+    return ss.str();
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reads the results of a report written by PerformanceReport::print_json_*
+PerformanceResultVector read_performance_results(JsonValue const& document) {
+    JsonValue const* results = document.find("results");
+    if (!results || results->kind != JsonValue::Kind::kArray) {
+        throw std::runtime_error("report does not contain a 'results' array");
+    }
+
+    PerformanceResultVector performance_results;
+
+    for (JsonValue const& value : results->array) {
+        PerformanceResult result;
+
+        result.problem_index = size_t(value.get_number("problem_index"));
+        result.provider =
+                library::from_string<library::Provider>(value.get_string("provider"));
+        result.op_kind = library::from_string<library::OperationKind>(
+                value.get_string("operation_kind"));
+        result.operation_name = value.get_string("operation");
+        result.status = status_from_string(value.get_string("status"));
+        result.disposition =
+                from_string<Disposition>(value.get_string("disposition"));
+
+        if (JsonValue const* verification = value.find("verification")) {
+            for (auto const& member : verification->object) {
+                result.verification_map[library::from_string<library::Provider>(
+                        member.first)] =
+                        from_string<Disposition>(member.second.string);
+            }
+        }
+
+        if (JsonValue const* arguments = value.find("arguments")) {
+            for (auto const& member : arguments->object) {
+                result.arguments.emplace_back(member.first,
+                                              member.second.string);
+            }
+        }
+
+        result.bytes = int64_t(value.get_number("bytes"));
+        result.flops = int64_t(value.get_number("flops"));
+        result.runtime = value.get_number("runtime");
+
+        if (JsonValue const* statistics = value.find("statistics")) {
+            RuntimeStatistics& stats = result.runtime_statistics;
+
+            stats.samples = int(statistics->get_number("samples"));
+            stats.mean = statistics->get_number("mean");
+            stats.min = statistics->get_number("min");
+            stats.median = statistics->get_number("median");
+            stats.p90 = statistics->get_number("p90");
+            stats.p99 = statistics->get_number("p99");
+            stats.stddev = statistics->get_number("stddev");
+            stats.confidence = statistics->get_number("confidence");
+            stats.ci_lower = statistics->get_number("ci_lower");
+            stats.ci_upper = statistics->get_number("ci_upper");
+        }
+
+        performance_results.push_back(result);
+    }
+
+    return performance_results;
+}
+
+/// Returns a string identifying the provider, operation and problem of a
+/// result. Results with equal keys are compared with each other.
+std::string comparison_key(PerformanceResult const& result) {
+    std::stringstream ss;
+    ss << library::to_string(result.provider) << "|"
+       << library::to_string(result.op_kind) << "|" << result.operation_name;
+
+    for (auto const& arg : result.arguments) {
+        ss << "|" << arg.first << "=" << arg.second;
+    }
+
+    return ss.str();
+}
+
+/// Classifies the change between two results of the same key
+ComparisonOutcome compare_result(PerformanceResult const& baseline,
+                                 PerformanceResult const& candidate,
+                                 double threshold, double& relative_change) {
+    relative_change = 0;
+
+    bool baseline_failed = result_failed(baseline);
+    bool candidate_failed = result_failed(candidate);
+
+    if (candidate_failed && !baseline_failed) {
+        return ComparisonOutcome::kFailed;
+    }
+    if (baseline_failed && !candidate_failed) {
+        return ComparisonOutcome::kFixed;
+    }
+    if (!baseline.good() || !candidate.good()) {
+        return ComparisonOutcome::kUnchanged;
+    }
+
+    relative_change = central_runtime(candidate) / central_runtime(baseline) - 1;
+
+    if (std::abs(relative_change) <= threshold) {
+        return ComparisonOutcome::kUnchanged;
+    }
+
+    // Changes of the median which keep the confidence intervals overlapping
+    // are indistinguishable from measurement noise
+    RuntimeStatistics const& base = baseline.runtime_statistics;
+    RuntimeStatistics const& cand = candidate.runtime_statistics;
+
+    if (base.good() && cand.good() && cand.ci_lower <= base.ci_upper &&
+        base.ci_lower <= cand.ci_upper) {
+        return ComparisonOutcome::kUnchanged;
+    }
+
+    return relative_change > 0 ? ComparisonOutcome::kRegressed
+                               : ComparisonOutcome::kImproved;
+}
+
+/// Matches results by key and compares each pair
+ComparisonRecordVector compare_results(PerformanceResultVector const& baseline,
+                                       PerformanceResultVector const& candidate,
+                                       double threshold) {
+    // Results sharing a key are matched in the order they were reported
+    std::map<std::string, std::vector<size_t>> baseline_index;
+    for (size_t idx = baseline.size(); idx > 0; --idx) {
+        baseline_index[comparison_key(baseline[idx - 1])].push_back(idx - 1);
+    }
+
+    std::vector<bool> matched(baseline.size(), false);
+    ComparisonRecordVector records;
+
+    for (auto const& result : candidate) {
+        ComparisonRecord record;
+        record.candidate = &result;
+
+        auto it = baseline_index.find(comparison_key(result));
+        if (it == baseline_index.end() || it->second.empty()) {
+            record.outcome = ComparisonOutcome::kAdded;
+        } else {
+            size_t idx = it->second.back();
+            it->second.pop_back();
+            matched[idx] = true;
+
+            record.baseline = &baseline[idx];
+            record.outcome = compare_result(baseline[idx], result, threshold,
+                                            record.relative_change);
+        }
+
+        records.push_back(record);
+    }
+
+    for (size_t idx = 0; idx < baseline.size(); ++idx) {
+        if (!matched[idx]) {
+            ComparisonRecord record;
+            record.baseline = &baseline[idx];
+            record.outcome = ComparisonOutcome::kMissing;
+            records.push_back(record);
+        }
+    }
+
+    return records;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns true if the command line requests a comparison
+bool PerformanceComparison::enabled(CommandLine const& cmdline) {
+    return cmdline.check_cmd_line_flag("compare");
+}
+
+PerformanceComparison::PerformanceComparison(CommandLine const& cmdline) {
+    std::vector<std::string> paths;
+    cmdline.get_cmd_line_arguments("compare", paths);
+
+    if (paths.size() == 2) {
+        baseline_path_ = paths[0];
+        candidate_path_ = paths[1];
+    }
+
+    cmdline.get_cmd_line_argument("compare-threshold", threshold_, 0.05);
+    cmdline.get_cmd_line_argument("compare-output", output_path_);
+}
+
+/// Reads a report, returning false on failure
+bool PerformanceComparison::read_(std::string const& path,
+                                  JsonValue& document,
+                                  PerformanceResultVector& results) {
+    std::ifstream file(path);
+    if (!file.good()) {
+        std::cerr << "Could not open report at path '" << path << "'"
+                  << std::endl;
+        return false;
+    }
+
+    try {
+        document = parse_json(file);
+        results = read_performance_results(document);
+    } catch (std::exception const& error) {
+        std::cerr << "Could not read report '" << path << "': " << error.what()
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/// Prints a human readable line for a record
+std::ostream& PerformanceComparison::print_record_(
+        std::ostream& out, ComparisonRecord const& record) {
+    PerformanceResult const& result =
+            record.candidate ? *record.candidate : *record.baseline;
+
+    out << std::left << std::setw(10) << to_string(record.outcome, true)
+        << std::right;
+
+    if (record.baseline && record.candidate && record.baseline->good() &&
+        record.candidate->good()) {
+        out << std::showpos << std::fixed << std::setprecision(1)
+            << std::setw(8) << record.relative_change * 100 << "%"
+            << std::noshowpos << std::setprecision(4) << "  "
+            << central_runtime(*record.baseline) << " ms -> "
+            << central_runtime(*record.candidate) << " ms";
+        out.unsetf(std::ios::floatfield);
+    }
+
+    out << "  " << library::to_string(result.provider) << "  "
+        << result.operation_name << "  " << arguments_string(result) << "\n";
+
+    return out;
+}
+
+/// Writes all records in CSV
+std::ostream& PerformanceComparison::print_csv_(
+        std::ostream& out, ComparisonRecordVector const& records) {
+    out << "Outcome,Provider,OperationKind,Operation,Arguments"
+        << ",BaselineRuntime,BaselineCILower,BaselineCIUpper"
+        << ",CandidateRuntime,CandidateCILower,CandidateCIUpper"
+        << ",RelativeChange\n";
+
+    for (auto const& record : records) {
+        PerformanceResult const& result =
+                record.candidate ? *record.candidate : *record.baseline;
+
+        out << to_string(record.outcome) << ","
+            << library::to_string(result.provider) << ","
+            << library::to_string(result.op_kind) << ","
+            << result.operation_name << "," << arguments_string(result);
+
+        for (PerformanceResult const* side :
+             {record.baseline, record.candidate}) {
+            if (side && side->good()) {
+                out << "," << central_runtime(*side) << ","
+                    << side->runtime_statistics.ci_lower << ","
+                    << side->runtime_statistics.ci_upper;
+            } else {
+                out << std::string(3, ',');
+            }
+        }
+
+        out << "," << record.relative_change << "\n";
+    }
+
+    return out;
+}
+
+/// Compares the reports and returns the process exit code
+int PerformanceComparison::operator()() {
+    if (baseline_path_.empty() || candidate_path_.empty()) {
+        std::cerr << "--compare expects two reports: "
+                     "--compare=baseline.json,candidate.json"
+                  << std::endl;
+        return kExitError;
+    }
+
+    JsonValue baseline_document;
+    JsonValue candidate_document;
+    PerformanceResultVector baseline;
+    PerformanceResultVector candidate;
+
+    if (!read_(baseline_path_, baseline_document, baseline) ||
+        !read_(candidate_path_, candidate_document, candidate)) {
+        return kExitError;
+    }
+
+    // Reports measured on different devices are still compared, but the
+    // user is told that differences may not be caused by the library
+    auto device_name = [](JsonValue const& document) -> std::string {
+        JsonValue const* environment = document.find("environment");
+        JsonValue const* device =
+                environment ? environment->find("device") : nullptr;
+        return device ? device->get_string("name") : std::string();
+    };
+
+    if (device_name(baseline_document) != device_name(candidate_document)) {
+        std::cerr << "Warning: comparing reports of different devices ('"
+                  << device_name(baseline_document) << "' and '"
+                  << device_name(candidate_document) << "')" << std::endl;
+    }
+
+    ComparisonRecordVector records =
+            compare_results(baseline, candidate, threshold_);
+
+    std::map<ComparisonOutcome, int> counts;
+    for (auto const& record : records) {
+        ++counts[record.outcome];
+        if (record.outcome != ComparisonOutcome::kUnchanged) {
+            print_record_(std::cout, record);
+        }
+    }
+
+    std::cout << "\nCompared " << baseline.size() << " baseline and "
+              << candidate.size() << " candidate results:";
+
+    int column_idx = 0;
+    for (auto const& possible : ComparisonOutcome_enumerants) {
+        std::cout << (column_idx++ ? ", " : " ") << counts[possible.enumerant]
+                  << " " << possible.text;
+    }
+    std::cout << std::endl;
+
+    if (!output_path_.empty()) {
+        std::ofstream output_file(output_path_);
+        if (!output_file.good()) {
+            std::cerr << "Could not open output file at path '"
+                      << output_path_ << "'" << std::endl;
+            return kExitError;
+        }
+        print_csv_(output_file, records);
+    }
+
+    if (counts[ComparisonOutcome::kRegressed] ||
+        counts[ComparisonOutcome::kFailed] ||
+        counts[ComparisonOutcome::kMissing]) {
+        return kExitRegression;
+    }
+
+    return kExitSuccess;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
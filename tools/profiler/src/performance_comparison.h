@@ -0,0 +1,156 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Compares two JSON performance reports and classifies the change of
+   each result
+*/
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "cutlass/util/command_line.h"
+
+// CUTLASS Profiler includes
+#include "json.h"
+#include "performance_result.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Outcome of comparing a candidate result with its baseline
+enum class ComparisonOutcome {
+    kUnchanged,  ///< change is within the threshold or the measurement noise
+    kImproved,   ///< candidate is significantly faster
+    kRegressed,  ///< candidate is significantly slower
+    kFailed,     ///< candidate fails where the baseline passed
+    kFixed,      ///< candidate passes where the baseline failed
+    kMissing,    ///< baseline result has no match in the candidate
+    kAdded,      ///< candidate result has no match in the baseline
+    kInvalid
+};
+
+/// Converts a ComparisonOutcome enumerant to a string
+char const* to_string(ComparisonOutcome outcome, bool pretty = false);
+
+/// Result of comparing one pair of matched results
+struct ComparisonRecord {
+    ComparisonOutcome outcome;
+
+    /// Baseline result or nullptr if the result was added
+    PerformanceResult const* baseline;
+
+    /// Candidate result or nullptr if the result is missing
+    PerformanceResult const* candidate;
+
+    /// Relative change of the median runtime (candidate / baseline - 1)
+    double relative_change;
+
+    ComparisonRecord()
+            : outcome(ComparisonOutcome::kInvalid),
+              baseline(nullptr),
+              candidate(nullptr),
+              relative_change(0) {}
+};
+
+using ComparisonRecordVector = std::vector<ComparisonRecord>;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reads the results of a report written by PerformanceReport::print_json_*
+PerformanceResultVector read_performance_results(JsonValue const& document);
+
+/// Returns a string identifying the provider, operation and problem of a
+/// result. Results with equal keys are compared with each other.
+std::string comparison_key(PerformanceResult const& result);
+
+/// Classifies the change between two results of the same key. A runtime
+/// change is only significant if it exceeds `threshold` and the confidence
+/// intervals of both medians do not overlap.
+ComparisonOutcome compare_result(PerformanceResult const& baseline,
+                                 PerformanceResult const& candidate,
+                                 double threshold, double& relative_change);
+
+/// Matches results by key and compares each pair. Records are ordered as the
+/// candidate results followed by baseline results missing in the candidate.
+ComparisonRecordVector compare_results(PerformanceResultVector const& baseline,
+                                       PerformanceResultVector const& candidate,
+                                       double threshold);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Host-only comparison of two JSON reports selected by --compare
+class PerformanceComparison {
+public:
+    /// Process exit codes usable by automated gates
+    static int const kExitSuccess = 0;
+    static int const kExitRegression = 1;
+    static int const kExitError = 2;
+
+private:
+    std::string baseline_path_;
+    std::string candidate_path_;
+
+    /// Path to CSV file listing each comparison
+    std::string output_path_;
+
+    /// Smallest relative change considered significant
+    double threshold_;
+
+public:
+    /// Returns true if the command line requests a comparison
+    static bool enabled(CommandLine const& cmdline);
+
+    explicit PerformanceComparison(CommandLine const& cmdline);
+
+    /// Compares the reports and returns the process exit code
+    int operator()();
+
+private:
+    /// Reads a report, returning false on failure
+    bool read_(std::string const& path, JsonValue& document,
+               PerformanceResultVector& results);
+
+    /// Prints a human readable line for a record
+    std::ostream& print_record_(std::ostream& out,
+                                ComparisonRecord const& record);
+
+    /// Writes all records in CSV
+    std::ostream& print_csv_(std::ostream& out,
+                             ComparisonRecordVector const& records);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,348 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Roofline model relating measured performance to device peaks
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "cutlass/library/util.h"
+
+#include "performance_model.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using library::NumericTypeID;
+using library::OpcodeClassID;
+
+/// Dense per-SM math rates. The first matching row applies.
+MathThroughput const kMathThroughput[] = {
+        // Tensor Cores
+        {70, 72, OpcodeClassID::kTensorOp, NumericTypeID::kF16, 1024},
+        {75, 75, OpcodeClassID::kTensorOp, NumericTypeID::kF16, 1024},
+        {75, 75, OpcodeClassID::kTensorOp, NumericTypeID::kS8, 2048},
+        {75, 75, OpcodeClassID::kTensorOp, NumericTypeID::kU8, 2048},
+        {75, 75, OpcodeClassID::kTensorOp, NumericTypeID::kS4, 4096},
+        {75, 75, OpcodeClassID::kTensorOp, NumericTypeID::kU4, 4096},
+        {75, 75, OpcodeClassID::kTensorOp, NumericTypeID::kB1, 16384},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kF16, 2048},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kBF16, 2048},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kTF32, 1024},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kF64, 128},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kS8, 4096},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kU8, 4096},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kS4, 8192},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kU4, 8192},
+        {80, 80, OpcodeClassID::kTensorOp, NumericTypeID::kB1, 32768},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kF16, 1024},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kBF16, 1024},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kTF32, 512},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kS8, 2048},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kU8, 2048},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kS4, 4096},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kU4, 4096},
+        {86, 89, OpcodeClassID::kTensorOp, NumericTypeID::kB1, 16384},
+
+        // CUDA cores
+        {50, 53, OpcodeClassID::kSimt, NumericTypeID::kF32, 256},
+        {60, 60, OpcodeClassID::kSimt, NumericTypeID::kF32, 128},
+        {61, 62, OpcodeClassID::kSimt, NumericTypeID::kF32, 256},
+        {70, 80, OpcodeClassID::kSimt, NumericTypeID::kF32, 128},
+        {86, 89, OpcodeClassID::kSimt, NumericTypeID::kF32, 256},
+        {60, 60, OpcodeClassID::kSimt, NumericTypeID::kF64, 64},
+        {61, 62, OpcodeClassID::kSimt, NumericTypeID::kF64, 8},
+        {70, 70, OpcodeClassID::kSimt, NumericTypeID::kF64, 64},
+        {75, 75, OpcodeClassID::kSimt, NumericTypeID::kF64, 4},
+        {80, 80, OpcodeClassID::kSimt, NumericTypeID::kF64, 64},
+        {86, 89, OpcodeClassID::kSimt, NumericTypeID::kF64, 4},
+        {53, 53, OpcodeClassID::kSimt, NumericTypeID::kF16, 512},
+        {60, 60, OpcodeClassID::kSimt, NumericTypeID::kF16, 256},
+        {62, 62, OpcodeClassID::kSimt, NumericTypeID::kF16, 512},
+        {70, 89, OpcodeClassID::kSimt, NumericTypeID::kF16, 256},
+        {61, 89, OpcodeClassID::kSimt, NumericTypeID::kS8, 512},
+        {61, 89, OpcodeClassID::kSimt, NumericTypeID::kU8, 512},
+        {50, 89, OpcodeClassID::kSimt, NumericTypeID::kS32, 128}};
+
+/// Maps operand types to the type executed by the math instruction
+NumericTypeID math_element(OpcodeClassID opcode_class, NumericTypeID element,
+                           library::MathOperationID math_operation) {
+    switch (element) {
+        case NumericTypeID::kCF16:
+            return NumericTypeID::kF16;
+        case NumericTypeID::kCF32:
+            element = NumericTypeID::kF32;
+            break;
+        case NumericTypeID::kCF64:
+            return NumericTypeID::kF64;
+        default:
+            break;
+    }
+
+    // Single-precision operands are multiplied by Tensor Cores in a narrower
+    // type
+    if (opcode_class != OpcodeClassID::kSimt &&
+        element == NumericTypeID::kF32) {
+        if (math_operation == library::MathOperationID::kMultiplyAddFastF16) {
+            return NumericTypeID::kF16;
+        }
+        if (math_operation == library::MathOperationID::kMultiplyAddFastBF16) {
+            return NumericTypeID::kBF16;
+        }
+        return NumericTypeID::kTF32;
+    }
+
+    return element;
+}
+
+/// Resident CTAs per SM by compute capability
+int resident_ctas_per_sm(int compute_capability) {
+    switch (compute_capability) {
+        case 75:
+        case 86:
+            return 16;
+        case 89:
+            return 24;
+        default:
+            return 32;
+    }
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+DeviceSpec::DeviceSpec()
+        : compute_capability(0),
+          sm_count(0),
+          clock_ghz(0),
+          memory_bandwidth(0),
+          shared_memory_per_sm(0),
+          max_threads_per_sm(0),
+          max_ctas_per_sm(0) {}
+
+DeviceSpec DeviceSpec::from_properties(cudaDeviceProp const& properties) {
+    DeviceSpec spec;
+
+    spec.name = properties.name;
+    spec.compute_capability = properties.major * 10 + properties.minor;
+    spec.sm_count = properties.multiProcessorCount;
+    spec.clock_ghz = double(properties.clockRate) * 1.0e-6;
+
+    // Memory clock in kHz, two transfers per clock
+    spec.memory_bandwidth = 2.0 * double(properties.memoryClockRate) * 1.0e3 *
+                            double(properties.memoryBusWidth) / 8.0;
+
+    spec.shared_memory_per_sm = int64_t(properties.sharedMemPerMultiprocessor);
+    spec.max_threads_per_sm = properties.maxThreadsPerMultiProcessor;
+    spec.max_ctas_per_sm = resident_ctas_per_sm(spec.compute_capability);
+
+    return spec;
+}
+
+int DeviceSpec::flops_per_clock(library::OpcodeClassID opcode_class,
+                                library::NumericTypeID element,
+                                library::MathOperationID math_operation) const {
+    NumericTypeID math_type =
+            math_element(opcode_class, element, math_operation);
+
+    // Structured sparsity doubles the effective rate of dense Tensor Cores
+    int scale = 1;
+    if (opcode_class == OpcodeClassID::kSparseTensorOp) {
+        scale = 2;
+    }
+    if (opcode_class != OpcodeClassID::kSimt) {
+        opcode_class = OpcodeClassID::kTensorOp;
+    }
+
+    for (MathThroughput const& row : kMathThroughput) {
+        if (compute_capability >= row.minimum_compute_capability &&
+            compute_capability <= row.maximum_compute_capability &&
+            opcode_class == row.opcode_class && math_type == row.element) {
+            return row.flops_per_clock * scale;
+        }
+    }
+
+    return 0;
+}
+
+double DeviceSpec::peak_flops(library::OpcodeClassID opcode_class,
+                              library::NumericTypeID element,
+                              library::MathOperationID math_operation) const {
+    return double(flops_per_clock(opcode_class, element, math_operation)) *
+           double(sm_count) * clock_ghz * 1.0e9;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+PerformanceModel::PerformanceModel()
+        : opcode_class(library::OpcodeClassID::kInvalid),
+          element(library::NumericTypeID::kInvalid),
+          math_operation(library::MathOperationID::kInvalid),
+          tiles(0),
+          threads_per_cta(0),
+          shared_memory_per_cta(0),
+          arithmetic_intensity(0),
+          peak_flops(0),
+          roofline_flops(0),
+          compute_efficiency(0),
+          memory_efficiency(0),
+          roofline_efficiency(0),
+          ctas_per_sm(0),
+          waves(0),
+          wave_efficiency(0),
+          estimated_runtime(0) {}
+
+PerformanceModel::PerformanceModel(
+        library::OperationDescription const& operation_desc,
+        library::NumericTypeID element_A, library::NumericTypeID element_B,
+        int64_t tiles_)
+        : PerformanceModel() {
+    library::TileDescription const& tile_description =
+            operation_desc.tile_description;
+
+    opcode_class = tile_description.math_instruction.opcode_class;
+    element = element_A;
+    math_operation = tile_description.math_instruction.math_operation;
+    tiles = tiles_;
+
+    threads_per_cta = 32 * tile_description.warp_count.m() *
+                      tile_description.warp_count.n() *
+                      tile_description.warp_count.k();
+
+    if (operation_desc.shared_memory_size > 0) {
+        shared_memory_per_cta = operation_desc.shared_memory_size;
+        return;
+    }
+
+    // Each pipeline stage holds one tile of A and one of B
+    int64_t stage_bits =
+            int64_t(tile_description.threadblock_shape.m()) *
+                    tile_description.threadblock_shape.k() *
+                    library::sizeof_bits(element_A) +
+            int64_t(tile_description.threadblock_shape.n()) *
+                    tile_description.threadblock_shape.k() *
+                    library::sizeof_bits(element_B);
+
+    shared_memory_per_cta = std::max(tile_description.threadblock_stages, 1) *
+                            stage_bits / 8;
+}
+
+void PerformanceModel::evaluate(DeviceSpec const& device, int64_t flops,
+                                int64_t bytes, double runtime) {
+    arithmetic_intensity = bytes > 0 ? double(flops) / double(bytes) : 0;
+
+    peak_flops = device.peak_flops(opcode_class, element, math_operation);
+
+    roofline_flops = peak_flops;
+    if (arithmetic_intensity > 0 && device.memory_bandwidth > 0) {
+        double memory_bound = arithmetic_intensity * device.memory_bandwidth;
+        roofline_flops = peak_flops > 0 ? std::min(peak_flops, memory_bound)
+                                        : memory_bound;
+    }
+
+    compute_efficiency = 0;
+    memory_efficiency = 0;
+    roofline_efficiency = 0;
+
+    if (runtime > 0) {
+        double seconds = runtime * 1.0e-3;
+        double achieved_flops = double(flops) / seconds;
+
+        if (peak_flops > 0) {
+            compute_efficiency = achieved_flops / peak_flops;
+        }
+        if (device.memory_bandwidth > 0) {
+            memory_efficiency =
+                    double(bytes) / seconds / device.memory_bandwidth;
+        }
+        if (roofline_flops > 0) {
+            roofline_efficiency = achieved_flops / roofline_flops;
+        }
+    }
+
+    // Wave quantization
+    ctas_per_sm = 0;
+    waves = 0;
+    wave_efficiency = 0;
+
+    if (tiles > 0 && device.sm_count > 0) {
+        ctas_per_sm = std::max(device.max_ctas_per_sm, 1);
+
+        if (threads_per_cta > 0 && device.max_threads_per_sm > 0) {
+            ctas_per_sm = std::min(ctas_per_sm,
+                                   device.max_threads_per_sm / threads_per_cta);
+        }
+        if (shared_memory_per_cta > 0 && device.shared_memory_per_sm > 0) {
+            ctas_per_sm = std::min(
+                    ctas_per_sm, int(device.shared_memory_per_sm /
+                                     shared_memory_per_cta));
+        }
+        ctas_per_sm = std::max(ctas_per_sm, 1);
+
+        int64_t slots = int64_t(device.sm_count) * ctas_per_sm;
+
+        waves = (tiles + slots - 1) / slots;
+        wave_efficiency = double(tiles) / double(waves * slots);
+    }
+
+    // Runtime at the roofline. A compute-bound kernel leaves the slots of a
+    // partial last wave idle, while a memory-bound one still saturates DRAM.
+    estimated_runtime = 0;
+
+    if (flops > 0 && roofline_flops > 0) {
+        estimated_runtime = double(flops) / roofline_flops * 1.0e3;
+
+        if (wave_efficiency > 0 && peak_flops > 0 &&
+            roofline_flops >= peak_flops) {
+            estimated_runtime /= wave_efficiency;
+        }
+    } else if (bytes > 0 && device.memory_bandwidth > 0) {
+        estimated_runtime = double(bytes) / device.memory_bandwidth * 1.0e3;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+int64_t tile_count(int64_t extent, int64_t tile) {
+    if (tile <= 0) {
+        return 0;
+    }
+    return (std::max(extent, int64_t(0)) + tile - 1) / tile;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,210 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Roofline model relating measured performance to device peaks
+
+  Peak math throughput is taken from a table of dense per-SM rates indexed by
+  compute capability, opcode class and operand type, scaled by the SM count
+  and clock rate of the device. Peak memory bandwidth follows from the memory
+  clock and bus width. Wave quantization assumes as many CTAs are resident
+  per SM as fit its shared memory, thread and CTA limits.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <cuda_runtime.h>
+
+// CUTLASS Library includes
+#include "cutlass/library/library.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Dense math throughput of one SM
+struct MathThroughput {
+    /// Range of compute capabilities, inclusive
+    int minimum_compute_capability;
+    int maximum_compute_capability;
+
+    /// Class of math instruction
+    library::OpcodeClassID opcode_class;
+
+    /// Data type of the multiplied operands
+    library::NumericTypeID element;
+
+    /// Flops per clock per SM counting a multiply-add as two flops
+    int flops_per_clock;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Resources and peak rates of a device
+struct DeviceSpec {
+    /// Device name
+    std::string name;
+
+    /// Compute capability (e.g. 70, 75, 80)
+    int compute_capability;
+
+    /// Number of streaming multiprocessors
+    int sm_count;
+
+    /// SM clock rate in GHz
+    double clock_ghz;
+
+    /// Peak DRAM bandwidth in bytes per second
+    double memory_bandwidth;
+
+    /// Shared memory per SM in bytes
+    int64_t shared_memory_per_sm;
+
+    /// Resident threads per SM
+    int max_threads_per_sm;
+
+    /// Resident CTAs per SM
+    int max_ctas_per_sm;
+
+    //
+    // Methods
+    //
+
+    DeviceSpec();
+
+    /// Describes a device from its CUDA properties
+    static DeviceSpec from_properties(cudaDeviceProp const& properties);
+
+    /// Returns the flops per clock per SM of a math instruction, or zero if
+    /// unknown
+    int flops_per_clock(library::OpcodeClassID opcode_class,
+                        library::NumericTypeID element,
+                        library::MathOperationID math_operation =
+                                library::MathOperationID::kMultiplyAdd) const;
+
+    /// Returns the peak math throughput in flops per second, or zero if
+    /// unknown
+    double peak_flops(library::OpcodeClassID opcode_class,
+                      library::NumericTypeID element,
+                      library::MathOperationID math_operation =
+                              library::MathOperationID::kMultiplyAdd) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Relates the measured performance of an operation to the peaks of a device
+struct PerformanceModel {
+    //
+    // Properties of the operation
+    //
+
+    /// Class of math instruction
+    library::OpcodeClassID opcode_class;
+
+    /// Data type of the multiplied operands
+    library::NumericTypeID element;
+
+    /// Math operation of the instruction
+    library::MathOperationID math_operation;
+
+    /// Number of threadblock tiles launched. Zero if unknown.
+    int64_t tiles;
+
+    /// Threads per CTA
+    int threads_per_cta;
+
+    /// Shared memory staging operand tiles per CTA in bytes
+    int64_t shared_memory_per_cta;
+
+    //
+    // Derived by evaluate()
+    //
+
+    /// Flops per byte of memory traffic
+    double arithmetic_intensity;
+
+    /// Peak math throughput in flops per second
+    double peak_flops;
+
+    /// Attainable throughput given the arithmetic intensity
+    double roofline_flops;
+
+    /// Fraction of peak math throughput achieved
+    double compute_efficiency;
+
+    /// Fraction of peak memory bandwidth achieved
+    double memory_efficiency;
+
+    /// Fraction of attainable throughput achieved
+    double roofline_efficiency;
+
+    /// Number of CTAs resident per SM
+    int ctas_per_sm;
+
+    /// Number of waves of CTAs needed to cover all tiles
+    int64_t waves;
+
+    /// Fraction of CTA slots occupied across all waves
+    double wave_efficiency;
+
+    /// Runtime in ms at the roofline, lengthened by the idle CTA slots of the
+    /// last wave when compute bound. Zero if neither peak is known.
+    double estimated_runtime;
+
+    //
+    // Methods
+    //
+
+    PerformanceModel();
+
+    /// Captures the properties of an operation launching the given number of
+    /// tiles. Shared memory is estimated from the tile shape if the operation
+    /// does not report it.
+    PerformanceModel(library::OperationDescription const& operation_desc,
+                     library::NumericTypeID element_A,
+                     library::NumericTypeID element_B, int64_t tiles);
+
+    /// Derives the roofline and wave quantization of a measurement. Runtime
+    /// is in milliseconds; quantities which cannot be derived are zero.
+    void evaluate(DeviceSpec const& device, int64_t flops, int64_t bytes,
+                  double runtime);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Number of tiles of the given extent covering a problem extent
+int64_t tile_count(int64_t extent, int64_t tile);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
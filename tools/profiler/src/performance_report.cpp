@@ -35,10 +35,10 @@
 #include <cstring>
 
 #include "cutlass/library/util.h"
-
-#include "cutlass/library/util.h"
+#include "cutlass/version.h"
 
 #include "performance_report.h"
+#include "json.h"
 #include "debug.h"
 namespace cutlass {
 namespace profiler {
@@ -69,8 +69,14 @@ PerformanceReport::PerformanceReport(
         : options_(options),
           argument_names_(argument_names),
           problem_index_(0),
+          json_result_count_(0),
+          result_count_(0),
+          estimated_runtime_(0),
+          peak_workspace_bytes_(0),
+          oversized_count_(0),
           good_(true),
-          op_kind_(op_kind) {
+          op_kind_(op_kind),
+          device_spec_(DeviceSpec::from_properties(options.device.properties)) {
     // Strip '.csv' if present
     std::string base_path = options_.report.output_path;
     base_path = base_path.substr(0, base_path.rfind(".csv"));
@@ -81,6 +87,10 @@ PerformanceReport::PerformanceReport(
     base_path = base_path.substr(0, base_path.rfind(".junit"));
     op_junit_file_name_ = base_path + "." + to_string(op_kind_) + ".junit.xml";
 
+    base_path = options_.report.json_output_path;
+    base_path = base_path.substr(0, base_path.rfind(".json"));
+    op_json_file_name_ = base_path + "." + to_string(op_kind_) + ".json";
+
     //
     // Open output file for operation of PerformanceReport::op_kind
     //
@@ -124,6 +134,19 @@ PerformanceReport::PerformanceReport(
 
         print_junit_header_(junit_output_file_);
     }
+
+    if (!options_.report.json_output_path.empty()) {
+        json_output_file_.open(op_json_file_name_);
+
+        if (!json_output_file_.good()) {
+            std::cerr << "Could not open JSON output file at path '"
+                      << options_.report.json_output_path << "'" << std::endl;
+
+            good_ = false;
+        }
+
+        print_json_header_(json_output_file_);
+    }
 }
 
 void PerformanceReport::next_problem() {
@@ -133,6 +156,25 @@ void PerformanceReport::next_problem() {
 void PerformanceReport::append_result(PerformanceResult result) {
     result.problem_index = problem_index_;
 
+    result.model.evaluate(device_spec_, result.flops, result.bytes,
+                          result.runtime);
+
+    // Each run verifies once, warms up and then profiles
+    int launches = options_.profiling.warmup_iterations +
+                   options_.profiling.iterations +
+                   (options_.verification.enabled ? 1 : 0);
+
+    ++result_count_;
+    estimated_runtime_ += launches * result.model.estimated_runtime;
+    peak_workspace_bytes_ =
+            std::max(peak_workspace_bytes_, result.workspace_bytes);
+
+    if (options_.device.properties.totalGlobalMem &&
+        result.workspace_bytes >
+                int64_t(options_.device.properties.totalGlobalMem)) {
+        ++oversized_count_;
+    }
+
     if (options_.report.verbose) {
         std::cout << "\n";
         print_result_pretty_(std::cout, result) << std::flush;
@@ -142,6 +184,10 @@ void PerformanceReport::append_result(PerformanceResult result) {
         print_junit_result_(junit_output_file_, result);
     }
 
+    if (json_output_file_.is_open()) {
+        print_result_json_(json_output_file_, result);
+    }
+
     if (output_file_.is_open()) {
         print_result_csv_(output_file_, result) << std::endl;
     } else {
@@ -161,6 +207,10 @@ void PerformanceReport::append_results(PerformanceResultVector const& results) {
 }
 
 PerformanceReport::~PerformanceReport() {
+    if (options_.execution_mode == ExecutionMode::kDryRun && result_count_) {
+        print_dry_run_summary_(std::cout);
+    }
+
     //
     // Output results to stdout if they were not written to a file already.
     //
@@ -189,6 +239,13 @@ PerformanceReport::~PerformanceReport() {
         std::cout << "\nWrote jUnit results to '" << op_junit_file_name_ << "'"
                   << std::endl;
     }
+
+    if (json_output_file_.is_open()) {
+        print_json_footer_(json_output_file_);
+        json_output_file_.close();
+        std::cout << "\nWrote JSON results to '" << op_json_file_name_ << "'"
+                  << std::endl;
+    }
 }
 
 static const char* disposition_status_color(Disposition disposition) {
@@ -205,6 +262,28 @@ static const char* disposition_status_color(Disposition disposition) {
     return SHELL_COLOR_END();
 }
 
+/// Prints the number, estimated runtime and footprint of planned runs
+std::ostream& PerformanceReport::print_dry_run_summary_(std::ostream& out) {
+    out << "\n=============================\n"
+        << "  Dry run of " << to_string(op_kind_) << " on " << device_spec_.name
+        << (options_.device.emulated ? " (emulated)" : "") << "\n\n"
+        << "    Planned runs: " << result_count_ << "  (" << problem_index_
+        << " problems)\n"
+        << "   Est. run time: " << estimated_runtime_
+        << "  ms of device time\n"
+        << "     Peak memory: "
+        << double(peak_workspace_bytes_) / double(1 << 20) << "  MiB\n";
+
+    if (oversized_count_) {
+        out << "        Oversize: " << oversized_count_
+            << " runs exceed the "
+            << (options_.device.properties.totalGlobalMem >> 20)
+            << " MiB of device memory\n";
+    }
+
+    return out;
+}
+
 /// Prints the result in human readable form
 std::ostream& PerformanceReport::print_result_pretty_(
         std::ostream& out, PerformanceResult const& result,
@@ -271,15 +350,60 @@ std::ostream& PerformanceReport::print_result_pretty_(
     out << "\n\n";
 
     out << "           Bytes: " << result.bytes << "  bytes\n"
-        << "           FLOPs: " << result.flops << "  flops\n\n";
+        << "           FLOPs: " << result.flops << "  flops\n";
+
+    if (result.workspace_bytes > 0) {
+        out << "       Workspace: " << result.workspace_bytes << "  bytes\n";
+    }
+
+    out << "\n";
 
     if (result.good()) {
-        out << "         Runtime: " << result.runtime << "  ms\n"
-            << "          Memory: " << result.gbytes_per_sec() << " GiB/s\n"
+        out << "         Runtime: " << result.runtime << "  ms\n";
+
+        RuntimeStatistics const& statistics = result.runtime_statistics;
+        if (statistics.good()) {
+            out << "          Median: " << statistics.median << "  ms  ("
+                << int(statistics.confidence * 100 + 0.5) << "% CI "
+                << statistics.ci_lower << " - " << statistics.ci_upper
+                << ")\n"
+                << "     Min/P90/P99: " << statistics.min << " / "
+                << statistics.p90 << " / " << statistics.p99 << "  ms\n"
+                << "          Stddev: " << statistics.stddev << "  ms  ("
+                << statistics.samples << " samples)\n";
+        }
+
+        out << "          Memory: " << result.gbytes_per_sec() << " GiB/s\n"
             << "\n            Math: " << result.gflops_per_sec()
             << " GFLOP/s\n";
     }
 
+    PerformanceModel const& model = result.model;
+
+    if (model.peak_flops > 0) {
+        out << "\n       Intensity: " << model.arithmetic_intensity
+            << "  flops/byte\n"
+            << "            Peak: " << model.peak_flops / 1.0e9
+            << " GFLOP/s\n";
+
+        if (result.good()) {
+            out << "      Efficiency: " << model.compute_efficiency * 100
+                << "% of peak math, " << model.memory_efficiency * 100
+                << "% of peak memory, " << model.roofline_efficiency * 100
+                << "% of roofline\n";
+        }
+    }
+
+    if (model.waves > 0) {
+        out << "           Waves: " << model.waves << "  (" << model.tiles
+            << " tiles, " << model.ctas_per_sm << " CTAs/SM, "
+            << model.wave_efficiency * 100 << "% efficient)\n";
+    }
+
+    if (model.estimated_runtime > 0) {
+        out << "       Estimated: " << model.estimated_runtime << "  ms\n";
+    }
+
     return out;
 }
 
@@ -303,7 +427,25 @@ std::ostream& PerformanceReport::print_csv_header_(std::ostream& out) {
         << ",Flops"
         << ",Runtime"
         << ",GB/s"
-        << ",GFLOPs";
+        << ",GFLOPs"
+        << ",Samples"
+        << ",RuntimeMedian"
+        << ",RuntimeMin"
+        << ",RuntimeP90"
+        << ",RuntimeP99"
+        << ",RuntimeStddev"
+        << ",RuntimeCILower"
+        << ",RuntimeCIUpper"
+        << ",ArithmeticIntensity"
+        << ",PeakGFLOPs"
+        << ",ComputeEfficiency"
+        << ",MemoryEfficiency"
+        << ",RooflineEfficiency"
+        << ",Waves"
+        << ",WaveEfficiency"
+        << ",WorkspaceBytes"
+        << ",EstimatedRuntime"
+        << ",CacheMode";
 
     return out;
 }
@@ -335,6 +477,214 @@ std::ostream& PerformanceReport::print_result_csv_(
         out << std::string(2, ',');
     }
 
+    RuntimeStatistics const& statistics = result.runtime_statistics;
+
+    out << "," << statistics.samples;
+
+    if (statistics.good()) {
+        out << "," << statistics.median << "," << statistics.min << ","
+            << statistics.p90 << "," << statistics.p99 << ","
+            << statistics.stddev << "," << statistics.ci_lower << ","
+            << statistics.ci_upper;
+    } else {
+        out << std::string(7, ',');
+    }
+
+    PerformanceModel const& model = result.model;
+
+    out << "," << model.arithmetic_intensity;
+
+    if (model.peak_flops > 0) {
+        out << "," << model.peak_flops / 1.0e9;
+    } else {
+        out << ",";
+    }
+
+    if (model.peak_flops > 0 && result.good()) {
+        out << "," << model.compute_efficiency << ","
+            << model.memory_efficiency << "," << model.roofline_efficiency;
+    } else {
+        out << std::string(3, ',');
+    }
+
+    if (model.waves > 0) {
+        out << "," << model.waves << "," << model.wave_efficiency;
+    } else {
+        out << std::string(2, ',');
+    }
+
+    out << "," << result.workspace_bytes;
+
+    if (model.estimated_runtime > 0) {
+        out << "," << model.estimated_runtime;
+    } else {
+        out << ",";
+    }
+
+    out << "," << to_string(options_.profiling.cache_mode);
+
+    return out;
+}
+
+std::ostream& PerformanceReport::print_json_header_(std::ostream& out) {
+    cudaDeviceProp const& properties = options_.device.properties;
+
+    out << std::setprecision(10) << "{\n"
+        << "  \"version\": 1,\n"
+        << "  \"operation_kind\": " << json_string(to_string(op_kind_))
+        << ",\n"
+        << "  \"environment\": {\n"
+        << "    \"cutlass_version\": "
+        << json_string(cutlass::getVersionString()) << ",\n"
+        << "    \"git_revision\": " << json_string(cutlass::getGitRevision())
+        << ",\n"
+        << "    \"device\": {\n"
+        << "      \"name\": " << json_string(properties.name) << ",\n"
+        << "      \"compute_capability\": "
+        << options_.device.compute_capability() << ",\n"
+        << "      \"multiprocessor_count\": "
+        << properties.multiProcessorCount << ",\n"
+        << "      \"clock_rate_khz\": " << properties.clockRate << ",\n"
+        << "      \"memory_clock_rate_khz\": " << properties.memoryClockRate
+        << ",\n"
+        << "      \"memory_bus_width\": " << properties.memoryBusWidth
+        << ",\n"
+        << "      \"l2_cache_size\": " << properties.l2CacheSize << "\n"
+        << "    },\n"
+        << "    \"profiling\": {\n"
+        << "      \"cache_mode\": "
+        << json_string(to_string(options_.profiling.cache_mode)) << ",\n"
+        << "      \"warmup_iterations\": "
+        << options_.profiling.warmup_iterations << ",\n"
+        << "      \"iterations\": " << options_.profiling.iterations << ",\n"
+        << "      \"iterations_per_sample\": "
+        << options_.profiling.iterations_per_sample << ",\n"
+        << "      \"confidence\": " << options_.profiling.confidence << ",\n"
+        << "      \"target_ci_width\": " << options_.profiling.target_ci_width
+        << "\n"
+        << "    },\n"
+        << "    \"tags\": {";
+
+    int tag_idx = 0;
+    for (auto const& tag : options_.report.pivot_tags) {
+        out << (tag_idx++ ? ", " : "") << json_string(tag.first) << ": "
+            << json_string(tag.second);
+    }
+
+    out << "}\n"
+        << "  },\n"
+        << "  \"results\": [";
+
+    return out;
+}
+
+std::ostream& PerformanceReport::print_result_json_(
+        std::ostream& out, PerformanceResult const& result) {
+    out << (json_result_count_++ ? ",\n" : "\n") << "    {\n"
+        << "      \"problem_index\": " << result.problem_index << ",\n"
+        << "      \"provider\": " << json_string(to_string(result.provider))
+        << ",\n"
+        << "      \"operation_kind\": "
+        << json_string(to_string(result.op_kind)) << ",\n"
+        << "      \"operation\": " << json_string(result.operation_name)
+        << ",\n"
+        << "      \"status\": "
+        << json_string(library::to_string(result.status)) << ",\n"
+        << "      \"disposition\": "
+        << json_string(to_string(result.disposition)) << ",\n"
+        << "      \"verification\": {";
+
+    int column_idx = 0;
+    for (auto const& m : result.verification_map) {
+        out << (column_idx++ ? ", " : "") << json_string(to_string(m.first))
+            << ": " << json_string(to_string(m.second));
+    }
+
+    out << "},\n"
+        << "      \"arguments\": {";
+
+    column_idx = 0;
+    for (auto const& arg : result.arguments) {
+        out << (column_idx++ ? ", " : "") << json_string(arg.first) << ": "
+            << json_string(arg.second);
+    }
+
+    out << "},\n"
+        << "      \"bytes\": " << result.bytes << ",\n"
+        << "      \"flops\": " << result.flops << ",\n"
+        << "      \"workspace_bytes\": " << result.workspace_bytes << ",\n"
+        << "      \"runtime\": " << result.runtime;
+
+    if (result.good()) {
+        out << ",\n"
+            << "      \"gbytes_per_sec\": " << result.gbytes_per_sec() << ",\n"
+            << "      \"gflops_per_sec\": " << result.gflops_per_sec();
+    }
+
+    RuntimeStatistics const& statistics = result.runtime_statistics;
+
+    if (statistics.good()) {
+        out << ",\n"
+            << "      \"statistics\": {\n"
+            << "        \"samples\": " << statistics.samples << ",\n"
+            << "        \"mean\": " << statistics.mean << ",\n"
+            << "        \"min\": " << statistics.min << ",\n"
+            << "        \"median\": " << statistics.median << ",\n"
+            << "        \"p90\": " << statistics.p90 << ",\n"
+            << "        \"p99\": " << statistics.p99 << ",\n"
+            << "        \"stddev\": " << statistics.stddev << ",\n"
+            << "        \"confidence\": " << statistics.confidence << ",\n"
+            << "        \"ci_lower\": " << statistics.ci_lower << ",\n"
+            << "        \"ci_upper\": " << statistics.ci_upper << "\n"
+            << "      }";
+    }
+
+    PerformanceModel const& model = result.model;
+
+    out << ",\n"
+        << "      \"model\": {\n"
+        << "        \"arithmetic_intensity\": " << model.arithmetic_intensity;
+
+    if (model.peak_flops > 0) {
+        out << ",\n"
+            << "        \"peak_gflops_per_sec\": " << model.peak_flops / 1.0e9
+            << ",\n"
+            << "        \"roofline_gflops_per_sec\": "
+            << model.roofline_flops / 1.0e9;
+
+        if (result.good()) {
+            out << ",\n"
+                << "        \"compute_efficiency\": "
+                << model.compute_efficiency << ",\n"
+                << "        \"memory_efficiency\": " << model.memory_efficiency
+                << ",\n"
+                << "        \"roofline_efficiency\": "
+                << model.roofline_efficiency;
+        }
+    }
+
+    if (model.waves > 0) {
+        out << ",\n"
+            << "        \"tiles\": " << model.tiles << ",\n"
+            << "        \"ctas_per_sm\": " << model.ctas_per_sm << ",\n"
+            << "        \"waves\": " << model.waves << ",\n"
+            << "        \"wave_efficiency\": " << model.wave_efficiency;
+    }
+
+    if (model.estimated_runtime > 0) {
+        out << ",\n"
+            << "        \"estimated_runtime\": " << model.estimated_runtime;
+    }
+
+    out << "\n      }";
+
+    out << "\n    }";
+
+    return out;
+}
+
+std::ostream& PerformanceReport::print_json_footer_(std::ostream& out) {
+    out << (json_result_count_ ? "\n  ]\n" : "]\n") << "}" << std::endl;
     return out;
 }
 
@@ -37,6 +37,7 @@
 #include "options.h"
 #include "enumerated_types.h"
 #include "performance_result.h"
+#include "performance_model.h"
 
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
@@ -54,6 +55,9 @@ private:
     /// Operation kind
     library::OperationKind op_kind_;
 
+    /// Peak rates of the device against which results are modeled
+    DeviceSpec device_spec_;
+
     /// Operation file name containing performance report of op_kind
     std::string op_file_name_;
 
@@ -66,6 +70,15 @@ private:
     /// Output file containing junit results
     std::ofstream junit_output_file_;
 
+    /// Operation file name containing JSON performance report of op_kind
+    std::string op_json_file_name_;
+
+    /// Output file containing JSON results
+    std::ofstream json_output_file_;
+
+    /// Number of results written to the JSON output file
+    size_t json_result_count_;
+
     /// Flag indicating the performance report is valid
     bool good_;
 
@@ -78,6 +91,18 @@ private:
     /// Collection of all results
     PerformanceResultVector concatenated_results_;
 
+    /// Number of results appended, which a dry run plans to profile
+    size_t result_count_;
+
+    /// Estimated device time in ms of profiling every result
+    double estimated_runtime_;
+
+    /// Largest device memory footprint of any result in bytes
+    int64_t peak_workspace_bytes_;
+
+    /// Number of results whose footprint exceeds device memory
+    size_t oversized_count_;
+
 public:
     PerformanceReport(Options const& options,
                       std::vector<std::string> const& argument_names,
@@ -109,6 +134,20 @@ public:
 
     /// @}
 
+    /// @defgroup JSON Result Generation
+    /// Functions related to generation of the JSON results
+    /// @{
+
+    std::ostream& print_json_header_(std::ostream& out);
+    std::ostream& print_result_json_(std::ostream& out,
+                                     PerformanceResult const& result);
+    std::ostream& print_json_footer_(std::ostream& out);
+
+    /// @}
+
+    /// Prints the number, estimated runtime and footprint of planned runs
+    std::ostream& print_dry_run_summary_(std::ostream& out);
+
     /// Prints the result in human readable form
     std::ostream& print_result_pretty_(std::ostream& out,
                                        PerformanceResult const& result,
@@ -36,6 +36,8 @@
 
 // CUTLASS Profiler includes
 #include "enumerated_types.h"
+#include "performance_model.h"
+#include "runtime_statistics.h"
 
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
@@ -78,9 +80,18 @@ struct PerformanceResult {
     /// Number of DL flops performed by the math function
     int64_t flops;
 
+    /// Device memory occupied by the tensors and workspace of the problem
+    int64_t workspace_bytes;
+
     /// Average runtime in ms
     double runtime;
 
+    /// Distribution of runtime samples in ms
+    RuntimeStatistics runtime_statistics;
+
+    /// Roofline and wave quantization of the measurement
+    PerformanceModel model;
+
     //
     // Members
     //
@@ -94,6 +105,7 @@ struct PerformanceResult {
               status(Status::kInvalid),
               bytes(0),
               flops(0),
+              workspace_bytes(0),
               runtime(0) {}
 
     /// Returns true if the runtime is valid
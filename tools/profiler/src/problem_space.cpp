@@ -28,6 +28,7 @@
    \brief
 */
 
+#include <algorithm>
 #include <string>
 #include <stdexcept>
 #include <sstream>
@@ -386,6 +387,38 @@ ProblemSpace::Iterator::Iterator(ProblemSpace const& problem_space) {
     }
 }
 
+ProblemSpace::Iterator::Iterator(ProblemSpace const& problem_space,
+                                 std::vector<size_t> const& indices) {
+    if (indices.size() != problem_space.arguments.size()) {
+        throw std::invalid_argument(
+                "Number of indices does not match the problem space rank");
+    }
+
+    for (size_t idx = 0; idx < indices.size(); ++idx) {
+        KernelArgument const* argument = problem_space.arguments[idx].get();
+
+        construct_(argument);
+
+        std::unique_ptr<KernelArgument::ValueIterator> end = argument->end();
+
+        // Null arguments consist of a single value which may compare equal
+        // to end()
+        auto at_end = [&]() {
+            return !iterators.back()->null_argument &&
+                   *iterators.back() == *end;
+        };
+
+        for (size_t step = 0; step < indices[idx] && !at_end(); ++step) {
+            ++(*iterators.back());
+        }
+
+        if (at_end()) {
+            throw std::out_of_range("Index exceeds the range of argument '" +
+                                    argument->qualified_name() + "'");
+        }
+    }
+}
+
 ProblemSpace::Iterator::Iterator(Iterator&& it) {
     iterators = std::move(it.iterators);
 }
@@ -491,6 +524,31 @@ ProblemSpace::ProblemSpace(ArgumentDescriptionVector const& schema,
     }
 }
 
+/// Returns the number of values in each argument's range
+std::vector<size_t> ProblemSpace::extents() const {
+    std::vector<size_t> result;
+
+    for (auto const& arg_ptr : arguments) {
+        std::unique_ptr<KernelArgument::ValueIterator> it = arg_ptr->begin();
+        std::unique_ptr<KernelArgument::ValueIterator> end = arg_ptr->end();
+
+        size_t count = 0;
+        for (; *it != *end; ++(*it)) {
+            ++count;
+        }
+
+        result.push_back(std::max(count, size_t(1)));
+    }
+
+    return result;
+}
+
+/// Returns the point at the given position along each argument's range
+ProblemSpace::Problem ProblemSpace::at(
+        std::vector<size_t> const& indices) const {
+    return Iterator(*this, indices).at();
+}
+
 /// Returns the index of an argument by name
 size_t ProblemSpace::argument_index(char const* name) const {
     return argument_index_map.at(name);
@@ -1161,6 +1219,82 @@ bool iterator_algorithm_satisfies(
     return false;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns true if a conv type satisfies the value
+bool conv_type_satisfies(
+        library::ConvType const& conv_type,
+        EnumeratedTypeArgument::EnumeratedTypeValue const* value_ptr) {
+    if (value_ptr->not_null) {
+        library::ConvType conv_type_cmd_line =
+                library::from_string<library::ConvType>(value_ptr->element);
+
+        if (conv_type_cmd_line != library::ConvType::kInvalid &&
+            conv_type_cmd_line != conv_type) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Returns true if a conv type satisfies the value
+bool conv_type_satisfies(library::ConvType const& conv_type, char const* name,
+                         ProblemSpace const& problem_space,
+                         ProblemSpace::Problem const& problem) {
+    size_t idx = problem_space.argument_index(name);
+    KernelArgument::Value const* value_ptr = problem.at(idx).get();
+
+    if (value_ptr->argument->description->type == ArgumentTypeID::kEnumerated) {
+        return conv_type_satisfies(
+                conv_type,
+                static_cast<EnumeratedTypeArgument::EnumeratedTypeValue const*>(
+                        value_ptr));
+    } else {
+        throw std::runtime_error("Kernel argument mismatch");
+    }
+
+    return false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns true if an epilogue kind satisfies the value
+bool epilogue_satisfies(
+        library::EpilogueKind const& epilogue,
+        EnumeratedTypeArgument::EnumeratedTypeValue const* value_ptr) {
+    if (value_ptr->not_null) {
+        library::EpilogueKind epilogue_cmd_line =
+                library::from_string<library::EpilogueKind>(value_ptr->element);
+
+        if (epilogue_cmd_line != library::EpilogueKind::kInvalid &&
+            epilogue_cmd_line != epilogue) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Returns true if an epilogue kind satisfies the value
+bool epilogue_satisfies(library::EpilogueKind const& epilogue,
+                        char const* name, ProblemSpace const& problem_space,
+                        ProblemSpace::Problem const& problem) {
+    size_t idx = problem_space.argument_index(name);
+    KernelArgument::Value const* value_ptr = problem.at(idx).get();
+
+    if (value_ptr->argument->description->type == ArgumentTypeID::kEnumerated) {
+        return epilogue_satisfies(
+                epilogue,
+                static_cast<EnumeratedTypeArgument::EnumeratedTypeValue const*>(
+                        value_ptr));
+    } else {
+        throw std::runtime_error("Kernel argument mismatch");
+    }
+
+    return false;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 }  // namespace profiler
 }  // namespace cutlass
@@ -718,6 +718,12 @@ public:
 
         explicit Iterator();
         Iterator(ProblemSpace const& problem_space);
+
+        /// Constructs an iterator pointing to the point whose position along
+        /// each argument's range is given by indices
+        Iterator(ProblemSpace const& problem_space,
+                 std::vector<size_t> const& indices);
+
         Iterator(Iterator&& it);
 
         // Rule of three
@@ -789,6 +795,14 @@ public:
     /// Returns the number of dimensions of the problem space
     size_t rank() const { return arguments.size(); }
 
+    /// Returns the number of values in each argument's range. Null arguments
+    /// count as a single value.
+    std::vector<size_t> extents() const;
+
+    /// Returns the point whose position along each argument's range is given
+    /// by indices
+    Problem at(std::vector<size_t> const& indices) const;
+
 private:
     /// Helper for recursively cloning
     void clone_(KernelArgumentVector& kernel_args,
@@ -943,6 +957,26 @@ bool iterator_algorithm_satisfies(
         char const* name, ProblemSpace const& problem_space,
         ProblemSpace::Problem const& problem);
 
+/// Returns true if a conv type satisfies the value
+bool conv_type_satisfies(
+        library::ConvType const& conv_type,
+        EnumeratedTypeArgument::EnumeratedTypeValue const* value_ptr);
+
+/// Returns true if a conv type satisfies the value
+bool conv_type_satisfies(library::ConvType const& conv_type, char const* name,
+                         ProblemSpace const& problem_space,
+                         ProblemSpace::Problem const& problem);
+
+/// Returns true if an epilogue kind satisfies the value
+bool epilogue_satisfies(
+        library::EpilogueKind const& epilogue,
+        EnumeratedTypeArgument::EnumeratedTypeValue const* value_ptr);
+
+/// Returns true if an epilogue kind satisfies the value
+bool epilogue_satisfies(library::EpilogueKind const& epilogue,
+                        char const* name, ProblemSpace const& problem_space,
+                        ProblemSpace::Problem const& problem);
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 }  // namespace profiler
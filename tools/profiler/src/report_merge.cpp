@@ -0,0 +1,405 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Combines the reports written by the shards of a distributed sweep
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "cutlass/library/util.h"
+
+#include "report_merge.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Identity and sort order of one result
+struct MergeKey {
+    long long problem_index;
+    std::string operation;
+
+    /// Providers are ordered as the profiler reports them, CUTLASS first
+    library::Provider provider;
+    std::string provider_name;
+
+    /// Identifies the result. Vendor libraries are timed once per problem
+    /// under the name of whichever CUTLASS operation came first, which may
+    /// differ between shards, so their operation name is not part of it.
+    std::string identity;
+
+    bool operator<(MergeKey const& rhs) const {
+        if (problem_index != rhs.problem_index) {
+            return problem_index < rhs.problem_index;
+        }
+        if (operation != rhs.operation) {
+            return operation < rhs.operation;
+        }
+        if (provider != rhs.provider) {
+            return int(provider) < int(rhs.provider);
+        }
+        return provider_name < rhs.provider_name;
+    }
+};
+
+MergeKey make_key(long long problem_index, std::string const& provider_name,
+                  std::string const& operation, std::string const& arguments) {
+    MergeKey key;
+    key.problem_index = problem_index;
+    key.operation = operation;
+
+    // CSV reports name providers in their pretty form, JSON reports do not
+    key.provider = library::from_string<library::Provider>(provider_name);
+    key.provider_name = key.provider == library::Provider::kInvalid
+                                ? provider_name
+                                : std::string(library::to_string(key.provider));
+
+    std::stringstream ss;
+    ss << problem_index << "|" << key.provider_name << "|" << arguments;
+    if (key.provider == library::Provider::kCUTLASS) {
+        ss << "|" << operation;
+    }
+    key.identity = ss.str();
+
+    return key;
+}
+
+/// Keeps the last occurrence of each identity and sorts the survivors
+template <typename T>
+std::vector<T> deduplicate(std::vector<std::pair<MergeKey, T>>& entries) {
+    std::map<std::string, size_t> last;
+    for (size_t idx = 0; idx < entries.size(); ++idx) {
+        last[entries[idx].first.identity] = idx;
+    }
+
+    std::vector<size_t> order;
+    for (auto const& entry : last) {
+        order.push_back(entry.second);
+    }
+
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (entries[a].first < entries[b].first) {
+            return true;
+        }
+        if (entries[b].first < entries[a].first) {
+            return false;
+        }
+        return a < b;
+    });
+
+    std::vector<T> merged;
+    for (size_t idx : order) {
+        merged.push_back(entries[idx].second);
+    }
+
+    return merged;
+}
+
+std::vector<std::string> split_csv_line(std::string const& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+
+    while (std::getline(ss, field, ',')) {
+        fields.push_back(field);
+    }
+
+    // A trailing empty column is not produced by getline
+    if (!line.empty() && line.back() == ',') {
+        fields.push_back(std::string());
+    }
+
+    return fields;
+}
+
+size_t find_column(std::vector<std::string> const& header,
+                   std::string const& name) {
+    auto it = std::find(header.begin(), header.end(), name);
+    if (it == header.end()) {
+        throw std::runtime_error("CSV report has no column '" + name + "'");
+    }
+    return size_t(it - header.begin());
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reads a CSV report. Throws std::runtime_error on malformed input.
+CsvReport read_csv_report(std::istream& in) {
+    CsvReport report;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        std::vector<std::string> fields = split_csv_line(line);
+
+        if (report.header.empty()) {
+            report.header = fields;
+        } else if (fields.size() != report.header.size()) {
+            std::stringstream ss;
+            ss << "CSV row " << report.rows.size() + 1 << " has "
+               << fields.size() << " columns, expected "
+               << report.header.size();
+            throw std::runtime_error(ss.str());
+        } else {
+            report.rows.push_back(fields);
+        }
+    }
+
+    if (report.header.empty()) {
+        throw std::runtime_error("CSV report is empty");
+    }
+
+    return report;
+}
+
+/// Writes a CSV report
+std::ostream& print_csv_report(std::ostream& out, CsvReport const& report) {
+    auto print_line = [&](std::vector<std::string> const& fields) {
+        for (size_t idx = 0; idx < fields.size(); ++idx) {
+            out << (idx ? "," : "") << fields[idx];
+        }
+        out << "\n";
+    };
+
+    print_line(report.header);
+
+    for (auto const& row : report.rows) {
+        print_line(row);
+    }
+
+    return out;
+}
+
+/// Merges CSV reports of the same columns
+CsvReport merge_csv_reports(std::vector<CsvReport> const& reports) {
+    CsvReport merged;
+
+    if (reports.empty()) {
+        return merged;
+    }
+
+    merged.header = reports.front().header;
+
+    size_t problem_col = find_column(merged.header, "Problem");
+    size_t provider_col = find_column(merged.header, "Provider");
+    size_t operation_col = find_column(merged.header, "Operation");
+
+    // Problem arguments are the columns between Status and Bytes
+    size_t arguments_begin = find_column(merged.header, "Status") + 1;
+    size_t arguments_end = find_column(merged.header, "Bytes");
+
+    std::vector<std::pair<MergeKey, std::vector<std::string>>> entries;
+
+    for (auto const& report : reports) {
+        if (report.header != merged.header) {
+            throw std::runtime_error(
+                    "CSV reports have different columns and cannot be merged");
+        }
+
+        for (auto const& row : report.rows) {
+            std::string arguments;
+            for (size_t col = arguments_begin; col < arguments_end; ++col) {
+                arguments += merged.header[col] + "=" + row[col] + " ";
+            }
+
+            entries.push_back(std::make_pair(
+                    make_key(std::atoll(row[problem_col].c_str()),
+                             row[provider_col], row[operation_col],
+                             arguments),
+                    row));
+        }
+    }
+
+    merged.rows = deduplicate(entries);
+
+    return merged;
+}
+
+/// Merges JSON reports of the same operation kind
+JsonValue merge_json_reports(std::vector<JsonValue> const& reports) {
+    if (reports.empty()) {
+        return JsonValue();
+    }
+
+    JsonValue merged = reports.front();
+    std::string op_kind = merged.get_string("operation_kind");
+
+    std::vector<std::pair<MergeKey, JsonValue>> entries;
+
+    for (auto const& report : reports) {
+        if (report.get_string("operation_kind") != op_kind) {
+            throw std::runtime_error(
+                    "JSON reports of operation kinds '" + op_kind + "' and '" +
+                    report.get_string("operation_kind") +
+                    "' cannot be merged");
+        }
+
+        JsonValue const* results = report.find("results");
+        if (!results) {
+            continue;
+        }
+
+        for (auto const& result : results->array) {
+            std::string arguments;
+            if (JsonValue const* args = result.find("arguments")) {
+                for (auto const& arg : args->object) {
+                    arguments += arg.first + "=" + arg.second.string + " ";
+                }
+            }
+
+            entries.push_back(std::make_pair(
+                    make_key((long long)result.get_number("problem_index"),
+                             result.get_string("provider"),
+                             result.get_string("operation"), arguments),
+                    result));
+        }
+    }
+
+    JsonValue results;
+    results.kind = JsonValue::Kind::kArray;
+    results.array = deduplicate(entries);
+
+    bool replaced = false;
+    for (auto& member : merged.object) {
+        if (member.first == "results") {
+            member.second = results;
+            replaced = true;
+        }
+    }
+
+    if (!replaced) {
+        merged.object.push_back(std::make_pair("results", results));
+    }
+
+    return merged;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns true if the command line requests a merge
+bool ReportMerge::enabled(CommandLine const& cmdline) {
+    return cmdline.check_cmd_line_flag("merge");
+}
+
+ReportMerge::ReportMerge(CommandLine const& cmdline) {
+    cmdline.get_cmd_line_arguments("merge", input_paths_);
+    cmdline.get_cmd_line_argument("merge-output", output_path_);
+}
+
+/// Merges the reports and returns the process exit code
+int ReportMerge::operator()() {
+    if (input_paths_.empty()) {
+        std::cerr << "--merge expects a list of reports: "
+                     "--merge=shard0.csv,shard1.csv"
+                  << std::endl;
+        return kExitError;
+    }
+
+    auto is_json = [](std::string const& path) {
+        return path.size() >= 5 && path.substr(path.size() - 5) == ".json";
+    };
+
+    bool json = is_json(input_paths_.front());
+
+    std::vector<CsvReport> csv_reports;
+    std::vector<JsonValue> json_reports;
+
+    for (auto const& path : input_paths_) {
+        if (is_json(path) != json) {
+            std::cerr << "Cannot merge CSV and JSON reports" << std::endl;
+            return kExitError;
+        }
+
+        std::ifstream file(path);
+        if (!file.good()) {
+            std::cerr << "Could not open report at path '" << path << "'"
+                      << std::endl;
+            return kExitError;
+        }
+
+        try {
+            if (json) {
+                json_reports.push_back(parse_json(file));
+            } else {
+                csv_reports.push_back(read_csv_report(file));
+            }
+        } catch (std::exception const& error) {
+            std::cerr << "Could not read report '" << path
+                      << "': " << error.what() << std::endl;
+            return kExitError;
+        }
+    }
+
+    std::ofstream output_file;
+    if (!output_path_.empty()) {
+        output_file.open(output_path_);
+        if (!output_file.good()) {
+            std::cerr << "Could not open output file at path '"
+                      << output_path_ << "'" << std::endl;
+            return kExitError;
+        }
+    }
+
+    std::ostream& out = output_path_.empty() ? std::cout : output_file;
+
+    try {
+        if (json) {
+            print_json(out, merge_json_reports(json_reports)) << std::endl;
+        } else {
+            print_csv_report(out, merge_csv_reports(csv_reports));
+        }
+    } catch (std::exception const& error) {
+        std::cerr << "Could not merge reports: " << error.what() << std::endl;
+        return kExitError;
+    }
+
+    return kExitSuccess;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
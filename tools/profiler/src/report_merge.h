@@ -0,0 +1,101 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Combines the reports written by the shards of a distributed sweep
+*/
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "cutlass/util/command_line.h"
+
+// CUTLASS Profiler includes
+#include "json.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Rows of a CSV report written by PerformanceReport
+struct CsvReport {
+    std::vector<std::string> header;
+
+    std::vector<std::vector<std::string>> rows;
+};
+
+/// Reads a CSV report. Throws std::runtime_error on malformed input.
+CsvReport read_csv_report(std::istream& in);
+
+/// Writes a CSV report
+std::ostream& print_csv_report(std::ostream& out, CsvReport const& report);
+
+/// Merges CSV reports of the same columns into one ordered by problem,
+/// operation and provider. A result repeated by a later report or row, such
+/// as a retried shard, replaces the earlier one. Throws std::runtime_error if
+/// the columns differ.
+CsvReport merge_csv_reports(std::vector<CsvReport> const& reports);
+
+/// Merges JSON reports of the same operation kind in the same way. The
+/// environment is taken from the first report. Throws std::runtime_error if
+/// the operation kinds differ.
+JsonValue merge_json_reports(std::vector<JsonValue> const& reports);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Host-only merge of the reports selected by --merge
+class ReportMerge {
+public:
+    /// Process exit codes
+    static int const kExitSuccess = 0;
+    static int const kExitError = 2;
+
+private:
+    std::vector<std::string> input_paths_;
+
+    /// Path to the merged report. Written to stdout if empty.
+    std::string output_path_;
+
+public:
+    /// Returns true if the command line requests a merge
+    static bool enabled(CommandLine const& cmdline);
+
+    explicit ReportMerge(CommandLine const& cmdline);
+
+    /// Merges the reports and returns the process exit code
+    int operator()();
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,131 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Statistics of runtime samples measured while profiling
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "runtime_statistics.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the given percentile (0 to 100) of sorted samples
+double percentile(std::vector<double> const& sorted_samples, double percent) {
+    if (sorted_samples.empty()) {
+        return 0;
+    }
+
+    double position = percent / 100.0 * double(sorted_samples.size() - 1);
+    size_t lower = size_t(std::floor(position));
+    size_t upper = std::min(lower + 1, sorted_samples.size() - 1);
+    double fraction = position - double(lower);
+
+    return sorted_samples[lower] +
+           fraction * (sorted_samples[upper] - sorted_samples[lower]);
+}
+
+/// Computes the distribution of runtime samples
+RuntimeStatistics compute_runtime_statistics(std::vector<double> const& samples,
+                                             double confidence,
+                                             int bootstrap_resamples,
+                                             uint64_t seed) {
+    RuntimeStatistics statistics;
+
+    if (samples.empty()) {
+        return statistics;
+    }
+
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0;
+    for (double sample : sorted) {
+        sum += sample;
+    }
+
+    statistics.samples = int(sorted.size());
+    statistics.mean = sum / double(sorted.size());
+    statistics.min = sorted.front();
+    statistics.median = percentile(sorted, 50);
+    statistics.p90 = percentile(sorted, 90);
+    statistics.p99 = percentile(sorted, 99);
+
+    double sum_squares = 0;
+    for (double sample : sorted) {
+        sum_squares += (sample - statistics.mean) * (sample - statistics.mean);
+    }
+    statistics.stddev =
+            sorted.size() > 1 ? std::sqrt(sum_squares / double(sorted.size() - 1))
+                              : 0;
+
+    //
+    // Percentile bootstrap of the median
+    //
+
+    statistics.confidence = confidence;
+    statistics.ci_lower = statistics.median;
+    statistics.ci_upper = statistics.median;
+
+    if (sorted.size() < 2 || bootstrap_resamples < 2) {
+        return statistics;
+    }
+
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<size_t> index(0, sorted.size() - 1);
+
+    std::vector<double> resample(sorted.size());
+    std::vector<double> medians(bootstrap_resamples);
+
+    for (double& median : medians) {
+        for (double& sample : resample) {
+            sample = sorted[index(generator)];
+        }
+        std::sort(resample.begin(), resample.end());
+        median = percentile(resample, 50);
+    }
+
+    std::sort(medians.begin(), medians.end());
+
+    double tail = (1.0 - confidence) / 2.0 * 100.0;
+    statistics.ci_lower = percentile(medians, tail);
+    statistics.ci_upper = percentile(medians, 100.0 - tail);
+
+    return statistics;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
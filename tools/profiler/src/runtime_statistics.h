@@ -0,0 +1,110 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Statistics of runtime samples measured while profiling
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Distribution of runtime samples (all runtimes in ms)
+struct RuntimeStatistics {
+    /// Number of samples
+    int samples;
+
+    /// Arithmetic mean
+    double mean;
+
+    /// Smallest sample
+    double min;
+
+    /// 50th percentile
+    double median;
+
+    /// 90th percentile
+    double p90;
+
+    /// 99th percentile
+    double p99;
+
+    /// Sample standard deviation
+    double stddev;
+
+    /// Confidence level of the interval [ci_lower, ci_upper] on the median
+    double confidence;
+    double ci_lower;
+    double ci_upper;
+
+    //
+    // Methods
+    //
+
+    RuntimeStatistics()
+            : samples(0),
+              mean(0),
+              min(0),
+              median(0),
+              p90(0),
+              p99(0),
+              stddev(0),
+              confidence(0),
+              ci_lower(0),
+              ci_upper(0) {}
+
+    /// Returns true if statistics were computed
+    bool good() const { return samples > 0; }
+
+    /// Width of the confidence interval relative to the median
+    double relative_ci_width() const {
+        return median > 0 ? (ci_upper - ci_lower) / median : 0;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the given percentile (0 to 100) of sorted samples, interpolating
+/// linearly between neighbouring samples
+double percentile(std::vector<double> const& sorted_samples, double percent);
+
+/// Computes the distribution of runtime samples. The confidence interval on
+/// the median is estimated by bootstrap resampling with a fixed seed, so
+/// results are reproducible.
+RuntimeStatistics compute_runtime_statistics(
+        std::vector<double> const& samples, double confidence = 0.95,
+        int bootstrap_resamples = 1000, uint64_t seed = 2020);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
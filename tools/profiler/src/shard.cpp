@@ -0,0 +1,127 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Partitioning of a sweep's work list across profiler processes
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include "shard.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+ShardSpec ShardSpec::parse(std::string const& text) {
+    size_t slash = text.find('/');
+
+    if (slash == std::string::npos || slash == 0 ||
+        slash + 1 == text.size()) {
+        throw std::runtime_error("Invalid shard '" + text +
+                                 "', expected <index>/<count>");
+    }
+
+    char* end = nullptr;
+    std::string index_text = text.substr(0, slash);
+    std::string count_text = text.substr(slash + 1);
+
+    long index = std::strtol(index_text.c_str(), &end, 10);
+    bool valid = (*end == '\0');
+
+    long count = std::strtol(count_text.c_str(), &end, 10);
+    valid = valid && (*end == '\0');
+
+    if (!valid || count < 1 || index < 0 || index >= count) {
+        throw std::runtime_error("Invalid shard '" + text +
+                                 "', expected 0 <= index < count");
+    }
+
+    return ShardSpec(int(index), int(count));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+double planned_cost(int64_t flops, int64_t bytes, int launches) {
+    double const kNominalFlops = 100.0e12;
+    double const kNominalBandwidth = 1.0e12;
+    double const kOverhead = 1.0;
+
+    double runtime = 1.0e3 * std::max(double(flops) / kNominalFlops,
+                                      double(bytes) / kNominalBandwidth);
+
+    return kOverhead + std::max(launches, 0) * runtime;
+}
+
+std::vector<int> assign_shards(std::vector<double> const& costs,
+                               int shard_count) {
+    std::vector<int> shards(costs.size(), 0);
+
+    if (shard_count <= 1) {
+        return shards;
+    }
+
+    std::vector<size_t> order(costs.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return costs[a] > costs[b];
+    });
+
+    // Least loaded shard first, then lowest index
+    using Load = std::pair<double, int>;
+    std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+
+    for (int shard = 0; shard < shard_count; ++shard) {
+        loads.push(Load(0, shard));
+    }
+
+    for (size_t item : order) {
+        Load load = loads.top();
+        loads.pop();
+
+        shards[item] = load.second;
+
+        load.first += costs[item];
+        loads.push(load);
+    }
+
+    return shards;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,89 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Partitioning of a sweep's work list across profiler processes
+
+  A sweep is split into n shards given on the command line as --shard=i/n.
+  Every shard enumerates the same list of (problem, operation) work items and
+  estimates the cost of each from its flops and bytes, independently of the
+  device it runs on. Items are assigned greedily, most expensive first, to
+  the least loaded shard. Since the assignment depends only on the work list
+  and the options, the shards need not communicate and together cover every
+  item exactly once.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Selects one of several processes sharing a sweep
+struct ShardSpec {
+    /// Index of this shard
+    int index;
+
+    /// Number of shards
+    int count;
+
+    //
+    // Methods
+    //
+
+    ShardSpec() : index(0), count(1) {}
+
+    ShardSpec(int index, int count) : index(index), count(count) {}
+
+    /// Parses "i/n". Throws std::runtime_error if malformed.
+    static ShardSpec parse(std::string const& text);
+
+    /// Returns true if the sweep is split across processes
+    bool enabled() const { return count > 1; }
+};
+
+/// Device-independent cost of profiling a work item: its launches at the
+/// roofline of a nominal 100 TFLOP/s, 1 TB/s device plus a fixed overhead
+/// of 1 ms for allocation, initialization and verification.
+double planned_cost(int64_t flops, int64_t bytes, int launches);
+
+/// Assigns each work item to a shard, visiting items from the most to the
+/// least expensive and placing each on the least loaded shard. Ties are broken
+/// by item index and by shard index, so the assignment is deterministic.
+std::vector<int> assign_shards(std::vector<double> const& costs,
+                               int shard_count);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
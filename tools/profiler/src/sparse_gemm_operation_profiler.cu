@@ -367,6 +367,13 @@ void SparseGemmOperationProfiler::initialize_result_(
     result.flops = 2 * (problem_.m * problem_.n * problem_.k +
                         problem_.m * problem_.n);
     result.runtime = 0;
+
+    cutlass::gemm::GemmCoord const& tile =
+            operation_desc.tile_description.threadblock_shape;
+
+    result.model = PerformanceModel(
+            operation_desc, operation_desc.A.element, operation_desc.B.element,
+            tile_count(problem_.m, tile.m()) * tile_count(problem_.n, tile.n()));
 }
 
 /// Initializes workspace
@@ -379,6 +386,26 @@ Status SparseGemmOperationProfiler::initialize_workspace(
             static_cast<library::SparseGemmDescription const&>(
                     operation->description());
 
+    // Device memory of A, B, C, E, the computed D and the reference D
+    int64_t workspace_bytes =
+            DeviceAllocation::bytes(
+                    operation_desc.A.element, operation_desc.A.layout,
+                    {int(problem_.m), int(problem_.k) / int(problem_.sparse)},
+                    {int(problem_.lda)}) +
+            DeviceAllocation::bytes(operation_desc.B.element,
+                                    operation_desc.B.layout,
+                                    {int(problem_.k), int(problem_.n)},
+                                    {int(problem_.ldb)}) +
+            3 * DeviceAllocation::bytes(operation_desc.C.element,
+                                        operation_desc.C.layout,
+                                        {int(problem_.m), int(problem_.n)},
+                                        {int(problem_.ldc)}) +
+            DeviceAllocation::bytes(
+                    operation_desc.E.element, operation_desc.E.layout,
+                    {int(problem_.m), int(problem_.k) / int(problem_.sparse) /
+                                              int(problem_.elements_per_128b)},
+                    {int(problem_.lde)});
+
     if (options.execution_mode != ExecutionMode::kDryRun) {
         gemm_workspace_.A = device_context.allocate_tensor(
                 options, "A", operation_desc.A.element, operation_desc.A.layout,
@@ -418,15 +445,16 @@ Status SparseGemmOperationProfiler::initialize_workspace(
     Status status = Status::kSuccess;
 
     if (options.profiling.provider_enabled(library::Provider::kCUTLASS)) {
+        uint64_t device_workspace_size = operation->get_device_workspace_size(
+                &gemm_workspace_.configuration);
+
         if (options.execution_mode != ExecutionMode::kDryRun) {
             uint64_t workspace_size = operation->get_host_workspace_size(
                     &gemm_workspace_.configuration);
             gemm_workspace_.host_workspace.resize(workspace_size, 0);
 
-            workspace_size = operation->get_device_workspace_size(
-                    &gemm_workspace_.configuration);
             gemm_workspace_.device_workspace.reset(library::NumericTypeID::kU8,
-                                                   workspace_size);
+                                                   device_workspace_size);
 
             status = operation->initialize(
                     &gemm_workspace_.configuration,
@@ -442,6 +470,8 @@ Status SparseGemmOperationProfiler::initialize_workspace(
         results_.back().provider = library::Provider::kCUTLASS;
         results_.back().op_kind = library::OperationKind::kSparseGemm;
         results_.back().disposition = Disposition::kNotRun;
+        results_.back().workspace_bytes =
+                workspace_bytes + int64_t(device_workspace_size);
 
         for (auto& verification_provider : options.verification.providers) {
             results_.back().verification_map[verification_provider] =
@@ -551,7 +581,7 @@ bool SparseGemmOperationProfiler::profile(
                 library::ScalarPointerMode::kHost;
 
         results_.back().status =
-                profile_cutlass_(results_.back().runtime, options, operation,
+                profile_cutlass_(results_.back(), options, operation,
                                  &gemm_workspace_.arguments,
                                  gemm_workspace_.host_workspace.data(),
                                  gemm_workspace_.device_workspace.data());
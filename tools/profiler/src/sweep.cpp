@@ -0,0 +1,337 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Sampling of problem spaces and checkpoints for resumable sweeps
+*/
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "sweep.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Primitive polynomial and initial direction numbers of one Sobol dimension
+struct SobolDirection {
+    int degree;
+    uint32_t coefficients;
+    uint32_t initial[7];
+};
+
+/// Joe and Kuo's parameters for dimensions 2 through kSobolMaxDimensions. The
+/// first dimension is the van der Corput sequence.
+SobolDirection const kSobolDirections[] = {
+        {1, 0, {1}},
+        {2, 1, {1, 3}},
+        {3, 1, {1, 3, 1}},
+        {3, 2, {1, 1, 1}},
+        {4, 1, {1, 1, 3, 3}},
+        {4, 4, {1, 3, 5, 13}},
+        {5, 2, {1, 1, 5, 5, 17}},
+        {5, 4, {1, 1, 5, 5, 5}},
+        {5, 7, {1, 1, 7, 11, 19}},
+        {5, 11, {1, 1, 5, 1, 1}},
+        {5, 13, {1, 1, 1, 3, 11}},
+        {5, 14, {1, 3, 5, 5, 31}},
+        {6, 1, {1, 3, 3, 9, 7, 49}},
+        {6, 13, {1, 1, 1, 15, 21, 21}},
+        {6, 16, {1, 3, 1, 13, 27, 49}},
+        {6, 19, {1, 1, 1, 15, 7, 5}},
+        {6, 22, {1, 3, 1, 15, 13, 25}},
+        {6, 25, {1, 1, 5, 5, 19, 61}},
+        {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+        {7, 4, {1, 3, 7, 13, 13, 15, 69}}};
+
+int const kSobolBits = 32;
+
+/// Computes the direction numbers of one dimension scaled to 32 bits
+std::vector<uint32_t> sobol_direction_numbers(size_t dimension) {
+    std::vector<uint32_t> v(kSobolBits + 1, 0);
+
+    if (dimension == 0) {
+        for (int k = 1; k <= kSobolBits; ++k) {
+            v[k] = uint32_t(1) << (kSobolBits - k);
+        }
+        return v;
+    }
+
+    SobolDirection const& direction = kSobolDirections[dimension - 1];
+    int s = direction.degree;
+
+    for (int k = 1; k <= kSobolBits; ++k) {
+        if (k <= s) {
+            v[k] = direction.initial[k - 1] << (kSobolBits - k);
+        } else {
+            v[k] = v[k - s] ^ (v[k - s] >> s);
+            for (int j = 1; j < s; ++j) {
+                v[k] ^= ((direction.coefficients >> (s - 1 - j)) & 1) *
+                        v[k - j];
+            }
+        }
+    }
+
+    return v;
+}
+
+/// Enumerates every point of a problem space with the first argument changing
+/// fastest, matching ProblemSpace::Iterator
+std::vector<std::vector<size_t>> enumerate_problem_space(
+        std::vector<size_t> const& extents) {
+    std::vector<std::vector<size_t>> points;
+    std::vector<size_t> indices(extents.size(), 0);
+
+    while (true) {
+        points.push_back(indices);
+
+        size_t dim = 0;
+        for (; dim < extents.size(); ++dim) {
+            if (++indices[dim] < extents[dim]) {
+                break;
+            }
+            indices[dim] = 0;
+        }
+
+        if (dim == extents.size()) {
+            break;
+        }
+    }
+
+    return points;
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<std::vector<double>> latin_hypercube(size_t count,
+                                                 size_t dimensions,
+                                                 uint64_t seed) {
+    std::vector<std::vector<double>> points(count,
+                                            std::vector<double>(dimensions));
+
+    std::mt19937_64 engine(seed);
+    std::uniform_real_distribution<double> jitter(0, 1);
+
+    std::vector<size_t> strata(count);
+
+    for (size_t dim = 0; dim < dimensions; ++dim) {
+        for (size_t i = 0; i < count; ++i) {
+            strata[i] = i;
+        }
+        std::shuffle(strata.begin(), strata.end(), engine);
+
+        for (size_t i = 0; i < count; ++i) {
+            double u = (double(strata[i]) + jitter(engine)) / double(count);
+            points[i][dim] = std::min(u, std::nextafter(1.0, 0.0));
+        }
+    }
+
+    return points;
+}
+
+std::vector<std::vector<double>> sobol_sequence(size_t count,
+                                                size_t dimensions) {
+    if (dimensions > size_t(kSobolMaxDimensions)) {
+        std::stringstream ss;
+        ss << "Sobol sampling supports at most " << kSobolMaxDimensions
+           << " arguments with more than one value, got " << dimensions;
+        throw std::invalid_argument(ss.str());
+    }
+
+    std::vector<std::vector<double>> points(count,
+                                            std::vector<double>(dimensions));
+
+    double const scale = 1.0 / 4294967296.0;
+
+    for (size_t dim = 0; dim < dimensions; ++dim) {
+        std::vector<uint32_t> v = sobol_direction_numbers(dim);
+
+        // Gray code construction: point i differs from point i - 1 by the
+        // direction number of the lowest zero bit of i - 1
+        uint32_t x = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (i) {
+                size_t c = 1;
+                for (size_t value = i - 1; value & 1; value >>= 1) {
+                    ++c;
+                }
+                if (c > size_t(kSobolBits)) {
+                    throw std::invalid_argument(
+                            "Sobol sequence exhausted its 32-bit precision");
+                }
+                x ^= v[c];
+            }
+            points[i][dim] = double(x) * scale;
+        }
+    }
+
+    return points;
+}
+
+std::vector<std::vector<size_t>> sample_problem_space(
+        std::vector<size_t> const& extents, SamplingMode mode, size_t count,
+        uint64_t seed) {
+    // Number of points, saturating rather than overflowing
+    size_t total = 1;
+    std::vector<size_t> dims;
+
+    for (size_t dim = 0; dim < extents.size(); ++dim) {
+        size_t extent = std::max(extents[dim], size_t(1));
+        if (extent > 1) {
+            dims.push_back(dim);
+        }
+        if (total > std::numeric_limits<size_t>::max() / extent) {
+            total = std::numeric_limits<size_t>::max();
+        } else {
+            total *= extent;
+        }
+    }
+
+    if (mode == SamplingMode::kExhaustive || total <= count) {
+        return enumerate_problem_space(extents);
+    }
+
+    std::vector<std::vector<double>> unit_points;
+
+    switch (mode) {
+        case SamplingMode::kLatinHypercube:
+            unit_points = latin_hypercube(count, dims.size(), seed);
+            break;
+        case SamplingMode::kSobol:
+            unit_points = sobol_sequence(count, dims.size());
+            break;
+        default:
+            throw std::invalid_argument("Invalid sampling mode");
+    }
+
+    std::vector<std::vector<size_t>> points;
+    std::set<std::vector<size_t>> visited;
+
+    for (std::vector<double> const& u : unit_points) {
+        std::vector<size_t> indices(extents.size(), 0);
+
+        for (size_t i = 0; i < dims.size(); ++i) {
+            size_t extent = extents[dims[i]];
+            indices[dims[i]] =
+                    std::min(extent - 1, size_t(u[i] * double(extent)));
+        }
+
+        if (visited.insert(indices).second) {
+            points.push_back(indices);
+        }
+    }
+
+    return points;
+}
+
+std::string problem_key(ProblemSpace::Problem const& problem) {
+    std::stringstream ss;
+
+    for (size_t idx = 0; idx < problem.size(); ++idx) {
+        if (idx) {
+            ss << ";";
+        }
+        problem[idx]->print(ss);
+    }
+
+    return ss.str();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+SweepCheckpoint::SweepCheckpoint(std::string const& path,
+                                 std::string const& operation_kind)
+        : path_(path), operation_kind_(operation_kind), resumed_(0) {
+    if (path_.empty()) {
+        return;
+    }
+
+    bool needs_newline = false;
+
+    std::ifstream input(path_);
+    if (input.good()) {
+        std::string line;
+        while (std::getline(input, line)) {
+            // A line cut short by an interrupted write lacks its newline and
+            // is ignored
+            if (input.eof()) {
+                needs_newline = !line.empty();
+                break;
+            }
+
+            // Keys never contain tabs, so records invalidated below are
+            // ignored
+            size_t tab = line.find('\t');
+            if (tab != std::string::npos &&
+                line.find('\t', tab + 1) == std::string::npos &&
+                line.compare(0, tab, operation_kind_) == 0 &&
+                completed_.insert(line.substr(tab + 1)).second) {
+                ++resumed_;
+            }
+        }
+    }
+    input.close();
+
+    file_.open(path_, std::ios_base::app);
+    if (!file_.good()) {
+        throw std::runtime_error("Failed to open checkpoint file '" + path_ +
+                                 "'");
+    }
+
+    // Terminates the truncated record such that it is never loaded
+    if (needs_newline) {
+        file_ << "\t\n";
+    }
+}
+
+bool SweepCheckpoint::completed(std::string const& key) const {
+    return completed_.count(key) != 0;
+}
+
+void SweepCheckpoint::complete(std::string const& key) {
+    if (!enabled() || !completed_.insert(key).second) {
+        return;
+    }
+
+    file_ << operation_kind_ << "\t" << key << "\n";
+    file_.flush();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
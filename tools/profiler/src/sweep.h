@@ -0,0 +1,120 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Sampling of problem spaces and checkpoints for resumable sweeps
+
+  Exhaustive sweeps visit the full cartesian product of every argument's
+  range. Large spaces can instead be covered by a fixed number of points drawn
+  with a Latin hypercube or a Sobol sequence. Each argument with more than one
+  value is one dimension of the unit hypercube, and coordinate u selects the
+  value at position floor(u * extent) of that argument's range.
+
+  A checkpoint file records one line per completed problem so that an
+  interrupted sweep can be restarted without repeating finished points:
+
+    gemm<TAB>m: 1024;n: 512;k: 64;...
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+// Profiler includes
+#include "enumerated_types.h"
+#include "problem_space.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Largest number of dimensions supported by sobol_sequence()
+int const kSobolMaxDimensions = 21;
+
+/// Draws count points of a Latin hypercube in [0, 1)^dimensions. Along each
+/// dimension, every interval [i / count, (i + 1) / count) holds exactly one
+/// point.
+std::vector<std::vector<double>> latin_hypercube(size_t count,
+                                                 size_t dimensions,
+                                                 uint64_t seed);
+
+/// Returns the first count points of the Sobol sequence in [0, 1)^dimensions
+/// using the direction numbers of Joe and Kuo.
+std::vector<std::vector<double>> sobol_sequence(size_t count,
+                                                size_t dimensions);
+
+/// Selects the points of a problem space to visit, given the extent of each
+/// argument's range. Each element of the result holds one index per
+/// argument. Duplicate points are removed, and the complete space is returned
+/// in iteration order if it holds no more than count points.
+std::vector<std::vector<size_t>> sample_problem_space(
+        std::vector<size_t> const& extents, SamplingMode mode, size_t count,
+        uint64_t seed);
+
+/// Forms a key identifying a problem within a checkpoint
+std::string problem_key(ProblemSpace::Problem const& problem);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Append-only record of the problems completed by a sweep
+class SweepCheckpoint {
+public:
+    /// Opens the checkpoint file, loading the problems completed for the
+    /// given operation kind. An empty path disables checkpointing.
+    SweepCheckpoint(std::string const& path, std::string const& operation_kind);
+
+    /// Returns true if checkpointing is enabled
+    bool enabled() const { return !path_.empty(); }
+
+    /// Returns true if the problem was completed by a previous run
+    bool completed(std::string const& key) const;
+
+    /// Records a completed problem. The file is flushed so the record
+    /// survives if the process is terminated.
+    void complete(std::string const& key);
+
+    /// Number of problems loaded from the file
+    size_t resumed() const { return resumed_; }
+
+private:
+    std::string path_;
+    std::string operation_kind_;
+    std::set<std::string> completed_;
+    size_t resumed_;
+    std::ofstream file_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,333 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Workload traces replayed by the profiler and their frequency-weighted
+   summary
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include "cutlass/library/util.h"
+
+#include "workload.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Splits a CSV line into cells, honoring double quotes
+std::vector<std::string> split_csv_line(std::string const& line) {
+    std::vector<std::string> cells(1);
+    bool quoted = false;
+
+    for (size_t idx = 0; idx < line.size(); ++idx) {
+        char c = line[idx];
+        if (c == '"') {
+            if (quoted && idx + 1 < line.size() && line[idx + 1] == '"') {
+                cells.back().push_back('"');
+                ++idx;
+            } else {
+                quoted = !quoted;
+            }
+        } else if (c == ',' && !quoted) {
+            cells.emplace_back();
+        } else if (c != '\r') {
+            cells.back().push_back(c);
+        }
+    }
+
+    // trim surrounding whitespace
+    for (auto& cell : cells) {
+        size_t begin = cell.find_first_not_of(" \t");
+        size_t end = cell.find_last_not_of(" \t");
+        cell = (begin == std::string::npos)
+                       ? std::string()
+                       : cell.substr(begin, end - begin + 1);
+    }
+
+    return cells;
+}
+
+/// Throws an error referring to a line of the trace
+[[noreturn]] void workload_error(int line, std::string const& message) {
+    std::stringstream ss;
+    ss << "workload line " << line << ": " << message;
+    throw std::runtime_error(ss.str());
+}
+
+}  // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the command line defining this problem
+CommandLine WorkloadRecord::command_line(CommandLine const& cmdline) const {
+    CommandLine result(cmdline);
+
+    for (auto const& arg : arguments) {
+        for (size_t idx = result.keys.size(); idx > 0; --idx) {
+            if (result.keys[idx - 1] == arg.first) {
+                result.keys.erase(result.keys.begin() + (idx - 1));
+                result.values.erase(result.values.begin() + (idx - 1));
+            }
+        }
+
+        result.keys.push_back(arg.first);
+        result.values.push_back(arg.second);
+    }
+
+    return result;
+}
+
+/// Reads a workload trace
+WorkloadRecordVector read_workload(std::istream& in) {
+    WorkloadRecordVector records;
+    std::vector<std::string> header;
+
+    std::string line;
+    for (int line_idx = 1; std::getline(in, line); ++line_idx) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos ||
+            line[line.find_first_not_of(" \t")] == '#') {
+            continue;
+        }
+
+        std::vector<std::string> cells = split_csv_line(line);
+
+        if (header.empty()) {
+            header = cells;
+            if (std::find(header.begin(), header.end(), "operation") ==
+                header.end()) {
+                workload_error(line_idx, "header has no 'operation' column");
+            }
+            continue;
+        }
+
+        if (cells.size() != header.size()) {
+            workload_error(line_idx, "number of cells differs from header");
+        }
+
+        WorkloadRecord record;
+        record.line = line_idx;
+
+        for (size_t idx = 0; idx < cells.size(); ++idx) {
+            if (header[idx] == "operation") {
+                record.op_kind = library::from_string<library::OperationKind>(
+                        cells[idx]);
+                if (record.op_kind == library::OperationKind::kInvalid) {
+                    workload_error(line_idx,
+                                   "unknown operation '" + cells[idx] + "'");
+                }
+            } else if (header[idx] == "weight") {
+                char* end = nullptr;
+                record.weight = std::strtod(cells[idx].c_str(), &end);
+                if (cells[idx].empty() || *end || record.weight < 0) {
+                    workload_error(line_idx,
+                                   "invalid weight '" + cells[idx] + "'");
+                }
+            } else if (!cells[idx].empty()) {
+                record.arguments.emplace_back(header[idx], cells[idx]);
+            }
+        }
+
+        records.push_back(record);
+    }
+
+    return records;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Considers the results of profiling one record
+void WorkloadSummary::append_results(size_t record_idx,
+                                     PerformanceResultVector const& results) {
+    for (auto const& result : results) {
+        if (!result.good() || result.status != Status::kSuccess ||
+            result.disposition == Disposition::kFailed ||
+            result.disposition == Disposition::kIncorrect) {
+            continue;
+        }
+
+        double runtime = result.runtime_statistics.good()
+                                 ? result.runtime_statistics.median
+                                 : result.runtime;
+
+        auto key = std::make_pair(record_idx, result.provider);
+        auto it = selections_.find(key);
+
+        if (it == selections_.end() || runtime < it->second.runtime) {
+            Selection& selection = selections_[key];
+            selection.operation_name = result.operation_name;
+            selection.runtime = runtime;
+        }
+    }
+}
+
+/// Returns the fastest result of a provider for a record
+WorkloadSummary::Selection const* WorkloadSummary::selection(
+        size_t record_idx, library::Provider provider) const {
+    auto it = selections_.find(std::make_pair(record_idx, provider));
+    return it == selections_.end() ? nullptr : &it->second;
+}
+
+/// Frequency-weighted runtime of a provider over the given records in ms
+double WorkloadSummary::weighted_runtime(
+        library::Provider provider,
+        std::vector<size_t> const& record_indices) const {
+    double total = 0;
+    for (size_t record_idx : record_indices) {
+        Selection const* s = selection(record_idx, provider);
+        if (s) {
+            total += records_[record_idx].weight * s->runtime;
+        }
+    }
+    return total;
+}
+
+/// Prints totals per provider and per selected kernel
+std::ostream& WorkloadSummary::print(std::ostream& out) const {
+    std::set<library::Provider> providers;
+    for (auto const& entry : selections_) {
+        providers.insert(entry.first.second);
+    }
+
+    double total_weight = 0;
+    for (auto const& record : records_) {
+        total_weight += record.weight;
+    }
+
+    out << "\n=============================\n"
+        << "  Workload: " << records_.size() << " records, total weight "
+        << total_weight << "\n\n";
+
+    if (providers.empty()) {
+        out << "  No record was profiled successfully.\n";
+        return out;
+    }
+
+    // Records every provider succeeded on are the basis of a fair comparison
+    std::vector<size_t> common_records;
+
+    for (size_t record_idx = 0; record_idx < records_.size(); ++record_idx) {
+        bool covered = true;
+        for (auto provider : providers) {
+            covered = covered && selection(record_idx, provider);
+        }
+        if (covered) {
+            common_records.push_back(record_idx);
+        }
+    }
+
+    out << "  Weighted runtime of the fastest kernel per provider:\n\n"
+        << "  " << std::setw(16) << "Provider" << std::setw(10) << "Records"
+        << std::setw(14) << "Weight" << std::setw(20) << "Runtime (ms)"
+        << std::setw(20) << "Common (ms)" << "\n";
+
+    for (auto provider : providers) {
+        std::vector<size_t> covered_records;
+        double covered_weight = 0;
+
+        for (size_t record_idx = 0; record_idx < records_.size();
+             ++record_idx) {
+            if (selection(record_idx, provider)) {
+                covered_records.push_back(record_idx);
+                covered_weight += records_[record_idx].weight;
+            }
+        }
+
+        out << "  " << std::setw(16) << library::to_string(provider, true)
+            << std::setw(10) << covered_records.size() << std::setw(14)
+            << covered_weight << std::setw(20)
+            << weighted_runtime(provider, covered_records) << std::setw(20)
+            << weighted_runtime(provider, common_records) << "\n";
+    }
+
+    out << "\n  'Common' sums the " << common_records.size() << " of "
+        << records_.size() << " records profiled by every provider.\n\n";
+
+    //
+    // Share of the weighted runtime spent in each selected kernel
+    //
+
+    out << "  Fastest kernels by weighted runtime:\n\n";
+
+    for (auto provider : providers) {
+        std::map<std::string, std::pair<int, double>> kernels;
+        double provider_total = 0;
+
+        for (size_t record_idx = 0; record_idx < records_.size();
+             ++record_idx) {
+            Selection const* s = selection(record_idx, provider);
+            if (s) {
+                double runtime = records_[record_idx].weight * s->runtime;
+                auto& kernel = kernels[s->operation_name];
+                ++kernel.first;
+                kernel.second += runtime;
+                provider_total += runtime;
+            }
+        }
+
+        std::vector<std::pair<std::string, std::pair<int, double>>> sorted(
+                kernels.begin(), kernels.end());
+        std::sort(sorted.begin(), sorted.end(),
+                  [](std::pair<std::string, std::pair<int, double>> const& lhs,
+                     std::pair<std::string, std::pair<int, double>> const& rhs) {
+                      return lhs.second.second > rhs.second.second;
+                  });
+
+        out << "  " << library::to_string(provider, true) << ":\n";
+
+        for (auto const& kernel : sorted) {
+            out << "    " << std::setw(6) << std::fixed << std::setprecision(1)
+                << (provider_total > 0
+                            ? 100.0 * kernel.second.second / provider_total
+                            : 0.0)
+                << "%  " << std::setw(6) << kernel.second.first
+                << " records  " << kernel.first << "\n";
+            out.unsetf(std::ios::floatfield);
+            out << std::setprecision(6);
+        }
+
+        out << "\n";
+    }
+
+    return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
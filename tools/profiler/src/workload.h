@@ -0,0 +1,142 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Workload traces replayed by the profiler and their frequency-weighted
+   summary
+
+  A workload trace is a CSV file with a header row. The 'operation' column
+  names the operation kind of each record and the optional 'weight' column its
+  relative frequency (default: 1). Every other column is an argument of that
+  operation kind exactly as it would be given on the command line, for
+  example:
+
+    operation,weight,m,n,k,A,B,C
+    gemm,1200,1024,512,64,f16:column,f16:row,f32:column
+    gemm,15,4096,4096,4096,f16:column,f16:row,f32:column
+
+  Empty cells leave the argument to the command line or its default. Cells
+  containing commas must be quoted. Lines beginning with '#' are ignored.
+*/
+
+#pragma once
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cutlass/util/command_line.h"
+
+// CUTLASS Library includes
+#include "cutlass/library/library.h"
+
+// Profiler includes
+#include "performance_result.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// One problem of a workload trace
+struct WorkloadRecord {
+    /// Operation kind profiled for this record
+    library::OperationKind op_kind;
+
+    /// Relative frequency of the problem
+    double weight;
+
+    /// Problem arguments as given on the command line
+    std::vector<std::pair<std::string, std::string>> arguments;
+
+    /// Line of the trace defining the record
+    int line;
+
+    WorkloadRecord()
+            : op_kind(library::OperationKind::kInvalid), weight(1), line(0) {}
+
+    /// Returns the command line defining this problem. Arguments absent from
+    /// the record are taken from `cmdline`.
+    CommandLine command_line(CommandLine const& cmdline) const;
+};
+
+using WorkloadRecordVector = std::vector<WorkloadRecord>;
+
+/// Reads a workload trace. Throws std::runtime_error on malformed input.
+WorkloadRecordVector read_workload(std::istream& in);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Accumulates the fastest result of each provider for each record and
+/// reports frequency-weighted totals
+class WorkloadSummary {
+public:
+    /// Fastest passing result of a provider for one record
+    struct Selection {
+        std::string operation_name;
+        double runtime;
+
+        Selection() : runtime(0) {}
+    };
+
+private:
+    /// Records of the replayed trace
+    WorkloadRecordVector records_;
+
+    /// Fastest result indexed by record and provider
+    std::map<std::pair<size_t, library::Provider>, Selection> selections_;
+
+public:
+    explicit WorkloadSummary(WorkloadRecordVector const& records)
+            : records_(records) {}
+
+    WorkloadRecordVector const& records() const { return records_; }
+
+    /// Considers the results of profiling one record
+    void append_results(size_t record_idx,
+                        PerformanceResultVector const& results);
+
+    /// Returns the fastest result of a provider for a record or nullptr if
+    /// the provider produced no passing result
+    Selection const* selection(size_t record_idx,
+                               library::Provider provider) const;
+
+    /// Frequency-weighted runtime of a provider over the given records in ms
+    double weighted_runtime(library::Provider provider,
+                            std::vector<size_t> const& record_indices) const;
+
+    /// Prints totals per provider and per selected kernel
+    std::ostream& print(std::ostream& out) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace profiler
+}  // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
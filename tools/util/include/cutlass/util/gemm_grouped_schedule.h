@@ -0,0 +1,87 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Simulates on the host the tile schedule of a persistent grouped GEMM
+   kernel.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/kernel/gemm_grouped_problem_visitor.h"
+
+namespace cutlass {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// One output tile computed by a threadblock of a grouped GEMM
+struct GemmGroupedTileAssignment {
+    /// Threadblock computing the tile
+    int threadblock_idx;
+
+    /// Position of the tile in the sequence computed by its threadblock
+    int iteration;
+
+    /// Problem owning the tile
+    int problem_idx;
+
+    /// Coordinate of the tile within its problem, in units of tiles
+    gemm::GemmCoord tile_offset;
+};
+
+/// Runs the problem visitor of every threadblock of a grouped GEMM launch and
+/// returns the tiles each one computes, ordered by threadblock and then by
+/// iteration. No device is required.
+template <typename ProblemVisitor>
+std::vector<GemmGroupedTileAssignment> simulate_gemm_grouped_schedule(
+        gemm::GemmCoord const* problem_sizes, int problem_count,
+        int threadblock_count) {
+    std::vector<GemmGroupedTileAssignment> assignments;
+
+    typename ProblemVisitor::Params params(problem_sizes, problem_count);
+
+    for (int block_idx = 0; block_idx < threadblock_count; ++block_idx) {
+        ProblemVisitor problem_visitor(params, block_idx);
+
+        for (int iteration = 0; problem_visitor.next_tile(); ++iteration) {
+            assignments.push_back(GemmGroupedTileAssignment{
+                    block_idx, iteration, problem_visitor.problem_index(),
+                    problem_visitor.threadblock_tile_offset()});
+
+            problem_visitor.advance(threadblock_count);
+        }
+    }
+
+    return assignments;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace cutlass
@@ -0,0 +1,113 @@
+/***************************************************************************************************
+ * Copyright (c) 2017-2020, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ *modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice,
+ *this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *notice, this list of conditions and the following disclaimer in the
+ *documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the NVIDIA CORPORATION nor the names of its
+ *contributors may be used to endorse or promote products derived from this
+ *software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *DISCLAIMED. IN NO EVENT SHALL NVIDIA CORPORATION BE LIABLE FOR ANY DIRECT,
+ *INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ *OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TOR (INCLUDING
+ *NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Host-side replay of the work assigned to each threadblock of a
+   Stream-K GEMM.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/threadblock/threadblock_swizzle.h"
+
+namespace cutlass {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Part of one output tile computed by a threadblock of a Stream-K GEMM
+struct GemmStreamKWorkRange {
+    /// Threadblock computing the range
+    int threadblock_idx;
+
+    /// Index of the output tile
+    int tile_idx;
+
+    /// Coordinate of the output tile, in units of tiles
+    gemm::GemmCoord tile_offset;
+
+    /// First K iteration of the tile computed by the threadblock
+    int k_iter_begin;
+
+    /// One past the last K iteration of the tile computed by the threadblock
+    int k_iter_end;
+
+    /// Position of this range in the serial reduction of the tile
+    int partition_idx;
+
+    /// Number of threadblocks contributing to the tile
+    int partition_count;
+};
+
+/// Walks the iteration range of every threadblock of a Stream-K GEMM launch
+/// as the kernel does and returns the part of each output tile it computes,
+/// ordered by threadblock and then by tile. No device is required.
+template <typename ThreadblockSwizzle =
+                  gemm::threadblock::GemmStreamKThreadblockSwizzle>
+std::vector<GemmStreamKWorkRange> simulate_gemm_streamk_schedule(
+        ThreadblockSwizzle const& swizzle) {
+    std::vector<GemmStreamKWorkRange> ranges;
+
+    for (int block_idx = 0; block_idx < swizzle.block_count; ++block_idx) {
+        int iter = swizzle.get_block_iter_begin(block_idx);
+        int block_iter_end = swizzle.get_block_iter_end(block_idx);
+
+        while (iter < block_iter_end) {
+            int tile_idx = swizzle.get_tile_idx(iter);
+            int tile_iter_begin = swizzle.get_tile_iter_begin(tile_idx);
+            int segment_iter_end = std::min(
+                    block_iter_end, swizzle.get_tile_iter_end(tile_idx));
+
+            ranges.push_back(GemmStreamKWorkRange{
+                    block_idx, tile_idx, swizzle.get_tile_offset(tile_idx),
+                    iter - tile_iter_begin, segment_iter_end - tile_iter_begin,
+                    swizzle.get_partition_idx(tile_idx, block_idx),
+                    swizzle.get_partition_count(tile_idx)});
+
+            iter = segment_iter_end;
+        }
+    }
+
+    return ranges;
+}
+
+/// Partitions a problem among at most threadblock_count threadblocks and
+/// returns the work ranges of each threadblock
+inline std::vector<GemmStreamKWorkRange> simulate_gemm_streamk_schedule(
+        gemm::GemmCoord problem_size, gemm::GemmCoord tile_size,
+        int threadblock_count) {
+    return simulate_gemm_streamk_schedule(
+            gemm::threadblock::GemmStreamKThreadblockSwizzle(
+                    problem_size, tile_size, threadblock_count));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+}  // namespace cutlass